@@ -0,0 +1,17 @@
+static const char *petscmachineinfo = "\n"
+"-----------------------------------------\n"
+"Libraries compiled on 2026-10-18 18:18:26 on vm \n"
+"Machine characteristics: Linux-6.18.44-fc-v139-x86_64-with-debian-12.12\n"
+"Using PETSc directory: /root/repo\n"
+"Using PETSc arch: _cplx\n"
+"-----------------------------------------\n";
+static const char *petsccompilerinfo = "\n"
+"Using C compiler: mpicc  -fPIC  -Wall -Wwrite-strings -Wno-strict-aliasing -Wno-unknown-pragmas -fstack-protector -fvisibility=hidden -g3 -DOMPI_OMIT_MPI1_COMPAT_DECLS=0 -DOMPI_REMOVED_USE_STATIC_ASSERT=0 \n"
+"-----------------------------------------\n";
+static const char *petsccompilerflagsinfo = "\n"
+"Using include paths: -I/root/repo/include -I/root/repo/_cplx/include\n"
+"-----------------------------------------\n";
+static const char *petsclinkerinfo = "\n"
+"Using C linker: mpicc\n"
+"Using libraries: -Wl,-rpath,/root/repo/_cplx/lib -L/root/repo/_cplx/lib -lpetsc -llapack -lblas -lm -lstdc++ -ldl\n"
+"-----------------------------------------\n";
@@ -0,0 +1,18 @@
+#!/root/.pyenv/versions/2.7.18/bin/python
+if __name__ == '__main__':
+  import sys
+  import os
+  sys.path.insert(0, os.path.abspath('config'))
+  import configure
+  configure_options = [
+    '--with-cc=mpicc',
+    '--with-cxx=mpicxx',
+    '--with-debugging=1',
+    '--with-fc=0',
+    '--with-scalar-type=complex',
+    '--with-ssl=0',
+    '--with-x=0',
+    'CPPFLAGS=-DOMPI_OMIT_MPI1_COMPAT_DECLS=0 -DOMPI_REMOVED_USE_STATIC_ASSERT=0',
+    'PETSC_ARCH=_cplx',
+  ]
+  configure.petsc_configure(configure_options)
@@ -0,0 +1,47 @@
+#!/usr/bin/env bash
+# This script was created by gmakegentest.py
+
+
+
+# PATH for DLLs on windows
+PATH="$PATH":"/root/repo/_cplx/lib"
+
+exec='../ex1'
+testname='runex1_1'
+label='dm_dt_tests-ex1_1'
+runfiles=''
+wPETSC_DIR='/root/repo'
+petsc_dir='/root/repo'
+petsc_arch='_cplx'
+# Must be consistent with gmakefile.test
+testlogfile=/root/repo/_cplx/tests/examples_${petsc_arch}.log
+config_dir='/root/repo/config'
+petsc_bindir='/root/repo/lib/petsc/bin'
+DATAFILESPATH=${DATAFILESPATH:-""}
+args='-degrees 1,2,3,4,5 -points 0,.2,-.5,.8,.9,1 -interval -.5,1'
+timeoutfactor=1
+
+mpiexec=${PETSCMPIEXEC:-"mpiexec --oversubscribe"}
+diffexec=${PETSCDIFF:-"${petsc_bindir}/petscdiff"}
+
+. "${config_dir}/petsc_harness.sh"
+
+# The diff flags come from script arguments
+diff_exe="${diffexec} ${diff_flags}"
+mpiexec="${mpiexec} ${mpiexec_flags}"
+nsize=${nsize:-1}
+
+
+
+
+
+petsc_testrun "${mpiexec} -n ${nsize} ${exec} ${args} " ex1_1.tmp ${testname}.err "${label}" 
+res=$?
+
+if test $res = 0; then
+   petsc_testrun "${diff_exe} /root/repo/src/dm/dt/examples/tests/output/ex1_1.out ex1_1.tmp" diff-${testname}.out diff-${testname}.out diff-${label} ""
+else
+   printf "ok ${label} # SKIP Command failed so no diff\n"
+fi
+
+petsc_testend "/root/repo/_cplx/tests" 
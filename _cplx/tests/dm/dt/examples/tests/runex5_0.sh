@@ -0,0 +1,47 @@
+#!/usr/bin/env bash
+# This script was created by gmakegentest.py
+
+
+
+# PATH for DLLs on windows
+PATH="$PATH":"/root/repo/_cplx/lib"
+
+exec='../ex5'
+testname='runex5_0'
+label='dm_dt_tests-ex5_0'
+runfiles=''
+wPETSC_DIR='/root/repo'
+petsc_dir='/root/repo'
+petsc_arch='_cplx'
+# Must be consistent with gmakefile.test
+testlogfile=/root/repo/_cplx/tests/examples_${petsc_arch}.log
+config_dir='/root/repo/config'
+petsc_bindir='/root/repo/lib/petsc/bin'
+DATAFILESPATH=${DATAFILESPATH:-""}
+args='-petscspace_order 1 -trace_fe_view'
+timeoutfactor=1
+
+mpiexec=${PETSCMPIEXEC:-"mpiexec --oversubscribe"}
+diffexec=${PETSCDIFF:-"${petsc_bindir}/petscdiff"}
+
+. "${config_dir}/petsc_harness.sh"
+
+# The diff flags come from script arguments
+diff_exe="${diffexec} ${diff_flags}"
+mpiexec="${mpiexec} ${mpiexec_flags}"
+nsize=${nsize:-1}
+
+
+
+
+
+petsc_testrun "${mpiexec} -n ${nsize} ${exec} ${args} " ex5_0.tmp ${testname}.err "${label}" 
+res=$?
+
+if test $res = 0; then
+   petsc_testrun "${diff_exe} /root/repo/src/dm/dt/examples/tests/output/ex5_0.out ex5_0.tmp" diff-${testname}.out diff-${testname}.out diff-${label} ""
+else
+   printf "ok ${label} # SKIP Command failed so no diff\n"
+fi
+
+petsc_testend "/root/repo/_cplx/tests" 
@@ -0,0 +1,78 @@
+#!/usr/bin/env bash
+# This script was created by gmakegentest.py
+
+
+
+# PATH for DLLs on windows
+PATH="$PATH":"/root/repo/_cplx/lib"
+
+exec='../ex36'
+testname='runex36_2d'
+label='dm_tests-ex36_2d'
+runfiles=''
+wPETSC_DIR='/root/repo'
+petsc_dir='/root/repo'
+petsc_arch='_cplx'
+# Must be consistent with gmakefile.test
+testlogfile=/root/repo/_cplx/tests/examples_${petsc_arch}.log
+config_dir='/root/repo/config'
+petsc_bindir='/root/repo/lib/petsc/bin'
+DATAFILESPATH=${DATAFILESPATH:-""}
+args=''
+timeoutfactor=1
+
+mpiexec=${PETSCMPIEXEC:-"mpiexec --oversubscribe"}
+diffexec=${PETSCDIFF:-"${petsc_bindir}/petscdiff"}
+
+. "${config_dir}/petsc_harness.sh"
+
+# The diff flags come from script arguments
+diff_exe="${diffexec} ${diff_flags}"
+mpiexec="${mpiexec} ${mpiexec_flags}"
+nsize=${nsize:-1}
+
+
+
+
+
+nsize=1
+petsc_testrun "${mpiexec} -n ${nsize} ${exec} ${args}  -mx 10 -my 10 -nl 6 -dim 2 -cmap 0" ex36_2d.tmp ${testname}.err "${label}-a" 
+res=$?
+
+if test $res = 0; then
+   petsc_testrun "${diff_exe} /root/repo/src/dm/examples/tests/output/ex36_2d.out ex36_2d.tmp" diff-${testname}.out diff-${testname}.out diff-${label}-a ""
+else
+   printf "ok ${label} # SKIP Command failed so no diff\n"
+fi
+
+nsize=1
+petsc_testrun "${mpiexec} -n ${nsize} ${exec} ${args}  -mx 10 -my 10 -nl 6 -dim 2 -cmap 1" ex36_2d.tmp ${testname}.err "${label}-b" 
+res=$?
+
+if test $res = 0; then
+   petsc_testrun "${diff_exe} /root/repo/src/dm/examples/tests/output/ex36_2d.out ex36_2d.tmp" diff-${testname}.out diff-${testname}.out diff-${label}-b ""
+else
+   printf "ok ${label} # SKIP Command failed so no diff\n"
+fi
+
+nsize=1
+petsc_testrun "${mpiexec} -n ${nsize} ${exec} ${args}  -mx 10 -my 10 -nl 6 -dim 2 -cmap 2" ex36_2d.tmp ${testname}.err "${label}-c" 
+res=$?
+
+if test $res = 0; then
+   petsc_testrun "${diff_exe} /root/repo/src/dm/examples/tests/output/ex36_2d.out ex36_2d.tmp" diff-${testname}.out diff-${testname}.out diff-${label}-c ""
+else
+   printf "ok ${label} # SKIP Command failed so no diff\n"
+fi
+
+nsize=1
+petsc_testrun "${mpiexec} -n ${nsize} ${exec} ${args}  -mx 10 -my 10 -nl 6 -dim 2 -cmap 3" ex36_2d.tmp ${testname}.err "${label}-d" 
+res=$?
+
+if test $res = 0; then
+   petsc_testrun "${diff_exe} /root/repo/src/dm/examples/tests/output/ex36_2d.out ex36_2d.tmp" diff-${testname}.out diff-${testname}.out diff-${label}-d ""
+else
+   printf "ok ${label} # SKIP Command failed so no diff\n"
+fi
+
+petsc_testend "/root/repo/_cplx/tests" 
@@ -0,0 +1,63 @@
+#!/usr/bin/env bash
+# This script was created by gmakegentest.py
+
+
+
+# PATH for DLLs on windows
+PATH="$PATH":"/root/repo/_cplx/lib"
+
+exec='../ex24'
+testname='runex24_4'
+label='dm_impls_plex_tests-ex24_4'
+runfiles=''
+wPETSC_DIR='/root/repo'
+petsc_dir='/root/repo'
+petsc_arch='_cplx'
+# Must be consistent with gmakefile.test
+testlogfile=/root/repo/_cplx/tests/examples_${petsc_arch}.log
+config_dir='/root/repo/config'
+petsc_bindir='/root/repo/lib/petsc/bin'
+DATAFILESPATH=${DATAFILESPATH:-""}
+args='-petscpartititoner_ptscotch_vertex_weight 0 -mat_partitioning_ptscotch_proc_weight 0'
+timeoutfactor=1
+
+mpiexec=${PETSCMPIEXEC:-"mpiexec --oversubscribe"}
+diffexec=${PETSCDIFF:-"${petsc_bindir}/petscdiff"}
+
+. "${config_dir}/petsc_harness.sh"
+
+# The diff flags come from script arguments
+diff_exe="${diffexec} ${diff_flags}"
+mpiexec="${mpiexec} ${mpiexec_flags}"
+nsize=${nsize:-${nsize}}
+
+
+
+if ! $force; then
+    printf "ok ${label} # SKIP PETSC_HAVE_CHACO requirement not met, PETSC_HAVE_PARMETIS requirement not met, PETSC_HAVE_PTSCOTCH requirement not met, PETSC_HAVE_CTETGEN requirement not met\n"
+    total=1; skip=1
+    petsc_testend "/root/repo/_cplx/tests" 
+    exit
+fi
+
+
+for nsize in 1 2 3 4 8; do
+   for faces in 2,3,4  5,4,3  7,11,5; do
+      for partitioning in chaco parmetis ptscotch; do
+         for repartitioning in parmetis ptscotch; do
+
+            petsc_testrun "${mpiexec} -n ${nsize} ${exec} ${args}  -faces ${faces} -partitioning ${partitioning} -repartitioning ${repartitioning}" ex24_4.tmp ${testname}.err "${label}_nsize-${nsize}_faces-${faces}_partitioning-${partitioning}_repartitioning-${repartitioning}" 
+            res=$?
+
+            if test $res = 0; then
+               petsc_testrun "${diff_exe} /root/repo/src/dm/impls/plex/examples/tests/output/ex24_4.out ex24_4.tmp" diff-${testname}.out diff-${testname}.out diff-${label}_nsize-${nsize}_faces-${faces}_partitioning-${partitioning}_repartitioning-${repartitioning} ""
+            else
+               printf "ok ${label} # SKIP Command failed so no diff\n"
+            fi
+
+         done
+      done
+   done
+done
+
+petsc_testend "/root/repo/_cplx/tests" 
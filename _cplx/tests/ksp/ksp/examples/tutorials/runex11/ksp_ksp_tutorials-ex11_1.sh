@@ -0,0 +1 @@
+mpiexec --oversubscribe  -n 1 ../ex11 -n 6 -norandom -pc_type none -ksp_monitor_short -ksp_gmres_cgs_refinement_type refine_always  > ex11_1.tmp 2> runex11.err
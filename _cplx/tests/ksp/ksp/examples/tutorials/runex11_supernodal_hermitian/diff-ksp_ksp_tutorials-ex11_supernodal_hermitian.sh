@@ -0,0 +1 @@
+/root/repo/lib/petsc/bin/petscdiff  /root/repo/src/ksp/ksp/examples/tutorials/output/ex11_supernodal_hermitian.out ex11_supernodal_hermitian.tmp > diff-runex11_supernodal_hermitian.out 2> diff-runex11_supernodal_hermitian.out
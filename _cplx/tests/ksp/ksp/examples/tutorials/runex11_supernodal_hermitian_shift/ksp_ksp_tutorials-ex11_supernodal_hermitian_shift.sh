@@ -0,0 +1 @@
+mpiexec --oversubscribe  -n 1 ../ex11 -n 10 -norandom -hermitian -sigma1 0 -ksp_type preonly -pc_type cholesky -pc_factor_mat_solver_type supernodal -pc_factor_mat_ordering_type rcm -mat_supernodal_max_width 4 -pc_factor_shift_type nonzero  > ex11_supernodal_hermitian_shift.tmp 2> runex11_supernodal_hermitian_shift.err
@@ -0,0 +1 @@
+static const char *petscconfigureoptions = "--with-cc=mpicc --with-cxx=mpicxx --with-debugging=1 --with-fc=0 --with-ssl=0 --with-x=0 --with-hdf5-dir=/usr/lib/x86_64-linux-gnu/hdf5/serial CPPFLAGS=\"-DOMPI_OMIT_MPI1_COMPAT_DECLS=0 -DOMPI_REMOVED_USE_STATIC_ASSERT=0\" PETSC_ARCH=_h5";
@@ -13,6 +13,7 @@
 #define KSPType character*(80)
 #define KSPGuessType character*(80)
 #define KSPCGType PetscEnum
+#define KSPChebyshevKind PetscEnum
 #define KSPFCDTruncationType PetscEnum
 #define KSPConvergedReason PetscEnum
 #define KSPNormType PetscEnum
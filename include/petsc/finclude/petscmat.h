@@ -49,6 +49,7 @@
 
 #define MATPARTITIONING_CURRENT 'current'
 #define MATPARTITIONING_PARMETIS 'parmetis'
+#define MATPARTITIONING_MULTILEVEL 'multilevel'
 
 #define MATCOARSEN_MIS 'mis'
 
@@ -67,6 +68,7 @@
 #define MATORDERINGROWLENGTH 'rowlength'
 #define MATORDERINGWBM       'wbm'
 #define MATORDERINGSPECTRAL  'spectral'
+#define MATORDERINGMLND      'mlnd'
 #define MATORDERINGAMD       'amd'
 !
 !  Matrix types
@@ -115,6 +117,7 @@
 #define MATNORMAL          'normal'
 #define MATNORMALHERMITIAN 'normalh'
 #define MATLRC             'lrc'
+#define MATHODLR           'hodlr'
 #define MATSCATTER         'scatter'
 #define MATBLOCKMAT        'blockmat'
 #define MATCOMPOSITE       'composite'
@@ -134,6 +137,7 @@
 #define MATSEQSELL         'seqsell'
 #define MATMPISELL         'mpisell'
 #define MATDUMMY           'dummy'
+#define MATEBE             'ebe'
 
 !
 ! MatMFFDType values
@@ -161,6 +165,8 @@
 #define MATSOLVERMATLAB          'matlab'
 #define MATSOLVERPETSC           'petsc'
 #define MATSOLVERBAS             'bas'
+#define MATSOLVERCHOWILU         'chowilu'
+#define MATSOLVERSUPERNODAL      'supernodal'
 #define MATSOLVERCUSPARSE        'cusparse'
 
 !
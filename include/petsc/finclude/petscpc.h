@@ -50,6 +50,7 @@
 #define PCNN 'nn'
 #define PCCHOLESKY 'cholesky'
 #define PCPBJACOBI 'pbjacobi'
+#define PCVPBJACOBI 'vpbjacobi'
 #define PCMAT 'mat'
 #define PCHYPRE 'hypre'
 #define PCPARMS 'parms'
@@ -72,6 +73,7 @@
 
 #define PCMGType PetscEnum
 #define PCMGCycleType PetscEnum
+#define PCMGAdditiveType PetscEnum
 #define PCMGGalerkinType PetscEnum
 #define PCExoticType PetscEnum
 #define PCFailedReason PetscEnum
@@ -118,6 +118,26 @@ struct _PetscGridHash {
   DMLabel      cellsSparse; /* Sparse storage for cell map */
 };
 
+/* Bounding volume hierarchy over the local cells, see DMPlexGetCellBVH_Internal() */
+typedef struct _n_DMPlexCellBVH *DMPlexCellBVH;
+struct _n_DMPlexCellBVH {
+  PetscInt          dim;         /* The coordinate dimension */
+  PetscInt          cStart;      /* The cells in the hierarchy, numbered c - cStart below */
+  PetscInt          cEnd;
+  Vec               coordinates; /* The local coordinates the hierarchy was built from */
+  PetscObjectState  state;       /* The state of the coordinates when the hierarchy was built */
+  PetscInt         *vertOff;     /* Offset of the vertex coordinates of each cell in vertCoords, of size cEnd-cStart+1 */
+  PetscReal        *vertCoords;  /* Vertex coordinates of each cell in closure order */
+  PetscInt         *nbrOff;      /* Offset of the face neighbors of each cell in nbrs, of size cEnd-cStart+1 */
+  PetscInt         *nbrs;        /* Face neighbors of each cell, empty for uninterpolated meshes */
+  PetscInt          numNodes;    /* The number of tree nodes, the root is node 0 */
+  PetscReal        *box;         /* Lower and upper corner of each node, 2*dim entries per node */
+  PetscInt         *child;       /* First child of each node, the second is child+1, or -1 for a leaf */
+  PetscInt         *start;       /* Range of each node in cells */
+  PetscInt         *end;
+  PetscInt         *cells;       /* Cells ordered so that each node covers a contiguous range */
+};
+
 typedef struct {
   PetscInt             refct;
 
@@ -187,6 +207,20 @@ typedef struct {
   PetscReal            minradius;         /* Minimum distance from cell centroid to face */
   PetscBool            useHashLocation;   /* Use grid hashing for point location */
   PetscGridHash        lbox;              /* Local box for searching */
+  PetscBool            useBVHLocation;    /* Use a bounding volume hierarchy over the cells for point location */
+  PetscInt             locationWalk;      /* Number of neighbor cells to try from the initial guess before searching */
+  DMPlexCellBVH        bvh;               /* Persistent hierarchy for searching */
+
+  /* Assembly */
+  PetscBool            threadedAssembly;  /* Integrate cells in concurrent threads, and add them in conflict-free colors */
+  PetscBool            useClosureIndexCache; /* Gather and scatter cell closures through precomputed indices */
+  PetscInt             numThreadDS;       /* Number of PetscDS cached for threaded assembly, the first entry is the one they copy */
+  PetscDS             *threadDS;          /* The PetscDS of the problem for each assembly thread */
+  PetscDS             *threadDSAux;       /* The PetscDS of the auxiliary problem for each assembly thread */
+
+  /* Storage */
+  PetscBool            compactTopology;   /* Store the cone and support sections as runs of equal size */
+  DMPlexReorderType    reorderType;       /* Renumber the points for locality after distribution */
 
   /* Debugging */
   PetscBool            printSetValues;
@@ -194,6 +228,22 @@ typedef struct {
   PetscReal            printTol;
 } DM_Plex;
 
+/* Closure indices of all cells for a section, see DMPlexGetClosureIndexCache_Internal() */
+typedef struct {
+  PetscObjectId    dmId;   /* The DM the closures were computed on */
+  PetscObjectState state;  /* The state of the local section */
+  PetscInt         cStart; /* The cells covered by the cache */
+  PetscInt         cEnd;
+  PetscBool        depth1; /* Closures follow the cell-vertex ordering */
+  PetscInt        *off;    /* Offset of the closure of each cell, of size cEnd-cStart+1 */
+  PetscInt        *lidx;   /* Local indices, with constrained dofs stored as -(idx+1) */
+  PetscBool        lvalid; /* False if the closures cannot be gathered through lidx, e.g. because of sign flips */
+  PetscObjectId    gsId;   /* The global section the global indices were computed for */
+  PetscObjectState gstate;
+  PetscInt        *gidx;   /* Global indices, as from DMPlexGetClosureIndices() */
+  PetscBool        gvalid; /* False if the global indices cannot be used, e.g. because of anchors */
+} DMPlexClosureIndexCache;
+
 PETSC_EXTERN PetscErrorCode DMPlexVTKWriteAll_VTU(DM,PetscViewer);
 PETSC_EXTERN PetscErrorCode VecView_Plex_Local(Vec,PetscViewer);
 PETSC_EXTERN PetscErrorCode VecView_Plex_Native(Vec,PetscViewer);
@@ -235,6 +285,9 @@ PETSC_INTERN PetscErrorCode DMPlexBuildFromCellList_Internal(DM, PetscInt, Petsc
 PETSC_INTERN PetscErrorCode DMPlexBuildFromCellList_Parallel_Internal(DM, PetscInt, PetscInt, PetscInt, PetscInt, const int[], PetscBool, PetscSF *);
 PETSC_INTERN PetscErrorCode DMPlexBuildCoordinates_Internal(DM, PetscInt, PetscInt, PetscInt, const double[]);
 PETSC_INTERN PetscErrorCode DMPlexBuildCoordinates_Parallel_Internal(DM, PetscInt, PetscInt, PetscInt, PetscSF, const PetscReal[]);
+PETSC_INTERN PetscErrorCode DMPlexBuildFromDAG_Parallel_Internal(DM, PetscInt, const PetscInt[], const PetscInt[], const PetscInt[], const PetscInt[], PetscSF *);
+PETSC_INTERN PetscErrorCode DMPlexBuildCoordinates_DAG_Parallel_Internal(DM, PetscSF, PetscInt, const PetscScalar[]);
+PETSC_INTERN PetscErrorCode DMPlexSetLabelValues_DAG_Parallel_Internal(DM, PetscSF, DMLabel, PetscInt, PetscInt, const PetscInt[]);
 PETSC_INTERN PetscErrorCode DMPlexLoadLabels_HDF5_Internal(DM, PetscViewer);
 PETSC_INTERN PetscErrorCode DMPlexView_HDF5_Internal(DM, PetscViewer);
 PETSC_INTERN PetscErrorCode DMPlexLoad_HDF5_Internal(DM, PetscViewer);
@@ -491,5 +544,9 @@ PETSC_STATIC_INLINE PetscErrorCode DMPlexGetGlobalFieldOffset_Private(DM dm, Pet
 PETSC_INTERN PetscErrorCode DMPlexGetPointDualSpaceFEM(DM,PetscInt,PetscInt,PetscDualSpace *);
 PETSC_INTERN PetscErrorCode DMPlexGetIndicesPoint_Internal(PetscSection,PetscInt,PetscInt,PetscInt *,PetscBool,const PetscInt[],PetscInt[]);
 PETSC_INTERN PetscErrorCode DMPlexGetIndicesPointFields_Internal(PetscSection,PetscInt,PetscInt,PetscInt[],PetscBool,const PetscInt***,PetscInt,PetscInt[]);
+PETSC_INTERN PetscErrorCode DMPlexGetClosureIndexCache_Internal(DM,PetscSection,PetscSection,DMPlexClosureIndexCache**);
+PETSC_INTERN PetscErrorCode DMPlexPermuteSF_Internal(PetscSF,IS,PetscBool,PetscSF*);
+PETSC_INTERN PetscErrorCode DMPlexGetCellBVH_Internal(DM,DMPlexCellBVH*);
+PETSC_INTERN PetscErrorCode DMPlexCellBVHDestroy_Internal(DMPlexCellBVH*);
 
 #endif /* _PLEXIMPL_H */
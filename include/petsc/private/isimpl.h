@@ -91,6 +91,10 @@ struct _p_PetscSection {
   PetscInt                     *atlasDof;     /* Describes layout of storage, point --> # of values */
   PetscInt                     *atlasOff;     /* Describes layout of storage, point --> offset into storage */
   PetscInt                      maxDof;       /* Maximum dof on any point */
+  PetscInt                      numRuns;      /* The number of runs in a compact layout, or 0 if atlasDof and atlasOff are stored */
+  PetscInt                     *runStart;     /* The first point of each run, and pEnd, of size numRuns+1 */
+  PetscInt                     *runDof;       /* The dof of every point in a run */
+  PetscInt                     *runOff;       /* The offset of the first point in a run, later points following contiguously */
   PetscSection                  bc;           /* Describes constraints, point --> # local dofs which are constrained */
   PetscInt                     *bcIndices;    /* Local indices for constrained dofs */
   PetscBool                     setup;
@@ -112,6 +116,8 @@ struct _p_PetscSection {
 PETSC_EXTERN PetscErrorCode PetscSectionSetClosurePermutation_Internal(PetscSection, PetscObject, PetscInt, PetscCopyMode, PetscInt *);
 PETSC_EXTERN PetscErrorCode PetscSectionGetClosurePermutation_Internal(PetscSection, PetscObject, PetscInt *, const PetscInt *[]);
 PETSC_EXTERN PetscErrorCode PetscSectionGetClosureInversePermutation_Internal(PetscSection, PetscObject, PetscInt *, const PetscInt *[]);
+PETSC_EXTERN PetscErrorCode PetscSectionCompact_Internal(PetscSection, PetscInt, PetscBool *);
+PETSC_EXTERN PetscErrorCode PetscSectionExpand_Internal(PetscSection);
 
 struct _PetscSectionSymOps {
   PetscErrorCode (*getpoints)(PetscSectionSym,PetscSection,PetscInt,const PetscInt *,const PetscInt **,const PetscScalar **);
@@ -27,6 +27,9 @@ typedef struct gamg_TAG {
   PetscBool use_parallel_coarse_grid_solver;
   PetscInt  min_eq_proc;
   PetscInt  coarse_eq_limit;
+  PetscBool cost_model;      /* choose the number of active processes on each level with a cost model instead of min_eq_proc */
+  PetscReal cost_nz_time;    /* time of the local SpMV per nonzero, PETSC_DECIDE to measure it on each level */
+  PetscReal cost_latency;    /* latency of a message, PETSC_DECIDE to measure it on each level */
   PetscReal threshold_scale;
   PetscInt  current_level; /* stash construction state */
   PetscReal threshold[PETSC_GAMG_MAXLEVELS]; /* common quatity to many AMG methods so keep it up here */
@@ -8,6 +8,7 @@
 
 PETSC_EXTERN PetscBool PCRegisterAllCalled;
 PETSC_EXTERN PetscErrorCode PCRegisterAll(void);
+PETSC_INTERN PetscErrorCode PCSetSubOperators_Private(KSP,Mat,Mat);
 
 typedef struct _PCOps *PCOps;
 struct _PCOps {
@@ -26,6 +26,7 @@ typedef struct {
   Mat           interpolate;
   Mat           restrct;                       /* restrict is a reserved word in C99 and on Cray */
   Mat           inject;                        /* Used for moving state if provided. */
+  Mat           sinterpolate;                  /* l1-Jacobi smoothed interpolation, for PC_MG_ADDITIVE_MULT */
   Vec           rscale;                        /* scaling of restriction matrix */
   PetscLogEvent eventsmoothsetup;              /* if logging times for each level */
   PetscLogEvent eventsmoothsolve;
@@ -38,6 +39,7 @@ typedef struct {
 */
 typedef struct {
   PCMGType         am;                        /* Multiplicative, additive or full */
+  PCMGAdditiveType additivetype;              /* variant of additive multigrid */
   PetscInt         cyclesperpcapply;          /* Number of cycles to use in each PCApply(), multiplicative only*/
   PetscInt         maxlevels;                 /* total number of levels allocated */
   PCMGGalerkinType galerkin;                  /* use Galerkin process to compute coarser matrices */
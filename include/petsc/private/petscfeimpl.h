@@ -92,6 +92,15 @@ typedef struct {
   PetscInt *numDof;
 } PetscDualSpace_Simple;
 
+/* Factorization B(x) = \prod_d B1(x_d) of the default tabulation of a tensor product element, used for sum factorization */
+typedef struct {
+  PetscInt   Nn;   /* Number of 1D nodes */
+  PetscInt   Nq;   /* Number of 1D quadrature points */
+  PetscInt  *node; /* node[b] is the lexicographic tensor index of scalar basis function b */
+  PetscReal *B1;   /* B1[q*Nn+i] is the 1D basis function i at 1D quadrature point q */
+  PetscReal *D1;   /* D1[q*Nn+i] is its derivative */
+} PetscFETensorTabulation;
+
 typedef struct _PetscFEOps *PetscFEOps;
 struct _PetscFEOps {
   PetscErrorCode (*setfromoptions)(PetscOptionItems*,PetscFE);
@@ -104,7 +113,7 @@ struct _PetscFEOps {
   PetscErrorCode (*integrate)(PetscFE, PetscDS, PetscInt, PetscInt, PetscFEGeom *, const PetscScalar[], PetscDS, const PetscScalar[], PetscScalar[]);
   PetscErrorCode (*integrateresidual)(PetscFE, PetscDS, PetscInt, PetscInt, PetscFEGeom *, const PetscScalar[], const PetscScalar[], PetscDS, const PetscScalar[], PetscReal, PetscScalar[]);
   PetscErrorCode (*integratebdresidual)(PetscFE, PetscDS, PetscInt, PetscInt, PetscFEGeom *, const PetscScalar[], const PetscScalar[], PetscDS, const PetscScalar[], PetscReal, PetscScalar[]);
-  PetscErrorCode (*integratejacobianaction)(PetscFE, PetscDS, PetscInt, PetscInt, PetscFEGeom *, const PetscScalar[], const PetscScalar[], PetscDS, const PetscScalar[], PetscReal, PetscReal, PetscScalar[]);
+  PetscErrorCode (*integratejacobianaction)(PetscFE, PetscDS, PetscFEJacobianType, PetscInt, PetscInt, PetscInt, PetscFEGeom *, const PetscScalar[], const PetscScalar[], PetscDS, const PetscScalar[], PetscReal, PetscReal, const PetscScalar[], PetscScalar[]);
   PetscErrorCode (*integratejacobian)(PetscFE, PetscDS, PetscFEJacobianType, PetscInt, PetscInt, PetscInt, PetscFEGeom *, const PetscScalar[], const PetscScalar[], PetscDS, const PetscScalar[], PetscReal, PetscReal, PetscScalar[]);
   PetscErrorCode (*integratebdjacobian)(PetscFE, PetscDS, PetscInt, PetscInt, PetscInt, PetscFEGeom *, const PetscScalar[], const PetscScalar[], PetscDS, const PetscScalar[], PetscReal, PetscReal, PetscScalar[]);
 };
@@ -122,6 +131,8 @@ struct _p_PetscFE {
   PetscReal      *B,  *D,  *H;           /* Tabulation of basis and derivatives at quadrature points */
   PetscReal      *Bf, *Df, *Hf;          /* Tabulation of basis and derivatives at quadrature points on each face */
   PetscReal      *F;                     /* Tabulation of basis at face centroids */
+  PetscFETensorTabulation *T;            /* Factored tabulation for tensor product elements, or NULL */
+  PetscBool       Tchecked;              /* Whether we have looked for a tensor product factorization */
   PetscInt        blockSize, numBlocks;  /* Blocks are processed concurrently */
   PetscInt        batchSize, numBatches; /* A batch is made up of blocks, Batches are processed in serial */
   PetscBool       setupcalled;
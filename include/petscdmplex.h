@@ -54,6 +54,7 @@ PETSC_EXTERN PetscErrorCode DMPlexCreateCohesiveSubmesh(DM, PetscBool, const cha
 PETSC_EXTERN PetscErrorCode DMPlexCreateFromCellList(MPI_Comm, PetscInt, PetscInt, PetscInt, PetscInt, PetscBool, const int[], PetscInt, const double[], DM*);
 PETSC_EXTERN PetscErrorCode DMPlexCreateFromCellListParallel(MPI_Comm, PetscInt, PetscInt, PetscInt, PetscInt, PetscBool, const int[], PetscInt, const PetscReal[], PetscSF *, DM *);
 PETSC_EXTERN PetscErrorCode DMPlexCreateFromDAG(DM, PetscInt, const PetscInt [], const PetscInt [], const PetscInt [], const PetscInt [], const PetscScalar []);
+PETSC_EXTERN PetscErrorCode DMPlexCreateFromDAGParallel(DM, PetscInt, const PetscInt [], const PetscInt [], const PetscInt [], const PetscInt [], PetscInt, const PetscScalar [], PetscSF *);
 PETSC_EXTERN PetscErrorCode DMPlexCreateReferenceCell(MPI_Comm, PetscInt, PetscBool, DM*);
 PETSC_EXTERN PetscErrorCode DMPlexSetOptionsPrefix(DM, const char []);
 PETSC_EXTERN PetscErrorCode DMPlexGetChart(DM, PetscInt *, PetscInt *);
@@ -184,8 +185,25 @@ PETSC_EXTERN PetscErrorCode DMPlexGetAdjacency(DM, PetscInt, PetscInt *, PetscIn
 PETSC_EXTERN PetscErrorCode DMPlexSetMigrationSF(DM, PetscSF);
 PETSC_EXTERN PetscErrorCode DMPlexGetMigrationSF(DM, PetscSF *);
 
+/*E
+  DMPlexReorderType - The ordering of the mesh points used by DMPlexGetReordering()
+
+  Level: intermediate
+
+  DMPLEX_REORDER_RCM orders the cells by reverse Cuthill-McKee on their adjacency graph. DMPLEX_REORDER_HILBERT and
+  DMPLEX_REORDER_MORTON order the cells along a Hilbert or Morton space filling curve through their centroids.
+
+.seealso: DMPlexGetReordering(), DMPlexReorder(), DMPlexSetReorderType()
+E*/
+typedef enum {DMPLEX_REORDER_NONE, DMPLEX_REORDER_RCM, DMPLEX_REORDER_HILBERT, DMPLEX_REORDER_MORTON} DMPlexReorderType;
+PETSC_EXTERN const char *const DMPlexReorderTypes[];
+
 PETSC_EXTERN PetscErrorCode DMPlexGetOrdering(DM, MatOrderingType, DMLabel, IS *);
 PETSC_EXTERN PetscErrorCode DMPlexPermute(DM, IS, DM *);
+PETSC_EXTERN PetscErrorCode DMPlexGetReordering(DM, DMPlexReorderType, IS *);
+PETSC_EXTERN PetscErrorCode DMPlexReorder(DM, DMPlexReorderType, DM *);
+PETSC_EXTERN PetscErrorCode DMPlexGetReorderType(DM, DMPlexReorderType *);
+PETSC_EXTERN PetscErrorCode DMPlexSetReorderType(DM, DMPlexReorderType);
 
 PETSC_EXTERN PetscErrorCode DMPlexCreateProcessSF(DM, PetscSF, IS *, PetscSF *);
 PETSC_EXTERN PetscErrorCode DMPlexCreateTwoSidedProcessSF(DM, PetscSF, PetscSection, IS, PetscSection, IS, IS *, PetscSF *);
@@ -216,8 +234,25 @@ PETSC_EXTERN PetscErrorCode DMPlexSetRefinementFunction(DM, PetscErrorCode (*)(c
 PETSC_EXTERN PetscErrorCode DMPlexCreateCoarsePointIS(DM, IS *);
 PETSC_EXTERN PetscErrorCode DMPlexGetRegularRefinement(DM, PetscBool *);
 PETSC_EXTERN PetscErrorCode DMPlexSetRegularRefinement(DM, PetscBool);
+PETSC_EXTERN PetscErrorCode DMPlexGetThreadedAssembly(DM, PetscBool *);
+PETSC_EXTERN PetscErrorCode DMPlexSetThreadedAssembly(DM, PetscBool);
+PETSC_EXTERN PetscErrorCode DMPlexGetUseClosureIndexCache(DM, PetscBool *);
+PETSC_EXTERN PetscErrorCode DMPlexSetUseClosureIndexCache(DM, PetscBool);
+PETSC_EXTERN PetscErrorCode DMPlexGetCompactTopology(DM, PetscBool *);
+PETSC_EXTERN PetscErrorCode DMPlexSetCompactTopology(DM, PetscBool);
+PETSC_EXTERN PetscErrorCode DMPlexCreateClosureColoring(DM, IS, ISColoring *);
 PETSC_EXTERN PetscErrorCode DMPlexRefineSimplexToTensor(DM, DM*);
 
+typedef struct _n_DMPlexImplicitRefinement *DMPlexImplicitRefinement;
+PETSC_EXTERN PetscErrorCode DMPlexImplicitRefinementCreate(DM, PetscInt, DMPlexImplicitRefinement *);
+PETSC_EXTERN PetscErrorCode DMPlexImplicitRefinementDestroy(DMPlexImplicitRefinement *);
+PETSC_EXTERN PetscErrorCode DMPlexImplicitRefinementGetChart(DMPlexImplicitRefinement, PetscInt *, PetscInt *);
+PETSC_EXTERN PetscErrorCode DMPlexImplicitRefinementGetDepthStratum(DMPlexImplicitRefinement, PetscInt, PetscInt *, PetscInt *);
+PETSC_EXTERN PetscErrorCode DMPlexImplicitRefinementGetConeSize(DMPlexImplicitRefinement, PetscInt, PetscInt *);
+PETSC_EXTERN PetscErrorCode DMPlexImplicitRefinementGetCone(DMPlexImplicitRefinement, PetscInt, PetscInt [], PetscInt []);
+PETSC_EXTERN PetscErrorCode DMPlexImplicitRefinementGetCoarsePoint(DMPlexImplicitRefinement, PetscInt, PetscInt *);
+PETSC_EXTERN PetscErrorCode DMPlexImplicitRefinementCreateDM(DMPlexImplicitRefinement, DM *);
+
 /* Support for cell-vertex meshes */
 PETSC_EXTERN PetscErrorCode DMPlexGetNumFaceVertices(DM, PetscInt, PetscInt, PetscInt *);
 PETSC_EXTERN PetscErrorCode DMPlexGetOrientedFace(DM, PetscInt, PetscInt, const PetscInt [], PetscInt, PetscInt [], PetscInt [], PetscInt [], PetscBool *);
@@ -236,6 +271,10 @@ PETSC_EXTERN PetscErrorCode PetscGridHashEnlarge(PetscGridHash, const PetscScala
 PETSC_EXTERN PetscErrorCode PetscGridHashSetGrid(PetscGridHash, const PetscInt [], const PetscReal []);
 PETSC_EXTERN PetscErrorCode PetscGridHashGetEnclosingBox(PetscGridHash, PetscInt, const PetscScalar [], PetscInt [], PetscInt []);
 PETSC_EXTERN PetscErrorCode PetscGridHashDestroy(PetscGridHash *);
+PETSC_EXTERN PetscErrorCode DMPlexGetUseBVHLocation(DM, PetscBool *);
+PETSC_EXTERN PetscErrorCode DMPlexSetUseBVHLocation(DM, PetscBool);
+PETSC_EXTERN PetscErrorCode DMPlexGetPointLocationWalk(DM, PetscInt *);
+PETSC_EXTERN PetscErrorCode DMPlexSetPointLocationWalk(DM, PetscInt);
 
 /* FVM Support */
 PETSC_EXTERN PetscErrorCode DMPlexComputeCellGeometryFVM(DM, PetscInt, PetscReal *, PetscReal [], PetscReal []);
@@ -155,6 +155,22 @@ PETSC_EXTERN PetscErrorCode KSPChebyshevSetEigenvalues(KSP,PetscReal,PetscReal);
 PETSC_EXTERN PetscErrorCode KSPChebyshevEstEigSet(KSP,PetscReal,PetscReal,PetscReal,PetscReal);
 PETSC_EXTERN PetscErrorCode KSPChebyshevEstEigSetUseNoisy(KSP,PetscBool);
 PETSC_EXTERN PetscErrorCode KSPChebyshevEstEigGetKSP(KSP,KSP*);
+PETSC_EXTERN PetscErrorCode KSPChebyshevEstEigSetRefine(KSP,PetscInt);
+
+/*E
+    KSPChebyshevKind - Which kind of Chebyshev polynomial KSPCHEBYSHEV uses
+
+$  KSP_CHEBYSHEV_FIRST  - the classical first kind polynomial, needs lower and upper bounds of the spectrum
+$  KSP_CHEBYSHEV_FOURTH - the fourth kind polynomial, needs only an upper bound of the spectrum
+
+   Level: intermediate
+
+.seealso: KSPChebyshevSetKind()
+E*/
+typedef enum {KSP_CHEBYSHEV_FIRST,KSP_CHEBYSHEV_FOURTH} KSPChebyshevKind;
+PETSC_EXTERN const char *const KSPChebyshevKinds[];
+PETSC_EXTERN PetscErrorCode KSPChebyshevSetKind(KSP,KSPChebyshevKind);
+PETSC_EXTERN PetscErrorCode KSPChebyshevGetKind(KSP,KSPChebyshevKind*);
 PETSC_EXTERN PetscErrorCode KSPComputeExtremeSingularValues(KSP,PetscReal*,PetscReal*);
 PETSC_EXTERN PetscErrorCode KSPComputeEigenvalues(KSP,PetscInt,PetscReal[],PetscReal[],PetscInt*);
 PETSC_EXTERN PetscErrorCode KSPComputeEigenvaluesExplicitly(KSP,PetscInt,PetscReal[],PetscReal[]);
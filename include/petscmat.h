@@ -68,6 +68,7 @@ typedef const char* MatType;
 #define MATNORMAL          "normal"
 #define MATNORMALHERMITIAN "normalh"
 #define MATLRC             "lrc"
+#define MATHODLR           "hodlr"
 #define MATSCATTER         "scatter"
 #define MATBLOCKMAT        "blockmat"
 #define MATCOMPOSITE       "composite"
@@ -80,6 +81,7 @@ typedef const char* MatType;
 #define MATHYPRE           "hypre"
 #define MATHYPRESTRUCT     "hyprestruct"
 #define MATHYPRESSTRUCT    "hypresstruct"
+#define MATDASTENCIL       "dastencil"
 #define MATSUBMATRIX       "submatrix"
 #define MATLOCALREF        "localref"
 #define MATNEST            "nest"
@@ -88,6 +90,7 @@ typedef const char* MatType;
 #define MATSEQSELL         "seqsell"
 #define MATMPISELL         "mpisell"
 #define MATDUMMY           "dummy"
+#define MATEBE             "ebe"
 
 /*J
     MatSolverType - String with the name of a PETSc matrix solver type.
@@ -116,6 +119,8 @@ typedef const char* MatSolverType;
 #define MATSOLVERMATLAB           "matlab"
 #define MATSOLVERPETSC            "petsc"
 #define MATSOLVERBAS              "bas"
+#define MATSOLVERCHOWILU          "chowilu"
+#define MATSOLVERSUPERNODAL       "supernodal"
 #define MATSOLVERCUSPARSE         "cusparse"
 
 /*E
@@ -244,6 +249,7 @@ PETSC_EXTERN PetscErrorCode MatCreateNormal(Mat,Mat*);
 PETSC_EXTERN PetscErrorCode MatCreateNormalHermitian(Mat,Mat*);
 PETSC_EXTERN PetscErrorCode MatCreateLRC(Mat,Mat,Vec,Mat,Mat*);
 PETSC_EXTERN PetscErrorCode MatLRCGetMats(Mat,Mat*,Mat*,Vec*,Mat*);
+PETSC_EXTERN PetscErrorCode MatCreateHODLR(Mat,PetscReal,PetscInt,Mat*);
 PETSC_EXTERN PetscErrorCode MatCreateIS(MPI_Comm,PetscInt,PetscInt,PetscInt,PetscInt,PetscInt,ISLocalToGlobalMapping,ISLocalToGlobalMapping,Mat*);
 PETSC_EXTERN PetscErrorCode MatCreateSeqAIJCRL(MPI_Comm,PetscInt,PetscInt,PetscInt,const PetscInt[],Mat*);
 PETSC_EXTERN PetscErrorCode MatCreateMPIAIJCRL(MPI_Comm,PetscInt,PetscInt,PetscInt,const PetscInt[],PetscInt,const PetscInt[],Mat*);
@@ -286,6 +292,7 @@ PETSC_EXTERN PetscErrorCode MatGetDiagonalBlock(Mat,Mat*);
 PETSC_EXTERN PetscErrorCode MatGetTrace(Mat,PetscScalar*);
 PETSC_EXTERN PetscErrorCode MatInvertBlockDiagonal(Mat,const PetscScalar **);
 PETSC_EXTERN PetscErrorCode MatInvertBlockDiagonalMat(Mat,Mat);
+PETSC_EXTERN PetscErrorCode MatInvertVariableBlockDiagonal(Mat,PetscInt,const PetscInt*,PetscScalar*);
 
 /* ------------------------------------------------------------*/
 PETSC_EXTERN PetscErrorCode MatSetValues(Mat,PetscInt,const PetscInt[],PetscInt,const PetscInt[],const PetscScalar[],InsertMode);
@@ -406,6 +413,8 @@ PETSC_EXTERN PetscErrorCode MatSetBlockSize(Mat,PetscInt);
 PETSC_EXTERN PetscErrorCode MatGetBlockSizes(Mat,PetscInt *,PetscInt *);
 PETSC_EXTERN PetscErrorCode MatSetBlockSizes(Mat,PetscInt,PetscInt);
 PETSC_EXTERN PetscErrorCode MatSetBlockSizesFromMats(Mat,Mat,Mat);
+PETSC_EXTERN PetscErrorCode MatSetVariableBlockSizes(Mat,PetscInt,PetscInt*);
+PETSC_EXTERN PetscErrorCode MatGetVariableBlockSizes(Mat,PetscInt*,const PetscInt**);
 PETSC_EXTERN PetscErrorCode MatDenseGetColumn(Mat,PetscInt,PetscScalar *[]);
 PETSC_EXTERN PetscErrorCode MatDenseRestoreColumn(Mat,PetscScalar *[]);
 
@@ -1067,6 +1076,7 @@ typedef const char* MatOrderingType;
 #define MATORDERINGROWLENGTH   "rowlength"
 #define MATORDERINGWBM         "wbm"
 #define MATORDERINGSPECTRAL    "spectral"
+#define MATORDERINGMLND        "mlnd"
 #define MATORDERINGAMD         "amd"            /* only works if UMFPACK is installed with PETSc */
 
 PETSC_EXTERN PetscErrorCode MatGetOrdering(Mat,MatOrderingType,IS*,IS*);
@@ -1325,6 +1335,7 @@ typedef const char* MatPartitioningType;
 #define MATPARTITIONINGPARTY    "party"
 #define MATPARTITIONINGPTSCOTCH "ptscotch"
 #define MATPARTITIONINGHIERARCH  "hierarch"
+#define MATPARTITIONINGMULTILEVEL "multilevel"
 
 
 PETSC_EXTERN PetscErrorCode MatPartitioningCreate(MPI_Comm,MatPartitioning*);
@@ -1400,6 +1411,14 @@ PETSC_EXTERN PetscErrorCode MatPartitioningHierarchicalGetCoarseparts(MatPartiti
 PETSC_EXTERN PetscErrorCode MatPartitioningHierarchicalSetNcoarseparts(MatPartitioning,PetscInt);
 PETSC_EXTERN PetscErrorCode MatPartitioningHierarchicalSetNfineparts(MatPartitioning, PetscInt);
 
+/*
+ * native multilevel partitioning
+ */
+PETSC_EXTERN PetscErrorCode MatPartitioningMultilevelSetImbalance(MatPartitioning,PetscReal);
+PETSC_EXTERN PetscErrorCode MatPartitioningMultilevelGetEdgeCut(MatPartitioning,PetscInt*);
+PETSC_EXTERN PetscErrorCode MatPartitioningMultilevelSetRepartition(MatPartitioning,PetscBool);
+PETSC_EXTERN PetscErrorCode MatPartitioningMultilevelGetMigration(MatPartitioning,PetscInt*);
+
 PETSC_EXTERN PetscErrorCode MatMeshToVertexGraph(Mat,PetscInt,Mat*);
 PETSC_EXTERN PetscErrorCode MatMeshToCellGraph(Mat,PetscInt,Mat*);
 
@@ -1550,7 +1569,8 @@ typedef enum { MATOP_SET_VALUES=0,
                MATOP_RESIDUAL=141,
                MATOP_FDCOLORING_SETUP=142,
                MATOP_MPICONCATENATESEQ=144,
-               MATOP_DESTROYSUBMATRICES=145
+               MATOP_DESTROYSUBMATRICES=145,
+               MATOP_INVERT_VBLOCK_DIAGONAL=146
              } MatOperation;
 PETSC_EXTERN PetscErrorCode MatSetOperation(Mat,MatOperation,void(*)(void));
 PETSC_EXTERN PetscErrorCode MatGetOperation(Mat,MatOperation,void(**)(void));
@@ -1583,6 +1603,13 @@ PETSC_EXTERN PetscErrorCode MatISRestoreLocalMat(Mat,Mat*);
 PETSC_EXTERN PetscErrorCode MatISSetLocalMat(Mat,Mat);
 PETSC_EXTERN PetscErrorCode MatISGetMPIXAIJ(Mat,MatReuse,Mat*);
 
+PETSC_EXTERN PetscErrorCode MatCreateEBE(MPI_Comm,PetscInt,PetscInt,ISLocalToGlobalMapping,PetscInt,PetscInt,const PetscInt[],Mat*);
+PETSC_EXTERN PetscErrorCode MatEBESetElements(Mat,PetscInt,PetscInt,const PetscInt[]);
+PETSC_EXTERN PetscErrorCode MatEBEGetElements(Mat,PetscInt*,PetscInt*,const PetscInt*[]);
+PETSC_EXTERN PetscErrorCode MatEBEGetArray(Mat,PetscScalar*[]);
+PETSC_EXTERN PetscErrorCode MatEBERestoreArray(Mat,PetscScalar*[]);
+PETSC_EXTERN PetscErrorCode MatEBESetElementValues(Mat,PetscInt,const PetscScalar[],InsertMode);
+
 /*S
      MatNullSpace - Object that removes a null space from a vector, i.e.
          orthogonalizes the vector to a subsapce
@@ -28,6 +28,7 @@ typedef struct _p_MatCoarsen* MatCoarsen;
 J*/
 typedef const char* MatCoarsenType;
 #define MATCOARSENMIS  "mis"
+#define MATCOARSENMIS2 "mis2"
 #define MATCOARSENHEM  "hem"
 
 /* linked list for aggregates */
@@ -134,6 +134,7 @@ PETSC_EXTERN PetscErrorCode PCFactorReorderForNonzeroDiagonal(PC,PetscReal);
 PETSC_EXTERN PetscErrorCode PCFactorSetMatOrderingType(PC,MatOrderingType);
 PETSC_EXTERN PetscErrorCode PCFactorSetReuseOrdering(PC,PetscBool );
 PETSC_EXTERN PetscErrorCode PCFactorSetReuseFill(PC,PetscBool );
+PETSC_EXTERN PetscErrorCode PCFactorSetUpdateRank(PC,PetscInt);
 PETSC_EXTERN PetscErrorCode PCFactorSetUseInPlace(PC,PetscBool);
 PETSC_EXTERN PetscErrorCode PCFactorGetUseInPlace(PC,PetscBool*);
 PETSC_EXTERN PetscErrorCode PCFactorSetAllowDiagonalFill(PC,PetscBool);
@@ -228,6 +229,7 @@ PETSC_EXTERN PetscErrorCode PCFieldSplitSetSchurPre(PC,PCFieldSplitSchurPreType,
 PETSC_EXTERN PetscErrorCode PCFieldSplitGetSchurPre(PC,PCFieldSplitSchurPreType*,Mat*);
 PETSC_EXTERN PetscErrorCode PCFieldSplitSetSchurFactType(PC,PCFieldSplitSchurFactType);
 PETSC_EXTERN PetscErrorCode PCFieldSplitSetSchurScale(PC,PetscScalar);
+PETSC_EXTERN PetscErrorCode PCFieldSplitSetSchurHODLR(PC,PetscReal,PetscInt);
 PETSC_EXTERN PetscErrorCode PCFieldSplitGetSchurBlocks(PC,Mat*,Mat*,Mat*,Mat*);
 PETSC_EXTERN PetscErrorCode PCFieldSplitSchurGetS(PC,Mat *S);
 PETSC_EXTERN PetscErrorCode PCFieldSplitSchurRestoreS(PC,Mat *S);
@@ -259,6 +261,8 @@ PETSC_EXTERN PetscErrorCode PCGAMGSetType( PC,PCGAMGType);
 PETSC_EXTERN PetscErrorCode PCGAMGGetType( PC,PCGAMGType*);
 PETSC_EXTERN PetscErrorCode PCGAMGSetProcEqLim(PC,PetscInt);
 PETSC_EXTERN PetscErrorCode PCGAMGSetRepartition(PC,PetscBool);
+PETSC_EXTERN PetscErrorCode PCGAMGSetProcCostModel(PC,PetscBool);
+PETSC_EXTERN PetscErrorCode PCGAMGSetProcCostModelParameters(PC,PetscReal,PetscReal);
 PETSC_EXTERN PetscErrorCode PCGAMGASMSetUseAggs(PC,PetscBool);
 PETSC_EXTERN PetscErrorCode PCGAMGSetUseParallelCoarseGridSolve(PC,PetscBool);
 PETSC_EXTERN PetscErrorCode PCGAMGSetSolverType(PC,char[],PetscInt);
@@ -306,6 +310,8 @@ PETSC_EXTERN PetscErrorCode PCISSetSubdomainDiagonalScaling(PC,Vec);
 PETSC_EXTERN PetscInt PetscMGLevelId;
 PETSC_EXTERN PetscErrorCode PCMGSetType(PC,PCMGType);
 PETSC_EXTERN PetscErrorCode PCMGGetType(PC,PCMGType*);
+PETSC_EXTERN PetscErrorCode PCMGSetAdditiveType(PC,PCMGAdditiveType);
+PETSC_EXTERN PetscErrorCode PCMGGetAdditiveType(PC,PCMGAdditiveType*);
 PETSC_EXTERN PetscErrorCode PCMGSetLevels(PC,PetscInt,MPI_Comm*);
 PETSC_EXTERN PetscErrorCode PCMGGetLevels(PC,PetscInt*);
 
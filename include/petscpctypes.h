@@ -46,6 +46,7 @@ typedef const char* PCType;
 #define PCNN              "nn"
 #define PCCHOLESKY        "cholesky"
 #define PCPBJACOBI        "pbjacobi"
+#define PCVPBJACOBI       "vpbjacobi"
 #define PCMAT             "mat"
 #define PCHYPRE           "hypre"
 #define PCPARMS           "parms"
@@ -280,6 +281,28 @@ E*/
 typedef enum { PC_MG_CYCLE_V = 1,PC_MG_CYCLE_W = 2 } PCMGCycleType;
 PETSC_EXTERN const char *const PCMGCycleTypes[];
 
+/*E
+    PCMGAdditiveType - The variant of additive multigrid, used with PC_MG_ADDITIVE
+
+   Level: advanced
+
+   Values:
++  PC_MG_ADDITIVE_STANDARD - the restricted right hand side is smoothed on each level independently and the corrections are interpolated and added
+.  PC_MG_ADDITIVE_AFACX - (asynchronous fast adaptive composite) the correction on each level is computed from the residual left after
+                          smoothing the restricted right hand side on the next coarser level, which removes the coarse space component
+-  PC_MG_ADDITIVE_MULT - (mult-additive) the restriction and interpolation are smoothed with l1-Jacobi and a symmetrized smoother is used on each level,
+                         this mimics the multiplicative V-cycle while keeping the levels independent of each other
+
+   Notes:
+    In all variants the levels only depend on each other through the restriction and the interpolation, the smoothing and coarse solves of
+    all the levels are independent.
+
+.seealso: PCMGSetAdditiveType(), PCMGSetType()
+
+E*/
+typedef enum { PC_MG_ADDITIVE_STANDARD,PC_MG_ADDITIVE_AFACX,PC_MG_ADDITIVE_MULT } PCMGAdditiveType;
+PETSC_EXTERN const char *const PCMGAdditiveTypes[];
+
 /*E
     PCMGalerkinType - Determines if the coarse grid operators are computed via the Galerkin process
 
@@ -4144,6 +4144,149 @@ PetscErrorCode PetscFESetUp(PetscFE fem)
   PetscFunctionReturn(0);
 }
 
+static PetscErrorCode PetscFETensorTabulationDestroy_Private(PetscFETensorTabulation **T)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (!*T) PetscFunctionReturn(0);
+  ierr = PetscFree3((*T)->node, (*T)->B1, (*T)->D1);CHKERRQ(ierr);
+  ierr = PetscFree(*T);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+  PetscFEGetTensorTabulation_Private - Factors the default tabulation of a tensor product element into 1D tabulations
+
+  Input Parameter:
+. fem - The PetscFE object
+
+  Output Parameter:
+. T - The factored tabulation, or NULL if the element does not have tensor product structure
+
+  Note: The element is recognized as a tensor product if each basis functional is evaluation at a node of a tensor grid,
+  the quadrature points form a tensor grid with the last coordinate varying fastest, and the products of 1D Lagrange
+  interpolants on the node grid reproduce the default tabulation. The result is cached in the PetscFE.
+*/
+static PetscErrorCode PetscFEGetTensorTabulation_Private(PetscFE fem, PetscFETensorTabulation **T)
+{
+  PetscDualSpace   sp;
+  PetscQuadrature  f;
+  const PetscReal *points, *fpoints;
+  PetscReal       *B, *D, *x1, *y1, *nodes, *B1, *D1;
+  const PetscReal  tol = 1.0e-8;
+  PetscInt        *node;
+  PetscInt         dim, Nc, Nb, Ns, Nq, qNc, Nq1, Nn = 0, fdim, fNp, n, q, d, i, j, k, c, c2;
+  PetscBool        isTensor = PETSC_TRUE;
+  PetscErrorCode   ierr;
+
+  PetscFunctionBegin;
+  if (fem->Tchecked) {*T = fem->T; PetscFunctionReturn(0);}
+  *T = NULL;
+  fem->Tchecked = PETSC_TRUE;
+  ierr = PetscFEGetSpatialDimension(fem, &dim);CHKERRQ(ierr);
+  ierr = PetscFEGetNumComponents(fem, &Nc);CHKERRQ(ierr);
+  ierr = PetscFEGetDimension(fem, &Nb);CHKERRQ(ierr);
+  ierr = PetscFEGetDualSpace(fem, &sp);CHKERRQ(ierr);
+  ierr = PetscQuadratureGetData(fem->quadrature, NULL, &qNc, &Nq, &points, NULL);CHKERRQ(ierr);
+  if ((dim < 1) || (dim > 3) || (qNc != 1) || (Nb % Nc)) PetscFunctionReturn(0);
+  Ns = Nb/Nc;
+  for (Nq1 = 1; PetscPowInt(Nq1, dim) < Nq; ++Nq1);
+  if (PetscPowInt(Nq1, dim) != Nq) PetscFunctionReturn(0);
+  ierr = PetscMalloc4(Nq1, &x1, Ns*dim, &y1, Ns*dim, &nodes, Ns, &node);CHKERRQ(ierr);
+  /* The quadrature must be a tensor grid, with the last coordinate varying fastest */
+  for (i = 0; i < Nq1; ++i) x1[i] = points[i*PetscPowInt(Nq1, dim-1)*dim];
+  for (q = 0; q < Nq && isTensor; ++q) {
+    for (d = 0; d < dim; ++d) {
+      if (PetscAbsReal(points[q*dim+d] - x1[(q/PetscPowInt(Nq1, dim-1-d))%Nq1]) > tol) isTensor = PETSC_FALSE;
+    }
+  }
+  /* Each scalar basis function must be dual to evaluation at a node */
+  for (n = 0; n < Ns && isTensor; ++n) {
+    ierr = PetscDualSpaceGetFunctional(sp, n*Nc, &f);CHKERRQ(ierr);
+    ierr = PetscQuadratureGetData(f, &fdim, NULL, &fNp, &fpoints, NULL);CHKERRQ(ierr);
+    if ((fdim != dim) || (fNp != 1)) {isTensor = PETSC_FALSE; break;}
+    for (d = 0; d < dim; ++d) nodes[n*dim+d] = y1[n*dim+d] = fpoints[d];
+  }
+  /* The nodes must form a tensor grid */
+  if (isTensor) {
+    ierr = PetscSortReal(Ns*dim, y1);CHKERRQ(ierr);
+    for (i = 0; i < Ns*dim; ++i) if (!Nn || (y1[i] - y1[Nn-1] > tol)) y1[Nn++] = y1[i];
+    if (PetscPowInt(Nn, dim) != Ns) isTensor = PETSC_FALSE;
+  }
+  if (isTensor) {
+    PetscBT seen;
+
+    ierr = PetscBTCreate(Ns, &seen);CHKERRQ(ierr);
+    for (n = 0; n < Ns && isTensor; ++n) {
+      for (d = 0, node[n] = 0; d < dim; ++d) {
+        for (i = 0; i < Nn; ++i) if (PetscAbsReal(nodes[n*dim+d] - y1[i]) <= tol) break;
+        if (i == Nn) {isTensor = PETSC_FALSE; break;}
+        node[n] = node[n]*Nn + i;
+      }
+      if (isTensor && PetscBTLookupSet(seen, node[n])) isTensor = PETSC_FALSE;
+    }
+    ierr = PetscBTDestroy(&seen);CHKERRQ(ierr);
+  }
+  if (isTensor) {
+    ierr = PetscMalloc2(Nq1*Nn, &B1, Nq1*Nn, &D1);CHKERRQ(ierr);
+    /* Tabulate the 1D Lagrange interpolants on the nodes */
+    for (q = 0; q < Nq1; ++q) {
+      for (i = 0; i < Nn; ++i) {
+        PetscReal b = 1.0, db = 0.0;
+
+        for (j = 0; j < Nn; ++j) {
+          PetscReal p = 1.0;
+
+          if (j == i) continue;
+          b *= (x1[q] - y1[j])/(y1[i] - y1[j]);
+          for (k = 0; k < Nn; ++k) if ((k != i) && (k != j)) p *= (x1[q] - y1[k])/(y1[i] - y1[k]);
+          db += p/(y1[i] - y1[j]);
+        }
+        B1[q*Nn+i] = b;
+        D1[q*Nn+i] = db;
+      }
+    }
+    /* Check that the products of the 1D interpolants reproduce the default tabulation */
+    ierr = PetscFEGetDefaultTabulation(fem, &B, &D, NULL);CHKERRQ(ierr);
+    for (q = 0; q < Nq && isTensor; ++q) {
+      for (n = 0; n < Ns && isTensor; ++n) {
+        PetscReal b = 1.0, db[3] = {1.0, 1.0, 1.0};
+        PetscInt  e;
+
+        for (d = 0; d < dim; ++d) {
+          const PetscInt qd = (q/PetscPowInt(Nq1, dim-1-d))%Nq1, id = (node[n]/PetscPowInt(Nn, dim-1-d))%Nn;
+
+          b *= B1[qd*Nn+id];
+          for (e = 0; e < dim; ++e) db[e] *= (e == d ? D1[qd*Nn+id] : B1[qd*Nn+id]);
+        }
+        for (c = 0; c < Nc; ++c) {
+          for (c2 = 0; c2 < Nc; ++c2) {
+            const PetscInt bidx = (q*Nb + n*Nc+c)*Nc + c2;
+
+            if (PetscAbsReal(B[bidx] - (c == c2 ? b : 0.0)) > tol*(1.0 + PetscAbsReal(b))) isTensor = PETSC_FALSE;
+            for (e = 0; e < dim; ++e) if (PetscAbsReal(D[bidx*dim+e] - (c == c2 ? db[e] : 0.0)) > tol*(1.0 + PetscAbsReal(db[e]))) isTensor = PETSC_FALSE;
+          }
+        }
+      }
+    }
+    if (isTensor) {
+      ierr = PetscNew(&fem->T);CHKERRQ(ierr);
+      fem->T->Nn = Nn;
+      fem->T->Nq = Nq1;
+      ierr = PetscMalloc3(Ns, &fem->T->node, Nq1*Nn, &fem->T->B1, Nq1*Nn, &fem->T->D1);CHKERRQ(ierr);
+      ierr = PetscMemcpy(fem->T->node, node, Ns * sizeof(PetscInt));CHKERRQ(ierr);
+      ierr = PetscMemcpy(fem->T->B1, B1, Nq1*Nn * sizeof(PetscReal));CHKERRQ(ierr);
+      ierr = PetscMemcpy(fem->T->D1, D1, Nq1*Nn * sizeof(PetscReal));CHKERRQ(ierr);
+    }
+    ierr = PetscFree2(B1, D1);CHKERRQ(ierr);
+  }
+  ierr = PetscFree4(x1, y1, nodes, node);CHKERRQ(ierr);
+  ierr = PetscInfo2(fem, "Tensor product structure %s, %D 1D nodes\n", fem->T ? "found" : "not found", Nn);CHKERRQ(ierr);
+  *T = fem->T;
+  PetscFunctionReturn(0);
+}
+
 /*@
   PetscFEDestroy - Destroys a PetscFE object
 
@@ -4178,6 +4321,7 @@ PetscErrorCode PetscFEDestroy(PetscFE *fem)
   ierr = PetscFERestoreTabulation((*fem), 0, NULL, &(*fem)->B, &(*fem)->D, NULL /*&(*fem)->H*/);CHKERRQ(ierr);
   ierr = PetscFERestoreTabulation((*fem), 0, NULL, &(*fem)->Bf, &(*fem)->Df, NULL /*&(*fem)->Hf*/);CHKERRQ(ierr);
   ierr = PetscFERestoreTabulation((*fem), 0, NULL, &(*fem)->F, NULL, NULL);CHKERRQ(ierr);
+  ierr = PetscFETensorTabulationDestroy_Private(&(*fem)->T);CHKERRQ(ierr);
   ierr = PetscSpaceDestroy(&(*fem)->basisSpace);CHKERRQ(ierr);
   ierr = PetscDualSpaceDestroy(&(*fem)->dualSpace);CHKERRQ(ierr);
   ierr = PetscQuadratureDestroy(&(*fem)->quadrature);CHKERRQ(ierr);
@@ -4323,6 +4467,9 @@ PetscErrorCode PetscFEGetNumComponents(PetscFE fem, PetscInt *comp)
 . batchSize - The number of elements in a batch
 - numBatches - The number of batches in a chunk
 
+  Note: The basic implementation integrates numBlocks cells together, one in each lane of its kernels, so that the
+  innermost loops vectorize across cells. Setting numBlocks to 1 selects the cell-by-cell kernels.
+
   Level: intermediate
 
 .seealso: PetscFECreate()
@@ -4519,6 +4666,8 @@ PetscErrorCode PetscFESetQuadrature(PetscFE fem, PetscQuadrature q)
   ierr = PetscQuadratureGetNumComponents(q, &qNc);CHKERRQ(ierr);
   if ((qNc != 1) && (Nc != qNc)) SETERRQ2(PetscObjectComm((PetscObject) fem), PETSC_ERR_ARG_SIZ, "FE components %D != Quadrature components %D and non-scalar quadrature", Nc, qNc);
   ierr = PetscFERestoreTabulation(fem, 0, NULL, &fem->B, &fem->D, NULL /*&(*fem)->H*/);CHKERRQ(ierr);
+  ierr = PetscFETensorTabulationDestroy_Private(&fem->T);CHKERRQ(ierr);
+  fem->Tchecked = PETSC_FALSE;
   ierr = PetscQuadratureDestroy(&fem->quadrature);CHKERRQ(ierr);
   fem->quadrature = q;
   ierr = PetscObjectReference((PetscObject) q);CHKERRQ(ierr);
@@ -5061,6 +5210,452 @@ PetscErrorCode PetscFEIntegrate_Basic(PetscFE fem, PetscDS prob, PetscInt field,
   PetscFunctionReturn(0);
 }
 
+/*
+  Lane-packed integration: W elements are integrated together, with their coefficients, geometry, field jets, and
+  pointwise results stored in structure-of-arrays layout, x[i*W+w] for item i in lane w. The tabulation contractions
+  then run over lanes in the innermost loop, which vectorizes, so that even low order elements with a handful of
+  quadrature points fill the vector units. The pointwise functions have a single point interface and are called lane
+  by lane. Within each lane, the arithmetic is performed in the same order as the element-by-element kernels.
+*/
+static void PackLanes_Private(PetscInt W, PetscInt nw, PetscInt n, PetscInt stride, const PetscScalar x[], PetscScalar xL[])
+{
+  PetscInt i, w;
+
+  for (w = 0; w < nw; ++w) for (i = 0; i < n; ++i) xL[i*W+w] = x[w*stride+i];
+}
+
+static void EvaluateFieldJetsLanes_Private(PetscInt dim, PetscInt Nf, const PetscInt Nb[], const PetscInt Nc[], PetscInt q, PetscReal *basisField[], PetscReal *basisFieldDer[], PetscInt W, PetscInt nw, const PetscReal invJ[], const PetscScalar coefficients[], const PetscScalar coefficients_t[], PetscScalar refSpaceDer[], PetscScalar u[], PetscScalar u_x[], PetscScalar u_t[])
+{
+  PetscInt dOffset = 0, fOffset = 0, f;
+
+  for (f = 0; f < Nf; ++f) {
+    const PetscInt   Nbf = Nb[f], Ncf = Nc[f];
+    const PetscReal *Bq = &basisField[f][q*Nbf*Ncf];
+    const PetscReal *Dq = &basisFieldDer[f][q*Nbf*Ncf*dim];
+    PetscInt         b, c, d, e, w;
+
+    for (c = 0; c < Ncf; ++c)     for (w = 0; w < nw; ++w) u[(fOffset+c)*W+w] = 0.0;
+    for (d = 0; d < dim*Ncf; ++d) for (w = 0; w < nw; ++w) refSpaceDer[d*W+w] = 0.0;
+    for (b = 0; b < Nbf; ++b) {
+      const PetscScalar *cb = &coefficients[(dOffset+b)*W];
+
+      for (c = 0; c < Ncf; ++c) {
+        const PetscInt cidx = b*Ncf+c;
+        const PetscReal bq  = Bq[cidx];
+
+        for (w = 0; w < nw; ++w) u[(fOffset+c)*W+w] += bq*cb[w];
+        for (d = 0; d < dim; ++d) {
+          const PetscReal dq = Dq[cidx*dim+d];
+
+          for (w = 0; w < nw; ++w) refSpaceDer[(c*dim+d)*W+w] += dq*cb[w];
+        }
+      }
+    }
+    for (c = 0; c < Ncf; ++c) {
+      for (d = 0; d < dim; ++d) {
+        PetscScalar *ux = &u_x[((fOffset+c)*dim+d)*W];
+
+        for (w = 0; w < nw; ++w) ux[w] = 0.0;
+        for (e = 0; e < dim; ++e) for (w = 0; w < nw; ++w) ux[w] += invJ[(e*dim+d)*W+w]*refSpaceDer[(c*dim+e)*W+w];
+      }
+    }
+    if (u_t) {
+      for (c = 0; c < Ncf; ++c) for (w = 0; w < nw; ++w) u_t[(fOffset+c)*W+w] = 0.0;
+      for (b = 0; b < Nbf; ++b) {
+        const PetscScalar *cb = &coefficients_t[(dOffset+b)*W];
+
+        for (c = 0; c < Ncf; ++c) {
+          const PetscReal bq = Bq[b*Ncf+c];
+
+          for (w = 0; w < nw; ++w) u_t[(fOffset+c)*W+w] += bq*cb[w];
+        }
+      }
+    }
+    fOffset += Ncf;
+    dOffset += Nbf;
+  }
+}
+
+static void TransformFLanes_Private(PetscInt dim, PetscInt Nc, PetscInt q, PetscInt W, PetscInt nw, const PetscReal invJ[], const PetscReal detJ[], const PetscReal quadWeights[], PetscScalar refSpaceDer[], PetscScalar f0[], PetscScalar f1[])
+{
+  PetscInt c, d, e, w;
+
+  if (f0) for (c = 0; c < Nc; ++c) for (w = 0; w < nw; ++w) f0[(q*Nc+c)*W+w] *= detJ[w]*quadWeights[q];
+  if (f1) {
+    for (c = 0; c < Nc; ++c) {
+      for (d = 0; d < dim; ++d) {
+        PetscScalar *f1d = &f1[((q*Nc + c)*dim+d)*W];
+
+        for (w = 0; w < nw; ++w) f1d[w] = 0.0;
+        for (e = 0; e < dim; ++e) for (w = 0; w < nw; ++w) f1d[w] += invJ[(d*dim+e)*W+w]*refSpaceDer[(c*dim+e)*W+w];
+        for (w = 0; w < nw; ++w) f1d[w] *= detJ[w]*quadWeights[q];
+      }
+    }
+  }
+}
+
+static void UpdateElementVecLanes_Private(PetscInt dim, PetscInt Nq, PetscInt Nb, PetscInt Nc, PetscInt W, PetscInt nw, const PetscReal basis[], const PetscReal basisDer[], const PetscScalar f0[], const PetscScalar f1[], PetscScalar elemVec[])
+{
+  PetscInt b, c, q, d, w;
+
+  for (b = 0; b < Nb; ++b) {
+    PetscScalar *ev = &elemVec[b*W];
+
+    for (w = 0; w < nw; ++w) ev[w] = 0.0;
+    for (c = 0; c < Nc; ++c) {
+      const PetscInt cidx = b*Nc+c;
+
+      for (q = 0; q < Nq; ++q) {
+        const PetscReal bq = basis[q*Nb*Nc+cidx];
+
+        for (w = 0; w < nw; ++w) ev[w] += bq*f0[(q*Nc+c)*W+w];
+        for (d = 0; d < dim; ++d) {
+          const PetscReal dq = basisDer[(q*Nb*Nc+cidx)*dim+d];
+
+          for (w = 0; w < nw; ++w) ev[w] += dq*f1[((q*Nc+c)*dim+d)*W+w];
+        }
+      }
+    }
+  }
+}
+
+/* Copies the jets of lane w into the single point evaluation arrays */
+static void UnpackJets_Private(PetscInt dim, PetscInt Nc, PetscInt W, PetscInt w, const PetscScalar uL[], const PetscScalar u_xL[], const PetscScalar u_tL[], PetscScalar u[], PetscScalar u_x[], PetscScalar u_t[])
+{
+  PetscInt i;
+
+  for (i = 0; i < Nc; ++i)     u[i]   = uL[i*W+w];
+  for (i = 0; i < Nc*dim; ++i) u_x[i] = u_xL[i*W+w];
+  if (u_tL) for (i = 0; i < Nc; ++i) u_t[i] = u_tL[i*W+w];
+}
+
+/* Packs the inverse Jacobians and determinants of the lanes at quadrature point q */
+static void PackGeometryLanes_Private(PetscFEGeom *geom, PetscInt dim, PetscInt e, PetscInt q, PetscInt W, PetscInt nw, PetscReal invJL[], PetscReal detJL[])
+{
+  const PetscInt Np = geom->numPoints, dE = geom->dimEmbed;
+  PetscInt       i, w;
+
+  for (w = 0; w < nw; ++w) {
+    const PetscReal *invJ = geom->isAffine ? &geom->invJ[(e+w)*dE*dE] : &geom->invJ[((e+w)*Np+q)*dE*dE];
+
+    for (i = 0; i < dim*dim; ++i) invJL[i*W+w] = invJ[i];
+    detJL[w] = geom->isAffine ? geom->detJ[e+w] : geom->detJ[(e+w)*Np+q];
+  }
+}
+
+/* Returns the physical coordinates of quadrature point q in lane w */
+static const PetscReal *GetQuadraturePointLane_Private(PetscFEGeom *geom, PetscInt dim, PetscInt e, PetscInt q, const PetscReal quadPoints[], PetscReal x[])
+{
+  const PetscInt   Np = geom->numPoints, dE = geom->dimEmbed;
+  const PetscReal *v0 = &geom->v[e*Np*dE];
+
+  if (geom->isAffine) {
+    CoordinatesRefToReal(dE, dim, geom->xi, v0, &geom->J[e*Np*dE*dE], &quadPoints[q*dim], x);
+    return x;
+  }
+  return &v0[q*dE];
+}
+
+static PetscErrorCode PetscDSGetMaxComponents_Private(PetscDS prob, PetscInt *NcMax)
+{
+  PetscInt      *Nc, Nf, f;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (!prob) PetscFunctionReturn(0);
+  ierr = PetscDSGetNumFields(prob, &Nf);CHKERRQ(ierr);
+  ierr = PetscDSGetComponents(prob, &Nc);CHKERRQ(ierr);
+  for (f = 0; f < Nf; ++f) *NcMax = PetscMax(*NcMax, Nc[f]);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PetscFEIntegrateResidualLanes_Private(PetscFE fem, PetscDS prob, PetscInt field, PetscInt Ne, PetscFEGeom *cgeom,
+                                                            const PetscScalar coefficients[], const PetscScalar coefficients_t[], PetscDS probAux, const PetscScalar coefficientsAux[], PetscReal t, PetscScalar elemVec[])
+{
+  const PetscInt     W = fem->numBlocks;
+  PetscPointFunc     f0_func;
+  PetscPointFunc     f1_func;
+  PetscQuadrature    quad;
+  PetscScalar       *f0, *f1, *u, *u_t = NULL, *u_x, *a = NULL, *a_x = NULL, *refSpaceDer;
+  PetscScalar       *cL, *c_tL = NULL, *cAuxL = NULL, *uL, *u_tL = NULL, *u_xL, *aL = NULL, *a_xL = NULL, *refL, *f0L, *f1L, *evL;
+  PetscReal         *invJL, *detJL;
+  const PetscScalar *constants;
+  PetscReal         *x;
+  PetscReal        **B, **D, **BAux = NULL, **DAux = NULL;
+  PetscInt          *uOff, *uOff_x, *aOff = NULL, *aOff_x = NULL, *Nb, *Nc, *NbAux = NULL, *NcAux = NULL;
+  PetscInt           dim, numConstants, Nf, NfAux = 0, totDim, totDimAux = 0, NcTot, NcTotAux = 0, NcMax = 0, fOffset, e, NbI, NcI;
+  const PetscReal   *quadPoints, *quadWeights;
+  PetscInt           qNc, Nq, q, i, w;
+  PetscErrorCode     ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscFEGetSpatialDimension(fem, &dim);CHKERRQ(ierr);
+  ierr = PetscFEGetQuadrature(fem, &quad);CHKERRQ(ierr);
+  ierr = PetscDSGetNumFields(prob, &Nf);CHKERRQ(ierr);
+  ierr = PetscDSGetTotalDimension(prob, &totDim);CHKERRQ(ierr);
+  ierr = PetscDSGetTotalComponents(prob, &NcTot);CHKERRQ(ierr);
+  ierr = PetscDSGetDimensions(prob, &Nb);CHKERRQ(ierr);
+  ierr = PetscDSGetComponents(prob, &Nc);CHKERRQ(ierr);
+  ierr = PetscDSGetComponentOffsets(prob, &uOff);CHKERRQ(ierr);
+  ierr = PetscDSGetComponentDerivativeOffsets(prob, &uOff_x);CHKERRQ(ierr);
+  ierr = PetscDSGetFieldOffset(prob, field, &fOffset);CHKERRQ(ierr);
+  ierr = PetscDSGetResidual(prob, field, &f0_func, &f1_func);CHKERRQ(ierr);
+  ierr = PetscDSGetEvaluationArrays(prob, &u, coefficients_t ? &u_t : NULL, &u_x);CHKERRQ(ierr);
+  ierr = PetscDSGetRefCoordArrays(prob, &x, &refSpaceDer);CHKERRQ(ierr);
+  ierr = PetscDSGetWeakFormArrays(prob, &f0, &f1, NULL, NULL, NULL, NULL);CHKERRQ(ierr);
+  ierr = PetscDSGetTabulation(prob, &B, &D);CHKERRQ(ierr);
+  ierr = PetscDSGetConstants(prob, &numConstants, &constants);CHKERRQ(ierr);
+  ierr = PetscDSGetMaxComponents_Private(prob, &NcMax);CHKERRQ(ierr);
+  if (probAux) {
+    ierr = PetscDSGetNumFields(probAux, &NfAux);CHKERRQ(ierr);
+    ierr = PetscDSGetTotalDimension(probAux, &totDimAux);CHKERRQ(ierr);
+    ierr = PetscDSGetTotalComponents(probAux, &NcTotAux);CHKERRQ(ierr);
+    ierr = PetscDSGetDimensions(probAux, &NbAux);CHKERRQ(ierr);
+    ierr = PetscDSGetComponents(probAux, &NcAux);CHKERRQ(ierr);
+    ierr = PetscDSGetComponentOffsets(probAux, &aOff);CHKERRQ(ierr);
+    ierr = PetscDSGetComponentDerivativeOffsets(probAux, &aOff_x);CHKERRQ(ierr);
+    ierr = PetscDSGetEvaluationArrays(probAux, &a, NULL, &a_x);CHKERRQ(ierr);
+    ierr = PetscDSGetTabulation(probAux, &BAux, &DAux);CHKERRQ(ierr);
+    ierr = PetscDSGetMaxComponents_Private(probAux, &NcMax);CHKERRQ(ierr);
+  }
+  NbI = Nb[field];
+  NcI = Nc[field];
+  ierr = PetscQuadratureGetData(quad, NULL, &qNc, &Nq, &quadPoints, &quadWeights);CHKERRQ(ierr);
+  if (qNc != 1) SETERRQ1(PETSC_COMM_SELF, PETSC_ERR_SUP, "Only supports scalar quadrature, not %D components\n", qNc);
+  ierr = PetscMalloc7(totDim*W, &cL, NcTot*W, &uL, NcTot*dim*W, &u_xL, PetscMax(NcMax, NcI)*dim*W, &refL, Nq*NcI*W, &f0L, Nq*NcI*dim*W, &f1L, NbI*W, &evL);CHKERRQ(ierr);
+  ierr = PetscMalloc2(dim*dim*W, &invJL, W, &detJL);CHKERRQ(ierr);
+  if (coefficients_t) {ierr = PetscMalloc2(totDim*W, &c_tL, NcTot*W, &u_tL);CHKERRQ(ierr);}
+  if (probAux)        {ierr = PetscMalloc3(totDimAux*W, &cAuxL, NcTotAux*W, &aL, NcTotAux*dim*W, &a_xL);CHKERRQ(ierr);}
+  for (e = 0; e < Ne; e += W) {
+    const PetscInt nw = PetscMin(W, Ne-e);
+
+    PackLanes_Private(W, nw, totDim, totDim, &coefficients[e*totDim], cL);
+    if (coefficients_t) PackLanes_Private(W, nw, totDim, totDim, &coefficients_t[e*totDim], c_tL);
+    if (probAux)        PackLanes_Private(W, nw, totDimAux, totDimAux, &coefficientsAux[e*totDimAux], cAuxL);
+    ierr = PetscMemzero(f0L, Nq*NcI*W * sizeof(PetscScalar));CHKERRQ(ierr);
+    ierr = PetscMemzero(f1L, Nq*NcI*dim*W * sizeof(PetscScalar));CHKERRQ(ierr);
+    for (q = 0; q < Nq; ++q) {
+      PackGeometryLanes_Private(cgeom, dim, e, q, W, nw, invJL, detJL);
+      EvaluateFieldJetsLanes_Private(dim, Nf, Nb, Nc, q, B, D, W, nw, invJL, cL, c_tL, refL, uL, u_xL, u_tL);
+      if (probAux) EvaluateFieldJetsLanes_Private(dim, NfAux, NbAux, NcAux, q, BAux, DAux, W, nw, invJL, cAuxL, NULL, refL, aL, a_xL, NULL);
+      for (w = 0; w < nw; ++w) {
+        const PetscReal *v = GetQuadraturePointLane_Private(cgeom, dim, e+w, q, quadPoints, x);
+
+        UnpackJets_Private(dim, NcTot, W, w, uL, u_xL, u_tL, u, u_x, u_t);
+        if (probAux) UnpackJets_Private(dim, NcTotAux, W, w, aL, a_xL, NULL, a, a_x, NULL);
+        if (f0_func) {
+          ierr = PetscMemzero(f0, NcI * sizeof(PetscScalar));CHKERRQ(ierr);
+          f0_func(dim, Nf, NfAux, uOff, uOff_x, u, u_t, u_x, aOff, aOff_x, a, NULL, a_x, t, v, numConstants, constants, f0);
+          for (i = 0; i < NcI; ++i) f0L[(q*NcI+i)*W+w] = f0[i];
+        }
+        if (f1_func) {
+          ierr = PetscMemzero(refSpaceDer, NcI*dim * sizeof(PetscScalar));CHKERRQ(ierr);
+          f1_func(dim, Nf, NfAux, uOff, uOff_x, u, u_t, u_x, aOff, aOff_x, a, NULL, a_x, t, v, numConstants, constants, refSpaceDer);
+          for (i = 0; i < NcI*dim; ++i) refL[i*W+w] = refSpaceDer[i];
+        }
+      }
+      TransformFLanes_Private(dim, NcI, q, W, nw, invJL, detJL, quadWeights, refL, f0_func ? f0L : NULL, f1_func ? f1L : NULL);
+    }
+    UpdateElementVecLanes_Private(dim, Nq, NbI, NcI, W, nw, B[field], D[field], f0L, f1L, evL);
+    for (w = 0; w < nw; ++w) for (i = 0; i < NbI; ++i) elemVec[(e+w)*totDim+fOffset+i] = evL[i*W+w];
+  }
+  ierr = PetscFree7(cL, uL, u_xL, refL, f0L, f1L, evL);CHKERRQ(ierr);
+  ierr = PetscFree2(invJL, detJL);CHKERRQ(ierr);
+  if (coefficients_t) {ierr = PetscFree2(c_tL, u_tL);CHKERRQ(ierr);}
+  if (probAux)        {ierr = PetscFree3(cAuxL, aL, a_xL);CHKERRQ(ierr);}
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PetscFEIntegrateJacobianLanes_Private(PetscFE fem, PetscDS prob, PetscFEJacobianType jtype, PetscInt fieldI, PetscInt fieldJ, PetscInt Ne, PetscFEGeom *geom,
+                                                            const PetscScalar coefficients[], const PetscScalar coefficients_t[], PetscDS probAux, const PetscScalar coefficientsAux[], PetscReal t, PetscReal u_tshift, PetscScalar elemMat[])
+{
+  const PetscInt     W = fem->numBlocks;
+  PetscPointJac      g0_func;
+  PetscPointJac      g1_func;
+  PetscPointJac      g2_func;
+  PetscPointJac      g3_func;
+  PetscInt           offsetI = 0; /* Offset into an element vector for fieldI */
+  PetscInt           offsetJ = 0; /* Offset into an element vector for fieldJ */
+  PetscQuadrature    quad;
+  PetscScalar       *g0, *g1, *g2, *g3, *u, *u_t = NULL, *u_x, *a = NULL, *a_x = NULL, *refSpaceDer;
+  PetscScalar       *cL, *c_tL = NULL, *cAuxL = NULL, *uL, *u_tL = NULL, *u_xL, *aL = NULL, *a_xL = NULL, *refL, *g0L, *g1L, *g2L, *g3L, *emL;
+  PetscReal         *invJL, *detJL;
+  const PetscScalar *constants;
+  PetscReal         *x;
+  PetscReal        **B, **D, **BAux = NULL, **DAux = NULL, *BI, *DI, *BJ, *DJ;
+  PetscInt          *uOff, *uOff_x, *aOff = NULL, *aOff_x = NULL, *Nb, *Nc, *NbAux = NULL, *NcAux = NULL;
+  PetscInt           NbI, NcI, NbJ, NcJ;
+  PetscInt           dim, numConstants, Nf, NfAux = 0, totDim, totDimAux = 0, NcTot, NcTotAux = 0, NcMax = 0, e;
+  const PetscReal   *quadPoints, *quadWeights;
+  PetscInt           qNc, Nq, q, i, j, w;
+  PetscErrorCode     ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscFEGetSpatialDimension(fem, &dim);CHKERRQ(ierr);
+  ierr = PetscFEGetQuadrature(fem, &quad);CHKERRQ(ierr);
+  ierr = PetscDSGetNumFields(prob, &Nf);CHKERRQ(ierr);
+  ierr = PetscDSGetTotalDimension(prob, &totDim);CHKERRQ(ierr);
+  ierr = PetscDSGetTotalComponents(prob, &NcTot);CHKERRQ(ierr);
+  ierr = PetscDSGetDimensions(prob, &Nb);CHKERRQ(ierr);
+  ierr = PetscDSGetComponents(prob, &Nc);CHKERRQ(ierr);
+  ierr = PetscDSGetComponentOffsets(prob, &uOff);CHKERRQ(ierr);
+  ierr = PetscDSGetComponentDerivativeOffsets(prob, &uOff_x);CHKERRQ(ierr);
+  switch(jtype) {
+  case PETSCFE_JACOBIAN_DYN: ierr = PetscDSGetDynamicJacobian(prob, fieldI, fieldJ, &g0_func, &g1_func, &g2_func, &g3_func);CHKERRQ(ierr);break;
+  case PETSCFE_JACOBIAN_PRE: ierr = PetscDSGetJacobianPreconditioner(prob, fieldI, fieldJ, &g0_func, &g1_func, &g2_func, &g3_func);CHKERRQ(ierr);break;
+  case PETSCFE_JACOBIAN:     ierr = PetscDSGetJacobian(prob, fieldI, fieldJ, &g0_func, &g1_func, &g2_func, &g3_func);CHKERRQ(ierr);break;
+  }
+  if (!g0_func && !g1_func && !g2_func && !g3_func) PetscFunctionReturn(0);
+  ierr = PetscDSGetEvaluationArrays(prob, &u, coefficients_t ? &u_t : NULL, &u_x);CHKERRQ(ierr);
+  ierr = PetscDSGetRefCoordArrays(prob, &x, &refSpaceDer);CHKERRQ(ierr);
+  ierr = PetscDSGetWeakFormArrays(prob, NULL, NULL, &g0, &g1, &g2, &g3);CHKERRQ(ierr);
+  ierr = PetscDSGetTabulation(prob, &B, &D);CHKERRQ(ierr);
+  ierr = PetscDSGetFieldOffset(prob, fieldI, &offsetI);CHKERRQ(ierr);
+  ierr = PetscDSGetFieldOffset(prob, fieldJ, &offsetJ);CHKERRQ(ierr);
+  ierr = PetscDSGetConstants(prob, &numConstants, &constants);CHKERRQ(ierr);
+  ierr = PetscDSGetMaxComponents_Private(prob, &NcMax);CHKERRQ(ierr);
+  if (probAux) {
+    ierr = PetscDSGetNumFields(probAux, &NfAux);CHKERRQ(ierr);
+    ierr = PetscDSGetTotalDimension(probAux, &totDimAux);CHKERRQ(ierr);
+    ierr = PetscDSGetTotalComponents(probAux, &NcTotAux);CHKERRQ(ierr);
+    ierr = PetscDSGetDimensions(probAux, &NbAux);CHKERRQ(ierr);
+    ierr = PetscDSGetComponents(probAux, &NcAux);CHKERRQ(ierr);
+    ierr = PetscDSGetComponentOffsets(probAux, &aOff);CHKERRQ(ierr);
+    ierr = PetscDSGetComponentDerivativeOffsets(probAux, &aOff_x);CHKERRQ(ierr);
+    ierr = PetscDSGetEvaluationArrays(probAux, &a, NULL, &a_x);CHKERRQ(ierr);
+    ierr = PetscDSGetTabulation(probAux, &BAux, &DAux);CHKERRQ(ierr);
+    ierr = PetscDSGetMaxComponents_Private(probAux, &NcMax);CHKERRQ(ierr);
+  }
+  NbI = Nb[fieldI], NbJ = Nb[fieldJ];
+  NcI = Nc[fieldI], NcJ = Nc[fieldJ];
+  BI  = B[fieldI],  BJ  = B[fieldJ];
+  DI  = D[fieldI],  DJ  = D[fieldJ];
+  ierr = PetscQuadratureGetData(quad, NULL, &qNc, &Nq, &quadPoints, &quadWeights);CHKERRQ(ierr);
+  if (qNc != 1) SETERRQ1(PETSC_COMM_SELF, PETSC_ERR_SUP, "Only supports scalar quadrature, not %D components\n", qNc);
+  ierr = PetscMalloc5(totDim*W, &cL, NcTot*W, &uL, NcTot*dim*W, &u_xL, NcMax*dim*W, &refL, NbI*NbJ*W, &emL);CHKERRQ(ierr);
+  ierr = PetscMalloc4(NcI*NcJ*W, &g0L, NcI*NcJ*dim*W, &g1L, NcI*NcJ*dim*W, &g2L, NcI*NcJ*dim*dim*W, &g3L);CHKERRQ(ierr);
+  ierr = PetscMalloc2(dim*dim*W, &invJL, W, &detJL);CHKERRQ(ierr);
+  if (coefficients_t) {ierr = PetscMalloc2(totDim*W, &c_tL, NcTot*W, &u_tL);CHKERRQ(ierr);}
+  if (probAux)        {ierr = PetscMalloc3(totDimAux*W, &cAuxL, NcTotAux*W, &aL, NcTotAux*dim*W, &a_xL);CHKERRQ(ierr);}
+  /* Initialize here in case the function is not defined */
+  ierr = PetscMemzero(g0L, NcI*NcJ*W * sizeof(PetscScalar));CHKERRQ(ierr);
+  ierr = PetscMemzero(g1L, NcI*NcJ*dim*W * sizeof(PetscScalar));CHKERRQ(ierr);
+  ierr = PetscMemzero(g2L, NcI*NcJ*dim*W * sizeof(PetscScalar));CHKERRQ(ierr);
+  ierr = PetscMemzero(g3L, NcI*NcJ*dim*dim*W * sizeof(PetscScalar));CHKERRQ(ierr);
+  for (e = 0; e < Ne; e += W) {
+    const PetscInt nw = PetscMin(W, Ne-e);
+
+    PackLanes_Private(W, nw, totDim, totDim, &coefficients[e*totDim], cL);
+    if (coefficients_t) PackLanes_Private(W, nw, totDim, totDim, &coefficients_t[e*totDim], c_tL);
+    if (probAux)        PackLanes_Private(W, nw, totDimAux, totDimAux, &coefficientsAux[e*totDimAux], cAuxL);
+    for (w = 0; w < nw; ++w) for (i = 0; i < NbI; ++i) for (j = 0; j < NbJ; ++j) emL[(i*NbJ+j)*W+w] = elemMat[(e+w)*totDim*totDim+(offsetI+i)*totDim+offsetJ+j];
+    for (q = 0; q < Nq; ++q) {
+      const PetscReal *BIq = &BI[q*NbI*NcI], *BJq = &BJ[q*NbJ*NcJ];
+      const PetscReal *DIq = &DI[q*NbI*NcI*dim], *DJq = &DJ[q*NbJ*NcJ*dim];
+      PetscInt         f, g, fc, gc, c, d, d2, dp, d3;
+
+      PackGeometryLanes_Private(geom, dim, e, q, W, nw, invJL, detJL);
+      EvaluateFieldJetsLanes_Private(dim, Nf, Nb, Nc, q, B, D, W, nw, invJL, cL, c_tL, refL, uL, u_xL, u_tL);
+      if (probAux) EvaluateFieldJetsLanes_Private(dim, NfAux, NbAux, NcAux, q, BAux, DAux, W, nw, invJL, cAuxL, NULL, refL, aL, a_xL, NULL);
+      for (w = 0; w < nw; ++w) {
+        const PetscReal *v    = GetQuadraturePointLane_Private(geom, dim, e+w, q, quadPoints, x);
+        const PetscReal *invJ = geom->isAffine ? &geom->invJ[(e+w)*geom->dimEmbed*geom->dimEmbed] : &geom->invJ[((e+w)*geom->numPoints+q)*geom->dimEmbed*geom->dimEmbed];
+        const PetscReal  wgt  = detJL[w]*quadWeights[q];
+
+        UnpackJets_Private(dim, NcTot, W, w, uL, u_xL, u_tL, u, u_x, u_t);
+        if (probAux) UnpackJets_Private(dim, NcTotAux, W, w, aL, a_xL, NULL, a, a_x, NULL);
+        if (g0_func) {
+          ierr = PetscMemzero(g0, NcI*NcJ * sizeof(PetscScalar));CHKERRQ(ierr);
+          g0_func(dim, Nf, NfAux, uOff, uOff_x, u, u_t, u_x, aOff, aOff_x, a, NULL, a_x, t, u_tshift, v, numConstants, constants, g0);
+          for (c = 0; c < NcI*NcJ; ++c) g0L[c*W+w] = g0[c]*wgt;
+        }
+        if (g1_func) {
+          ierr = PetscMemzero(refSpaceDer, NcI*NcJ*dim * sizeof(PetscScalar));CHKERRQ(ierr);
+          g1_func(dim, Nf, NfAux, uOff, uOff_x, u, u_t, u_x, aOff, aOff_x, a, NULL, a_x, t, u_tshift, v, numConstants, constants, refSpaceDer);
+          for (fc = 0; fc < NcI; ++fc) {
+            for (gc = 0; gc < NcJ; ++gc) {
+              for (d = 0; d < dim; ++d) {
+                PetscScalar g1d = 0.0;
+
+                for (d2 = 0; d2 < dim; ++d2) g1d += invJ[d*dim+d2]*refSpaceDer[(fc*NcJ+gc)*dim+d2];
+                g1L[((fc*NcJ+gc)*dim+d)*W+w] = g1d*wgt;
+              }
+            }
+          }
+        }
+        if (g2_func) {
+          ierr = PetscMemzero(refSpaceDer, NcI*NcJ*dim * sizeof(PetscScalar));CHKERRQ(ierr);
+          g2_func(dim, Nf, NfAux, uOff, uOff_x, u, u_t, u_x, aOff, aOff_x, a, NULL, a_x, t, u_tshift, v, numConstants, constants, refSpaceDer);
+          for (fc = 0; fc < NcI; ++fc) {
+            for (gc = 0; gc < NcJ; ++gc) {
+              for (d = 0; d < dim; ++d) {
+                PetscScalar g2d = 0.0;
+
+                for (d2 = 0; d2 < dim; ++d2) g2d += invJ[d*dim+d2]*refSpaceDer[(fc*NcJ+gc)*dim+d2];
+                g2L[((fc*NcJ+gc)*dim+d)*W+w] = g2d*wgt;
+              }
+            }
+          }
+        }
+        if (g3_func) {
+          ierr = PetscMemzero(refSpaceDer, NcI*NcJ*dim*dim * sizeof(PetscScalar));CHKERRQ(ierr);
+          g3_func(dim, Nf, NfAux, uOff, uOff_x, u, u_t, u_x, aOff, aOff_x, a, NULL, a_x, t, u_tshift, v, numConstants, constants, refSpaceDer);
+          for (fc = 0; fc < NcI; ++fc) {
+            for (gc = 0; gc < NcJ; ++gc) {
+              for (d = 0; d < dim; ++d) {
+                for (dp = 0; dp < dim; ++dp) {
+                  PetscScalar g3d = 0.0;
+
+                  for (d2 = 0; d2 < dim; ++d2) {
+                    for (d3 = 0; d3 < dim; ++d3) {
+                      g3d += invJ[d*dim+d2]*refSpaceDer[((fc*NcJ+gc)*dim+d2)*dim+d3]*invJ[dp*dim+d3];
+                    }
+                  }
+                  g3L[(((fc*NcJ+gc)*dim+d)*dim+dp)*W+w] = g3d*wgt;
+                }
+              }
+            }
+          }
+        }
+      }
+      for (f = 0; f < NbI; ++f) {
+        for (fc = 0; fc < NcI; ++fc) {
+          const PetscInt fidx = f*NcI+fc; /* Test function basis index */
+
+          for (g = 0; g < NbJ; ++g) {
+            PetscScalar *em = &emL[(f*NbJ+g)*W];
+
+            for (gc = 0; gc < NcJ; ++gc) {
+              const PetscInt     gidx = g*NcJ+gc; /* Trial function basis index */
+              const PetscScalar *g0q  = &g0L[(fc*NcJ+gc)*W];
+
+              for (w = 0; w < nw; ++w) em[w] += BIq[fidx]*g0q[w]*BJq[gidx];
+              for (d = 0; d < dim; ++d) {
+                const PetscScalar *g1q = &g1L[((fc*NcJ+gc)*dim+d)*W], *g2q = &g2L[((fc*NcJ+gc)*dim+d)*W];
+
+                for (w = 0; w < nw; ++w) em[w] += BIq[fidx]*g1q[w]*DJq[gidx*dim+d];
+                for (w = 0; w < nw; ++w) em[w] += DIq[fidx*dim+d]*g2q[w]*BJq[gidx];
+                for (d2 = 0; d2 < dim; ++d2) {
+                  const PetscScalar *g3q = &g3L[(((fc*NcJ+gc)*dim+d)*dim+d2)*W];
+
+                  for (w = 0; w < nw; ++w) em[w] += DIq[fidx*dim+d]*g3q[w]*DJq[gidx*dim+d2];
+                }
+              }
+            }
+          }
+        }
+      }
+    }
+    for (w = 0; w < nw; ++w) for (i = 0; i < NbI; ++i) for (j = 0; j < NbJ; ++j) elemMat[(e+w)*totDim*totDim+(offsetI+i)*totDim+offsetJ+j] = emL[(i*NbJ+j)*W+w];
+  }
+  ierr = PetscFree5(cL, uL, u_xL, refL, emL);CHKERRQ(ierr);
+  ierr = PetscFree4(g0L, g1L, g2L, g3L);CHKERRQ(ierr);
+  ierr = PetscFree2(invJL, detJL);CHKERRQ(ierr);
+  if (coefficients_t) {ierr = PetscFree2(c_tL, u_tL);CHKERRQ(ierr);}
+  if (probAux)        {ierr = PetscFree3(cAuxL, aL, a_xL);CHKERRQ(ierr);}
+  PetscFunctionReturn(0);
+}
+
 PetscErrorCode PetscFEIntegrateResidual_Basic(PetscFE fem, PetscDS prob, PetscInt field, PetscInt Ne, PetscFEGeom *cgeom,
                                               const PetscScalar coefficients[], const PetscScalar coefficients_t[], PetscDS probAux, const PetscScalar coefficientsAux[], PetscReal t, PetscScalar elemVec[])
 {
@@ -5081,6 +5676,10 @@ PetscErrorCode PetscFEIntegrateResidual_Basic(PetscFE fem, PetscDS prob, PetscIn
   PetscErrorCode     ierr;
 
   PetscFunctionBegin;
+  if (fem->numBlocks > 1) {
+    ierr = PetscFEIntegrateResidualLanes_Private(fem, prob, field, Ne, cgeom, coefficients, coefficients_t, probAux, coefficientsAux, t, elemVec);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
   ierr = PetscFEGetSpatialDimension(fem, &dim);CHKERRQ(ierr);
   ierr = PetscFEGetQuadrature(fem, &quad);CHKERRQ(ierr);
   ierr = PetscDSGetNumFields(prob, &Nf);CHKERRQ(ierr);
@@ -5294,6 +5893,10 @@ PetscErrorCode PetscFEIntegrateJacobian_Basic(PetscFE fem, PetscDS prob, PetscFE
   PetscErrorCode     ierr;
 
   PetscFunctionBegin;
+  if (fem->numBlocks > 1) {
+    ierr = PetscFEIntegrateJacobianLanes_Private(fem, prob, jtype, fieldI, fieldJ, Ne, geom, coefficients, coefficients_t, probAux, coefficientsAux, t, u_tshift, elemMat);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
   ierr = PetscFEGetSpatialDimension(fem, &dim);CHKERRQ(ierr);
   ierr = PetscFEGetQuadrature(fem, &quad);CHKERRQ(ierr);
   ierr = PetscDSGetNumFields(prob, &Nf);CHKERRQ(ierr);
@@ -5470,6 +6073,296 @@ PetscErrorCode PetscFEIntegrateJacobian_Basic(PetscFE fem, PetscDS prob, PetscFE
   PetscFunctionReturn(0);
 }
 
+/* Applies the tensor product operator A[0] x ... x A[dim-1], or its transpose, to x, where each A[d] is an Nq x Nn matrix */
+static void PetscFETensorContract_Private(PetscInt dim, PetscInt Nq, PetscInt Nn, const PetscReal *A[], PetscBool transpose, const PetscScalar x[], PetscScalar work[], PetscScalar y[])
+{
+  const PetscInt     Nin  = transpose ? Nq : Nn;
+  const PetscInt     Nout = transpose ? Nn : Nq;
+  const PetscScalar *src  = x;
+  PetscInt           na   = 1, nb = PetscPowInt(Nin, dim-1), a, b, d, i, j;
+
+  for (d = 0; d < dim; ++d) {
+    /* Alternate buffers so that the last contraction lands in y */
+    PetscScalar *dst = (dim-1-d) % 2 ? work : y;
+
+    for (a = 0; a < na; ++a) {
+      for (j = 0; j < Nout; ++j) {
+        PetscScalar *dj = &dst[(a*Nout+j)*nb];
+
+        for (b = 0; b < nb; ++b) dj[b] = 0.0;
+        for (i = 0; i < Nin; ++i) {
+          const PetscReal    m  = transpose ? A[d][i*Nn+j] : A[d][j*Nn+i];
+          const PetscScalar *si = &src[(a*Nin+i)*nb];
+
+          for (b = 0; b < nb; ++b) dj[b] += m*si[b];
+        }
+      }
+    }
+    src = dst;
+    na *= Nout;
+    if (d < dim-1) nb /= Nin;
+  }
+}
+
+/* Evaluates a field and its reference gradient at all quadrature points by sum factorization */
+static void EvaluateFieldJetsTensor_Private(PetscInt dim, PetscFETensorTabulation *T, PetscInt Nb, PetscInt Nc, const PetscScalar coefficients[], const PetscScalar coefficients_t[], PetscInt NcTot, PetscInt off, PetscScalar *work[], PetscScalar u[], PetscScalar u_x[], PetscScalar u_t[])
+{
+  const PetscInt   Ns = Nb/Nc, Nq = PetscPowInt(T->Nq, dim);
+  const PetscReal *A[3];
+  PetscInt         c, n, q, d, e;
+
+  for (c = 0; c < Nc; ++c) {
+    for (n = 0; n < Ns; ++n) work[0][T->node[n]] = coefficients[n*Nc+c];
+    for (d = 0; d < dim; ++d) A[d] = T->B1;
+    PetscFETensorContract_Private(dim, T->Nq, T->Nn, A, PETSC_FALSE, work[0], work[1], work[2]);
+    for (q = 0; q < Nq; ++q) u[q*NcTot+off+c] = work[2][q];
+    for (e = 0; e < dim; ++e) {
+      for (d = 0; d < dim; ++d) A[d] = d == e ? T->D1 : T->B1;
+      PetscFETensorContract_Private(dim, T->Nq, T->Nn, A, PETSC_FALSE, work[0], work[1], work[2]);
+      for (q = 0; q < Nq; ++q) u_x[(q*NcTot+off+c)*dim+e] = work[2][q];
+    }
+    if (u_t) {
+      for (n = 0; n < Ns; ++n) work[0][T->node[n]] = coefficients_t[n*Nc+c];
+      for (d = 0; d < dim; ++d) A[d] = T->B1;
+      PetscFETensorContract_Private(dim, T->Nq, T->Nn, A, PETSC_FALSE, work[0], work[1], work[2]);
+      for (q = 0; q < Nq; ++q) u_t[q*NcTot+off+c] = work[2][q];
+    }
+  }
+}
+
+/* Integrates the quadrature point values f0 and reference fluxes f1 against the test functions by sum factorization, adding to elemVec */
+static void UpdateElementVecTensor_Private(PetscInt dim, PetscFETensorTabulation *T, PetscInt Nb, PetscInt Nc, const PetscScalar f0[], const PetscScalar f1[], PetscScalar *work[], PetscScalar elemVec[])
+{
+  const PetscInt   Ns = Nb/Nc, Nq = PetscPowInt(T->Nq, dim);
+  const PetscReal *A[3];
+  PetscInt         c, n, q, d, e;
+
+  for (c = 0; c < Nc; ++c) {
+    if (f0) {
+      for (q = 0; q < Nq; ++q) work[0][q] = f0[q*Nc+c];
+      for (d = 0; d < dim; ++d) A[d] = T->B1;
+      PetscFETensorContract_Private(dim, T->Nq, T->Nn, A, PETSC_TRUE, work[0], work[1], work[2]);
+      for (n = 0; n < Ns; ++n) elemVec[n*Nc+c] += work[2][T->node[n]];
+    }
+    if (f1) {
+      for (e = 0; e < dim; ++e) {
+        for (q = 0; q < Nq; ++q) work[0][q] = f1[(q*Nc+c)*dim+e];
+        for (d = 0; d < dim; ++d) A[d] = d == e ? T->D1 : T->B1;
+        PetscFETensorContract_Private(dim, T->Nq, T->Nn, A, PETSC_TRUE, work[0], work[1], work[2]);
+        for (n = 0; n < Ns; ++n) elemVec[n*Nc+c] += work[2][T->node[n]];
+      }
+    }
+  }
+}
+
+/* Maps reference gradients to physical gradients in place */
+static void TransformGradients_Private(PetscInt dim, PetscInt Nc, const PetscReal invJ[], PetscScalar refSpaceDer[], PetscScalar u_x[])
+{
+  PetscInt c, d, e;
+
+  for (c = 0; c < Nc; ++c) {
+    for (d = 0; d < dim; ++d) refSpaceDer[d] = u_x[c*dim+d];
+    for (d = 0; d < dim; ++d) for (e = 0, u_x[c*dim+d] = 0.0; e < dim; ++e) u_x[c*dim+d] += invJ[e*dim+d]*refSpaceDer[e];
+  }
+}
+
+/* Returns the factored tabulations for all fields of prob, or PETSC_FALSE if some field is not a tensor product element on the 1D quadrature of size Nq1 */
+static PetscErrorCode PetscDSGetTensorTabulations_Private(PetscDS prob, PetscInt Nq1, PetscFETensorTabulation *T[], PetscInt *maxSize, PetscBool *isTensor)
+{
+  PetscInt       Nf, dim, f;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscDSGetNumFields(prob, &Nf);CHKERRQ(ierr);
+  ierr = PetscDSGetSpatialDimension(prob, &dim);CHKERRQ(ierr);
+  for (f = 0; f < Nf && *isTensor; ++f) {
+    PetscObject  obj;
+    PetscClassId id;
+
+    ierr = PetscDSGetDiscretization(prob, f, &obj);CHKERRQ(ierr);
+    ierr = PetscObjectGetClassId(obj, &id);CHKERRQ(ierr);
+    if (id != PETSCFE_CLASSID) {*isTensor = PETSC_FALSE; break;}
+    ierr = PetscFEGetTensorTabulation_Private((PetscFE) obj, &T[f]);CHKERRQ(ierr);
+    if (!T[f] || (T[f]->Nq != Nq1)) {*isTensor = PETSC_FALSE; break;}
+    *maxSize = PetscMax(*maxSize, PetscPowInt(PetscMax(T[f]->Nq, T[f]->Nn), dim));
+  }
+  PetscFunctionReturn(0);
+}
+
+/*
+  The action of the element Jacobian is computed without forming the element matrix. The state and input jets are
+  evaluated at the quadrature points, the pointwise Jacobian is applied to the input jet, and the result is tested
+  against the basis. For tensor product elements, evaluation and testing use sum factorization, costing O(k^{d+1})
+  per cell instead of O(k^{2d}).
+*/
+PetscErrorCode PetscFEIntegrateJacobianAction_Basic(PetscFE fem, PetscDS prob, PetscFEJacobianType jtype, PetscInt fieldI, PetscInt fieldJ, PetscInt Ne, PetscFEGeom *geom,
+                                                    const PetscScalar coefficients[], const PetscScalar coefficients_t[], PetscDS probAux, const PetscScalar coefficientsAux[], PetscReal t, PetscReal u_tshift, const PetscScalar input[], PetscScalar elemVec[])
+{
+  PetscPointJac            g0_func;
+  PetscPointJac            g1_func;
+  PetscPointJac            g2_func;
+  PetscPointJac            g3_func;
+  PetscInt                 cOffset    = 0; /* Offset into coefficients[] for element e */
+  PetscInt                 cOffsetAux = 0; /* Offset into coefficientsAux[] for element e */
+  PetscInt                 offsetI    = 0; /* Offset into an element vector for fieldI */
+  PetscInt                 offsetJ    = 0; /* Offset into an element vector for fieldJ */
+  PetscQuadrature          quad;
+  PetscScalar             *g0, *g1, *g2, *g3, *u, *u_t = NULL, *u_x, *a = NULL, *a_x = NULL, *y, *y_x, *f0, *f1, *refSpaceDer, *refSpaceDerAux, *work[3] = {NULL, NULL, NULL};
+  const PetscScalar       *constants;
+  PetscReal               *x;
+  PetscReal              **B, **D, **BAux = NULL, **DAux = NULL;
+  PetscFETensorTabulation *Tfem, **T = NULL, **TAux = NULL;
+  PetscInt                *uOff, *uOff_x, *aOff = NULL, *aOff_x = NULL, *Nb, *Nc, *NbAux = NULL, *NcAux = NULL;
+  PetscInt                 NcI, NcJ, NcTot, NcTotAux = 0, maxSize = 0;
+  PetscInt                 dim, numConstants, Nf, NfAux = 0, totDim, totDimAux = 0, e, f;
+  PetscInt                 dE, Np;
+  PetscBool                isAffine, isTensor;
+  const PetscReal         *quadPoints, *quadWeights;
+  PetscInt                 qNc, Nq, q;
+  PetscErrorCode           ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscFEGetSpatialDimension(fem, &dim);CHKERRQ(ierr);
+  ierr = PetscFEGetQuadrature(fem, &quad);CHKERRQ(ierr);
+  ierr = PetscDSGetNumFields(prob, &Nf);CHKERRQ(ierr);
+  ierr = PetscDSGetTotalDimension(prob, &totDim);CHKERRQ(ierr);
+  ierr = PetscDSGetTotalComponents(prob, &NcTot);CHKERRQ(ierr);
+  ierr = PetscDSGetDimensions(prob, &Nb);CHKERRQ(ierr);
+  ierr = PetscDSGetComponents(prob, &Nc);CHKERRQ(ierr);
+  ierr = PetscDSGetComponentOffsets(prob, &uOff);CHKERRQ(ierr);
+  ierr = PetscDSGetComponentDerivativeOffsets(prob, &uOff_x);CHKERRQ(ierr);
+  switch(jtype) {
+  case PETSCFE_JACOBIAN_DYN: ierr = PetscDSGetDynamicJacobian(prob, fieldI, fieldJ, &g0_func, &g1_func, &g2_func, &g3_func);CHKERRQ(ierr);break;
+  case PETSCFE_JACOBIAN_PRE: ierr = PetscDSGetJacobianPreconditioner(prob, fieldI, fieldJ, &g0_func, &g1_func, &g2_func, &g3_func);CHKERRQ(ierr);break;
+  case PETSCFE_JACOBIAN:     ierr = PetscDSGetJacobian(prob, fieldI, fieldJ, &g0_func, &g1_func, &g2_func, &g3_func);CHKERRQ(ierr);break;
+  }
+  if (!g0_func && !g1_func && !g2_func && !g3_func) PetscFunctionReturn(0);
+  ierr = PetscDSGetRefCoordArrays(prob, &x, &refSpaceDer);CHKERRQ(ierr);
+  ierr = PetscDSGetWeakFormArrays(prob, &f0, &f1, &g0, &g1, &g2, &g3);CHKERRQ(ierr);
+  ierr = PetscDSGetTabulation(prob, &B, &D);CHKERRQ(ierr);
+  ierr = PetscDSGetFieldOffset(prob, fieldI, &offsetI);CHKERRQ(ierr);
+  ierr = PetscDSGetFieldOffset(prob, fieldJ, &offsetJ);CHKERRQ(ierr);
+  ierr = PetscDSGetConstants(prob, &numConstants, &constants);CHKERRQ(ierr);
+  if (probAux) {
+    ierr = PetscDSGetNumFields(probAux, &NfAux);CHKERRQ(ierr);
+    ierr = PetscDSGetTotalDimension(probAux, &totDimAux);CHKERRQ(ierr);
+    ierr = PetscDSGetTotalComponents(probAux, &NcTotAux);CHKERRQ(ierr);
+    ierr = PetscDSGetDimensions(probAux, &NbAux);CHKERRQ(ierr);
+    ierr = PetscDSGetComponents(probAux, &NcAux);CHKERRQ(ierr);
+    ierr = PetscDSGetComponentOffsets(probAux, &aOff);CHKERRQ(ierr);
+    ierr = PetscDSGetComponentDerivativeOffsets(probAux, &aOff_x);CHKERRQ(ierr);
+    ierr = PetscDSGetRefCoordArrays(probAux, NULL, &refSpaceDerAux);CHKERRQ(ierr);
+    ierr = PetscDSGetTabulation(probAux, &BAux, &DAux);CHKERRQ(ierr);
+  }
+  NcI = Nc[fieldI], NcJ = Nc[fieldJ];
+  ierr = PetscQuadratureGetData(quad, NULL, &qNc, &Nq, &quadPoints, &quadWeights);CHKERRQ(ierr);
+  if (qNc != 1) SETERRQ1(PETSC_COMM_SELF, PETSC_ERR_SUP, "Only supports scalar quadrature, not %D components\n", qNc);
+  /* Use sum factorization only if every field, including auxiliary fields, is a tensor product element on the same quadrature */
+  ierr = PetscFEGetTensorTabulation_Private(fem, &Tfem);CHKERRQ(ierr);
+  isTensor = Tfem ? PETSC_TRUE : PETSC_FALSE;
+  ierr = PetscCalloc2(Nf, &T, NfAux, &TAux);CHKERRQ(ierr);
+  if (isTensor) {ierr = PetscDSGetTensorTabulations_Private(prob, Tfem->Nq, T, &maxSize, &isTensor);CHKERRQ(ierr);}
+  if (isTensor && probAux) {ierr = PetscDSGetTensorTabulations_Private(probAux, Tfem->Nq, TAux, &maxSize, &isTensor);CHKERRQ(ierr);}
+  ierr = PetscMalloc4(Nq*NcTot, &u, Nq*NcTot*dim, &u_x, Nq*NcJ, &y, Nq*NcJ*dim, &y_x);CHKERRQ(ierr);
+  if (coefficients_t) {ierr = PetscMalloc1(Nq*NcTot, &u_t);CHKERRQ(ierr);}
+  if (probAux) {ierr = PetscMalloc2(Nq*NcTotAux, &a, Nq*NcTotAux*dim, &a_x);CHKERRQ(ierr);}
+  if (isTensor) {ierr = PetscMalloc3(maxSize, &work[0], maxSize, &work[1], maxSize, &work[2]);CHKERRQ(ierr);}
+  else          {ierr = PetscMalloc1(Nb[fieldI], &work[0]);CHKERRQ(ierr);}
+  Np = geom->numPoints;
+  dE = geom->dimEmbed;
+  isAffine = geom->isAffine;
+  for (e = 0; e < Ne; ++e) {
+    const PetscReal *v0 = &geom->v[e*Np*dE];
+    const PetscReal *J  = &geom->J[e*Np*dE*dE];
+
+    if (isTensor) {
+      PetscInt dOffset;
+
+      for (f = 0, dOffset = 0; f < Nf; dOffset += Nb[f], ++f) {
+        EvaluateFieldJetsTensor_Private(dim, T[f], Nb[f], Nc[f], &coefficients[cOffset+dOffset], coefficients_t ? &coefficients_t[cOffset+dOffset] : NULL, NcTot, uOff[f], work, u, u_x, u_t);
+      }
+      for (f = 0, dOffset = 0; f < NfAux; dOffset += NbAux[f], ++f) {
+        EvaluateFieldJetsTensor_Private(dim, TAux[f], NbAux[f], NcAux[f], &coefficientsAux[cOffsetAux+dOffset], NULL, NcTotAux, aOff[f], work, a, a_x, NULL);
+      }
+      EvaluateFieldJetsTensor_Private(dim, T[fieldJ], Nb[fieldJ], NcJ, &input[cOffset+offsetJ], NULL, NcJ, 0, work, y, y_x, NULL);
+    }
+    for (q = 0; q < Nq; ++q) {
+      PetscScalar     *uq   = &u[q*NcTot],   *u_xq = &u_x[q*NcTot*dim], *u_tq = u_t ? &u_t[q*NcTot] : NULL;
+      PetscScalar     *aq   = a ? &a[q*NcTotAux] : NULL, *a_xq = a_x ? &a_x[q*NcTotAux*dim] : NULL;
+      PetscScalar     *yq   = &y[q*NcJ],     *y_xq = &y_x[q*NcJ*dim];
+      const PetscReal *v;
+      const PetscReal *invJ;
+      PetscReal        detJ;
+      PetscInt         fc, gc, d, d2;
+
+      if (isAffine) {
+        CoordinatesRefToReal(dE, dim, geom->xi, v0, J, &quadPoints[q*dim], x);
+        v = x;
+        invJ = &geom->invJ[e*dE*dE];
+        detJ = geom->detJ[e];
+      } else {
+        v = &v0[q*dE];
+        invJ = &geom->invJ[(e*Np+q)*dE*dE];
+        detJ = geom->detJ[e*Np + q];
+      }
+      if (isTensor) {
+        TransformGradients_Private(dim, NcTot, invJ, refSpaceDer, u_xq);
+        if (probAux) TransformGradients_Private(dim, NcTotAux, invJ, refSpaceDer, a_xq);
+        TransformGradients_Private(dim, NcJ, invJ, refSpaceDer, y_xq);
+      } else {
+        EvaluateFieldJets(dim, Nf, Nb, Nc, q, B, D, refSpaceDer, invJ, &coefficients[cOffset], coefficients_t ? &coefficients_t[cOffset] : NULL, uq, u_xq, u_tq);
+        if (probAux) EvaluateFieldJets(dim, NfAux, NbAux, NcAux, q, BAux, DAux, refSpaceDerAux, invJ, &coefficientsAux[cOffsetAux], NULL, aq, a_xq, NULL);
+        EvaluateFieldJets(dim, 1, &Nb[fieldJ], &NcJ, q, &B[fieldJ], &D[fieldJ], refSpaceDer, invJ, &input[cOffset+offsetJ], NULL, yq, y_xq, NULL);
+      }
+      if (g0_func) {
+        ierr = PetscMemzero(g0, NcI*NcJ * sizeof(PetscScalar));CHKERRQ(ierr);
+        g0_func(dim, Nf, NfAux, uOff, uOff_x, uq, u_tq, u_xq, aOff, aOff_x, aq, NULL, a_xq, t, u_tshift, v, numConstants, constants, g0);
+      }
+      if (g1_func) {
+        ierr = PetscMemzero(g1, NcI*NcJ*dim * sizeof(PetscScalar));CHKERRQ(ierr);
+        g1_func(dim, Nf, NfAux, uOff, uOff_x, uq, u_tq, u_xq, aOff, aOff_x, aq, NULL, a_xq, t, u_tshift, v, numConstants, constants, g1);
+      }
+      if (g2_func) {
+        ierr = PetscMemzero(g2, NcI*NcJ*dim * sizeof(PetscScalar));CHKERRQ(ierr);
+        g2_func(dim, Nf, NfAux, uOff, uOff_x, uq, u_tq, u_xq, aOff, aOff_x, aq, NULL, a_xq, t, u_tshift, v, numConstants, constants, g2);
+      }
+      if (g3_func) {
+        ierr = PetscMemzero(g3, NcI*NcJ*dim*dim * sizeof(PetscScalar));CHKERRQ(ierr);
+        g3_func(dim, Nf, NfAux, uOff, uOff_x, uq, u_tq, u_xq, aOff, aOff_x, aq, NULL, a_xq, t, u_tshift, v, numConstants, constants, g3);
+      }
+      /* Apply the pointwise Jacobian to the input jet, giving f0 and the physical flux in refSpaceDer */
+      for (fc = 0; fc < NcI; ++fc) {
+        f0[q*NcI+fc] = 0.0;
+        for (d = 0; d < dim; ++d) refSpaceDer[fc*dim+d] = 0.0;
+        for (gc = 0; gc < NcJ; ++gc) {
+          if (g0_func) f0[q*NcI+fc] += g0[fc*NcJ+gc]*yq[gc];
+          for (d = 0; d < dim; ++d) {
+            if (g1_func) f0[q*NcI+fc] += g1[(fc*NcJ+gc)*dim+d]*y_xq[gc*dim+d];
+            if (g2_func) refSpaceDer[fc*dim+d] += g2[(fc*NcJ+gc)*dim+d]*yq[gc];
+            if (g3_func) for (d2 = 0; d2 < dim; ++d2) refSpaceDer[fc*dim+d] += g3[((fc*NcJ+gc)*dim+d)*dim+d2]*y_xq[gc*dim+d2];
+          }
+        }
+      }
+      TransformF(dim, NcI, q, invJ, detJ, quadWeights, refSpaceDer, f0, f1);
+    }
+    if (isTensor) {
+      UpdateElementVecTensor_Private(dim, T[fieldI], Nb[fieldI], NcI, g0_func || g1_func ? f0 : NULL, g2_func || g3_func ? f1 : NULL, work, &elemVec[cOffset+offsetI]);
+    } else {
+      UpdateElementVec(dim, Nq, Nb[fieldI], NcI, B[fieldI], D[fieldI], f0, f1, work[0]);
+      for (f = 0; f < Nb[fieldI]; ++f) elemVec[cOffset+offsetI+f] += work[0][f];
+    }
+    cOffset    += totDim;
+    cOffsetAux += totDimAux;
+  }
+  if (isTensor) {ierr = PetscFree3(work[0], work[1], work[2]);CHKERRQ(ierr);}
+  else          {ierr = PetscFree(work[0]);CHKERRQ(ierr);}
+  if (probAux) {ierr = PetscFree2(a, a_x);CHKERRQ(ierr);}
+  ierr = PetscFree(u_t);CHKERRQ(ierr);
+  ierr = PetscFree4(u, u_x, y, y_x);CHKERRQ(ierr);
+  ierr = PetscFree2(T, TAux);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 PetscErrorCode PetscFEIntegrateBdJacobian_Basic(PetscFE fem, PetscDS prob, PetscInt fieldI, PetscInt fieldJ, PetscInt Ne, PetscFEGeom *fgeom,
                                                 const PetscScalar coefficients[], const PetscScalar coefficients_t[], PetscDS probAux, const PetscScalar coefficientsAux[], PetscReal t, PetscReal u_tshift, PetscScalar elemMat[])
 {
@@ -5676,6 +6569,8 @@ PetscErrorCode PetscFEIntegrateBdJacobian_Basic(PetscFE fem, PetscDS prob, Petsc
 PetscErrorCode PetscFEInitialize_Basic(PetscFE fem)
 {
   PetscFunctionBegin;
+  /* The basic implementation packs this many cells into the lanes of its integration kernels */
+  fem->numBlocks                    = 8;
   fem->ops->setfromoptions          = NULL;
   fem->ops->setup                   = PetscFESetUp_Basic;
   fem->ops->view                    = PetscFEView_Basic;
@@ -5685,7 +6580,7 @@ PetscErrorCode PetscFEInitialize_Basic(PetscFE fem)
   fem->ops->integrate               = PetscFEIntegrate_Basic;
   fem->ops->integrateresidual       = PetscFEIntegrateResidual_Basic;
   fem->ops->integratebdresidual     = PetscFEIntegrateBdResidual_Basic;
-  fem->ops->integratejacobianaction = NULL/* PetscFEIntegrateJacobianAction_Basic */;
+  fem->ops->integratejacobianaction = PetscFEIntegrateJacobianAction_Basic;
   fem->ops->integratejacobian       = PetscFEIntegrateJacobian_Basic;
   fem->ops->integratebdjacobian     = PetscFEIntegrateBdJacobian_Basic;
   PetscFunctionReturn(0);
@@ -6492,7 +7387,7 @@ PetscErrorCode PetscFEInitialize_OpenCL(PetscFE fem)
   fem->ops->gettabulation           = PetscFEGetTabulation_Basic;
   fem->ops->integrateresidual       = PetscFEIntegrateResidual_OpenCL;
   fem->ops->integratebdresidual     = NULL/* PetscFEIntegrateBdResidual_OpenCL */;
-  fem->ops->integratejacobianaction = NULL/* PetscFEIntegrateJacobianAction_OpenCL */;
+  fem->ops->integratejacobianaction = PetscFEIntegrateJacobianAction_Basic;
   fem->ops->integratejacobian       = PetscFEIntegrateJacobian_Basic;
   PetscFunctionReturn(0);
 }
@@ -6764,7 +7659,7 @@ PetscErrorCode PetscFEInitialize_Composite(PetscFE fem)
   fem->ops->gettabulation           = PetscFEGetTabulation_Composite;
   fem->ops->integrateresidual       = PetscFEIntegrateResidual_Basic;
   fem->ops->integratebdresidual     = PetscFEIntegrateBdResidual_Basic;
-  fem->ops->integratejacobianaction = NULL/* PetscFEIntegrateJacobianAction_Basic */;
+  fem->ops->integratejacobianaction = PetscFEIntegrateJacobianAction_Basic;
   fem->ops->integratejacobian       = PetscFEIntegrateJacobian_Basic;
   PetscFunctionReturn(0);
 }
@@ -7179,6 +8074,59 @@ PetscErrorCode PetscFEIntegrateJacobian(PetscFE fem, PetscDS prob, PetscFEJacobi
   PetscFunctionReturn(0);
 }
 
+/*@C
+  PetscFEIntegrateJacobianAction - Apply the element Jacobian for a chunk of elements to the input element vectors without forming the element matrices
+
+  Not collective
+
+  Input Parameters:
++ fem          - The PetscFE object for the field being integrated
+. prob         - The PetscDS specifying the discretizations and continuum functions
+. jtype        - The type of matrix pointwise functions that should be used
+. fieldI       - The test field being integrated
+. fieldJ       - The basis field being integrated
+. Ne           - The number of elements in the chunk
+. cgeom        - The cell geometry for each cell in the chunk
+. coefficients - The array of FEM basis coefficients for the elements for the Jacobian evaluation point
+. coefficients_t - The array of FEM basis time derivative coefficients for the elements
+. probAux      - The PetscDS specifying the auxiliary discretizations
+. coefficientsAux - The array of FEM auxiliary basis coefficients for the elements
+. t            - The time
+. u_tShift     - A multiplier for the dF/du_t term (as opposed to the dF/du term)
+- input        - The array of FEM basis coefficients for the elements of the vector the Jacobian is applied to
+
+  Output Parameter
+. elemVec      - the element vectors to which the action of the Jacobian block (fieldI, fieldJ) on input is added
+
+  Note:
+$ Loop over batch of elements (e):
+$   Loop over quadrature points (q):
+$     Make u_q, gradU_q, and y_q, gradY_q for the input (loops over fields,Nb,Ncomp)
+$     f0_{fc} = g0_{fc,gc}(u, \nabla u) y^{gc} + g1_{fc,gc,dg}(u, \nabla u) \nabla y^{gc}
+$     f1_{fc} = g2_{fc,gc,df}(u, \nabla u) y^{gc} + g3_{fc,gc,df,dg}(u, \nabla u) \nabla y^{gc}
+$   Loop over element vector entries (f,fc --> i):
+$     elemVec[i] += \psi^{fc}_f(q) f0_{fc}(q) + \nabla\psi^{fc}_f(q) \cdot f1_{fc}(q)
+
+  For tensor product elements, such as Q_k Lagrange elements on quadrilaterals and hexahedra with a tensor product
+  quadrature, the interpolation to quadrature points and the integration against test functions are done by sum
+  factorization, so that the work per element is O(k^{d+1}) rather than the O(k^{2d}) of forming the element matrix.
+
+  Level: developer
+
+.seealso: PetscFEIntegrateJacobian(), PetscFEIntegrateResidual()
+@*/
+PetscErrorCode PetscFEIntegrateJacobianAction(PetscFE fem, PetscDS prob, PetscFEJacobianType jtype, PetscInt fieldI, PetscInt fieldJ, PetscInt Ne, PetscFEGeom *cgeom,
+                                              const PetscScalar coefficients[], const PetscScalar coefficients_t[], PetscDS probAux, const PetscScalar coefficientsAux[], PetscReal t, PetscReal u_tshift, const PetscScalar input[], PetscScalar elemVec[])
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(fem, PETSCFE_CLASSID, 1);
+  if (!fem->ops->integratejacobianaction) SETERRQ(PetscObjectComm((PetscObject) fem), PETSC_ERR_SUP, "This PetscFE type does not support the matrix-free Jacobian action");
+  ierr = (*fem->ops->integratejacobianaction)(fem, prob, jtype, fieldI, fieldJ, Ne, cgeom, coefficients, coefficients_t, probAux, coefficientsAux, t, u_tshift, input, elemVec);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 /*@C
   PetscFEIntegrateBdJacobian - Produce the boundary element Jacobian for a chunk of elements by quadrature integration
 
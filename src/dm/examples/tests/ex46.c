@@ -0,0 +1,189 @@
+static char help[] = "Tests MATDASTENCIL by comparing it with MATAIJ for the same stencil operator.\n\
+Also checks that the interleaved (tiled) SOR sweeps give the same result as separate sweeps.\n\
+Input parameters include:\n\
+  -dim <dim>      : dimension of the grid\n\
+  -dof <dof>      : degrees of freedom per grid point\n\
+  -sw <sw>        : stencil width\n\
+  -box            : use a box stencil instead of a star stencil\n\
+  -periodic       : use periodic boundary conditions\n\n";
+
+#include <petscdmda.h>
+
+/* fills the complete stencil of every owned row with made up values, the diagonal is made dominant */
+static PetscErrorCode FillStencil(DM da,Mat A)
+{
+  PetscErrorCode  ierr;
+  PetscInt        dim,dof,sw,M,N,P,xs,ys,zs,xm,ym,zm,i,j,k,c,di,dj,dk,b,cnt;
+  DMBoundaryType  bx;
+  DMDAStencilType st;
+  MatStencil      row,*cols;
+  PetscScalar     *vals;
+
+  PetscFunctionBeginUser;
+  ierr = DMDAGetInfo(da,&dim,&M,&N,&P,0,0,0,&dof,&sw,&bx,0,0,&st);CHKERRQ(ierr);
+  ierr = DMDAGetCorners(da,&xs,&ys,&zs,&xm,&ym,&zm);CHKERRQ(ierr);
+  ierr = PetscMalloc2(dof*(2*sw+1)*(2*sw+1)*(2*sw+1),&cols,dof*(2*sw+1)*(2*sw+1)*(2*sw+1),&vals);CHKERRQ(ierr);
+  for (k=zs; k<zs+zm; k++) {
+    for (j=ys; j<ys+ym; j++) {
+      for (i=xs; i<xs+xm; i++) {
+        for (c=0; c<dof; c++) {
+          row.i = i; row.j = j; row.k = k; row.c = c;
+          cnt   = 0;
+          for (dk=(dim > 2 ? -sw : 0); dk<=(dim > 2 ? sw : 0); dk++) {
+            for (dj=(dim > 1 ? -sw : 0); dj<=(dim > 1 ? sw : 0); dj++) {
+              for (di=-sw; di<=sw; di++) {
+                if (st == DMDA_STENCIL_STAR && (di != 0) + (dj != 0) + (dk != 0) > 1) continue;
+                if (bx != DM_BOUNDARY_PERIODIC && (i+di < 0 || i+di >= M || j+dj < 0 || j+dj >= N || k+dk < 0 || k+dk >= P)) continue;
+                for (b=0; b<dof; b++) {
+                  cols[cnt].i = i+di; cols[cnt].j = j+dj; cols[cnt].k = k+dk; cols[cnt].c = b;
+                  vals[cnt++] = (!di && !dj && !dk && b == c) ? 100.0 + i + 2*j + 3*k : -1.0/(1.0 + PetscAbsInt(di+2*dj+3*dk) + b + 2*c);
+                }
+              }
+            }
+          }
+          ierr = MatSetValuesStencil(A,1,&row,cnt,cols,vals,INSERT_VALUES);CHKERRQ(ierr);
+        }
+      }
+    }
+  }
+  ierr = MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = PetscFree2(cols,vals);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* compares MatSOR() of the stencil matrix, with and without tiling, and of the AIJ matrix */
+static PetscErrorCode TestSOR(Mat A,Mat S,Mat Sn,MatSORType flag,PetscInt its,PetscInt lits,PetscBool cmpaij,const char *name)
+{
+  PetscErrorCode ierr;
+  Vec            b,x,xs,xn;
+  PetscRandom    rand;
+  PetscReal      nrm,err;
+  PetscBool      same;
+
+  PetscFunctionBeginUser;
+  ierr = MatCreateVecs(A,&x,&b);CHKERRQ(ierr);
+  ierr = VecDuplicate(x,&xs);CHKERRQ(ierr);
+  ierr = VecDuplicate(x,&xn);CHKERRQ(ierr);
+  ierr = PetscRandomCreate(PetscObjectComm((PetscObject)A),&rand);CHKERRQ(ierr);
+  ierr = PetscRandomSetFromOptions(rand);CHKERRQ(ierr);
+  ierr = VecSetRandom(b,rand);CHKERRQ(ierr);
+  ierr = VecSetRandom(x,rand);CHKERRQ(ierr);
+  ierr = VecCopy(x,xs);CHKERRQ(ierr);
+  ierr = VecCopy(x,xn);CHKERRQ(ierr);
+  ierr = MatSOR(A,b,1.2,flag,0.0,its,lits,x);CHKERRQ(ierr);
+  ierr = MatSOR(S,b,1.2,flag,0.0,its,lits,xs);CHKERRQ(ierr);
+  ierr = MatSOR(Sn,b,1.2,flag,0.0,its,lits,xn);CHKERRQ(ierr);
+  ierr = VecEqual(xs,xn,&same);CHKERRQ(ierr);
+  ierr = PetscPrintf(PETSC_COMM_WORLD,"MatSOR() %s: tiled and separate sweeps %s",name,same ? "agree" : "differ");CHKERRQ(ierr);
+  if (cmpaij) {
+    ierr = VecNorm(x,NORM_2,&nrm);CHKERRQ(ierr);
+    ierr = VecAXPY(x,-1.0,xs);CHKERRQ(ierr);
+    ierr = VecNorm(x,NORM_2,&err);CHKERRQ(ierr);
+    ierr = PetscPrintf(PETSC_COMM_WORLD,", %s MATAIJ",err <= 1.e-12*nrm ? "matches" : "does not match");CHKERRQ(ierr);
+  }
+  ierr = PetscPrintf(PETSC_COMM_WORLD,"\n");CHKERRQ(ierr);
+  ierr = PetscRandomDestroy(&rand);CHKERRQ(ierr);
+  ierr = VecDestroy(&x);CHKERRQ(ierr);
+  ierr = VecDestroy(&b);CHKERRQ(ierr);
+  ierr = VecDestroy(&xs);CHKERRQ(ierr);
+  ierr = VecDestroy(&xn);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+int main(int argc,char **argv)
+{
+  PetscErrorCode ierr;
+  DM             da;
+  Mat            A,S,Sa,Sn;
+  PetscMPIInt    size;
+  Vec            d1,d2;
+  PetscInt       dim = 3,dof = 1,sw = 1,n = 6;
+  PetscBool      box = PETSC_FALSE,periodic = PETSC_FALSE,flg;
+  DMBoundaryType bt;
+
+  ierr = PetscInitialize(&argc,&argv,NULL,help);if (ierr) return ierr;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-dim",&dim,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-dof",&dof,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-sw",&sw,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetBool(NULL,NULL,"-box",&box,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetBool(NULL,NULL,"-periodic",&periodic,NULL);CHKERRQ(ierr);
+  bt   = periodic ? DM_BOUNDARY_PERIODIC : DM_BOUNDARY_NONE;
+  if (dim == 1) {
+    ierr = DMDACreate1d(PETSC_COMM_WORLD,bt,4*n,dof,sw,NULL,&da);CHKERRQ(ierr);
+  } else if (dim == 2) {
+    ierr = DMDACreate2d(PETSC_COMM_WORLD,bt,bt,box ? DMDA_STENCIL_BOX : DMDA_STENCIL_STAR,2*n,n+1,PETSC_DECIDE,PETSC_DECIDE,dof,sw,NULL,NULL,&da);CHKERRQ(ierr);
+  } else {
+    ierr = DMDACreate3d(PETSC_COMM_WORLD,bt,bt,bt,box ? DMDA_STENCIL_BOX : DMDA_STENCIL_STAR,n,n+1,n+2,PETSC_DECIDE,PETSC_DECIDE,PETSC_DECIDE,dof,sw,NULL,NULL,NULL,&da);CHKERRQ(ierr);
+  }
+  ierr = DMSetFromOptions(da);CHKERRQ(ierr);
+  ierr = DMSetUp(da);CHKERRQ(ierr);
+
+  ierr = DMSetMatType(da,MATAIJ);CHKERRQ(ierr);
+  ierr = PetscOptionsSetValue(NULL,"-mat_no_inode",NULL);CHKERRQ(ierr); /* inode SOR only supports omega = 1 */
+  ierr = DMCreateMatrix(da,&A);CHKERRQ(ierr);
+  ierr = FillStencil(da,A);CHKERRQ(ierr);
+  ierr = DMSetMatType(da,MATDASTENCIL);CHKERRQ(ierr);
+  ierr = DMCreateMatrix(da,&S);CHKERRQ(ierr);
+  ierr = FillStencil(da,S);CHKERRQ(ierr);
+  ierr = MatView(S,PETSC_VIEWER_STDOUT_WORLD);CHKERRQ(ierr);
+
+  ierr = MatMultEqual(A,S,5,&flg);CHKERRQ(ierr);
+  ierr = PetscPrintf(PETSC_COMM_WORLD,"MatMult() %s\n",flg ? "matches" : "does not match");CHKERRQ(ierr);
+  ierr = MatMultAddEqual(A,S,5,&flg);CHKERRQ(ierr);
+  ierr = PetscPrintf(PETSC_COMM_WORLD,"MatMultAdd() %s\n",flg ? "matches" : "does not match");CHKERRQ(ierr);
+  ierr = MatCreateVecs(A,&d1,&d2);CHKERRQ(ierr);
+  ierr = MatGetDiagonal(A,d1);CHKERRQ(ierr);
+  ierr = MatGetDiagonal(S,d2);CHKERRQ(ierr);
+  ierr = VecEqual(d1,d2,&flg);CHKERRQ(ierr);
+  ierr = PetscPrintf(PETSC_COMM_WORLD,"MatGetDiagonal() %s\n",flg ? "matches" : "does not match");CHKERRQ(ierr);
+  ierr = MatConvert(S,MATAIJ,MAT_INITIAL_MATRIX,&Sa);CHKERRQ(ierr);
+  ierr = MatEqual(A,Sa,&flg);CHKERRQ(ierr);
+  ierr = PetscPrintf(PETSC_COMM_WORLD,"MatConvert() %s\n",flg ? "matches" : "does not match");CHKERRQ(ierr);
+
+  /* separate sweeps for reference */
+  ierr = MatDuplicate(S,MAT_COPY_VALUES,&Sn);CHKERRQ(ierr);
+  ierr = PetscOptionsSetValue(NULL,"-mat_dastencil_sor_tile","0");CHKERRQ(ierr);
+  ierr = MatSetFromOptions(Sn);CHKERRQ(ierr);
+  ierr = MPI_Comm_size(PETSC_COMM_WORLD,&size);CHKERRQ(ierr);
+  /* with periodic boundaries MATDASTENCIL refreshes the periodic ghost values only between the outer iterations */
+  ierr = TestSOR(A,S,Sn,SOR_LOCAL_FORWARD_SWEEP,2,3,(PetscBool)!periodic,"forward");CHKERRQ(ierr);
+  ierr = TestSOR(A,S,Sn,SOR_LOCAL_BACKWARD_SWEEP,1,4,(PetscBool)!periodic,"backward");CHKERRQ(ierr);
+  ierr = TestSOR(A,S,Sn,SOR_LOCAL_SYMMETRIC_SWEEP,2,2,(PetscBool)!periodic,"symmetric");CHKERRQ(ierr);
+  if (size == 1) {
+    ierr = TestSOR(A,S,Sn,(MatSORType)(SOR_FORWARD_SWEEP | SOR_ZERO_INITIAL_GUESS),3,1,(PetscBool)!periodic,"forward zero guess");CHKERRQ(ierr);
+    ierr = TestSOR(A,S,Sn,(MatSORType)(SOR_SYMMETRIC_SWEEP | SOR_ZERO_INITIAL_GUESS),1,1,(PetscBool)!periodic,"symmetric zero guess");CHKERRQ(ierr);
+  }
+
+  ierr = MatDestroy(&Sn);CHKERRQ(ierr);
+  ierr = VecDestroy(&d1);CHKERRQ(ierr);
+  ierr = VecDestroy(&d2);CHKERRQ(ierr);
+  ierr = MatDestroy(&Sa);CHKERRQ(ierr);
+  ierr = MatDestroy(&S);CHKERRQ(ierr);
+  ierr = MatDestroy(&A);CHKERRQ(ierr);
+  ierr = DMDestroy(&da);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   test:
+      suffix: 3d_star
+
+   test:
+      suffix: 3d_box_2
+      nsize: 3
+      args: -box -dof 2
+
+   test:
+      suffix: 2d_periodic_2
+      nsize: 2
+      args: -dim 2 -box -periodic -sw 2
+
+   test:
+      suffix: 1d_3
+      nsize: 3
+      args: -dim 1 -dof 3 -periodic
+
+TEST*/
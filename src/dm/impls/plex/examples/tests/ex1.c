@@ -400,6 +400,9 @@ int main(int argc, char **argv)
   test:
     suffix: 7
     args: -dim 2 -cell_simplex 0 -interpolate -dm_refine 1 -dm_view ascii::ascii_info_detail
+  test:
+    suffix: 7_compact
+    args: -dim 2 -cell_simplex 0 -interpolate -dm_refine 1 -dm_plex_compact_topology -dm_view ascii::ascii_info_detail
   test:
     suffix: 8
     nsize: 2
@@ -426,6 +429,10 @@ int main(int argc, char **argv)
     suffix: 1d_refine_overlap_1
     nsize: 2
     args: -dim 1 -domain_box_sizes 4 -dm_refine 1 -overlap 1 -petscpartitioner_type simple -dm_view ascii::ascii_info_detail
+  test:
+    suffix: 1d_refine_overlap_1_compact
+    nsize: 2
+    args: -dim 1 -domain_box_sizes 4 -dm_refine 1 -overlap 1 -petscpartitioner_type simple -dm_plex_compact_topology -dm_view ascii::ascii_info_detail
   test:
     suffix: refine_overlap_0
     requires: triangle
@@ -0,0 +1,115 @@
+static char help[] = "Tests the redistribution of an imbalanced mesh by diffusive repartitioning.\n\n";
+
+#include <petscdmplex.h>
+
+typedef struct {
+  PetscInt  faces[2];    /* Number of faces per dimension */
+  PetscBool repartition; /* Rebalance the current distribution instead of partitioning from scratch */
+} AppCtx;
+
+static PetscErrorCode ProcessOptions(MPI_Comm comm, AppCtx *options)
+{
+  PetscInt       n = 2;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  options->faces[0]    = 12;
+  options->faces[1]    = 12;
+  options->repartition = PETSC_TRUE;
+  ierr = PetscOptionsBegin(comm, "", "Repartitioning Test Options", "DMPLEX");CHKERRQ(ierr);
+  ierr = PetscOptionsIntArray("-faces", "Number of faces per dimension", "ex27.c", options->faces, &n, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-repartition", "Rebalance the current distribution", "ex27.c", options->repartition, &options->repartition, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsEnd();
+  PetscFunctionReturn(0);
+}
+
+/* Distributes the mesh so that process 0 gets twice as many cells as the others, as after a local refinement */
+static PetscErrorCode DistributeImbalanced(DM *dm)
+{
+  DM               dmDist = NULL;
+  PetscPartitioner part;
+  PetscInt         *sizes = NULL, *points = NULL, cEnd, c, p;
+  PetscMPIInt      rank, size;
+  PetscErrorCode   ierr;
+
+  PetscFunctionBegin;
+  ierr = MPI_Comm_rank(PetscObjectComm((PetscObject) *dm), &rank);CHKERRQ(ierr);
+  ierr = MPI_Comm_size(PetscObjectComm((PetscObject) *dm), &size);CHKERRQ(ierr);
+  ierr = DMPlexGetHeightStratum(*dm, 0, NULL, &cEnd);CHKERRQ(ierr);
+  if (!rank) {
+    ierr = PetscMalloc2(size, &sizes, cEnd, &points);CHKERRQ(ierr);
+    for (p = 0; p < size; ++p) sizes[p] = ((p+2)*cEnd)/(size+1) - ((p ? p+1 : 0)*cEnd)/(size+1);
+    for (c = 0; c < cEnd; ++c) points[c] = c;
+  }
+  ierr = DMPlexGetPartitioner(*dm, &part);CHKERRQ(ierr);
+  ierr = PetscPartitionerSetType(part, PETSCPARTITIONERSHELL);CHKERRQ(ierr);
+  ierr = PetscPartitionerShellSetPartition(part, size, sizes, points);CHKERRQ(ierr);
+  ierr = PetscFree2(sizes, points);CHKERRQ(ierr);
+  ierr = DMPlexDistribute(*dm, 0, NULL, &dmDist);CHKERRQ(ierr);
+  if (dmDist) {
+    ierr = DMDestroy(dm);CHKERRQ(ierr);
+    *dm  = dmDist;
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PrintCells(DM dm, const char name[])
+{
+  PetscInt       cStart, cEnd, nmin, nmax;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = DMPlexGetHeightStratum(dm, 0, &cStart, &cEnd);CHKERRQ(ierr);
+  nmin = nmax = cEnd - cStart;
+  ierr = MPIU_Allreduce(MPI_IN_PLACE, &nmin, 1, MPIU_INT, MPI_MIN, PetscObjectComm((PetscObject) dm));CHKERRQ(ierr);
+  ierr = MPIU_Allreduce(MPI_IN_PLACE, &nmax, 1, MPIU_INT, MPI_MAX, PetscObjectComm((PetscObject) dm));CHKERRQ(ierr);
+  ierr = PetscPrintf(PetscObjectComm((PetscObject) dm), "%s: between %D and %D cells per process\n", name, nmin, nmax);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+int main(int argc, char **argv)
+{
+  DM               dm, dmDist = NULL;
+  PetscPartitioner part;
+  MatPartitioning  mp;
+  AppCtx           user;
+  PetscInt         cut, migration;
+  PetscErrorCode   ierr;
+
+  ierr = PetscInitialize(&argc, &argv, NULL, help);if (ierr) return ierr;
+  ierr = ProcessOptions(PETSC_COMM_WORLD, &user);CHKERRQ(ierr);
+  ierr = DMPlexCreateBoxMesh(PETSC_COMM_WORLD, 2, PETSC_FALSE, user.faces, NULL, NULL, NULL, PETSC_TRUE, &dm);CHKERRQ(ierr);
+  ierr = DistributeImbalanced(&dm);CHKERRQ(ierr);
+  ierr = PrintCells(dm, "Imbalanced mesh");CHKERRQ(ierr);
+
+  ierr = DMPlexGetPartitioner(dm, &part);CHKERRQ(ierr);
+  ierr = PetscPartitionerSetType(part, PETSCPARTITIONERMATPARTITIONING);CHKERRQ(ierr);
+  ierr = PetscPartitionerMatPartitioningGetMatPartitioning(part, &mp);CHKERRQ(ierr);
+  ierr = MatPartitioningSetType(mp, MATPARTITIONINGMULTILEVEL);CHKERRQ(ierr);
+  ierr = MatPartitioningMultilevelSetRepartition(mp, user.repartition);CHKERRQ(ierr);
+  ierr = PetscPartitionerSetFromOptions(part);CHKERRQ(ierr);
+  ierr = DMPlexDistribute(dm, 0, NULL, &dmDist);CHKERRQ(ierr);
+  ierr = MatPartitioningMultilevelGetEdgeCut(mp, &cut);CHKERRQ(ierr);
+  ierr = MatPartitioningMultilevelGetMigration(mp, &migration);CHKERRQ(ierr);
+  ierr = PrintCells(dmDist, "Redistributed mesh");CHKERRQ(ierr);
+  ierr = PetscPrintf(PETSC_COMM_WORLD, "Edge cut %D, %D cells migrated\n", cut, migration);CHKERRQ(ierr);
+
+  ierr = DMDestroy(&dmDist);CHKERRQ(ierr);
+  ierr = DMDestroy(&dm);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+  test:
+    suffix: 0
+    nsize: 4
+    args: -faces 16,12
+
+  test:
+    suffix: scratch
+    nsize: 4
+    args: -faces 16,12 -repartition 0
+
+TEST*/
@@ -0,0 +1,218 @@
+static char help[] = "Tests the matrix-free Jacobian action against the assembled Jacobian.\n\n";
+
+#include <petscdmplex.h>
+#include <petscds.h>
+#include <petscsnes.h>
+
+typedef struct {
+  PetscInt  dim;         /* Topological dimension */
+  PetscInt  faces[3];    /* Number of faces per dimension */
+  PetscInt  numComp;     /* Number of field components */
+  PetscBool nonAffine;   /* Perturb the coordinates so that cells are not affine */
+} AppCtx;
+
+/* Jacobian of the residual f0_c = u_c^3 + u_c \partial_x u_c, f1_c = (1 + u_c^2) \nabla u_c + u_c e_x */
+static void g0_nl(PetscInt dim, PetscInt Nf, PetscInt NfAux,
+                  const PetscInt uOff[], const PetscInt uOff_x[], const PetscScalar u[], const PetscScalar u_t[], const PetscScalar u_x[],
+                  const PetscInt aOff[], const PetscInt aOff_x[], const PetscScalar a[], const PetscScalar a_t[], const PetscScalar a_x[],
+                  PetscReal t, PetscReal u_tShift, const PetscReal x[], PetscInt numConstants, const PetscScalar constants[], PetscScalar g0[])
+{
+  const PetscInt Nc = uOff[1]-uOff[0];
+  PetscInt       c;
+
+  for (c = 0; c < Nc; ++c) g0[c*Nc+c] = 3.0*u[c]*u[c] + u_x[c*dim+0] + x[0];
+}
+
+static void g1_nl(PetscInt dim, PetscInt Nf, PetscInt NfAux,
+                  const PetscInt uOff[], const PetscInt uOff_x[], const PetscScalar u[], const PetscScalar u_t[], const PetscScalar u_x[],
+                  const PetscInt aOff[], const PetscInt aOff_x[], const PetscScalar a[], const PetscScalar a_t[], const PetscScalar a_x[],
+                  PetscReal t, PetscReal u_tShift, const PetscReal x[], PetscInt numConstants, const PetscScalar constants[], PetscScalar g1[])
+{
+  const PetscInt Nc = uOff[1]-uOff[0];
+  PetscInt       c;
+
+  for (c = 0; c < Nc; ++c) g1[(c*Nc+c)*dim+0] = u[c];
+}
+
+static void g2_nl(PetscInt dim, PetscInt Nf, PetscInt NfAux,
+                  const PetscInt uOff[], const PetscInt uOff_x[], const PetscScalar u[], const PetscScalar u_t[], const PetscScalar u_x[],
+                  const PetscInt aOff[], const PetscInt aOff_x[], const PetscScalar a[], const PetscScalar a_t[], const PetscScalar a_x[],
+                  PetscReal t, PetscReal u_tShift, const PetscReal x[], PetscInt numConstants, const PetscScalar constants[], PetscScalar g2[])
+{
+  const PetscInt Nc = uOff[1]-uOff[0];
+  PetscInt       c, d;
+
+  for (c = 0; c < Nc; ++c) {
+    for (d = 0; d < dim; ++d) g2[(c*Nc+c)*dim+d] = 2.0*u[c]*u_x[c*dim+d];
+    g2[(c*Nc+c)*dim+0] += 1.0;
+  }
+}
+
+static void g3_nl(PetscInt dim, PetscInt Nf, PetscInt NfAux,
+                  const PetscInt uOff[], const PetscInt uOff_x[], const PetscScalar u[], const PetscScalar u_t[], const PetscScalar u_x[],
+                  const PetscInt aOff[], const PetscInt aOff_x[], const PetscScalar a[], const PetscScalar a_t[], const PetscScalar a_x[],
+                  PetscReal t, PetscReal u_tShift, const PetscReal x[], PetscInt numConstants, const PetscScalar constants[], PetscScalar g3[])
+{
+  const PetscInt Nc = uOff[1]-uOff[0];
+  PetscInt       c, d;
+
+  for (c = 0; c < Nc; ++c) for (d = 0; d < dim; ++d) g3[((c*Nc+c)*dim+d)*dim+d] = 1.0 + u[c]*u[c];
+  /* Couple the components through the diffusion */
+  if (Nc > 1) for (d = 0; d < dim; ++d) g3[((0*Nc+1)*dim+d)*dim+d] = 0.5;
+}
+
+static PetscErrorCode ProcessOptions(MPI_Comm comm, AppCtx *options)
+{
+  PetscInt       n = 3;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  options->dim       = 2;
+  options->faces[0]  = 3;
+  options->faces[1]  = 3;
+  options->faces[2]  = 3;
+  options->numComp   = 1;
+  options->nonAffine = PETSC_FALSE;
+  ierr = PetscOptionsBegin(comm, "", "Jacobian Action Test Options", "DMPLEX");CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-dim", "The topological mesh dimension", "ex28.c", options->dim, &options->dim, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsIntArray("-faces", "Number of faces per dimension", "ex28.c", options->faces, &n, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-num_comp", "The number of field components", "ex28.c", options->numComp, &options->numComp, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-non_affine", "Perturb the coordinates so that cells are not affine", "ex28.c", options->nonAffine, &options->nonAffine, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsEnd();
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode CreateMesh(MPI_Comm comm, AppCtx *user, DM *dm)
+{
+  DM             dmDist = NULL;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = DMPlexCreateBoxMesh(comm, user->dim, PETSC_FALSE, user->faces, NULL, NULL, NULL, PETSC_TRUE, dm);CHKERRQ(ierr);
+  ierr = DMPlexDistribute(*dm, 0, NULL, &dmDist);CHKERRQ(ierr);
+  if (dmDist) {
+    ierr = DMDestroy(dm);CHKERRQ(ierr);
+    *dm  = dmDist;
+  }
+  if (user->nonAffine) {
+    Vec          coordinates;
+    PetscScalar *coords;
+    PetscInt     N, i, d;
+
+    ierr = DMGetCoordinatesLocal(*dm, &coordinates);CHKERRQ(ierr);
+    ierr = VecGetLocalSize(coordinates, &N);CHKERRQ(ierr);
+    ierr = VecGetArray(coordinates, &coords);CHKERRQ(ierr);
+    for (i = 0; i < N; i += user->dim) {
+      PetscReal r = 0.0;
+
+      for (d = 0; d < user->dim; ++d) r += PetscRealPart(coords[i+d]);
+      for (d = 0; d < user->dim; ++d) coords[i+d] += 0.1*PetscSinReal(PETSC_PI*(d+1)*r)*PetscRealPart(coords[i+d]);
+    }
+    ierr = VecRestoreArray(coordinates, &coords);CHKERRQ(ierr);
+    ierr = DMSetCoordinatesLocal(*dm, coordinates);CHKERRQ(ierr);
+  }
+  ierr = DMSetFromOptions(*dm);CHKERRQ(ierr);
+  ierr = DMViewFromOptions(*dm, NULL, "-dm_view");CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode SetupDiscretization(DM dm, AppCtx *user)
+{
+  PetscFE        fe;
+  PetscDS        prob;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscFECreateDefault(PetscObjectComm((PetscObject) dm), user->dim, user->numComp, PETSC_FALSE, NULL, -1, &fe);CHKERRQ(ierr);
+  ierr = PetscObjectSetName((PetscObject) fe, "u");CHKERRQ(ierr);
+  ierr = DMGetDS(dm, &prob);CHKERRQ(ierr);
+  ierr = PetscDSSetDiscretization(prob, 0, (PetscObject) fe);CHKERRQ(ierr);
+  ierr = PetscDSSetJacobian(prob, 0, 0, g0_nl, g1_nl, g2_nl, g3_nl);CHKERRQ(ierr);
+  ierr = PetscFEDestroy(&fe);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+int main(int argc, char **argv)
+{
+  DM             dm;
+  Mat            J;
+  Vec            u, y, z, zmf, uloc, yloc, zloc;
+  PetscRandom    rand;
+  PetscReal      norm, error;
+  AppCtx         user;
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc, &argv, NULL, help);if (ierr) return ierr;
+  ierr = ProcessOptions(PETSC_COMM_WORLD, &user);CHKERRQ(ierr);
+  ierr = CreateMesh(PETSC_COMM_WORLD, &user, &dm);CHKERRQ(ierr);
+  ierr = SetupDiscretization(dm, &user);CHKERRQ(ierr);
+
+  ierr = DMCreateGlobalVector(dm, &u);CHKERRQ(ierr);
+  ierr = VecDuplicate(u, &y);CHKERRQ(ierr);
+  ierr = VecDuplicate(u, &z);CHKERRQ(ierr);
+  ierr = VecDuplicate(u, &zmf);CHKERRQ(ierr);
+  ierr = PetscRandomCreate(PETSC_COMM_WORLD, &rand);CHKERRQ(ierr);
+  ierr = PetscRandomSetInterval(rand, -1.0, 1.0);CHKERRQ(ierr);
+  ierr = PetscRandomSetFromOptions(rand);CHKERRQ(ierr);
+  ierr = VecSetRandom(u, rand);CHKERRQ(ierr);
+  ierr = VecSetRandom(y, rand);CHKERRQ(ierr);
+  ierr = DMGetLocalVector(dm, &uloc);CHKERRQ(ierr);
+  ierr = DMGetLocalVector(dm, &yloc);CHKERRQ(ierr);
+  ierr = DMGetLocalVector(dm, &zloc);CHKERRQ(ierr);
+  ierr = DMGlobalToLocalBegin(dm, u, INSERT_VALUES, uloc);CHKERRQ(ierr);
+  ierr = DMGlobalToLocalEnd(dm, u, INSERT_VALUES, uloc);CHKERRQ(ierr);
+  ierr = DMGlobalToLocalBegin(dm, y, INSERT_VALUES, yloc);CHKERRQ(ierr);
+  ierr = DMGlobalToLocalEnd(dm, y, INSERT_VALUES, yloc);CHKERRQ(ierr);
+  /* Assembled Jacobian */
+  ierr = DMCreateMatrix(dm, &J);CHKERRQ(ierr);
+  ierr = DMPlexSNESComputeJacobianFEM(dm, uloc, J, J, NULL);CHKERRQ(ierr);
+  ierr = MatMult(J, y, z);CHKERRQ(ierr);
+  /* Matrix-free Jacobian action */
+  ierr = DMPlexSNESComputeJacobianActionFEM(dm, uloc, yloc, zloc, NULL);CHKERRQ(ierr);
+  ierr = VecSet(zmf, 0.0);CHKERRQ(ierr);
+  ierr = DMLocalToGlobalBegin(dm, zloc, ADD_VALUES, zmf);CHKERRQ(ierr);
+  ierr = DMLocalToGlobalEnd(dm, zloc, ADD_VALUES, zmf);CHKERRQ(ierr);
+  ierr = VecNorm(z, NORM_2, &norm);CHKERRQ(ierr);
+  ierr = VecAXPY(zmf, -1.0, z);CHKERRQ(ierr);
+  ierr = VecNorm(zmf, NORM_2, &error);CHKERRQ(ierr);
+  if (error < 1.0e-10*norm) {ierr = PetscPrintf(PETSC_COMM_WORLD, "Jacobian action matches the assembled Jacobian\n");CHKERRQ(ierr);}
+  else                      {ierr = PetscPrintf(PETSC_COMM_WORLD, "Jacobian action error %g, relative %g\n", (double) error, (double) (error/norm));CHKERRQ(ierr);}
+
+  ierr = DMRestoreLocalVector(dm, &uloc);CHKERRQ(ierr);
+  ierr = DMRestoreLocalVector(dm, &yloc);CHKERRQ(ierr);
+  ierr = DMRestoreLocalVector(dm, &zloc);CHKERRQ(ierr);
+  ierr = PetscRandomDestroy(&rand);CHKERRQ(ierr);
+  ierr = MatDestroy(&J);CHKERRQ(ierr);
+  ierr = VecDestroy(&u);CHKERRQ(ierr);
+  ierr = VecDestroy(&y);CHKERRQ(ierr);
+  ierr = VecDestroy(&z);CHKERRQ(ierr);
+  ierr = VecDestroy(&zmf);CHKERRQ(ierr);
+  ierr = DMDestroy(&dm);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+  test:
+    suffix: q1_2d
+    args: -petscspace_order 1
+
+  test:
+    suffix: q3_2d
+    args: -petscspace_order 3 -non_affine
+
+  test:
+    suffix: q2_2d_vec
+    nsize: 2
+    args: -petscspace_order 2 -num_comp 2 -non_affine -petscpartitioner_type simple
+
+  test:
+    suffix: p2_2d_dg
+    args: -petscspace_order 2 -petscspace_poly_tensor 0 -petscdualspace_lagrange_continuity 0
+
+  test:
+    suffix: q2_3d
+    args: -dim 3 -faces 2,2,2 -petscspace_order 2 -non_affine
+
+TEST*/
@@ -0,0 +1,107 @@
+static char help[] = "Tests the closure coloring used for threaded assembly.\n\n";
+
+#include <petscdmplex.h>
+
+typedef struct {
+  PetscInt  dim;      /* Topological dimension */
+  PetscBool simplex;  /* Use simplices or tensor product cells */
+  PetscInt  faces[3]; /* Number of faces per dimension */
+} AppCtx;
+
+static PetscErrorCode ProcessOptions(MPI_Comm comm, AppCtx *options)
+{
+  PetscInt       n = 3;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  options->dim      = 2;
+  options->simplex  = PETSC_FALSE;
+  options->faces[0] = 4;
+  options->faces[1] = 4;
+  options->faces[2] = 4;
+  ierr = PetscOptionsBegin(comm, "", "Closure Coloring Test Options", "DMPLEX");CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-dim", "The topological mesh dimension", "ex29.c", options->dim, &options->dim, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-simplex", "Use simplices or tensor product cells", "ex29.c", options->simplex, &options->simplex, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsIntArray("-faces", "Number of faces per dimension", "ex29.c", options->faces, &n, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsEnd();
+  PetscFunctionReturn(0);
+}
+
+/* Checks that no point lies in the closures of two cells of the same color */
+static PetscErrorCode CheckColoring(DM dm, ISColoring coloring)
+{
+  IS             *colorIS;
+  PetscInt       *owner, numColors, pStart, pEnd, cStart, k;
+  PetscErrorCode  ierr;
+
+  PetscFunctionBegin;
+  ierr = DMPlexGetChart(dm, &pStart, &pEnd);CHKERRQ(ierr);
+  ierr = DMPlexGetHeightStratum(dm, 0, &cStart, NULL);CHKERRQ(ierr);
+  ierr = PetscMalloc1(pEnd-pStart, &owner);CHKERRQ(ierr);
+  ierr = ISColoringGetIS(coloring, &numColors, &colorIS);CHKERRQ(ierr);
+  for (k = 0; k < numColors; ++k) {
+    const PetscInt *cind;
+    PetscInt        n, i, p;
+
+    for (p = pStart; p < pEnd; ++p) owner[p-pStart] = -1;
+    ierr = ISGetLocalSize(colorIS[k], &n);CHKERRQ(ierr);
+    ierr = ISGetIndices(colorIS[k], &cind);CHKERRQ(ierr);
+    for (i = 0; i < n; ++i) {
+      PetscInt *closure = NULL, clSize, cl;
+
+      ierr = DMPlexGetTransitiveClosure(dm, cStart+cind[i], PETSC_TRUE, &clSize, &closure);CHKERRQ(ierr);
+      for (cl = 0; cl < clSize*2; cl += 2) {
+        const PetscInt q = closure[cl]-pStart;
+
+        if (owner[q] >= 0) SETERRQ4(PETSC_COMM_SELF, PETSC_ERR_PLIB, "Cells %D and %D of color %D share point %D", owner[q], cStart+cind[i], k, closure[cl]);
+        owner[q] = cStart+cind[i];
+      }
+      ierr = DMPlexRestoreTransitiveClosure(dm, cStart+cind[i], PETSC_TRUE, &clSize, &closure);CHKERRQ(ierr);
+    }
+    ierr = ISRestoreIndices(colorIS[k], &cind);CHKERRQ(ierr);
+  }
+  ierr = ISColoringRestoreIS(coloring, &colorIS);CHKERRQ(ierr);
+  ierr = PetscFree(owner);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+int main(int argc, char **argv)
+{
+  DM             dm;
+  IS             cellIS;
+  ISColoring     coloring;
+  AppCtx         user;
+  PetscInt       cStart, cEnd, numColors;
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc, &argv, NULL, help);if (ierr) return ierr;
+  ierr = ProcessOptions(PETSC_COMM_WORLD, &user);CHKERRQ(ierr);
+  ierr = DMPlexCreateBoxMesh(PETSC_COMM_WORLD, user.dim, user.simplex, user.faces, NULL, NULL, NULL, PETSC_TRUE, &dm);CHKERRQ(ierr);
+  ierr = DMPlexGetHeightStratum(dm, 0, &cStart, &cEnd);CHKERRQ(ierr);
+  ierr = ISCreateStride(PETSC_COMM_SELF, cEnd-cStart, cStart, 1, &cellIS);CHKERRQ(ierr);
+  ierr = DMPlexCreateClosureColoring(dm, cellIS, &coloring);CHKERRQ(ierr);
+  ierr = CheckColoring(dm, coloring);CHKERRQ(ierr);
+  ierr = ISColoringGetIS(coloring, &numColors, NULL);CHKERRQ(ierr);
+  ierr = PetscPrintf(PETSC_COMM_SELF, "%D cells in %D colors\n", cEnd-cStart, numColors);CHKERRQ(ierr);
+  ierr = ISColoringDestroy(&coloring);CHKERRQ(ierr);
+  ierr = ISDestroy(&cellIS);CHKERRQ(ierr);
+  ierr = DMDestroy(&dm);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+  test:
+    suffix: quad
+    args: -faces 5,3
+
+  test:
+    suffix: hex
+    args: -dim 3 -faces 3,3,3
+
+  test:
+    suffix: hex_column
+    args: -dim 3 -faces 1,1,4
+
+TEST*/
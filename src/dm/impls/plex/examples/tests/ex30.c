@@ -0,0 +1,201 @@
+static char help[] = "Tests the closure index cache against the usual closure operations.\n\n";
+
+#include <petscdmplex.h>
+
+typedef struct {
+  PetscInt  dim;         /* Topological dimension */
+  PetscInt  faces[3];    /* Number of faces per dimension */
+  PetscBool interpolate; /* Interpolate the mesh */
+  PetscInt  numFields;   /* Number of fields, either 1 or 2 */
+  PetscBool spectral;    /* Use the spectral closure permutation */
+  PetscBool bc;          /* Constrain the first field on the boundary */
+} AppCtx;
+
+static PetscErrorCode ProcessOptions(MPI_Comm comm, AppCtx *options)
+{
+  PetscInt       n = 3;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  options->dim         = 2;
+  options->faces[0]    = 3;
+  options->faces[1]    = 3;
+  options->faces[2]    = 3;
+  options->interpolate = PETSC_TRUE;
+  options->numFields   = 2;
+  options->spectral    = PETSC_FALSE;
+  options->bc          = PETSC_TRUE;
+  ierr = PetscOptionsBegin(comm, "", "Closure Index Cache Test Options", "DMPLEX");CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-dim", "The topological mesh dimension", "ex30.c", options->dim, &options->dim, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsIntArray("-faces", "Number of faces per dimension", "ex30.c", options->faces, &n, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-interpolate", "Interpolate the mesh", "ex30.c", options->interpolate, &options->interpolate, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-num_fields", "The number of fields", "ex30.c", options->numFields, &options->numFields, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-spectral", "Use the spectral closure permutation", "ex30.c", options->spectral, &options->spectral, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-bc", "Constrain the first field on the boundary", "ex30.c", options->bc, &options->bc, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsEnd();
+  if ((options->numFields < 1) || (options->numFields > 2)) SETERRQ1(comm, PETSC_ERR_ARG_OUTOFRANGE, "Number of fields %D must be 1 or 2", options->numFields);
+  PetscFunctionReturn(0);
+}
+
+/* A P2-like scalar field and, optionally, a P1 vector field */
+static PetscErrorCode SetupSection(DM dm, AppCtx *user)
+{
+  PetscSection   section;
+  IS             bcPoints[1] = {NULL};
+  PetscInt       numComp[2]  = {1, 2};
+  PetscInt       numDof[8]   = {0, 0, 0, 0, 0, 0, 0, 0};
+  PetscInt       bcField[1]  = {0};
+  PetscInt       dim, d;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = DMGetDimension(dm, &dim);CHKERRQ(ierr);
+  for (d = 0; d <= dim; ++d) numDof[d] = user->interpolate || !d || d == dim ? 1 : 0;
+  numDof[dim+1] = 2;
+  if (user->bc) {ierr = DMGetStratumIS(dm, "marker", 1, &bcPoints[0]);CHKERRQ(ierr);}
+  ierr = DMPlexCreateSection(dm, dim, user->numFields, numComp, numDof, bcPoints[0] ? 1 : 0, bcField, NULL, bcPoints, NULL, &section);CHKERRQ(ierr);
+  if (user->spectral) {ierr = DMPlexCreateSpectralClosurePermutation(dm, PETSC_DETERMINE, section);CHKERRQ(ierr);}
+  ierr = DMSetDefaultSection(dm, section);CHKERRQ(ierr);
+  ierr = PetscSectionDestroy(&section);CHKERRQ(ierr);
+  ierr = ISDestroy(&bcPoints[0]);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode CheckVecClosures(DM dm, PetscBool *match)
+{
+  Vec            x, y[2];
+  PetscScalar   *a, *values[2] = {NULL, NULL};
+  InsertMode     modes[6] = {INSERT_VALUES, ADD_VALUES, INSERT_ALL_VALUES, ADD_ALL_VALUES, INSERT_BC_VALUES, ADD_BC_VALUES};
+  PetscInt       cStart, cEnd, c, n, i, m, k;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = DMPlexGetHeightStratum(dm, 0, &cStart, &cEnd);CHKERRQ(ierr);
+  ierr = DMCreateLocalVector(dm, &x);CHKERRQ(ierr);
+  ierr = VecGetLocalSize(x, &n);CHKERRQ(ierr);
+  ierr = VecGetArray(x, &a);CHKERRQ(ierr);
+  for (i = 0; i < n; ++i) a[i] = i + 1;
+  ierr = VecRestoreArray(x, &a);CHKERRQ(ierr);
+  /* Gather */
+  for (c = cStart; c < cEnd; ++c) {
+    PetscInt size[2];
+
+    for (k = 0; k < 2; ++k) {
+      ierr = DMPlexSetUseClosureIndexCache(dm, k ? PETSC_TRUE : PETSC_FALSE);CHKERRQ(ierr);
+      ierr = DMPlexVecGetClosure(dm, NULL, x, c, &size[k], &values[k]);CHKERRQ(ierr);
+    }
+    if (size[0] != size[1]) *match = PETSC_FALSE;
+    for (i = 0; i < PetscMin(size[0], size[1]); ++i) if (values[0][i] != values[1][i]) *match = PETSC_FALSE;
+    for (k = 0; k < 2; ++k) {ierr = DMPlexVecRestoreClosure(dm, NULL, x, c, &size[k], &values[k]);CHKERRQ(ierr);}
+  }
+  /* Scatter */
+  for (k = 0; k < 2; ++k) {ierr = VecDuplicate(x, &y[k]);CHKERRQ(ierr);}
+  for (m = 0; m < 6; ++m) {
+    PetscBool equal;
+
+    for (k = 0; k < 2; ++k) {
+      ierr = DMPlexSetUseClosureIndexCache(dm, k ? PETSC_TRUE : PETSC_FALSE);CHKERRQ(ierr);
+      ierr = VecZeroEntries(y[k]);CHKERRQ(ierr);
+      for (c = cStart; c < cEnd; ++c) {
+        PetscInt size;
+
+        ierr = DMPlexVecGetClosure(dm, NULL, x, c, &size, &values[0]);CHKERRQ(ierr);
+        for (i = 0; i < size; ++i) values[0][i] += c;
+        ierr = DMPlexVecSetClosure(dm, NULL, y[k], c, values[0], modes[m]);CHKERRQ(ierr);
+        ierr = DMPlexVecRestoreClosure(dm, NULL, x, c, &size, &values[0]);CHKERRQ(ierr);
+      }
+    }
+    ierr = VecEqual(y[0], y[1], &equal);CHKERRQ(ierr);
+    if (!equal) *match = PETSC_FALSE;
+  }
+  ierr = DMPlexSetUseClosureIndexCache(dm, PETSC_FALSE);CHKERRQ(ierr);
+  for (k = 0; k < 2; ++k) {ierr = VecDestroy(&y[k]);CHKERRQ(ierr);}
+  ierr = VecDestroy(&x);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode CheckMatClosures(DM dm, PetscBool *match)
+{
+  Mat            A[2];
+  Vec            x;
+  PetscScalar   *elemMat;
+  PetscInt       cStart, cEnd, c, i, k;
+  PetscBool      equal;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = DMPlexGetHeightStratum(dm, 0, &cStart, &cEnd);CHKERRQ(ierr);
+  ierr = DMGetLocalVector(dm, &x);CHKERRQ(ierr);
+  for (k = 0; k < 2; ++k) {
+    ierr = DMCreateMatrix(dm, &A[k]);CHKERRQ(ierr);
+    ierr = DMPlexSetUseClosureIndexCache(dm, k ? PETSC_TRUE : PETSC_FALSE);CHKERRQ(ierr);
+    for (c = cStart; c < cEnd; ++c) {
+      PetscInt size;
+
+      ierr = DMPlexVecGetClosure(dm, NULL, x, c, &size, NULL);CHKERRQ(ierr);
+      ierr = PetscMalloc1(size*size, &elemMat);CHKERRQ(ierr);
+      for (i = 0; i < size*size; ++i) elemMat[i] = c + 0.5*i;
+      ierr = DMPlexMatSetClosure(dm, NULL, NULL, A[k], c, elemMat, ADD_VALUES);CHKERRQ(ierr);
+      ierr = PetscFree(elemMat);CHKERRQ(ierr);
+    }
+    ierr = MatAssemblyBegin(A[k], MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+    ierr = MatAssemblyEnd(A[k], MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  }
+  ierr = DMRestoreLocalVector(dm, &x);CHKERRQ(ierr);
+  ierr = DMPlexSetUseClosureIndexCache(dm, PETSC_FALSE);CHKERRQ(ierr);
+  ierr = MatEqual(A[0], A[1], &equal);CHKERRQ(ierr);
+  if (!equal) *match = PETSC_FALSE;
+  for (k = 0; k < 2; ++k) {ierr = MatDestroy(&A[k]);CHKERRQ(ierr);}
+  PetscFunctionReturn(0);
+}
+
+int main(int argc, char **argv)
+{
+  DM             dm, dmDist;
+  AppCtx         user;
+  PetscBool      vmatch = PETSC_TRUE, mmatch = PETSC_TRUE, match;
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc, &argv, NULL, help);if (ierr) return ierr;
+  ierr = ProcessOptions(PETSC_COMM_WORLD, &user);CHKERRQ(ierr);
+  ierr = DMPlexCreateBoxMesh(PETSC_COMM_WORLD, user.dim, PETSC_FALSE, user.faces, NULL, NULL, NULL, user.interpolate, &dm);CHKERRQ(ierr);
+  ierr = DMPlexDistribute(dm, 0, NULL, &dmDist);CHKERRQ(ierr);
+  if (dmDist) {
+    ierr = DMDestroy(&dm);CHKERRQ(ierr);
+    dm   = dmDist;
+  }
+  ierr = SetupSection(dm, &user);CHKERRQ(ierr);
+  ierr = CheckVecClosures(dm, &vmatch);CHKERRQ(ierr);
+  ierr = CheckMatClosures(dm, &mmatch);CHKERRQ(ierr);
+  ierr = MPIU_Allreduce(&vmatch, &match, 1, MPIU_BOOL, MPI_LAND, PETSC_COMM_WORLD);CHKERRQ(ierr);
+  ierr = PetscPrintf(PETSC_COMM_WORLD, "Vec closures %s\n", match ? "match" : "differ");CHKERRQ(ierr);
+  ierr = MPIU_Allreduce(&mmatch, &match, 1, MPIU_BOOL, MPI_LAND, PETSC_COMM_WORLD);CHKERRQ(ierr);
+  ierr = PetscPrintf(PETSC_COMM_WORLD, "Mat closures %s\n", match ? "match" : "differ");CHKERRQ(ierr);
+  ierr = DMDestroy(&dm);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+  test:
+    suffix: quad
+
+  test:
+    suffix: quad_spectral
+    args: -spectral
+
+  test:
+    suffix: quad_uninterpolated
+    args: -interpolate 0 -num_fields 1
+
+  test:
+    suffix: hex
+    args: -dim 3 -faces 2,2,2
+
+  test:
+    suffix: quad_parallel
+    nsize: 2
+    args: -faces 4,4
+
+TEST*/
@@ -0,0 +1,255 @@
+static char help[] = "Tests the locality reordering of distributed meshes.\n\n";
+
+#include <petscdmplex.h>
+#include <petscsf.h>
+
+typedef struct {
+  PetscInt          dim;         /* Topological dimension */
+  PetscInt          faces[3];    /* Number of faces per dimension */
+  PetscBool         interpolate; /* Interpolate the mesh */
+  PetscInt          overlap;     /* The cell overlap of the distribution */
+  DMPlexReorderType reorder;     /* The reordering */
+} AppCtx;
+
+static PetscErrorCode ProcessOptions(MPI_Comm comm, AppCtx *options)
+{
+  PetscInt       n = 3;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  options->dim         = 2;
+  options->faces[0]    = 4;
+  options->faces[1]    = 4;
+  options->faces[2]    = 4;
+  options->interpolate = PETSC_TRUE;
+  options->overlap     = 0;
+  options->reorder     = DMPLEX_REORDER_HILBERT;
+  ierr = PetscOptionsBegin(comm, "", "Mesh Reordering Test Options", "DMPLEX");CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-dim", "The topological mesh dimension", "ex31.c", options->dim, &options->dim, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsIntArray("-faces", "Number of faces per dimension", "ex31.c", options->faces, &n, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-interpolate", "Interpolate the mesh", "ex31.c", options->interpolate, &options->interpolate, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-overlap", "The cell overlap of the distribution", "ex31.c", options->overlap, &options->overlap, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsEnum("-reorder", "The reordering", "ex31.c", DMPlexReorderTypes, (PetscEnum) options->reorder, (PetscEnum *) &options->reorder, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsEnd();
+  PetscFunctionReturn(0);
+}
+
+/* Distributes the mesh, with or without reordering */
+static PetscErrorCode DistributeMesh(DM dm, AppCtx *user, DMPlexReorderType reorder, PetscSF *sf, DM *dmDist)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = DMPlexSetReorderType(dm, reorder);CHKERRQ(ierr);
+  ierr = DMPlexDistribute(dm, user->overlap, sf, dmDist);CHKERRQ(ierr);
+  if (!*dmDist) {
+    ierr = DMPlexReorder(dm, reorder, dmDist);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+/* Checks that the leaves of the point SF are at the end of each stratum, and that they agree with their roots */
+static PetscErrorCode CheckPointSF(DM dm)
+{
+  PetscSF            sf;
+  Vec                coordinates;
+  PetscSection       csection;
+  const PetscScalar *coords;
+  const PetscInt    *leaves;
+  PetscInt          *rootDepth, *leafDepth;
+  PetscScalar       *leafCoords;
+  PetscInt           nroots, nleaves, depth, cdim, pStart, pEnd, d, l;
+  PetscErrorCode     ierr;
+
+  PetscFunctionBegin;
+  ierr = DMGetPointSF(dm, &sf);CHKERRQ(ierr);
+  ierr = PetscSFGetGraph(sf, &nroots, &nleaves, &leaves, NULL);CHKERRQ(ierr);
+  if (nroots < 0) PetscFunctionReturn(0);
+  ierr = DMPlexGetChart(dm, &pStart, &pEnd);CHKERRQ(ierr);
+  ierr = DMPlexGetDepth(dm, &depth);CHKERRQ(ierr);
+  ierr = DMGetCoordinateDim(dm, &cdim);CHKERRQ(ierr);
+  ierr = PetscMalloc2(pEnd-pStart, &rootDepth, pEnd-pStart, &leafDepth);CHKERRQ(ierr);
+  for (d = 0; d <= depth; ++d) {
+    PetscInt sStart, sEnd, p;
+
+    ierr = DMPlexGetDepthStratum(dm, d, &sStart, &sEnd);CHKERRQ(ierr);
+    for (p = sStart; p < sEnd; ++p) rootDepth[p] = d;
+  }
+  ierr = PetscSFBcastBegin(sf, MPIU_INT, rootDepth, leafDepth);CHKERRQ(ierr);
+  ierr = PetscSFBcastEnd(sf, MPIU_INT, rootDepth, leafDepth);CHKERRQ(ierr);
+  for (l = 0; l < nleaves; ++l) {
+    const PetscInt p = leaves ? leaves[l] : l;
+    PetscInt       sStart, sEnd, q;
+
+    if (leafDepth[p] != rootDepth[p]) SETERRQ3(PETSC_COMM_SELF, PETSC_ERR_PLIB, "Leaf %D has depth %D but its root has depth %D", p, rootDepth[p], leafDepth[p]);
+    ierr = DMPlexGetDepthStratum(dm, rootDepth[p], &sStart, &sEnd);CHKERRQ(ierr);
+    for (q = p+1; q < sEnd; ++q) {
+      PetscInt loc;
+
+      ierr = PetscFindInt(q, nleaves, leaves, &loc);CHKERRQ(ierr);
+      if (loc < 0) SETERRQ2(PETSC_COMM_SELF, PETSC_ERR_PLIB, "Leaf %D is followed by the owned point %D in its stratum", p, q);
+    }
+  }
+  ierr = PetscFree2(rootDepth, leafDepth);CHKERRQ(ierr);
+  /* Shared vertices must have the same coordinates */
+  ierr = DMGetCoordinateSection(dm, &csection);CHKERRQ(ierr);
+  ierr = DMGetCoordinatesLocal(dm, &coordinates);CHKERRQ(ierr);
+  ierr = VecGetArrayRead(coordinates, &coords);CHKERRQ(ierr);
+  ierr = PetscMalloc1((pEnd-pStart)*cdim, &leafCoords);CHKERRQ(ierr);
+  {
+    MPI_Datatype unit;
+    PetscScalar *rootCoords;
+    PetscInt     vStart, vEnd, v;
+
+    ierr = DMPlexGetDepthStratum(dm, 0, &vStart, &vEnd);CHKERRQ(ierr);
+    ierr = PetscCalloc1((pEnd-pStart)*cdim, &rootCoords);CHKERRQ(ierr);
+    for (v = vStart; v < vEnd; ++v) {
+      PetscInt off;
+
+      ierr = PetscSectionGetOffset(csection, v, &off);CHKERRQ(ierr);
+      for (d = 0; d < cdim; ++d) rootCoords[v*cdim+d] = coords[off+d];
+    }
+    ierr = MPI_Type_contiguous(cdim, MPIU_SCALAR, &unit);CHKERRQ(ierr);
+    ierr = MPI_Type_commit(&unit);CHKERRQ(ierr);
+    ierr = PetscSFBcastBegin(sf, unit, rootCoords, leafCoords);CHKERRQ(ierr);
+    ierr = PetscSFBcastEnd(sf, unit, rootCoords, leafCoords);CHKERRQ(ierr);
+    ierr = MPI_Type_free(&unit);CHKERRQ(ierr);
+    for (l = 0; l < nleaves; ++l) {
+      const PetscInt p = leaves ? leaves[l] : l;
+
+      if ((p < vStart) || (p >= vEnd)) continue;
+      for (d = 0; d < cdim; ++d) if (PetscAbsScalar(leafCoords[p*cdim+d] - rootCoords[p*cdim+d]) > PETSC_SMALL) SETERRQ1(PETSC_COMM_SELF, PETSC_ERR_PLIB, "Vertex %D does not match its root", p);
+    }
+    ierr = PetscFree(rootCoords);CHKERRQ(ierr);
+  }
+  ierr = PetscFree(leafCoords);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(coordinates, &coords);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* Checks that moving the serial coordinates with the migration SF gives the distributed coordinates */
+static PetscErrorCode CheckMigrationSF(DM dm, PetscSF sf, DM dmDist)
+{
+  PetscSection   csection, newSection;
+  Vec            coordinates, newCoordinates, distCoordinates;
+  PetscReal      norm;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (!sf) PetscFunctionReturn(0);
+  ierr = DMGetCoordinateSection(dm, &csection);CHKERRQ(ierr);
+  ierr = DMGetCoordinatesLocal(dm, &coordinates);CHKERRQ(ierr);
+  ierr = PetscSectionCreate(PetscObjectComm((PetscObject) dm), &newSection);CHKERRQ(ierr);
+  ierr = VecCreate(PETSC_COMM_SELF, &newCoordinates);CHKERRQ(ierr);
+  ierr = DMPlexDistributeField(dm, sf, csection, coordinates, newSection, newCoordinates);CHKERRQ(ierr);
+  ierr = DMGetCoordinatesLocal(dmDist, &distCoordinates);CHKERRQ(ierr);
+  ierr = VecAXPY(newCoordinates, -1.0, distCoordinates);CHKERRQ(ierr);
+  ierr = VecNorm(newCoordinates, NORM_INFINITY, &norm);CHKERRQ(ierr);
+  if (norm > PETSC_SMALL) SETERRQ1(PETSC_COMM_SELF, PETSC_ERR_PLIB, "Migrated coordinates differ by %g", (double) norm);
+  ierr = VecDestroy(&newCoordinates);CHKERRQ(ierr);
+  ierr = PetscSectionDestroy(&newSection);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* The norm of a global vertex field, which must not depend on the numbering */
+static PetscErrorCode ComputeNorm(DM dm, PetscReal *norm)
+{
+  PetscSection       s, csection;
+  Vec                coordinates, u, lu;
+  const PetscScalar *coords;
+  PetscScalar       *a;
+  PetscInt           numDof[4] = {1, 0, 0, 0}, numComp[1] = {1}, dim, cdim, vStart, vEnd, v, d;
+  PetscErrorCode     ierr;
+
+  PetscFunctionBegin;
+  ierr = DMGetDimension(dm, &dim);CHKERRQ(ierr);
+  ierr = DMGetCoordinateDim(dm, &cdim);CHKERRQ(ierr);
+  ierr = DMPlexCreateSection(dm, dim, 1, numComp, numDof, 0, NULL, NULL, NULL, NULL, &s);CHKERRQ(ierr);
+  ierr = DMSetDefaultSection(dm, s);CHKERRQ(ierr);
+  ierr = DMGetLocalVector(dm, &lu);CHKERRQ(ierr);
+  ierr = DMGetGlobalVector(dm, &u);CHKERRQ(ierr);
+  ierr = DMGetCoordinateSection(dm, &csection);CHKERRQ(ierr);
+  ierr = DMGetCoordinatesLocal(dm, &coordinates);CHKERRQ(ierr);
+  ierr = DMPlexGetDepthStratum(dm, 0, &vStart, &vEnd);CHKERRQ(ierr);
+  ierr = VecGetArrayRead(coordinates, &coords);CHKERRQ(ierr);
+  ierr = VecGetArray(lu, &a);CHKERRQ(ierr);
+  for (v = vStart; v < vEnd; ++v) {
+    PetscInt off, coff;
+
+    ierr = PetscSectionGetOffset(s, v, &off);CHKERRQ(ierr);
+    ierr = PetscSectionGetOffset(csection, v, &coff);CHKERRQ(ierr);
+    a[off] = 1.0;
+    for (d = 0; d < cdim; ++d) a[off] += (d+1)*coords[coff+d];
+  }
+  ierr = VecRestoreArray(lu, &a);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(coordinates, &coords);CHKERRQ(ierr);
+  ierr = DMLocalToGlobalBegin(dm, lu, INSERT_VALUES, u);CHKERRQ(ierr);
+  ierr = DMLocalToGlobalEnd(dm, lu, INSERT_VALUES, u);CHKERRQ(ierr);
+  ierr = VecNorm(u, NORM_2, norm);CHKERRQ(ierr);
+  ierr = DMRestoreGlobalVector(dm, &u);CHKERRQ(ierr);
+  ierr = DMRestoreLocalVector(dm, &lu);CHKERRQ(ierr);
+  ierr = PetscSectionDestroy(&s);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+int main(int argc, char **argv)
+{
+  DM             dm, dmDist, dmRef;
+  PetscSF        sf = NULL, sfRef = NULL;
+  AppCtx         user;
+  PetscReal      norm, normRef;
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc, &argv, NULL, help);if (ierr) return ierr;
+  ierr = ProcessOptions(PETSC_COMM_WORLD, &user);CHKERRQ(ierr);
+  ierr = DMPlexCreateBoxMesh(PETSC_COMM_WORLD, user.dim, PETSC_FALSE, user.faces, NULL, NULL, NULL, user.interpolate, &dm);CHKERRQ(ierr);
+  {
+    PetscPartitioner part;
+
+    ierr = DMPlexGetPartitioner(dm, &part);CHKERRQ(ierr);
+    ierr = PetscPartitionerSetFromOptions(part);CHKERRQ(ierr);
+  }
+  ierr = DistributeMesh(dm, &user, DMPLEX_REORDER_NONE, &sfRef, &dmRef);CHKERRQ(ierr);
+  ierr = DistributeMesh(dm, &user, user.reorder, &sf, &dmDist);CHKERRQ(ierr);
+  ierr = DMPlexCheckSymmetry(dmDist);CHKERRQ(ierr);
+  ierr = DMPlexCheckSkeleton(dmDist, PETSC_FALSE, 0);CHKERRQ(ierr);
+  if (user.interpolate) {ierr = DMPlexCheckFaces(dmDist, PETSC_FALSE, 0);CHKERRQ(ierr);}
+  ierr = CheckPointSF(dmDist);CHKERRQ(ierr);
+  ierr = CheckMigrationSF(dm, sf, dmDist);CHKERRQ(ierr);
+  ierr = ComputeNorm(dmRef, &normRef);CHKERRQ(ierr);
+  ierr = ComputeNorm(dmDist, &norm);CHKERRQ(ierr);
+  if (PetscAbsReal(norm - normRef) > PETSC_SMALL*normRef) SETERRQ2(PETSC_COMM_WORLD, PETSC_ERR_PLIB, "Norm %g of the reordered mesh differs from %g", (double) norm, (double) normRef);
+  ierr = PetscPrintf(PETSC_COMM_WORLD, "Reordered mesh with %s is valid\n", DMPlexReorderTypes[user.reorder]);CHKERRQ(ierr);
+  ierr = PetscSFDestroy(&sf);CHKERRQ(ierr);
+  ierr = PetscSFDestroy(&sfRef);CHKERRQ(ierr);
+  ierr = DMDestroy(&dmDist);CHKERRQ(ierr);
+  ierr = DMDestroy(&dmRef);CHKERRQ(ierr);
+  ierr = DMDestroy(&dm);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+  test:
+    suffix: quad_hilbert
+
+  test:
+    suffix: hex_morton
+    args: -dim 3 -faces 3,3,3 -reorder morton
+
+  test:
+    suffix: quad_rcm_uninterpolated
+    args: -interpolate 0 -reorder rcm
+
+  test:
+    suffix: quad_hilbert_parallel
+    nsize: 3
+    args: -faces 6,5 -petscpartitioner_type simple
+
+  test:
+    suffix: hex_hilbert_overlap
+    nsize: 2
+    args: -dim 3 -faces 3,3,2 -overlap 1 -petscpartitioner_type simple
+
+TEST*/
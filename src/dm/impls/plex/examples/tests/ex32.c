@@ -0,0 +1,448 @@
+static char help[] = "Tests the parallel construction of a mesh from chunks of its DAG.\n\n";
+
+#include <petscdmplex.h>
+#include <petscsf.h>
+#include <petscviewerhdf5.h>
+#include <petscbt.h>
+
+typedef struct {
+  PetscInt  dim;         /* Topological dimension */
+  PetscInt  faces[3];    /* Number of faces per dimension */
+  PetscBool interpolate; /* Interpolate the mesh */
+  PetscBool reverse;     /* Give the points in reverse order, instead of the order of the serial mesh */
+  PetscBool hdf5;        /* Compare the serial and the parallel load of a mesh written with DMView() */
+  char      filename[PETSC_MAX_PATH_LEN]; /* The HDF5 file, which is only read if it is given */
+} AppCtx;
+
+static PetscErrorCode ProcessOptions(MPI_Comm comm, AppCtx *options)
+{
+  PetscInt       n = 3;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  options->dim         = 2;
+  options->faces[0]    = 4;
+  options->faces[1]    = 4;
+  options->faces[2]    = 4;
+  options->interpolate = PETSC_TRUE;
+  options->reverse     = PETSC_FALSE;
+  options->hdf5        = PETSC_FALSE;
+  options->filename[0] = '\0';
+  ierr = PetscOptionsBegin(comm, "", "Parallel DAG Test Options", "DMPLEX");CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-dim", "The topological mesh dimension", "ex32.c", options->dim, &options->dim, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsIntArray("-faces", "Number of faces per dimension", "ex32.c", options->faces, &n, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-interpolate", "Interpolate the mesh", "ex32.c", options->interpolate, &options->interpolate, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-reverse", "Give the points in reverse order", "ex32.c", options->reverse, &options->reverse, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-hdf5", "Compare the serial and the parallel load of a mesh written with DMView()", "ex32.c", options->hdf5, &options->hdf5, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsString("-f", "HDF5 file to load, instead of writing a box mesh", "ex32.c", options->filename, options->filename, PETSC_MAX_PATH_LEN, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsEnd();
+  PetscFunctionReturn(0);
+}
+
+/* Every process holds the serial mesh, and passes its chunk of the points, as if it had read them from a file */
+static PetscErrorCode CreateParallelMesh(DM serialDM, AppCtx *user, IS *globalPoints, PetscSF *ownershipSF, DM *dm)
+{
+  MPI_Comm           comm = PETSC_COMM_WORLD;
+  PetscLayout        layout;
+  PetscSection       coordSection;
+  Vec                coordinates;
+  const PetscScalar *coords;
+  const PetscInt    *gpoint;
+  PetscInt          *points, *coneSize, *cones, *ornts;
+  PetscInt           pStart, pEnd, vStart, vEnd, rStart, rEnd, vrStart, vrEnd, numCones = 0, r, c;
+  PetscErrorCode     ierr;
+
+  PetscFunctionBegin;
+  ierr = DMPlexGetChart(serialDM, &pStart, &pEnd);CHKERRQ(ierr);
+  ierr = DMPlexGetDepthStratum(serialDM, 0, &vStart, &vEnd);CHKERRQ(ierr);
+  ierr = DMPlexCreatePointNumbering(serialDM, globalPoints);CHKERRQ(ierr);
+  ierr = ISGetIndices(*globalPoints, &gpoint);CHKERRQ(ierr);
+  ierr = PetscLayoutCreate(comm, &layout);CHKERRQ(ierr);
+  ierr = PetscLayoutSetSize(layout, pEnd-pStart);CHKERRQ(ierr);
+  ierr = PetscLayoutSetBlockSize(layout, 1);CHKERRQ(ierr);
+  ierr = PetscLayoutSetUp(layout);CHKERRQ(ierr);
+  ierr = PetscLayoutGetRange(layout, &rStart, &rEnd);CHKERRQ(ierr);
+  ierr = PetscLayoutDestroy(&layout);CHKERRQ(ierr);
+  for (r = rStart; r < rEnd; ++r) {
+    const PetscInt p = user->reverse ? pEnd-1-r : pStart+r;
+    PetscInt       size;
+
+    ierr = DMPlexGetConeSize(serialDM, p, &size);CHKERRQ(ierr);
+    numCones += size;
+  }
+  ierr = PetscMalloc4(rEnd-rStart, &points, rEnd-rStart, &coneSize, numCones, &cones, numCones, &ornts);CHKERRQ(ierr);
+  for (r = rStart, numCones = 0; r < rEnd; ++r) {
+    const PetscInt  p = user->reverse ? pEnd-1-r : pStart+r;
+    const PetscInt *cone, *ornt;
+
+    points[r-rStart] = gpoint[p];
+    ierr = DMPlexGetConeSize(serialDM, p, &coneSize[r-rStart]);CHKERRQ(ierr);
+    ierr = DMPlexGetCone(serialDM, p, &cone);CHKERRQ(ierr);
+    ierr = DMPlexGetConeOrientation(serialDM, p, &ornt);CHKERRQ(ierr);
+    for (c = 0; c < coneSize[r-rStart]; ++c, ++numCones) {cones[numCones] = gpoint[cone[c]]; ornts[numCones] = ornt[c];}
+  }
+  /* The vertices of the serial mesh are numbered contiguously, so the coordinates are in the order of the global numbers */
+  ierr = PetscLayoutCreate(comm, &layout);CHKERRQ(ierr);
+  ierr = PetscLayoutSetSize(layout, vEnd-vStart);CHKERRQ(ierr);
+  ierr = PetscLayoutSetBlockSize(layout, 1);CHKERRQ(ierr);
+  ierr = PetscLayoutSetUp(layout);CHKERRQ(ierr);
+  ierr = PetscLayoutGetRange(layout, &vrStart, &vrEnd);CHKERRQ(ierr);
+  ierr = PetscLayoutDestroy(&layout);CHKERRQ(ierr);
+  ierr = DMGetCoordinateSection(serialDM, &coordSection);CHKERRQ(ierr);
+  ierr = DMGetCoordinatesLocal(serialDM, &coordinates);CHKERRQ(ierr);
+  ierr = VecGetArrayRead(coordinates, &coords);CHKERRQ(ierr);
+  if (vrEnd > vrStart) {ierr = PetscSectionGetOffset(coordSection, vStart+vrStart, &c);CHKERRQ(ierr);}
+  else c = 0;
+  ierr = DMCreate(comm, dm);CHKERRQ(ierr);
+  ierr = DMSetType(*dm, DMPLEX);CHKERRQ(ierr);
+  ierr = DMSetDimension(*dm, user->dim);CHKERRQ(ierr);
+  ierr = DMPlexCreateFromDAGParallel(*dm, rEnd-rStart, points, coneSize, cones, ornts, vrEnd-vrStart, &coords[c], ownershipSF);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(coordinates, &coords);CHKERRQ(ierr);
+  ierr = PetscFree4(points, coneSize, cones, ornts);CHKERRQ(ierr);
+  ierr = ISRestoreIndices(*globalPoints, &gpoint);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* Compare the cones, orientations and coordinates of each local point with the serial mesh */
+static PetscErrorCode CompareMeshes(DM dm, DM serialDM, IS globalPoints, PetscSF ownershipSF)
+{
+  PetscLayout        layout;
+  PetscSection       cs, scs;
+  Vec                coordinates, scoordinates;
+  const PetscScalar *coords, *scoords;
+  const PetscSFNode *iremote;
+  const PetscInt    *gpoint, *range;
+  PetscInt          *spoint, *gnum, numSlots, pStart, pEnd, spStart, spEnd, vStart, vEnd, cdim, p;
+  PetscErrorCode     ierr;
+
+  PetscFunctionBegin;
+  ierr = DMGetCoordinateDim(dm, &cdim);CHKERRQ(ierr);
+  ierr = DMPlexGetChart(dm, &pStart, &pEnd);CHKERRQ(ierr);
+  ierr = DMPlexGetChart(serialDM, &spStart, &spEnd);CHKERRQ(ierr);
+  ierr = ISGetIndices(globalPoints, &gpoint);CHKERRQ(ierr);
+  ierr = PetscMalloc2(spEnd-spStart, &spoint, pEnd-pStart, &gnum);CHKERRQ(ierr);
+  for (p = spStart; p < spEnd; ++p) spoint[gpoint[p]] = p;
+  ierr = PetscSFGetGraph(ownershipSF, &numSlots, NULL, NULL, &iremote);CHKERRQ(ierr);
+  ierr = PetscLayoutCreate(PetscObjectComm((PetscObject) dm), &layout);CHKERRQ(ierr);
+  ierr = PetscLayoutSetLocalSize(layout, numSlots);CHKERRQ(ierr);
+  ierr = PetscLayoutSetBlockSize(layout, 1);CHKERRQ(ierr);
+  ierr = PetscLayoutSetUp(layout);CHKERRQ(ierr);
+  ierr = PetscLayoutGetRanges(layout, &range);CHKERRQ(ierr);
+  for (p = pStart; p < pEnd; ++p) gnum[p] = range[iremote[p].rank] + iremote[p].index;
+  ierr = DMGetCoordinateSection(dm, &cs);CHKERRQ(ierr);
+  ierr = DMGetCoordinateSection(serialDM, &scs);CHKERRQ(ierr);
+  ierr = PetscSectionGetChart(cs, &vStart, &vEnd);CHKERRQ(ierr);
+  ierr = DMGetCoordinatesLocal(dm, &coordinates);CHKERRQ(ierr);
+  ierr = DMGetCoordinatesLocal(serialDM, &scoordinates);CHKERRQ(ierr);
+  ierr = VecGetArrayRead(coordinates, &coords);CHKERRQ(ierr);
+  ierr = VecGetArrayRead(scoordinates, &scoords);CHKERRQ(ierr);
+  for (p = pStart; p < pEnd; ++p) {
+    const PetscInt *cone, *scone, *ornt, *sornt;
+    const PetscInt  sp = spoint[gnum[p]];
+    PetscInt        coneSize, sconeSize, off, soff, c, d;
+
+    ierr = DMPlexGetConeSize(dm, p, &coneSize);CHKERRQ(ierr);
+    ierr = DMPlexGetConeSize(serialDM, sp, &sconeSize);CHKERRQ(ierr);
+    if (coneSize != sconeSize) SETERRQ4(PETSC_COMM_SELF, PETSC_ERR_PLIB, "Point %D (global %D) has cone size %D != %D", p, gnum[p], coneSize, sconeSize);
+    ierr = DMPlexGetCone(dm, p, &cone);CHKERRQ(ierr);
+    ierr = DMPlexGetCone(serialDM, sp, &scone);CHKERRQ(ierr);
+    ierr = DMPlexGetConeOrientation(dm, p, &ornt);CHKERRQ(ierr);
+    ierr = DMPlexGetConeOrientation(serialDM, sp, &sornt);CHKERRQ(ierr);
+    for (c = 0; c < coneSize; ++c) {
+      if (gnum[cone[c]] != gpoint[scone[c]]) SETERRQ4(PETSC_COMM_SELF, PETSC_ERR_PLIB, "Cone point %D of global point %D is %D != %D", c, gnum[p], gnum[cone[c]], gpoint[scone[c]]);
+      if (ornt[c] != sornt[c]) SETERRQ4(PETSC_COMM_SELF, PETSC_ERR_PLIB, "Cone orientation %D of global point %D is %D != %D", c, gnum[p], ornt[c], sornt[c]);
+    }
+    if ((p < vStart) || (p >= vEnd)) continue;
+    ierr = PetscSectionGetOffset(cs, p, &off);CHKERRQ(ierr);
+    ierr = PetscSectionGetOffset(scs, sp, &soff);CHKERRQ(ierr);
+    for (d = 0; d < cdim; ++d) if (coords[off+d] != scoords[soff+d]) SETERRQ2(PETSC_COMM_SELF, PETSC_ERR_PLIB, "Coordinate %D of global point %D does not match", d, gnum[p]);
+  }
+  ierr = VecRestoreArrayRead(coordinates, &coords);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(scoordinates, &scoords);CHKERRQ(ierr);
+  ierr = PetscLayoutDestroy(&layout);CHKERRQ(ierr);
+  ierr = PetscFree2(spoint, gnum);CHKERRQ(ierr);
+  ierr = ISRestoreIndices(globalPoints, &gpoint);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* Checks the topology, and reports the global number of owned points and, for interpolated meshes, the mesh volume */
+static PetscErrorCode CheckMesh(DM dm, AppCtx *user, const char name[])
+{
+  PetscSF         sf;
+  const PetscInt *leaves;
+  PetscInt        pStart, pEnd, cStart, cEnd, numLeaves, c, counts[2], gcounts[2];
+  PetscReal       vol = 0.0, gvol;
+  PetscErrorCode  ierr;
+
+  PetscFunctionBegin;
+  ierr = DMPlexCheckSymmetry(dm);CHKERRQ(ierr);
+  ierr = DMPlexCheckSkeleton(dm, PETSC_FALSE, 0);CHKERRQ(ierr);
+  if (user->interpolate) {ierr = DMPlexCheckFaces(dm, PETSC_FALSE, 0);CHKERRQ(ierr);}
+  ierr = DMPlexGetChart(dm, &pStart, &pEnd);CHKERRQ(ierr);
+  ierr = DMPlexGetHeightStratum(dm, 0, &cStart, &cEnd);CHKERRQ(ierr);
+  ierr = DMGetPointSF(dm, &sf);CHKERRQ(ierr);
+  ierr = PetscSFGetGraph(sf, NULL, &numLeaves, &leaves, NULL);CHKERRQ(ierr);
+  for (c = 0; c < numLeaves; ++c) {
+    const PetscInt leaf = leaves ? leaves[c] : c;
+
+    if ((leaf >= cStart) && (leaf < cEnd)) SETERRQ1(PETSC_COMM_SELF, PETSC_ERR_PLIB, "Cell %D is not owned", leaf);
+  }
+  for (c = cStart; user->interpolate && c < cEnd; ++c) {
+    PetscReal cvol;
+
+    ierr = DMPlexComputeCellGeometryFVM(dm, c, &cvol, NULL, NULL);CHKERRQ(ierr);
+    vol += cvol;
+  }
+  counts[0] = cEnd-cStart;
+  counts[1] = pEnd-pStart-PetscMax(numLeaves, 0);
+  ierr = MPIU_Allreduce(counts, gcounts, 2, MPIU_INT, MPI_SUM, PetscObjectComm((PetscObject) dm));CHKERRQ(ierr);
+  ierr = MPIU_Allreduce(&vol, &gvol, 1, MPIU_REAL, MPIU_SUM, PetscObjectComm((PetscObject) dm));CHKERRQ(ierr);
+  ierr = PetscPrintf(PetscObjectComm((PetscObject) dm), "%s: %D cells, %D points", name, gcounts[0], gcounts[1]);CHKERRQ(ierr);
+  if (user->interpolate) {ierr = PetscPrintf(PetscObjectComm((PetscObject) dm), ", volume %g", (double) gvol);CHKERRQ(ierr);}
+  ierr = PetscPrintf(PetscObjectComm((PetscObject) dm), "\n");CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#if defined(PETSC_HAVE_HDF5)
+/* For each stratum of the label, sums over the owned points the number of points and the coordinates of the vertices in their closures */
+static PetscErrorCode ComputeLabelSignature(DM dm, const char name[], PetscInt *vStart, PetscInt *numValues, PetscReal **sig)
+{
+  MPI_Comm        comm = PetscObjectComm((PetscObject) dm);
+  DMLabel         label;
+  PetscSF         sf;
+  PetscSection    cs;
+  Vec             coordinates;
+  PetscBT         leaf;
+  IS              valueIS;
+  const PetscInt *values, *leaves;
+  PetscReal      *lsig;
+  PetscInt        range[2] = {PETSC_MAX_INT, PETSC_MAX_INT}, grange[2], numLeaves, pStart, pEnd, cdim, Nv, v, l;
+  PetscErrorCode  ierr;
+
+  PetscFunctionBegin;
+  ierr = DMGetLabel(dm, name, &label);CHKERRQ(ierr);
+  if (!label) SETERRQ1(comm, PETSC_ERR_ARG_WRONG, "Missing label %s", name);
+  ierr = DMGetCoordinateDim(dm, &cdim);CHKERRQ(ierr);
+  ierr = DMGetCoordinateSection(dm, &cs);CHKERRQ(ierr);
+  ierr = DMGetCoordinatesLocal(dm, &coordinates);CHKERRQ(ierr);
+  ierr = DMPlexGetChart(dm, &pStart, &pEnd);CHKERRQ(ierr);
+  ierr = PetscBTCreate(pEnd-pStart, &leaf);CHKERRQ(ierr);
+  ierr = DMGetPointSF(dm, &sf);CHKERRQ(ierr);
+  ierr = PetscSFGetGraph(sf, NULL, &numLeaves, &leaves, NULL);CHKERRQ(ierr);
+  for (l = 0; l < numLeaves; ++l) {ierr = PetscBTSet(leaf, (leaves ? leaves[l] : l) - pStart);CHKERRQ(ierr);}
+  ierr = DMLabelGetValueIS(label, &valueIS);CHKERRQ(ierr);
+  ierr = ISGetLocalSize(valueIS, &Nv);CHKERRQ(ierr);
+  ierr = ISGetIndices(valueIS, &values);CHKERRQ(ierr);
+  /* the smallest value and minus the largest one */
+  for (v = 0; v < Nv; ++v) {range[0] = PetscMin(range[0], values[v]); range[1] = PetscMin(range[1], -values[v]);}
+  ierr = MPIU_Allreduce(range, grange, 2, MPIU_INT, MPI_MIN, comm);CHKERRQ(ierr);
+  *vStart    = grange[0];
+  *numValues = grange[0] <= -grange[1] ? -grange[1]-grange[0]+1 : 0;
+  ierr = PetscCalloc1(*numValues*(cdim+1), &lsig);CHKERRQ(ierr);
+  ierr = PetscMalloc1(*numValues*(cdim+1), sig);CHKERRQ(ierr);
+  for (v = 0; v < Nv; ++v) {
+    IS              pointIS;
+    const PetscInt *points;
+    PetscReal      *s = &lsig[(values[v]-*vStart)*(cdim+1)];
+    PetscInt        n, p;
+
+    ierr = DMLabelGetStratumIS(label, values[v], &pointIS);CHKERRQ(ierr);
+    ierr = ISGetLocalSize(pointIS, &n);CHKERRQ(ierr);
+    ierr = ISGetIndices(pointIS, &points);CHKERRQ(ierr);
+    for (p = 0; p < n; ++p) {
+      PetscScalar *coords = NULL;
+      PetscInt     size, i;
+
+      if (PetscBTLookup(leaf, points[p]-pStart)) continue;
+      s[0] += 1.0;
+      ierr = DMPlexVecGetClosure(dm, cs, coordinates, points[p], &size, &coords);CHKERRQ(ierr);
+      for (i = 0; i < size; ++i) s[1+i%cdim] += PetscRealPart(coords[i]);
+      ierr = DMPlexVecRestoreClosure(dm, cs, coordinates, points[p], &size, &coords);CHKERRQ(ierr);
+    }
+    ierr = ISRestoreIndices(pointIS, &points);CHKERRQ(ierr);
+    ierr = ISDestroy(&pointIS);CHKERRQ(ierr);
+  }
+  ierr = ISRestoreIndices(valueIS, &values);CHKERRQ(ierr);
+  ierr = ISDestroy(&valueIS);CHKERRQ(ierr);
+  ierr = MPIU_Allreduce(lsig, *sig, *numValues*(cdim+1), MPIU_REAL, MPIU_SUM, comm);CHKERRQ(ierr);
+  ierr = PetscFree(lsig);CHKERRQ(ierr);
+  ierr = PetscBTDestroy(&leaf);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* Compares the number of owned points in each stratum of each label, and the coordinates of their closures */
+static PetscErrorCode CompareLabels(DM dm, DM refDM, PetscBool print)
+{
+  MPI_Comm       comm = PetscObjectComm((PetscObject) dm);
+  PetscInt       numLabels, cdim, l;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = DMGetCoordinateDim(refDM, &cdim);CHKERRQ(ierr);
+  ierr = DMGetNumLabels(refDM, &numLabels);CHKERRQ(ierr);
+  for (l = 0; l < numLabels; ++l) {
+    const char *name;
+    PetscReal  *sig, *refSig;
+    PetscInt    vStart, refvStart, Nv, refNv, v, d;
+
+    ierr = DMGetLabelName(refDM, l, &name);CHKERRQ(ierr);
+    ierr = ComputeLabelSignature(dm, name, &vStart, &Nv, &sig);CHKERRQ(ierr);
+    ierr = ComputeLabelSignature(refDM, name, &refvStart, &refNv, &refSig);CHKERRQ(ierr);
+    if (vStart != refvStart || Nv != refNv) SETERRQ1(comm, PETSC_ERR_PLIB, "Label %s has different values", name);
+    for (v = 0; v < Nv; ++v) {
+      for (d = 0; d <= cdim; ++d) {
+        const PetscReal a = sig[v*(cdim+1)+d], b = refSig[v*(cdim+1)+d];
+
+        if (PetscAbsReal(a - b) > 1.0e-10*PetscMax(1.0, PetscAbsReal(b))) SETERRQ4(comm, PETSC_ERR_PLIB, "Label %s value %D differs in entry %D: %g", name, vStart+v, d, (double) (a - b));
+      }
+      if (print && refSig[v*(cdim+1)] > 0.0) {ierr = PetscPrintf(comm, "  Label %s value %D: %D points\n", name, vStart+v, (PetscInt) refSig[v*(cdim+1)]);CHKERRQ(ierr);}
+    }
+    ierr = PetscFree(sig);CHKERRQ(ierr);
+    ierr = PetscFree(refSig);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode LoadMesh(MPI_Comm comm, const char filename[], const char prefix[], DM *dm)
+{
+  PetscViewer    viewer;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscViewerHDF5Open(comm, filename, FILE_MODE_READ, &viewer);CHKERRQ(ierr);
+  ierr = DMCreate(comm, dm);CHKERRQ(ierr);
+  ierr = PetscObjectSetOptionsPrefix((PetscObject) *dm, prefix);CHKERRQ(ierr);
+  ierr = DMSetType(*dm, DMPLEX);CHKERRQ(ierr);
+  ierr = DMLoad(*dm, viewer);CHKERRQ(ierr);
+  ierr = PetscViewerDestroy(&viewer);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode DistributeMesh(DM *dm)
+{
+  DM               dmDist;
+  PetscPartitioner part;
+  PetscErrorCode   ierr;
+
+  PetscFunctionBegin;
+  ierr = DMPlexGetPartitioner(*dm, &part);CHKERRQ(ierr);
+  ierr = PetscPartitionerSetFromOptions(part);CHKERRQ(ierr);
+  ierr = DMPlexDistribute(*dm, 0, NULL, &dmDist);CHKERRQ(ierr);
+  if (dmDist) {
+    ierr = DMDestroy(dm);CHKERRQ(ierr);
+    *dm  = dmDist;
+  }
+  PetscFunctionReturn(0);
+}
+
+/* Writes a box mesh with DMView(), unless a file is given, and checks that loading it in parallel with the par_ prefix
+   (-par_dm_plex_hdf5_parallel_load) gives the same mesh and labels as loading it on process 0, before and after distribution */
+static PetscErrorCode TestHDF5(AppCtx *user)
+{
+  MPI_Comm       comm = PETSC_COMM_WORLD;
+  DM             dm, serialDM;
+  const char    *filename = user->filename[0] ? user->filename : "ex32.h5";
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (!user->filename[0]) {
+    PetscViewer viewer;
+    DMLabel     label;
+    PetscInt    cStart, cEnd, c;
+
+    ierr = DMPlexCreateBoxMesh(comm, user->dim, PETSC_FALSE, user->faces, NULL, NULL, NULL, user->interpolate, &dm);CHKERRQ(ierr);
+    ierr = DMCreateLabel(dm, "cells");CHKERRQ(ierr);
+    ierr = DMGetLabel(dm, "cells", &label);CHKERRQ(ierr);
+    ierr = DMPlexGetHeightStratum(dm, 0, &cStart, &cEnd);CHKERRQ(ierr);
+    for (c = cStart; c < cEnd; ++c) {ierr = DMLabelSetValue(label, c, c%3);CHKERRQ(ierr);}
+    ierr = PetscViewerHDF5Open(comm, filename, FILE_MODE_WRITE, &viewer);CHKERRQ(ierr);
+    ierr = DMView(dm, viewer);CHKERRQ(ierr);
+    ierr = PetscViewerDestroy(&viewer);CHKERRQ(ierr);
+    ierr = DMDestroy(&dm);CHKERRQ(ierr);
+  }
+  ierr = LoadMesh(comm, filename, NULL, &serialDM);CHKERRQ(ierr);
+  ierr = LoadMesh(comm, filename, "par_", &dm);CHKERRQ(ierr);
+  ierr = CompareLabels(dm, serialDM, PETSC_FALSE);CHKERRQ(ierr);
+  ierr = CheckMesh(dm, user, "Parallel load");CHKERRQ(ierr);
+  ierr = DistributeMesh(&serialDM);CHKERRQ(ierr);
+  ierr = DistributeMesh(&dm);CHKERRQ(ierr);
+  ierr = CheckMesh(dm, user, "Distributed parallel load");CHKERRQ(ierr);
+  ierr = CompareLabels(dm, serialDM, PETSC_TRUE);CHKERRQ(ierr);
+  ierr = DMDestroy(&dm);CHKERRQ(ierr);
+  ierr = DMDestroy(&serialDM);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+#endif
+
+int main(int argc, char **argv)
+{
+  DM               serialDM, dm, dmDist;
+  IS               globalPoints;
+  PetscSF          ownershipSF;
+  PetscPartitioner part;
+  AppCtx           user;
+  PetscErrorCode   ierr;
+
+  ierr = PetscInitialize(&argc, &argv, NULL, help);if (ierr) return ierr;
+  ierr = ProcessOptions(PETSC_COMM_WORLD, &user);CHKERRQ(ierr);
+  if (user.hdf5) {
+#if defined(PETSC_HAVE_HDF5)
+    ierr = TestHDF5(&user);CHKERRQ(ierr);
+    ierr = PetscFinalize();
+    return ierr;
+#else
+    SETERRQ(PETSC_COMM_WORLD, PETSC_ERR_SUP, "Reconfigure PETSc with --download-hdf5");
+#endif
+  }
+  ierr = DMPlexCreateBoxMesh(PETSC_COMM_SELF, user.dim, PETSC_FALSE, user.faces, NULL, NULL, NULL, user.interpolate, &serialDM);CHKERRQ(ierr);
+  ierr = CreateParallelMesh(serialDM, &user, &globalPoints, &ownershipSF, &dm);CHKERRQ(ierr);
+  ierr = CompareMeshes(dm, serialDM, globalPoints, ownershipSF);CHKERRQ(ierr);
+  ierr = CheckMesh(dm, &user, "Naive mesh");CHKERRQ(ierr);
+  ierr = DMPlexGetPartitioner(dm, &part);CHKERRQ(ierr);
+  ierr = PetscPartitionerSetFromOptions(part);CHKERRQ(ierr);
+  ierr = DMPlexDistribute(dm, 0, NULL, &dmDist);CHKERRQ(ierr);
+  if (dmDist) {
+    ierr = CheckMesh(dmDist, &user, "Repartitioned mesh");CHKERRQ(ierr);
+    ierr = DMDestroy(&dmDist);CHKERRQ(ierr);
+  }
+  ierr = PetscSFDestroy(&ownershipSF);CHKERRQ(ierr);
+  ierr = ISDestroy(&globalPoints);CHKERRQ(ierr);
+  ierr = DMDestroy(&dm);CHKERRQ(ierr);
+  ierr = DMDestroy(&serialDM);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+  test:
+    suffix: quad
+
+  test:
+    suffix: quad_parallel
+    nsize: 3
+    args: -petscpartitioner_type simple
+
+  test:
+    suffix: quad_uninterpolated
+    nsize: 2
+    args: -interpolate 0 -reverse -petscpartitioner_type simple
+
+  test:
+    suffix: hex_parallel
+    nsize: 4
+    args: -dim 3 -faces 3,2,3 -reverse -petscpartitioner_type simple
+
+  test:
+    suffix: hdf5_quad
+    requires: hdf5
+    nsize: 2
+    args: -hdf5 -par_dm_plex_hdf5_parallel_load -petscpartitioner_type simple
+
+  test:
+    suffix: hdf5_hex_uninterpolated
+    requires: hdf5
+    nsize: 3
+    args: -hdf5 -dim 3 -faces 3,2,3 -interpolate 0 -par_dm_plex_hdf5_parallel_load -petscpartitioner_type simple
+
+TEST*/
@@ -0,0 +1,269 @@
+static char help[] = "Tests implicit uniform refinement against repeated DMRefine().\n\n";
+
+#include <petscdmplex.h>
+#include <petscsf.h>
+
+typedef struct {
+  PetscInt  dim;       /* Topological dimension */
+  PetscBool simplex;   /* Use simplices or tensor product cells */
+  PetscInt  faces[3];  /* Number of faces per dimension */
+  PetscInt  numLevels; /* Number of refinements */
+} AppCtx;
+
+static PetscErrorCode ProcessOptions(MPI_Comm comm, AppCtx *options)
+{
+  PetscInt       n = 3;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  options->dim       = 2;
+  options->simplex   = PETSC_TRUE;
+  options->faces[0]  = 2;
+  options->faces[1]  = 2;
+  options->faces[2]  = 2;
+  options->numLevels = 1;
+  ierr = PetscOptionsBegin(comm, "", "Implicit Refinement Test Options", "DMPLEX");CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-dim", "The topological mesh dimension", "ex33.c", options->dim, &options->dim, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-simplex", "Use simplices or tensor product cells", "ex33.c", options->simplex, &options->simplex, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsIntArray("-faces", "Number of faces per dimension", "ex33.c", options->faces, &n, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-num_levels", "The number of refinements", "ex33.c", options->numLevels, &options->numLevels, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsEnd();
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode CompareTopology(DM dm, DM rdm, DMPlexImplicitRefinement ir, PetscBool *match)
+{
+  const PetscInt *cone, *ornt;
+  PetscInt        icone[8], iornt[8];
+  PetscInt        pStart, pEnd, ipStart, ipEnd, p, coneSize, iconeSize, c;
+  PetscErrorCode  ierr;
+
+  PetscFunctionBegin;
+  ierr = DMPlexGetChart(dm, &pStart, &pEnd);CHKERRQ(ierr);
+  ierr = DMPlexImplicitRefinementGetChart(ir, &ipStart, &ipEnd);CHKERRQ(ierr);
+  if ((pStart != ipStart) || (pEnd != ipEnd)) {*match = PETSC_FALSE; PetscFunctionReturn(0);}
+  for (p = pStart; p < pEnd; ++p) {
+    ierr = DMPlexGetConeSize(dm, p, &coneSize);CHKERRQ(ierr);
+    ierr = DMPlexImplicitRefinementGetConeSize(ir, p, &iconeSize);CHKERRQ(ierr);
+    if (coneSize != iconeSize) {*match = PETSC_FALSE; continue;}
+    ierr = DMPlexGetCone(dm, p, &cone);CHKERRQ(ierr);
+    ierr = DMPlexGetConeOrientation(dm, p, &ornt);CHKERRQ(ierr);
+    ierr = DMPlexImplicitRefinementGetCone(ir, p, icone, iornt);CHKERRQ(ierr);
+    for (c = 0; c < coneSize; ++c) if ((cone[c] != icone[c]) || (ornt[c] != iornt[c])) *match = PETSC_FALSE;
+    ierr = DMPlexGetConeSize(rdm, p, &iconeSize);CHKERRQ(ierr);
+    if (coneSize != iconeSize) {*match = PETSC_FALSE; continue;}
+    ierr = DMPlexGetCone(rdm, p, &cone);CHKERRQ(ierr);
+    ierr = DMPlexGetConeOrientation(rdm, p, &ornt);CHKERRQ(ierr);
+    for (c = 0; c < coneSize; ++c) if ((cone[c] != icone[c]) || (ornt[c] != iornt[c])) *match = PETSC_FALSE;
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode CompareCoordinates(DM dm, DM rdm, PetscBool *match)
+{
+  Vec            coordinates, rcoordinates;
+  PetscReal      diff;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = DMGetCoordinatesLocal(dm, &coordinates);CHKERRQ(ierr);
+  ierr = DMGetCoordinatesLocal(rdm, &rcoordinates);CHKERRQ(ierr);
+  ierr = VecAXPY(rcoordinates, -1.0, coordinates);CHKERRQ(ierr);
+  ierr = VecNorm(rcoordinates, NORM_INFINITY, &diff);CHKERRQ(ierr);
+  ierr = VecAXPY(rcoordinates, 1.0, coordinates);CHKERRQ(ierr);
+  if (diff > 1.0e-10) *match = PETSC_FALSE;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode CompareLabels(DM dm, DM rdm, PetscBool *match)
+{
+  PetscInt       numLabels, l;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = DMGetNumLabels(dm, &numLabels);CHKERRQ(ierr);
+  for (l = 0; l < numLabels; ++l) {
+    DMLabel         label, rlabel;
+    IS              valueIS;
+    const PetscInt *values;
+    const char     *name;
+    PetscInt        numValues, v;
+
+    ierr = DMGetLabelName(dm, l, &name);CHKERRQ(ierr);
+    ierr = DMGetLabel(dm, name, &label);CHKERRQ(ierr);
+    ierr = DMGetLabel(rdm, name, &rlabel);CHKERRQ(ierr);
+    if (!rlabel) {*match = PETSC_FALSE; continue;}
+    ierr = DMLabelGetValueIS(label, &valueIS);CHKERRQ(ierr);
+    ierr = ISGetLocalSize(valueIS, &numValues);CHKERRQ(ierr);
+    ierr = ISGetIndices(valueIS, &values);CHKERRQ(ierr);
+    for (v = 0; v < numValues; ++v) {
+      IS        pointIS, rpointIS;
+      PetscBool equal;
+
+      ierr = DMLabelGetStratumIS(label, values[v], &pointIS);CHKERRQ(ierr);
+      ierr = DMLabelGetStratumIS(rlabel, values[v], &rpointIS);CHKERRQ(ierr);
+      if (pointIS && rpointIS) {
+        ierr = ISEqual(pointIS, rpointIS, &equal);CHKERRQ(ierr);
+        if (!equal) *match = PETSC_FALSE;
+      } else if (pointIS || rpointIS) *match = PETSC_FALSE;
+      ierr = ISDestroy(&pointIS);CHKERRQ(ierr);
+      ierr = ISDestroy(&rpointIS);CHKERRQ(ierr);
+    }
+    ierr = ISRestoreIndices(valueIS, &values);CHKERRQ(ierr);
+    ierr = ISDestroy(&valueIS);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode ComparePointSF(DM dm, DM rdm, PetscBool *match)
+{
+  PetscSF            sf, rsf;
+  const PetscInt    *leaves, *rleaves;
+  const PetscSFNode *remotes, *rremotes;
+  PetscInt           numRoots, numLeaves, rnumRoots, rnumLeaves, l;
+  PetscErrorCode     ierr;
+
+  PetscFunctionBegin;
+  ierr = DMGetPointSF(dm, &sf);CHKERRQ(ierr);
+  ierr = DMGetPointSF(rdm, &rsf);CHKERRQ(ierr);
+  ierr = PetscSFGetGraph(sf, &numRoots, &numLeaves, &leaves, &remotes);CHKERRQ(ierr);
+  ierr = PetscSFGetGraph(rsf, &rnumRoots, &rnumLeaves, &rleaves, &rremotes);CHKERRQ(ierr);
+  if ((numRoots < 0) && (rnumRoots < 0)) PetscFunctionReturn(0);
+  if ((numRoots != rnumRoots) || (numLeaves != rnumLeaves)) {*match = PETSC_FALSE; PetscFunctionReturn(0);}
+  for (l = 0; l < numLeaves; ++l) {
+    if (leaves[l] != rleaves[l] || remotes[l].rank != rremotes[l].rank || remotes[l].index != rremotes[l].index) *match = PETSC_FALSE;
+  }
+  PetscFunctionReturn(0);
+}
+
+/* Split each square of a faces[0] x faces[1] grid into two triangles, without a mesh generator */
+static PetscErrorCode CreateTriangleMesh(MPI_Comm comm, AppCtx *user, DM *dm)
+{
+  DMLabel        label;
+  PetscMPIInt    rank;
+  int           *cells = NULL;
+  double        *coords = NULL;
+  PetscInt       nx = user->faces[0], ny = user->faces[1], numCells = 0, numVertices = 0, i, j;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MPI_Comm_rank(comm, &rank);CHKERRQ(ierr);
+  if (!rank) {
+    numCells    = 2*nx*ny;
+    numVertices = (nx+1)*(ny+1);
+    ierr = PetscMalloc2(numCells*3, &cells, numVertices*2, &coords);CHKERRQ(ierr);
+    for (j = 0; j <= ny; ++j) for (i = 0; i <= nx; ++i) {
+      coords[(j*(nx+1)+i)*2+0] = ((double) i)/nx;
+      coords[(j*(nx+1)+i)*2+1] = ((double) j)/ny;
+    }
+    for (j = 0; j < ny; ++j) for (i = 0; i < nx; ++i) {
+      const int v = j*(nx+1)+i, c = 2*(j*nx+i);
+
+      cells[c*3+0] = v;   cells[c*3+1] = v+1;      cells[c*3+2] = v+nx+2;
+      cells[c*3+3] = v;   cells[c*3+4] = v+nx+2;   cells[c*3+5] = v+nx+1;
+    }
+  }
+  ierr = DMPlexCreateFromCellList(comm, 2, numCells, numVertices, 3, PETSC_TRUE, cells, 2, coords, dm);CHKERRQ(ierr);
+  ierr = PetscFree2(cells, coords);CHKERRQ(ierr);
+  ierr = DMCreateLabel(*dm, "marker");CHKERRQ(ierr);
+  ierr = DMGetLabel(*dm, "marker", &label);CHKERRQ(ierr);
+  ierr = DMPlexMarkBoundaryFaces(*dm, 1, label);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+int main(int argc, char **argv)
+{
+  DM                       dm, dmDist, edm, idm;
+  DMPlexImplicitRefinement ir;
+  AppCtx                   user;
+  PetscBool                tmatch = PETSC_TRUE, cmatch = PETSC_TRUE, lmatch = PETSC_TRUE, smatch = PETSC_TRUE, match;
+  PetscInt                 cStart, cEnd, cell, q, l;
+  PetscErrorCode           ierr;
+
+  ierr = PetscInitialize(&argc, &argv, NULL, help);if (ierr) return ierr;
+  ierr = ProcessOptions(PETSC_COMM_WORLD, &user);CHKERRQ(ierr);
+  if (user.simplex && user.dim == 2) {ierr = CreateTriangleMesh(PETSC_COMM_WORLD, &user, &dm);CHKERRQ(ierr);}
+  else {ierr = DMPlexCreateBoxMesh(PETSC_COMM_WORLD, user.dim, user.simplex, user.faces, NULL, NULL, NULL, PETSC_TRUE, &dm);CHKERRQ(ierr);}
+  ierr = DMSetFromOptions(dm);CHKERRQ(ierr);
+  ierr = DMPlexDistribute(dm, 0, NULL, &dmDist);CHKERRQ(ierr);
+  if (dmDist) {
+    ierr = DMDestroy(&dm);CHKERRQ(ierr);
+    dm   = dmDist;
+  }
+  ierr = DMPlexSetRefinementUniform(dm, PETSC_TRUE);CHKERRQ(ierr);
+  /* Explicit refinement, one level at a time */
+  ierr = PetscObjectReference((PetscObject) dm);CHKERRQ(ierr);
+  edm  = dm;
+  for (l = 0; l < user.numLevels; ++l) {
+    DM rdm;
+
+    ierr = DMRefine(edm, PETSC_COMM_WORLD, &rdm);CHKERRQ(ierr);
+    ierr = DMDestroy(&edm);CHKERRQ(ierr);
+    edm  = rdm;
+  }
+  /* Implicit refinement */
+  ierr = DMPlexImplicitRefinementCreate(dm, user.numLevels, &ir);CHKERRQ(ierr);
+  ierr = DMPlexImplicitRefinementCreateDM(ir, &idm);CHKERRQ(ierr);
+  ierr = CompareTopology(edm, idm, ir, &tmatch);CHKERRQ(ierr);
+  ierr = CompareCoordinates(edm, idm, &cmatch);CHKERRQ(ierr);
+  ierr = CompareLabels(edm, idm, &lmatch);CHKERRQ(ierr);
+  ierr = ComparePointSF(edm, idm, &smatch);CHKERRQ(ierr);
+  /* Every refined cell comes from a coarse cell */
+  ierr = DMPlexGetHeightStratum(dm, 0, &cStart, &cEnd);CHKERRQ(ierr);
+  ierr = DMPlexGetHeightStratum(idm, 0, NULL, &cell);CHKERRQ(ierr);
+  for (--cell; cell >= 0; --cell) {
+    ierr = DMPlexImplicitRefinementGetCoarsePoint(ir, cell, &q);CHKERRQ(ierr);
+    if ((q < cStart) || (q >= cEnd)) tmatch = PETSC_FALSE;
+  }
+  ierr = DMPlexImplicitRefinementDestroy(&ir);CHKERRQ(ierr);
+  ierr = DMPlexCheckSymmetry(idm);CHKERRQ(ierr);
+  ierr = DMPlexCheckSkeleton(idm, user.simplex, 0);CHKERRQ(ierr);
+  ierr = DMPlexCheckFaces(idm, user.simplex, 0);CHKERRQ(ierr);
+  ierr = MPIU_Allreduce(&tmatch, &match, 1, MPIU_BOOL, MPI_LAND, PETSC_COMM_WORLD);CHKERRQ(ierr);
+  ierr = PetscPrintf(PETSC_COMM_WORLD, "Topology %s\n", match ? "matches" : "differs");CHKERRQ(ierr);
+  ierr = MPIU_Allreduce(&cmatch, &match, 1, MPIU_BOOL, MPI_LAND, PETSC_COMM_WORLD);CHKERRQ(ierr);
+  ierr = PetscPrintf(PETSC_COMM_WORLD, "Coordinates %s\n", match ? "match" : "differ");CHKERRQ(ierr);
+  ierr = MPIU_Allreduce(&lmatch, &match, 1, MPIU_BOOL, MPI_LAND, PETSC_COMM_WORLD);CHKERRQ(ierr);
+  ierr = PetscPrintf(PETSC_COMM_WORLD, "Labels %s\n", match ? "match" : "differ");CHKERRQ(ierr);
+  ierr = MPIU_Allreduce(&smatch, &match, 1, MPIU_BOOL, MPI_LAND, PETSC_COMM_WORLD);CHKERRQ(ierr);
+  ierr = PetscPrintf(PETSC_COMM_WORLD, "Point SF %s\n", match ? "matches" : "differs");CHKERRQ(ierr);
+  ierr = DMDestroy(&idm);CHKERRQ(ierr);
+  ierr = DMDestroy(&edm);CHKERRQ(ierr);
+  ierr = DMDestroy(&dm);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+  test:
+    suffix: seg
+    args: -dim 1 -faces 5 -num_levels 2
+
+  test:
+    suffix: tri
+    args: -num_levels 2
+
+  test:
+    suffix: quad
+    args: -simplex 0 -faces 3,2 -num_levels 2
+
+  test:
+    suffix: hex
+    args: -dim 3 -simplex 0 -num_levels 2
+
+  test:
+    suffix: tri_parallel
+    nsize: 2
+    args: -faces 3,3 -num_levels 2
+
+  test:
+    suffix: hex_parallel
+    nsize: 2
+    args: -dim 3 -simplex 0 -faces 2,2,3
+
+  test:
+    suffix: quad_options
+    args: -simplex 0 -faces 3,2 -dm_refine 2 -dm_refine_implicit
+
+TEST*/
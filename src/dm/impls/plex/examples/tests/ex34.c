@@ -0,0 +1,259 @@
+static char help[] = "Tests point location with a bounding volume hierarchy against brute force search.\n\n";
+
+#include <petscdmplex.h>
+#include <petscsf.h>
+#include <petscsnes.h>
+
+typedef struct {
+  PetscInt  dim;       /* Topological dimension */
+  PetscBool simplex;   /* Use simplices or tensor product cells */
+  PetscInt  faces[3];  /* Number of faces per dimension */
+  PetscInt  numPoints; /* Number of random points per process */
+  PetscInt  walk;      /* Number of neighbors tried from the initial guess */
+} AppCtx;
+
+static PetscErrorCode ProcessOptions(MPI_Comm comm, AppCtx *options)
+{
+  PetscInt       n = 3;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  options->dim       = 2;
+  options->simplex   = PETSC_FALSE;
+  options->faces[0]  = 4;
+  options->faces[1]  = 4;
+  options->faces[2]  = 4;
+  options->numPoints = 100;
+  options->walk      = 8;
+  ierr = PetscOptionsBegin(comm, "", "Point Location Test Options", "DMPLEX");CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-dim", "The topological mesh dimension", "ex34.c", options->dim, &options->dim, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-simplex", "Use simplices or tensor product cells", "ex34.c", options->simplex, &options->simplex, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsIntArray("-faces", "Number of faces per dimension", "ex34.c", options->faces, &n, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-num_points", "The number of random points per process", "ex34.c", options->numPoints, &options->numPoints, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-walk", "The number of neighbors tried from the initial guess", "ex34.c", options->walk, &options->walk, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsEnd();
+  PetscFunctionReturn(0);
+}
+
+/* Split each square of a faces[0] x faces[1] grid into two triangles, without a mesh generator */
+static PetscErrorCode CreateTriangleMesh(MPI_Comm comm, AppCtx *user, DM *dm)
+{
+  PetscMPIInt    rank;
+  int           *cells = NULL;
+  double        *coords = NULL;
+  PetscInt       nx = user->faces[0], ny = user->faces[1], numCells = 0, numVertices = 0, i, j;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MPI_Comm_rank(comm, &rank);CHKERRQ(ierr);
+  if (!rank) {
+    numCells    = 2*nx*ny;
+    numVertices = (nx+1)*(ny+1);
+    ierr = PetscMalloc2(numCells*3, &cells, numVertices*2, &coords);CHKERRQ(ierr);
+    for (j = 0; j <= ny; ++j) for (i = 0; i <= nx; ++i) {
+      coords[(j*(nx+1)+i)*2+0] = ((double) i)/nx;
+      coords[(j*(nx+1)+i)*2+1] = ((double) j)/ny;
+    }
+    for (j = 0; j < ny; ++j) for (i = 0; i < nx; ++i) {
+      const int v = j*(nx+1)+i, c = 2*(j*nx+i);
+
+      cells[c*3+0] = v;   cells[c*3+1] = v+1;      cells[c*3+2] = v+nx+2;
+      cells[c*3+3] = v;   cells[c*3+4] = v+nx+2;   cells[c*3+5] = v+nx+1;
+    }
+  }
+  ierr = DMPlexCreateFromCellList(comm, 2, numCells, numVertices, 3, PETSC_TRUE, cells, 2, coords, dm);CHKERRQ(ierr);
+  ierr = PetscFree2(cells, coords);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode CreateMesh(MPI_Comm comm, AppCtx *user, DM *dm)
+{
+  DM             dmDist;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (user->simplex && user->dim == 2) {ierr = CreateTriangleMesh(comm, user, dm);CHKERRQ(ierr);}
+  else {ierr = DMPlexCreateBoxMesh(comm, user->dim, user->simplex, user->faces, NULL, NULL, NULL, PETSC_TRUE, dm);CHKERRQ(ierr);}
+  ierr = DMPlexDistribute(*dm, 0, NULL, &dmDist);CHKERRQ(ierr);
+  if (dmDist) {
+    ierr = DMDestroy(dm);CHKERRQ(ierr);
+    *dm  = dmDist;
+  }
+  ierr = DMSetFromOptions(*dm);CHKERRQ(ierr);
+  ierr = DMViewFromOptions(*dm, NULL, "-dm_view");CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* Locate the points, starting from the cells in guess if given, and return the cell of each point or -1 */
+static PetscErrorCode LocatePoints(DM dm, Vec points, const PetscInt guess[], PetscInt cells[])
+{
+  PetscSF            cellSF;
+  PetscSFNode       *nodes;
+  const PetscSFNode *found;
+  PetscInt           bs, n, p;
+  PetscErrorCode     ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscSFCreate(PETSC_COMM_SELF, &cellSF);CHKERRQ(ierr);
+  if (guess) {
+    ierr = VecGetLocalSize(points, &n);CHKERRQ(ierr);
+    ierr = VecGetBlockSize(points, &bs);CHKERRQ(ierr);
+    n   /= bs;
+    ierr = PetscMalloc1(n, &nodes);CHKERRQ(ierr);
+    for (p = 0; p < n; ++p) {nodes[p].rank = 0; nodes[p].index = guess[p];}
+    ierr = PetscSFSetGraph(cellSF, n, n, NULL, PETSC_OWN_POINTER, nodes, PETSC_OWN_POINTER);CHKERRQ(ierr);
+  }
+  ierr = DMLocatePoints(dm, points, DM_POINTLOCATION_NONE, &cellSF);CHKERRQ(ierr);
+  ierr = PetscSFGetGraph(cellSF, NULL, &n, NULL, &found);CHKERRQ(ierr);
+  for (p = 0; p < n; ++p) cells[p] = found[p].index;
+  ierr = PetscSFDestroy(&cellSF);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* Locate random points on each process, then move them slightly and locate them again from their old cells */
+static PetscErrorCode TestLocatePoints(DM dm, AppCtx *user, PetscInt *numFound, PetscInt *numDiffer)
+{
+  PetscRandom    rand;
+  Vec            points;
+  PetscScalar   *x;
+  PetscInt      *bcells, *hcells, dim = user->dim, n = user->numPoints, p, d;
+  PetscMPIInt    rank;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MPI_Comm_rank(PETSC_COMM_WORLD, &rank);CHKERRQ(ierr);
+  ierr = PetscRandomCreate(PETSC_COMM_SELF, &rand);CHKERRQ(ierr);
+  ierr = PetscRandomSetSeed(rand, 17 + rank);CHKERRQ(ierr);
+  ierr = PetscRandomSeed(rand);CHKERRQ(ierr);
+  ierr = PetscRandomSetInterval(rand, -0.1, 1.1);CHKERRQ(ierr);
+  ierr = VecCreateSeq(PETSC_COMM_SELF, n*dim, &points);CHKERRQ(ierr);
+  ierr = VecSetBlockSize(points, dim);CHKERRQ(ierr);
+  ierr = VecSetRandom(points, rand);CHKERRQ(ierr);
+  ierr = PetscMalloc2(n, &bcells, n, &hcells);CHKERRQ(ierr);
+  *numFound = *numDiffer = 0;
+  ierr = DMPlexSetUseBVHLocation(dm, PETSC_FALSE);CHKERRQ(ierr);
+  ierr = LocatePoints(dm, points, NULL, bcells);CHKERRQ(ierr);
+  ierr = DMPlexSetUseBVHLocation(dm, PETSC_TRUE);CHKERRQ(ierr);
+  ierr = LocatePoints(dm, points, NULL, hcells);CHKERRQ(ierr);
+  for (p = 0; p < n; ++p) {
+    if (bcells[p] >= 0) ++(*numFound);
+    if (bcells[p] != hcells[p]) ++(*numDiffer);
+  }
+  /* Move the points by at most a tenth of a cell */
+  ierr = VecGetArray(points, &x);CHKERRQ(ierr);
+  for (p = 0; p < n; ++p) {
+    for (d = 0; d < dim; ++d) {
+      PetscReal r;
+
+      ierr = PetscRandomGetValueReal(rand, &r);CHKERRQ(ierr);
+      x[p*dim+d] += 0.1*(r - 0.5)/(1.2*user->faces[d]);
+    }
+  }
+  ierr = VecRestoreArray(points, &x);CHKERRQ(ierr);
+  ierr = DMPlexSetPointLocationWalk(dm, user->walk);CHKERRQ(ierr);
+  ierr = LocatePoints(dm, points, hcells, hcells);CHKERRQ(ierr);
+  ierr = DMPlexSetUseBVHLocation(dm, PETSC_FALSE);CHKERRQ(ierr);
+  ierr = LocatePoints(dm, points, NULL, bcells);CHKERRQ(ierr);
+  for (p = 0; p < n; ++p) if (bcells[p] != hcells[p]) ++(*numDiffer);
+  ierr = PetscFree2(bcells, hcells);CHKERRQ(ierr);
+  ierr = VecDestroy(&points);CHKERRQ(ierr);
+  ierr = PetscRandomDestroy(&rand);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* Compare the interpolation setup for points distributed over the processes to the one for replicated points */
+static PetscErrorCode TestInterpolation(DM dm, AppCtx *user, PetscBool *match)
+{
+  DMInterpolationInfo dctx, rctx;
+  PetscRandom         rand;
+  PetscReal          *points, *allPoints;
+  PetscMPIInt         rank, size, *counts, *displs, r;
+  PetscInt            dim = user->dim, n = user->numPoints, c;
+  const PetscScalar  *dcoords, *rcoords;
+  PetscErrorCode      ierr;
+
+  PetscFunctionBegin;
+  ierr = MPI_Comm_rank(PETSC_COMM_WORLD, &rank);CHKERRQ(ierr);
+  ierr = MPI_Comm_size(PETSC_COMM_WORLD, &size);CHKERRQ(ierr);
+  ierr = PetscRandomCreate(PETSC_COMM_SELF, &rand);CHKERRQ(ierr);
+  ierr = PetscRandomSetSeed(rand, 31 + rank);CHKERRQ(ierr);
+  ierr = PetscRandomSeed(rand);CHKERRQ(ierr);
+  ierr = PetscMalloc4(n*dim, &points, n*dim*size, &allPoints, size, &counts, size, &displs);CHKERRQ(ierr);
+  for (c = 0; c < n*dim; ++c) {ierr = PetscRandomGetValueReal(rand, &points[c]);CHKERRQ(ierr);}
+  for (r = 0; r < size; ++r) {counts[r] = n*dim; displs[r] = r*n*dim;}
+  ierr = MPI_Allgatherv(points, n*dim, MPIU_REAL, allPoints, counts, displs, MPIU_REAL, PETSC_COMM_WORLD);CHKERRQ(ierr);
+  ierr = DMInterpolationCreate(PETSC_COMM_WORLD, &dctx);CHKERRQ(ierr);
+  ierr = DMInterpolationSetDim(dctx, dim);CHKERRQ(ierr);
+  ierr = DMInterpolationAddPoints(dctx, n, points);CHKERRQ(ierr);
+  ierr = DMInterpolationSetUp(dctx, dm, PETSC_FALSE);CHKERRQ(ierr);
+  ierr = DMInterpolationCreate(PETSC_COMM_WORLD, &rctx);CHKERRQ(ierr);
+  ierr = DMInterpolationSetDim(rctx, dim);CHKERRQ(ierr);
+  ierr = DMInterpolationAddPoints(rctx, n*size, allPoints);CHKERRQ(ierr);
+  ierr = DMInterpolationSetUp(rctx, dm, PETSC_TRUE);CHKERRQ(ierr);
+  *match = dctx->n == rctx->n ? PETSC_TRUE : PETSC_FALSE;
+  if (*match) {
+    ierr = VecGetArrayRead(dctx->coords, &dcoords);CHKERRQ(ierr);
+    ierr = VecGetArrayRead(rctx->coords, &rcoords);CHKERRQ(ierr);
+    for (c = 0; c < dctx->n; ++c) if (dctx->cells[c] != rctx->cells[c]) *match = PETSC_FALSE;
+    for (c = 0; c < dctx->n*dim; ++c) if (dcoords[c] != rcoords[c]) *match = PETSC_FALSE;
+    ierr = VecRestoreArrayRead(dctx->coords, &dcoords);CHKERRQ(ierr);
+    ierr = VecRestoreArrayRead(rctx->coords, &rcoords);CHKERRQ(ierr);
+  }
+  ierr = DMInterpolationDestroy(&dctx);CHKERRQ(ierr);
+  ierr = DMInterpolationDestroy(&rctx);CHKERRQ(ierr);
+  ierr = PetscFree4(points, allPoints, counts, displs);CHKERRQ(ierr);
+  ierr = PetscRandomDestroy(&rand);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+int main(int argc, char **argv)
+{
+  DM             dm;
+  AppCtx         user;
+  PetscBool      imatch, match;
+  PetscInt       numFound, numDiffer, totDiffer;
+  PetscMPIInt    rank;
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc, &argv, NULL, help);if (ierr) return ierr;
+  ierr = ProcessOptions(PETSC_COMM_WORLD, &user);CHKERRQ(ierr);
+  ierr = MPI_Comm_rank(PETSC_COMM_WORLD, &rank);CHKERRQ(ierr);
+  ierr = CreateMesh(PETSC_COMM_WORLD, &user, &dm);CHKERRQ(ierr);
+  ierr = TestLocatePoints(dm, &user, &numFound, &numDiffer);CHKERRQ(ierr);
+  ierr = PetscSynchronizedPrintf(PETSC_COMM_WORLD, "[%d] Located %D of %D points\n", rank, numFound, user.numPoints);CHKERRQ(ierr);
+  ierr = PetscSynchronizedFlush(PETSC_COMM_WORLD, NULL);CHKERRQ(ierr);
+  ierr = MPIU_Allreduce(&numDiffer, &totDiffer, 1, MPIU_INT, MPI_SUM, PETSC_COMM_WORLD);CHKERRQ(ierr);
+  ierr = PetscPrintf(PETSC_COMM_WORLD, "Hierarchy and brute force locations %s\n", totDiffer ? "differ" : "match");CHKERRQ(ierr);
+  ierr = TestInterpolation(dm, &user, &imatch);CHKERRQ(ierr);
+  ierr = MPIU_Allreduce(&imatch, &match, 1, MPIU_BOOL, MPI_LAND, PETSC_COMM_WORLD);CHKERRQ(ierr);
+  ierr = PetscPrintf(PETSC_COMM_WORLD, "Distributed and replicated interpolation points %s\n", match ? "match" : "differ");CHKERRQ(ierr);
+  ierr = DMDestroy(&dm);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+  test:
+    suffix: tri
+    args: -simplex
+
+  test:
+    suffix: quad
+    args: -faces 5,3
+
+  test:
+    suffix: hex
+    args: -dim 3 -faces 3,3,3
+
+  test:
+    suffix: quad_parallel
+    nsize: 2
+    args: -faces 5,3 -petscpartitioner_type simple
+
+  test:
+    suffix: hex_parallel
+    nsize: 3
+    args: -dim 3 -faces 3,3,3 -petscpartitioner_type simple
+
+TEST*/
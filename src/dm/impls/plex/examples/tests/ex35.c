@@ -0,0 +1,211 @@
+static char help[] = "Tests element-by-element storage of a DMPlex operator against the assembled matrix.\n\n";
+
+#include <petscdmplex.h>
+#include <petscds.h>
+#include <petscsnes.h>
+
+typedef struct {
+  PetscInt dim;      /* Topological dimension */
+  PetscInt faces[3]; /* Number of faces per dimension */
+} AppCtx;
+
+/* A nonsymmetric operator -\Delta u + b . \nabla u + u, so that the transpose product is checked as well */
+static void g0_uu(PetscInt dim, PetscInt Nf, PetscInt NfAux,
+                  const PetscInt uOff[], const PetscInt uOff_x[], const PetscScalar u[], const PetscScalar u_t[], const PetscScalar u_x[],
+                  const PetscInt aOff[], const PetscInt aOff_x[], const PetscScalar a[], const PetscScalar a_t[], const PetscScalar a_x[],
+                  PetscReal t, PetscReal u_tShift, const PetscReal x[], PetscInt numConstants, const PetscScalar constants[], PetscScalar g0[])
+{
+  g0[0] = 1.0;
+}
+
+static void g1_uu(PetscInt dim, PetscInt Nf, PetscInt NfAux,
+                  const PetscInt uOff[], const PetscInt uOff_x[], const PetscScalar u[], const PetscScalar u_t[], const PetscScalar u_x[],
+                  const PetscInt aOff[], const PetscInt aOff_x[], const PetscScalar a[], const PetscScalar a_t[], const PetscScalar a_x[],
+                  PetscReal t, PetscReal u_tShift, const PetscReal x[], PetscInt numConstants, const PetscScalar constants[], PetscScalar g1[])
+{
+  PetscInt d;
+  for (d = 0; d < dim; ++d) g1[d] = 1.0/(d+1);
+}
+
+static void g3_uu(PetscInt dim, PetscInt Nf, PetscInt NfAux,
+                  const PetscInt uOff[], const PetscInt uOff_x[], const PetscScalar u[], const PetscScalar u_t[], const PetscScalar u_x[],
+                  const PetscInt aOff[], const PetscInt aOff_x[], const PetscScalar a[], const PetscScalar a_t[], const PetscScalar a_x[],
+                  PetscReal t, PetscReal u_tShift, const PetscReal x[], PetscInt numConstants, const PetscScalar constants[], PetscScalar g3[])
+{
+  PetscInt d;
+  for (d = 0; d < dim; ++d) g3[d*dim+d] = 1.0;
+}
+
+static PetscErrorCode zero(PetscInt dim, PetscReal time, const PetscReal x[], PetscInt Nc, PetscScalar *u, void *ctx)
+{
+  u[0] = 0.0;
+  return 0;
+}
+
+static PetscErrorCode ProcessOptions(MPI_Comm comm, AppCtx *options)
+{
+  PetscInt       n = 3;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  options->dim      = 2;
+  options->faces[0] = 4;
+  options->faces[1] = 4;
+  options->faces[2] = 4;
+  ierr = PetscOptionsBegin(comm, "", "Element Storage Test Options", "DMPLEX");CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-dim", "The topological mesh dimension", "ex35.c", options->dim, &options->dim, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsIntArray("-faces", "Number of faces per dimension", "ex35.c", options->faces, &n, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsEnd();
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode CreateMesh(MPI_Comm comm, AppCtx *user, DM *dm)
+{
+  DM             pdm = NULL;
+  PetscBool      hasLabel;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = DMPlexCreateBoxMesh(comm, user->dim, PETSC_FALSE, user->faces, NULL, NULL, NULL, PETSC_TRUE, dm);CHKERRQ(ierr);
+  ierr = DMHasLabel(*dm, "marker", &hasLabel);CHKERRQ(ierr);
+  if (!hasLabel) {
+    DMLabel label;
+
+    ierr = DMCreateLabel(*dm, "marker");CHKERRQ(ierr);
+    ierr = DMGetLabel(*dm, "marker", &label);CHKERRQ(ierr);
+    ierr = DMPlexMarkBoundaryFaces(*dm, 1, label);CHKERRQ(ierr);
+    ierr = DMPlexLabelComplete(*dm, label);CHKERRQ(ierr);
+  }
+  ierr = DMPlexDistribute(*dm, 0, NULL, &pdm);CHKERRQ(ierr);
+  if (pdm) {
+    ierr = DMDestroy(dm);CHKERRQ(ierr);
+    *dm  = pdm;
+  }
+  ierr = DMSetFromOptions(*dm);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode SetupDiscretization(DM dm, AppCtx *user)
+{
+  PetscFE        fe;
+  PetscDS        prob;
+  const PetscInt id = 1;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscFECreateDefault(PetscObjectComm((PetscObject) dm), user->dim, 1, PETSC_FALSE, NULL, -1, &fe);CHKERRQ(ierr);
+  ierr = DMGetDS(dm, &prob);CHKERRQ(ierr);
+  ierr = PetscDSSetDiscretization(prob, 0, (PetscObject) fe);CHKERRQ(ierr);
+  ierr = PetscDSSetJacobian(prob, 0, 0, g0_uu, g1_uu, NULL, g3_uu);CHKERRQ(ierr);
+  ierr = PetscDSAddBoundary(prob, DM_BC_ESSENTIAL, "wall", "marker", 0, 0, NULL, (void (*)(void)) zero, 1, &id, NULL);CHKERRQ(ierr);
+  ierr = PetscFEDestroy(&fe);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode CheckDifference(Vec a, Vec b, const char name[])
+{
+  PetscReal      norm, diff;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = VecNorm(a, NORM_2, &norm);CHKERRQ(ierr);
+  ierr = VecAXPY(b, -1.0, a);CHKERRQ(ierr);
+  ierr = VecNorm(b, NORM_2, &diff);CHKERRQ(ierr);
+  if (diff > 1.0e-10*norm) {ierr = PetscPrintf(PETSC_COMM_WORLD, "%s differs from the assembled matrix by %g\n", name, (double) (diff/norm));CHKERRQ(ierr);}
+  else                     {ierr = PetscPrintf(PETSC_COMM_WORLD, "%s matches the assembled matrix\n", name);CHKERRQ(ierr);}
+  PetscFunctionReturn(0);
+}
+
+int main(int argc, char **argv)
+{
+  AppCtx         user;
+  DM             dm;
+  Mat            A, E, C;
+  Vec            u, x, y, z;
+  KSP            ksp;
+  PetscRandom    rand;
+  PetscReal      norm, diff;
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc, &argv, NULL, help);if (ierr) return ierr;
+  ierr = ProcessOptions(PETSC_COMM_WORLD, &user);CHKERRQ(ierr);
+  ierr = CreateMesh(PETSC_COMM_WORLD, &user, &dm);CHKERRQ(ierr);
+  ierr = SetupDiscretization(dm, &user);CHKERRQ(ierr);
+  ierr = DMCreateGlobalVector(dm, &u);CHKERRQ(ierr);
+  ierr = VecSet(u, 0.0);CHKERRQ(ierr);
+  ierr = DMSetMatType(dm, MATAIJ);CHKERRQ(ierr);
+  ierr = DMCreateMatrix(dm, &A);CHKERRQ(ierr);
+  ierr = DMSetMatType(dm, MATEBE);CHKERRQ(ierr);
+  ierr = DMCreateMatrix(dm, &E);CHKERRQ(ierr);
+  ierr = DMPlexSNESComputeJacobianFEM(dm, u, A, A, NULL);CHKERRQ(ierr);
+  ierr = DMPlexSNESComputeJacobianFEM(dm, u, E, E, NULL);CHKERRQ(ierr);
+  ierr = PetscViewerPushFormat(PETSC_VIEWER_STDOUT_WORLD, PETSC_VIEWER_ASCII_INFO);CHKERRQ(ierr);
+  ierr = MatView(E, PETSC_VIEWER_STDOUT_WORLD);CHKERRQ(ierr);
+  ierr = PetscViewerPopFormat(PETSC_VIEWER_STDOUT_WORLD);CHKERRQ(ierr);
+  /* Compare the products and the diagonal with the assembled matrix */
+  ierr = VecDuplicate(u, &x);CHKERRQ(ierr);
+  ierr = VecDuplicate(u, &y);CHKERRQ(ierr);
+  ierr = VecDuplicate(u, &z);CHKERRQ(ierr);
+  ierr = PetscRandomCreate(PETSC_COMM_WORLD, &rand);CHKERRQ(ierr);
+  ierr = PetscRandomSetFromOptions(rand);CHKERRQ(ierr);
+  ierr = VecSetRandom(x, rand);CHKERRQ(ierr);
+  ierr = MatMult(A, x, y);CHKERRQ(ierr);
+  ierr = MatMult(E, x, z);CHKERRQ(ierr);
+  ierr = CheckDifference(y, z, "MatMult()");CHKERRQ(ierr);
+  ierr = MatMultTranspose(A, x, y);CHKERRQ(ierr);
+  ierr = MatMultTranspose(E, x, z);CHKERRQ(ierr);
+  ierr = CheckDifference(y, z, "MatMultTranspose()");CHKERRQ(ierr);
+  ierr = MatMultAdd(A, x, x, y);CHKERRQ(ierr);
+  ierr = MatMultAdd(E, x, x, z);CHKERRQ(ierr);
+  ierr = CheckDifference(y, z, "MatMultAdd()");CHKERRQ(ierr);
+  ierr = MatGetDiagonal(A, y);CHKERRQ(ierr);
+  ierr = MatGetDiagonal(E, z);CHKERRQ(ierr);
+  ierr = CheckDifference(y, z, "MatGetDiagonal()");CHKERRQ(ierr);
+  ierr = MatConvert(E, MATAIJ, MAT_INITIAL_MATRIX, &C);CHKERRQ(ierr);
+  ierr = MatNorm(A, NORM_FROBENIUS, &norm);CHKERRQ(ierr);
+  ierr = MatAXPY(C, -1.0, A, DIFFERENT_NONZERO_PATTERN);CHKERRQ(ierr);
+  ierr = MatNorm(C, NORM_FROBENIUS, &diff);CHKERRQ(ierr);
+  if (diff > 1.0e-10*norm) {ierr = PetscPrintf(PETSC_COMM_WORLD, "MatConvert() differs from the assembled matrix by %g\n", (double) (diff/norm));CHKERRQ(ierr);}
+  else                     {ierr = PetscPrintf(PETSC_COMM_WORLD, "MatConvert() matches the assembled matrix\n");CHKERRQ(ierr);}
+  ierr = MatDestroy(&C);CHKERRQ(ierr);
+  /* Solve with the element operator and a diagonal preconditioner, and check against the assembled operator */
+  ierr = MatMult(A, x, y);CHKERRQ(ierr);
+  ierr = KSPCreate(PETSC_COMM_WORLD, &ksp);CHKERRQ(ierr);
+  ierr = KSPSetOperators(ksp, E, E);CHKERRQ(ierr);
+  ierr = KSPSetTolerances(ksp, 1.0e-12, PETSC_DEFAULT, PETSC_DEFAULT, PETSC_DEFAULT);CHKERRQ(ierr);
+  ierr = KSPSetFromOptions(ksp);CHKERRQ(ierr);
+  ierr = KSPSolve(ksp, y, z);CHKERRQ(ierr);
+  ierr = CheckDifference(x, z, "KSPSolve()");CHKERRQ(ierr);
+  ierr = KSPDestroy(&ksp);CHKERRQ(ierr);
+  ierr = PetscRandomDestroy(&rand);CHKERRQ(ierr);
+  ierr = VecDestroy(&u);CHKERRQ(ierr);
+  ierr = VecDestroy(&x);CHKERRQ(ierr);
+  ierr = VecDestroy(&y);CHKERRQ(ierr);
+  ierr = VecDestroy(&z);CHKERRQ(ierr);
+  ierr = MatDestroy(&A);CHKERRQ(ierr);
+  ierr = MatDestroy(&E);CHKERRQ(ierr);
+  ierr = DMDestroy(&dm);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+  test:
+    suffix: q1
+    args: -petscspace_order 1 -ksp_type gmres -pc_type jacobi
+
+  test:
+    suffix: q2
+    args: -petscspace_order 2 -faces 3,3 -ksp_type gmres -pc_type jacobi
+
+  test:
+    suffix: hex
+    args: -dim 3 -faces 2,2,2 -petscspace_order 2 -ksp_type gmres -pc_type jacobi
+
+  test:
+    suffix: q2_parallel
+    nsize: 3
+    args: -petscspace_order 2 -faces 6,6 -ksp_type gmres -pc_type jacobi
+
+TEST*/
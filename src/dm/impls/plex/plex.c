@@ -1059,6 +1059,7 @@ PetscErrorCode DMLoad_Plex(DM dm, PetscViewer viewer)
 PetscErrorCode DMDestroy_Plex(DM dm)
 {
   DM_Plex       *mesh = (DM_Plex*) dm->data;
+  PetscInt       th;
   PetscErrorCode ierr;
 
   PetscFunctionBegin;
@@ -1087,17 +1088,82 @@ PetscErrorCode DMDestroy_Plex(DM dm)
   ierr = PetscFree(mesh->children);CHKERRQ(ierr);
   ierr = DMDestroy(&mesh->referenceTree);CHKERRQ(ierr);
   ierr = PetscGridHashDestroy(&mesh->lbox);CHKERRQ(ierr);
+  ierr = DMPlexCellBVHDestroy_Internal(&mesh->bvh);CHKERRQ(ierr);
+  for (th = 0; th < mesh->numThreadDS; ++th) {
+    ierr = PetscDSDestroy(&mesh->threadDS[th]);CHKERRQ(ierr);
+    ierr = PetscDSDestroy(&mesh->threadDSAux[th]);CHKERRQ(ierr);
+  }
+  ierr = PetscFree2(mesh->threadDS, mesh->threadDSAux);CHKERRQ(ierr);
   /* This was originally freed in DMDestroy(), but that prevents reference counting of backend objects */
   ierr = PetscFree(mesh);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
+/* A MATEBE operator has one element per cell, whose dofs index the local vector in the order of DMPlexVecGetClosure() */
+static PetscErrorCode DMPlexSetUpMatrixEBE_Private(DM dm, Mat J)
+{
+  PetscSection             section, sectionGlobal, anchorSection;
+  DMPlexClosureIndexCache *cache;
+  ISLocalToGlobalMapping   ltog;
+  PetscInt                *ltogidx, Nf, size, pStart, pEnd, p, Nb, c;
+  PetscErrorCode           ierr;
+
+  PetscFunctionBegin;
+  ierr = DMGetDefaultSection(dm, &section);CHKERRQ(ierr);
+  ierr = DMGetDefaultGlobalSection(dm, &sectionGlobal);CHKERRQ(ierr);
+  ierr = DMPlexGetAnchors(dm, &anchorSection, NULL);CHKERRQ(ierr);
+  if (anchorSection) SETERRQ(PetscObjectComm((PetscObject) dm), PETSC_ERR_SUP, "MATEBE cannot represent anchored closures");
+  ierr = PetscSectionGetNumFields(section, &Nf);CHKERRQ(ierr);
+  ierr = PetscSectionGetStorageSize(section, &size);CHKERRQ(ierr);
+  ierr = PetscSectionGetChart(section, &pStart, &pEnd);CHKERRQ(ierr);
+  ierr = PetscMalloc1(size, &ltogidx);CHKERRQ(ierr);
+  /* Number the unconstrained dofs of each point field by field, as DMPlexGetClosureIndices() does */
+  for (p = pStart; p < pEnd; ++p) {
+    PetscInt goff, g, f;
+
+    ierr = PetscSectionGetOffset(sectionGlobal, p, &goff);CHKERRQ(ierr);
+    g    = goff < 0 ? -(goff+1) : goff;
+    for (f = 0; f < PetscMax(1, Nf); ++f) {
+      const PetscInt *cdofs;
+      PetscInt        dof, off, cdof, cind = 0, k;
+
+      if (Nf) {
+        ierr = PetscSectionGetFieldDof(section, p, f, &dof);CHKERRQ(ierr);
+        ierr = PetscSectionGetFieldOffset(section, p, f, &off);CHKERRQ(ierr);
+        ierr = PetscSectionGetFieldConstraintDof(section, p, f, &cdof);CHKERRQ(ierr);
+        ierr = PetscSectionGetFieldConstraintIndices(section, p, f, &cdofs);CHKERRQ(ierr);
+      } else {
+        ierr = PetscSectionGetDof(section, p, &dof);CHKERRQ(ierr);
+        ierr = PetscSectionGetOffset(section, p, &off);CHKERRQ(ierr);
+        ierr = PetscSectionGetConstraintDof(section, p, &cdof);CHKERRQ(ierr);
+        ierr = PetscSectionGetConstraintIndices(section, p, &cdofs);CHKERRQ(ierr);
+      }
+      for (k = 0; k < dof; ++k) {
+        if ((cind < cdof) && (k == cdofs[cind])) {ltogidx[off+k] = -1; ++cind;}
+        else                                     {ltogidx[off+k] = g++;}
+      }
+    }
+  }
+  ierr = ISLocalToGlobalMappingCreate(PetscObjectComm((PetscObject) dm), 1, size, ltogidx, PETSC_OWN_POINTER, &ltog);CHKERRQ(ierr);
+  ierr = MatSetLocalToGlobalMapping(J, ltog, ltog);CHKERRQ(ierr);
+  ierr = ISLocalToGlobalMappingDestroy(&ltog);CHKERRQ(ierr);
+  /* Constrained dofs are encoded as negative local indices in the cache, which the matrix drops */
+  ierr = DMPlexGetClosureIndexCache_Internal(dm, section, NULL, &cache);CHKERRQ(ierr);
+  if (!cache->lvalid) SETERRQ(PetscObjectComm((PetscObject) dm), PETSC_ERR_SUP, "MATEBE cannot represent closures which are not a plain gather of the local vector");
+  Nb = cache->cEnd > cache->cStart ? cache->off[1] : 0;
+  for (c = cache->cStart; c < cache->cEnd; ++c) {
+    if (cache->off[c-cache->cStart+1] - cache->off[c-cache->cStart] != Nb) SETERRQ3(PETSC_COMM_SELF, PETSC_ERR_SUP, "MATEBE requires closures of equal size, but cell %D has %D dofs instead of %D", c, cache->off[c-cache->cStart+1] - cache->off[c-cache->cStart], Nb);
+  }
+  ierr = MatEBESetElements(J, cache->cEnd-cache->cStart, Nb, cache->lidx);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 PetscErrorCode DMCreateMatrix_Plex(DM dm, Mat *J)
 {
   PetscSection           sectionGlobal;
   PetscInt               bs = -1, mbs;
   PetscInt               localSize;
-  PetscBool              isShell, isBlock, isSeqBlock, isMPIBlock, isSymBlock, isSymSeqBlock, isSymMPIBlock, isMatIS;
+  PetscBool              isShell, isBlock, isSeqBlock, isMPIBlock, isSymBlock, isSymSeqBlock, isSymMPIBlock, isMatIS, isEBE;
   PetscErrorCode         ierr;
   MatType                mtype;
   ISLocalToGlobalMapping ltog;
@@ -1122,7 +1188,10 @@ PetscErrorCode DMCreateMatrix_Plex(DM dm, Mat *J)
   ierr = PetscStrcmp(mtype, MATSEQSBAIJ, &isSymSeqBlock);CHKERRQ(ierr);
   ierr = PetscStrcmp(mtype, MATMPISBAIJ, &isSymMPIBlock);CHKERRQ(ierr);
   ierr = PetscStrcmp(mtype, MATIS, &isMatIS);CHKERRQ(ierr);
-  if (!isShell) {
+  ierr = PetscStrcmp(mtype, MATEBE, &isEBE);CHKERRQ(ierr);
+  if (isEBE) {
+    ierr = DMPlexSetUpMatrixEBE_Private(dm, *J);CHKERRQ(ierr);
+  } else if (!isShell) {
     PetscSection subSection;
     PetscBool    fillMatrix = (PetscBool)(!dm->prealloc_only && !isMatIS);
     PetscInt    *dnz, *onz, *dnzu, *onzu, bsLocal[2], bsMinMax[2], *ltogidx, lsize;
@@ -2283,6 +2352,33 @@ PetscErrorCode DMPlexSymmetrize(DM dm)
   PetscFunctionReturn(0);
 }
 
+/* Compact the cone and support sections, whose sizes are mostly constant over each stratum */
+static PetscErrorCode DMPlexCompactTopology_Static(DM dm)
+{
+  DM_Plex       *mesh = (DM_Plex*) dm->data;
+  PetscSection   sections[2];
+  PetscInt       maxRuns, depth, s;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  sections[0] = mesh->coneSection;
+  sections[1] = mesh->supportSection;
+  ierr = DMPlexGetDepth(dm, &depth);CHKERRQ(ierr);
+  /* Allow a few cell types, or boundary and interior sizes, in each stratum */
+  maxRuns = 8*(PetscMax(depth, 0)+1);
+  for (s = 0; s < 2; ++s) {
+    PetscInt  pStart, pEnd;
+    PetscBool compact;
+
+    if (!sections[s]->setup || sections[s]->numRuns) continue;
+    ierr = PetscSectionGetChart(sections[s], &pStart, &pEnd);CHKERRQ(ierr);
+    ierr = PetscSectionCompact_Internal(sections[s], maxRuns, &compact);CHKERRQ(ierr);
+    if (compact) {ierr = PetscInfo3(dm, "Compacted %s section of %D points into %D runs\n", s ? "support" : "cone", pEnd-pStart, sections[s]->numRuns);CHKERRQ(ierr);}
+    else         {ierr = PetscInfo1(dm, "Could not compact %s section\n", s ? "support" : "cone");CHKERRQ(ierr);}
+  }
+  PetscFunctionReturn(0);
+}
+
 /*@
   DMPlexStratify - The DAG for most topologies is a graded poset (http://en.wikipedia.org/wiki/Graded_poset), and
   can be illustrated by a Hasse Diagram (a http://en.wikipedia.org/wiki/Hasse_diagram). The strata group all points of the
@@ -2411,6 +2507,7 @@ PetscErrorCode DMPlexStratify(DM dm)
   }
 
   ierr = DMLabelGetState(label, &mesh->depthState);CHKERRQ(ierr);
+  if (mesh->compactTopology) {ierr = DMPlexCompactTopology_Static(dm);CHKERRQ(ierr);}
   ierr = PetscLogEventEnd(DMPLEX_Stratify,dm,0,0,0);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
@@ -4152,6 +4249,33 @@ PetscErrorCode DMPlexVecGetClosure(DM dm, PetscSection section, Vec v, PetscInt
   if (!section) {ierr = DMGetDefaultSection(dm, &section);CHKERRQ(ierr);}
   PetscValidHeaderSpecific(section, PETSC_SECTION_CLASSID, 2);
   PetscValidHeaderSpecific(v, VEC_CLASSID, 3);
+  if (((DM_Plex *) dm->data)->useClosureIndexCache) {
+    DMPlexClosureIndexCache *cache;
+
+    ierr = DMPlexGetClosureIndexCache_Internal(dm, section, NULL, &cache);CHKERRQ(ierr);
+    if (cache->lvalid && (point >= cache->cStart) && (point < cache->cEnd)) {
+      const PetscInt *lidx = &cache->lidx[cache->off[point-cache->cStart]];
+      PetscInt        i;
+
+      size = cache->off[point-cache->cStart+1] - cache->off[point-cache->cStart];
+      if (!values) {
+        if (csize) *csize = size;
+        PetscFunctionReturn(0);
+      }
+      if (!*values) {
+        ierr = DMGetWorkArray(dm, size, MPIU_SCALAR, &array);CHKERRQ(ierr);
+      } else {
+        if (size > *csize) SETERRQ2(PETSC_COMM_SELF, PETSC_ERR_ARG_OUTOFRANGE, "Size of input array %D < actual size %D", *csize, size);
+        array = *values;
+      }
+      ierr = VecGetArrayRead(v, &vArray);CHKERRQ(ierr);
+      for (i = 0; i < size; ++i) array[i] = vArray[lidx[i] < 0 ? -(lidx[i]+1) : lidx[i]];
+      ierr = VecRestoreArrayRead(v, &vArray);CHKERRQ(ierr);
+      if (csize) *csize = size;
+      *values = array;
+      PetscFunctionReturn(0);
+    }
+  }
   ierr = DMPlexGetDepth(dm, &depth);CHKERRQ(ierr);
   ierr = PetscSectionGetNumFields(section, &numFields);CHKERRQ(ierr);
   if (depth == 1 && numFields < 2) {
@@ -4575,6 +4699,43 @@ PetscErrorCode DMPlexVecSetClosure(DM dm, PetscSection section, Vec v, PetscInt
   if (!section) {ierr = DMGetDefaultSection(dm, &section);CHKERRQ(ierr);}
   PetscValidHeaderSpecific(section, PETSC_SECTION_CLASSID, 2);
   PetscValidHeaderSpecific(v, VEC_CLASSID, 3);
+  if (((DM_Plex *) dm->data)->useClosureIndexCache) {
+    DMPlexClosureIndexCache *cache;
+
+    ierr = DMPlexGetClosureIndexCache_Internal(dm, section, NULL, &cache);CHKERRQ(ierr);
+    /* The cell-vertex ordering is only used for ADD_VALUES, see DMPlexVecSetClosure_Depth1_Static() */
+    if (cache->lvalid && (!cache->depth1 || mode == ADD_VALUES) && (point >= cache->cStart) && (point < cache->cEnd)) {
+      const PetscInt *lidx = &cache->lidx[cache->off[point-cache->cStart]];
+      const PetscInt  size = cache->off[point-cache->cStart+1] - cache->off[point-cache->cStart];
+      PetscInt        i;
+
+      ierr = VecGetArray(v, &array);CHKERRQ(ierr);
+      switch (mode) {
+      case INSERT_VALUES:
+        for (i = 0; i < size; ++i) if (lidx[i] >= 0) array[lidx[i]] = values[i];
+        break;
+      case INSERT_ALL_VALUES:
+        for (i = 0; i < size; ++i) array[lidx[i] < 0 ? -(lidx[i]+1) : lidx[i]] = values[i];
+        break;
+      case INSERT_BC_VALUES:
+        for (i = 0; i < size; ++i) if (lidx[i] < 0) array[-(lidx[i]+1)] = values[i];
+        break;
+      case ADD_VALUES:
+        for (i = 0; i < size; ++i) if (lidx[i] >= 0) array[lidx[i]] += values[i];
+        break;
+      case ADD_ALL_VALUES:
+        for (i = 0; i < size; ++i) array[lidx[i] < 0 ? -(lidx[i]+1) : lidx[i]] += values[i];
+        break;
+      case ADD_BC_VALUES:
+        for (i = 0; i < size; ++i) if (lidx[i] < 0) array[-(lidx[i]+1)] += values[i];
+        break;
+      default:
+        SETERRQ1(PetscObjectComm((PetscObject)dm), PETSC_ERR_ARG_OUTOFRANGE, "Invalid insert mode %d", mode);
+      }
+      ierr = VecRestoreArray(v, &array);CHKERRQ(ierr);
+      PetscFunctionReturn(0);
+    }
+  }
   ierr = DMPlexGetDepth(dm, &depth);CHKERRQ(ierr);
   ierr = PetscSectionGetNumFields(section, &numFields);CHKERRQ(ierr);
   if (depth == 1 && numFields < 2 && mode == ADD_VALUES) {
@@ -5618,6 +5779,7 @@ PetscErrorCode DMPlexMatSetClosure(DM dm, PetscSection section, PetscSection glo
   PetscInt            numFields, numPoints, newNumPoints, numIndices, newNumIndices, dof, off, globalOff, p, f;
   PetscScalar        *valCopy = NULL;
   PetscScalar        *newValues;
+  PetscBool           isEBE;
   PetscErrorCode      ierr;
 
   PetscFunctionBegin;
@@ -5627,6 +5789,43 @@ PetscErrorCode DMPlexMatSetClosure(DM dm, PetscSection section, PetscSection glo
   if (!globalSection) {ierr = DMGetDefaultGlobalSection(dm, &globalSection);CHKERRQ(ierr);}
   PetscValidHeaderSpecific(globalSection, PETSC_SECTION_CLASSID, 3);
   PetscValidHeaderSpecific(A, MAT_CLASSID, 4);
+  ierr = PetscObjectTypeCompare((PetscObject) A, MATEBE, &isEBE);CHKERRQ(ierr);
+  if (isEBE) {
+    PetscInt cStart, cEnd;
+
+    /* The element matrix is the cell block itself, so no indices are needed */
+    ierr = DMPlexGetHeightStratum(dm, 0, &cStart, &cEnd);CHKERRQ(ierr);
+    if ((point < cStart) || (point >= cEnd)) SETERRQ3(PETSC_COMM_SELF, PETSC_ERR_ARG_OUTOFRANGE, "MATEBE only holds cell closures, and point %D is not in [%D, %D)", point, cStart, cEnd);
+    ierr = MatEBESetElementValues(A, point-cStart, values, mode);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  if (mesh->useClosureIndexCache) {
+    DMPlexClosureIndexCache *cache;
+
+    ierr = DMPlexGetClosureIndexCache_Internal(dm, section, globalSection, &cache);CHKERRQ(ierr);
+    if (cache->gvalid && (point >= cache->cStart) && (point < cache->cEnd)) {
+      indices    = &cache->gidx[cache->off[point-cache->cStart]];
+      numIndices = cache->off[point-cache->cStart+1] - cache->off[point-cache->cStart];
+      if (mesh->printSetValues) {ierr = DMPlexPrintMatSetValues(PETSC_VIEWER_STDOUT_SELF, A, point, numIndices, indices, 0, NULL, values);CHKERRQ(ierr);}
+      ierr = MatSetValues(A, numIndices, indices, numIndices, indices, values, mode);
+      if (ierr) {
+        PetscMPIInt    rank;
+        PetscErrorCode ierr2;
+
+        ierr2 = MPI_Comm_rank(PetscObjectComm((PetscObject)A), &rank);CHKERRQ(ierr2);
+        ierr2 = (*PetscErrorPrintf)("[%d]ERROR in DMPlexMatSetClosure\n", rank);CHKERRQ(ierr2);
+        ierr2 = DMPlexPrintMatSetValues(PETSC_VIEWER_STDERR_SELF, A, point, numIndices, indices, 0, NULL, values);CHKERRQ(ierr2);
+        CHKERRQ(ierr);
+      }
+      if (mesh->printFEM > 1) {
+        PetscInt i;
+        ierr = PetscPrintf(PETSC_COMM_SELF, "  Indices:");CHKERRQ(ierr);
+        for (i = 0; i < numIndices; ++i) {ierr = PetscPrintf(PETSC_COMM_SELF, " %D", indices[i]);CHKERRQ(ierr);}
+        ierr = PetscPrintf(PETSC_COMM_SELF, "\n");CHKERRQ(ierr);
+      }
+      PetscFunctionReturn(0);
+    }
+  }
   ierr = PetscSectionGetNumFields(section, &numFields);CHKERRQ(ierr);
   if (numFields > 31) SETERRQ1(PetscObjectComm((PetscObject)dm), PETSC_ERR_ARG_OUTOFRANGE, "Number of fields %D limited to 31", numFields);
   ierr = PetscMemzero(offsets, 32 * sizeof(PetscInt));CHKERRQ(ierr);
@@ -6871,6 +7070,176 @@ PetscErrorCode DMPlexSetRegularRefinement(DM dm, PetscBool regular)
   PetscFunctionReturn(0);
 }
 
+/*@
+  DMPlexGetThreadedAssembly - Get the flag indicating that residuals and Jacobians are assembled by concurrent threads
+
+  Input Parameter:
+. dm - The DMPlex object
+
+  Output Parameter:
+. threaded - The flag
+
+  Level: intermediate
+
+.seealso: DMPlexSetThreadedAssembly()
+@*/
+PetscErrorCode DMPlexGetThreadedAssembly(DM dm, PetscBool *threaded)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(dm, DM_CLASSID, 1);
+  PetscValidPointer(threaded, 2);
+  *threaded = ((DM_Plex *) dm->data)->threadedAssembly;
+  PetscFunctionReturn(0);
+}
+
+/*@
+  DMPlexSetThreadedAssembly - Set the flag indicating that residuals and Jacobians are assembled by concurrent threads
+
+  Input Parameters:
++ dm - The DMPlex object
+- threaded - The flag
+
+  Options Database:
+. -dm_plex_threaded_assembly - Use threaded assembly
+
+  Notes:
+  The cells are split into one contiguous slab per thread, and each thread integrates its slab using its own copy of
+  the PetscDS work arrays. The element vectors are then added into the local residual one color of
+  DMPlexCreateClosureColoring() at a time, where the cells of a color are added concurrently since their closures are
+  disjoint. Element matrices are inserted by a single thread, since MatSetValues() is not thread safe.
+
+  Threads are only used when PETSc is configured with OpenMP and --with-threadsafety, since the integration calls PETSc
+  routines. Otherwise the same algorithm runs on a single thread.
+
+  Level: intermediate
+
+.seealso: DMPlexGetThreadedAssembly(), DMPlexCreateClosureColoring(), PetscFESetTileSizes()
+@*/
+PetscErrorCode DMPlexSetThreadedAssembly(DM dm, PetscBool threaded)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(dm, DM_CLASSID, 1);
+  ((DM_Plex *) dm->data)->threadedAssembly = threaded;
+  PetscFunctionReturn(0);
+}
+
+/*@
+  DMPlexGetUseClosureIndexCache - Get the flag indicating that cell closures are gathered and scattered through precomputed indices
+
+  Input Parameter:
+. dm - The DMPlex object
+
+  Output Parameter:
+. useCache - The flag
+
+  Level: intermediate
+
+.seealso: DMPlexSetUseClosureIndexCache()
+@*/
+PetscErrorCode DMPlexGetUseClosureIndexCache(DM dm, PetscBool *useCache)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(dm, DM_CLASSID, 1);
+  PetscValidPointer(useCache, 2);
+  *useCache = ((DM_Plex *) dm->data)->useClosureIndexCache;
+  PetscFunctionReturn(0);
+}
+
+/*@
+  DMPlexSetUseClosureIndexCache - Set the flag indicating that cell closures are gathered and scattered through precomputed indices
+
+  Input Parameters:
++ dm - The DMPlex object
+- useCache - The flag
+
+  Options Database:
+. -dm_plex_closure_index_cache - Use the closure index cache
+
+  Notes:
+  On first use with a PetscSection, the local indices of the closure of every cell are computed, with the orientation
+  permutations and the closure permutation already applied, and stored in CSR form on the section. The global indices
+  used by DMPlexMatSetClosure() are stored in the same way for the global section. DMPlexVecGetClosure(),
+  DMPlexVecSetClosure() and DMPlexMatSetClosure() on a cell are then a plain gather or scatter. The indices are
+  recomputed when the section changes.
+
+  Closures with sign flips, and global indices with anchors, are not cached and go through the usual path. The cache
+  holds one index per closure dof of each cell, for the local section and again for the global section.
+
+  Level: intermediate
+
+.seealso: DMPlexGetUseClosureIndexCache(), DMPlexCreateClosureIndex(), DMPlexVecGetClosure(), DMPlexMatSetClosure()
+@*/
+PetscErrorCode DMPlexSetUseClosureIndexCache(DM dm, PetscBool useCache)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(dm, DM_CLASSID, 1);
+  ((DM_Plex *) dm->data)->useClosureIndexCache = useCache;
+  PetscFunctionReturn(0);
+}
+
+/*@
+  DMPlexGetCompactTopology - Get the flag indicating that the cone and support sections are stored compactly
+
+  Input Parameter:
+. dm - The DMPlex object
+
+  Output Parameter:
+. compact - The flag
+
+  Level: intermediate
+
+.seealso: DMPlexSetCompactTopology()
+@*/
+PetscErrorCode DMPlexGetCompactTopology(DM dm, PetscBool *compact)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(dm, DM_CLASSID, 1);
+  PetscValidPointer(compact, 2);
+  *compact = ((DM_Plex *) dm->data)->compactTopology;
+  PetscFunctionReturn(0);
+}
+
+/*@
+  DMPlexSetCompactTopology - Set the flag indicating that the cone and support sections are stored compactly
+
+  Input Parameters:
++ dm - The DMPlex object
+- compact - The flag
+
+  Options Database:
+. -dm_plex_compact_topology - Store the cone and support sections compactly
+
+  Notes:
+  The cone section and support section hold an offset and a size for every mesh point. Since the points of a stratum
+  are numbered contiguously, and usually all have the same cone size, these sections are stored instead as a short list
+  of runs of points with equal size and contiguous offsets, saving two integers per mesh point. DMPlexGetCone() and the
+  other topology queries are unchanged, and find the run by a binary search. Sections with too many runs, such as most
+  support sections, are left as they are.
+
+  The sections are compacted now if they have been set up, and otherwise by DMPlexStratify(). Changing a cone or
+  support size expands the section again. The flag is passed on by DMPlexDistribute() and DMPlexDistributeOverlap().
+
+  Level: intermediate
+
+.seealso: DMPlexGetCompactTopology(), DMPlexStratify(), DMPlexGetConeSection(), DMPlexGetSupportSection()
+@*/
+PetscErrorCode DMPlexSetCompactTopology(DM dm, PetscBool compact)
+{
+  DM_Plex       *mesh = (DM_Plex*) dm->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(dm, DM_CLASSID, 1);
+  mesh->compactTopology = compact;
+  if (compact) {
+    ierr = DMPlexCompactTopology_Static(dm);CHKERRQ(ierr);
+  } else {
+    ierr = PetscSectionExpand_Internal(mesh->coneSection);CHKERRQ(ierr);
+    ierr = PetscSectionExpand_Internal(mesh->supportSection);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
 /* anchors */
 /*@
   DMPlexGetAnchors - Get the layout of the anchor (point-to-point) constraints.  Typically, the user will not have to
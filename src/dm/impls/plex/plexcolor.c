@@ -0,0 +1,93 @@
+#include <petsc/private/dmpleximpl.h>   /*I      "petscdmplex.h"   I*/
+
+/*@
+  DMPlexCreateClosureColoring - Color the given cells so that no two cells of the same color share a point in their closures
+
+  Not collective
+
+  Input Parameters:
++ dm     - The DMPlex object
+- cellIS - The cells to color
+
+  Output Parameter:
+. coloring - The coloring, where entry i is the color of the i-th cell in cellIS
+
+  Note: Since the closures of cells of one color are disjoint, values on the cells of one color can be added into a local
+  vector or matrix concurrently. Two cells share a closure point exactly when they share a vertex, so the coloring is a
+  greedy distance-1 coloring of the cell-vertex incidence, in the order of cellIS.
+
+  Level: developer
+
+.seealso: DMPlexSetThreadedAssembly(), ISColoringGetIS()
+@*/
+PetscErrorCode DMPlexCreateClosureColoring(DM dm, IS cellIS, ISColoring *coloring)
+{
+  const PetscInt  *cells;
+  ISColoringValue *colors;
+  PetscInt        *cOff, *cVerts, *vOff, *vCells, *mark;
+  PetscInt         numCells, vStart, vEnd, numColors = 0, c, v, i, j;
+  PetscErrorCode   ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(dm, DM_CLASSID, 1);
+  PetscValidHeaderSpecific(cellIS, IS_CLASSID, 2);
+  PetscValidPointer(coloring, 3);
+  ierr = ISGetLocalSize(cellIS, &numCells);CHKERRQ(ierr);
+  ierr = ISGetIndices(cellIS, &cells);CHKERRQ(ierr);
+  ierr = DMPlexGetDepthStratum(dm, 0, &vStart, &vEnd);CHKERRQ(ierr);
+  /* Cell to vertex incidence */
+  ierr = PetscMalloc1(numCells+1, &cOff);CHKERRQ(ierr);
+  cOff[0] = 0;
+  for (c = 0; c < numCells; ++c) {
+    PetscInt *closure = NULL, clSize, cl, n = 0;
+
+    ierr = DMPlexGetTransitiveClosure(dm, cells[c], PETSC_TRUE, &clSize, &closure);CHKERRQ(ierr);
+    for (cl = 0; cl < clSize*2; cl += 2) if ((closure[cl] >= vStart) && (closure[cl] < vEnd)) ++n;
+    ierr = DMPlexRestoreTransitiveClosure(dm, cells[c], PETSC_TRUE, &clSize, &closure);CHKERRQ(ierr);
+    cOff[c+1] = cOff[c] + n;
+  }
+  ierr = PetscMalloc1(cOff[numCells], &cVerts);CHKERRQ(ierr);
+  for (c = 0; c < numCells; ++c) {
+    PetscInt *closure = NULL, clSize, cl, n = cOff[c];
+
+    ierr = DMPlexGetTransitiveClosure(dm, cells[c], PETSC_TRUE, &clSize, &closure);CHKERRQ(ierr);
+    for (cl = 0; cl < clSize*2; cl += 2) if ((closure[cl] >= vStart) && (closure[cl] < vEnd)) cVerts[n++] = closure[cl] - vStart;
+    ierr = DMPlexRestoreTransitiveClosure(dm, cells[c], PETSC_TRUE, &clSize, &closure);CHKERRQ(ierr);
+  }
+  ierr = ISRestoreIndices(cellIS, &cells);CHKERRQ(ierr);
+  /* Vertex to cell incidence */
+  ierr = PetscCalloc1(vEnd-vStart+1, &vOff);CHKERRQ(ierr);
+  for (i = 0; i < cOff[numCells]; ++i) ++vOff[cVerts[i]+1];
+  for (v = 0; v < vEnd-vStart; ++v) vOff[v+1] += vOff[v];
+  ierr = PetscMalloc1(cOff[numCells], &vCells);CHKERRQ(ierr);
+  for (c = 0; c < numCells; ++c) for (i = cOff[c]; i < cOff[c+1]; ++i) vCells[vOff[cVerts[i]]++] = c;
+  for (v = vEnd-vStart; v > 0; --v) vOff[v] = vOff[v-1];
+  vOff[0] = 0;
+  /* Greedy coloring: mark[k] == c if color k is used by a neighbor of cell c */
+  ierr = PetscMalloc1(numCells, &colors);CHKERRQ(ierr);
+  ierr = PetscMalloc1(numCells+1, &mark);CHKERRQ(ierr);
+  for (c = 0; c <= numCells; ++c) mark[c] = -1;
+  for (c = 0; c < numCells; ++c) {
+    PetscInt color = 0;
+
+    for (i = cOff[c]; i < cOff[c+1]; ++i) {
+      for (j = vOff[cVerts[i]]; j < vOff[cVerts[i]+1]; ++j) {
+        const PetscInt d = vCells[j];
+
+        if (d < c) mark[colors[d]] = c;
+      }
+    }
+    while (mark[color] == c) ++color;
+    if (color >= IS_COLORING_MAX) SETERRQ1(PETSC_COMM_SELF, PETSC_ERR_SUP, "Closure coloring requires more than %d colors", IS_COLORING_MAX);
+    colors[c] = (ISColoringValue) color;
+    numColors = PetscMax(numColors, color+1);
+  }
+  ierr = PetscInfo2(dm, "Closure coloring of %D cells uses %D colors\n", numCells, numColors);CHKERRQ(ierr);
+  ierr = ISColoringCreate(PETSC_COMM_SELF, numColors, numCells, colors, PETSC_OWN_POINTER, coloring);CHKERRQ(ierr);
+  ierr = PetscFree(mark);CHKERRQ(ierr);
+  ierr = PetscFree(cOff);CHKERRQ(ierr);
+  ierr = PetscFree(cVerts);CHKERRQ(ierr);
+  ierr = PetscFree(vOff);CHKERRQ(ierr);
+  ierr = PetscFree(vCells);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
@@ -1972,6 +1972,8 @@ static PetscErrorCode DMPlexSwap_Static(DM dmA, DM dmB)
 PetscErrorCode DMSetFromOptions_NonRefinement_Plex(PetscOptionItems *PetscOptionsObject,DM dm)
 {
   DM_Plex       *mesh = (DM_Plex*) dm->data;
+  PetscInt       walk;
+  PetscBool      compact, flg;
   PetscErrorCode ierr;
 
   PetscFunctionBegin;
@@ -1981,11 +1983,21 @@ PetscErrorCode DMSetFromOptions_NonRefinement_Plex(PetscOptionItems *PetscOption
   ierr = PetscOptionsReal("-dm_plex_print_tol", "Tolerance for FEM output", "DMView", mesh->printTol, &mesh->printTol, NULL);CHKERRQ(ierr);
   /* Point Location */
   ierr = PetscOptionsBool("-dm_plex_hash_location", "Use grid hashing for point location", "DMView", PETSC_FALSE, &mesh->useHashLocation, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-dm_plex_bvh_location", "Use a bounding volume hierarchy over the cells for point location", "DMPlexSetUseBVHLocation", mesh->useBVHLocation, &mesh->useBVHLocation, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-dm_plex_location_walk", "Number of neighbor cells to try from the initial guess", "DMPlexSetPointLocationWalk", mesh->locationWalk, &walk, &flg);CHKERRQ(ierr);
+  if (flg) {ierr = DMPlexSetPointLocationWalk(dm, walk);CHKERRQ(ierr);}
   /* Generation and remeshing */
   ierr = PetscOptionsBool("-dm_plex_remesh_bd", "Allow changes to the boundary on remeshing", "DMView", PETSC_FALSE, &mesh->remeshBd, NULL);CHKERRQ(ierr);
   /* Projection behavior */
   ierr = PetscOptionsInt("-dm_plex_max_projection_height", "Maxmimum mesh point height used to project locally", "DMPlexSetMaxProjectionHeight", 0, &mesh->maxProjectionHeight, NULL);CHKERRQ(ierr);
   ierr = PetscOptionsBool("-dm_plex_regular_refinement", "Use special nested projection algorithm for regular refinement", "DMPlexSetRegularRefinement", mesh->regularRefinement, &mesh->regularRefinement, NULL);CHKERRQ(ierr);
+  /* Assembly */
+  ierr = PetscOptionsBool("-dm_plex_threaded_assembly", "Integrate and assemble cells in concurrent threads", "DMPlexSetThreadedAssembly", mesh->threadedAssembly, &mesh->threadedAssembly, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-dm_plex_closure_index_cache", "Gather and scatter cell closures through precomputed indices", "DMPlexSetUseClosureIndexCache", mesh->useClosureIndexCache, &mesh->useClosureIndexCache, NULL);CHKERRQ(ierr);
+  /* Storage */
+  ierr = PetscOptionsBool("-dm_plex_compact_topology", "Store the cone and support sections compactly", "DMPlexSetCompactTopology", mesh->compactTopology, &compact, &flg);CHKERRQ(ierr);
+  if (flg) {ierr = DMPlexSetCompactTopology(dm, compact);CHKERRQ(ierr);}
+  ierr = PetscOptionsEnum("-dm_plex_reorder", "Renumber the mesh points for locality after distribution", "DMPlexSetReorderType", DMPlexReorderTypes, (PetscEnum) mesh->reorderType, (PetscEnum *) &mesh->reorderType, NULL);CHKERRQ(ierr);
 
   ierr = PetscPartitionerSetFromOptions(mesh->partitioner);CHKERRQ(ierr);
   PetscFunctionReturn(0);
@@ -1994,7 +2006,7 @@ PetscErrorCode DMSetFromOptions_NonRefinement_Plex(PetscOptionItems *PetscOption
 static PetscErrorCode DMSetFromOptions_Plex(PetscOptionItems *PetscOptionsObject,DM dm)
 {
   PetscInt       refine = 0, coarsen = 0, r;
-  PetscBool      isHierarchy;
+  PetscBool      isHierarchy, implicit = PETSC_FALSE;
   PetscErrorCode ierr;
 
   PetscFunctionBegin;
@@ -2003,6 +2015,7 @@ static PetscErrorCode DMSetFromOptions_Plex(PetscOptionItems *PetscOptionsObject
   /* Handle DMPlex refinement */
   ierr = PetscOptionsInt("-dm_refine", "The number of uniform refinements", "DMCreate", refine, &refine, NULL);CHKERRQ(ierr);
   ierr = PetscOptionsInt("-dm_refine_hierarchy", "The number of uniform refinements", "DMCreate", refine, &refine, &isHierarchy);CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-dm_refine_implicit", "Build only the finest mesh of the uniform refinements", "DMPlexImplicitRefinementCreate", implicit, &implicit, NULL);CHKERRQ(ierr);
   if (refine) {ierr = DMPlexSetRefinementUniform(dm, PETSC_TRUE);CHKERRQ(ierr);}
   if (refine && isHierarchy) {
     DM *dms, coarseDM;
@@ -2030,6 +2043,18 @@ static PetscErrorCode DMSetFromOptions_Plex(PetscOptionItems *PetscOptionsObject
       ierr = DMDestroy(&dms[r]);CHKERRQ(ierr);
     }
     ierr = PetscFree(dms);CHKERRQ(ierr);
+  } else if (refine && implicit) {
+    DMPlexImplicitRefinement ir;
+    DM                       refinedMesh;
+
+    ierr = DMSetFromOptions_NonRefinement_Plex(PetscOptionsObject, dm);CHKERRQ(ierr);
+    ierr = DMPlexImplicitRefinementCreate(dm, refine, &ir);CHKERRQ(ierr);
+    ierr = DMPlexImplicitRefinementCreateDM(ir, &refinedMesh);CHKERRQ(ierr);
+    ierr = DMPlexImplicitRefinementDestroy(&ir);CHKERRQ(ierr);
+    /* Total hack since we do not pass in a pointer */
+    ierr = DMPlexReplace_Static(dm, refinedMesh);CHKERRQ(ierr);
+    ierr = DMSetFromOptions_NonRefinement_Plex(PetscOptionsObject, dm);CHKERRQ(ierr);
+    ierr = DMDestroy(&refinedMesh);CHKERRQ(ierr);
   } else {
     for (r = 0; r < refine; ++r) {
       DM refinedMesh;
@@ -2268,6 +2293,16 @@ PETSC_EXTERN PetscErrorCode DMCreate_Plex(DM dm)
   mesh->useAnchors          = PETSC_FALSE;
 
   mesh->maxProjectionHeight = 0;
+  mesh->threadedAssembly    = PETSC_FALSE;
+  mesh->useClosureIndexCache = PETSC_FALSE;
+  mesh->numThreadDS          = 0;
+  mesh->threadDS             = NULL;
+  mesh->threadDSAux          = NULL;
+  mesh->compactTopology      = PETSC_FALSE;
+  mesh->reorderType          = DMPLEX_REORDER_NONE;
+  mesh->useBVHLocation       = PETSC_FALSE;
+  mesh->locationWalk         = 0;
+  mesh->bvh                  = NULL;
 
   mesh->printSetValues = PETSC_FALSE;
   mesh->printFEM       = 0;
@@ -2771,6 +2806,415 @@ PetscErrorCode DMPlexCreateFromDAG(DM dm, PetscInt depth, const PetscInt numPoin
   PetscFunctionReturn(0);
 }
 
+/*
+  This takes as input chunks of the DAG records in a global point numbering, in any distribution over the processes, for
+  example as read from a file. The records are first moved to a directory, in which the record of point g sits on the
+  process owning g in the default layout of the global numbers. Each process then gets a contiguous chunk of the cells,
+  that is the points which are not in any cone, and pulls in their closures from the directory. Each point is owned by
+  the lowest rank holding it. The output SF has the directory slots as roots and the local points as leaves.
+
+  A record is the global point number and the cone size, followed by the cone and the cone orientations padded to the
+  maximum cone size, so that it can be sent as a single MPI datatype.
+*/
+PetscErrorCode DMPlexBuildFromDAG_Parallel_Internal(DM dm, PetscInt numPoints, const PetscInt points[], const PetscInt coneSize[], const PetscInt cones[], const PetscInt coneOrientations[], PetscSF *ownershipSF)
+{
+  MPI_Comm       comm;
+  MPI_Datatype   rectype;
+  PetscLayout    pLayout, cLayout;
+  PetscSF        sf, sfPoint;
+  PetscSFNode   *remote, *nodeLocal, *nodeOwner, *remotePoint;
+  PetscInt      *recs, *dir, *ref, *ones, *cellSlots, *lrecs, *known, *idx, *depth, *newnum, *off, *cone, *ornt, *localPoint;
+  PetscInt       N, numSlots, numCells, numCellsLocal, cOffset, numLocal, numRefs, numGhosts, maxConeSize = 0, mc, w, maxDepth = -1, D, frontStart, frontEnd, i, k, p, s;
+  PetscMPIInt    rank;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectGetComm((PetscObject) dm, &comm);CHKERRQ(ierr);
+  ierr = MPI_Comm_rank(comm, &rank);CHKERRQ(ierr);
+  for (i = 0; i < numPoints; ++i) maxConeSize = PetscMax(maxConeSize, coneSize[i]);
+  ierr = MPIU_Allreduce(&maxConeSize, &mc, 1, MPIU_INT, MPI_MAX, comm);CHKERRQ(ierr);
+  ierr = MPIU_Allreduce(&numPoints, &N, 1, MPIU_INT, MPI_SUM, comm);CHKERRQ(ierr);
+  w    = 2 + 2*mc;
+  ierr = MPI_Type_contiguous(w, MPIU_INT, &rectype);CHKERRQ(ierr);
+  ierr = MPI_Type_commit(&rectype);CHKERRQ(ierr);
+  ierr = PetscLayoutCreate(comm, &pLayout);CHKERRQ(ierr);
+  ierr = PetscLayoutSetSize(pLayout, N);CHKERRQ(ierr);
+  ierr = PetscLayoutSetBlockSize(pLayout, 1);CHKERRQ(ierr);
+  ierr = PetscLayoutSetUp(pLayout);CHKERRQ(ierr);
+  ierr = PetscLayoutGetLocalSize(pLayout, &numSlots);CHKERRQ(ierr);
+  /* Move the records into the directory */
+  ierr = PetscCalloc1(numPoints*w, &recs);CHKERRQ(ierr);
+  ierr = PetscMalloc1(numPoints, &remote);CHKERRQ(ierr);
+  for (i = 0, k = 0; i < numPoints; k += coneSize[i], ++i) {
+    PetscInt *rec = &recs[i*w], c;
+
+    rec[0] = points[i];
+    rec[1] = coneSize[i];
+    for (c = 0; c < coneSize[i]; ++c) {rec[2+c] = cones[k+c]; rec[2+mc+c] = coneOrientations[k+c];}
+    if ((points[i] < 0) || (points[i] >= N)) SETERRQ2(PETSC_COMM_SELF, PETSC_ERR_ARG_OUTOFRANGE, "Global point %D is not in [0, %D)", points[i], N);
+    ierr = PetscLayoutFindOwnerIndex(pLayout, points[i], &remote[i].rank, &remote[i].index);CHKERRQ(ierr);
+  }
+  ierr = PetscMalloc1(numSlots*w, &dir);CHKERRQ(ierr);
+  for (s = 0; s < numSlots; ++s) dir[s*w] = -1;
+  ierr = PetscSFCreate(comm, &sf);CHKERRQ(ierr);
+  ierr = PetscSFSetGraph(sf, numSlots, numPoints, NULL, PETSC_OWN_POINTER, remote, PETSC_OWN_POINTER);CHKERRQ(ierr);
+  ierr = PetscSFReduceBegin(sf, rectype, recs, dir, MPI_REPLACE);CHKERRQ(ierr);
+  ierr = PetscSFReduceEnd(sf, rectype, recs, dir, MPI_REPLACE);CHKERRQ(ierr);
+  ierr = PetscSFDestroy(&sf);CHKERRQ(ierr);
+  ierr = PetscFree(recs);CHKERRQ(ierr);
+  for (s = 0, numRefs = 0; s < numSlots; ++s) {
+    if (dir[s*w] < 0) SETERRQ1(PETSC_COMM_SELF, PETSC_ERR_ARG_WRONG, "Global point %D has no record", pLayout->rstart+s);
+    numRefs += dir[s*w+1];
+  }
+  /* Mark the points which appear in some cone, the others are cells */
+  ierr = PetscMalloc2(numRefs, &remote, numRefs, &ones);CHKERRQ(ierr);
+  ierr = PetscMalloc1(numSlots, &ref);CHKERRQ(ierr);
+  for (s = 0, k = 0; s < numSlots; ++s) {
+    PetscInt c;
+
+    for (c = 0; c < dir[s*w+1]; ++c, ++k) {
+      ones[k] = 1;
+      ierr = PetscLayoutFindOwnerIndex(pLayout, dir[s*w+2+c], &remote[k].rank, &remote[k].index);CHKERRQ(ierr);
+    }
+    ref[s] = 0;
+  }
+  ierr = PetscSFCreate(comm, &sf);CHKERRQ(ierr);
+  ierr = PetscSFSetGraph(sf, numSlots, numRefs, NULL, PETSC_USE_POINTER, remote, PETSC_USE_POINTER);CHKERRQ(ierr);
+  ierr = PetscSFReduceBegin(sf, MPIU_INT, ones, ref, MPI_MAX);CHKERRQ(ierr);
+  ierr = PetscSFReduceEnd(sf, MPIU_INT, ones, ref, MPI_MAX);CHKERRQ(ierr);
+  ierr = PetscSFDestroy(&sf);CHKERRQ(ierr);
+  ierr = PetscFree2(remote, ones);CHKERRQ(ierr);
+  /* Give each process a contiguous chunk of the cells, in the order of their global numbers */
+  for (s = 0, numCellsLocal = 0; s < numSlots; ++s) if (!ref[s]) ++numCellsLocal;
+  ierr = MPI_Scan(&numCellsLocal, &cOffset, 1, MPIU_INT, MPI_SUM, comm);CHKERRQ(ierr);
+  cOffset -= numCellsLocal;
+  ierr = MPIU_Allreduce(&numCellsLocal, &numCells, 1, MPIU_INT, MPI_SUM, comm);CHKERRQ(ierr);
+  ierr = PetscLayoutCreate(comm, &cLayout);CHKERRQ(ierr);
+  ierr = PetscLayoutSetSize(cLayout, numCells);CHKERRQ(ierr);
+  ierr = PetscLayoutSetBlockSize(cLayout, 1);CHKERRQ(ierr);
+  ierr = PetscLayoutSetUp(cLayout);CHKERRQ(ierr);
+  ierr = PetscMalloc1(numCellsLocal, &cellSlots);CHKERRQ(ierr);
+  ierr = PetscMalloc1(numCellsLocal, &remote);CHKERRQ(ierr);
+  for (s = 0, k = 0; s < numSlots; ++s) {
+    if (ref[s]) continue;
+    cellSlots[k] = s;
+    ierr = PetscLayoutFindOwnerIndex(cLayout, cOffset+k, &remote[k].rank, &remote[k].index);CHKERRQ(ierr);
+    ++k;
+  }
+  ierr = PetscFree(ref);CHKERRQ(ierr);
+  numLocal = cLayout->n;
+  ierr = PetscMalloc1(numLocal*w, &lrecs);CHKERRQ(ierr);
+  ierr = PetscSFCreate(comm, &sf);CHKERRQ(ierr);
+  ierr = PetscSFSetGraph(sf, numLocal, numCellsLocal, cellSlots, PETSC_OWN_POINTER, remote, PETSC_OWN_POINTER);CHKERRQ(ierr);
+  ierr = PetscSFReduceBegin(sf, rectype, dir, lrecs, MPI_REPLACE);CHKERRQ(ierr);
+  ierr = PetscSFReduceEnd(sf, rectype, dir, lrecs, MPI_REPLACE);CHKERRQ(ierr);
+  ierr = PetscSFDestroy(&sf);CHKERRQ(ierr);
+  ierr = PetscLayoutDestroy(&cLayout);CHKERRQ(ierr);
+  /* Pull in the closures of the local cells from the directory, one level at a time */
+  ierr = PetscMalloc1(numLocal, &known);CHKERRQ(ierr);
+  for (p = 0; p < numLocal; ++p) known[p] = lrecs[p*w];
+  ierr = PetscSortInt(numLocal, known);CHKERRQ(ierr);
+  for (frontStart = 0, frontEnd = numLocal; ; frontStart = frontEnd, frontEnd = numLocal) {
+    PetscInt *needed, *tmp, numNeeded = 0, numCandidates = 0, anyNeeded;
+
+    for (p = frontStart; p < frontEnd; ++p) numCandidates += lrecs[p*w+1];
+    ierr = PetscMalloc1(numCandidates, &needed);CHKERRQ(ierr);
+    for (p = frontStart; p < frontEnd; ++p) for (k = 0; k < lrecs[p*w+1]; ++k) needed[numNeeded++] = lrecs[p*w+2+k];
+    ierr = PetscSortRemoveDupsInt(&numNeeded, needed);CHKERRQ(ierr);
+    for (i = 0, k = 0; i < numNeeded; ++i) {
+      PetscInt loc;
+
+      ierr = PetscFindInt(needed[i], numLocal, known, &loc);CHKERRQ(ierr);
+      if (loc < 0) needed[k++] = needed[i];
+    }
+    numNeeded = k;
+    ierr = MPIU_Allreduce(&numNeeded, &anyNeeded, 1, MPIU_INT, MPI_MAX, comm);CHKERRQ(ierr);
+    if (!anyNeeded) {ierr = PetscFree(needed);CHKERRQ(ierr); break;}
+    ierr = PetscMalloc1(numNeeded, &remote);CHKERRQ(ierr);
+    for (i = 0; i < numNeeded; ++i) {ierr = PetscLayoutFindOwnerIndex(pLayout, needed[i], &remote[i].rank, &remote[i].index);CHKERRQ(ierr);}
+    ierr = PetscMalloc1((numLocal+numNeeded)*w, &tmp);CHKERRQ(ierr);
+    ierr = PetscMemcpy(tmp, lrecs, numLocal*w * sizeof(PetscInt));CHKERRQ(ierr);
+    ierr = PetscFree(lrecs);CHKERRQ(ierr);
+    lrecs = tmp;
+    ierr = PetscSFCreate(comm, &sf);CHKERRQ(ierr);
+    ierr = PetscSFSetGraph(sf, numSlots, numNeeded, NULL, PETSC_OWN_POINTER, remote, PETSC_OWN_POINTER);CHKERRQ(ierr);
+    ierr = PetscSFBcastBegin(sf, rectype, dir, &lrecs[numLocal*w]);CHKERRQ(ierr);
+    ierr = PetscSFBcastEnd(sf, rectype, dir, &lrecs[numLocal*w]);CHKERRQ(ierr);
+    ierr = PetscSFDestroy(&sf);CHKERRQ(ierr);
+    ierr = PetscMalloc1(numLocal+numNeeded, &tmp);CHKERRQ(ierr);
+    ierr = PetscMemcpy(tmp, known, numLocal * sizeof(PetscInt));CHKERRQ(ierr);
+    ierr = PetscMemcpy(&tmp[numLocal], needed, numNeeded * sizeof(PetscInt));CHKERRQ(ierr);
+    ierr = PetscFree(known);CHKERRQ(ierr);
+    ierr = PetscFree(needed);CHKERRQ(ierr);
+    known     = tmp;
+    numLocal += numNeeded;
+    ierr = PetscSortInt(numLocal, known);CHKERRQ(ierr);
+  }
+  ierr = PetscFree(dir);CHKERRQ(ierr);
+  ierr = MPI_Type_free(&rectype);CHKERRQ(ierr);
+  /* Compute the depth of each local point, now that the local closures are complete */
+  ierr = PetscMalloc3(numLocal, &idx, numLocal, &depth, numLocal, &newnum);CHKERRQ(ierr);
+  for (p = 0; p < numLocal; ++p) {known[p] = lrecs[p*w]; idx[p] = p; depth[p] = -1;}
+  ierr = PetscSortIntWithArray(numLocal, known, idx);CHKERRQ(ierr);
+  for (k = 0; k <= numLocal; ++k) {
+    PetscBool done = PETSC_TRUE;
+
+    for (p = 0; p < numLocal; ++p) {
+      PetscInt dmax = -1, c;
+
+      if (depth[p] >= 0) continue;
+      for (c = 0; c < lrecs[p*w+1]; ++c) {
+        PetscInt q;
+
+        ierr = PetscFindInt(lrecs[p*w+2+c], numLocal, known, &q);CHKERRQ(ierr);
+        if (q < 0) SETERRQ2(PETSC_COMM_SELF, PETSC_ERR_PLIB, "Cone point %D of global point %D is not local", lrecs[p*w+2+c], lrecs[p*w]);
+        if (depth[idx[q]] < 0) break;
+        dmax = PetscMax(dmax, depth[idx[q]]);
+      }
+      if (c < lrecs[p*w+1]) done = PETSC_FALSE;
+      else {depth[p] = dmax+1; maxDepth = PetscMax(maxDepth, depth[p]);}
+    }
+    if (done) break;
+  }
+  if (k > numLocal) SETERRQ(PETSC_COMM_SELF, PETSC_ERR_ARG_WRONG, "The cones do not form a DAG");
+  ierr = MPIU_Allreduce(&maxDepth, &D, 1, MPIU_INT, MPI_MAX, comm);CHKERRQ(ierr);
+  /* Number the local points by stratum in the usual order, cells, vertices, then decreasing depth */
+  ierr = PetscCalloc1(D+2, &off);CHKERRQ(ierr);
+  for (p = 0; p < numLocal; ++p) {
+    const PetscInt d = depth[p], sr = d == D ? 0 : (!d ? 1 : D-d+1);
+
+    ++off[sr+1];
+  }
+  for (s = 0; s <= D; ++s) off[s+1] += off[s];
+  for (i = 0; i < numLocal; ++i) {
+    const PetscInt d = depth[idx[i]], sr = d == D ? 0 : (!d ? 1 : D-d+1);
+
+    newnum[idx[i]] = off[sr]++;
+  }
+  ierr = PetscFree(off);CHKERRQ(ierr);
+  /* Create cones */
+  ierr = DMPlexSetChart(dm, 0, numLocal);CHKERRQ(ierr);
+  for (p = 0; p < numLocal; ++p) {ierr = DMPlexSetConeSize(dm, newnum[p], lrecs[p*w+1]);CHKERRQ(ierr);}
+  ierr = DMSetUp(dm);CHKERRQ(ierr);
+  ierr = DMGetWorkArray(dm, mc, MPIU_INT, &cone);CHKERRQ(ierr);
+  ierr = DMGetWorkArray(dm, mc, MPIU_INT, &ornt);CHKERRQ(ierr);
+  for (p = 0; p < numLocal; ++p) {
+    PetscInt c, q;
+
+    for (c = 0; c < lrecs[p*w+1]; ++c) {
+      ierr = PetscFindInt(lrecs[p*w+2+c], numLocal, known, &q);CHKERRQ(ierr);
+      cone[c] = newnum[idx[q]];
+      ornt[c] = lrecs[p*w+2+mc+c];
+    }
+    ierr = DMPlexSetCone(dm, newnum[p], cone);CHKERRQ(ierr);
+    ierr = DMPlexSetConeOrientation(dm, newnum[p], ornt);CHKERRQ(ierr);
+  }
+  ierr = DMRestoreWorkArray(dm, mc, MPIU_INT, &cone);CHKERRQ(ierr);
+  ierr = DMRestoreWorkArray(dm, mc, MPIU_INT, &ornt);CHKERRQ(ierr);
+  /* Create the ownership SF from the directory slots to the local points */
+  ierr = PetscMalloc1(numLocal, &remote);CHKERRQ(ierr);
+  for (p = 0; p < numLocal; ++p) {ierr = PetscLayoutFindOwnerIndex(pLayout, lrecs[p*w], &remote[newnum[p]].rank, &remote[newnum[p]].index);CHKERRQ(ierr);}
+  ierr = PetscFree(lrecs);CHKERRQ(ierr);
+  ierr = PetscFree(known);CHKERRQ(ierr);
+  ierr = PetscFree3(idx, depth, newnum);CHKERRQ(ierr);
+  ierr = PetscSFCreate(comm, &sf);CHKERRQ(ierr);
+  ierr = PetscObjectSetName((PetscObject) sf, "Point Ownership SF");CHKERRQ(ierr);
+  ierr = PetscSFSetGraph(sf, numSlots, numLocal, NULL, PETSC_OWN_POINTER, remote, PETSC_OWN_POINTER);CHKERRQ(ierr);
+  ierr = PetscLayoutDestroy(&pLayout);CHKERRQ(ierr);
+  /* Build pointSF, where the lowest rank holding a point owns it */
+  ierr = PetscMalloc2(numLocal, &nodeLocal, numSlots, &nodeOwner);CHKERRQ(ierr);
+  for (p = 0; p < numLocal; ++p) {nodeLocal[p].rank = rank; nodeLocal[p].index = p;}
+  for (s = 0; s < numSlots; ++s) {nodeOwner[s].rank = PETSC_MAX_INT; nodeOwner[s].index = -1;}
+  ierr = PetscSFReduceBegin(sf, MPIU_2INT, nodeLocal, nodeOwner, MPI_MINLOC);CHKERRQ(ierr);
+  ierr = PetscSFReduceEnd(sf, MPIU_2INT, nodeLocal, nodeOwner, MPI_MINLOC);CHKERRQ(ierr);
+  ierr = PetscSFBcastBegin(sf, MPIU_2INT, nodeOwner, nodeLocal);CHKERRQ(ierr);
+  ierr = PetscSFBcastEnd(sf, MPIU_2INT, nodeOwner, nodeLocal);CHKERRQ(ierr);
+  for (p = 0, numGhosts = 0; p < numLocal; ++p) if (nodeLocal[p].rank != rank) ++numGhosts;
+  ierr = PetscMalloc1(numGhosts, &localPoint);CHKERRQ(ierr);
+  ierr = PetscMalloc1(numGhosts, &remotePoint);CHKERRQ(ierr);
+  for (p = 0, k = 0; p < numLocal; ++p) {
+    if (nodeLocal[p].rank != rank) {
+      localPoint[k]        = p;
+      remotePoint[k].rank  = nodeLocal[p].rank;
+      remotePoint[k].index = nodeLocal[p].index;
+      ++k;
+    }
+  }
+  ierr = PetscFree2(nodeLocal, nodeOwner);CHKERRQ(ierr);
+  ierr = DMGetPointSF(dm, &sfPoint);CHKERRQ(ierr);
+  ierr = PetscObjectSetName((PetscObject) sfPoint, "point SF");CHKERRQ(ierr);
+  ierr = PetscSFSetGraph(sfPoint, numLocal, numGhosts, localPoint, PETSC_OWN_POINTER, remotePoint, PETSC_OWN_POINTER);CHKERRQ(ierr);
+  /* Fill in the rest of the topology structure */
+  ierr = DMPlexSymmetrize(dm);CHKERRQ(ierr);
+  ierr = DMPlexStratify(dm);CHKERRQ(ierr);
+  if (ownershipSF) *ownershipSF = sf;
+  else {ierr = PetscSFDestroy(&sf);CHKERRQ(ierr);}
+  PetscFunctionReturn(0);
+}
+
+/*
+  This takes as input the coordinates of a chunk of the vertices, where the vertices are numbered in the order of their global point numbers
+*/
+PetscErrorCode DMPlexBuildCoordinates_DAG_Parallel_Internal(DM dm, PetscSF ownershipSF, PetscInt numVertices, const PetscScalar vertexCoords[])
+{
+  MPI_Comm       comm;
+  MPI_Datatype   coordtype;
+  PetscLayout    vLayout;
+  PetscSection   coordSection;
+  PetscSF        sfVert;
+  PetscSFNode   *remote;
+  Vec            coordinates;
+  PetscScalar   *coords;
+  PetscInt      *leafVertex, *slotVertex, numSlots, numLocal, numVerticesLocal = 0, numVerticesGlobal, vOffset, N, vStart, vEnd, dimEmbed, coordSize, p, s, v;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectGetComm((PetscObject) dm, &comm);CHKERRQ(ierr);
+  ierr = DMGetCoordinateDim(dm, &dimEmbed);CHKERRQ(ierr);
+  ierr = DMPlexGetDepthStratum(dm, 0, &vStart, &vEnd);CHKERRQ(ierr);
+  /* Number the vertices in the order of their global point numbers */
+  ierr = PetscSFGetGraph(ownershipSF, &numSlots, &numLocal, NULL, NULL);CHKERRQ(ierr);
+  ierr = PetscMalloc2(numLocal, &leafVertex, numSlots, &slotVertex);CHKERRQ(ierr);
+  for (p = 0; p < numLocal; ++p) leafVertex[p] = (p >= vStart) && (p < vEnd) ? 1 : 0;
+  for (s = 0; s < numSlots; ++s) slotVertex[s] = 0;
+  ierr = PetscSFReduceBegin(ownershipSF, MPIU_INT, leafVertex, slotVertex, MPI_MAX);CHKERRQ(ierr);
+  ierr = PetscSFReduceEnd(ownershipSF, MPIU_INT, leafVertex, slotVertex, MPI_MAX);CHKERRQ(ierr);
+  for (s = 0; s < numSlots; ++s) if (slotVertex[s]) ++numVerticesLocal;
+  ierr = MPI_Scan(&numVerticesLocal, &vOffset, 1, MPIU_INT, MPI_SUM, comm);CHKERRQ(ierr);
+  vOffset -= numVerticesLocal;
+  ierr = MPIU_Allreduce(&numVerticesLocal, &numVerticesGlobal, 1, MPIU_INT, MPI_SUM, comm);CHKERRQ(ierr);
+  for (s = 0; s < numSlots; ++s) slotVertex[s] = slotVertex[s] ? vOffset++ : -1;
+  ierr = PetscSFBcastBegin(ownershipSF, MPIU_INT, slotVertex, leafVertex);CHKERRQ(ierr);
+  ierr = PetscSFBcastEnd(ownershipSF, MPIU_INT, slotVertex, leafVertex);CHKERRQ(ierr);
+  /* Map the local vertices to the chunks of coordinates */
+  ierr = PetscLayoutCreate(comm, &vLayout);CHKERRQ(ierr);
+  ierr = PetscLayoutSetLocalSize(vLayout, numVertices);CHKERRQ(ierr);
+  ierr = PetscLayoutSetBlockSize(vLayout, 1);CHKERRQ(ierr);
+  ierr = PetscLayoutSetUp(vLayout);CHKERRQ(ierr);
+  ierr = PetscLayoutGetSize(vLayout, &N);CHKERRQ(ierr);
+  if (N != numVerticesGlobal) SETERRQ2(comm, PETSC_ERR_ARG_SIZ, "Number of vertex coordinates %D != %D number of vertices", N, numVerticesGlobal);
+  ierr = PetscMalloc1(vEnd-vStart, &remote);CHKERRQ(ierr);
+  for (v = vStart; v < vEnd; ++v) {ierr = PetscLayoutFindOwnerIndex(vLayout, leafVertex[v], &remote[v-vStart].rank, &remote[v-vStart].index);CHKERRQ(ierr);}
+  ierr = PetscFree2(leafVertex, slotVertex);CHKERRQ(ierr);
+  ierr = PetscLayoutDestroy(&vLayout);CHKERRQ(ierr);
+  ierr = PetscSFCreate(comm, &sfVert);CHKERRQ(ierr);
+  ierr = PetscSFSetGraph(sfVert, numVertices, vEnd-vStart, NULL, PETSC_OWN_POINTER, remote, PETSC_OWN_POINTER);CHKERRQ(ierr);
+  /* Build coordinates */
+  ierr = DMGetCoordinateSection(dm, &coordSection);CHKERRQ(ierr);
+  ierr = PetscSectionSetNumFields(coordSection, 1);CHKERRQ(ierr);
+  ierr = PetscSectionSetFieldComponents(coordSection, 0, dimEmbed);CHKERRQ(ierr);
+  ierr = PetscSectionSetChart(coordSection, vStart, vEnd);CHKERRQ(ierr);
+  for (v = vStart; v < vEnd; ++v) {
+    ierr = PetscSectionSetDof(coordSection, v, dimEmbed);CHKERRQ(ierr);
+    ierr = PetscSectionSetFieldDof(coordSection, v, 0, dimEmbed);CHKERRQ(ierr);
+  }
+  ierr = PetscSectionSetUp(coordSection);CHKERRQ(ierr);
+  ierr = PetscSectionGetStorageSize(coordSection, &coordSize);CHKERRQ(ierr);
+  ierr = VecCreate(PETSC_COMM_SELF, &coordinates);CHKERRQ(ierr);
+  ierr = PetscObjectSetName((PetscObject) coordinates, "coordinates");CHKERRQ(ierr);
+  ierr = VecSetSizes(coordinates, coordSize, PETSC_DETERMINE);CHKERRQ(ierr);
+  ierr = VecSetBlockSize(coordinates, dimEmbed);CHKERRQ(ierr);
+  ierr = VecSetType(coordinates, VECSTANDARD);CHKERRQ(ierr);
+  ierr = VecGetArray(coordinates, &coords);CHKERRQ(ierr);
+  ierr = MPI_Type_contiguous(dimEmbed, MPIU_SCALAR, &coordtype);CHKERRQ(ierr);
+  ierr = MPI_Type_commit(&coordtype);CHKERRQ(ierr);
+  ierr = PetscSFBcastBegin(sfVert, coordtype, vertexCoords, coords);CHKERRQ(ierr);
+  ierr = PetscSFBcastEnd(sfVert, coordtype, vertexCoords, coords);CHKERRQ(ierr);
+  ierr = MPI_Type_free(&coordtype);CHKERRQ(ierr);
+  ierr = VecRestoreArray(coordinates, &coords);CHKERRQ(ierr);
+  ierr = DMSetCoordinatesLocal(dm, coordinates);CHKERRQ(ierr);
+  ierr = VecDestroy(&coordinates);CHKERRQ(ierr);
+  ierr = PetscSFDestroy(&sfVert);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+  This sets the value on the local copies of a chunk of global points, numbered as in DMPlexBuildFromDAG_Parallel_Internal()
+*/
+PetscErrorCode DMPlexSetLabelValues_DAG_Parallel_Internal(DM dm, PetscSF ownershipSF, DMLabel label, PetscInt value, PetscInt numPoints, const PetscInt points[])
+{
+  MPI_Comm       comm;
+  PetscLayout    pLayout;
+  PetscSF        sf;
+  PetscSFNode   *remote;
+  PetscInt      *ones, *slotMark, *leafMark, numSlots, numLocal, i, p, s;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectGetComm((PetscObject) dm, &comm);CHKERRQ(ierr);
+  ierr = PetscSFGetGraph(ownershipSF, &numSlots, &numLocal, NULL, NULL);CHKERRQ(ierr);
+  ierr = PetscLayoutCreate(comm, &pLayout);CHKERRQ(ierr);
+  ierr = PetscLayoutSetLocalSize(pLayout, numSlots);CHKERRQ(ierr);
+  ierr = PetscLayoutSetBlockSize(pLayout, 1);CHKERRQ(ierr);
+  ierr = PetscLayoutSetUp(pLayout);CHKERRQ(ierr);
+  ierr = PetscMalloc1(numPoints, &remote);CHKERRQ(ierr);
+  ierr = PetscMalloc3(numPoints, &ones, numSlots, &slotMark, numLocal, &leafMark);CHKERRQ(ierr);
+  for (i = 0; i < numPoints; ++i) {
+    ones[i] = 1;
+    ierr = PetscLayoutFindOwnerIndex(pLayout, points[i], &remote[i].rank, &remote[i].index);CHKERRQ(ierr);
+  }
+  for (s = 0; s < numSlots; ++s) slotMark[s] = 0;
+  ierr = PetscSFCreate(comm, &sf);CHKERRQ(ierr);
+  ierr = PetscSFSetGraph(sf, numSlots, numPoints, NULL, PETSC_OWN_POINTER, remote, PETSC_OWN_POINTER);CHKERRQ(ierr);
+  ierr = PetscSFReduceBegin(sf, MPIU_INT, ones, slotMark, MPI_MAX);CHKERRQ(ierr);
+  ierr = PetscSFReduceEnd(sf, MPIU_INT, ones, slotMark, MPI_MAX);CHKERRQ(ierr);
+  ierr = PetscSFDestroy(&sf);CHKERRQ(ierr);
+  ierr = PetscSFBcastBegin(ownershipSF, MPIU_INT, slotMark, leafMark);CHKERRQ(ierr);
+  ierr = PetscSFBcastEnd(ownershipSF, MPIU_INT, slotMark, leafMark);CHKERRQ(ierr);
+  for (p = 0; p < numLocal; ++p) if (leafMark[p]) {ierr = DMLabelSetValue(label, p, value);CHKERRQ(ierr);}
+  ierr = PetscFree3(ones, slotMark, leafMark);CHKERRQ(ierr);
+  ierr = PetscLayoutDestroy(&pLayout);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@
+  DMPlexCreateFromDAGParallel - This takes as input chunks of the Directed Acyclic Graph (Hasse Diagram) encoding a mesh, given in a global point numbering and distributed in any way over the processes, and produces a distributed DM
+
+  Collective on dm
+
+  Input Parameters:
++ dm - The empty DM object, usually from DMCreate() and DMSetDimension()
+. numPoints - The number of points given on this process
+. points - The global number of each point given on this process
+. coneSize - The cone size of each point
+. cones - The concatenation of the cone points for each point, as global point numbers
+. coneOrientations - The orientation of each cone point
+. numVertices - The number of vertex coordinates given on this process
+- vertexCoords - An array of numVertices*dimEmbed numbers, a contiguous chunk of the vertex coordinates, where vertices are ordered by global point number
+
+  Output Parameters:
++ dm - The DM
+- ownershipSF - Optional, SF from the global point numbers, in the default layout over the processes, to the local points
+
+  Notes:
+  The global numbering must be contiguous, from 0 to the total number of points, and each point must be given on exactly one process. Each process
+  gets a contiguous chunk of the cells, in the order of their global numbers, together with their closures. The points shared by processes are
+  owned by the lowest rank. Since no process handles more than a chunk of the mesh, this is suitable for loading large meshes in parallel, for
+  example from the topology stored by DMView() with an HDF5 viewer. The result is a naive partition, which should then be improved with
+  DMPlexDistribute().
+
+  Level: advanced
+
+.seealso: DMPlexCreateFromDAG(), DMPlexCreateFromCellListParallel(), DMPlexDistribute()
+@*/
+PetscErrorCode DMPlexCreateFromDAGParallel(DM dm, PetscInt numPoints, const PetscInt points[], const PetscInt coneSize[], const PetscInt cones[], const PetscInt coneOrientations[], PetscInt numVertices, const PetscScalar vertexCoords[], PetscSF *ownershipSF)
+{
+  PetscSF        sf;
+  PetscInt       dim, dimEmbed;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(dm, DM_CLASSID, 1);
+  ierr = DMGetDimension(dm, &dim);CHKERRQ(ierr);
+  ierr = DMGetCoordinateDim(dm, &dimEmbed);CHKERRQ(ierr);
+  if (dimEmbed < dim) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_PLIB,"Embedding dimension %d cannot be less than intrinsic dimension %d",dimEmbed,dim);
+  ierr = DMPlexBuildFromDAG_Parallel_Internal(dm, numPoints, points, coneSize, cones, coneOrientations, &sf);CHKERRQ(ierr);
+  ierr = DMPlexBuildCoordinates_DAG_Parallel_Internal(dm, sf, numVertices, vertexCoords);CHKERRQ(ierr);
+  if (ownershipSF) *ownershipSF = sf;
+  else {ierr = PetscSFDestroy(&sf);CHKERRQ(ierr);}
+  PetscFunctionReturn(0);
+}
+
 /*@C
   DMPlexCreateCellVertexFromFile - Create a DMPlex mesh from a simple cell-vertex file.
 
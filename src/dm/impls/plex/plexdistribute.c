@@ -1605,6 +1605,40 @@ PetscErrorCode DMPlexMigrate(DM dm, PetscSF sf, DM targetDM)
   PetscFunctionReturn(0);
 }
 
+/* Replaces the distributed mesh by its reordering, and renumbers the leaves of the migration SF to match */
+static PetscErrorCode DMPlexDistributeReorder_Static(DMPlexReorderType rtype, PetscSF *sfMigration, DM *dmParallel)
+{
+  DM_Plex       *mesh = (DM_Plex *) (*dmParallel)->data;
+  DM             rdm;
+  IS             perm;
+  PetscSF        sfNew;
+  PetscBool      unsupported = PETSC_FALSE, any;
+  PetscInt       d;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  for (d = 0; d < 8; ++d) if (mesh->hybridPointMax[d] >= 0) unsupported = PETSC_TRUE;
+  if (mesh->parentSection) unsupported = PETSC_TRUE;
+  ierr = MPIU_Allreduce(&unsupported, &any, 1, MPIU_BOOL, MPI_LOR, PetscObjectComm((PetscObject) *dmParallel));CHKERRQ(ierr);
+  if (any) {
+    ierr = PetscInfo(*dmParallel, "Not reordering a mesh with hybrid points or a reference tree\n");CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  ierr = DMPlexGetReordering(*dmParallel, rtype, &perm);CHKERRQ(ierr);
+  ierr = DMPlexPermute(*dmParallel, perm, &rdm);CHKERRQ(ierr);
+  ierr = PetscObjectSetName((PetscObject) rdm, "Parallel Mesh");CHKERRQ(ierr);
+  ((DM_Plex *) rdm->data)->compactTopology = mesh->compactTopology;
+  ((DM_Plex *) rdm->data)->reorderType     = mesh->reorderType;
+  if (mesh->compactTopology) {ierr = DMPlexSetCompactTopology(rdm, PETSC_TRUE);CHKERRQ(ierr);}
+  ierr = DMPlexPermuteSF_Internal(*sfMigration, perm, PETSC_FALSE, &sfNew);CHKERRQ(ierr);
+  ierr = ISDestroy(&perm);CHKERRQ(ierr);
+  ierr = PetscSFDestroy(sfMigration);CHKERRQ(ierr);
+  *sfMigration = sfNew;
+  ierr = DMDestroy(dmParallel);CHKERRQ(ierr);
+  *dmParallel = rdm;
+  PetscFunctionReturn(0);
+}
+
 /*@C
   DMPlexDistribute - Distributes the mesh and any associated sections.
 
@@ -1618,6 +1652,9 @@ PetscErrorCode DMPlexMigrate(DM dm, PetscSF sf, DM targetDM)
 + sf - The PetscSF used for point distribution
 - parallelMesh - The distributed DMPlex object, or NULL
 
+  Options Database:
+. -dm_plex_reorder <none,rcm,hilbert,morton> - Renumber the distributed mesh for locality, see DMPlexSetReorderType()
+
   Note: If the mesh was not distributed, the return value is NULL.
 
   The user can control the definition of adjacency for the mesh using DMPlexSetAdjacencyUseCone() and
@@ -1627,7 +1664,7 @@ PetscErrorCode DMPlexMigrate(DM dm, PetscSF sf, DM targetDM)
   Level: intermediate
 
 .keywords: mesh, elements
-.seealso: DMPlexCreate(), DMPlexDistributeByFace(), DMPlexSetAdjacencyUseCone(), DMPlexSetAdjacencyUseClosure()
+.seealso: DMPlexCreate(), DMPlexDistributeByFace(), DMPlexSetAdjacencyUseCone(), DMPlexSetAdjacencyUseClosure(), DMPlexSetReorderType()
 @*/
 PetscErrorCode DMPlexDistribute(DM dm, PetscInt overlap, PetscSF *sf, DM *dmParallel)
 {
@@ -1638,6 +1675,7 @@ PetscErrorCode DMPlexDistribute(DM dm, PetscInt overlap, PetscSF *sf, DM *dmPara
   DM                     dmCoord;
   DMLabel                lblPartition, lblMigration;
   PetscSF                sfProcess, sfMigration, sfStratified, sfPoint;
+  DMPlexReorderType      reorder;
   PetscBool              flg;
   PetscMPIInt            rank, size, p;
   PetscErrorCode         ierr;
@@ -1706,6 +1744,7 @@ PetscErrorCode DMPlexDistribute(DM dm, PetscInt overlap, PetscSF *sf, DM *dmPara
   /* Create non-overlapping parallel DM and migrate internal data */
   ierr = DMPlexCreate(comm, dmParallel);CHKERRQ(ierr);
   ierr = PetscObjectSetName((PetscObject) *dmParallel, "Parallel Mesh");CHKERRQ(ierr);
+  ((DM_Plex *) (*dmParallel)->data)->compactTopology = ((DM_Plex *) dm->data)->compactTopology;
   ierr = DMPlexMigrate(dm, sfMigration, *dmParallel);CHKERRQ(ierr);
 
   /* Build the point SF without overlap */
@@ -1742,6 +1781,11 @@ PetscErrorCode DMPlexDistribute(DM dm, PetscInt overlap, PetscSF *sf, DM *dmPara
     ierr = PetscSFDestroy(&sfMigration);CHKERRQ(ierr);
     sfMigration = sfOverlapPoint;
   }
+  /* Renumber the points for locality */
+  reorder = ((DM_Plex *) dm->data)->reorderType;
+  ierr = PetscOptionsGetEnum(((PetscObject) dm)->options, ((PetscObject) dm)->prefix, "-dm_plex_reorder", DMPlexReorderTypes, (PetscEnum *) &reorder, NULL);CHKERRQ(ierr);
+  ((DM_Plex *) (*dmParallel)->data)->reorderType = reorder;
+  if (reorder != DMPLEX_REORDER_NONE) {ierr = DMPlexDistributeReorder_Static(reorder, &sfMigration, dmParallel);CHKERRQ(ierr);}
   /* Cleanup Partition */
   ierr = PetscSFDestroy(&sfProcess);CHKERRQ(ierr);
   ierr = DMLabelDestroy(&lblPartition);CHKERRQ(ierr);
@@ -1837,6 +1881,7 @@ PetscErrorCode DMPlexDistributeOverlap(DM dm, PetscInt overlap, PetscSF *sf, DM
   /* Build the overlapping DM */
   ierr = DMPlexCreate(comm, dmOverlap);CHKERRQ(ierr);
   ierr = PetscObjectSetName((PetscObject) *dmOverlap, "Parallel Mesh");CHKERRQ(ierr);
+  ((DM_Plex *) (*dmOverlap)->data)->compactTopology = ((DM_Plex *) dm->data)->compactTopology;
   ierr = DMPlexMigrate(dm, sfOverlap, *dmOverlap);CHKERRQ(ierr);
   /* Build the new point SF */
   ierr = DMPlexCreatePointSF(*dmOverlap, sfOverlap, PETSC_FALSE, &sfPoint);CHKERRQ(ierr);
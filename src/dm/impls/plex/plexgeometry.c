@@ -37,120 +37,106 @@ static PetscErrorCode DMPlexGetLineIntersection_2D_Internal(const PetscReal segm
   PetscFunctionReturn(0);
 }
 
-static PetscErrorCode DMPlexLocatePoint_Simplex_2D_Internal(DM dm, const PetscScalar point[], PetscInt c, PetscInt *cell)
+/*
+  The point in cell tests work on the vertex coordinates of the cell, as returned by DMPlexVecGetClosure() on the
+  coordinates, and call no PETSc routines so that the bounding volume hierarchy can run them concurrently. The
+  simplex tests use the affine maps of DMPlexComputeTriangleGeometry_Internal() and
+  DMPlexComputeTetrahedronGeometry_Internal(), so that reference coordinates lie in [0, 2].
+*/
+PETSC_STATIC_INLINE PetscBool DMPlexLocatePoint_Supported_Private(PetscInt dim, PetscInt nv)
 {
-  const PetscInt  embedDim = 2;
-  const PetscReal eps      = PETSC_SQRT_MACHINE_EPSILON;
-  PetscReal       x        = PetscRealPart(point[0]);
-  PetscReal       y        = PetscRealPart(point[1]);
-  PetscReal       v0[2], J[4], invJ[4], detJ;
-  PetscReal       xi, eta;
-  PetscErrorCode  ierr;
-
-  PetscFunctionBegin;
-  ierr = DMPlexComputeCellGeometryFEM(dm, c, NULL, v0, J, invJ, &detJ);CHKERRQ(ierr);
-  xi  = invJ[0*embedDim+0]*(x - v0[0]) + invJ[0*embedDim+1]*(y - v0[1]);
-  eta = invJ[1*embedDim+0]*(x - v0[0]) + invJ[1*embedDim+1]*(y - v0[1]);
+  switch (dim*10 + nv) {
+  case 12: case 23: case 24: case 34: case 38: return PETSC_TRUE;
+  default: return PETSC_FALSE;
+  }
+}
 
-  if ((xi >= -eps) && (eta >= -eps) && (xi + eta <= 2.0+eps)) *cell = c;
-  else *cell = DMLOCATEPOINT_POINT_NOT_FOUND;
-  PetscFunctionReturn(0);
+static PetscBool DMPlexLocatePoint_Segment_1D_Private(const PetscReal v[], const PetscReal x[])
+{
+  return (x[0] >= PetscMin(v[0], v[1])) && (x[0] <= PetscMax(v[0], v[1])) ? PETSC_TRUE : PETSC_FALSE;
 }
 
-static PetscErrorCode DMPlexClosestPoint_Simplex_2D_Internal(DM dm, const PetscScalar point[], PetscInt c, PetscReal cpoint[])
+static PetscBool DMPlexLocatePoint_Simplex_2D_Private(const PetscReal v[], const PetscReal x[])
 {
   const PetscInt  embedDim = 2;
-  PetscReal       x        = PetscRealPart(point[0]);
-  PetscReal       y        = PetscRealPart(point[1]);
-  PetscReal       v0[2], J[4], invJ[4], detJ;
-  PetscReal       xi, eta, r;
-  PetscErrorCode  ierr;
-
-  PetscFunctionBegin;
-  ierr = DMPlexComputeCellGeometryFEM(dm, c, NULL, v0, J, invJ, &detJ);CHKERRQ(ierr);
-  xi  = invJ[0*embedDim+0]*(x - v0[0]) + invJ[0*embedDim+1]*(y - v0[1]);
-  eta = invJ[1*embedDim+0]*(x - v0[0]) + invJ[1*embedDim+1]*(y - v0[1]);
+  const PetscReal eps      = PETSC_SQRT_MACHINE_EPSILON;
+  PetscReal       J[4], invJ[4], detJ, invDet;
+  PetscReal       xi, eta;
+  PetscInt        d, f;
 
-  xi  = PetscMax(xi,  0.0);
-  eta = PetscMax(eta, 0.0);
-  if (xi + eta > 2.0) {
-    r    = (xi + eta)/2.0;
-    xi  /= r;
-    eta /= r;
+  for (d = 0; d < embedDim; ++d) {
+    for (f = 0; f < embedDim; ++f) J[d*embedDim+f] = 0.5*(v[(f+1)*embedDim+d] - v[0*embedDim+d]);
   }
-  cpoint[0] = J[0*embedDim+0]*xi + J[0*embedDim+1]*eta + v0[0];
-  cpoint[1] = J[1*embedDim+0]*xi + J[1*embedDim+1]*eta + v0[1];
-  PetscFunctionReturn(0);
+  detJ    = J[0]*J[3] - J[1]*J[2];
+  invDet  = 1.0/detJ;
+  invJ[0] =  invDet*J[3];
+  invJ[1] = -invDet*J[1];
+  invJ[2] = -invDet*J[2];
+  invJ[3] =  invDet*J[0];
+  xi  = invJ[0*embedDim+0]*(x[0] - v[0]) + invJ[0*embedDim+1]*(x[1] - v[1]);
+  eta = invJ[1*embedDim+0]*(x[0] - v[0]) + invJ[1*embedDim+1]*(x[1] - v[1]);
+
+  return (xi >= -eps) && (eta >= -eps) && (xi + eta <= 2.0+eps) ? PETSC_TRUE : PETSC_FALSE;
 }
 
-static PetscErrorCode DMPlexLocatePoint_General_2D_Internal(DM dm, const PetscScalar point[], PetscInt c, PetscInt *cell)
+static PetscBool DMPlexLocatePoint_General_2D_Private(const PetscReal v[], const PetscReal x[])
 {
-  PetscSection       coordSection;
-  Vec             coordsLocal;
-  PetscScalar    *coords = NULL;
-  const PetscInt  faces[8]  = {0, 1, 1, 2, 2, 3, 3, 0};
-  PetscReal       x         = PetscRealPart(point[0]);
-  PetscReal       y         = PetscRealPart(point[1]);
-  PetscInt        crossings = 0, f;
-  PetscErrorCode  ierr;
+  const PetscInt faces[8]  = {0, 1, 1, 2, 2, 3, 3, 0};
+  PetscInt       crossings = 0, f;
 
-  PetscFunctionBegin;
-  ierr = DMGetCoordinatesLocal(dm, &coordsLocal);CHKERRQ(ierr);
-  ierr = DMGetCoordinateSection(dm, &coordSection);CHKERRQ(ierr);
-  ierr = DMPlexVecGetClosure(dm, coordSection, coordsLocal, c, NULL, &coords);CHKERRQ(ierr);
   for (f = 0; f < 4; ++f) {
-    PetscReal x_i   = PetscRealPart(coords[faces[2*f+0]*2+0]);
-    PetscReal y_i   = PetscRealPart(coords[faces[2*f+0]*2+1]);
-    PetscReal x_j   = PetscRealPart(coords[faces[2*f+1]*2+0]);
-    PetscReal y_j   = PetscRealPart(coords[faces[2*f+1]*2+1]);
+    PetscReal x_i   = v[faces[2*f+0]*2+0];
+    PetscReal y_i   = v[faces[2*f+0]*2+1];
+    PetscReal x_j   = v[faces[2*f+1]*2+0];
+    PetscReal y_j   = v[faces[2*f+1]*2+1];
     PetscReal slope = (y_j - y_i) / (x_j - x_i);
-    PetscBool cond1 = (x_i <= x) && (x < x_j) ? PETSC_TRUE : PETSC_FALSE;
-    PetscBool cond2 = (x_j <= x) && (x < x_i) ? PETSC_TRUE : PETSC_FALSE;
-    PetscBool above = (y < slope * (x - x_i) + y_i) ? PETSC_TRUE : PETSC_FALSE;
+    PetscBool cond1 = (x_i <= x[0]) && (x[0] < x_j) ? PETSC_TRUE : PETSC_FALSE;
+    PetscBool cond2 = (x_j <= x[0]) && (x[0] < x_i) ? PETSC_TRUE : PETSC_FALSE;
+    PetscBool above = (x[1] < slope * (x[0] - x_i) + y_i) ? PETSC_TRUE : PETSC_FALSE;
     if ((cond1 || cond2)  && above) ++crossings;
   }
-  if (crossings % 2) *cell = c;
-  else *cell = DMLOCATEPOINT_POINT_NOT_FOUND;
-  ierr = DMPlexVecRestoreClosure(dm, coordSection, coordsLocal, c, NULL, &coords);CHKERRQ(ierr);
-  PetscFunctionReturn(0);
+  return crossings % 2 ? PETSC_TRUE : PETSC_FALSE;
 }
 
-static PetscErrorCode DMPlexLocatePoint_Simplex_3D_Internal(DM dm, const PetscScalar point[], PetscInt c, PetscInt *cell)
+static PetscBool DMPlexLocatePoint_Simplex_3D_Private(const PetscReal v[], const PetscReal x[])
 {
   const PetscInt embedDim = 3;
-  PetscReal      v0[3], J[9], invJ[9], detJ;
-  PetscReal      x = PetscRealPart(point[0]);
-  PetscReal      y = PetscRealPart(point[1]);
-  PetscReal      z = PetscRealPart(point[2]);
+  PetscReal      J[9], invJ[9], detJ, invDet;
   PetscReal      xi, eta, zeta;
-  PetscErrorCode ierr;
-
-  PetscFunctionBegin;
-  ierr = DMPlexComputeCellGeometryFEM(dm, c, NULL, v0, J, invJ, &detJ);CHKERRQ(ierr);
-  xi   = invJ[0*embedDim+0]*(x - v0[0]) + invJ[0*embedDim+1]*(y - v0[1]) + invJ[0*embedDim+2]*(z - v0[2]);
-  eta  = invJ[1*embedDim+0]*(x - v0[0]) + invJ[1*embedDim+1]*(y - v0[1]) + invJ[1*embedDim+2]*(z - v0[2]);
-  zeta = invJ[2*embedDim+0]*(x - v0[0]) + invJ[2*embedDim+1]*(y - v0[1]) + invJ[2*embedDim+2]*(z - v0[2]);
+  PetscInt       d;
 
-  if ((xi >= 0.0) && (eta >= 0.0) && (zeta >= 0.0) && (xi + eta + zeta <= 2.0)) *cell = c;
-  else *cell = DMLOCATEPOINT_POINT_NOT_FOUND;
-  PetscFunctionReturn(0);
+  for (d = 0; d < embedDim; ++d) {
+    /* Same vertex order as DMPlexComputeTetrahedronGeometry_Internal() */
+    J[d*embedDim+0] = 0.5*(v[2*embedDim+d] - v[0*embedDim+d]);
+    J[d*embedDim+1] = 0.5*(v[1*embedDim+d] - v[0*embedDim+d]);
+    J[d*embedDim+2] = 0.5*(v[3*embedDim+d] - v[0*embedDim+d]);
+  }
+  detJ = (J[0*3+0]*(J[1*3+1]*J[2*3+2] - J[1*3+2]*J[2*3+1]) +
+          J[0*3+1]*(J[1*3+2]*J[2*3+0] - J[1*3+0]*J[2*3+2]) +
+          J[0*3+2]*(J[1*3+0]*J[2*3+1] - J[1*3+1]*J[2*3+0]));
+  invDet = 1.0/detJ;
+  invJ[0*3+0] = invDet*(J[1*3+1]*J[2*3+2] - J[1*3+2]*J[2*3+1]);
+  invJ[0*3+1] = invDet*(J[0*3+2]*J[2*3+1] - J[0*3+1]*J[2*3+2]);
+  invJ[0*3+2] = invDet*(J[0*3+1]*J[1*3+2] - J[0*3+2]*J[1*3+1]);
+  invJ[1*3+0] = invDet*(J[1*3+2]*J[2*3+0] - J[1*3+0]*J[2*3+2]);
+  invJ[1*3+1] = invDet*(J[0*3+0]*J[2*3+2] - J[0*3+2]*J[2*3+0]);
+  invJ[1*3+2] = invDet*(J[0*3+2]*J[1*3+0] - J[0*3+0]*J[1*3+2]);
+  invJ[2*3+0] = invDet*(J[1*3+0]*J[2*3+1] - J[1*3+1]*J[2*3+0]);
+  invJ[2*3+1] = invDet*(J[0*3+1]*J[2*3+0] - J[0*3+0]*J[2*3+1]);
+  invJ[2*3+2] = invDet*(J[0*3+0]*J[1*3+1] - J[0*3+1]*J[1*3+0]);
+  xi   = invJ[0*embedDim+0]*(x[0] - v[0]) + invJ[0*embedDim+1]*(x[1] - v[1]) + invJ[0*embedDim+2]*(x[2] - v[2]);
+  eta  = invJ[1*embedDim+0]*(x[0] - v[0]) + invJ[1*embedDim+1]*(x[1] - v[1]) + invJ[1*embedDim+2]*(x[2] - v[2]);
+  zeta = invJ[2*embedDim+0]*(x[0] - v[0]) + invJ[2*embedDim+1]*(x[1] - v[1]) + invJ[2*embedDim+2]*(x[2] - v[2]);
+
+  return (xi >= 0.0) && (eta >= 0.0) && (zeta >= 0.0) && (xi + eta + zeta <= 2.0) ? PETSC_TRUE : PETSC_FALSE;
 }
 
-static PetscErrorCode DMPlexLocatePoint_General_3D_Internal(DM dm, const PetscScalar point[], PetscInt c, PetscInt *cell)
+static PetscBool DMPlexLocatePoint_General_3D_Private(const PetscReal v[], const PetscReal x[])
 {
-  PetscSection   coordSection;
-  Vec            coordsLocal;
-  PetscScalar   *coords = NULL;
   const PetscInt faces[24] = {0, 3, 2, 1,  5, 4, 7, 6,  3, 0, 4, 5,
                               1, 2, 6, 7,  3, 5, 6, 2,  0, 1, 7, 4};
-  PetscBool      found = PETSC_TRUE;
   PetscInt       f;
-  PetscErrorCode ierr;
 
-  PetscFunctionBegin;
-  ierr = DMGetCoordinatesLocal(dm, &coordsLocal);CHKERRQ(ierr);
-  ierr = DMGetCoordinateSection(dm, &coordSection);CHKERRQ(ierr);
-  ierr = DMPlexVecGetClosure(dm, coordSection, coordsLocal, c, NULL, &coords);CHKERRQ(ierr);
   for (f = 0; f < 6; ++f) {
     /* Check the point is under plane */
     /*   Get face normal */
@@ -160,29 +146,62 @@ static PetscErrorCode DMPlexLocatePoint_General_3D_Internal(DM dm, const PetscSc
     PetscReal pp[3];
     PetscReal dot;
 
-    v_i[0]    = PetscRealPart(coords[faces[f*4+3]*3+0]-coords[faces[f*4+0]*3+0]);
-    v_i[1]    = PetscRealPart(coords[faces[f*4+3]*3+1]-coords[faces[f*4+0]*3+1]);
-    v_i[2]    = PetscRealPart(coords[faces[f*4+3]*3+2]-coords[faces[f*4+0]*3+2]);
-    v_j[0]    = PetscRealPart(coords[faces[f*4+1]*3+0]-coords[faces[f*4+0]*3+0]);
-    v_j[1]    = PetscRealPart(coords[faces[f*4+1]*3+1]-coords[faces[f*4+0]*3+1]);
-    v_j[2]    = PetscRealPart(coords[faces[f*4+1]*3+2]-coords[faces[f*4+0]*3+2]);
+    v_i[0]    = v[faces[f*4+3]*3+0]-v[faces[f*4+0]*3+0];
+    v_i[1]    = v[faces[f*4+3]*3+1]-v[faces[f*4+0]*3+1];
+    v_i[2]    = v[faces[f*4+3]*3+2]-v[faces[f*4+0]*3+2];
+    v_j[0]    = v[faces[f*4+1]*3+0]-v[faces[f*4+0]*3+0];
+    v_j[1]    = v[faces[f*4+1]*3+1]-v[faces[f*4+0]*3+1];
+    v_j[2]    = v[faces[f*4+1]*3+2]-v[faces[f*4+0]*3+2];
     normal[0] = v_i[1]*v_j[2] - v_i[2]*v_j[1];
     normal[1] = v_i[2]*v_j[0] - v_i[0]*v_j[2];
     normal[2] = v_i[0]*v_j[1] - v_i[1]*v_j[0];
-    pp[0]     = PetscRealPart(coords[faces[f*4+0]*3+0] - point[0]);
-    pp[1]     = PetscRealPart(coords[faces[f*4+0]*3+1] - point[1]);
-    pp[2]     = PetscRealPart(coords[faces[f*4+0]*3+2] - point[2]);
+    pp[0]     = v[faces[f*4+0]*3+0] - x[0];
+    pp[1]     = v[faces[f*4+0]*3+1] - x[1];
+    pp[2]     = v[faces[f*4+0]*3+2] - x[2];
     dot       = normal[0]*pp[0] + normal[1]*pp[1] + normal[2]*pp[2];
 
     /* Check that projected point is in face (2D location problem) */
-    if (dot < 0.0) {
-      found = PETSC_FALSE;
-      break;
-    }
+    if (dot < 0.0) return PETSC_FALSE;
+  }
+  return PETSC_TRUE;
+}
+
+/* Tests whether x lies in the cell with nv vertices whose coordinates are v[], the shape must be supported */
+static PetscBool DMPlexLocatePoint_Vertices_Private(PetscInt dim, PetscInt nv, const PetscReal v[], const PetscReal x[])
+{
+  switch (dim*10 + nv) {
+  case 12: return DMPlexLocatePoint_Segment_1D_Private(v, x);
+  case 23: return DMPlexLocatePoint_Simplex_2D_Private(v, x);
+  case 24: return DMPlexLocatePoint_General_2D_Private(v, x);
+  case 34: return DMPlexLocatePoint_Simplex_3D_Private(v, x);
+  case 38: return DMPlexLocatePoint_General_3D_Private(v, x);
+  default: return PETSC_FALSE;
   }
-  if (found) *cell = c;
-  else *cell = DMLOCATEPOINT_POINT_NOT_FOUND;
-  ierr = DMPlexVecRestoreClosure(dm, coordSection, coordsLocal, c, NULL, &coords);CHKERRQ(ierr);
+}
+
+static PetscErrorCode DMPlexClosestPoint_Simplex_2D_Internal(DM dm, const PetscScalar point[], PetscInt c, PetscReal cpoint[])
+{
+  const PetscInt  embedDim = 2;
+  PetscReal       x        = PetscRealPart(point[0]);
+  PetscReal       y        = PetscRealPart(point[1]);
+  PetscReal       v0[2], J[4], invJ[4], detJ;
+  PetscReal       xi, eta, r;
+  PetscErrorCode  ierr;
+
+  PetscFunctionBegin;
+  ierr = DMPlexComputeCellGeometryFEM(dm, c, NULL, v0, J, invJ, &detJ);CHKERRQ(ierr);
+  xi  = invJ[0*embedDim+0]*(x - v0[0]) + invJ[0*embedDim+1]*(y - v0[1]);
+  eta = invJ[1*embedDim+0]*(x - v0[0]) + invJ[1*embedDim+1]*(y - v0[1]);
+
+  xi  = PetscMax(xi,  0.0);
+  eta = PetscMax(eta, 0.0);
+  if (xi + eta > 2.0) {
+    r    = (xi + eta)/2.0;
+    xi  /= r;
+    eta /= r;
+  }
+  cpoint[0] = J[0*embedDim+0]*xi + J[0*embedDim+1]*eta + v0[0];
+  cpoint[1] = J[1*embedDim+0]*xi + J[1*embedDim+1]*eta + v0[1];
   PetscFunctionReturn(0);
 }
 
@@ -355,40 +374,27 @@ PetscErrorCode PetscGridHashDestroy(PetscGridHash *box)
 
 PetscErrorCode DMPlexLocatePoint_Internal(DM dm, PetscInt dim, const PetscScalar point[], PetscInt cellStart, PetscInt *cell)
 {
-  PetscInt       coneSize;
+  PetscSection   coordSection;
+  Vec            coordsLocal;
+  PetscScalar   *coords = NULL;
+  PetscReal      v[24], x[3];
+  PetscInt       pStart, pEnd, dof = 0, size, nv, i, d;
   PetscErrorCode ierr;
 
   PetscFunctionBegin;
-  switch (dim) {
-  case 2:
-    ierr = DMPlexGetConeSize(dm, cellStart, &coneSize);CHKERRQ(ierr);
-    switch (coneSize) {
-    case 3:
-      ierr = DMPlexLocatePoint_Simplex_2D_Internal(dm, point, cellStart, cell);CHKERRQ(ierr);
-      break;
-    case 4:
-      ierr = DMPlexLocatePoint_General_2D_Internal(dm, point, cellStart, cell);CHKERRQ(ierr);
-      break;
-    default:
-      SETERRQ1(PetscObjectComm((PetscObject)dm), PETSC_ERR_ARG_OUTOFRANGE, "No point location for cell with cone size %D", coneSize);
-    }
-    break;
-  case 3:
-    ierr = DMPlexGetConeSize(dm, cellStart, &coneSize);CHKERRQ(ierr);
-    switch (coneSize) {
-    case 4:
-      ierr = DMPlexLocatePoint_Simplex_3D_Internal(dm, point, cellStart, cell);CHKERRQ(ierr);
-      break;
-    case 6:
-      ierr = DMPlexLocatePoint_General_3D_Internal(dm, point, cellStart, cell);CHKERRQ(ierr);
-      break;
-    default:
-      SETERRQ1(PetscObjectComm((PetscObject)dm), PETSC_ERR_ARG_OUTOFRANGE, "No point location for cell with cone size %D", coneSize);
-    }
-    break;
-  default:
-    SETERRQ1(PetscObjectComm((PetscObject)dm), PETSC_ERR_ARG_OUTOFRANGE, "No point location for mesh dimension %D", dim);
-  }
+  if ((dim < 1) || (dim > 3)) SETERRQ1(PetscObjectComm((PetscObject)dm), PETSC_ERR_ARG_OUTOFRANGE, "No point location for mesh dimension %D", dim);
+  ierr = DMGetCoordinatesLocal(dm, &coordsLocal);CHKERRQ(ierr);
+  ierr = DMGetCoordinateSection(dm, &coordSection);CHKERRQ(ierr);
+  ierr = PetscSectionGetChart(coordSection, &pStart, &pEnd);CHKERRQ(ierr);
+  /* Localized coordinates are stored on the cell and come first in the closure */
+  if ((cellStart >= pStart) && (cellStart < pEnd)) {ierr = PetscSectionGetDof(coordSection, cellStart, &dof);CHKERRQ(ierr);}
+  ierr = DMPlexVecGetClosure(dm, coordSection, coordsLocal, cellStart, &size, &coords);CHKERRQ(ierr);
+  nv   = (dof ? dof : size)/dim;
+  if (DMPlexLocatePoint_Supported_Private(dim, nv)) {for (i = 0; i < nv*dim; ++i) v[i] = PetscRealPart(coords[i]);}
+  ierr = DMPlexVecRestoreClosure(dm, coordSection, coordsLocal, cellStart, &size, &coords);CHKERRQ(ierr);
+  if (!DMPlexLocatePoint_Supported_Private(dim, nv)) SETERRQ2(PetscObjectComm((PetscObject)dm), PETSC_ERR_ARG_OUTOFRANGE, "No point location for cell with %D vertices in dimension %D", nv, dim);
+  for (d = 0; d < dim; ++d) x[d] = PetscRealPart(point[d]);
+  *cell = DMPlexLocatePoint_Vertices_Private(dim, nv, v, x) ? cellStart : DMLOCATEPOINT_POINT_NOT_FOUND;
   PetscFunctionReturn(0);
 }
 
@@ -571,11 +577,408 @@ PetscErrorCode DMPlexComputeGridHash_Internal(DM dm, PetscGridHash *localBox)
   PetscFunctionReturn(0);
 }
 
+#define DMPLEX_BVH_LEAF_SIZE 8
+#define DMPLEX_BVH_MAX_DEPTH 64
+#define DMPLEX_BVH_MAX_WALK  64
+
+PETSC_STATIC_INLINE PetscBool DMPlexCellBVHCellContains_Private(DMPlexCellBVH bvh, PetscInt c, const PetscReal x[])
+{
+  const PetscInt off = bvh->vertOff[c];
+
+  return DMPlexLocatePoint_Vertices_Private(bvh->dim, (bvh->vertOff[c+1] - off)/bvh->dim, &bvh->vertCoords[off], x);
+}
+
+/* Returns the lowest numbered cell containing x, relative to cStart, or -1 */
+static PetscInt DMPlexCellBVHQuery_Private(DMPlexCellBVH bvh, const PetscReal x[])
+{
+  const PetscInt dim = bvh->dim;
+  PetscInt       stack[DMPLEX_BVH_MAX_DEPTH+1], top = 0, found = -1, d, i;
+
+  if (bvh->numNodes) stack[top++] = 0;
+  while (top) {
+    const PetscInt   n   = stack[--top];
+    const PetscReal *box = &bvh->box[n*2*dim];
+
+    for (d = 0; d < dim; ++d) if ((x[d] < box[d]) || (x[d] > box[dim+d])) break;
+    if (d < dim) continue;
+    if (bvh->child[n] < 0) {
+      for (i = bvh->start[n]; i < bvh->end[n]; ++i) {
+        const PetscInt c = bvh->cells[i];
+
+        if ((found >= 0) && (c >= found)) continue;
+        if (DMPlexCellBVHCellContains_Private(bvh, c, x)) found = c;
+      }
+    } else {
+      stack[top++] = bvh->child[n]+1;
+      stack[top++] = bvh->child[n];
+    }
+  }
+  return found;
+}
+
+/* Breadth first search through face neighbors of c, which has already been tested, trying at most walk cells */
+static PetscInt DMPlexCellBVHWalk_Private(DMPlexCellBVH bvh, PetscInt walk, PetscInt c, const PetscReal x[])
+{
+  PetscInt queue[DMPLEX_BVH_MAX_WALK+1], head = 0, tail = 0, n, q;
+
+  queue[tail++] = c;
+  while (head < tail) {
+    const PetscInt cell = queue[head++];
+
+    for (n = bvh->nbrOff[cell]; n < bvh->nbrOff[cell+1]; ++n) {
+      const PetscInt nbr = bvh->nbrs[n];
+
+      for (q = 0; q < tail; ++q) if (queue[q] == nbr) break;
+      if (q < tail) continue;
+      if (tail > walk) return -1;
+      if (DMPlexCellBVHCellContains_Private(bvh, nbr, x)) return nbr;
+      queue[tail++] = nbr;
+    }
+  }
+  return -1;
+}
+
+static PetscErrorCode DMPlexCellBVHBuild_Private(DMPlexCellBVH bvh, const PetscReal cbox[], const PetscReal centroids[], PetscReal keys[], PetscInt n, PetscInt depth)
+{
+  const PetscInt dim = bvh->dim, s = bvh->start[n], e = bvh->end[n];
+  PetscReal     *box = &bvh->box[n*2*dim];
+  PetscReal      clo[3], chi[3];
+  PetscInt       axis = 0, left, i, d;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (depth > DMPLEX_BVH_MAX_DEPTH) SETERRQ1(PETSC_COMM_SELF, PETSC_ERR_PLIB, "Bounding volume hierarchy deeper than %d", DMPLEX_BVH_MAX_DEPTH);
+  for (d = 0; d < dim; ++d) {box[d] = clo[d] = PETSC_MAX_REAL; box[dim+d] = chi[d] = PETSC_MIN_REAL;}
+  for (i = s; i < e; ++i) {
+    const PetscInt c = bvh->cells[i];
+
+    for (d = 0; d < dim; ++d) {
+      box[d]     = PetscMin(box[d],     cbox[c*2*dim+d]);
+      box[dim+d] = PetscMax(box[dim+d], cbox[c*2*dim+dim+d]);
+      clo[d]     = PetscMin(clo[d], centroids[c*dim+d]);
+      chi[d]     = PetscMax(chi[d], centroids[c*dim+d]);
+    }
+  }
+  bvh->child[n] = -1;
+  if (e - s <= DMPLEX_BVH_LEAF_SIZE) PetscFunctionReturn(0);
+  /* Split at the median centroid along the longest axis */
+  for (d = 1; d < dim; ++d) if (chi[d] - clo[d] > chi[axis] - clo[axis]) axis = d;
+  for (i = s; i < e; ++i) keys[i] = centroids[bvh->cells[i]*dim+axis];
+  ierr = PetscSortRealWithArrayInt(e - s, &keys[s], &bvh->cells[s]);CHKERRQ(ierr);
+  left = bvh->numNodes;
+  bvh->numNodes += 2;
+  bvh->child[n]      = left;
+  bvh->start[left]   = s;
+  bvh->end[left]     = (s + e)/2;
+  bvh->start[left+1] = (s + e)/2;
+  bvh->end[left+1]   = e;
+  ierr = DMPlexCellBVHBuild_Private(bvh, cbox, centroids, keys, left,   depth+1);CHKERRQ(ierr);
+  ierr = DMPlexCellBVHBuild_Private(bvh, cbox, centroids, keys, left+1, depth+1);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode DMPlexCellBVHDestroy_Internal(DMPlexCellBVH *bvh)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (!*bvh) PetscFunctionReturn(0);
+  ierr = VecDestroy(&(*bvh)->coordinates);CHKERRQ(ierr);
+  ierr = PetscFree2((*bvh)->vertOff, (*bvh)->vertCoords);CHKERRQ(ierr);
+  ierr = PetscFree2((*bvh)->nbrOff, (*bvh)->nbrs);CHKERRQ(ierr);
+  ierr = PetscFree5((*bvh)->box, (*bvh)->child, (*bvh)->start, (*bvh)->end, (*bvh)->cells);CHKERRQ(ierr);
+  ierr = PetscFree(*bvh);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+  DMPlexGetCellBVH_Internal - Returns the bounding volume hierarchy over the local cells, building it if the local
+  coordinates changed since it was last built. It is stored on the DM and destroyed with it.
+*/
+PetscErrorCode DMPlexGetCellBVH_Internal(DM dm, DMPlexCellBVH *tree)
+{
+  DM_Plex         *mesh = (DM_Plex *) dm->data;
+  DMPlexCellBVH    bvh  = mesh->bvh;
+  PetscSection     coordSection;
+  Vec              coordsLocal;
+  PetscObjectState state;
+  PetscReal       *cbox, *centroids, *keys;
+  PetscInt         dim, tdim, depth, cStart, cEnd, cMax, pStart, pEnd, numCells, c, d, i;
+  PetscErrorCode   ierr;
+
+  PetscFunctionBegin;
+  ierr = DMGetCoordinatesLocal(dm, &coordsLocal);CHKERRQ(ierr);
+  if (!coordsLocal) SETERRQ(PetscObjectComm((PetscObject) dm), PETSC_ERR_ARG_WRONGSTATE, "Point location requires coordinates");
+  ierr = PetscObjectStateGet((PetscObject) coordsLocal, &state);CHKERRQ(ierr);
+  if (bvh && (bvh->coordinates == coordsLocal) && (bvh->state == state)) {*tree = bvh; PetscFunctionReturn(0);}
+  ierr = DMPlexCellBVHDestroy_Internal(&mesh->bvh);CHKERRQ(ierr);
+  ierr = PetscInfo(dm, "Building bounding volume hierarchy for point location\n");CHKERRQ(ierr);
+  ierr = DMGetCoordinateDim(dm, &dim);CHKERRQ(ierr);
+  ierr = DMGetDimension(dm, &tdim);CHKERRQ(ierr);
+  ierr = DMPlexGetDepth(dm, &depth);CHKERRQ(ierr);
+  ierr = DMGetCoordinateSection(dm, &coordSection);CHKERRQ(ierr);
+  ierr = PetscSectionGetChart(coordSection, &pStart, &pEnd);CHKERRQ(ierr);
+  ierr = DMPlexGetHeightStratum(dm, 0, &cStart, &cEnd);CHKERRQ(ierr);
+  ierr = DMPlexGetHybridBounds(dm, &cMax, NULL, NULL, NULL);CHKERRQ(ierr);
+  if (cMax >= 0) cEnd = PetscMin(cEnd, cMax);
+  numCells = cEnd - cStart;
+  ierr = PetscNew(&bvh);CHKERRQ(ierr);
+  bvh->dim    = dim;
+  bvh->cStart = cStart;
+  bvh->cEnd   = cEnd;
+  ierr = PetscObjectReference((PetscObject) coordsLocal);CHKERRQ(ierr);
+  bvh->coordinates = coordsLocal;
+  bvh->state       = state;
+  /* Cache the vertex coordinates of each cell, using the cell coordinates if they have been localized */
+  ierr = PetscMalloc1(numCells+1, &bvh->vertOff);CHKERRQ(ierr);
+  bvh->vertOff[0] = 0;
+  for (c = cStart; c < cEnd; ++c) {
+    PetscScalar *ccoords = NULL;
+    PetscInt     dof = 0, size;
+
+    if ((c >= pStart) && (c < pEnd)) {ierr = PetscSectionGetDof(coordSection, c, &dof);CHKERRQ(ierr);}
+    ierr = DMPlexVecGetClosure(dm, coordSection, coordsLocal, c, &size, &ccoords);CHKERRQ(ierr);
+    ierr = DMPlexVecRestoreClosure(dm, coordSection, coordsLocal, c, &size, &ccoords);CHKERRQ(ierr);
+    if (dof) size = dof;
+    if (!DMPlexLocatePoint_Supported_Private(dim, size/dim)) SETERRQ3(PETSC_COMM_SELF, PETSC_ERR_SUP, "No point location for cell %D with %D vertices in dimension %D", c, size/dim, dim);
+    bvh->vertOff[c-cStart+1] = bvh->vertOff[c-cStart] + size;
+  }
+  {
+    PetscInt *vertOff = bvh->vertOff;
+
+    ierr = PetscMalloc2(numCells+1, &bvh->vertOff, vertOff[numCells], &bvh->vertCoords);CHKERRQ(ierr);
+    ierr = PetscMemcpy(bvh->vertOff, vertOff, (numCells+1) * sizeof(PetscInt));CHKERRQ(ierr);
+    ierr = PetscFree(vertOff);CHKERRQ(ierr);
+  }
+  ierr = PetscMalloc3(numCells*2*dim, &cbox, numCells*dim, &centroids, numCells, &keys);CHKERRQ(ierr);
+  for (c = 0; c < numCells; ++c) {
+    PetscScalar *ccoords = NULL;
+    PetscReal   *v  = &bvh->vertCoords[bvh->vertOff[c]];
+    PetscReal   *lo = &cbox[c*2*dim], *hi = &cbox[c*2*dim+dim];
+    PetscInt     nv = (bvh->vertOff[c+1] - bvh->vertOff[c])/dim, size, e;
+    PetscReal    tol = 0.0;
+
+    ierr = DMPlexVecGetClosure(dm, coordSection, coordsLocal, c+cStart, &size, &ccoords);CHKERRQ(ierr);
+    for (i = 0; i < nv*dim; ++i) v[i] = PetscRealPart(ccoords[i]);
+    ierr = DMPlexVecRestoreClosure(dm, coordSection, coordsLocal, c+cStart, &size, &ccoords);CHKERRQ(ierr);
+    for (d = 0; d < dim; ++d) {lo[d] = PETSC_MAX_REAL; hi[d] = PETSC_MIN_REAL; centroids[c*dim+d] = 0.0;}
+    for (e = 0; e < nv; ++e) {
+      for (d = 0; d < dim; ++d) {
+        lo[d] = PetscMin(lo[d], v[e*dim+d]);
+        hi[d] = PetscMax(hi[d], v[e*dim+d]);
+        centroids[c*dim+d] += v[e*dim+d]/nv;
+      }
+    }
+    /* Enlarge the box to cover the tolerance of the point in cell tests */
+    for (d = 0; d < dim; ++d) tol = PetscMax(tol, hi[d] - lo[d]);
+    tol *= PETSC_SQRT_MACHINE_EPSILON;
+    for (d = 0; d < dim; ++d) {lo[d] -= tol; hi[d] += tol;}
+  }
+  /* Face neighbors for walking from an initial guess */
+  ierr = PetscMalloc1(numCells+1, &bvh->nbrOff);CHKERRQ(ierr);
+  for (i = 0; i < 2; ++i) {
+    PetscInt *nbrOff = bvh->nbrOff, n = 0;
+
+    if (i) {ierr = PetscMalloc2(numCells+1, &bvh->nbrOff, nbrOff[numCells], &bvh->nbrs);CHKERRQ(ierr);}
+    for (c = cStart; c < cEnd; ++c) {
+      const PetscInt *cone, *supp;
+      PetscInt        coneSize, suppSize, f, s;
+
+      if (!i) nbrOff[c-cStart] = n;
+      if ((depth == tdim) && tdim) {
+        ierr = DMPlexGetConeSize(dm, c, &coneSize);CHKERRQ(ierr);
+        ierr = DMPlexGetCone(dm, c, &cone);CHKERRQ(ierr);
+        for (f = 0; f < coneSize; ++f) {
+          ierr = DMPlexGetSupportSize(dm, cone[f], &suppSize);CHKERRQ(ierr);
+          ierr = DMPlexGetSupport(dm, cone[f], &supp);CHKERRQ(ierr);
+          for (s = 0; s < suppSize; ++s) {
+            if ((supp[s] == c) || (supp[s] < cStart) || (supp[s] >= cEnd)) continue;
+            if (i) bvh->nbrs[n] = supp[s] - cStart;
+            ++n;
+          }
+        }
+      }
+    }
+    if (!i) nbrOff[numCells] = n;
+    else {
+      ierr = PetscMemcpy(bvh->nbrOff, nbrOff, (numCells+1) * sizeof(PetscInt));CHKERRQ(ierr);
+      ierr = PetscFree(nbrOff);CHKERRQ(ierr);
+    }
+  }
+  /* A binary tree with leaves of at least one cell has fewer than 2 numCells nodes */
+  ierr = PetscMalloc5(PetscMax(2*numCells, 1)*2*dim, &bvh->box, PetscMax(2*numCells, 1), &bvh->child, PetscMax(2*numCells, 1), &bvh->start, PetscMax(2*numCells, 1), &bvh->end, numCells, &bvh->cells);CHKERRQ(ierr);
+  for (c = 0; c < numCells; ++c) bvh->cells[c] = c;
+  if (numCells) {
+    bvh->numNodes = 1;
+    bvh->start[0] = 0;
+    bvh->end[0]   = numCells;
+    ierr = DMPlexCellBVHBuild_Private(bvh, cbox, centroids, keys, 0, 0);CHKERRQ(ierr);
+  }
+  ierr = PetscFree3(cbox, centroids, keys);CHKERRQ(ierr);
+  ierr = PetscInfo2(dm, "Bounding volume hierarchy with %D nodes over %D cells\n", bvh->numNodes, numCells);CHKERRQ(ierr);
+  mesh->bvh = *tree = bvh;
+  PetscFunctionReturn(0);
+}
+
+/* Locate points with the bounding volume hierarchy, after trying the initial guess in cells[] and its neighbors */
+static PetscErrorCode DMLocatePoints_Plex_BVH(DM dm, PetscInt numPoints, const PetscScalar a[], const PetscReal gmin[], const PetscReal gmax[], PetscSFNode cells[], PetscInt *numFound, PetscInt terminating_query_type[])
+{
+  DM_Plex       *mesh = (DM_Plex *) dm->data;
+  DMPlexCellBVH  bvh;
+  PetscInt       walk = mesh->locationWalk, found = 0, outside = 0, guess = 0, walked = 0, searched = 0, p;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = DMPlexGetCellBVH_Internal(dm, &bvh);CHKERRQ(ierr);
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(static) reduction(+:found,outside,guess,walked,searched)
+#endif
+  for (p = 0; p < numPoints; ++p) {
+    const PetscInt dim = bvh->dim;
+    PetscReal      x[3];
+    PetscInt       cell = -1, c, d;
+
+    for (d = 0; d < dim; ++d) x[d] = PetscRealPart(a[p*dim+d]);
+    for (d = 0; d < dim; ++d) if ((x[d] < gmin[d]) || (x[d] > gmax[d])) break;
+    c = cells[p].index;
+    cells[p].rank  = 0;
+    cells[p].index = DMLOCATEPOINT_POINT_NOT_FOUND;
+    if (d < dim) {++outside; continue;}
+    if ((c >= bvh->cStart) && (c < bvh->cEnd)) {
+      c -= bvh->cStart;
+      if (DMPlexCellBVHCellContains_Private(bvh, c, x)) {cell = c; ++guess;}
+      else if (walk) {
+        cell = DMPlexCellBVHWalk_Private(bvh, walk, c, x);
+        if (cell >= 0) ++walked;
+      }
+    }
+    if (cell < 0) {
+      cell = DMPlexCellBVHQuery_Private(bvh, x);
+      if (cell >= 0) ++searched;
+    }
+    if (cell >= 0) {
+      cells[p].index = cell + bvh->cStart;
+      ++found;
+    }
+  }
+  *numFound = found;
+  terminating_query_type[0] = outside;
+  terminating_query_type[1] = guess;
+  terminating_query_type[2] = searched;
+  ierr = PetscInfo1(dm, "[DMLocatePoints_Plex] %D points found by walking from the initial cell\n", walked);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@
+  DMPlexGetUseBVHLocation - Get the flag indicating that DMLocatePoints() searches a bounding volume hierarchy over the cells
+
+  Input Parameter:
+. dm - The DMPlex object
+
+  Output Parameter:
+. useBVH - The flag
+
+  Level: intermediate
+
+.seealso: DMPlexSetUseBVHLocation(), DMPlexGetPointLocationWalk(), DMLocatePoints()
+@*/
+PetscErrorCode DMPlexGetUseBVHLocation(DM dm, PetscBool *useBVH)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(dm, DM_CLASSID, 1);
+  PetscValidPointer(useBVH, 2);
+  *useBVH = ((DM_Plex *) dm->data)->useBVHLocation;
+  PetscFunctionReturn(0);
+}
+
+/*@
+  DMPlexSetUseBVHLocation - Set the flag indicating that DMLocatePoints() searches a bounding volume hierarchy over the cells
+
+  Input Parameters:
++ dm - The DMPlex object
+- useBVH - The flag
+
+  Options Database:
+. -dm_plex_bvh_location - Use the bounding volume hierarchy
+
+  Notes:
+  The hierarchy is a binary tree of cell bounding boxes, split at the median cell centroid along the longest axis. It
+  is built on the first call to DMLocatePoints(), kept on the DM, and only rebuilt when the local coordinates change.
+  The vertex coordinates of each cell are cached alongside it, so that the points can be located concurrently by
+  OpenMP threads. Each point is first tried in the cell given in the input PetscSF, then in its neighbors (see
+  DMPlexSetPointLocationWalk()), and only then searched for in the tree. Among the cells containing a point, the tree
+  search returns the lowest numbered one, as the brute force search does.
+
+  DM_POINTLOCATION_NEAREST still requires grid hashing, -dm_plex_hash_location.
+
+  Level: intermediate
+
+.seealso: DMPlexGetUseBVHLocation(), DMPlexSetPointLocationWalk(), DMLocatePoints()
+@*/
+PetscErrorCode DMPlexSetUseBVHLocation(DM dm, PetscBool useBVH)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(dm, DM_CLASSID, 1);
+  ((DM_Plex *) dm->data)->useBVHLocation = useBVH;
+  PetscFunctionReturn(0);
+}
+
+/*@
+  DMPlexGetPointLocationWalk - Get the number of neighbor cells tried from the initial guess before searching
+
+  Input Parameter:
+. dm - The DMPlex object
+
+  Output Parameter:
+. walk - The maximum number of cells tried
+
+  Level: intermediate
+
+.seealso: DMPlexSetPointLocationWalk(), DMPlexSetUseBVHLocation()
+@*/
+PetscErrorCode DMPlexGetPointLocationWalk(DM dm, PetscInt *walk)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(dm, DM_CLASSID, 1);
+  PetscValidPointer(walk, 2);
+  *walk = ((DM_Plex *) dm->data)->locationWalk;
+  PetscFunctionReturn(0);
+}
+
+/*@
+  DMPlexSetPointLocationWalk - Set the number of neighbor cells tried from the initial guess before searching
+
+  Input Parameters:
++ dm - The DMPlex object
+- walk - The maximum number of cells tried, at most 64
+
+  Options Database:
+. -dm_plex_location_walk <n> - The number of cells
+
+  Notes:
+  When a point is not in the cell given for it in the input PetscSF of DMLocatePoints(), the face neighbors of that cell
+  are tried breadth first, up to walk cells, before searching the bounding volume hierarchy. This is cheap for points
+  which moved only slightly since the last location, such as particles. The walk requires an interpolated mesh and is
+  only used with DMPlexSetUseBVHLocation().
+
+  Level: intermediate
+
+.seealso: DMPlexGetPointLocationWalk(), DMPlexSetUseBVHLocation(), DMLocatePoints()
+@*/
+PetscErrorCode DMPlexSetPointLocationWalk(DM dm, PetscInt walk)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(dm, DM_CLASSID, 1);
+  if ((walk < 0) || (walk > DMPLEX_BVH_MAX_WALK)) SETERRQ2(PetscObjectComm((PetscObject) dm), PETSC_ERR_ARG_OUTOFRANGE, "Location walk %D must be in [0, %d]", walk, DMPLEX_BVH_MAX_WALK);
+  ((DM_Plex *) dm->data)->locationWalk = walk;
+  PetscFunctionReturn(0);
+}
+
 PetscErrorCode DMLocatePoints_Plex(DM dm, Vec v, DMPointLocationType ltype, PetscSF cellSF)
 {
   DM_Plex        *mesh = (DM_Plex *) dm->data;
-  PetscBool       hash = mesh->useHashLocation, reuse = PETSC_FALSE;
-  PetscInt        bs, numPoints, p, numFound, *found = NULL;
+  PetscBool       hash = mesh->useHashLocation, bvh = mesh->useBVHLocation, reuse = PETSC_FALSE;
+  PetscInt        bs, numPoints, p, numFound = 0, *found = NULL;
   PetscInt        dim, cStart, cEnd, cMax, numCells, c, d;
   const PetscInt *boxCells;
   PetscSFNode    *cells;
@@ -626,58 +1029,74 @@ PetscErrorCode DMLocatePoints_Plex(DM dm, Vec v, DMPointLocationType ltype, Pets
     ierr = VecStrideMaxAll(coorglobal,NULL,gmax);CHKERRQ(ierr);
     ierr = VecStrideMinAll(coorglobal,NULL,gmin);CHKERRQ(ierr);
   }
-  if (hash) {
-    if (!mesh->lbox) {ierr = PetscInfo(dm, "Initializing grid hashing");CHKERRQ(ierr);ierr = DMPlexComputeGridHash_Internal(dm, &mesh->lbox);CHKERRQ(ierr);}
-    /* Designate the local box for each point */
-    /* Send points to correct process */
-    /* Search cells that lie in each subbox */
-    /*   Should we bin points before doing search? */
-    ierr = ISGetIndices(mesh->lbox->cells, &boxCells);CHKERRQ(ierr);
-  }
-  for (p = 0, numFound = 0; p < numPoints; ++p) {
-    const PetscScalar *point = &a[p*bs];
-    PetscInt           dbin[3] = {-1,-1,-1}, bin, cell = -1, cellOffset;
-    PetscBool          point_outside_domain = PETSC_FALSE;
-
-    /* check bounding box of domain */
-    for (d=0; d<dim; d++) {
-      if (PetscRealPart(point[d]) < gmin[d]) { point_outside_domain = PETSC_TRUE; break; }
-      if (PetscRealPart(point[d]) > gmax[d]) { point_outside_domain = PETSC_TRUE; break; }
-    }
-    if (point_outside_domain) {
-      cells[p].rank = 0;
-      cells[p].index = DMLOCATEPOINT_POINT_NOT_FOUND;
-      terminating_query_type[0]++;
-      continue;
-    }
-    
-    /* check initial values in cells[].index - abort early if found */
-    if (cells[p].index != DMLOCATEPOINT_POINT_NOT_FOUND) {
-      c = cells[p].index;
-      cells[p].index = DMLOCATEPOINT_POINT_NOT_FOUND;
-      ierr = DMPlexLocatePoint_Internal(dm, dim, point, c, &cell);CHKERRQ(ierr);
-      if (cell >= 0) {
+  if (bvh && ltype != DM_POINTLOCATION_NEAREST) {
+    ierr = DMLocatePoints_Plex_BVH(dm, numPoints, a, gmin, gmax, cells, &numFound, terminating_query_type);CHKERRQ(ierr);
+  } else {
+    bvh = PETSC_FALSE;
+    if (hash) {
+      if (!mesh->lbox) {ierr = PetscInfo(dm, "Initializing grid hashing");CHKERRQ(ierr);ierr = DMPlexComputeGridHash_Internal(dm, &mesh->lbox);CHKERRQ(ierr);}
+      /* Designate the local box for each point */
+      /* Send points to correct process */
+      /* Search cells that lie in each subbox */
+      /*   Should we bin points before doing search? */
+      ierr = ISGetIndices(mesh->lbox->cells, &boxCells);CHKERRQ(ierr);
+    }
+    for (p = 0, numFound = 0; p < numPoints; ++p) {
+      const PetscScalar *point = &a[p*bs];
+      PetscInt           dbin[3] = {-1,-1,-1}, bin, cell = -1, cellOffset;
+      PetscBool          point_outside_domain = PETSC_FALSE;
+
+      /* check bounding box of domain */
+      for (d=0; d<dim; d++) {
+        if (PetscRealPart(point[d]) < gmin[d]) { point_outside_domain = PETSC_TRUE; break; }
+        if (PetscRealPart(point[d]) > gmax[d]) { point_outside_domain = PETSC_TRUE; break; }
+      }
+      if (point_outside_domain) {
         cells[p].rank = 0;
-        cells[p].index = cell;
-        numFound++;
+        cells[p].index = DMLOCATEPOINT_POINT_NOT_FOUND;
+        terminating_query_type[0]++;
+        continue;
+      }
+    
+      /* check initial values in cells[].index - abort early if found */
+      if (cells[p].index != DMLOCATEPOINT_POINT_NOT_FOUND) {
+        c = cells[p].index;
+        cells[p].index = DMLOCATEPOINT_POINT_NOT_FOUND;
+        ierr = DMPlexLocatePoint_Internal(dm, dim, point, c, &cell);CHKERRQ(ierr);
+        if (cell >= 0) {
+          cells[p].rank = 0;
+          cells[p].index = cell;
+          numFound++;
+        }
+      }
+      if (cells[p].index != DMLOCATEPOINT_POINT_NOT_FOUND) {
+        terminating_query_type[1]++;
+        continue;
       }
-    }
-    if (cells[p].index != DMLOCATEPOINT_POINT_NOT_FOUND) {
-      terminating_query_type[1]++;
-      continue;
-    }
   
-    if (hash) {
-      PetscBool found_box;
+      if (hash) {
+        PetscBool found_box;
       
-      /* allow for case that point is outside box - abort early */
-      ierr = PetscGridHashGetEnclosingBoxQuery(mesh->lbox, 1, point, dbin, &bin,&found_box);CHKERRQ(ierr);
-      if (found_box) {
-        /* TODO Lay an interface over this so we can switch between Section (dense) and Label (sparse) */
-        ierr = PetscSectionGetDof(mesh->lbox->cellSection, bin, &numCells);CHKERRQ(ierr);
-        ierr = PetscSectionGetOffset(mesh->lbox->cellSection, bin, &cellOffset);CHKERRQ(ierr);
-        for (c = cellOffset; c < cellOffset + numCells; ++c) {
-          ierr = DMPlexLocatePoint_Internal(dm, dim, point, boxCells[c], &cell);CHKERRQ(ierr);
+        /* allow for case that point is outside box - abort early */
+        ierr = PetscGridHashGetEnclosingBoxQuery(mesh->lbox, 1, point, dbin, &bin,&found_box);CHKERRQ(ierr);
+        if (found_box) {
+          /* TODO Lay an interface over this so we can switch between Section (dense) and Label (sparse) */
+          ierr = PetscSectionGetDof(mesh->lbox->cellSection, bin, &numCells);CHKERRQ(ierr);
+          ierr = PetscSectionGetOffset(mesh->lbox->cellSection, bin, &cellOffset);CHKERRQ(ierr);
+          for (c = cellOffset; c < cellOffset + numCells; ++c) {
+            ierr = DMPlexLocatePoint_Internal(dm, dim, point, boxCells[c], &cell);CHKERRQ(ierr);
+            if (cell >= 0) {
+              cells[p].rank = 0;
+              cells[p].index = cell;
+              numFound++;
+              terminating_query_type[2]++;
+              break;
+            }
+          }
+        }
+      } else {
+        for (c = cStart; c < cEnd; ++c) {
+          ierr = DMPlexLocatePoint_Internal(dm, dim, point, c, &cell);CHKERRQ(ierr);
           if (cell >= 0) {
             cells[p].rank = 0;
             cells[p].index = cell;
@@ -687,20 +1106,9 @@ PetscErrorCode DMLocatePoints_Plex(DM dm, Vec v, DMPointLocationType ltype, Pets
           }
         }
       }
-    } else {
-      for (c = cStart; c < cEnd; ++c) {
-        ierr = DMPlexLocatePoint_Internal(dm, dim, point, c, &cell);CHKERRQ(ierr);
-        if (cell >= 0) {
-          cells[p].rank = 0;
-          cells[p].index = cell;
-          numFound++;
-          terminating_query_type[2]++;
-          break;
-        }
-      }
     }
+    if (hash) {ierr = ISRestoreIndices(mesh->lbox->cells, &boxCells);CHKERRQ(ierr);}
   }
-  if (hash) {ierr = ISRestoreIndices(mesh->lbox->cells, &boxCells);CHKERRQ(ierr);}
   if (ltype == DM_POINTLOCATION_NEAREST && hash && numFound < numPoints) {
     for (p = 0; p < numPoints; p++) {
       const PetscScalar *point = &a[p*bs];
@@ -742,10 +1150,13 @@ PetscErrorCode DMLocatePoints_Plex(DM dm, Vec v, DMPointLocationType ltype, Pets
   }
   ierr = VecRestoreArray(v, &a);CHKERRQ(ierr);
   if (!reuse) {
-    ierr = PetscSFSetGraph(cellSF, cEnd - cStart, numFound, found, PETSC_OWN_POINTER, cells, PETSC_OWN_POINTER);CHKERRQ(ierr);
+    /* Unless they are removed, points which were not found keep their place in the graph */
+    ierr = PetscSFSetGraph(cellSF, cEnd - cStart, ltype == DM_POINTLOCATION_REMOVE ? numFound : numPoints, found, PETSC_OWN_POINTER, cells, PETSC_OWN_POINTER);CHKERRQ(ierr);
   }
   ierr = PetscTime(&t1);CHKERRQ(ierr);
-  if (hash) {
+  if (bvh) {
+    ierr = PetscInfo3(dm,"[DMLocatePoints_Plex] terminating_query_type : %D [outside domain] : %D [inside intial cell] : %D [bvh]\n",terminating_query_type[0],terminating_query_type[1],terminating_query_type[2]);CHKERRQ(ierr);
+  } else if (hash) {
     ierr = PetscInfo3(dm,"[DMLocatePoints_Plex] terminating_query_type : %D [outside domain] : %D [inside intial cell] : %D [hash]\n",terminating_query_type[0],terminating_query_type[1],terminating_query_type[2]);CHKERRQ(ierr);
   } else {
     ierr = PetscInfo3(dm,"[DMLocatePoints_Plex] terminating_query_type : %D [outside domain] : %D [inside intial cell] : %D [brute-force]\n",terminating_query_type[0],terminating_query_type[1],terminating_query_type[2]);CHKERRQ(ierr);
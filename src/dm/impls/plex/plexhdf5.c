@@ -733,6 +733,7 @@ typedef struct {
   DM          dm;
   PetscViewer viewer;
   DMLabel     label;
+  PetscSF     sfPoints; /* Map from global point numbers to local points, when the mesh was loaded in parallel */
 } LabelCtx;
 
 static herr_t ReadLabelStratumHDF5_Static(hid_t g_id, const char *name, const H5L_info_t *info, void *op_data)
@@ -752,17 +753,22 @@ static herr_t ReadLabelStratumHDF5_Static(hid_t g_id, const char *name, const H5
   ierr = DMLabelGetName(label, &lname);
   ierr = PetscSNPrintf(group, PETSC_MAX_PATH_LEN, "/labels/%s/%s", lname, name);CHKERRQ(ierr);
   ierr = PetscViewerHDF5PushGroup(viewer, group);CHKERRQ(ierr);
-  {
+  ierr = PetscViewerHDF5ReadSizes(viewer, "indices", NULL, &N);CHKERRQ(ierr);
+  if (!((LabelCtx *) op_data)->sfPoints) {
     /* Force serial load */
-    ierr = PetscViewerHDF5ReadSizes(viewer, "indices", NULL, &N);CHKERRQ(ierr);
     ierr = PetscLayoutSetLocalSize(stratumIS->map, !((LabelCtx *) op_data)->rank ? N : 0);CHKERRQ(ierr);
-    ierr = PetscLayoutSetSize(stratumIS->map, N);CHKERRQ(ierr);
   }
+  ierr = PetscLayoutSetSize(stratumIS->map, N);CHKERRQ(ierr);
   ierr = ISLoad(stratumIS, viewer);
   ierr = PetscViewerHDF5PopGroup(viewer);CHKERRQ(ierr);
   ierr = ISGetLocalSize(stratumIS, &N);
   ierr = ISGetIndices(stratumIS, &ind);
-  for (i = 0; i < N; ++i) {ierr = DMLabelSetValue(label, ind[i], value);}
+  if (((LabelCtx *) op_data)->sfPoints) {
+    /* Each process holds a chunk of the global point numbers, which are sent to the processes holding the points */
+    ierr = DMPlexSetLabelValues_DAG_Parallel_Internal(((LabelCtx *) op_data)->dm, ((LabelCtx *) op_data)->sfPoints, label, value, N, ind);
+  } else {
+    for (i = 0; i < N; ++i) {ierr = DMLabelSetValue(label, ind[i], value);}
+  }
   ierr = ISRestoreIndices(stratumIS, &ind);
   ierr = ISDestroy(&stratumIS);
   return 0;
@@ -781,7 +787,7 @@ static herr_t ReadLabelHDF5_Static(hid_t g_id, const char *name, const H5L_info_
   return err;
 }
 
-PetscErrorCode DMPlexLoadLabels_HDF5_Internal(DM dm, PetscViewer viewer)
+static PetscErrorCode DMPlexLoadLabels_HDF5_Static(DM dm, PetscSF sfPoints, PetscViewer viewer)
 {
   LabelCtx        ctx;
   hid_t           fileId, groupId;
@@ -790,8 +796,9 @@ PetscErrorCode DMPlexLoadLabels_HDF5_Internal(DM dm, PetscViewer viewer)
 
   PetscFunctionBegin;
   ierr = MPI_Comm_rank(PetscObjectComm((PetscObject) dm), &ctx.rank);CHKERRQ(ierr);
-  ctx.dm     = dm;
-  ctx.viewer = viewer;
+  ctx.dm       = dm;
+  ctx.viewer   = viewer;
+  ctx.sfPoints = sfPoints;
   ierr = PetscViewerHDF5PushGroup(viewer, "/labels");CHKERRQ(ierr);
   ierr = PetscViewerHDF5OpenGroup(viewer, &fileId, &groupId);CHKERRQ(ierr);
   PetscStackCallHDF5(H5Literate,(groupId, H5_INDEX_NAME, H5_ITER_NATIVE, &idx, ReadLabelHDF5_Static, &ctx));
@@ -800,8 +807,98 @@ PetscErrorCode DMPlexLoadLabels_HDF5_Internal(DM dm, PetscViewer viewer)
   PetscFunctionReturn(0);
 }
 
-/* The first version will read everything onto proc 0, letting the user distribute
-   The next will create a naive partition, and then rebalance after reading
+PetscErrorCode DMPlexLoadLabels_HDF5_Internal(DM dm, PetscViewer viewer)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = DMPlexLoadLabels_HDF5_Static(dm, NULL, viewer);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* Each process reads a contiguous chunk of the points and of the vertex coordinates, and DMPlexCreateFromDAGParallel()
+   assembles a naive partition from them, so that no process ever holds the whole mesh */
+static PetscErrorCode DMPlexLoad_HDF5_Parallel_Static(DM dm, PetscViewer viewer)
+{
+  PetscSF            sfPoints;
+  Vec                coordinates;
+  IS                 orderIS, conesIS, cellsIS, orntsIS;
+  const PetscInt    *order, *cones, *cells, *ornts;
+  const PetscScalar *coords;
+  PetscReal          lengthScale;
+  PetscInt           dim, spatialDim, N, numPoints, numConePoints = 0, numVertices, p;
+  PetscErrorCode     ierr;
+
+  PetscFunctionBegin;
+  /* Read toplogy */
+  ierr = PetscViewerHDF5ReadAttribute(viewer, "/topology/cells", "cell_dim", PETSC_INT, (void *) &dim);CHKERRQ(ierr);
+  ierr = DMSetDimension(dm, dim);CHKERRQ(ierr);
+  ierr = PetscViewerHDF5PushGroup(viewer, "/topology");CHKERRQ(ierr);
+  ierr = ISCreate(PetscObjectComm((PetscObject) dm), &orderIS);CHKERRQ(ierr);
+  ierr = PetscObjectSetName((PetscObject) orderIS, "order");CHKERRQ(ierr);
+  ierr = ISCreate(PetscObjectComm((PetscObject) dm), &conesIS);CHKERRQ(ierr);
+  ierr = PetscObjectSetName((PetscObject) conesIS, "cones");CHKERRQ(ierr);
+  ierr = ISCreate(PetscObjectComm((PetscObject) dm), &cellsIS);CHKERRQ(ierr);
+  ierr = PetscObjectSetName((PetscObject) cellsIS, "cells");CHKERRQ(ierr);
+  ierr = ISCreate(PetscObjectComm((PetscObject) dm), &orntsIS);CHKERRQ(ierr);
+  ierr = PetscObjectSetName((PetscObject) orntsIS, "orientation");CHKERRQ(ierr);
+  /* The point records are split evenly, and the cone points follow the records */
+  ierr = PetscViewerHDF5ReadSizes(viewer, "order", NULL, &N);CHKERRQ(ierr);
+  ierr = PetscLayoutSetSize(orderIS->map, N);CHKERRQ(ierr);
+  ierr = PetscLayoutSetSize(conesIS->map, N);CHKERRQ(ierr);
+  ierr = ISLoad(orderIS, viewer);CHKERRQ(ierr);
+  ierr = ISLoad(conesIS, viewer);CHKERRQ(ierr);
+  ierr = ISGetLocalSize(conesIS, &numPoints);CHKERRQ(ierr);
+  ierr = ISGetIndices(conesIS, &cones);CHKERRQ(ierr);
+  for (p = 0; p < numPoints; ++p) numConePoints += cones[p];
+  ierr = PetscViewerHDF5ReadSizes(viewer, "cells", NULL, &N);CHKERRQ(ierr);
+  ierr = PetscLayoutSetLocalSize(cellsIS->map, numConePoints);CHKERRQ(ierr);
+  ierr = PetscLayoutSetSize(cellsIS->map, N);CHKERRQ(ierr);
+  ierr = PetscViewerHDF5ReadSizes(viewer, "orientation", NULL, &N);CHKERRQ(ierr);
+  ierr = PetscLayoutSetLocalSize(orntsIS->map, numConePoints);CHKERRQ(ierr);
+  ierr = PetscLayoutSetSize(orntsIS->map, N);CHKERRQ(ierr);
+  ierr = ISLoad(cellsIS, viewer);CHKERRQ(ierr);
+  ierr = ISLoad(orntsIS, viewer);CHKERRQ(ierr);
+  ierr = PetscViewerHDF5PopGroup(viewer);CHKERRQ(ierr);
+  /* Read geometry */
+  ierr = PetscViewerHDF5PushGroup(viewer, "/geometry");CHKERRQ(ierr);
+  ierr = VecCreate(PetscObjectComm((PetscObject) dm), &coordinates);CHKERRQ(ierr);
+  ierr = PetscObjectSetName((PetscObject) coordinates, "vertices");CHKERRQ(ierr);
+  ierr = PetscViewerHDF5ReadSizes(viewer, "vertices", &spatialDim, &N);CHKERRQ(ierr);
+  ierr = VecSetSizes(coordinates, PETSC_DECIDE, N);CHKERRQ(ierr);
+  ierr = VecSetBlockSize(coordinates, spatialDim);CHKERRQ(ierr);
+  ierr = VecLoad(coordinates, viewer);CHKERRQ(ierr);
+  ierr = PetscViewerHDF5PopGroup(viewer);CHKERRQ(ierr);
+  ierr = DMPlexGetScale(dm, PETSC_UNIT_LENGTH, &lengthScale);CHKERRQ(ierr);
+  ierr = VecScale(coordinates, 1.0/lengthScale);CHKERRQ(ierr);
+  ierr = VecGetLocalSize(coordinates, &numVertices);CHKERRQ(ierr);
+  ierr = VecGetBlockSize(coordinates, &spatialDim);CHKERRQ(ierr);
+  numVertices /= spatialDim;
+  /* Create Plex */
+  ierr = DMSetCoordinateDim(dm, spatialDim);CHKERRQ(ierr);
+  ierr = ISGetIndices(orderIS, &order);CHKERRQ(ierr);
+  ierr = ISGetIndices(cellsIS, &cells);CHKERRQ(ierr);
+  ierr = ISGetIndices(orntsIS, &ornts);CHKERRQ(ierr);
+  ierr = VecGetArrayRead(coordinates, &coords);CHKERRQ(ierr);
+  ierr = DMPlexCreateFromDAGParallel(dm, numPoints, order, cones, cells, ornts, numVertices, coords, &sfPoints);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(coordinates, &coords);CHKERRQ(ierr);
+  ierr = ISRestoreIndices(orderIS, &order);CHKERRQ(ierr);
+  ierr = ISRestoreIndices(conesIS, &cones);CHKERRQ(ierr);
+  ierr = ISRestoreIndices(cellsIS, &cells);CHKERRQ(ierr);
+  ierr = ISRestoreIndices(orntsIS, &ornts);CHKERRQ(ierr);
+  ierr = ISDestroy(&orderIS);CHKERRQ(ierr);
+  ierr = ISDestroy(&conesIS);CHKERRQ(ierr);
+  ierr = ISDestroy(&cellsIS);CHKERRQ(ierr);
+  ierr = ISDestroy(&orntsIS);CHKERRQ(ierr);
+  ierr = VecDestroy(&coordinates);CHKERRQ(ierr);
+  /* Read Labels */
+  ierr = DMPlexLoadLabels_HDF5_Static(dm, sfPoints, viewer);CHKERRQ(ierr);
+  ierr = PetscSFDestroy(&sfPoints);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* By default, everything is read onto proc 0, letting the user distribute
+   With -dm_plex_hdf5_parallel_load, each process reads a chunk and we create a naive partition, which the user then rebalances with DMPlexDistribute()
 */
 PetscErrorCode DMPlexLoad_HDF5_Internal(DM dm, PetscViewer viewer)
 {
@@ -813,9 +910,15 @@ PetscErrorCode DMPlexLoad_HDF5_Internal(DM dm, PetscViewer viewer)
   PetscInt       *cone, *ornt;
   PetscInt        dim, spatialDim, N, numVertices, vStart, vEnd, v, pEnd, p, q, maxConeSize = 0, c;
   PetscMPIInt     rank;
+  PetscBool       parallel = PETSC_FALSE;
   PetscErrorCode  ierr;
 
   PetscFunctionBegin;
+  ierr = PetscOptionsGetBool(((PetscObject) dm)->options, ((PetscObject) dm)->prefix, "-dm_plex_hdf5_parallel_load", &parallel, NULL);CHKERRQ(ierr);
+  if (parallel) {
+    ierr = DMPlexLoad_HDF5_Parallel_Static(dm, viewer);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
   ierr = MPI_Comm_rank(PetscObjectComm((PetscObject) dm), &rank);CHKERRQ(ierr);
   /* Read toplogy */
   ierr = PetscViewerHDF5ReadAttribute(viewer, "/topology/cells", "cell_dim", PETSC_INT, (void *) &dim);CHKERRQ(ierr);
@@ -71,3 +71,216 @@ PetscErrorCode DMPlexCreateClosureIndex(DM dm, PetscSection section)
   ierr = PetscSectionSetClosureIndex(section, (PetscObject) dm, closureSection, closureIS);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
+
+static PetscErrorCode PetscContainerUserDestroy_DMPlexClosureIndexCache(void *ctx)
+{
+  DMPlexClosureIndexCache *cache = (DMPlexClosureIndexCache *) ctx;
+  PetscErrorCode           ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscFree(cache->off);CHKERRQ(ierr);
+  ierr = PetscFree(cache->lidx);CHKERRQ(ierr);
+  ierr = PetscFree(cache->gidx);CHKERRQ(ierr);
+  ierr = PetscFree(cache);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* Record the local index of each closure dof at the position where DMPlexVecGetClosure() puts its value */
+static PetscErrorCode DMPlexClosureIndexCacheSetPoint_Private(PetscInt dof, PetscInt off, PetscInt cdof, const PetscInt cdofs[], const PetscInt perm[], PetscBool reverse, const PetscInt clperm[], PetscInt offset, PetscInt lidx[])
+{
+  PetscInt cind = 0, k;
+
+  PetscFunctionBegin;
+  for (k = 0; k < dof; ++k) {
+    PetscInt j = reverse ? offset + dof-k-1 : offset + (perm ? perm[k] : k);
+
+    if (clperm) j = clperm[j];
+    if ((cind < cdof) && (k == cdofs[cind])) {lidx[j] = -(off+k+1); ++cind;}
+    else                                     {lidx[j] = off+k;}
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode DMPlexClosureIndexCacheSetUpLocal_Private(DM dm, PetscSection section, DMPlexClosureIndexCache *cache)
+{
+  const PetscInt *clperm;
+  PetscInt        depth, Nf, pStart, pEnd, clSize, c;
+  PetscErrorCode  ierr;
+
+  PetscFunctionBegin;
+  ierr = DMPlexGetDepth(dm, &depth);CHKERRQ(ierr);
+  ierr = PetscSectionGetNumFields(section, &Nf);CHKERRQ(ierr);
+  ierr = PetscSectionGetChart(section, &pStart, &pEnd);CHKERRQ(ierr);
+  ierr = PetscSectionGetClosureInversePermutation_Internal(section, (PetscObject) dm, &clSize, &clperm);CHKERRQ(ierr);
+  ierr = DMPlexGetHeightStratum(dm, 0, &cache->cStart, &cache->cEnd);CHKERRQ(ierr);
+  cache->depth1 = depth == 1 && Nf < 2 ? PETSC_TRUE : PETSC_FALSE;
+  cache->lvalid = PETSC_TRUE;
+  ierr = PetscMalloc1(cache->cEnd-cache->cStart+1, &cache->off);CHKERRQ(ierr);
+  cache->off[0] = 0;
+  for (c = cache->cStart; c < cache->cEnd; ++c) {
+    PetscInt *points = NULL, numPoints, p, dof, n = 0;
+
+    ierr = DMPlexGetTransitiveClosure(dm, c, PETSC_TRUE, &numPoints, &points);CHKERRQ(ierr);
+    for (p = 0; p < numPoints*2; p += 2) {
+      if ((points[p] < pStart) || (points[p] >= pEnd)) continue;
+      ierr = PetscSectionGetDof(section, points[p], &dof);CHKERRQ(ierr);
+      n   += dof;
+    }
+    ierr = DMPlexRestoreTransitiveClosure(dm, c, PETSC_TRUE, &numPoints, &points);CHKERRQ(ierr);
+    if (clperm && !cache->depth1 && n != clSize) cache->lvalid = PETSC_FALSE;
+    cache->off[c-cache->cStart+1] = cache->off[c-cache->cStart] + n;
+  }
+  ierr = PetscMalloc1(cache->off[cache->cEnd-cache->cStart], &cache->lidx);CHKERRQ(ierr);
+  for (c = cache->cStart; cache->lvalid && c < cache->cEnd; ++c) {
+    PetscInt *lidx = &cache->lidx[cache->off[c-cache->cStart]];
+
+    if (cache->depth1) {
+      /* Matches DMPlexVecGetClosure_Depth1_Static(): the cell, then its cone reversed on negative orientation */
+      const PetscInt *cone, *coneO, *cdofs;
+      PetscInt        coneSize, p, offset = 0;
+
+      ierr = DMPlexGetConeSize(dm, c, &coneSize);CHKERRQ(ierr);
+      ierr = DMPlexGetCone(dm, c, &cone);CHKERRQ(ierr);
+      ierr = DMPlexGetConeOrientation(dm, c, &coneO);CHKERRQ(ierr);
+      for (p = 0; p <= coneSize; ++p) {
+        const PetscInt cp = !p ? c : cone[p-1];
+        const PetscInt o  = !p ? 0 : coneO[p-1];
+        PetscInt       dof, off, cdof;
+
+        if ((cp < pStart) || (cp >= pEnd)) continue;
+        ierr = PetscSectionGetDof(section, cp, &dof);CHKERRQ(ierr);
+        ierr = PetscSectionGetOffset(section, cp, &off);CHKERRQ(ierr);
+        ierr = PetscSectionGetConstraintDof(section, cp, &cdof);CHKERRQ(ierr);
+        ierr = PetscSectionGetConstraintIndices(section, cp, &cdofs);CHKERRQ(ierr);
+        ierr = DMPlexClosureIndexCacheSetPoint_Private(dof, off, cdof, cdofs, NULL, o < 0 ? PETSC_TRUE : PETSC_FALSE, NULL, offset, lidx);CHKERRQ(ierr);
+        offset += dof;
+      }
+    } else {
+      PetscInt *points = NULL, numPoints, p, q, f, offset = 0;
+
+      ierr = DMPlexGetTransitiveClosure(dm, c, PETSC_TRUE, &numPoints, &points);CHKERRQ(ierr);
+      /* Compress out points not in the section, as DMPlexGetCompressedClosure() does */
+      for (p = 0, q = 0; p < numPoints; ++p) {
+        if ((points[p*2] < pStart) || (points[p*2] >= pEnd)) continue;
+        points[q*2]   = points[p*2];
+        points[q*2+1] = points[p*2+1];
+        ++q;
+      }
+      for (f = 0; f < PetscMax(1, Nf); ++f) {
+        const PetscInt    **perms = NULL;
+        const PetscScalar **flips = NULL;
+
+        if (Nf) {ierr = PetscSectionGetFieldPointSyms(section, f, q, points, &perms, &flips);CHKERRQ(ierr);}
+        else    {ierr = PetscSectionGetPointSyms(section, q, points, &perms, &flips);CHKERRQ(ierr);}
+        for (p = 0; p < q; ++p) {
+          const PetscInt  point = points[p*2];
+          const PetscInt *cdofs;
+          PetscInt        dof, off, cdof;
+
+          if (flips && flips[p]) cache->lvalid = PETSC_FALSE;
+          if (Nf) {
+            ierr = PetscSectionGetFieldDof(section, point, f, &dof);CHKERRQ(ierr);
+            ierr = PetscSectionGetFieldOffset(section, point, f, &off);CHKERRQ(ierr);
+            ierr = PetscSectionGetFieldConstraintDof(section, point, f, &cdof);CHKERRQ(ierr);
+            ierr = PetscSectionGetFieldConstraintIndices(section, point, f, &cdofs);CHKERRQ(ierr);
+          } else {
+            ierr = PetscSectionGetDof(section, point, &dof);CHKERRQ(ierr);
+            ierr = PetscSectionGetOffset(section, point, &off);CHKERRQ(ierr);
+            ierr = PetscSectionGetConstraintDof(section, point, &cdof);CHKERRQ(ierr);
+            ierr = PetscSectionGetConstraintIndices(section, point, &cdofs);CHKERRQ(ierr);
+          }
+          ierr = DMPlexClosureIndexCacheSetPoint_Private(dof, off, cdof, cdofs, perms ? perms[p] : NULL, PETSC_FALSE, clperm, offset, lidx);CHKERRQ(ierr);
+          offset += dof;
+        }
+        if (Nf) {ierr = PetscSectionRestoreFieldPointSyms(section, f, q, points, &perms, &flips);CHKERRQ(ierr);}
+        else    {ierr = PetscSectionRestorePointSyms(section, q, points, &perms, &flips);CHKERRQ(ierr);}
+      }
+      ierr = DMPlexRestoreTransitiveClosure(dm, c, PETSC_TRUE, &numPoints, &points);CHKERRQ(ierr);
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode DMPlexClosureIndexCacheSetUpGlobal_Private(DM dm, PetscSection section, PetscSection globalSection, DMPlexClosureIndexCache *cache)
+{
+  PetscSection   anchorSection;
+  PetscInt       c;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscFree(cache->gidx);CHKERRQ(ierr);
+  ierr = PetscObjectGetId((PetscObject) globalSection, &cache->gsId);CHKERRQ(ierr);
+  ierr = PetscObjectStateGet((PetscObject) globalSection, &cache->gstate);CHKERRQ(ierr);
+  /* Anchors change the closure size and sign flips change the element matrix, so those go through DMPlexMatSetClosure() */
+  ierr = DMPlexGetAnchors(dm, &anchorSection, NULL);CHKERRQ(ierr);
+  cache->gvalid = cache->lvalid && !anchorSection ? PETSC_TRUE : PETSC_FALSE;
+  if (!cache->gvalid) PetscFunctionReturn(0);
+  ierr = PetscMalloc1(cache->off[cache->cEnd-cache->cStart], &cache->gidx);CHKERRQ(ierr);
+  for (c = cache->cStart; cache->gvalid && c < cache->cEnd; ++c) {
+    PetscInt *indices = NULL, numIndices;
+
+    ierr = DMPlexGetClosureIndices(dm, section, globalSection, c, &numIndices, &indices, NULL);CHKERRQ(ierr);
+    if (numIndices == cache->off[c-cache->cStart+1] - cache->off[c-cache->cStart]) {
+      ierr = PetscMemcpy(&cache->gidx[cache->off[c-cache->cStart]], indices, numIndices * sizeof(PetscInt));CHKERRQ(ierr);
+    } else cache->gvalid = PETSC_FALSE;
+    ierr = DMPlexRestoreClosureIndices(dm, section, globalSection, c, &numIndices, &indices, NULL);CHKERRQ(ierr);
+  }
+  if (!cache->gvalid) {ierr = PetscFree(cache->gidx);CHKERRQ(ierr);}
+  PetscFunctionReturn(0);
+}
+
+/*
+  DMPlexGetClosureIndexCache_Internal - Get the closure indices of all cells for the given sections, building them if the
+  DM or the sections have changed since they were last computed
+
+  Input Parameters:
++ dm            - The DM
+. section       - The local section
+- globalSection - The global section, or NULL if only local indices are needed
+
+  Output Parameter:
+. cache - The cache, which is owned by the section
+
+  Note: The local indices of cell c are lidx[off[c-cStart]] to lidx[off[c-cStart+1]], in the order of DMPlexVecGetClosure(),
+  with constrained dofs encoded as -(idx+1). The global indices in gidx follow DMPlexGetClosureIndices(). If lvalid or gvalid
+  is false, the closure cannot be represented by a plain gather and the caller must use the general path.
+*/
+PetscErrorCode DMPlexGetClosureIndexCache_Internal(DM dm, PetscSection section, PetscSection globalSection, DMPlexClosureIndexCache **cache)
+{
+  PetscContainer   container;
+  PetscObjectId    dmId;
+  PetscObjectState state;
+  PetscErrorCode   ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectGetId((PetscObject) dm, &dmId);CHKERRQ(ierr);
+  ierr = PetscObjectStateGet((PetscObject) section, &state);CHKERRQ(ierr);
+  ierr = PetscObjectQuery((PetscObject) section, "DMPlexClosureIndexCache", (PetscObject *) &container);CHKERRQ(ierr);
+  if (container) {
+    ierr = PetscContainerGetPointer(container, (void **) cache);CHKERRQ(ierr);
+    if (((*cache)->dmId != dmId) || ((*cache)->state != state)) container = NULL;
+  }
+  if (!container) {
+    ierr = PetscNew(cache);CHKERRQ(ierr);
+    (*cache)->dmId  = dmId;
+    (*cache)->state = state;
+    ierr = DMPlexClosureIndexCacheSetUpLocal_Private(dm, section, *cache);CHKERRQ(ierr);
+    ierr = PetscInfo3(dm, "Built closure index cache for %D cells with %D indices%s\n", (*cache)->cEnd-(*cache)->cStart, (*cache)->off[(*cache)->cEnd-(*cache)->cStart], (*cache)->lvalid ? "" : ", which cannot be used");CHKERRQ(ierr);
+    ierr = PetscContainerCreate(PETSC_COMM_SELF, &container);CHKERRQ(ierr);
+    ierr = PetscContainerSetPointer(container, (void *) *cache);CHKERRQ(ierr);
+    ierr = PetscContainerSetUserDestroy(container, PetscContainerUserDestroy_DMPlexClosureIndexCache);CHKERRQ(ierr);
+    ierr = PetscObjectCompose((PetscObject) section, "DMPlexClosureIndexCache", (PetscObject) container);CHKERRQ(ierr);
+    ierr = PetscContainerDestroy(&container);CHKERRQ(ierr);
+  }
+  if (globalSection) {
+    PetscObjectId    gsId;
+    PetscObjectState gstate;
+
+    ierr = PetscObjectGetId((PetscObject) globalSection, &gsId);CHKERRQ(ierr);
+    ierr = PetscObjectStateGet((PetscObject) globalSection, &gstate);CHKERRQ(ierr);
+    if (((*cache)->gsId != gsId) || ((*cache)->gstate != gstate)) {
+      ierr = DMPlexClosureIndexCacheSetUpGlobal_Private(dm, section, globalSection, *cache);CHKERRQ(ierr);
+    }
+  }
+  PetscFunctionReturn(0);
+}
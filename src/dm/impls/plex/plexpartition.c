@@ -42,7 +42,8 @@ const char ParMetisPartitionerCitation[] = "@article{KarypisKumar98,\n"
 
   The user can control the definition of adjacency for the mesh using DMPlexGetAdjacencyUseCone() and
   DMPlexSetAdjacencyUseClosure(). They should choose the combination appropriate for the function
-  representation on the mesh.
+  representation on the mesh. For an interpolated parallel mesh, the cells on other processes that share a face with a
+  local cell are included in the adjacency.
 
   Level: developer
 
@@ -50,8 +51,8 @@ const char ParMetisPartitionerCitation[] = "@article{KarypisKumar98,\n"
 @*/
 PetscErrorCode DMPlexCreatePartitionerGraph(DM dm, PetscInt height, PetscInt *numVertices, PetscInt **offsets, PetscInt **adjacency, IS *globalNumbering)
 {
-  PetscInt       p, pStart, pEnd, a, adjSize, idx, size, nroots;
-  PetscInt      *adj = NULL, *vOffsets = NULL, *graph = NULL;
+  PetscInt       p, pStart, pEnd, a, adjSize, idx, size, nroots, depth, dim;
+  PetscInt      *adj = NULL, *vOffsets = NULL, *graph = NULL, *adjCells = NULL, *remoteCells = NULL;
   IS             cellNumbering;
   const PetscInt *cellNum;
   PetscBool      useCone, useClosure;
@@ -81,9 +82,46 @@ PetscErrorCode DMPlexCreatePartitionerGraph(DM dm, PetscInt height, PetscInt *nu
     *globalNumbering = cellNumbering;
   }
   ierr = ISGetIndices(cellNumbering, &cellNum);CHKERRQ(ierr);
+  /* In parallel, the neighbors across the faces shared with other processes are exchanged through the point SF */
+  ierr = DMPlexGetDepth(dm, &depth);CHKERRQ(ierr);
+  ierr = DMGetDimension(dm, &dim);CHKERRQ(ierr);
+  if (nroots >= 0 && depth == dim) {
+    const PetscInt *support;
+    PetscInt        fStart, fEnd, f, supportSize;
+
+    ierr = PetscMalloc2(nroots, &adjCells, nroots, &remoteCells);CHKERRQ(ierr);
+    for (f = 0; f < nroots; ++f) {adjCells[f] = -3; remoteCells[f] = -1;}
+    ierr = DMPlexGetHeightStratum(dm, height+1, &fStart, &fEnd);CHKERRQ(ierr);
+    for (f = fStart; f < fEnd; ++f) {
+      ierr = DMPlexGetSupportSize(dm, f, &supportSize);CHKERRQ(ierr);
+      if (supportSize != 1) continue;
+      ierr = DMPlexGetSupport(dm, f, &support);CHKERRQ(ierr);
+      adjCells[f] = cellNum[support[0]] < 0 ? -(cellNum[support[0]]+1) : cellNum[support[0]];
+    }
+    /* the roots receive the cell of a leaf and the leaves the cell of their root */
+    ierr = PetscSFReduceBegin(sfPoint, MPIU_INT, adjCells, remoteCells, MPI_MAX);CHKERRQ(ierr);
+    ierr = PetscSFReduceEnd(sfPoint, MPIU_INT, adjCells, remoteCells, MPI_MAX);CHKERRQ(ierr);
+    ierr = PetscSFBcastBegin(sfPoint, MPIU_INT, adjCells, remoteCells);CHKERRQ(ierr);
+    ierr = PetscSFBcastEnd(sfPoint, MPIU_INT, adjCells, remoteCells);CHKERRQ(ierr);
+  }
   for (*numVertices = 0, p = pStart; p < pEnd; p++) {
     /* Skip non-owned cells in parallel (ParMetis expects no overlap) */
     if (nroots > 0) {if (cellNum[p] < 0) continue;}
+    if (remoteCells) {
+      const PetscInt *cone;
+      PetscInt        coneSize, c;
+
+      ierr = DMPlexGetConeSize(dm, p, &coneSize);CHKERRQ(ierr);
+      ierr = DMPlexGetCone(dm, p, &cone);CHKERRQ(ierr);
+      for (c = 0; c < coneSize; ++c) {
+        if (remoteCells[cone[c]] >= 0) {
+          PetscInt *PETSC_RESTRICT pBuf;
+          ierr = PetscSectionAddDof(section, p, 1);CHKERRQ(ierr);
+          ierr = PetscSegBufferGetInts(adjBuffer, 1, &pBuf);CHKERRQ(ierr);
+          *pBuf = remoteCells[cone[c]];
+        }
+      }
+    }
     adjSize = PETSC_DETERMINE;
     ierr = DMPlexGetAdjacency(dm, p, &adjSize, &adj);CHKERRQ(ierr);
     for (a = 0; a < adjSize; ++a) {
@@ -92,7 +130,7 @@ PetscErrorCode DMPlexCreatePartitionerGraph(DM dm, PetscInt height, PetscInt *nu
         PetscInt *PETSC_RESTRICT pBuf;
         ierr = PetscSectionAddDof(section, p, 1);CHKERRQ(ierr);
         ierr = PetscSegBufferGetInts(adjBuffer, 1, &pBuf);CHKERRQ(ierr);
-        *pBuf = point;
+        *pBuf = cellNum[point] < 0 ? -(cellNum[point]+1) : cellNum[point];
       }
     }
     (*numVertices)++;
@@ -109,24 +147,13 @@ PetscErrorCode DMPlexCreatePartitionerGraph(DM dm, PetscInt height, PetscInt *nu
   }
   vOffsets[*numVertices] = size;
   if (offsets) *offsets = vOffsets;
+  /* The graph uses the positive global cell numbers */
   ierr = PetscSegBufferExtractAlloc(adjBuffer, &graph);CHKERRQ(ierr);
-  {
-    ISLocalToGlobalMapping ltogCells;
-    PetscInt n, size, *cells_arr;
-    /* In parallel, apply a global cell numbering to the graph */
-    ierr = ISRestoreIndices(cellNumbering, &cellNum);CHKERRQ(ierr);
-    ierr = ISLocalToGlobalMappingCreateIS(cellNumbering, &ltogCells);CHKERRQ(ierr);
-    ierr = ISLocalToGlobalMappingGetSize(ltogCells, &size);CHKERRQ(ierr);
-    ierr = ISLocalToGlobalMappingGetIndices(ltogCells, (const PetscInt**)&cells_arr);CHKERRQ(ierr);
-    /* Convert to positive global cell numbers */
-    for (n=0; n<size; n++) {if (cells_arr[n] < 0) cells_arr[n] = -(cells_arr[n]+1);}
-    ierr = ISLocalToGlobalMappingRestoreIndices(ltogCells, (const PetscInt**)&cells_arr);CHKERRQ(ierr);
-    ierr = ISLocalToGlobalMappingApplyBlock(ltogCells, vOffsets[*numVertices], graph, graph);CHKERRQ(ierr);
-    ierr = ISLocalToGlobalMappingDestroy(&ltogCells);CHKERRQ(ierr);
-    ierr = ISDestroy(&cellNumbering);CHKERRQ(ierr);
-  }
+  ierr = ISRestoreIndices(cellNumbering, &cellNum);CHKERRQ(ierr);
+  ierr = ISDestroy(&cellNumbering);CHKERRQ(ierr);
   if (adjacency) *adjacency = graph;
   /* Clean up */
+  ierr = PetscFree2(adjCells, remoteCells);CHKERRQ(ierr);
   ierr = PetscSegBufferDestroy(&adjBuffer);CHKERRQ(ierr);
   ierr = PetscSectionDestroy(&section);CHKERRQ(ierr);
   ierr = PetscFree(adj);CHKERRQ(ierr);
@@ -691,6 +718,16 @@ PetscErrorCode PetscPartitionerPartition(PetscPartitioner part, DM dm, PetscSect
       ierr = ISDestroy(partition);CHKERRQ(ierr);
       *partition = newPartition;
     }
+    if (PetscLogPrintInfo) {
+      PetscMPIInt rank;
+      PetscInt    nstay, nlocal;
+
+      /* the migration caused by distributing the mesh with this partition */
+      ierr = MPI_Comm_rank(PetscObjectComm((PetscObject) part), &rank);CHKERRQ(ierr);
+      ierr = PetscSectionGetDof(partSection, rank, &nstay);CHKERRQ(ierr);
+      ierr = ISGetLocalSize(*partition, &nlocal);CHKERRQ(ierr);
+      ierr = PetscInfo2(part, "%D cells stay on this process and %D cells migrate\n", nstay, nlocal-nstay);CHKERRQ(ierr);
+    }
   } else SETERRQ1(PetscObjectComm((PetscObject) part), PETSC_ERR_ARG_OUTOFRANGE, "Invalid height %D for points to partition", part->height);
   PetscFunctionReturn(0);
 
@@ -0,0 +1,857 @@
+#include <petsc/private/dmpleximpl.h>   /*I      "petscdmplex.h"   I*/
+#include <petscsf.h>
+
+/*
+  Implicit regular refinement
+
+  Regular refinement replaces each point of depth dp by numChildren[dp][d] new points of depth d, for d <= dp. As in
+  DMRefine(), the new points are numbered by stratum in the order cells, vertices, faces, and edges, and inside a stratum
+  in blocks by the depth of the parent, so that child k of depth d of the point q of depth dq is
+
+    start[d] + sum_{dp < dq} n[dp] numChildren[dp][d] + (q - qStart[dq]) numChildren[dq][d] + k
+
+  where n[dp] is the number of parent points of depth dp. The cone of a child is given by a table in terms of children of
+  the parent and of the points in the cone of the parent, so that the topology after any number of refinements can be
+  computed from the coarse mesh alone, one point at a time.
+*/
+
+/* The way the orientation of a parent cone point changes the number of its child */
+typedef enum {CHILD_FIXED, CHILD_SEGMENT, CHILD_QUAD_SUBFACE, CHILD_QUAD_EDGE} ChildTransform;
+
+/* A point in the cone of a child: child r of the parent if c < 0, and otherwise of the point c in the cone of the parent.
+   Children of segments and of quadrilateral subfaces take the orientation of that cone point, all others take o. */
+typedef struct {
+  PetscInt       c;
+  ChildTransform t;
+  PetscInt       r;
+  PetscInt       o;
+} ChildConePoint;
+
+typedef struct {
+  CellRefiner           refiner;
+  PetscInt              depth;
+  PetscInt              numChildren[4][4]; /* numChildren[dp][d] is the number of children of depth d of a point of depth dp */
+  PetscInt              coneSize[4];       /* The cone size of a child of depth d */
+  const ChildConePoint *cones[4][4];       /* The cones of the numChildren[dp][d] children of depth d, one after the other */
+} RefinementRule;
+
+struct _n_DMPlexImplicitRefinement {
+  DM                    dm;          /* The coarse mesh */
+  const RefinementRule *rule;
+  PetscInt              numLevels;   /* The number of refinements */
+  PetscInt              depth;
+  PetscInt              maxConeSize;
+  PetscInt             *start, *end; /* start[l*(depth+1)+d] is the first point of depth d on level l */
+  PetscInt             *block;       /* block[(l*(depth+1)+dp)*(depth+1)+d] is the first child of depth d of the points of depth dp on level l */
+  PetscInt             *cone, *ornt; /* Work space for the parent cones, maxConeSize for each level */
+};
+
+/* Split segment: the children are the halves touching cone[0] and cone[1] */
+static const ChildConePoint segmentCones[] = {
+  {0, CHILD_FIXED, 0, 0}, {-1, CHILD_FIXED, 0, 0},
+  {-1, CHILD_FIXED, 0, 0}, {1, CHILD_FIXED, 0, 0}};
+
+/* Triangle: the interior edges join the midpoints of the edges, and cell D is the middle cell */
+static const ChildConePoint triEdgeCones[] = {
+  {0, CHILD_FIXED, 0, 0}, {1, CHILD_FIXED, 0, 0},
+  {1, CHILD_FIXED, 0, 0}, {2, CHILD_FIXED, 0, 0},
+  {2, CHILD_FIXED, 0, 0}, {0, CHILD_FIXED, 0, 0}};
+static const ChildConePoint triCellCones[] = {
+  {0, CHILD_SEGMENT, 0, 0}, {-1, CHILD_FIXED, 2, -2}, {2, CHILD_SEGMENT, 1, 0},
+  {0, CHILD_SEGMENT, 1, 0}, {1, CHILD_SEGMENT, 0, 0}, {-1, CHILD_FIXED, 0, -2},
+  {-1, CHILD_FIXED, 1, -2}, {1, CHILD_SEGMENT, 1, 0}, {2, CHILD_SEGMENT, 0, 0},
+  {-1, CHILD_FIXED, 0, 0}, {-1, CHILD_FIXED, 1, 0}, {-1, CHILD_FIXED, 2, 0}};
+
+/* Quadrilateral: the interior edges join the cell vertex to the edge midpoints */
+static const ChildConePoint quadEdgeCones[] = {
+  {0, CHILD_FIXED, 0, 0}, {-1, CHILD_FIXED, 0, 0},
+  {-1, CHILD_FIXED, 0, 0}, {1, CHILD_FIXED, 0, 0},
+  {-1, CHILD_FIXED, 0, 0}, {2, CHILD_FIXED, 0, 0},
+  {3, CHILD_FIXED, 0, 0}, {-1, CHILD_FIXED, 0, 0}};
+static const ChildConePoint quadCellCones[] = {
+  {0, CHILD_SEGMENT, 0, 0}, {-1, CHILD_FIXED, 0, 0}, {-1, CHILD_FIXED, 3, -2}, {3, CHILD_SEGMENT, 1, 0},
+  {0, CHILD_SEGMENT, 1, 0}, {1, CHILD_SEGMENT, 0, 0}, {-1, CHILD_FIXED, 1, -2}, {-1, CHILD_FIXED, 0, -2},
+  {-1, CHILD_FIXED, 1, 0}, {1, CHILD_SEGMENT, 1, 0}, {2, CHILD_SEGMENT, 0, 0}, {-1, CHILD_FIXED, 2, -2},
+  {-1, CHILD_FIXED, 3, 0}, {-1, CHILD_FIXED, 2, 0}, {2, CHILD_SEGMENT, 1, 0}, {3, CHILD_SEGMENT, 0, 0}};
+
+/* Hexahedron: the quadrilateral faces split as above, but with the orientations of a face in a hexahedron */
+static const ChildConePoint hexFaceEdgeCones[] = {
+  {0, CHILD_FIXED, 0, 0}, {-1, CHILD_FIXED, 0, 0},
+  {1, CHILD_FIXED, 0, 0}, {-1, CHILD_FIXED, 0, 0},
+  {2, CHILD_FIXED, 0, 0}, {-1, CHILD_FIXED, 0, 0},
+  {3, CHILD_FIXED, 0, 0}, {-1, CHILD_FIXED, 0, 0}};
+static const ChildConePoint hexFaceCones[] = {
+  {0, CHILD_SEGMENT, 0, 0}, {-1, CHILD_FIXED, 0, 0}, {-1, CHILD_FIXED, 3, -2}, {3, CHILD_SEGMENT, 1, 0},
+  {0, CHILD_SEGMENT, 1, 0}, {1, CHILD_SEGMENT, 0, 0}, {-1, CHILD_FIXED, 1, 0}, {-1, CHILD_FIXED, 0, -2},
+  {-1, CHILD_FIXED, 1, -2}, {1, CHILD_SEGMENT, 1, 0}, {2, CHILD_SEGMENT, 0, 0}, {-1, CHILD_FIXED, 2, 0},
+  {-1, CHILD_FIXED, 3, 0}, {-1, CHILD_FIXED, 2, -2}, {2, CHILD_SEGMENT, 1, 0}, {3, CHILD_SEGMENT, 0, 0}};
+/* The interior edges join the cell vertex to the face vertices */
+static const ChildConePoint hexEdgeCones[] = {
+  {0, CHILD_FIXED, 0, 0}, {-1, CHILD_FIXED, 0, 0},
+  {1, CHILD_FIXED, 0, 0}, {-1, CHILD_FIXED, 0, 0},
+  {2, CHILD_FIXED, 0, 0}, {-1, CHILD_FIXED, 0, 0},
+  {3, CHILD_FIXED, 0, 0}, {-1, CHILD_FIXED, 0, 0},
+  {4, CHILD_FIXED, 0, 0}, {-1, CHILD_FIXED, 0, 0},
+  {5, CHILD_FIXED, 0, 0}, {-1, CHILD_FIXED, 0, 0}};
+static const ChildConePoint hexInteriorFaceCones[] = {
+  {0, CHILD_QUAD_EDGE, 3, 0}, {-1, CHILD_FIXED, 0, 0}, {-1, CHILD_FIXED, 2, -2}, {2, CHILD_QUAD_EDGE, 0, -2},
+  {0, CHILD_QUAD_EDGE, 2, 0}, {-1, CHILD_FIXED, 0, 0}, {-1, CHILD_FIXED, 4, -2}, {4, CHILD_QUAD_EDGE, 0, -2},
+  {0, CHILD_QUAD_EDGE, 1, -2}, {3, CHILD_QUAD_EDGE, 0, 0}, {-1, CHILD_FIXED, 3, 0}, {-1, CHILD_FIXED, 0, -2},
+  {0, CHILD_QUAD_EDGE, 0, -2}, {5, CHILD_QUAD_EDGE, 3, 0}, {-1, CHILD_FIXED, 5, 0}, {-1, CHILD_FIXED, 0, -2},
+  {-1, CHILD_FIXED, 2, -2}, {2, CHILD_QUAD_EDGE, 2, -2}, {1, CHILD_QUAD_EDGE, 0, 0}, {-1, CHILD_FIXED, 1, 0},
+  {-1, CHILD_FIXED, 4, -2}, {4, CHILD_QUAD_EDGE, 2, -2}, {1, CHILD_QUAD_EDGE, 1, 0}, {-1, CHILD_FIXED, 1, 0},
+  {3, CHILD_QUAD_EDGE, 2, -2}, {1, CHILD_QUAD_EDGE, 2, 0}, {-1, CHILD_FIXED, 1, 0}, {-1, CHILD_FIXED, 3, -2},
+  {-1, CHILD_FIXED, 5, -2}, {5, CHILD_QUAD_EDGE, 1, -2}, {1, CHILD_QUAD_EDGE, 3, 0}, {-1, CHILD_FIXED, 1, 0},
+  {2, CHILD_QUAD_EDGE, 3, 0}, {-1, CHILD_FIXED, 2, 0}, {-1, CHILD_FIXED, 5, -2}, {5, CHILD_QUAD_EDGE, 0, -2},
+  {2, CHILD_QUAD_EDGE, 1, -2}, {4, CHILD_QUAD_EDGE, 3, 0}, {-1, CHILD_FIXED, 4, 0}, {-1, CHILD_FIXED, 2, -2},
+  {-1, CHILD_FIXED, 4, -2}, {4, CHILD_QUAD_EDGE, 1, -2}, {3, CHILD_QUAD_EDGE, 3, 0}, {-1, CHILD_FIXED, 3, 0},
+  {-1, CHILD_FIXED, 5, 0}, {-1, CHILD_FIXED, 3, -2}, {3, CHILD_QUAD_EDGE, 1, -2}, {5, CHILD_QUAD_EDGE, 2, 0}};
+static const ChildConePoint hexCellCones[] = {
+  {0, CHILD_QUAD_SUBFACE, 0, 0}, {-1, CHILD_FIXED, 8, 0}, {2, CHILD_QUAD_SUBFACE, 0, 0}, {-1, CHILD_FIXED, 3, 0}, {-1, CHILD_FIXED, 0, 0}, {5, CHILD_QUAD_SUBFACE, 0, 0},
+  {0, CHILD_QUAD_SUBFACE, 1, 0}, {-1, CHILD_FIXED, 11, 0}, {-1, CHILD_FIXED, 3, -1}, {3, CHILD_QUAD_SUBFACE, 1, 0}, {-1, CHILD_FIXED, 2, 0}, {5, CHILD_QUAD_SUBFACE, 3, 0},
+  {0, CHILD_QUAD_SUBFACE, 2, 0}, {-1, CHILD_FIXED, 10, 0}, {-1, CHILD_FIXED, 1, -1}, {3, CHILD_QUAD_SUBFACE, 0, 0}, {4, CHILD_QUAD_SUBFACE, 1, 0}, {-1, CHILD_FIXED, 2, -4},
+  {0, CHILD_QUAD_SUBFACE, 3, 0}, {-1, CHILD_FIXED, 9, 0}, {2, CHILD_QUAD_SUBFACE, 1, 0}, {-1, CHILD_FIXED, 1, 0}, {4, CHILD_QUAD_SUBFACE, 0, 0}, {-1, CHILD_FIXED, 0, -4},
+  {-1, CHILD_FIXED, 8, -4}, {1, CHILD_QUAD_SUBFACE, 0, 0}, {2, CHILD_QUAD_SUBFACE, 3, 0}, {-1, CHILD_FIXED, 7, 0}, {-1, CHILD_FIXED, 4, -1}, {5, CHILD_QUAD_SUBFACE, 1, 0},
+  {-1, CHILD_FIXED, 9, -4}, {1, CHILD_QUAD_SUBFACE, 1, 0}, {2, CHILD_QUAD_SUBFACE, 2, 0}, {-1, CHILD_FIXED, 5, -1}, {4, CHILD_QUAD_SUBFACE, 3, 0}, {-1, CHILD_FIXED, 4, 1},
+  {-1, CHILD_FIXED, 10, -4}, {1, CHILD_QUAD_SUBFACE, 2, 0}, {-1, CHILD_FIXED, 5, 0}, {3, CHILD_QUAD_SUBFACE, 3, 0}, {4, CHILD_QUAD_SUBFACE, 2, 0}, {-1, CHILD_FIXED, 6, -3},
+  {-1, CHILD_FIXED, 11, -4}, {1, CHILD_QUAD_SUBFACE, 3, 0}, {-1, CHILD_FIXED, 7, -1}, {3, CHILD_QUAD_SUBFACE, 2, 0}, {-1, CHILD_FIXED, 6, 3}, {5, CHILD_QUAD_SUBFACE, 2, 0}};
+
+static const RefinementRule refinementRules[] = {
+  {REFINER_SIMPLEX_1D, 1,
+   {{1, 0}, {1, 2}},
+   {0, 2},
+   {{NULL}, {NULL, segmentCones}}},
+  {REFINER_SIMPLEX_2D, 2,
+   {{1, 0, 0}, {1, 2, 0}, {0, 3, 4}},
+   {0, 2, 3},
+   {{NULL}, {NULL, segmentCones}, {NULL, triEdgeCones, triCellCones}}},
+  {REFINER_HEX_2D, 2,
+   {{1, 0, 0}, {1, 2, 0}, {1, 4, 4}},
+   {0, 2, 4},
+   {{NULL}, {NULL, segmentCones}, {NULL, quadEdgeCones, quadCellCones}}},
+  {REFINER_HEX_3D, 3,
+   {{1, 0, 0, 0}, {1, 2, 0, 0}, {1, 4, 4, 0}, {1, 6, 12, 8}},
+   {0, 2, 4, 6},
+   {{NULL}, {NULL, segmentCones}, {NULL, hexFaceEdgeCones, hexFaceCones}, {NULL, hexEdgeCones, hexInteriorFaceCones, hexCellCones}}}};
+
+/* Compute the strata and child blocks on levels 1 to numLevels from the strata on level 0 */
+static PetscErrorCode DMPlexRefinementRuleSetUpLevels_Private(const RefinementRule *rule, PetscInt numLevels, PetscInt start[], PetscInt end[], PetscInt block[])
+{
+  const PetscInt depth = rule->depth, Nd = depth+1;
+  PetscInt       order[4], numOrder = 0, l, d, dp, o;
+
+  PetscFunctionBegin;
+  order[numOrder++] = depth;
+  order[numOrder++] = 0;
+  if (depth > 1) order[numOrder++] = depth-1;
+  if (depth > 2) order[numOrder++] = 1;
+  for (l = 0; l < numLevels; ++l) {
+    PetscInt64 pStart = 0;
+
+    for (o = 0; o < numOrder; ++o) {
+      PetscInt64 off = pStart;
+
+      d = order[o];
+      start[(l+1)*Nd+d] = (PetscInt) pStart;
+      for (dp = 0; dp <= depth; ++dp) {
+        block[(l*Nd+dp)*Nd+d] = (PetscInt) off;
+        off += (PetscInt64) (end[l*Nd+dp] - start[l*Nd+dp])*rule->numChildren[dp][d];
+      }
+      if (off > PETSC_MAX_INT) SETERRQ1(PETSC_COMM_SELF, PETSC_ERR_ARG_OUTOFRANGE, "Refinement level %D has too many points for PetscInt, configure with --with-64-bit-indices", l+1);
+      end[(l+1)*Nd+d] = (PetscInt) off;
+      pStart          = off;
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
+PETSC_STATIC_INLINE PetscInt DMPlexImplicitRefinementGetDepth_Private(PetscInt depth, const PetscInt start[], const PetscInt end[], PetscInt p)
+{
+  PetscInt d;
+
+  for (d = 0; d <= depth; ++d) if ((p >= start[d]) && (p < end[d])) return d;
+  return -1;
+}
+
+/* Return child r of depth d of the point p of depth dp on level l */
+PETSC_STATIC_INLINE PetscInt DMPlexImplicitRefinementGetChild_Private(const RefinementRule *rule, const PetscInt start[], const PetscInt block[], PetscInt l, PetscInt dp, PetscInt p, PetscInt d, PetscInt r)
+{
+  const PetscInt Nd = rule->depth+1;
+
+  return block[(l*Nd+dp)*Nd+d] + (p - start[l*Nd+dp])*rule->numChildren[dp][d] + r;
+}
+
+/* Find the parent q of depth dq on level l-1 of the point p of depth d on level l, and its child number r */
+static PetscErrorCode DMPlexImplicitRefinementGetParent_Private(DMPlexImplicitRefinement ir, PetscInt l, PetscInt p, PetscInt *d, PetscInt *dq, PetscInt *q, PetscInt *r)
+{
+  const RefinementRule *rule = ir->rule;
+  const PetscInt        Nd   = ir->depth+1;
+  PetscInt              dp;
+
+  PetscFunctionBegin;
+  *d = DMPlexImplicitRefinementGetDepth_Private(ir->depth, &ir->start[l*Nd], &ir->end[l*Nd], p);
+  if (*d < 0) SETERRQ2(PETSC_COMM_SELF, PETSC_ERR_ARG_OUTOFRANGE, "Point %D is not in refinement level %D", p, l);
+  for (dp = *d; dp <= ir->depth; ++dp) {
+    const PetscInt n  = rule->numChildren[dp][*d];
+    const PetscInt b  = ir->block[((l-1)*Nd+dp)*Nd+*d];
+
+    if (!n || p >= b + (ir->end[(l-1)*Nd+dp] - ir->start[(l-1)*Nd+dp])*n) continue;
+    *dq = dp;
+    *q  = ir->start[(l-1)*Nd+dp] + (p - b)/n;
+    *r  = (p - b)%n;
+    PetscFunctionReturn(0);
+  }
+  SETERRQ2(PETSC_COMM_SELF, PETSC_ERR_PLIB, "Could not find the parent of point %D on refinement level %D", p, l);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode DMPlexImplicitRefinementGetCone_Private(DMPlexImplicitRefinement ir, PetscInt l, PetscInt p, PetscInt cone[], PetscInt ornt[])
+{
+  const RefinementRule *rule = ir->rule;
+  const ChildConePoint *cp;
+  PetscInt             *pcone, *pornt;
+  PetscInt              d, dq, q, r, coneSize, c;
+  PetscErrorCode        ierr;
+
+  PetscFunctionBegin;
+  if (!l) {
+    const PetscInt *qcone, *qornt;
+
+    ierr = DMPlexGetConeSize(ir->dm, p, &coneSize);CHKERRQ(ierr);
+    ierr = DMPlexGetCone(ir->dm, p, &qcone);CHKERRQ(ierr);
+    ierr = DMPlexGetConeOrientation(ir->dm, p, &qornt);CHKERRQ(ierr);
+    for (c = 0; c < coneSize; ++c) {
+      cone[c] = qcone[c];
+      if (ornt) ornt[c] = qornt[c];
+    }
+    PetscFunctionReturn(0);
+  }
+  ierr = DMPlexImplicitRefinementGetParent_Private(ir, l, p, &d, &dq, &q, &r);CHKERRQ(ierr);
+  coneSize = rule->coneSize[d];
+  if (!coneSize) PetscFunctionReturn(0);
+  pcone = &ir->cone[(l-1)*ir->maxConeSize];
+  pornt = &ir->ornt[(l-1)*ir->maxConeSize];
+  ierr  = DMPlexImplicitRefinementGetCone_Private(ir, l-1, q, pcone, pornt);CHKERRQ(ierr);
+  cp    = &rule->cones[dq][d][r*coneSize];
+  for (c = 0; c < coneSize; ++c) {
+    const PetscInt x  = cp[c].c < 0 ? q  : pcone[cp[c].c];
+    const PetscInt dx = cp[c].c < 0 ? dq : dq-1;
+    const PetscInt o  = cp[c].c < 0 ? 0  : pornt[cp[c].c];
+    PetscInt       s  = cp[c].r, so = cp[c].o;
+
+    switch (cp[c].t) {
+    case CHILD_FIXED: break;
+    case CHILD_SEGMENT:      s = o < 0 ? 1-s : s;               so = o; break;
+    case CHILD_QUAD_SUBFACE: s = (o < 0 ? 4-(o+s) : o+s)%4;     so = o; break;
+    case CHILD_QUAD_EDGE:    s = (o < 0 ? 3-(o+s) : o+s)%4;             break;
+    }
+    cone[c] = DMPlexImplicitRefinementGetChild_Private(rule, ir->start, ir->block, l-1, dx, x, d-1, s);
+    if (ornt) ornt[c] = so;
+  }
+  PetscFunctionReturn(0);
+}
+
+/* Gather the vertices in the closure of the point p on level l, using the last slot of the work space */
+static PetscErrorCode DMPlexImplicitRefinementGetClosureVertices_Private(DMPlexImplicitRefinement ir, PetscInt l, PetscInt p, PetscInt *numVertices, PetscInt vertices[])
+{
+  const PetscInt  Nd = ir->depth+1;
+  const PetscInt *start = &ir->start[l*Nd], *end = &ir->end[l*Nd];
+  PetscInt       *cone = &ir->cone[ir->numLevels*ir->maxConeSize];
+  PetscInt        closure[32], closureSize = 1, i, j, c, coneSize;
+  PetscErrorCode  ierr;
+
+  PetscFunctionBegin;
+  closure[0]   = p;
+  *numVertices = 0;
+  for (i = 0; i < closureSize; ++i) {
+    const PetscInt d = DMPlexImplicitRefinementGetDepth_Private(ir->depth, start, end, closure[i]);
+
+    if (!d) {vertices[(*numVertices)++] = closure[i]; continue;}
+    if (l) coneSize = ir->rule->coneSize[d];
+    else {ierr = DMPlexGetConeSize(ir->dm, closure[i], &coneSize);CHKERRQ(ierr);}
+    ierr = DMPlexImplicitRefinementGetCone_Private(ir, l, closure[i], cone, NULL);CHKERRQ(ierr);
+    for (c = 0; c < coneSize; ++c) {
+      for (j = 0; j < closureSize; ++j) if (closure[j] == cone[c]) break;
+      if (j < closureSize) continue;
+      if (closureSize >= 32) SETERRQ1(PETSC_COMM_SELF, PETSC_ERR_PLIB, "Closure of point %D is too large", p);
+      closure[closureSize++] = cone[c];
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
+/* Return the points on level numLevels coming from the point p of depth dp on level 0, for the given strata */
+static PetscErrorCode DMPlexImplicitRefinementGetDescendants_Private(const RefinementRule *rule, PetscInt numLevels, const PetscInt start[], const PetscInt block[], PetscInt dp, PetscInt p, PetscInt *numPoints, PetscInt points[], PetscInt depths[], PetscInt work[], PetscInt workDepths[])
+{
+  PetscInt n = 1, l, i, d, r;
+
+  PetscFunctionBegin;
+  work[0]       = p;
+  workDepths[0] = dp;
+  for (l = 0; l < numLevels; ++l) {
+    PetscInt m = 0;
+
+    for (i = 0; i < n; ++i) {
+      for (d = 0; d <= workDepths[i]; ++d) {
+        for (r = 0; r < rule->numChildren[workDepths[i]][d]; ++r, ++m) {
+          points[m] = DMPlexImplicitRefinementGetChild_Private(rule, start, block, l, workDepths[i], work[i], d, r);
+          depths[m] = d;
+        }
+      }
+    }
+    for (i = 0; i < m; ++i) {work[i] = points[i]; workDepths[i] = depths[i];}
+    n = m;
+  }
+  *numPoints = n;
+  PetscFunctionReturn(0);
+}
+
+/* The largest number of descendants of a point on level numLevels */
+static PetscInt DMPlexRefinementRuleGetMaxDescendants_Private(const RefinementRule *rule, PetscInt numLevels)
+{
+  PetscInt count[4] = {1, 1, 1, 1}, tmp[4], l, d, dp;
+
+  for (l = 0; l < numLevels; ++l) {
+    for (dp = 0; dp <= rule->depth; ++dp) {
+      tmp[dp] = 0;
+      for (d = 0; d <= dp; ++d) tmp[dp] += rule->numChildren[dp][d]*count[d];
+    }
+    for (dp = 0; dp <= rule->depth; ++dp) count[dp] = tmp[dp];
+  }
+  return count[rule->depth];
+}
+
+/*@
+  DMPlexImplicitRefinementCreate - Create a description of a number of uniform refinements of a mesh, which computes
+  the refined topology from the coarse mesh on demand instead of building the refined meshes
+
+  Not collective
+
+  Input Parameters:
++ dm        - The coarse DMPlex, which must be interpolated
+- numLevels - The number of refinements, at least 1
+
+  Output Parameter:
+. ir - The implicit refinement
+
+  Notes:
+  The refined points are numbered exactly as by repeated DMRefine(), and DMPlexImplicitRefinementGetCone() computes
+  the cone of a refined point from the coarse mesh in a few operations per level, so that the refined topology takes no
+  memory beyond a few integers per level. DMPlexImplicitRefinementCreateDM() builds the finest mesh alone, without the
+  intermediate meshes and temporary arrays of repeated DMRefine(). The coarse mesh must not change while the refinement
+  is in use.
+
+  Segments, triangles, quadrilaterals, and hexahedra are supported. Meshes with hybrid cells, tetrahedra, and
+  simplex to hex refinement are not.
+
+  Level: intermediate
+
+.seealso: DMPlexImplicitRefinementDestroy(), DMPlexImplicitRefinementGetCone(), DMPlexImplicitRefinementCreateDM(), DMRefine()
+@*/
+PetscErrorCode DMPlexImplicitRefinementCreate(DM dm, PetscInt numLevels, DMPlexImplicitRefinement *ir)
+{
+  DMPlexImplicitRefinement r;
+  CellRefiner              refiner;
+  PetscInt                 depth, cMax, fMax, eMax, vMax, maxConeSize, Nd, d, i;
+  PetscErrorCode           ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(dm, DM_CLASSID, 1);
+  PetscValidPointer(ir, 3);
+  if (numLevels < 1) SETERRQ1(PETSC_COMM_SELF, PETSC_ERR_ARG_OUTOFRANGE, "Number of refinements %D must be positive", numLevels);
+  ierr = DMPlexGetDepth(dm, &depth);CHKERRQ(ierr);
+  ierr = DMPlexGetHybridBounds(dm, &cMax, &fMax, &eMax, &vMax);CHKERRQ(ierr);
+  if ((cMax >= 0) || (fMax >= 0) || (eMax >= 0) || (vMax >= 0)) SETERRQ(PETSC_COMM_SELF, PETSC_ERR_SUP, "Implicit refinement does not support hybrid meshes");
+  ierr = DMPlexGetCellRefiner_Internal(dm, &refiner);CHKERRQ(ierr);
+  for (i = 0; i < (PetscInt) (sizeof(refinementRules)/sizeof(refinementRules[0])); ++i) if (refinementRules[i].refiner == refiner) break;
+  if (i == (PetscInt) (sizeof(refinementRules)/sizeof(refinementRules[0]))) SETERRQ1(PETSC_COMM_SELF, PETSC_ERR_SUP, "Implicit refinement does not support cell refiner %d", (int) refiner);
+  if (depth != refinementRules[i].depth) SETERRQ2(PETSC_COMM_SELF, PETSC_ERR_SUP, "Implicit refinement needs an interpolated mesh, depth %D != %D", depth, refinementRules[i].depth);
+  ierr = DMPlexGetMaxSizes(dm, &maxConeSize, NULL);CHKERRQ(ierr);
+  maxConeSize = PetscMax(maxConeSize, refinementRules[i].coneSize[depth]);
+  Nd   = depth+1;
+  ierr = PetscNew(&r);CHKERRQ(ierr);
+  ierr = PetscObjectReference((PetscObject) dm);CHKERRQ(ierr);
+  r->dm          = dm;
+  r->rule        = &refinementRules[i];
+  r->numLevels   = numLevels;
+  r->depth       = depth;
+  r->maxConeSize = maxConeSize;
+  ierr = PetscMalloc5((numLevels+1)*Nd, &r->start, (numLevels+1)*Nd, &r->end, numLevels*Nd*Nd, &r->block, (numLevels+1)*maxConeSize, &r->cone, (numLevels+1)*maxConeSize, &r->ornt);CHKERRQ(ierr);
+  for (d = 0; d <= depth; ++d) {ierr = DMPlexGetDepthStratum(dm, d, &r->start[d], &r->end[d]);CHKERRQ(ierr);}
+  ierr = DMPlexRefinementRuleSetUpLevels_Private(r->rule, numLevels, r->start, r->end, r->block);CHKERRQ(ierr);
+  *ir  = r;
+  PetscFunctionReturn(0);
+}
+
+/*@
+  DMPlexImplicitRefinementDestroy - Destroy an implicit refinement
+
+  Not collective
+
+  Input Parameter:
+. ir - The implicit refinement
+
+  Level: intermediate
+
+.seealso: DMPlexImplicitRefinementCreate()
+@*/
+PetscErrorCode DMPlexImplicitRefinementDestroy(DMPlexImplicitRefinement *ir)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (!*ir) PetscFunctionReturn(0);
+  ierr = DMDestroy(&(*ir)->dm);CHKERRQ(ierr);
+  ierr = PetscFree5((*ir)->start, (*ir)->end, (*ir)->block, (*ir)->cone, (*ir)->ornt);CHKERRQ(ierr);
+  ierr = PetscFree(*ir);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@
+  DMPlexImplicitRefinementGetChart - Return the interval for all points of the refined mesh
+
+  Not collective
+
+  Input Parameter:
+. ir - The implicit refinement
+
+  Output Parameters:
++ pStart - The first mesh point
+- pEnd   - The upper bound for mesh points
+
+  Level: intermediate
+
+.seealso: DMPlexImplicitRefinementCreate(), DMPlexImplicitRefinementGetDepthStratum(), DMPlexGetChart()
+@*/
+PetscErrorCode DMPlexImplicitRefinementGetChart(DMPlexImplicitRefinement ir, PetscInt *pStart, PetscInt *pEnd)
+{
+  const PetscInt *end = &ir->end[ir->numLevels*(ir->depth+1)];
+  PetscInt        d;
+
+  PetscFunctionBegin;
+  PetscValidPointer(ir, 1);
+  if (pStart) *pStart = 0;
+  if (pEnd) {
+    *pEnd = 0;
+    for (d = 0; d <= ir->depth; ++d) *pEnd = PetscMax(*pEnd, end[d]);
+  }
+  PetscFunctionReturn(0);
+}
+
+/*@
+  DMPlexImplicitRefinementGetDepthStratum - Return the interval for the points of a given depth in the refined mesh
+
+  Not collective
+
+  Input Parameters:
++ ir    - The implicit refinement
+- depth - The requested depth
+
+  Output Parameters:
++ start - The first point at this depth
+- end   - One beyond the last point at this depth
+
+  Level: intermediate
+
+.seealso: DMPlexImplicitRefinementCreate(), DMPlexImplicitRefinementGetChart(), DMPlexGetDepthStratum()
+@*/
+PetscErrorCode DMPlexImplicitRefinementGetDepthStratum(DMPlexImplicitRefinement ir, PetscInt depth, PetscInt *start, PetscInt *end)
+{
+  const PetscInt off = ir->numLevels*(ir->depth+1);
+
+  PetscFunctionBegin;
+  PetscValidPointer(ir, 1);
+  if ((depth < 0) || (depth > ir->depth)) SETERRQ2(PETSC_COMM_SELF, PETSC_ERR_ARG_OUTOFRANGE, "Depth %D not in [0, %D]", depth, ir->depth);
+  if (start) *start = ir->start[off+depth];
+  if (end)   *end   = ir->end[off+depth];
+  PetscFunctionReturn(0);
+}
+
+/*@
+  DMPlexImplicitRefinementGetConeSize - Return the number of in-edges for this point of the refined mesh
+
+  Not collective
+
+  Input Parameters:
++ ir - The implicit refinement
+- p  - The point, which must lie in the chart set with DMPlexImplicitRefinementGetChart()
+
+  Output Parameter:
+. size - The cone size for point p
+
+  Level: intermediate
+
+.seealso: DMPlexImplicitRefinementCreate(), DMPlexImplicitRefinementGetCone(), DMPlexGetConeSize()
+@*/
+PetscErrorCode DMPlexImplicitRefinementGetConeSize(DMPlexImplicitRefinement ir, PetscInt p, PetscInt *size)
+{
+  const PetscInt off = ir->numLevels*(ir->depth+1);
+  PetscInt       d;
+
+  PetscFunctionBegin;
+  PetscValidPointer(ir, 1);
+  PetscValidPointer(size, 3);
+  d = DMPlexImplicitRefinementGetDepth_Private(ir->depth, &ir->start[off], &ir->end[off], p);
+  if (d < 0) SETERRQ1(PETSC_COMM_SELF, PETSC_ERR_ARG_OUTOFRANGE, "Point %D is not in the refined mesh", p);
+  *size = ir->rule->coneSize[d];
+  PetscFunctionReturn(0);
+}
+
+/*@
+  DMPlexImplicitRefinementGetCone - Compute the points and orientations on the in-edges for this point of the refined mesh
+
+  Not collective
+
+  Input Parameters:
++ ir - The implicit refinement
+- p  - The point, which must lie in the chart set with DMPlexImplicitRefinementGetChart()
+
+  Output Parameters:
++ cone - An array of length given by DMPlexImplicitRefinementGetConeSize(), to hold the cone points
+- ornt - An array of the same length to hold the cone orientations, or NULL
+
+  Note:
+  The cone is computed from the coarse mesh, at a cost proportional to the number of refinements. It is the same as the
+  cone of p in the mesh produced by repeated DMRefine().
+
+  Level: intermediate
+
+.seealso: DMPlexImplicitRefinementCreate(), DMPlexImplicitRefinementGetConeSize(), DMPlexGetCone(), DMPlexGetConeOrientation()
+@*/
+PetscErrorCode DMPlexImplicitRefinementGetCone(DMPlexImplicitRefinement ir, PetscInt p, PetscInt cone[], PetscInt ornt[])
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidPointer(ir, 1);
+  PetscValidPointer(cone, 3);
+  ierr = DMPlexImplicitRefinementGetCone_Private(ir, ir->numLevels, p, cone, ornt);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@
+  DMPlexImplicitRefinementGetCoarsePoint - Return the point of the coarse mesh which a point of the refined mesh came from
+
+  Not collective
+
+  Input Parameters:
++ ir - The implicit refinement
+- p  - The point, which must lie in the chart set with DMPlexImplicitRefinementGetChart()
+
+  Output Parameter:
+. q - The coarse point
+
+  Level: intermediate
+
+.seealso: DMPlexImplicitRefinementCreate(), DMPlexImplicitRefinementGetCone()
+@*/
+PetscErrorCode DMPlexImplicitRefinementGetCoarsePoint(DMPlexImplicitRefinement ir, PetscInt p, PetscInt *q)
+{
+  PetscInt       l, d, dq, r;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidPointer(ir, 1);
+  PetscValidPointer(q, 3);
+  *q = p;
+  for (l = ir->numLevels; l > 0; --l) {ierr = DMPlexImplicitRefinementGetParent_Private(ir, l, *q, &d, &dq, q, &r);CHKERRQ(ierr);}
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode DMPlexImplicitRefinementCreateCoordinates_Private(DMPlexImplicitRefinement ir, DM rdm)
+{
+  DM             dm = ir->dm;
+  const PetscInt Nd = ir->depth+1, L = ir->numLevels;
+  PetscSection   coordSection, coordSectionNew;
+  Vec            coordinates, coordinatesNew;
+  VecType        vtype;
+  PetscScalar   *coords, *coordsNew, *x, *xNew = NULL;
+  PetscInt       vertices[8];
+  PetscInt       spaceDim, bs, vStart, vEnd, v, off, l, d, i;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = DMGetCoordinateSection(dm, &coordSection);CHKERRQ(ierr);
+  ierr = DMGetCoordinatesLocal(dm, &coordinates);CHKERRQ(ierr);
+  ierr = PetscSectionGetFieldComponents(coordSection, 0, &spaceDim);CHKERRQ(ierr);
+  ierr = PetscSectionCreate(PetscObjectComm((PetscObject) dm), &coordSectionNew);CHKERRQ(ierr);
+  ierr = PetscSectionSetNumFields(coordSectionNew, 1);CHKERRQ(ierr);
+  ierr = PetscSectionSetFieldComponents(coordSectionNew, 0, spaceDim);CHKERRQ(ierr);
+  ierr = PetscSectionSetChart(coordSectionNew, ir->start[L*Nd], ir->end[L*Nd]);CHKERRQ(ierr);
+  for (v = ir->start[L*Nd]; v < ir->end[L*Nd]; ++v) {
+    ierr = PetscSectionSetDof(coordSectionNew, v, spaceDim);CHKERRQ(ierr);
+    ierr = PetscSectionSetFieldDof(coordSectionNew, v, 0, spaceDim);CHKERRQ(ierr);
+  }
+  ierr = PetscSectionSetUp(coordSectionNew);CHKERRQ(ierr);
+  ierr = DMSetCoordinateSection(rdm, PETSC_DETERMINE, coordSectionNew);CHKERRQ(ierr);
+  ierr = VecCreate(PETSC_COMM_SELF, &coordinatesNew);CHKERRQ(ierr);
+  ierr = PetscObjectSetName((PetscObject) coordinatesNew, "coordinates");CHKERRQ(ierr);
+  ierr = VecSetSizes(coordinatesNew, (ir->end[L*Nd] - ir->start[L*Nd])*spaceDim, PETSC_DETERMINE);CHKERRQ(ierr);
+  ierr = VecGetBlockSize(coordinates, &bs);CHKERRQ(ierr);
+  ierr = VecSetBlockSize(coordinatesNew, bs);CHKERRQ(ierr);
+  ierr = VecGetType(coordinates, &vtype);CHKERRQ(ierr);
+  ierr = VecSetType(coordinatesNew, vtype);CHKERRQ(ierr);
+  /* Vertex coordinates of each level, stored by vertex number, where only the finest level lives in the new vector */
+  vStart = ir->start[0];
+  vEnd   = ir->end[0];
+  ierr   = PetscMalloc1((vEnd - vStart)*spaceDim, &x);CHKERRQ(ierr);
+  ierr   = VecGetArray(coordinates, &coords);CHKERRQ(ierr);
+  for (v = vStart; v < vEnd; ++v) {
+    ierr = PetscSectionGetOffset(coordSection, v, &off);CHKERRQ(ierr);
+    for (d = 0; d < spaceDim; ++d) x[(v - vStart)*spaceDim+d] = coords[off+d];
+  }
+  ierr = VecRestoreArray(coordinates, &coords);CHKERRQ(ierr);
+  ierr = VecGetArray(coordinatesNew, &coordsNew);CHKERRQ(ierr);
+  for (l = 1; l <= L; ++l) {
+    const PetscInt vStartOld = ir->start[(l-1)*Nd];
+
+    vStart = ir->start[l*Nd];
+    vEnd   = ir->end[l*Nd];
+    if (l == L) xNew = coordsNew;
+    else {ierr = PetscMalloc1((vEnd - vStart)*spaceDim, &xNew);CHKERRQ(ierr);}
+    /* Old vertices stay the same, and new vertices have the average of the vertices of their parent */
+    for (v = vStart; v < vEnd; ++v) {
+      PetscScalar *xv = &xNew[(v - vStart)*spaceDim];
+      PetscInt     dv, dq, q, r, numVertices;
+
+      ierr = DMPlexImplicitRefinementGetParent_Private(ir, l, v, &dv, &dq, &q, &r);CHKERRQ(ierr);
+      if (!dq) {numVertices = 1; vertices[0] = q;}
+      else {ierr = DMPlexImplicitRefinementGetClosureVertices_Private(ir, l-1, q, &numVertices, vertices);CHKERRQ(ierr);}
+      for (d = 0; d < spaceDim; ++d) xv[d] = 0.0;
+      for (i = 0; i < numVertices; ++i) for (d = 0; d < spaceDim; ++d) xv[d] += x[(vertices[i] - vStartOld)*spaceDim+d];
+      for (d = 0; d < spaceDim; ++d) xv[d] /= numVertices;
+    }
+    ierr = PetscFree(x);CHKERRQ(ierr);
+    x    = xNew;
+  }
+  ierr = VecRestoreArray(coordinatesNew, &coordsNew);CHKERRQ(ierr);
+  ierr = DMSetCoordinatesLocal(rdm, coordinatesNew);CHKERRQ(ierr);
+  ierr = VecDestroy(&coordinatesNew);CHKERRQ(ierr);
+  ierr = PetscSectionDestroy(&coordSectionNew);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode DMPlexImplicitRefinementCreateLabels_Private(DMPlexImplicitRefinement ir, DM rdm)
+{
+  DM             dm = ir->dm;
+  PetscInt      *points, *depths, *work, *workDepths;
+  PetscInt       maxDesc, numLabels, l;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  maxDesc = DMPlexRefinementRuleGetMaxDescendants_Private(ir->rule, ir->numLevels);
+  ierr = PetscMalloc4(maxDesc, &points, maxDesc, &depths, maxDesc, &work, maxDesc, &workDepths);CHKERRQ(ierr);
+  ierr = DMGetNumLabels(dm, &numLabels);CHKERRQ(ierr);
+  for (l = 0; l < numLabels; ++l) {
+    DMLabel         label, labelNew;
+    const char     *lname;
+    PetscBool       isDepth;
+    IS              valueIS;
+    const PetscInt *values;
+    PetscInt        defVal, numValues, val;
+
+    ierr = DMGetLabelName(dm, l, &lname);CHKERRQ(ierr);
+    ierr = PetscStrcmp(lname, "depth", &isDepth);CHKERRQ(ierr);
+    if (isDepth) continue;
+    ierr = DMCreateLabel(rdm, lname);CHKERRQ(ierr);
+    ierr = DMGetLabel(dm, lname, &label);CHKERRQ(ierr);
+    ierr = DMGetLabel(rdm, lname, &labelNew);CHKERRQ(ierr);
+    ierr = DMLabelGetDefaultValue(label, &defVal);CHKERRQ(ierr);
+    ierr = DMLabelSetDefaultValue(labelNew, defVal);CHKERRQ(ierr);
+    ierr = DMLabelGetValueIS(label, &valueIS);CHKERRQ(ierr);
+    ierr = ISGetLocalSize(valueIS, &numValues);CHKERRQ(ierr);
+    ierr = ISGetIndices(valueIS, &values);CHKERRQ(ierr);
+    for (val = 0; val < numValues; ++val) {
+      IS              pointIS;
+      const PetscInt *lpoints;
+      PetscInt        numPoints, n, m, i;
+
+      ierr = DMLabelGetStratumIS(label, values[val], &pointIS);CHKERRQ(ierr);
+      ierr = ISGetLocalSize(pointIS, &numPoints);CHKERRQ(ierr);
+      ierr = ISGetIndices(pointIS, &lpoints);CHKERRQ(ierr);
+      /* Every descendant of a labeled point gets its value, and the strata match those of the coarse label */
+      ierr = DMLabelAddStratum(labelNew, values[val]);CHKERRQ(ierr);
+      for (n = 0; n < numPoints; ++n) {
+        const PetscInt dp = DMPlexImplicitRefinementGetDepth_Private(ir->depth, ir->start, ir->end, lpoints[n]);
+
+        if (dp < 0) continue;
+        ierr = DMPlexImplicitRefinementGetDescendants_Private(ir->rule, ir->numLevels, ir->start, ir->block, dp, lpoints[n], &m, points, depths, work, workDepths);CHKERRQ(ierr);
+        for (i = 0; i < m; ++i) {ierr = DMLabelSetValue(labelNew, points[i], values[val]);CHKERRQ(ierr);}
+      }
+      ierr = ISRestoreIndices(pointIS, &lpoints);CHKERRQ(ierr);
+      ierr = ISDestroy(&pointIS);CHKERRQ(ierr);
+    }
+    ierr = ISRestoreIndices(valueIS, &values);CHKERRQ(ierr);
+    ierr = ISDestroy(&valueIS);CHKERRQ(ierr);
+  }
+  ierr = PetscFree4(points, depths, work, workDepths);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode DMPlexImplicitRefinementCreateSF_Private(DMPlexImplicitRefinement ir, DM rdm)
+{
+  DM                 dm = ir->dm;
+  const PetscInt     Nd = ir->depth+1, L = ir->numLevels;
+  PetscSF            sf, sfNew, sfProcess;
+  IS                 processRanks;
+  MPI_Datatype       strataType;
+  const PetscInt    *localPoints, *neighbors;
+  const PetscSFNode *remotePoints;
+  PetscInt          *localPointsNew, *strata, *rstrata, *rstart, *rend, *rblock, *points, *depths, *rpoints, *work, *workDepths;
+  PetscSFNode       *remotePointsNew;
+  PetscInt           numRoots, numLeaves, numLeavesNew = 0, numNeighbors, maxDesc, pEnd, l, m, n, d, i;
+  PetscErrorCode     ierr;
+
+  PetscFunctionBegin;
+  ierr = DMGetPointSF(dm, &sf);CHKERRQ(ierr);
+  ierr = PetscSFGetGraph(sf, &numRoots, &numLeaves, &localPoints, &remotePoints);CHKERRQ(ierr);
+  if (numRoots < 0) PetscFunctionReturn(0);
+  /* Each neighbor computes the numbering of its refined points from its coarse strata */
+  ierr = DMPlexCreateProcessSF(dm, sf, &processRanks, &sfProcess);CHKERRQ(ierr);
+  ierr = ISGetLocalSize(processRanks, &numNeighbors);CHKERRQ(ierr);
+  ierr = PetscMalloc2(2*Nd, &strata, 2*Nd*numNeighbors, &rstrata);CHKERRQ(ierr);
+  for (d = 0; d < Nd; ++d) {strata[d] = ir->start[d]; strata[Nd+d] = ir->end[d];}
+  ierr = MPI_Type_contiguous(2*Nd, MPIU_INT, &strataType);CHKERRQ(ierr);
+  ierr = MPI_Type_commit(&strataType);CHKERRQ(ierr);
+  ierr = PetscSFBcastBegin(sfProcess, strataType, strata, rstrata);CHKERRQ(ierr);
+  ierr = PetscSFBcastEnd(sfProcess, strataType, strata, rstrata);CHKERRQ(ierr);
+  ierr = MPI_Type_free(&strataType);CHKERRQ(ierr);
+  ierr = PetscSFDestroy(&sfProcess);CHKERRQ(ierr);
+  ierr = PetscMalloc3((L+1)*Nd*numNeighbors, &rstart, (L+1)*Nd*numNeighbors, &rend, L*Nd*Nd*numNeighbors, &rblock);CHKERRQ(ierr);
+  for (n = 0; n < numNeighbors; ++n) {
+    for (d = 0; d < Nd; ++d) {
+      rstart[n*(L+1)*Nd+d] = rstrata[n*2*Nd+d];
+      rend[n*(L+1)*Nd+d]   = rstrata[n*2*Nd+Nd+d];
+    }
+    ierr = DMPlexRefinementRuleSetUpLevels_Private(ir->rule, L, &rstart[n*(L+1)*Nd], &rend[n*(L+1)*Nd], &rblock[n*L*Nd*Nd]);CHKERRQ(ierr);
+  }
+  ierr = PetscFree2(strata, rstrata);CHKERRQ(ierr);
+  /* The descendants of a shared point are shared with the descendants of its root, in the same order */
+  maxDesc = DMPlexRefinementRuleGetMaxDescendants_Private(ir->rule, L);
+  ierr = PetscMalloc5(maxDesc, &points, maxDesc, &depths, maxDesc, &rpoints, maxDesc, &work, maxDesc, &workDepths);CHKERRQ(ierr);
+  for (l = 0; l < numLeaves; ++l) {
+    const PetscInt p  = localPoints ? localPoints[l] : l;
+    const PetscInt dp = DMPlexImplicitRefinementGetDepth_Private(ir->depth, ir->start, ir->end, p);
+
+    ierr = DMPlexImplicitRefinementGetDescendants_Private(ir->rule, L, ir->start, ir->block, dp, p, &m, points, depths, work, workDepths);CHKERRQ(ierr);
+    numLeavesNew += m;
+  }
+  ierr = PetscMalloc1(numLeavesNew, &localPointsNew);CHKERRQ(ierr);
+  ierr = PetscMalloc1(numLeavesNew, &remotePointsNew);CHKERRQ(ierr);
+  ierr = ISGetIndices(processRanks, &neighbors);CHKERRQ(ierr);
+  for (l = 0, numLeavesNew = 0; l < numLeaves; ++l) {
+    const PetscInt    p     = localPoints ? localPoints[l] : l;
+    const PetscInt    rp    = remotePoints[l].index;
+    const PetscMPIInt rrank = remotePoints[l].rank;
+    const PetscInt    dp    = DMPlexImplicitRefinementGetDepth_Private(ir->depth, ir->start, ir->end, p);
+    PetscInt          rm;
+
+    ierr = PetscFindInt(rrank, numNeighbors, neighbors, &n);CHKERRQ(ierr);
+    if (n < 0) SETERRQ1(PETSC_COMM_SELF, PETSC_ERR_ARG_OUTOFRANGE, "Could not locate remote rank %d", rrank);
+    ierr = DMPlexImplicitRefinementGetDescendants_Private(ir->rule, L, ir->start, ir->block, dp, p, &m, points, depths, work, workDepths);CHKERRQ(ierr);
+    ierr = DMPlexImplicitRefinementGetDescendants_Private(ir->rule, L, &rstart[n*(L+1)*Nd], &rblock[n*L*Nd*Nd], dp, rp, &rm, rpoints, depths, work, workDepths);CHKERRQ(ierr);
+    if (rm != m) SETERRQ3(PETSC_COMM_SELF, PETSC_ERR_PLIB, "Shared point %D has %D descendants, but its root has %D", p, m, rm);
+    for (i = 0; i < m; ++i, ++numLeavesNew) {
+      localPointsNew[numLeavesNew]        = points[i];
+      remotePointsNew[numLeavesNew].rank  = rrank;
+      remotePointsNew[numLeavesNew].index = rpoints[i];
+    }
+  }
+  ierr = ISRestoreIndices(processRanks, &neighbors);CHKERRQ(ierr);
+  ierr = ISDestroy(&processRanks);CHKERRQ(ierr);
+  ierr = PetscFree5(points, depths, rpoints, work, workDepths);CHKERRQ(ierr);
+  ierr = PetscFree3(rstart, rend, rblock);CHKERRQ(ierr);
+  /* SF needs sorted leaves to correctly calculate Gather */
+  {
+    PetscSFNode *rp;
+    PetscInt    *lp, *idx;
+
+    ierr = PetscMalloc3(numLeavesNew, &idx, numLeavesNew, &lp, numLeavesNew, &rp);CHKERRQ(ierr);
+    for (i = 0; i < numLeavesNew; ++i) idx[i] = i;
+    ierr = PetscSortIntWithPermutation(numLeavesNew, localPointsNew, idx);CHKERRQ(ierr);
+    for (i = 0; i < numLeavesNew; ++i) {
+      lp[i] = localPointsNew[idx[i]];
+      rp[i] = remotePointsNew[idx[i]];
+    }
+    for (i = 0; i < numLeavesNew; ++i) {
+      localPointsNew[i]  = lp[i];
+      remotePointsNew[i] = rp[i];
+    }
+    ierr = PetscFree3(idx, lp, rp);CHKERRQ(ierr);
+  }
+  ierr = DMPlexImplicitRefinementGetChart(ir, NULL, &pEnd);CHKERRQ(ierr);
+  ierr = DMGetPointSF(rdm, &sfNew);CHKERRQ(ierr);
+  ierr = PetscSFSetGraph(sfNew, pEnd, numLeavesNew, localPointsNew, PETSC_OWN_POINTER, remotePointsNew, PETSC_OWN_POINTER);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@
+  DMPlexImplicitRefinementCreateDM - Build the refined mesh described by an implicit refinement
+
+  Collective on DM
+
+  Input Parameter:
+. ir - The implicit refinement
+
+  Output Parameter:
+. rdm - The refined DMPlex
+
+  Notes:
+  Only the finest mesh is built, directly from the coarse mesh, so that the peak memory is that of the coarse and
+  refined meshes together with one array of vertex coordinates for the intermediate levels. The refined mesh has the same
+  points, cones, orientations, labels, and point SF as the result of repeated DMRefine(). Support order and the last
+  bits of the new vertex coordinates may differ. If the coarse mesh stores its topology compactly, so does the refined
+  mesh.
+
+  Periodic meshes and meshes with localized coordinates are not supported.
+
+  Level: intermediate
+
+.seealso: DMPlexImplicitRefinementCreate(), DMPlexSetCompactTopology(), DMRefine()
+@*/
+PetscErrorCode DMPlexImplicitRefinementCreateDM(DMPlexImplicitRefinement ir, DM *rdm)
+{
+  DM             dm;
+  PetscInt      *cone, *ornt;
+  PetscInt       dim, pEnd, p, d, coneSize;
+  PetscBool      isperiodic, localized, compact;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidPointer(ir, 1);
+  PetscValidPointer(rdm, 2);
+  dm   = ir->dm;
+  ierr = DMGetPeriodicity(dm, &isperiodic, NULL, NULL, NULL);CHKERRQ(ierr);
+  ierr = DMGetCoordinatesLocalized(dm, &localized);CHKERRQ(ierr);
+  if (isperiodic || localized) SETERRQ(PetscObjectComm((PetscObject) dm), PETSC_ERR_SUP, "Implicit refinement does not support periodic meshes");
+  ierr = DMGetDimension(dm, &dim);CHKERRQ(ierr);
+  ierr = DMPlexImplicitRefinementGetChart(ir, NULL, &pEnd);CHKERRQ(ierr);
+  ierr = DMCreate(PetscObjectComm((PetscObject) dm), rdm);CHKERRQ(ierr);
+  ierr = DMSetType(*rdm, DMPLEX);CHKERRQ(ierr);
+  ierr = DMSetDimension(*rdm, dim);CHKERRQ(ierr);
+  ierr = DMPlexGetCompactTopology(dm, &compact);CHKERRQ(ierr);
+  ((DM_Plex *) (*rdm)->data)->compactTopology = compact;
+  ierr = DMPlexSetChart(*rdm, 0, pEnd);CHKERRQ(ierr);
+  for (d = 0; d <= ir->depth; ++d) {
+    PetscInt dStart, dEnd;
+
+    ierr = DMPlexImplicitRefinementGetDepthStratum(ir, d, &dStart, &dEnd);CHKERRQ(ierr);
+    for (p = dStart; p < dEnd; ++p) {ierr = DMPlexSetConeSize(*rdm, p, ir->rule->coneSize[d]);CHKERRQ(ierr);}
+  }
+  ierr = DMSetUp(*rdm);CHKERRQ(ierr);
+  ierr = PetscMalloc2(ir->maxConeSize, &cone, ir->maxConeSize, &ornt);CHKERRQ(ierr);
+  for (p = 0; p < pEnd; ++p) {
+    ierr = DMPlexImplicitRefinementGetConeSize(ir, p, &coneSize);CHKERRQ(ierr);
+    if (!coneSize) continue;
+    ierr = DMPlexImplicitRefinementGetCone(ir, p, cone, ornt);CHKERRQ(ierr);
+    ierr = DMPlexSetCone(*rdm, p, cone);CHKERRQ(ierr);
+    ierr = DMPlexSetConeOrientation(*rdm, p, ornt);CHKERRQ(ierr);
+  }
+  ierr = PetscFree2(cone, ornt);CHKERRQ(ierr);
+  ierr = DMPlexSymmetrize(*rdm);CHKERRQ(ierr);
+  ierr = DMPlexStratify(*rdm);CHKERRQ(ierr);
+  ierr = DMPlexImplicitRefinementCreateSF_Private(ir, *rdm);CHKERRQ(ierr);
+  ierr = DMPlexImplicitRefinementCreateCoordinates_Private(ir, *rdm);CHKERRQ(ierr);
+  ierr = DMPlexImplicitRefinementCreateLabels_Private(ir, *rdm);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
@@ -1,6 +1,8 @@
 #include <petsc/private/dmpleximpl.h>   /*I      "petscdmplex.h"   I*/
 #include <petsc/private/matorderimpl.h> /*I      "petscmat.h"      I*/
 
+const char * const DMPlexReorderTypes[] = {"none", "rcm", "hilbert", "morton", "DMPlexReorderType", "DMPLEX_REORDER_", 0};
+
 static PetscErrorCode DMPlexCreateOrderingClosure_Static(DM dm, PetscInt numPoints, const PetscInt pperm[], PetscInt **clperm, PetscInt **invclperm)
 {
   PetscInt      *perm, *iperm;
@@ -45,6 +47,151 @@ static PetscErrorCode DMPlexCreateOrderingClosure_Static(DM dm, PetscInt numPoin
   PetscFunctionReturn(0);
 }
 
+/* Cell permutation by reverse Cuthill-McKee on the cell adjacency graph, cperm[new cell] = old cell */
+static PetscErrorCode DMPlexGetCellOrderingRCM_Static(DM dm, PetscInt *numCells, PetscInt **cperm)
+{
+  PetscInt      *start = NULL, *adjacency = NULL, *mask, *xls, c, i;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  *numCells = 0;
+  ierr = DMPlexCreateNeighborCSR(dm, 0, numCells, &start, &adjacency);CHKERRQ(ierr);
+  ierr = PetscMalloc1(*numCells, cperm);CHKERRQ(ierr);
+  ierr = PetscMalloc2(*numCells,&mask,*numCells*2,&xls);CHKERRQ(ierr);
+  if (*numCells) {
+    /* Shift for Fortran numbering */
+    for (i = 0; i < start[*numCells]; ++i) ++adjacency[i];
+    for (i = 0; i <= *numCells; ++i)       ++start[i];
+    ierr = SPARSEPACKgenrcm(numCells, start, adjacency, *cperm, mask, xls);CHKERRQ(ierr);
+  }
+  ierr = PetscFree(start);CHKERRQ(ierr);
+  ierr = PetscFree(adjacency);CHKERRQ(ierr);
+  ierr = PetscFree2(mask,xls);CHKERRQ(ierr);
+  /* Shift for Fortran numbering */
+  for (c = 0; c < *numCells; ++c) --(*cperm)[c];
+  PetscFunctionReturn(0);
+}
+
+/*
+  Converts the coordinates X, with the given number of bits each, to the transposed Hilbert index in place, following
+  J. Skilling, Programming the Hilbert curve, AIP Conference Proceedings 707, 2004. Interleaving the bits of the
+  result, starting with the high bit of X[0], gives the position along the curve.
+*/
+static void DMPlexHilbertTranspose_Private(PetscInt dim, PetscInt bits, PetscInt X[])
+{
+  const PetscInt M = ((PetscInt) 1) << (bits-1);
+  PetscInt       P, Q, t, i;
+
+  /* Inverse undo */
+  for (Q = M; Q > 1; Q >>= 1) {
+    P = Q - 1;
+    for (i = 0; i < dim; ++i) {
+      if (X[i] & Q) X[0] ^= P;
+      else {t = (X[0] ^ X[i]) & P; X[0] ^= t; X[i] ^= t;}
+    }
+  }
+  /* Gray encode */
+  for (i = 1; i < dim; ++i) X[i] ^= X[i-1];
+  t = 0;
+  for (Q = M; Q > 1; Q >>= 1) if (X[dim-1] & Q) t ^= Q - 1;
+  for (i = 0; i < dim; ++i) X[i] ^= t;
+}
+
+/* Cell permutation along a space filling curve through the cell centroids, cperm[new cell] = old cell */
+static PetscErrorCode DMPlexGetCellOrderingSFC_Static(DM dm, DMPlexReorderType rtype, PetscInt *numCells, PetscInt **cperm)
+{
+  DM             cdm;
+  PetscSection   csection;
+  Vec            coordinates;
+  PetscReal     *centroids, lower[3], upper[3], extent = 0.0, scale;
+  PetscInt      *keys, cdim, bits, maxCoord, cStart, cEnd, c, d, b;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = DMPlexGetHeightStratum(dm, 0, &cStart, &cEnd);CHKERRQ(ierr);
+  ierr = DMGetCoordinateDim(dm, &cdim);CHKERRQ(ierr);
+  if ((cdim < 1) || (cdim > 3)) SETERRQ1(PetscObjectComm((PetscObject) dm), PETSC_ERR_SUP, "Space filling curve ordering not supported for coordinate dimension %D", cdim);
+  ierr = DMGetCoordinateDM(dm, &cdm);CHKERRQ(ierr);
+  ierr = DMGetDefaultSection(cdm, &csection);CHKERRQ(ierr);
+  ierr = DMGetCoordinatesLocal(dm, &coordinates);CHKERRQ(ierr);
+  if (!coordinates) SETERRQ(PetscObjectComm((PetscObject) dm), PETSC_ERR_ARG_WRONGSTATE, "Space filling curve ordering requires mesh coordinates");
+  *numCells = cEnd - cStart;
+  ierr = PetscMalloc1(*numCells, cperm);CHKERRQ(ierr);
+  ierr = PetscMalloc2(*numCells*cdim, &centroids, *numCells, &keys);CHKERRQ(ierr);
+  for (d = 0; d < cdim; ++d) {lower[d] = PETSC_MAX_REAL; upper[d] = PETSC_MIN_REAL;}
+  for (c = cStart; c < cEnd; ++c) {
+    PetscScalar *coords = NULL;
+    PetscInt     csize, n, v;
+
+    ierr = DMPlexVecGetClosure(cdm, csection, coordinates, c, &csize, &coords);CHKERRQ(ierr);
+    n    = csize/cdim;
+    for (d = 0; d < cdim; ++d) {
+      PetscReal x = 0.0;
+
+      for (v = 0; v < n; ++v) x += PetscRealPart(coords[v*cdim+d]);
+      x /= PetscMax(n, 1);
+      centroids[(c-cStart)*cdim+d] = x;
+      lower[d] = PetscMin(lower[d], x);
+      upper[d] = PetscMax(upper[d], x);
+    }
+    ierr = DMPlexVecRestoreClosure(cdm, csection, coordinates, c, &csize, &coords);CHKERRQ(ierr);
+  }
+  /* Use a cube, so that the curve does not distort the aspect ratio of the domain */
+  for (d = 0; d < cdim; ++d) extent = PetscMax(extent, upper[d] - lower[d]);
+  /* Keys are nonnegative PetscInts */
+  bits     = PetscMin((PetscInt) (8*sizeof(PetscInt)-2), (PetscInt) (8*sizeof(PetscInt)-1)/cdim);
+  maxCoord = (((PetscInt) 1) << bits) - 1;
+  scale    = extent > 0.0 ? maxCoord/extent : 0.0;
+  for (c = 0; c < *numCells; ++c) {
+    PetscInt X[3], key = 0;
+
+    for (d = 0; d < cdim; ++d) {
+      const PetscReal x = (centroids[c*cdim+d] - lower[d])*scale;
+
+      X[d] = x < 0.0 ? 0 : (x >= (PetscReal) maxCoord ? maxCoord : (PetscInt) x);
+    }
+    if (rtype == DMPLEX_REORDER_HILBERT) DMPlexHilbertTranspose_Private(cdim, bits, X);
+    for (b = bits-1; b >= 0; --b) for (d = 0; d < cdim; ++d) key = (key << 1) | ((X[d] >> b) & 1);
+    keys[c]     = key;
+    (*cperm)[c] = c + cStart;
+  }
+  ierr = PetscSortIntWithArray(*numCells, keys, *cperm);CHKERRQ(ierr);
+  ierr = PetscFree2(centroids, keys);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* Moves the leaves of the point SF to the end of each stratum, keeping their order otherwise, perm[new point] = old point */
+static PetscErrorCode DMPlexGroupLeaves_Static(DM dm, PetscInt perm[])
+{
+  PetscSF         sf;
+  const PetscInt *leaves;
+  PetscBool      *isLeaf;
+  PetscInt       *tmp, nleaves, depth, d, pStart, pEnd, l;
+  PetscErrorCode  ierr;
+
+  PetscFunctionBegin;
+  ierr = DMGetPointSF(dm, &sf);CHKERRQ(ierr);
+  ierr = PetscSFGetGraph(sf, NULL, &nleaves, &leaves, NULL);CHKERRQ(ierr);
+  if (nleaves <= 0) PetscFunctionReturn(0);
+  ierr = DMPlexGetChart(dm, &pStart, &pEnd);CHKERRQ(ierr);
+  ierr = PetscCalloc1(pEnd-pStart, &isLeaf);CHKERRQ(ierr);
+  ierr = PetscMalloc1(pEnd-pStart, &tmp);CHKERRQ(ierr);
+  for (l = 0; l < nleaves; ++l) isLeaf[(leaves ? leaves[l] : l) - pStart] = PETSC_TRUE;
+  ierr = DMPlexGetDepth(dm, &depth);CHKERRQ(ierr);
+  for (d = 0; d <= depth; ++d) {
+    PetscInt sStart, sEnd, p, n;
+
+    ierr = DMPlexGetDepthStratum(dm, d, &sStart, &sEnd);CHKERRQ(ierr);
+    n    = sStart;
+    for (p = sStart; p < sEnd; ++p) if (!isLeaf[perm[p]-pStart]) tmp[n++] = perm[p];
+    for (p = sStart; p < sEnd; ++p) if ( isLeaf[perm[p]-pStart]) tmp[n++] = perm[p];
+    for (p = sStart; p < sEnd; ++p) perm[p] = tmp[p];
+  }
+  ierr = PetscFree(isLeaf);CHKERRQ(ierr);
+  ierr = PetscFree(tmp);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 /*@
   DMPlexGetOrdering - Calculate a reordering of the mesh
 
@@ -75,24 +222,13 @@ $     MATORDERINGQMD - Quotient Minimum Degree
 PetscErrorCode DMPlexGetOrdering(DM dm, MatOrderingType otype, DMLabel label, IS *perm)
 {
   PetscInt       numCells = 0;
-  PetscInt      *start = NULL, *adjacency = NULL, *cperm, *clperm = NULL, *invclperm = NULL, *mask, *xls, pStart, pEnd, c, i;
+  PetscInt      *cperm, *clperm = NULL, *invclperm = NULL, pStart, pEnd, c;
   PetscErrorCode ierr;
 
   PetscFunctionBegin;
   PetscValidHeaderSpecific(dm, DM_CLASSID, 1);
   PetscValidPointer(perm, 3);
-  ierr = DMPlexCreateNeighborCSR(dm, 0, &numCells, &start, &adjacency);CHKERRQ(ierr);
-  ierr = PetscMalloc3(numCells,&cperm,numCells,&mask,numCells*2,&xls);CHKERRQ(ierr);
-  if (numCells) {
-    /* Shift for Fortran numbering */
-    for (i = 0; i < start[numCells]; ++i) ++adjacency[i];
-    for (i = 0; i <= numCells; ++i)       ++start[i];
-    ierr = SPARSEPACKgenrcm(&numCells, start, adjacency, cperm, mask, xls);CHKERRQ(ierr);
-  }
-  ierr = PetscFree(start);CHKERRQ(ierr);
-  ierr = PetscFree(adjacency);CHKERRQ(ierr);
-  /* Shift for Fortran numbering */
-  for (c = 0; c < numCells; ++c) --cperm[c];
+  ierr = DMPlexGetCellOrderingRCM_Static(dm, &numCells, &cperm);CHKERRQ(ierr);
   /* Segregate */
   if (label) {
     IS              valueIS;
@@ -131,7 +267,7 @@ PetscErrorCode DMPlexGetOrdering(DM dm, MatOrderingType otype, DMLabel label, IS
   }
   /* Construct closure */
   ierr = DMPlexCreateOrderingClosure_Static(dm, numCells, cperm, &clperm, &invclperm);CHKERRQ(ierr);
-  ierr = PetscFree3(cperm,mask,xls);CHKERRQ(ierr);
+  ierr = PetscFree(cperm);CHKERRQ(ierr);
   ierr = PetscFree(clperm);CHKERRQ(ierr);
   /* Invert permutation */
   ierr = DMPlexGetChart(dm, &pStart, &pEnd);CHKERRQ(ierr);
@@ -151,6 +287,8 @@ PetscErrorCode DMPlexGetOrdering(DM dm, MatOrderingType otype, DMLabel label, IS
   Output Parameter:
 . pdm - The permuted DM
 
+  Note: The point SF is renumbered on all processes, so this is collective even though the permutation is local.
+
   Level: intermediate
 
 .keywords: mesh
@@ -171,7 +309,8 @@ PetscErrorCode DMPlexPermute(DM dm, IS perm, DM *pdm)
   ierr = DMSetType(*pdm, DMPLEX);CHKERRQ(ierr);
   ierr = DMGetDimension(dm, &dim);CHKERRQ(ierr);
   ierr = DMSetDimension(*pdm, dim);CHKERRQ(ierr);
-  ierr = DMGetDefaultSection(dm, &section);CHKERRQ(ierr);
+  /* Do not let DMGetDefaultSection() create a section from an empty discretization */
+  section = dm->defaultSection;
   if (section) {
     ierr = PetscSectionPermute(section, perm, &sectionNew);CHKERRQ(ierr);
     ierr = DMSetDefaultSection(*pdm, sectionNew);CHKERRQ(ierr);
@@ -179,8 +318,38 @@ PetscErrorCode DMPlexPermute(DM dm, IS perm, DM *pdm)
   }
   plexNew = (DM_Plex *) (*pdm)->data;
   /* Ignore ltogmap, ltogmapb */
-  /* Ignore sf, defaultSF */
+  /* Ignore defaultSF */
   /* Ignore globalVertexNumbers, globalCellNumbers */
+  /* Remap the point SF */
+  {
+    DM       cdmNew;
+    PetscSF  sf, sfNew;
+    PetscInt nroots;
+
+    ierr = DMGetPointSF(dm, &sf);CHKERRQ(ierr);
+    ierr = PetscSFGetGraph(sf, &nroots, NULL, NULL, NULL);CHKERRQ(ierr);
+    if (nroots >= 0) {
+      ierr = DMPlexPermuteSF_Internal(sf, perm, PETSC_TRUE, &sfNew);CHKERRQ(ierr);
+      ierr = DMSetPointSF(*pdm, sfNew);CHKERRQ(ierr);
+      ierr = DMGetCoordinateDM(*pdm, &cdmNew);CHKERRQ(ierr);
+      ierr = DMSetPointSF(cdmNew, sfNew);CHKERRQ(ierr);
+      ierr = PetscSFDestroy(&sfNew);CHKERRQ(ierr);
+    }
+  }
+  /* Copy adjacency and periodicity */
+  {
+    const PetscReal      *maxCell, *L;
+    const DMBoundaryType *bd;
+    PetscBool             isper, useCone, useClosure;
+
+    ierr = DMPlexGetAdjacencyUseCone(dm, &useCone);CHKERRQ(ierr);
+    ierr = DMPlexGetAdjacencyUseClosure(dm, &useClosure);CHKERRQ(ierr);
+    ierr = DMPlexSetAdjacencyUseCone(*pdm, useCone);CHKERRQ(ierr);
+    ierr = DMPlexSetAdjacencyUseClosure(*pdm, useClosure);CHKERRQ(ierr);
+    plexNew->useAnchors = plex->useAnchors;
+    ierr = DMGetPeriodicity(dm, &isper, &maxCell, &L, &bd);CHKERRQ(ierr);
+    ierr = DMSetPeriodicity(*pdm, isper, maxCell, L, bd);CHKERRQ(ierr);
+  }
   /* Remap coordinates */
   {
     DM              cdm, cdmNew;
@@ -231,6 +400,8 @@ PetscErrorCode DMPlexPermute(DM dm, IS perm, DM *pdm)
       ierr = DMAddLabel(*pdm, labelNew);CHKERRQ(ierr);
     }
     if (plex->subpointMap) {ierr = DMLabelPermute(plex->subpointMap, perm, &plexNew->subpointMap);CHKERRQ(ierr);}
+    ierr = DMPlexGetDepthLabel(*pdm, &label);CHKERRQ(ierr);
+    if (label) {ierr = DMLabelGetState(label, &plexNew->depthState);CHKERRQ(ierr);}
   }
   /* Reorder topology */
   {
@@ -277,3 +448,214 @@ PetscErrorCode DMPlexPermute(DM dm, IS perm, DM *pdm)
   }
   PetscFunctionReturn(0);
 }
+
+/*
+  DMPlexPermuteSF_Internal - Renumber the local points of a PetscSF by a mesh point permutation
+
+  Collective on sf if permuteRoots is PETSC_TRUE
+
+  Input Parameters:
++ sf           - The PetscSF, whose leaves are mesh points
+. perm         - The point permutation, perm[old point number] = new point number
+- permuteRoots - If PETSC_TRUE the roots are also mesh points, permuted on each process, as for the point SF
+
+  Output Parameter:
+. sfNew - The renumbered PetscSF, with leaves sorted by their new point number
+
+  Level: developer
+*/
+PetscErrorCode DMPlexPermuteSF_Internal(PetscSF sf, IS perm, PetscBool permuteRoots, PetscSF *sfNew)
+{
+  const PetscInt    *pperm, *ilocal;
+  const PetscSFNode *iremote;
+  PetscSFNode       *iremoteNew;
+  PetscInt          *rootNew = NULL, *leafNew = NULL, *order, *ilocalNew;
+  PetscInt           nroots, nleaves, n, p, l;
+  PetscBool          contiguous = PETSC_TRUE;
+  PetscErrorCode     ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscSFGetGraph(sf, &nroots, &nleaves, &ilocal, &iremote);CHKERRQ(ierr);
+  ierr = ISGetLocalSize(perm, &n);CHKERRQ(ierr);
+  ierr = ISGetIndices(perm, &pperm);CHKERRQ(ierr);
+  if (permuteRoots) {
+    ierr = PetscMalloc2(nroots, &rootNew, n, &leafNew);CHKERRQ(ierr);
+    for (p = 0; p < nroots; ++p) rootNew[p] = pperm[p];
+    ierr = PetscSFBcastBegin(sf, MPIU_INT, rootNew, leafNew);CHKERRQ(ierr);
+    ierr = PetscSFBcastEnd(sf, MPIU_INT, rootNew, leafNew);CHKERRQ(ierr);
+  }
+  ierr = PetscMalloc1(nleaves, &order);CHKERRQ(ierr);
+  ierr = PetscMalloc1(nleaves, &ilocalNew);CHKERRQ(ierr);
+  ierr = PetscMalloc1(nleaves, &iremoteNew);CHKERRQ(ierr);
+  for (l = 0; l < nleaves; ++l) {
+    order[l]     = l;
+    ilocalNew[l] = pperm[ilocal ? ilocal[l] : l];
+  }
+  ierr = PetscSortIntWithArray(nleaves, ilocalNew, order);CHKERRQ(ierr);
+  for (l = 0; l < nleaves; ++l) {
+    const PetscInt lold = order[l];
+
+    iremoteNew[l].rank  = iremote[lold].rank;
+    iremoteNew[l].index = permuteRoots ? leafNew[ilocal ? ilocal[lold] : lold] : iremote[lold].index;
+    if (ilocalNew[l] != l) contiguous = PETSC_FALSE;
+  }
+  if (contiguous) {ierr = PetscFree(ilocalNew);CHKERRQ(ierr);}
+  ierr = ISRestoreIndices(perm, &pperm);CHKERRQ(ierr);
+  ierr = PetscFree(order);CHKERRQ(ierr);
+  ierr = PetscFree2(rootNew, leafNew);CHKERRQ(ierr);
+  ierr = PetscSFCreate(PetscObjectComm((PetscObject) sf), sfNew);CHKERRQ(ierr);
+  ierr = PetscSFSetGraph(*sfNew, nroots, nleaves, ilocalNew, PETSC_OWN_POINTER, iremoteNew, PETSC_OWN_POINTER);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@
+  DMPlexGetReordering - Calculate a reordering of the mesh points for memory locality
+
+  Not collective
+
+  Input Parameters:
++ dm    - The DMPlex object
+- rtype - The type of reordering, one of the following:
+$     DMPLEX_REORDER_NONE - Keep the current numbering
+$     DMPLEX_REORDER_RCM - Reverse Cuthill-McKee on the cell adjacency graph
+$     DMPLEX_REORDER_HILBERT - Cells along a Hilbert curve through the cell centroids
+$     DMPLEX_REORDER_MORTON - Cells along a Morton (Z-order) curve through the cell centroids
+
+  Output Parameter:
+. perm - The point permutation as an IS, perm[old point number] = new point number
+
+  Notes:
+  Only the cells are ordered by rtype. The points of each lower stratum are numbered in the order in which they first
+  appear in the cones of the reordered stratum above, so the closures of consecutive cells are close in memory. Then,
+  in each stratum, the leaves of the point SF, which are owned by other processes, are moved to the end, so that the
+  ghost points of a stratum form one contiguous range.
+
+  Meshes with hybrid points or a reference tree are not supported.
+
+  Level: intermediate
+
+.keywords: mesh
+.seealso: DMPlexReorder(), DMPlexPermute(), DMPlexGetOrdering(), DMPlexSetReorderType()
+@*/
+PetscErrorCode DMPlexGetReordering(DM dm, DMPlexReorderType rtype, IS *perm)
+{
+  DM_Plex       *mesh = (DM_Plex *) dm->data;
+  PetscInt      *cperm = NULL, *clperm = NULL, *invclperm = NULL, numCells = 0, pStart, pEnd, p, d;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(dm, DM_CLASSID, 1);
+  PetscValidPointer(perm, 3);
+  ierr = DMPlexGetChart(dm, &pStart, &pEnd);CHKERRQ(ierr);
+  if (rtype == DMPLEX_REORDER_NONE) {
+    ierr = ISCreateStride(PETSC_COMM_SELF, pEnd-pStart, pStart, 1, perm);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  for (d = 0; d < 8; ++d) if (mesh->hybridPointMax[d] >= 0) SETERRQ(PetscObjectComm((PetscObject) dm), PETSC_ERR_SUP, "Reordering of meshes with hybrid points is not supported");
+  if (mesh->parentSection) SETERRQ(PetscObjectComm((PetscObject) dm), PETSC_ERR_SUP, "Reordering of meshes with a reference tree is not supported");
+  switch (rtype) {
+  case DMPLEX_REORDER_RCM:
+    ierr = DMPlexGetCellOrderingRCM_Static(dm, &numCells, &cperm);CHKERRQ(ierr);break;
+  case DMPLEX_REORDER_HILBERT:
+  case DMPLEX_REORDER_MORTON:
+    ierr = DMPlexGetCellOrderingSFC_Static(dm, rtype, &numCells, &cperm);CHKERRQ(ierr);break;
+  default: SETERRQ1(PetscObjectComm((PetscObject) dm), PETSC_ERR_ARG_OUTOFRANGE, "Invalid reordering type %d", (int) rtype);
+  }
+  ierr = DMPlexCreateOrderingClosure_Static(dm, numCells, cperm, &clperm, &invclperm);CHKERRQ(ierr);
+  ierr = PetscFree(cperm);CHKERRQ(ierr);
+  ierr = DMPlexGroupLeaves_Static(dm, clperm);CHKERRQ(ierr);
+  for (p = pStart; p < pEnd; ++p) invclperm[clperm[p]] = p;
+  ierr = PetscFree(clperm);CHKERRQ(ierr);
+  ierr = ISCreateGeneral(PETSC_COMM_SELF, pEnd-pStart, invclperm, PETSC_OWN_POINTER, perm);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@
+  DMPlexReorder - Renumber the mesh points for memory locality
+
+  Collective on DM
+
+  Input Parameters:
++ dm    - The DMPlex object
+- rtype - The type of reordering
+
+  Output Parameter:
+. rdm - The reordered DM
+
+  Note: The point SF of a distributed mesh is renumbered consistently on all processes.
+
+  Level: intermediate
+
+.keywords: mesh
+.seealso: DMPlexGetReordering(), DMPlexPermute(), DMPlexSetReorderType()
+@*/
+PetscErrorCode DMPlexReorder(DM dm, DMPlexReorderType rtype, DM *rdm)
+{
+  IS             perm;
+  const char    *name;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(dm, DM_CLASSID, 1);
+  PetscValidPointer(rdm, 3);
+  ierr = DMPlexGetReordering(dm, rtype, &perm);CHKERRQ(ierr);
+  ierr = DMPlexPermute(dm, perm, rdm);CHKERRQ(ierr);
+  ierr = ISDestroy(&perm);CHKERRQ(ierr);
+  ierr = PetscObjectGetName((PetscObject) dm, &name);CHKERRQ(ierr);
+  ierr = PetscObjectSetName((PetscObject) *rdm, name);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@
+  DMPlexGetReorderType - Get the reordering applied to the mesh points after distribution
+
+  Not collective
+
+  Input Parameter:
+. dm - The DMPlex object
+
+  Output Parameter:
+. rtype - The type of reordering
+
+  Level: intermediate
+
+.seealso: DMPlexSetReorderType(), DMPlexDistribute()
+@*/
+PetscErrorCode DMPlexGetReorderType(DM dm, DMPlexReorderType *rtype)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(dm, DM_CLASSID, 1);
+  PetscValidPointer(rtype, 2);
+  *rtype = ((DM_Plex *) dm->data)->reorderType;
+  PetscFunctionReturn(0);
+}
+
+/*@
+  DMPlexSetReorderType - Set the reordering applied to the mesh points after distribution
+
+  Logically collective on DM
+
+  Input Parameters:
++ dm    - The DMPlex object
+- rtype - The type of reordering
+
+  Options Database:
+. -dm_plex_reorder <none,rcm,hilbert,morton> - The type of reordering
+
+  Note: DMPlexDistribute() renumbers the distributed mesh with DMPlexGetReordering(), so that cells close in space,
+  their closures, and the points shared with other processes are each close in memory. Since the option is also
+  checked by DMPlexDistribute(), it takes effect even if DMSetFromOptions() is called after distribution. The
+  migration SF returned by DMPlexDistribute() refers to the renumbered points.
+
+  Level: intermediate
+
+.seealso: DMPlexGetReorderType(), DMPlexGetReordering(), DMPlexReorder(), DMPlexDistribute()
+@*/
+PetscErrorCode DMPlexSetReorderType(DM dm, DMPlexReorderType rtype)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(dm, DM_CLASSID, 1);
+  PetscValidLogicalCollectiveEnum(dm, rtype, 2);
+  ((DM_Plex *) dm->data)->reorderType = rtype;
+  PetscFunctionReturn(0);
+}
@@ -3410,11 +3410,16 @@ PetscErrorCode  DMRegister(const char sname[],PetscErrorCode (*function)(DM))
 - viewer - binary file viewer, obtained from PetscViewerBinaryOpen() or
            HDF5 file viewer, obtained from PetscViewerHDF5Open()
 
+  Options Database Key:
+. -dm_plex_hdf5_parallel_load - For a DMPLEX in the native HDF5 format, each process reads a chunk of the mesh, instead of process 0 reading all of it
+
    Level: intermediate
 
   Notes:
    The type is determined by the data in the file, any type set into the DM before this call is ignored.
 
+   A DMPLEX loaded in parallel has a naive partition, and should then be redistributed with DMPlexDistribute().
+
   Notes for advanced users:
   Most users should not need to know the details of the binary storage
   format, since DMLoad() and DMView() completely hide these details.
@@ -129,6 +129,14 @@
       PetscEnum PC_MG_CYCLE_W
       parameter (PC_MG_CYCLE_V = 1,PC_MG_CYCLE_W = 2)
 
+! PCMGAdditiveType
+      PetscEnum PC_MG_ADDITIVE_STANDARD
+      PetscEnum PC_MG_ADDITIVE_AFACX
+      PetscEnum PC_MG_ADDITIVE_MULT
+      parameter (PC_MG_ADDITIVE_STANDARD = 0)
+      parameter (PC_MG_ADDITIVE_AFACX = 1)
+      parameter (PC_MG_ADDITIVE_MULT = 2)
+
 ! PCMGGalerkinType
       PetscEnum PC_MG_GALERKIN_BOTH
       PetscEnum PC_MG_GALERKIN_PMAT
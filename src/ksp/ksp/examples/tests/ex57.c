@@ -0,0 +1,152 @@
+static char help[] = "Tests reuse of the block symbolic factorizations of PCBJACOBI and PCASM when the nonzero\n\
+structure of the global matrix changes but that of the blocks does not.\n\
+Input parameters include:\n\
+  -n <n> : number of mesh points\n\n";
+
+#include <petscksp.h>
+#include <petsc/private/petscimpl.h> /* for PetscObjectGetId() */
+
+/*
+   Checks, for every local block, if the factored matrix is still the one created by the previous PCSetUp()
+*/
+static PetscErrorCode CheckBlockFactors(PC pc,PetscInt nmax,PetscObjectId ids[],const char *stage)
+{
+  PetscErrorCode ierr;
+  KSP            *subksp;
+  PC             subpc;
+  Mat            F;
+  PetscInt       i,nlocal,first;
+  PetscBool      isasm;
+  PetscObjectId  id;
+  PetscMPIInt    rank;
+
+  PetscFunctionBeginUser;
+  ierr = MPI_Comm_rank(PetscObjectComm((PetscObject)pc),&rank);CHKERRQ(ierr);
+  ierr = PetscObjectTypeCompare((PetscObject)pc,PCASM,&isasm);CHKERRQ(ierr);
+  if (isasm) {
+    ierr = PCASMGetSubKSP(pc,&nlocal,&first,&subksp);CHKERRQ(ierr);
+  } else {
+    ierr = PCBJacobiGetSubKSP(pc,&nlocal,&first,&subksp);CHKERRQ(ierr);
+  }
+  if (nlocal > nmax) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_SUP,"Test supports at most %D local blocks, have %D",nmax,nlocal);
+  ierr = PetscPrintf(PetscObjectComm((PetscObject)pc),"%s\n",stage);CHKERRQ(ierr);
+  for (i=0; i<nlocal; i++) {
+    ierr = KSPGetPC(subksp[i],&subpc);CHKERRQ(ierr);
+    ierr = PCFactorGetMatrix(subpc,&F);CHKERRQ(ierr);
+    ierr = PetscObjectGetId((PetscObject)F,&id);CHKERRQ(ierr);
+    if (ids[i] >= 0) {
+      ierr = PetscSynchronizedPrintf(PetscObjectComm((PetscObject)pc),"  [%d] block %D: symbolic factorization %s\n",rank,i,id == ids[i] ? "reused" : "recomputed");CHKERRQ(ierr);
+    }
+    ids[i] = id;
+  }
+  ierr = PetscSynchronizedFlush(PetscObjectComm((PetscObject)pc),PETSC_STDOUT);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+int main(int argc,char **args)
+{
+  Vec            x,b;
+  Mat            A;
+  KSP            ksp;
+  PC             pc;
+  PetscInt       i,n = 40,rstart,rend,col[3],its;
+  PetscInt       nmax = 16;
+  PetscObjectId  ids[16];
+  PetscScalar    value[3];
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc,&args,(char*)0,help);if (ierr) return ierr;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-n",&n,NULL);CHKERRQ(ierr);
+  for (i=0; i<nmax; i++) ids[i] = -1;
+
+  /* 1d Laplacian, with room for the couplings added below */
+  ierr = MatCreateAIJ(PETSC_COMM_WORLD,PETSC_DECIDE,PETSC_DECIDE,n,n,3,NULL,1,NULL,&A);CHKERRQ(ierr);
+  ierr = MatSetFromOptions(A);CHKERRQ(ierr);
+  ierr = MatSetOption(A,MAT_NEW_NONZERO_ALLOCATION_ERR,PETSC_FALSE);CHKERRQ(ierr);
+  ierr = MatGetOwnershipRange(A,&rstart,&rend);CHKERRQ(ierr);
+  value[0] = -1.0; value[1] = 2.0; value[2] = -1.0;
+  for (i=rstart; i<rend; i++) {
+    col[0] = i-1; col[1] = i; col[2] = i+1;
+    if (i == 0) {
+      ierr = MatSetValues(A,1,&i,2,col+1,value+1,INSERT_VALUES);CHKERRQ(ierr);
+    } else if (i == n-1) {
+      ierr = MatSetValues(A,1,&i,2,col,value,INSERT_VALUES);CHKERRQ(ierr);
+    } else {
+      ierr = MatSetValues(A,1,&i,3,col,value,INSERT_VALUES);CHKERRQ(ierr);
+    }
+  }
+  ierr = MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatCreateVecs(A,&x,&b);CHKERRQ(ierr);
+  ierr = VecSet(b,1.0);CHKERRQ(ierr);
+
+  ierr = KSPCreate(PETSC_COMM_WORLD,&ksp);CHKERRQ(ierr);
+  ierr = KSPSetOperators(ksp,A,A);CHKERRQ(ierr);
+  ierr = KSPGetPC(ksp,&pc);CHKERRQ(ierr);
+  ierr = PCSetType(pc,PCBJACOBI);CHKERRQ(ierr);
+  ierr = KSPSetFromOptions(ksp);CHKERRQ(ierr);
+  ierr = KSPSolve(ksp,b,x);CHKERRQ(ierr);
+  ierr = KSPGetIterationNumber(ksp,&its);CHKERRQ(ierr);
+  ierr = PetscPrintf(PETSC_COMM_WORLD,"Initial solve: iterations %D\n",its);CHKERRQ(ierr);
+  ierr = CheckBlockFactors(pc,nmax,ids,"Initial setup");CHKERRQ(ierr);
+
+  /* couple the first and last unknowns, they belong to different blocks so no block changes its structure */
+  if (!rstart) {
+    i = 0; col[0] = n-1; value[0] = -0.5;
+    ierr = MatSetValues(A,1,&i,1,col,value,INSERT_VALUES);CHKERRQ(ierr);
+  }
+  if (rend == n) {
+    i = n-1; col[0] = 0; value[0] = -0.5;
+    ierr = MatSetValues(A,1,&i,1,col,value,INSERT_VALUES);CHKERRQ(ierr);
+  }
+  ierr = MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatShift(A,0.5);CHKERRQ(ierr);
+  ierr = KSPSolve(ksp,b,x);CHKERRQ(ierr);
+  ierr = KSPGetIterationNumber(ksp,&its);CHKERRQ(ierr);
+  ierr = PetscPrintf(PETSC_COMM_WORLD,"Solve after coupling between blocks: iterations %D\n",its);CHKERRQ(ierr);
+  ierr = CheckBlockFactors(pc,nmax,ids,"Setup after coupling between blocks");CHKERRQ(ierr);
+
+  /* now change the structure of the first block only */
+  if (!rstart) {
+    i = 0; col[0] = 2; value[0] = -0.25;
+    ierr = MatSetValues(A,1,&i,1,col,value,INSERT_VALUES);CHKERRQ(ierr);
+    i = 2; col[0] = 0;
+    ierr = MatSetValues(A,1,&i,1,col,value,INSERT_VALUES);CHKERRQ(ierr);
+  }
+  ierr = MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = KSPSolve(ksp,b,x);CHKERRQ(ierr);
+  ierr = KSPGetIterationNumber(ksp,&its);CHKERRQ(ierr);
+  ierr = PetscPrintf(PETSC_COMM_WORLD,"Solve after coupling inside the first block: iterations %D\n",its);CHKERRQ(ierr);
+  ierr = CheckBlockFactors(pc,nmax,ids,"Setup after coupling inside the first block");CHKERRQ(ierr);
+
+  ierr = KSPDestroy(&ksp);CHKERRQ(ierr);
+  ierr = VecDestroy(&x);CHKERRQ(ierr);
+  ierr = VecDestroy(&b);CHKERRQ(ierr);
+  ierr = MatDestroy(&A);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   test:
+      suffix: bjacobi
+      args: -pc_bjacobi_blocks 4 -sub_pc_type lu -ksp_type gmres
+
+   test:
+      suffix: bjacobi_2
+      nsize: 2
+      args: -pc_bjacobi_blocks 4 -sub_pc_type ilu -ksp_type gmres
+
+   test:
+      suffix: asm
+      args: -pc_type asm -pc_asm_blocks 4 -pc_asm_overlap 1 -sub_pc_type lu -ksp_type gmres
+
+   test:
+      suffix: asm_2
+      nsize: 2
+      args: -pc_type asm -pc_asm_overlap 2 -sub_pc_type lu -ksp_type gmres
+
+TEST*/
@@ -0,0 +1,104 @@
+static char help[] = "Tests PCVPBJACOBI with a matrix with point-blocks of size 1, 3 and 5.\n\
+Input parameters include:\n\
+  -nb <nb>     : number of point-blocks on each process\n\
+  -coupling <c>: strength of the coupling between consecutive point-blocks\n\n";
+
+#include <petscksp.h>
+
+int main(int argc,char **args)
+{
+  Vec            x,b,r;
+  Mat            A;
+  KSP            ksp;
+  PC             pc;
+  PetscInt       i,j,k,nb = 10,n = 0,*bsizes,rstart,rend,row,col,start,its;
+  PetscInt       sizes[3] = {1,3,5};
+  PetscReal      coupling = 0.1,norm;
+  PetscScalar    v;
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc,&args,(char*)0,help);if (ierr) return ierr;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-nb",&nb,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetReal(NULL,NULL,"-coupling",&coupling,NULL);CHKERRQ(ierr);
+  ierr = PetscMalloc1(nb,&bsizes);CHKERRQ(ierr);
+  for (i=0; i<nb; i++) {
+    bsizes[i] = sizes[i%3];
+    n        += bsizes[i];
+  }
+
+  ierr = MatCreate(PETSC_COMM_WORLD,&A);CHKERRQ(ierr);
+  ierr = MatSetSizes(A,n,n,PETSC_DETERMINE,PETSC_DETERMINE);CHKERRQ(ierr);
+  ierr = MatSetType(A,MATAIJ);CHKERRQ(ierr);
+  ierr = MatSetFromOptions(A);CHKERRQ(ierr);
+  ierr = MatSeqAIJSetPreallocation(A,7,NULL);CHKERRQ(ierr);
+  ierr = MatMPIAIJSetPreallocation(A,7,NULL,2,NULL);CHKERRQ(ierr);
+  ierr = MatGetOwnershipRange(A,&rstart,&rend);CHKERRQ(ierr);
+  ierr = MatGetSize(A,&n,NULL);CHKERRQ(ierr);
+
+  /* dense nonsymmetric diagonally dominant point-blocks, coupled to the neighboring rows outside of the block */
+  start = rstart;
+  for (k=0; k<nb; k++) {
+    for (i=0; i<bsizes[k]; i++) {
+      row = start + i;
+      for (j=0; j<bsizes[k]; j++) {
+        col  = start + j;
+        v    = (i == j) ? 2.0*bsizes[k] + 1.0 : 1.0/(1.0 + i + 2*j);
+        ierr = MatSetValues(A,1,&row,1,&col,&v,INSERT_VALUES);CHKERRQ(ierr);
+      }
+      v = -coupling;
+      if (!i && row > 0) {
+        col  = row-1;
+        ierr = MatSetValues(A,1,&row,1,&col,&v,INSERT_VALUES);CHKERRQ(ierr);
+      }
+      if (i == bsizes[k]-1 && row < n-1) {
+        col  = row+1;
+        ierr = MatSetValues(A,1,&row,1,&col,&v,INSERT_VALUES);CHKERRQ(ierr);
+      }
+    }
+    start += bsizes[k];
+  }
+  ierr = MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatSetVariableBlockSizes(A,nb,bsizes);CHKERRQ(ierr);
+
+  ierr = MatCreateVecs(A,&x,&b);CHKERRQ(ierr);
+  ierr = VecDuplicate(b,&r);CHKERRQ(ierr);
+  ierr = VecSet(b,1.0);CHKERRQ(ierr);
+
+  ierr = KSPCreate(PETSC_COMM_WORLD,&ksp);CHKERRQ(ierr);
+  ierr = KSPSetOperators(ksp,A,A);CHKERRQ(ierr);
+  ierr = KSPGetPC(ksp,&pc);CHKERRQ(ierr);
+  ierr = PCSetType(pc,PCVPBJACOBI);CHKERRQ(ierr);
+  ierr = KSPSetFromOptions(ksp);CHKERRQ(ierr);
+  ierr = KSPSolve(ksp,b,x);CHKERRQ(ierr);
+  ierr = KSPGetIterationNumber(ksp,&its);CHKERRQ(ierr);
+  ierr = MatMult(A,x,r);CHKERRQ(ierr);
+  ierr = VecAXPY(r,-1.0,b);CHKERRQ(ierr);
+  ierr = VecNorm(r,NORM_2,&norm);CHKERRQ(ierr);
+  ierr = PetscPrintf(PETSC_COMM_WORLD,"Number of iterations %D, residual norm %s\n",its,norm < 1.e-8 ? "< 1.e-8" : "too large");CHKERRQ(ierr);
+
+  ierr = KSPDestroy(&ksp);CHKERRQ(ierr);
+  ierr = VecDestroy(&x);CHKERRQ(ierr);
+  ierr = VecDestroy(&b);CHKERRQ(ierr);
+  ierr = VecDestroy(&r);CHKERRQ(ierr);
+  ierr = MatDestroy(&A);CHKERRQ(ierr);
+  ierr = PetscFree(bsizes);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   test:
+      args: -ksp_type gmres -ksp_rtol 1.e-10 -ksp_view
+
+   test:
+      suffix: 2
+      nsize: 2
+      args: -ksp_type gmres -ksp_rtol 1.e-10 -nb 11
+
+   test:
+      suffix: exact
+      args: -ksp_type richardson -coupling 0 -ksp_max_it 1 -ksp_norm_type none
+
+TEST*/
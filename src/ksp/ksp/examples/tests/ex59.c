@@ -0,0 +1,126 @@
+static char help[] = "Tests low-rank updates of the factorization in PCFactor when only a few rows of the matrix change.\n\
+Input parameters include:\n\
+  -m <m>        : the grid has m x m points\n\
+  -nsteps <n>   : number of times the matrix is changed and the system solved again\n\
+  -nrows <k>    : number of rows changed in each step\n\
+  -nonsymmetric : also change an off-diagonal entry of each changed row\n\
+  -transpose    : solve with the transpose of the matrix\n\n";
+
+#include <petscksp.h>
+
+int main(int argc,char **args)
+{
+  Vec            x,b,r;
+  Mat            A;
+  KSP            ksp;
+  PetscInt       i,j,k,s,m = 8,n,nsteps = 4,nrows = 2,row,col,rstart,rend,its;
+  PetscBool      nonsymmetric = PETSC_FALSE,view = PETSC_FALSE,transpose = PETSC_FALSE,sbaij;
+  PetscScalar    v;
+  PetscReal      norm,bnorm;
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc,&args,(char*)0,help);if (ierr) return ierr;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-m",&m,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-nsteps",&nsteps,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-nrows",&nrows,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetBool(NULL,NULL,"-nonsymmetric",&nonsymmetric,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetBool(NULL,NULL,"-transpose",&transpose,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetBool(NULL,NULL,"-view",&view,NULL);CHKERRQ(ierr);
+  n    = m*m;
+
+  /* five point Laplacian */
+  ierr = MatCreate(PETSC_COMM_WORLD,&A);CHKERRQ(ierr);
+  ierr = MatSetSizes(A,PETSC_DECIDE,PETSC_DECIDE,n,n);CHKERRQ(ierr);
+  ierr = MatSetFromOptions(A);CHKERRQ(ierr);
+  ierr = MatSeqAIJSetPreallocation(A,5,NULL);CHKERRQ(ierr);
+  ierr = MatMPIAIJSetPreallocation(A,5,NULL,2,NULL);CHKERRQ(ierr);
+  ierr = MatSeqSBAIJSetPreallocation(A,1,3,NULL);CHKERRQ(ierr);
+  ierr = MatMPISBAIJSetPreallocation(A,1,3,NULL,2,NULL);CHKERRQ(ierr);
+  ierr = PetscObjectTypeCompareAny((PetscObject)A,&sbaij,MATSEQSBAIJ,MATMPISBAIJ,"");CHKERRQ(ierr);
+  if (sbaij) {ierr = MatSetOption(A,MAT_IGNORE_LOWER_TRIANGULAR,PETSC_TRUE);CHKERRQ(ierr);}
+  ierr = MatGetOwnershipRange(A,&rstart,&rend);CHKERRQ(ierr);
+  for (row=rstart; row<rend; row++) {
+    i = row/m; j = row - i*m;
+    v = -1.0;
+    if (i>0)   {col = row - m; ierr = MatSetValues(A,1,&row,1,&col,&v,INSERT_VALUES);CHKERRQ(ierr);}
+    if (i<m-1) {col = row + m; ierr = MatSetValues(A,1,&row,1,&col,&v,INSERT_VALUES);CHKERRQ(ierr);}
+    if (j>0)   {col = row - 1; ierr = MatSetValues(A,1,&row,1,&col,&v,INSERT_VALUES);CHKERRQ(ierr);}
+    if (j<m-1) {col = row + 1; ierr = MatSetValues(A,1,&row,1,&col,&v,INSERT_VALUES);CHKERRQ(ierr);}
+    v = 4.0; ierr = MatSetValues(A,1,&row,1,&row,&v,INSERT_VALUES);CHKERRQ(ierr);
+  }
+  ierr = MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+
+  ierr = MatCreateVecs(A,&x,&b);CHKERRQ(ierr);
+  ierr = VecDuplicate(b,&r);CHKERRQ(ierr);
+  ierr = VecSet(b,1.0);CHKERRQ(ierr);
+  ierr = VecNorm(b,NORM_2,&bnorm);CHKERRQ(ierr);
+
+  ierr = KSPCreate(PETSC_COMM_WORLD,&ksp);CHKERRQ(ierr);
+  ierr = KSPSetOperators(ksp,A,A);CHKERRQ(ierr);
+  ierr = KSPSetFromOptions(ksp);CHKERRQ(ierr);
+
+  for (s=0; s<=nsteps; s++) {
+    if (s) {
+      /* a localized change of the matrix that keeps its nonzero structure, like contact in a Newton iteration */
+      for (k=0; k<nrows; k++) {
+        row = (37*(s*nrows+k)) % n;
+        if (row < rstart || row >= rend) continue;
+        v    = 0.5*s;
+        ierr = MatSetValues(A,1,&row,1,&row,&v,ADD_VALUES);CHKERRQ(ierr);
+        if (nonsymmetric && row+1 < n && (row+1) % m) {
+          col  = row+1;
+          v    = -0.25;
+          ierr = MatSetValues(A,1,&row,1,&col,&v,ADD_VALUES);CHKERRQ(ierr);
+        }
+      }
+      ierr = MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+      ierr = MatAssemblyEnd(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+    }
+    if (transpose) {
+      ierr = KSPSolveTranspose(ksp,b,x);CHKERRQ(ierr);
+      ierr = MatMultTranspose(A,x,r);CHKERRQ(ierr);
+    } else {
+      ierr = KSPSolve(ksp,b,x);CHKERRQ(ierr);
+      ierr = MatMult(A,x,r);CHKERRQ(ierr);
+    }
+    ierr = KSPGetIterationNumber(ksp,&its);CHKERRQ(ierr);
+    ierr = VecAXPY(r,-1.0,b);CHKERRQ(ierr);
+    ierr = VecNorm(r,NORM_2,&norm);CHKERRQ(ierr);
+    ierr = PetscPrintf(PETSC_COMM_WORLD,"Step %D: number of iterations %D, relative residual norm %s\n",s,its,norm < 1.e-8*bnorm ? "< 1.e-8" : "too large");CHKERRQ(ierr);
+    if (view) {ierr = KSPView(ksp,PETSC_VIEWER_STDOUT_WORLD);CHKERRQ(ierr);}
+  }
+
+  ierr = KSPDestroy(&ksp);CHKERRQ(ierr);
+  ierr = VecDestroy(&x);CHKERRQ(ierr);
+  ierr = VecDestroy(&b);CHKERRQ(ierr);
+  ierr = VecDestroy(&r);CHKERRQ(ierr);
+  ierr = MatDestroy(&A);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   test:
+      suffix: lu
+      args: -ksp_type preonly -pc_type lu -pc_factor_update_rank 3 -nonsymmetric
+
+   test:
+      suffix: lu_transpose
+      args: -ksp_type preonly -pc_type lu -pc_factor_update_rank 3 -nonsymmetric -transpose -pc_factor_mat_ordering_type rcm
+
+   test:
+      suffix: cholesky
+      args: -ksp_type preonly -pc_type cholesky -pc_factor_update_rank 4 -mat_type sbaij
+
+   test:
+      suffix: supernodal
+      args: -ksp_type preonly -pc_type lu -pc_factor_mat_solver_type supernodal -pc_factor_update_rank 3 -nonsymmetric -transpose -m 12
+
+   test:
+      suffix: ilu
+      nsize: 2
+      args: -ksp_type gmres -ksp_rtol 1.e-10 -pc_type bjacobi -sub_pc_type ilu -sub_pc_factor_update_rank 3 -nonsymmetric -m 10
+
+TEST*/
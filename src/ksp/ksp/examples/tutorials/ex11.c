@@ -1,5 +1,7 @@
 
-static char help[] = "Solves a linear system in parallel with KSP.\n\n";
+static char help[] = "Solves a linear system in parallel with KSP.\n\
+Input parameters include:\n\
+  -hermitian : use complex couplings in the x direction, and no imaginary shift, so that the matrix is Hermitian\n\n";
 
 /*T
    Concepts: KSP^solving a Helmholtz equation
@@ -46,11 +48,12 @@ int main(int argc,char **args)
   PetscScalar    v,none = -1.0,sigma2,pfive = 0.5,*xa;
   PetscRandom    rctx;
   PetscReal      h2,sigma1 = 100.0;
-  PetscBool      flg = PETSC_FALSE;
+  PetscBool      flg = PETSC_FALSE,herm = PETSC_FALSE;
 
   ierr = PetscInitialize(&argc,&args,(char*)0,help);if (ierr) return ierr;
   ierr = PetscOptionsGetReal(NULL,NULL,"-sigma1",&sigma1,NULL);CHKERRQ(ierr);
   ierr = PetscOptionsGetInt(NULL,NULL,"-n",&n,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetBool(NULL,NULL,"-hermitian",&herm,NULL);CHKERRQ(ierr);
   dim  = n*n;
 
   /* - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -102,14 +105,17 @@ int main(int argc,char **args)
     if (i<n-1) {
       J = Ii+n; ierr = MatSetValues(A,1,&Ii,1,&J,&v,ADD_VALUES);CHKERRQ(ierr);
     }
+    /* the Hermitian couplings have modulus one, so the spectrum is the one of the Laplacian */
+    if (herm) v = -0.6 - 0.8*PETSC_i;
     if (j>0) {
       J = Ii-1; ierr = MatSetValues(A,1,&Ii,1,&J,&v,ADD_VALUES);CHKERRQ(ierr);
     }
+    if (herm) v = -0.6 + 0.8*PETSC_i;
     if (j<n-1) {
       J = Ii+1; ierr = MatSetValues(A,1,&Ii,1,&J,&v,ADD_VALUES);CHKERRQ(ierr);
     }
     if (use_random) {ierr = PetscRandomGetValue(rctx,&sigma2);CHKERRQ(ierr);}
-    v    = 4.0 - sigma1*h2 + sigma2*h2;
+    v    = 4.0 - sigma1*h2 + (herm ? 0.0 : sigma2*h2);
     ierr = MatSetValues(A,1,&Ii,1,&Ii,&v,ADD_VALUES);CHKERRQ(ierr);
   }
   if (use_random) {ierr = PetscRandomDestroy(&rctx);CHKERRQ(ierr);}
@@ -122,6 +128,12 @@ int main(int argc,char **args)
   */
   ierr = MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
   ierr = MatAssemblyEnd(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  if (herm) {
+    /* SBAIJ needs the flag to multiply with the conjugate of the upper triangle, flagging an AIJ matrix as Hermitian
+       would make MatGetFactor() refuse the Cholesky factorization */
+    ierr = PetscObjectTypeCompareAny((PetscObject)A,&flg,MATSEQSBAIJ,MATMPISBAIJ,"");CHKERRQ(ierr);
+    if (flg) {ierr = MatSetOption(A,MAT_HERMITIAN,PETSC_TRUE);CHKERRQ(ierr);}
+  }
 
   /*
      Create parallel vectors.
@@ -228,4 +240,16 @@ int main(int argc,char **args)
    test:
       args: -n 6 -norandom -pc_type none -ksp_monitor_short -ksp_gmres_cgs_refinement_type refine_always
 
+   testset:
+      output_file: output/ex11_supernodal_hermitian.out
+      args: -n 10 -norandom -hermitian -sigma1 0 -ksp_type preonly -pc_type cholesky -pc_factor_mat_solver_type supernodal -pc_factor_mat_ordering_type rcm -mat_supernodal_max_width 4
+      test:
+         suffix: supernodal_hermitian
+      test:
+         suffix: supernodal_hermitian_sbaij
+         args: -mat_type sbaij -mat_ignore_lower_triangular
+      test:
+         suffix: supernodal_hermitian_shift
+         args: -pc_factor_shift_type nonzero
+
 TEST*/
@@ -287,6 +287,10 @@ int main(int argc,char **args)
       nsize: 4
       args: -pc_type bjacobi -pc_bjacobi_blocks 4 -ksp_monitor_short -sub_pc_type jacobi -sub_ksp_type gmres
 
+   test:
+      suffix: chowilu
+      args: -pc_type ilu -pc_factor_mat_solver_type chowilu -mat_chowilu_factor_sweeps 4 -mat_chowilu_solve_sweeps 3 -ksp_monitor_short
+
    test:
       suffix: fbcgs
       args: -ksp_type fbcgs -pc_type ilu
@@ -340,6 +344,27 @@ int main(int argc,char **args)
       suffix: sell_mumps
       args: -ksp_type preonly -m 9 -n 12 -mat_type sell -pc_type lu -pc_factor_mat_solver_type mumps -pc_factor_mat_ordering_type natural
 
+   test:
+      suffix: supernodal_cholesky
+      args: -ksp_type preonly -pc_type cholesky -mat_type sbaij -pc_factor_mat_solver_type supernodal -pc_factor_mat_ordering_type rcm -m 20 -n 17
+
+   test:
+      suffix: supernodal_lu
+      args: -ksp_type preonly -pc_type lu -pc_factor_mat_solver_type supernodal -mat_supernodal_max_width 8 -m 20 -n 17
+
+   test:
+      suffix: supernodal_lu_shift
+      args: -pc_type lu -pc_factor_mat_solver_type supernodal -pc_factor_shift_type positive_definite -pc_factor_zeropivot 1.0 -m 20 -n 17
+
+   test:
+      suffix: supernodal_cholesky_shift
+      args: -ksp_type preonly -pc_type cholesky -mat_type sbaij -pc_factor_mat_solver_type supernodal -pc_factor_shift_type nonzero -pc_factor_mat_ordering_type rcm -m 20 -n 17
+
+   test:
+      suffix: mlnd
+      args: -ksp_type preonly -pc_type cholesky -pc_factor_mat_ordering_type mlnd -mat_ordering_mlnd_leaf_size 16 -m 40 -n 37 -ksp_view
+      filter: egrep "(matrix ordering|fill ratio|Norm of error)"
+
    test:
       suffix: telescope
       nsize: 4
@@ -1901,6 +1901,10 @@ static PetscErrorCode DMDABCApplyFreeSlip(DM da_Stokes,Mat A,Vec f)
       nsize: 8
       args: -stokes_ksp_view -stokes_pc_type mg -stokes_pc_mg_levels 2 -stokes_mg_coarse_pc_type telescope -stokes_mg_coarse_pc_telescope_reduction_factor 2 -stokes_pc_use_amat false -stokes_pc_mg_galerkin pmat -stokes_mg_coarse_pc_telescope_subcomm_type contiguous
 
+   test:
+      suffix: schur_hodlr
+      args: -stokes_ksp_type fgmres -stokes_pc_type fieldsplit -stokes_pc_fieldsplit_type schur -stokes_pc_fieldsplit_schur_precondition full -stokes_pc_fieldsplit_schur_hodlr_tol 1e-6 -stokes_pc_fieldsplit_schur_hodlr_leaf_size 16 -stokes_fieldsplit_u_ksp_type preonly -stokes_fieldsplit_u_pc_type lu -stokes_fieldsplit_p_ksp_type preonly -stokes_fieldsplit_p_pc_type lu -c_str 3 -mx 16 -my 16 -stokes_ksp_monitor_short
+
    test:
       suffix: bjacobi
       nsize: 4
@@ -158,6 +158,26 @@ PetscErrorCode ComputeMatrix(KSP ksp,Mat jac,Mat B,void *ctx)
       nsize: 4
       args: -ksp_monitor_short -da_grid_x 21 -da_grid_y 21 -da_grid_z 21 -pc_type mg -pc_mg_levels 3 -mg_levels_ksp_type richardson -mg_levels_ksp_max_it 1 -mg_levels_pc_type bjacobi
 
+   test:
+      suffix: additive_afacx
+      nsize: 4
+      args: -ksp_converged_reason -da_grid_x 21 -da_grid_y 21 -da_grid_z 21 -pc_type mg -pc_mg_levels 3 -pc_mg_type additive -pc_mg_additive_type afacx -mg_levels_ksp_type chebyshev -mg_levels_pc_type jacobi
+
+   test:
+      suffix: additive_mult
+      nsize: 4
+      args: -ksp_converged_reason -da_grid_x 21 -da_grid_y 21 -da_grid_z 21 -pc_type mg -pc_mg_levels 3 -pc_mg_type additive -pc_mg_additive_type mult -mg_levels_ksp_type chebyshev -mg_levels_pc_type jacobi
+
+   test:
+      suffix: dastencil
+      nsize: 4
+      args: -ksp_type cg -ksp_converged_reason -dm_mat_type dastencil -da_grid_x 21 -da_grid_y 21 -da_grid_z 21 -pc_type mg -pc_mg_levels 3 -mg_levels_ksp_type chebyshev -mg_levels_pc_type jacobi -mg_coarse_ksp_type chebyshev -mg_coarse_ksp_max_it 20 -mg_coarse_pc_type jacobi
+
+   test:
+      suffix: dastencil_sor
+      nsize: 4
+      args: -ksp_type cg -ksp_converged_reason -dm_mat_type dastencil -da_grid_x 21 -da_grid_y 21 -da_grid_z 21 -pc_type mg -pc_mg_levels 3 -mg_levels_ksp_type richardson -mg_levels_pc_type sor -mg_levels_pc_sor_its 2 -mg_coarse_ksp_type richardson -mg_coarse_ksp_max_it 20 -mg_coarse_pc_type sor
+
    test:
       suffix: telescope
       nsize: 4
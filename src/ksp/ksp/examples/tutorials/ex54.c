@@ -227,4 +227,18 @@ int main(int argc,char **args)
       requires: triangle
       output_file: output/ex54_0.out
 
+   test:
+      suffix: mis2
+      nsize: 4
+      args: -ne 49 -alpha 1.e-3 -ksp_type cg -pc_type gamg -pc_gamg_type agg -pc_gamg_agg_nsmooths 1 -ksp_converged_reason -mg_levels_esteig_ksp_type cg -mat_coarsen_type mis2
+
+   test:
+      suffix: mis2_seq
+      args: -ne 49 -alpha 1.e-3 -ksp_type cg -pc_type gamg -pc_gamg_type agg -pc_gamg_agg_nsmooths 1 -ksp_converged_reason -mg_levels_esteig_ksp_type cg -mat_coarsen_type mis2 -mat_coarsen_mis2_seed 7
+
+   test:
+      suffix: cost_model
+      nsize: 4
+      args: -ne 99 -alpha 1.e-3 -ksp_type cg -pc_type gamg -pc_gamg_type agg -pc_gamg_agg_nsmooths 1 -ksp_converged_reason -mg_levels_esteig_ksp_type cg -pc_gamg_process_cost_model -pc_gamg_process_cost_latency 1.e-4
+
 TEST*/
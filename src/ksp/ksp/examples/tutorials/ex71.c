@@ -438,6 +438,10 @@ int main(int argc,char **args)
    filter: grep -v "variant HERMITIAN"
    suffix: bddc_elast_both_approx
    args: -pde_type Elasticity -cells 7,9,8 -dim 3 -ksp_view -pc_bddc_coarse_redundant_pc_type svd -ksp_error_if_not_converged -pc_bddc_monolithic -pc_bddc_dirichlet_pc_type ml -pc_bddc_neumann_pc_type ml -ksp_monitor_short -ksp_converged_reason -pc_bddc_neumann_approximate -pc_bddc_dirichlet_approximate
+ test:
+   nsize: 4
+   suffix: bddc_deluxe_hodlr
+   args: -pde_type Poisson -dim 2 -cells 40,40 -ksp_monitor_short -pc_bddc_coarse_redundant_pc_type svd -ksp_error_if_not_converged -pc_bddc_use_deluxe_scaling -pc_bddc_deluxe_hodlr_tol 1e-6 -pc_bddc_deluxe_hodlr_leaf_size 4
  test:
    nsize: 8
    filter: grep -v "variant HERMITIAN"
@@ -8,6 +8,7 @@ static PetscErrorCode KSPReset_Chebyshev(KSP ksp)
 
   PetscFunctionBegin;
   ierr = KSPReset(cheb->kspest);CHKERRQ(ierr);
+  ierr = VecDestroy(&cheb->evec);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -83,6 +84,34 @@ static PetscErrorCode KSPChebyshevEstEigSetUseNoisy_Chebyshev(KSP ksp,PetscBool
   PetscFunctionReturn(0);
 }
 
+static PetscErrorCode KSPChebyshevEstEigSetRefine_Chebyshev(KSP ksp,PetscInt steps)
+{
+  KSP_Chebyshev  *cheb = (KSP_Chebyshev*)ksp->data;
+
+  PetscFunctionBegin;
+  if (steps < 0) SETERRQ1(PetscObjectComm((PetscObject)ksp),PETSC_ERR_ARG_OUTOFRANGE,"Number of refinement steps %D must be nonnegative",steps);
+  cheb->refinesteps = steps;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode KSPChebyshevSetKind_Chebyshev(KSP ksp,KSPChebyshevKind kind)
+{
+  KSP_Chebyshev  *cheb = (KSP_Chebyshev*)ksp->data;
+
+  PetscFunctionBegin;
+  cheb->kind = kind;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode KSPChebyshevGetKind_Chebyshev(KSP ksp,KSPChebyshevKind *kind)
+{
+  KSP_Chebyshev  *cheb = (KSP_Chebyshev*)ksp->data;
+
+  PetscFunctionBegin;
+  *kind = cheb->kind;
+  PetscFunctionReturn(0);
+}
+
 /*@
    KSPChebyshevSetEigenvalues - Sets estimates for the extreme eigenvalues
    of the preconditioned problem.
@@ -192,6 +221,103 @@ PetscErrorCode KSPChebyshevEstEigSetUseNoisy(KSP ksp,PetscBool use)
   PetscFunctionReturn(0);
 }
 
+/*@
+   KSPChebyshevEstEigSetRefine - when only the values of the operators change, update the eigenvalue estimates with a
+   few power iterations instead of running the Krylov estimator again
+
+   Logically Collective
+
+   Input Arguments:
++  ksp - linear solver context
+-  steps - number of power iterations, 0 (the default) to always run the Krylov estimator
+
+   Options Database:
+.  -ksp_chebyshev_esteig_refine <steps>
+
+   Notes:
+   An approximate dominant eigenvector of the preconditioned operator is kept between solves. When the operators are the
+   same objects as for the previous estimate but their values changed, the norm of the new preconditioned operator
+   applied to this vector, compared with its value for the previous operators, gives the relative change of the largest
+   eigenvalue; both Krylov estimates are scaled by it. The remaining steps improve the vector for the next update.
+   The Krylov estimator is still used when the operators are new objects.
+
+   Each step costs one matrix-vector product and one preconditioner application, against the
+   -ksp_chebyshev_esteig_steps of the Krylov estimator, which makes it useful in nonlinear and time-stepping loops
+   where the operators change slightly at each solve.
+
+   Level: intermediate
+
+.seealso: KSPChebyshevEstEigSet(), KSPChebyshevEstEigSetUseNoisy()
+@*/
+PetscErrorCode KSPChebyshevEstEigSetRefine(KSP ksp,PetscInt steps)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ksp,KSP_CLASSID,1);
+  PetscValidLogicalCollectiveInt(ksp,steps,2);
+  ierr = PetscTryMethod(ksp,"KSPChebyshevEstEigSetRefine_C",(KSP,PetscInt),(ksp,steps));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@
+   KSPChebyshevSetKind - set the kind of Chebyshev polynomial to use
+
+   Logically Collective
+
+   Input Arguments:
++  ksp - linear solver context
+-  kind - KSP_CHEBYSHEV_FIRST or KSP_CHEBYSHEV_FOURTH
+
+   Options Database:
+.  -ksp_chebyshev_kind <first,fourth>
+
+   Notes:
+   The fourth kind polynomial of Lottes only uses the upper bound of the spectrum, so only the maximum eigenvalue
+   estimate and the transform entries for the maximum bound matter. As a multigrid smoother it does not depend on the
+   choice of the lower bound, which the first kind polynomial needs to target the upper part of the spectrum.
+
+   Level: intermediate
+
+.seealso: KSPChebyshevGetKind(), KSPChebyshevKind, KSPChebyshevEstEigSet()
+@*/
+PetscErrorCode KSPChebyshevSetKind(KSP ksp,KSPChebyshevKind kind)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ksp,KSP_CLASSID,1);
+  PetscValidLogicalCollectiveEnum(ksp,kind,2);
+  ierr = PetscTryMethod(ksp,"KSPChebyshevSetKind_C",(KSP,KSPChebyshevKind),(ksp,kind));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@
+   KSPChebyshevGetKind - get the kind of Chebyshev polynomial used
+
+   Not Collective
+
+   Input Argument:
+.  ksp - linear solver context
+
+   Output Argument:
+.  kind - the kind of polynomial
+
+   Level: intermediate
+
+.seealso: KSPChebyshevSetKind(), KSPChebyshevKind
+@*/
+PetscErrorCode KSPChebyshevGetKind(KSP ksp,KSPChebyshevKind *kind)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ksp,KSP_CLASSID,1);
+  PetscValidPointer(kind,2);
+  ierr = PetscUseMethod(ksp,"KSPChebyshevGetKind_C",(KSP,KSPChebyshevKind*),(ksp,kind));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 /*@
   KSPChebyshevEstEigGetKSP - Get the Krylov method context used to estimate eigenvalues for the Chebyshev method.  If
   a Krylov method is not being used for this purpose, NULL is returned.  The reference count of the returned KSP is
@@ -238,6 +364,7 @@ static PetscErrorCode KSPSetFromOptions_Chebyshev(PetscOptionItems *PetscOptions
 
   PetscFunctionBegin;
   ierr = PetscOptionsHead(PetscOptionsObject,"KSP Chebyshev Options");CHKERRQ(ierr);
+  ierr = PetscOptionsEnum("-ksp_chebyshev_kind","Kind of Chebyshev polynomial","KSPChebyshevSetKind",KSPChebyshevKinds,(PetscEnum)cheb->kind,(PetscEnum*)&cheb->kind,NULL);CHKERRQ(ierr);
   ierr = PetscOptionsInt("-ksp_chebyshev_esteig_steps","Number of est steps in Chebyshev","",cheb->eststeps,&cheb->eststeps,NULL);CHKERRQ(ierr);
   ierr = PetscOptionsRealArray("-ksp_chebyshev_eigenvalues","extreme eigenvalues","KSPChebyshevSetEigenvalues",eminmax,&neigarg,&flgeig);CHKERRQ(ierr);
   if (flgeig) {
@@ -267,6 +394,7 @@ static PetscErrorCode KSPSetFromOptions_Chebyshev(PetscOptionItems *PetscOptions
 
   if (cheb->kspest) {
     ierr = PetscOptionsBool("-ksp_chebyshev_esteig_noisy","Use noisy right hand side for estimate","KSPChebyshevEstEigSetUseNoisy",cheb->usenoisy,&cheb->usenoisy,NULL);CHKERRQ(ierr);
+    ierr = PetscOptionsInt("-ksp_chebyshev_esteig_refine","Power iterations to update the estimate when only the operator values change","KSPChebyshevEstEigSetRefine",cheb->refinesteps,&cheb->refinesteps,NULL);CHKERRQ(ierr);
     ierr = KSPSetFromOptions(cheb->kspest);CHKERRQ(ierr);
   }
   ierr = PetscOptionsTail();CHKERRQ(ierr);
@@ -307,6 +435,136 @@ PETSC_STATIC_INLINE PetscScalar chebyhash(PetscInt xx)
   return (PetscScalar)((PetscInt64)x-2147483648)*5.e-10; /* center around zero, scaled about -1. to 1.*/
 }
 
+/*
+   Applies cheb->refinesteps power iterations of the preconditioned operator to cheb->evec. Returns in ratio the norm of
+   the operator applied to the starting vector, relative to the one stored for the previous operators (before the
+   vector is changed), and leaves in cheb->evecrho the norm for the final vector and the current operators.
+*/
+static PetscErrorCode KSPChebyshevPowerRefine_Private(KSP ksp,Mat Amat,PetscReal *ratio)
+{
+  KSP_Chebyshev  *cheb = (KSP_Chebyshev*)ksp->data;
+  PetscErrorCode ierr;
+  PetscInt       i;
+  PetscReal      nrm,rho = 0.0;
+  Vec            w = ksp->work[0],t = ksp->work[2];
+
+  PetscFunctionBegin;
+  *ratio = 1.0;
+  if (!cheb->evec) {
+    PetscInt    n,istart;
+    PetscScalar *xx;
+
+    ierr = VecDuplicate(ksp->vec_rhs,&cheb->evec);CHKERRQ(ierr);
+    ierr = PetscLogObjectParent((PetscObject)ksp,(PetscObject)cheb->evec);CHKERRQ(ierr);
+    ierr = VecGetOwnershipRange(cheb->evec,&istart,NULL);CHKERRQ(ierr);
+    ierr = VecGetLocalSize(cheb->evec,&n);CHKERRQ(ierr);
+    ierr = VecGetArray(cheb->evec,&xx);CHKERRQ(ierr);
+    for (i=0; i<n; i++) xx[i] = chebyhash(i+istart);
+    ierr = VecRestoreArray(cheb->evec,&xx);CHKERRQ(ierr);
+    cheb->evecrho = 0.0;
+  }
+  ierr = VecNormalize(cheb->evec,&nrm);CHKERRQ(ierr);
+  for (i=0; i<cheb->refinesteps; i++) {
+    ierr = KSP_MatMult(ksp,Amat,cheb->evec,t);CHKERRQ(ierr);
+    ierr = KSP_PCApply(ksp,t,w);CHKERRQ(ierr);
+    ierr = VecNorm(w,NORM_2,&rho);CHKERRQ(ierr);
+    if (!i && cheb->evecrho > 0.0) *ratio = rho/cheb->evecrho;
+    if (i < cheb->refinesteps-1 && rho > 0.0) {
+      ierr = VecAXPBY(cheb->evec,1.0/rho,0.0,w);CHKERRQ(ierr);
+    }
+  }
+  cheb->evecrho = rho;
+  PetscFunctionReturn(0);
+}
+
+/*
+   Fourth kind Chebyshev smoother, from Lottes, Optimal polynomial smoothers for multigrid V-cycles, 2022.
+   It only uses the upper bound emax of the spectrum of the preconditioned operator.
+*/
+static PetscErrorCode KSPSolve_Chebyshev_FourthKind(KSP ksp)
+{
+  KSP_Chebyshev  *cheb = (KSP_Chebyshev*)ksp->data;
+  PetscErrorCode ierr;
+  PetscInt       i,maxit = ksp->max_it;
+  PetscReal      rnorm = 0.0,emax = cheb->emax;
+  Vec            x,b,d,p,r;
+  Mat            Amat,Pmat;
+  PetscBool      usenorm = (PetscBool)(ksp->normtype != KSP_NORM_NONE || ksp->numbermonitors),applied;
+
+  PetscFunctionBegin;
+  ierr = PCGetOperators(ksp->pc,&Amat,&Pmat);CHKERRQ(ierr);
+  x = ksp->vec_sol;
+  b = ksp->vec_rhs;
+  d = ksp->work[0];
+  p = ksp->work[1];
+  r = ksp->work[2];
+
+  if (!ksp->guess_zero) {
+    ierr = KSP_MatMult(ksp,Amat,x,r);CHKERRQ(ierr);     /*  r = b - A*x */
+    ierr = VecAYPX(r,-1.0,b);CHKERRQ(ierr);
+  } else {
+    ierr = VecCopy(b,r);CHKERRQ(ierr);
+  }
+  ierr = KSP_PCApply(ksp,r,p);CHKERRQ(ierr);            /* p = B^{-1} r */
+
+  ksp->its = 0;
+  if (usenorm) {
+    if (ksp->normtype == KSP_NORM_UNPRECONDITIONED) {
+      ierr = VecNorm(r,NORM_2,&rnorm);CHKERRQ(ierr);
+    } else {
+      ierr = VecNorm(p,NORM_2,&rnorm);CHKERRQ(ierr);
+    }
+    ierr       = PetscObjectSAWsTakeAccess((PetscObject)ksp);CHKERRQ(ierr);
+    ksp->rnorm = rnorm;
+    ierr       = PetscObjectSAWsGrantAccess((PetscObject)ksp);CHKERRQ(ierr);
+    ierr = KSPLogResidualHistory(ksp,rnorm);CHKERRQ(ierr);
+    ierr = KSPMonitor(ksp,0,rnorm);CHKERRQ(ierr);
+    ierr = (*ksp->converged)(ksp,0,rnorm,&ksp->reason,ksp->cnvP);CHKERRQ(ierr);
+    if (ksp->reason) PetscFunctionReturn(0);
+  }
+
+  /* d_0 = 4/(3 emax) B^{-1} r_0 */
+  ierr = VecAXPBY(d,4.0/(3.0*emax),0.0,p);CHKERRQ(ierr);
+  for (i=1; i<=maxit; i++) {
+    ierr = PetscObjectSAWsTakeAccess((PetscObject)ksp);CHKERRQ(ierr);
+    ksp->its++;
+    ierr = PetscObjectSAWsGrantAccess((PetscObject)ksp);CHKERRQ(ierr);
+
+    /* x_i = x_{i-1} + d_{i-1}, r_i = r_{i-1} - A d_{i-1} */
+    ierr = VecAXPY(x,1.0,d);CHKERRQ(ierr);
+    ierr = KSP_MatMult(ksp,Amat,d,p);CHKERRQ(ierr);
+    ierr = VecAXPY(r,-1.0,p);CHKERRQ(ierr);
+
+    applied = PETSC_FALSE;
+    if (usenorm) {
+      if (ksp->normtype == KSP_NORM_UNPRECONDITIONED) {
+        ierr = VecNorm(r,NORM_2,&rnorm);CHKERRQ(ierr);
+      } else {
+        ierr    = KSP_PCApply(ksp,r,p);CHKERRQ(ierr);
+        ierr    = VecNorm(p,NORM_2,&rnorm);CHKERRQ(ierr);
+        applied = PETSC_TRUE;
+      }
+      ierr       = PetscObjectSAWsTakeAccess((PetscObject)ksp);CHKERRQ(ierr);
+      ksp->rnorm = rnorm;
+      ierr       = PetscObjectSAWsGrantAccess((PetscObject)ksp);CHKERRQ(ierr);
+      ierr = KSPLogResidualHistory(ksp,rnorm);CHKERRQ(ierr);
+      ierr = KSPMonitor(ksp,i,rnorm);CHKERRQ(ierr);
+      ierr = (*ksp->converged)(ksp,i,rnorm,&ksp->reason,ksp->cnvP);CHKERRQ(ierr);
+      if (ksp->reason) break;
+    }
+    if (i == maxit) break;
+
+    /* d_i = (2i-1)/(2i+3) d_{i-1} + (8i+4)/((2i+3) emax) B^{-1} r_i */
+    if (!applied) {ierr = KSP_PCApply(ksp,r,p);CHKERRQ(ierr);}
+    ierr = VecAXPBY(d,(8.0*i+4.0)/((2.0*i+3.0)*emax),(2.0*i-1.0)/(2.0*i+3.0),p);CHKERRQ(ierr);
+  }
+  if (!ksp->reason) {
+    if (ksp->normtype != KSP_NORM_NONE) ksp->reason = KSP_DIVERGED_ITS;
+    else ksp->reason = KSP_CONVERGED_ITS;
+  }
+  PetscFunctionReturn(0);
+}
+
 static PetscErrorCode KSPSolve_Chebyshev(KSP ksp)
 {
   KSP_Chebyshev  *cheb = (KSP_Chebyshev*)ksp->data;
@@ -331,7 +589,20 @@ static PetscErrorCode KSPSolve_Chebyshev(KSP ksp)
     ierr = PetscObjectGetId((PetscObject)Pmat,&pmatid);CHKERRQ(ierr);
     ierr = PetscObjectStateGet((PetscObject)Amat,&amatstate);CHKERRQ(ierr);
     ierr = PetscObjectStateGet((PetscObject)Pmat,&pmatstate);CHKERRQ(ierr);
-    if (amatid != cheb->amatid || pmatid != cheb->pmatid || amatstate != cheb->amatstate || pmatstate != cheb->pmatstate) {
+    if (cheb->refinesteps && cheb->evec && amatid == cheb->amatid && pmatid == cheb->pmatid && (amatstate != cheb->amatstate || pmatstate != cheb->pmatstate)) {
+      PetscReal ratio;
+
+      /* only the values of the operators changed, update the previous estimates with a few power iterations */
+      ierr = KSPChebyshevPowerRefine_Private(ksp,Amat,&ratio);CHKERRQ(ierr);
+      ierr = PetscInfo1(ksp,"Operator values changed, scaling eigenvalue estimates by %g from power iteration\n",(double)ratio);CHKERRQ(ierr);
+      cheb->emin_computed *= ratio;
+      cheb->emax_computed *= ratio;
+      cheb->emin = cheb->tform[0]*cheb->emin_computed + cheb->tform[1]*cheb->emax_computed;
+      cheb->emax = cheb->tform[2]*cheb->emin_computed + cheb->tform[3]*cheb->emax_computed;
+
+      cheb->amatstate = amatstate;
+      cheb->pmatstate = pmatstate;
+    } else if (amatid != cheb->amatid || pmatid != cheb->pmatid || amatstate != cheb->amatstate || pmatstate != cheb->pmatstate) {
       PetscReal          max=0.0,min=0.0;
       Vec                B;
       KSPConvergedReason reason;
@@ -398,8 +669,19 @@ static PetscErrorCode KSPSolve_Chebyshev(KSP ksp)
       cheb->pmatid    = pmatid;
       cheb->amatstate = amatstate;
       cheb->pmatstate = pmatstate;
+
+      if (cheb->refinesteps) {
+        PetscReal ratio;
+
+        /* prepare the vector used to update the estimates when only the values of the operators change */
+        ierr = KSPChebyshevPowerRefine_Private(ksp,Amat,&ratio);CHKERRQ(ierr);
+      }
     }
   }
+  if (cheb->kind == KSP_CHEBYSHEV_FOURTH) {
+    ierr = KSPSolve_Chebyshev_FourthKind(ksp);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
 
   ksp->its = 0;
   maxit    = ksp->max_it;
@@ -515,7 +797,11 @@ static  PetscErrorCode KSPView_Chebyshev(KSP ksp,PetscViewer viewer)
   PetscFunctionBegin;
   ierr = PetscObjectTypeCompare((PetscObject)viewer,PETSCVIEWERASCII,&iascii);CHKERRQ(ierr);
   if (iascii) {
-    ierr = PetscViewerASCIIPrintf(viewer,"  eigenvalue estimates used:  min = %g, max = %g\n",(double)cheb->emin,(double)cheb->emax);CHKERRQ(ierr);
+    if (cheb->kind == KSP_CHEBYSHEV_FOURTH) {
+      ierr = PetscViewerASCIIPrintf(viewer,"  fourth kind Chebyshev polynomial, upper bound of the spectrum used:  max = %g\n",(double)cheb->emax);CHKERRQ(ierr);
+    } else {
+      ierr = PetscViewerASCIIPrintf(viewer,"  eigenvalue estimates used:  min = %g, max = %g\n",(double)cheb->emin,(double)cheb->emax);CHKERRQ(ierr);
+    }
     if (cheb->kspest) {
       ierr = PetscViewerASCIIPrintf(viewer,"  eigenvalues estimate via %s min %g, max %g\n",((PetscObject)(cheb->kspest))->type_name,(double)cheb->emin_computed,(double)cheb->emax_computed);CHKERRQ(ierr);
       ierr = PetscViewerASCIIPrintf(viewer,"  eigenvalues estimated using %s with translations  [%g %g; %g %g]\n",((PetscObject) cheb->kspest)->type_name,(double)cheb->tform[0],(double)cheb->tform[1],(double)cheb->tform[2],(double)cheb->tform[3]);CHKERRQ(ierr);
@@ -525,6 +811,9 @@ static  PetscErrorCode KSPView_Chebyshev(KSP ksp,PetscViewer viewer)
       if (cheb->usenoisy) {
         ierr = PetscViewerASCIIPrintf(viewer,"  estimating eigenvalues using noisy right hand side\n");CHKERRQ(ierr);
       }
+      if (cheb->refinesteps) {
+        ierr = PetscViewerASCIIPrintf(viewer,"  updating the estimates with %D power iterations when only the operator values change\n",cheb->refinesteps);CHKERRQ(ierr);
+      }
     }
   }
   PetscFunctionReturn(0);
@@ -537,10 +826,14 @@ static PetscErrorCode KSPDestroy_Chebyshev(KSP ksp)
 
   PetscFunctionBegin;
   ierr = KSPDestroy(&cheb->kspest);CHKERRQ(ierr);
+  ierr = VecDestroy(&cheb->evec);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPChebyshevSetEigenvalues_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPChebyshevEstEigSet_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPChebyshevEstEigSetUseNoisy_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPChebyshevEstEigGetKSP_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPChebyshevEstEigSetRefine_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPChebyshevSetKind_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPChebyshevGetKind_C",NULL);CHKERRQ(ierr);
   ierr = KSPDestroyDefault(ksp);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
@@ -554,7 +847,9 @@ static PetscErrorCode KSPDestroy_Chebyshev(KSP ksp)
 .   -ksp_chebyshev_esteig <a,b,c,d> - estimate eigenvalues using a Krylov method, then use this
                          transform for Chebyshev eigenvalue bounds (KSPChebyshevEstEigSet())
 .   -ksp_chebyshev_esteig_steps - number of estimation steps
--   -ksp_chebyshev_esteig_noisy - use noisy number generator to create right hand side for eigenvalue estimator
+.   -ksp_chebyshev_esteig_noisy - use noisy number generator to create right hand side for eigenvalue estimator
+.   -ksp_chebyshev_esteig_refine <steps> - update the estimates with this many power iterations when only the values of the operators change (KSPChebyshevEstEigSetRefine())
+-   -ksp_chebyshev_kind <first,fourth> - kind of Chebyshev polynomial (KSPChebyshevSetKind())
 
    Level: beginner
 
@@ -567,7 +862,8 @@ static PetscErrorCode KSPDestroy_Chebyshev(KSP ksp)
           The user should call KSPChebyshevSetEigenvalues() if they have eigenvalue estimates.
 
 .seealso:  KSPCreate(), KSPSetType(), KSPType (for list of available types), KSP,
-           KSPChebyshevSetEigenvalues(), KSPChebyshevEstEigSet(), KSPChebyshevEstEigSetUseNoisy()
+           KSPChebyshevSetEigenvalues(), KSPChebyshevEstEigSet(), KSPChebyshevEstEigSetUseNoisy(),
+           KSPChebyshevEstEigSetRefine(), KSPChebyshevSetKind()
            KSPRICHARDSON, KSPCG, PCMG
 
 M*/
@@ -595,6 +891,7 @@ PETSC_EXTERN PetscErrorCode KSPCreate_Chebyshev(KSP ksp)
   chebyshevP->tform[3] = 1.1;
   chebyshevP->eststeps = 10;
   chebyshevP->usenoisy = PETSC_TRUE;
+  chebyshevP->kind     = KSP_CHEBYSHEV_FIRST;
 
   ksp->ops->setup          = KSPSetUp_Chebyshev;
   ksp->ops->solve          = KSPSolve_Chebyshev;
@@ -609,5 +906,8 @@ PETSC_EXTERN PetscErrorCode KSPCreate_Chebyshev(KSP ksp)
   ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPChebyshevEstEigSet_C",KSPChebyshevEstEigSet_Chebyshev);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPChebyshevEstEigSetUseNoisy_C",KSPChebyshevEstEigSetUseNoisy_Chebyshev);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPChebyshevEstEigGetKSP_C",KSPChebyshevEstEigGetKSP_Chebyshev);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPChebyshevEstEigSetRefine_C",KSPChebyshevEstEigSetRefine_Chebyshev);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPChebyshevSetKind_C",KSPChebyshevSetKind_Chebyshev);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPChebyshevGetKind_C",KSPChebyshevGetKind_Chebyshev);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
@@ -14,6 +14,11 @@ typedef struct {
   PetscReal        tform[4];     /* transform from Krylov estimates to Chebyshev bounds */
   PetscInt         eststeps;     /* number of kspest steps in KSP used to estimate eigenvalues */
   PetscBool        usenoisy;    /* use noisy right hand side vector to estimate eigenvalues */
+  KSPChebyshevKind kind;        /* first or fourth kind polynomial */
+  /* For updating the estimates with a few power iterations when only the values of the operators change */
+  PetscInt         refinesteps;  /* number of power iterations, 0 to always redo the Krylov estimate */
+  Vec              evec;         /* approximate dominant eigenvector of the preconditioned operator */
+  PetscReal        evecrho;      /* norm of the preconditioned operator applied to evec, for the last operators */
   /* For tracking when to update the eigenvalue estimates */
   PetscObjectId    amatid,    pmatid;
   PetscObjectState amatstate, pmatstate;
@@ -85,6 +85,8 @@ PetscErrorCode PCSetFromOptions_BDDC(PetscOptionItems *PetscOptionsObject,PC pc)
   ierr = PetscOptionsBool("-pc_bddc_schur_exact","Whether or not to use the exact Schur complement instead of the reduced one (which excludes size 1 cc)","none",pcbddc->sub_schurs_exact_schur,&pcbddc->sub_schurs_exact_schur,NULL);CHKERRQ(ierr);
   ierr = PetscOptionsBool("-pc_bddc_deluxe_zerorows","Zero rows and columns of deluxe operators associated with primal dofs","none",pcbddc->deluxe_zerorows,&pcbddc->deluxe_zerorows,NULL);CHKERRQ(ierr);
   ierr = PetscOptionsBool("-pc_bddc_deluxe_singlemat","Collapse deluxe operators","none",pcbddc->deluxe_singlemat,&pcbddc->deluxe_singlemat,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsReal("-pc_bddc_deluxe_hodlr_tol","Compress deluxe operators to HODLR matrices with this tolerance (0 means no compression)","none",pcbddc->deluxe_hodlr_tol,&pcbddc->deluxe_hodlr_tol,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-pc_bddc_deluxe_hodlr_leaf_size","Leaf size of the HODLR deluxe operators","none",pcbddc->deluxe_hodlr_leaf_size,&pcbddc->deluxe_hodlr_leaf_size,NULL);CHKERRQ(ierr);
   ierr = PetscOptionsBool("-pc_bddc_adaptive_userdefined","Use user-defined constraints (should be attached via MatSetNearNullSpace to pmat) in addition to those adaptively generated","none",pcbddc->adaptive_userdefined,&pcbddc->adaptive_userdefined,NULL);CHKERRQ(ierr);
   nt   = 2;
   ierr = PetscOptionsRealArray("-pc_bddc_adaptive_threshold","Thresholds to be used for adaptive selection of constraints","none",pcbddc->adaptive_threshold,&nt,NULL);CHKERRQ(ierr);
@@ -154,6 +156,9 @@ static PetscErrorCode PCView_BDDC(PC pc,PetscViewer viewer)
     ierr = PetscViewerASCIIPrintf(viewer,"  Use deluxe scaling: %d\n",pcbddc->use_deluxe_scaling);CHKERRQ(ierr);
     ierr = PetscViewerASCIIPrintf(viewer,"  Use deluxe zerorows: %d\n",pcbddc->deluxe_zerorows);CHKERRQ(ierr);
     ierr = PetscViewerASCIIPrintf(viewer,"  Use deluxe singlemat: %d\n",pcbddc->deluxe_singlemat);CHKERRQ(ierr);
+    if (pcbddc->deluxe_hodlr_tol > 0.0) {
+      ierr = PetscViewerASCIIPrintf(viewer,"  Deluxe HODLR tolerance and leaf size: %g %D\n",(double)pcbddc->deluxe_hodlr_tol,pcbddc->deluxe_hodlr_leaf_size);CHKERRQ(ierr);
+    }
     ierr = PetscViewerASCIIPrintf(viewer,"  Rebuild interface graph for Schur principal minors: %d\n",pcbddc->sub_schurs_rebuild);CHKERRQ(ierr);
     ierr = PetscViewerASCIIPrintf(viewer,"  Number of dofs' layers for the computation of principal minors: %D\n",pcbddc->sub_schurs_layers);CHKERRQ(ierr);
     ierr = PetscViewerASCIIPrintf(viewer,"  Use user CSR graph to compute successive layers: %d\n",pcbddc->sub_schurs_use_useradj);CHKERRQ(ierr);
@@ -2111,6 +2116,7 @@ PetscErrorCode PCReset_BDDC(PC pc)
   pcbddc->nedglobal                 = PETSC_TRUE;
   pcbddc->graphmaxcount             = PETSC_MAX_INT;
   pcbddc->sub_schurs_layers         = -1;
+  pcbddc->deluxe_hodlr_leaf_size    = 32;
   pcbddc->ksp_D                     = kspD;
   pcbddc->ksp_R                     = kspR;
   pcbddc->coarse_ksp                = kspC;
@@ -2559,6 +2565,7 @@ PetscErrorCode PCBDDCCreateFETIDPOperators(PC pc, PetscBool fully_redundant, con
 .    -pc_bddc_coarsening_ratio <8> - number of subdomains which will be aggregated together at the coarser level (e.g. H/h ratio at the coarser level, significative only in the multilevel case)
 .    -pc_bddc_coarse_redistribute <0> - size of a subset of processors where the coarse problem will be remapped (the value is ignored if not at the coarsest level)
 .    -pc_bddc_use_deluxe_scaling <false> - use deluxe scaling
+.    -pc_bddc_deluxe_hodlr_tol <0.0> - when a positive value is specified, the deluxe operators of large interface subsets are compressed to MATHODLR matrices after being computed as dense matrices, this makes applying the scaling cheaper
 .    -pc_bddc_schur_layers <-1> - select the economic version of deluxe scaling by specifying the number of layers (-1 corresponds to the original deluxe scaling)
 .    -pc_bddc_adaptive_threshold <0.0> - when a value different than zero is specified, adaptive selection of constraints is performed on edges and faces (requires deluxe scaling and MUMPS or MKL_PARDISO installed)
 -    -pc_bddc_check_level <0> - set verbosity level of debugging output
@@ -2624,6 +2631,7 @@ PETSC_EXTERN PetscErrorCode PCCreate_BDDC(PC pc)
   pcbddc->nedglobal                 = PETSC_TRUE;
   pcbddc->graphmaxcount             = PETSC_MAX_INT;
   pcbddc->sub_schurs_layers         = -1;
+  pcbddc->deluxe_hodlr_leaf_size    = 32;
   pcbddc->adaptive_threshold[0]     = 0.0;
   pcbddc->adaptive_threshold[1]     = 0.0;
 
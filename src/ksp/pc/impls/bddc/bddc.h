@@ -143,6 +143,8 @@ typedef struct {
   PCBDDCDeluxeScaling deluxe_ctx;
   PetscBool           deluxe_zerorows;
   PetscBool           deluxe_singlemat;
+  PetscReal           deluxe_hodlr_tol;
+  PetscInt            deluxe_hodlr_leaf_size;
 
   /* schur complements on interface's subsets */
   PCBDDCSubSchurs sub_schurs;
@@ -537,7 +537,24 @@ static PetscErrorCode PCBDDCScalingSetUp_Deluxe_Private(PC pc)
     ierr = MatCreateSeqDense(PETSC_COMM_SELF,subset_size,subset_size,matdata2+cum2,&deluxe_ctx->seq_mat_inv_sum[i]);CHKERRQ(ierr);
     ierr = MatSetOption(deluxe_ctx->seq_mat_inv_sum[i],MAT_SPD,sub_schurs->is_posdef);CHKERRQ(ierr);
     ierr = MatSetOption(deluxe_ctx->seq_mat_inv_sum[i],MAT_HERMITIAN,sub_schurs->is_hermitian);CHKERRQ(ierr);
-    if (sub_schurs->is_hermitian) {
+    if (pcbddc->deluxe_hodlr_tol > 0.0 && !pcbddc->deluxe_singlemat && subset_size > 2*pcbddc->deluxe_hodlr_leaf_size) {
+      /* replace the dense blocks by their HODLR approximations: cheaper to apply and to solve with, but the dense blocks
+         have already been computed by the subschurs, so the peak memory of the setup is unchanged */
+      Mat           H,F;
+      MatFactorInfo info;
+
+      ierr = MatCreateHODLR(deluxe_ctx->seq_mat[i],pcbddc->deluxe_hodlr_tol,pcbddc->deluxe_hodlr_leaf_size,&H);CHKERRQ(ierr);
+      ierr = MatDestroy(&deluxe_ctx->seq_mat[i]);CHKERRQ(ierr);
+      deluxe_ctx->seq_mat[i] = H;
+      ierr = MatCreateHODLR(deluxe_ctx->seq_mat_inv_sum[i],pcbddc->deluxe_hodlr_tol,pcbddc->deluxe_hodlr_leaf_size,&H);CHKERRQ(ierr);
+      ierr = MatFactorInfoInitialize(&info);CHKERRQ(ierr);
+      ierr = MatGetFactor(H,MATSOLVERPETSC,MAT_FACTOR_LU,&F);CHKERRQ(ierr);
+      ierr = MatLUFactorSymbolic(F,H,NULL,NULL,&info);CHKERRQ(ierr);
+      ierr = MatLUFactorNumeric(F,H,&info);CHKERRQ(ierr);
+      ierr = MatDestroy(&H);CHKERRQ(ierr);
+      ierr = MatDestroy(&deluxe_ctx->seq_mat_inv_sum[i]);CHKERRQ(ierr);
+      deluxe_ctx->seq_mat_inv_sum[i] = F;
+    } else if (sub_schurs->is_hermitian) {
       ierr = MatCholeskyFactor(deluxe_ctx->seq_mat_inv_sum[i],NULL,NULL);CHKERRQ(ierr);
     } else {
       ierr = MatLUFactor(deluxe_ctx->seq_mat_inv_sum[i],NULL,NULL,NULL);CHKERRQ(ierr);
@@ -36,7 +36,7 @@ static PetscErrorCode PCView_Cholesky(PC pc,PetscViewer viewer)
 static PetscErrorCode PCSetUp_Cholesky(PC pc)
 {
   PetscErrorCode         ierr;
-  PetscBool              flg;
+  PetscBool              flg,updated;
   PC_Cholesky            *dir = (PC_Cholesky*)pc->data;
   MatSolverType          stype;
   MatFactorError         err;
@@ -123,10 +123,15 @@ static PetscErrorCode PCSetUp_Cholesky(PC pc)
       PetscFunctionReturn(0);
     }
 
-    ierr = MatCholeskyFactorNumeric(((PC_Factor*)dir)->fact,pc->pmat,&((PC_Factor*)dir)->info);CHKERRQ(ierr);
-    ierr = MatFactorGetError(((PC_Factor*)dir)->fact,&err);CHKERRQ(ierr);
-    if (err) { /* FactorNumeric() fails */
-      pc->failedreason = (PCFailedReason)err;
+    ierr = PCFactorUpdate_Factor(pc,&updated);CHKERRQ(ierr);
+    if (!updated) {
+      ierr = MatCholeskyFactorNumeric(((PC_Factor*)dir)->fact,pc->pmat,&((PC_Factor*)dir)->info);CHKERRQ(ierr);
+      ierr = MatFactorGetError(((PC_Factor*)dir)->fact,&err);CHKERRQ(ierr);
+      if (err) { /* FactorNumeric() fails */
+        pc->failedreason = (PCFailedReason)err;
+      } else {
+        ierr = PCFactorUpdateSetBase_Factor(pc);CHKERRQ(ierr);
+      }
     }
   }
 
@@ -146,6 +151,7 @@ static PetscErrorCode PCReset_Cholesky(PC pc)
 
   PetscFunctionBegin;
   if (!dir->hdr.inplace && ((PC_Factor*)dir)->fact) {ierr = MatDestroy(&((PC_Factor*)dir)->fact);CHKERRQ(ierr);}
+  ierr = PCFactorUpdateReset_Factor(pc);CHKERRQ(ierr);
   ierr = ISDestroy(&dir->row);CHKERRQ(ierr);
   ierr = ISDestroy(&dir->col);CHKERRQ(ierr);
   PetscFunctionReturn(0);
@@ -173,7 +179,7 @@ static PetscErrorCode PCApply_Cholesky(PC pc,Vec x,Vec y)
   if (dir->hdr.inplace) {
     ierr = MatSolve(pc->pmat,x,y);CHKERRQ(ierr);
   } else {
-    ierr = MatSolve(((PC_Factor*)dir)->fact,x,y);CHKERRQ(ierr);
+    ierr = PCFactorSolve_Factor(pc,x,y);CHKERRQ(ierr);
   }
   PetscFunctionReturn(0);
 }
@@ -187,7 +193,7 @@ static PetscErrorCode PCApplyTranspose_Cholesky(PC pc,Vec x,Vec y)
   if (dir->hdr.inplace) {
     ierr = MatSolveTranspose(pc->pmat,x,y);CHKERRQ(ierr);
   } else {
-    ierr = MatSolveTranspose(((PC_Factor*)dir)->fact,x,y);CHKERRQ(ierr);
+    ierr = PCFactorSolveTranspose_Factor(pc,x,y);CHKERRQ(ierr);
   }
   PetscFunctionReturn(0);
 }
@@ -253,7 +259,7 @@ PetscErrorCode  PCFactorSetReuseOrdering(PC pc,PetscBool flag)
 .seealso:  PCCreate(), PCSetType(), PCType (for list of available types), PC,
            PCILU, PCLU, PCICC, PCFactorSetReuseOrdering(), PCFactorSetReuseFill(), PCFactorGetMatrix(),
            PCFactorSetFill(), PCFactorSetShiftNonzero(), PCFactorSetShiftType(), PCFactorSetShiftAmount()
-           PCFactorSetUseInPlace(), PCFactorGetUseInPlace(), PCFactorSetMatOrderingType()
+           PCFactorSetUseInPlace(), PCFactorGetUseInPlace(), PCFactorSetMatOrderingType(), PCFactorSetUpdateRank()
 
 M*/
 
@@ -1,5 +1,6 @@
 
 #include <../src/ksp/pc/impls/factor/factor.h>     /*I "petscpc.h"  I*/
+#include <petscblaslapack.h>
 
 /* ------------------------------------------------------------------------------------------*/
 
@@ -221,6 +222,238 @@ PetscErrorCode  PCFactorSetColumnPivot_Factor(PC pc,PetscReal dtcol)
   PetscFunctionReturn(0);
 }
 
+PetscErrorCode PCFactorSetUpdateRank_Factor(PC pc,PetscInt rank)
+{
+  PC_Factor      *factor = (PC_Factor*)pc->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (rank < 0) SETERRQ1(PetscObjectComm((PetscObject)pc),PETSC_ERR_ARG_OUTOFRANGE,"Update rank %D cannot be negative",rank);
+  factor->updatemaxrank = rank;
+  if (!rank) {ierr = PCFactorUpdateReset_Factor(pc);CHKERRQ(ierr);}
+  PetscFunctionReturn(0);
+}
+
+/* discards the current low-rank update but keeps the matrix the factorization was computed from */
+static PetscErrorCode PCFactorUpdateClear_Private(PC_Factor *factor)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (factor->updatew) {ierr = VecDestroyVecs(factor->updaterank,&factor->updatew);CHKERRQ(ierr);}
+  ierr = VecDestroy(&factor->updatez);CHKERRQ(ierr);
+  ierr = VecDestroy(&factor->updatework[0]);CHKERRQ(ierr);
+  ierr = VecDestroy(&factor->updatework[1]);CHKERRQ(ierr);
+  ierr = VecScatterDestroy(&factor->updatescatter);CHKERRQ(ierr);
+  ierr = PetscFree2(factor->updatecap,factor->updatepivots);CHKERRQ(ierr);
+  factor->updaterank = 0;
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode PCFactorUpdateReset_Factor(PC pc)
+{
+  PC_Factor      *factor = (PC_Factor*)pc->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PCFactorUpdateClear_Private(factor);CHKERRQ(ierr);
+  ierr = MatDestroy(&factor->updatebase);CHKERRQ(ierr);
+  ierr = MatDestroy(&factor->updatediff);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   Called after a numeric factorization of pc->pmat, keeps a copy of the matrix so later changes to it can be
+   detected and applied as a low-rank update
+*/
+PetscErrorCode PCFactorUpdateSetBase_Factor(PC pc)
+{
+  PC_Factor      *factor = (PC_Factor*)pc->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PCFactorUpdateClear_Private(factor);CHKERRQ(ierr);
+  if (!factor->updatemaxrank || factor->inplace) PetscFunctionReturn(0);
+  if (factor->updatebase && pc->flag == SAME_NONZERO_PATTERN) {
+    ierr = MatCopy(pc->pmat,factor->updatebase,SAME_NONZERO_PATTERN);CHKERRQ(ierr);
+  } else {
+    ierr = PCFactorUpdateReset_Factor(pc);CHKERRQ(ierr);
+    ierr = MatDuplicate(pc->pmat,MAT_COPY_VALUES,&factor->updatebase);CHKERRQ(ierr);
+    ierr = PetscLogObjectParent((PetscObject)pc,(PetscObject)factor->updatebase);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+/*
+   Called instead of a numeric factorization when the nonzero pattern of pc->pmat did not change. If the matrix A
+   differs from the matrix A0 that was factored only in k <= updatemaxrank rows R, then A = A0 + E D with E the
+   columns of the identity for the rows R and D the k changed rows of A - A0, and by the Sherman-Morrison-Woodbury
+   formula
+
+      A^{-1} = A0^{-1} - W (I + D W)^{-1} D A0^{-1},   W = A0^{-1} E
+
+   which costs k solves with the existing factorization and the factorization of the dense k x k capacitance
+   matrix I + D W. Sets updated to PETSC_FALSE if the matrix must be refactored instead.
+*/
+PetscErrorCode PCFactorUpdate_Factor(PC pc,PetscBool *updated)
+{
+  PC_Factor         *factor = (PC_Factor*)pc->data;
+  PetscErrorCode    ierr;
+  MPI_Comm          comm;
+  PetscMPIInt       size,mn,*counts,*displs;
+  PetscInt          i,j,n,k,nlocal,rstart,cstart,cend,*lrows,*rows;
+  PetscBool         has;
+  Vec               e,t;
+  IS                is;
+  const PetscScalar *r,*z;
+  PetscBLASInt      bk,info;
+
+  PetscFunctionBegin;
+  *updated = PETSC_FALSE;
+  ierr = PCFactorUpdateClear_Private(factor);CHKERRQ(ierr);
+  if (!factor->updatemaxrank || !factor->updatebase || factor->inplace) PetscFunctionReturn(0);
+  if (pc->flag != SAME_NONZERO_PATTERN) {
+    ierr = PCFactorUpdateReset_Factor(pc);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  ierr = MatHasOperation(factor->updatebase,MATOP_GET_ROW_MAX_ABS,&has);CHKERRQ(ierr);
+  if (!has) PetscFunctionReturn(0);
+  if (!factor->updatediff) {
+    ierr = MatDuplicate(pc->pmat,MAT_DO_NOT_COPY_VALUES,&factor->updatediff);CHKERRQ(ierr);
+    ierr = PetscLogObjectParent((PetscObject)pc,(PetscObject)factor->updatediff);CHKERRQ(ierr);
+  }
+  ierr = MatCopy(pc->pmat,factor->updatediff,SAME_NONZERO_PATTERN);CHKERRQ(ierr);
+  ierr = MatAXPY(factor->updatediff,-1.0,factor->updatebase,SAME_NONZERO_PATTERN);CHKERRQ(ierr);
+
+  /* the changed rows are those in which the difference has a nonzero entry */
+  ierr = PetscObjectGetComm((PetscObject)pc,&comm);CHKERRQ(ierr);
+  ierr = MPI_Comm_size(comm,&size);CHKERRQ(ierr);
+  ierr = MatCreateVecs(pc->pmat,&e,&t);CHKERRQ(ierr);
+  ierr = MatGetRowMaxAbs(factor->updatediff,t,NULL);CHKERRQ(ierr);
+  ierr = VecGetLocalSize(t,&nlocal);CHKERRQ(ierr);
+  ierr = VecGetOwnershipRange(t,&rstart,NULL);CHKERRQ(ierr);
+  ierr = VecGetArrayRead(t,&r);CHKERRQ(ierr);
+  for (i=0,n=0; i<nlocal; i++) if (r[i] != 0.0) n++;
+  ierr = MPIU_Allreduce(&n,&k,1,MPIU_INT,MPI_SUM,comm);CHKERRQ(ierr);
+  if (!k || k > factor->updatemaxrank) {
+    ierr = VecRestoreArrayRead(t,&r);CHKERRQ(ierr);
+    ierr = VecDestroy(&e);CHKERRQ(ierr);
+    ierr = VecDestroy(&t);CHKERRQ(ierr);
+    if (k) {
+      ierr = PetscInfo2(pc,"%D rows changed, more than the maximum update rank %D, refactoring\n",k,factor->updatemaxrank);CHKERRQ(ierr);
+    } else {
+      ierr = PetscInfo(pc,"Matrix values did not change, reusing factorization\n");CHKERRQ(ierr);
+      *updated = PETSC_TRUE;
+    }
+    PetscFunctionReturn(0);
+  }
+  ierr = PetscMalloc1(n,&lrows);CHKERRQ(ierr);
+  for (i=0,n=0; i<nlocal; i++) if (r[i] != 0.0) lrows[n++] = rstart+i;
+  ierr = VecRestoreArrayRead(t,&r);CHKERRQ(ierr);
+
+  /* every process gets all the changed rows, in increasing order */
+  ierr = PetscMalloc1(k,&rows);CHKERRQ(ierr);
+  ierr = PetscMalloc2(size,&counts,size,&displs);CHKERRQ(ierr);
+  ierr = PetscMPIIntCast(n,&mn);CHKERRQ(ierr);
+  ierr = MPI_Allgather(&mn,1,MPI_INT,counts,1,MPI_INT,comm);CHKERRQ(ierr);
+  displs[0] = 0;
+  for (i=1; i<size; i++) displs[i] = displs[i-1]+counts[i-1];
+  ierr = MPI_Allgatherv(lrows,mn,MPIU_INT,rows,counts,displs,MPIU_INT,comm);CHKERRQ(ierr);
+  ierr = PetscFree2(counts,displs);CHKERRQ(ierr);
+  ierr = PetscFree(lrows);CHKERRQ(ierr);
+  ierr = ISCreateGeneral(PETSC_COMM_SELF,k,rows,PETSC_OWN_POINTER,&is);CHKERRQ(ierr);
+  ierr = VecCreateSeq(PETSC_COMM_SELF,k,&factor->updatez);CHKERRQ(ierr);
+  ierr = VecScatterCreate(t,is,factor->updatez,NULL,&factor->updatescatter);CHKERRQ(ierr);
+
+  /* W = A0^{-1} E and the capacitance matrix I + D W, stored by columns */
+  ierr = VecDuplicateVecs(e,k,&factor->updatew);CHKERRQ(ierr);
+  factor->updaterank = k;
+  ierr = PetscMalloc2(k*k,&factor->updatecap,k,&factor->updatepivots);CHKERRQ(ierr);
+  ierr = VecGetOwnershipRange(e,&cstart,&cend);CHKERRQ(ierr);
+  for (j=0; j<k; j++) {
+    ierr = VecSet(e,0.0);CHKERRQ(ierr);
+    if (rows[j] >= cstart && rows[j] < cend) {ierr = VecSetValue(e,rows[j],1.0,INSERT_VALUES);CHKERRQ(ierr);}
+    ierr = VecAssemblyBegin(e);CHKERRQ(ierr);
+    ierr = VecAssemblyEnd(e);CHKERRQ(ierr);
+    ierr = MatSolve(factor->fact,e,factor->updatew[j]);CHKERRQ(ierr);
+    ierr = MatMult(factor->updatediff,factor->updatew[j],t);CHKERRQ(ierr);
+    ierr = VecScatterBegin(factor->updatescatter,t,factor->updatez,INSERT_VALUES,SCATTER_FORWARD);CHKERRQ(ierr);
+    ierr = VecScatterEnd(factor->updatescatter,t,factor->updatez,INSERT_VALUES,SCATTER_FORWARD);CHKERRQ(ierr);
+    ierr = VecGetArrayRead(factor->updatez,&z);CHKERRQ(ierr);
+    for (i=0; i<k; i++) factor->updatecap[i+j*k] = z[i];
+    ierr = VecRestoreArrayRead(factor->updatez,&z);CHKERRQ(ierr);
+    factor->updatecap[j+j*k] += 1.0;
+  }
+  ierr = ISDestroy(&is);CHKERRQ(ierr);
+  factor->updatework[0] = t;
+  factor->updatework[1] = e;
+  ierr = PetscBLASIntCast(k,&bk);CHKERRQ(ierr);
+  PetscStackCallBLAS("LAPACKgetrf",LAPACKgetrf_(&bk,&bk,factor->updatecap,&bk,factor->updatepivots,&info));
+  if (info) {
+    ierr = PetscInfo(pc,"Capacitance matrix of the low-rank update is singular, refactoring\n");CHKERRQ(ierr);
+    ierr = PCFactorUpdateClear_Private(factor);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  ierr = PetscLogFlops(2.0*k*k*k/3.0);CHKERRQ(ierr);
+  ierr = PetscInfo1(pc,"Applying a rank %D update to the factorization\n",k);CHKERRQ(ierr);
+  *updated = PETSC_TRUE;
+  PetscFunctionReturn(0);
+}
+
+/* applies the factorization, including the low-rank update if there is one */
+PetscErrorCode PCFactorSolve_Factor(PC pc,Vec x,Vec y)
+{
+  PC_Factor      *factor = (PC_Factor*)pc->data;
+  PetscErrorCode ierr;
+  PetscScalar    *z;
+  PetscInt       i;
+  PetscBLASInt   bk,one = 1,info;
+
+  PetscFunctionBegin;
+  ierr = MatSolve(factor->fact,x,y);CHKERRQ(ierr);
+  if (!factor->updaterank) PetscFunctionReturn(0);
+  ierr = MatMult(factor->updatediff,y,factor->updatework[0]);CHKERRQ(ierr);
+  ierr = VecScatterBegin(factor->updatescatter,factor->updatework[0],factor->updatez,INSERT_VALUES,SCATTER_FORWARD);CHKERRQ(ierr);
+  ierr = VecScatterEnd(factor->updatescatter,factor->updatework[0],factor->updatez,INSERT_VALUES,SCATTER_FORWARD);CHKERRQ(ierr);
+  ierr = PetscBLASIntCast(factor->updaterank,&bk);CHKERRQ(ierr);
+  ierr = VecGetArray(factor->updatez,&z);CHKERRQ(ierr);
+  PetscStackCallBLAS("LAPACKgetrs",LAPACKgetrs_("N",&bk,&one,factor->updatecap,&bk,factor->updatepivots,z,&bk,&info));
+  if (info) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_LIB,"Error in LAPACK getrs %d",(int)info);
+  for (i=0; i<factor->updaterank; i++) z[i] = -z[i];
+  ierr = VecMAXPY(y,factor->updaterank,z,factor->updatew);CHKERRQ(ierr);
+  ierr = VecRestoreArray(factor->updatez,&z);CHKERRQ(ierr);
+  ierr = PetscLogFlops(2.0*factor->updaterank*factor->updaterank);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* the transpose of the update is A^{-T} = A0^{-T} - A0^{-T} D^T (I + D W)^{-T} E^T A0^{-T}, it needs a second solve */
+PetscErrorCode PCFactorSolveTranspose_Factor(PC pc,Vec x,Vec y)
+{
+  PC_Factor      *factor = (PC_Factor*)pc->data;
+  PetscErrorCode ierr;
+  PetscScalar    *z;
+  PetscBLASInt   bk,one = 1,info;
+
+  PetscFunctionBegin;
+  ierr = MatSolveTranspose(factor->fact,x,y);CHKERRQ(ierr);
+  if (!factor->updaterank) PetscFunctionReturn(0);
+  ierr = VecScatterBegin(factor->updatescatter,y,factor->updatez,INSERT_VALUES,SCATTER_FORWARD);CHKERRQ(ierr);
+  ierr = VecScatterEnd(factor->updatescatter,y,factor->updatez,INSERT_VALUES,SCATTER_FORWARD);CHKERRQ(ierr);
+  ierr = PetscBLASIntCast(factor->updaterank,&bk);CHKERRQ(ierr);
+  ierr = VecGetArray(factor->updatez,&z);CHKERRQ(ierr);
+  PetscStackCallBLAS("LAPACKgetrs",LAPACKgetrs_("T",&bk,&one,factor->updatecap,&bk,factor->updatepivots,z,&bk,&info));
+  if (info) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_LIB,"Error in LAPACK getrs %d",(int)info);
+  ierr = VecRestoreArray(factor->updatez,&z);CHKERRQ(ierr);
+  ierr = VecSet(factor->updatework[0],0.0);CHKERRQ(ierr);
+  ierr = VecScatterBegin(factor->updatescatter,factor->updatez,factor->updatework[0],INSERT_VALUES,SCATTER_REVERSE);CHKERRQ(ierr);
+  ierr = VecScatterEnd(factor->updatescatter,factor->updatez,factor->updatework[0],INSERT_VALUES,SCATTER_REVERSE);CHKERRQ(ierr);
+  ierr = MatMultTranspose(factor->updatediff,factor->updatework[0],factor->updatework[1]);CHKERRQ(ierr);
+  ierr = MatSolveTranspose(factor->fact,factor->updatework[1],factor->updatework[0]);CHKERRQ(ierr);
+  ierr = VecAXPY(y,-1.0,factor->updatework[0]);CHKERRQ(ierr);
+  ierr = PetscLogFlops(2.0*factor->updaterank*factor->updaterank);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 PetscErrorCode  PCSetFromOptions_Factor(PetscOptionItems *PetscOptionsObject,PC pc)
 {
   PC_Factor         *factor = (PC_Factor*)pc->data;
@@ -230,6 +463,7 @@ PetscErrorCode  PCSetFromOptions_Factor(PetscOptionItems *PetscOptionsObject,PC
   PetscFunctionList ordlist;
   PetscEnum         etmp;
   PetscBool         inplace;
+  PetscInt          rank;
 
   PetscFunctionBegin;
   ierr = PCFactorGetUseInPlace(pc,&inplace);CHKERRQ(ierr);
@@ -268,6 +502,11 @@ PetscErrorCode  PCSetFromOptions_Factor(PetscOptionItems *PetscOptionsObject,PC
     ierr = PCFactorSetMatOrderingType(pc,tname);CHKERRQ(ierr);
   }
 
+  ierr = PetscOptionsInt("-pc_factor_update_rank","Largest number of changed matrix rows applied as a low-rank update instead of refactoring","PCFactorSetUpdateRank",factor->updatemaxrank,&rank,&flg);CHKERRQ(ierr);
+  if (flg) {
+    ierr = PCFactorSetUpdateRank(pc,rank);CHKERRQ(ierr);
+  }
+
   /* maybe should have MatGetSolverTypes(Mat,&list) like the ordering list */
   ierr = PetscOptionsString("-pc_factor_mat_solver_type","Specific direct solver to use","MatGetFactor",((PC_Factor*)factor)->solvertype,solvertype,64,&flg);CHKERRQ(ierr);
   if (flg) {
@@ -312,6 +551,9 @@ PetscErrorCode PCView_Factor(PC pc,PetscViewer viewer)
     }
 
     ierr = PetscViewerASCIIPrintf(viewer,"  matrix ordering: %s\n",factor->ordering);CHKERRQ(ierr);
+    if (factor->updatemaxrank) {
+      ierr = PetscViewerASCIIPrintf(viewer,"  low-rank updates of the factorization up to rank %D, current rank %D\n",factor->updatemaxrank,factor->updaterank);CHKERRQ(ierr);
+    }
 
     if (factor->fact) {
       MatInfo info;
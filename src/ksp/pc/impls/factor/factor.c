@@ -707,6 +707,48 @@ PetscErrorCode  PCFactorSetReuseFill(PC pc,PetscBool flag)
   PetscFunctionReturn(0);
 }
 
+/*@
+   PCFactorSetUpdateRank - When the matrix keeps its nonzero structure and only a few of its rows change, apply the change
+   as a low-rank update of the existing factorization instead of computing a new one.
+
+   Logically Collective on PC
+
+   Input Parameters:
++  pc - the preconditioner context
+-  rank - the largest number of changed rows handled by an update, 0 (the default) always refactors
+
+   Options Database Key:
+.  -pc_factor_update_rank <rank> - Sets the largest rank of the update
+
+   Notes:
+   A copy of the factored matrix A0 is kept. When the preconditioner is set up again with a matrix A that differs from
+   A0 in k rows, the factorization of A0 is corrected with the Sherman-Morrison-Woodbury formula, which costs k solves
+   with the factorization of A0 at setup and one multiplication with A - A0 plus a dense k x k solve per application.
+   Once more than rank rows have changed since the last factorization, the matrix is factored again. This is intended
+   for Newton iterations in which the Jacobian changes only locally, for example due to contact.
+
+   For ILU and ICC the update is applied to the incomplete factorization, that is the preconditioner becomes the
+   incomplete factorization of A0 plus the exact change A - A0.
+
+   The update is not available with in-place factorization, and PCFactorGetMatrix() returns the factorization of A0.
+
+   Level: intermediate
+
+.keywords: PC, factorization, update, Sherman-Morrison-Woodbury
+
+.seealso: PCFactorSetReuseFill(), PCFactorSetReuseOrdering(), PCFactorGetMatrix()
+@*/
+PetscErrorCode PCFactorSetUpdateRank(PC pc,PetscInt rank)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(pc,PC_CLASSID,1);
+  PetscValidLogicalCollectiveInt(pc,rank,2);
+  ierr = PetscTryMethod(pc,"PCFactorSetUpdateRank_C",(PC,PetscInt),(pc,rank));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 PetscErrorCode PCFactorInitialize(PC pc)
 {
   PetscErrorCode ierr;
@@ -740,5 +782,6 @@ PetscErrorCode PCFactorInitialize(PC pc)
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCFactorGetUseInPlace_C",PCFactorGetUseInPlace_Factor);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCFactorSetReuseOrdering_C",PCFactorSetReuseOrdering_Factor);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCFactorSetReuseFill_C",PCFactorSetReuseFill_Factor);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)pc,"PCFactorSetUpdateRank_C",PCFactorSetUpdateRank_Factor);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
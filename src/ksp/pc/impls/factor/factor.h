@@ -16,6 +16,18 @@ typedef struct {
   PetscBool        inplace;            /* flag indicating in-place factorization */
   PetscBool        reuseordering;      /* reuses previous reordering computed */
   PetscBool        reusefill;          /* reuse fill from previous LU */
+
+  /* low-rank update of the factorization, see PCFactorSetUpdateRank() */
+  PetscInt         updatemaxrank;      /* largest number of changed rows handled without refactoring */
+  Mat              updatebase;         /* copy of the matrix the factorization was computed from */
+  Mat              updatediff;         /* current matrix minus updatebase, nonzero only in the changed rows */
+  PetscInt         updaterank;         /* number of changed rows */
+  Vec              *updatew;           /* factorization applied to the unit vectors of the changed rows */
+  Vec              updatez;            /* sequential work vector with one entry per changed row */
+  Vec              updatework[2];      /* work vectors with the row and column layout of the matrix */
+  VecScatter       updatescatter;      /* gathers the changed rows of a vector onto every process */
+  PetscScalar      *updatecap;         /* LU factors of the capacitance matrix */
+  PetscBLASInt     *updatepivots;
 } PC_Factor;
 
 PETSC_INTERN PetscErrorCode PCFactorInitialize(PC);
@@ -39,6 +51,12 @@ PETSC_INTERN PetscErrorCode PCFactorSetMatSolverType_Factor(PC,MatSolverType);
 PETSC_INTERN PetscErrorCode PCFactorSetUpMatSolverType_Factor(PC);
 PETSC_INTERN PetscErrorCode PCFactorGetMatSolverType_Factor(PC,MatSolverType*);
 PETSC_INTERN PetscErrorCode PCFactorSetColumnPivot_Factor(PC,PetscReal);
+PETSC_INTERN PetscErrorCode PCFactorSetUpdateRank_Factor(PC,PetscInt);
+PETSC_INTERN PetscErrorCode PCFactorUpdate_Factor(PC,PetscBool*);
+PETSC_INTERN PetscErrorCode PCFactorUpdateSetBase_Factor(PC);
+PETSC_INTERN PetscErrorCode PCFactorUpdateReset_Factor(PC);
+PETSC_INTERN PetscErrorCode PCFactorSolve_Factor(PC,Vec,Vec);
+PETSC_INTERN PetscErrorCode PCFactorSolveTranspose_Factor(PC,Vec,Vec);
 PETSC_INTERN PetscErrorCode PCSetFromOptions_Factor(PetscOptionItems *PetscOptionsObject,PC);
 PETSC_INTERN PetscErrorCode PCView_Factor(PC,PetscViewer);
 
@@ -9,6 +9,7 @@ static PetscErrorCode PCSetUp_ICC(PC pc)
   MatInfo                info;
   MatSolverType          stype;
   MatFactorError         err;
+  PetscBool              updated;
 
   PetscFunctionBegin;
   pc->failedreason = PC_NOERROR;
@@ -37,10 +38,15 @@ static PetscErrorCode PCSetUp_ICC(PC pc)
     PetscFunctionReturn(0);
   }
  
-  ierr = MatCholeskyFactorNumeric(((PC_Factor*)icc)->fact,pc->pmat,&((PC_Factor*)icc)->info);CHKERRQ(ierr);
-  ierr = MatFactorGetError(((PC_Factor*)icc)->fact,&err);CHKERRQ(ierr);
-  if (err) { /* FactorNumeric() fails */
-    pc->failedreason = (PCFailedReason)err;
+  ierr = PCFactorUpdate_Factor(pc,&updated);CHKERRQ(ierr);
+  if (!updated) {
+    ierr = MatCholeskyFactorNumeric(((PC_Factor*)icc)->fact,pc->pmat,&((PC_Factor*)icc)->info);CHKERRQ(ierr);
+    ierr = MatFactorGetError(((PC_Factor*)icc)->fact,&err);CHKERRQ(ierr);
+    if (err) { /* FactorNumeric() fails */
+      pc->failedreason = (PCFailedReason)err;
+    } else {
+      ierr = PCFactorUpdateSetBase_Factor(pc);CHKERRQ(ierr);
+    }
   }
 
   ierr = PCFactorGetMatSolverType(pc,&stype);CHKERRQ(ierr);
@@ -59,6 +65,7 @@ static PetscErrorCode PCReset_ICC(PC pc)
 
   PetscFunctionBegin;
   ierr = MatDestroy(&((PC_Factor*)icc)->fact);CHKERRQ(ierr);
+  ierr = PCFactorUpdateReset_Factor(pc);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -77,11 +84,10 @@ static PetscErrorCode PCDestroy_ICC(PC pc)
 
 static PetscErrorCode PCApply_ICC(PC pc,Vec x,Vec y)
 {
-  PC_ICC         *icc = (PC_ICC*)pc->data;
   PetscErrorCode ierr;
 
   PetscFunctionBegin;
-  ierr = MatSolve(((PC_Factor*)icc)->fact,x,y);CHKERRQ(ierr);
+  ierr = PCFactorSolve_Factor(pc,x,y);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -91,6 +97,7 @@ static PetscErrorCode PCApplySymmetricLeft_ICC(PC pc,Vec x,Vec y)
   PC_ICC         *icc = (PC_ICC*)pc->data;
 
   PetscFunctionBegin;
+  if (((PC_Factor*)icc)->updaterank) SETERRQ(PetscObjectComm((PetscObject)pc),PETSC_ERR_SUP,"Cannot apply a low-rank update of the factorization symmetrically");
   ierr = MatForwardSolve(((PC_Factor*)icc)->fact,x,y);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
@@ -101,6 +108,7 @@ static PetscErrorCode PCApplySymmetricRight_ICC(PC pc,Vec x,Vec y)
   PC_ICC         *icc = (PC_ICC*)pc->data;
 
   PetscFunctionBegin;
+  if (((PC_Factor*)icc)->updaterank) SETERRQ(PetscObjectComm((PetscObject)pc),PETSC_ERR_SUP,"Cannot apply a low-rank update of the factorization symmetrically");
   ierr = MatBackwardSolve(((PC_Factor*)icc)->fact,x,y);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
@@ -174,7 +182,7 @@ extern PetscErrorCode  PCFactorSetDropTolerance_ILU(PC,PetscReal,PetscReal,Petsc
 .seealso:  PCCreate(), PCSetType(), PCType (for list of available types), PC, PCSOR, MatOrderingType,
            PCFactorSetZeroPivot(), PCFactorSetShiftType(), PCFactorSetShiftAmount(),
            PCFactorSetFill(), PCFactorSetMatOrderingType(), PCFactorSetReuseOrdering(),
-           PCFactorSetLevels()
+           PCFactorSetLevels(), PCFactorSetUpdateRank()
 
 M*/
 
@@ -22,6 +22,7 @@ PetscErrorCode PCReset_ILU(PC pc)
 
   PetscFunctionBegin;
   if (!ilu->hdr.inplace) {ierr = MatDestroy(&((PC_Factor*)ilu)->fact);CHKERRQ(ierr);}
+  ierr = PCFactorUpdateReset_Factor(pc);CHKERRQ(ierr);
   if (ilu->row && ilu->col && ilu->row != ilu->col) {ierr = ISDestroy(&ilu->row);CHKERRQ(ierr);}
   ierr = ISDestroy(&ilu->col);CHKERRQ(ierr);
   PetscFunctionReturn(0);
@@ -84,7 +85,7 @@ static PetscErrorCode PCSetUp_ILU(PC pc)
   PetscErrorCode         ierr;
   PC_ILU                 *ilu = (PC_ILU*)pc->data;
   MatInfo                info;
-  PetscBool              flg;
+  PetscBool              flg,updated;
   MatSolverType          stype;
   MatFactorError         err;
 
@@ -173,10 +174,15 @@ static PetscErrorCode PCSetUp_ILU(PC pc)
       PetscFunctionReturn(0);
     }
 
-    ierr = MatLUFactorNumeric(((PC_Factor*)ilu)->fact,pc->pmat,&((PC_Factor*)ilu)->info);CHKERRQ(ierr);
-    ierr = MatFactorGetError(((PC_Factor*)ilu)->fact,&err);CHKERRQ(ierr);
-    if (err) { /* FactorNumeric() fails */
-      pc->failedreason = (PCFailedReason)err;
+    ierr = PCFactorUpdate_Factor(pc,&updated);CHKERRQ(ierr);
+    if (!updated) {
+      ierr = MatLUFactorNumeric(((PC_Factor*)ilu)->fact,pc->pmat,&((PC_Factor*)ilu)->info);CHKERRQ(ierr);
+      ierr = MatFactorGetError(((PC_Factor*)ilu)->fact,&err);CHKERRQ(ierr);
+      if (err) { /* FactorNumeric() fails */
+        pc->failedreason = (PCFailedReason)err;
+      } else {
+        ierr = PCFactorUpdateSetBase_Factor(pc);CHKERRQ(ierr);
+      }
     }
   }
 
@@ -204,21 +210,19 @@ static PetscErrorCode PCDestroy_ILU(PC pc)
 
 static PetscErrorCode PCApply_ILU(PC pc,Vec x,Vec y)
 {
-  PC_ILU         *ilu = (PC_ILU*)pc->data;
   PetscErrorCode ierr;
 
   PetscFunctionBegin;
-  ierr = MatSolve(((PC_Factor*)ilu)->fact,x,y);CHKERRQ(ierr);
+  ierr = PCFactorSolve_Factor(pc,x,y);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
 static PetscErrorCode PCApplyTranspose_ILU(PC pc,Vec x,Vec y)
 {
-  PC_ILU         *ilu = (PC_ILU*)pc->data;
   PetscErrorCode ierr;
 
   PetscFunctionBegin;
-  ierr = MatSolveTranspose(((PC_Factor*)ilu)->fact,x,y);CHKERRQ(ierr);
+  ierr = PCFactorSolveTranspose_Factor(pc,x,y);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -228,6 +232,7 @@ static PetscErrorCode PCApplySymmetricLeft_ILU(PC pc,Vec x,Vec y)
   PC_ILU         *icc = (PC_ILU*)pc->data;
 
   PetscFunctionBegin;
+  if (((PC_Factor*)icc)->updaterank) SETERRQ(PetscObjectComm((PetscObject)pc),PETSC_ERR_SUP,"Cannot apply a low-rank update of the factorization symmetrically");
   ierr = MatForwardSolve(((PC_Factor*)icc)->fact,x,y);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
@@ -238,6 +243,7 @@ static PetscErrorCode PCApplySymmetricRight_ILU(PC pc,Vec x,Vec y)
   PC_ILU         *icc = (PC_ILU*)pc->data;
 
   PetscFunctionBegin;
+  if (((PC_Factor*)icc)->updaterank) SETERRQ(PetscObjectComm((PetscObject)pc),PETSC_ERR_SUP,"Cannot apply a low-rank update of the factorization symmetrically");
   ierr = MatBackwardSolve(((PC_Factor*)icc)->fact,x,y);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
@@ -288,7 +294,7 @@ static PetscErrorCode PCApplySymmetricRight_ILU(PC pc,Vec x,Vec y)
            PCFactorSetZeroPivot(), PCFactorSetShiftSetType(), PCFactorSetAmount(),
            PCFactorSetDropTolerance(),PCFactorSetFill(), PCFactorSetMatOrderingType(), PCFactorSetReuseOrdering(),
            PCFactorSetLevels(), PCFactorSetUseInPlace(), PCFactorSetAllowDiagonalFill(), PCFactorSetPivotInBlocks(),
-           PCFactorGetAllowDiagonalFill(), PCFactorGetUseInPlace()
+           PCFactorGetAllowDiagonalFill(), PCFactorGetUseInPlace(), PCFactorSetUpdateRank()
 
 M*/
 
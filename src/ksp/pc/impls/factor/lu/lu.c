@@ -55,6 +55,7 @@ static PetscErrorCode PCSetUp_LU(PC pc)
   PC_LU                  *dir = (PC_LU*)pc->data;
   MatSolverType          stype;
   MatFactorError         err;
+  PetscBool              updated;
 
   PetscFunctionBegin;
   pc->failedreason = PC_NOERROR;
@@ -128,10 +129,15 @@ static PetscErrorCode PCSetUp_LU(PC pc)
       PetscFunctionReturn(0);
     }
 
-    ierr = MatLUFactorNumeric(((PC_Factor*)dir)->fact,pc->pmat,&((PC_Factor*)dir)->info);CHKERRQ(ierr);
-    ierr = MatFactorGetError(((PC_Factor*)dir)->fact,&err);CHKERRQ(ierr);
-    if (err) { /* FactorNumeric() fails */
-      pc->failedreason = (PCFailedReason)err;
+    ierr = PCFactorUpdate_Factor(pc,&updated);CHKERRQ(ierr);
+    if (!updated) {
+      ierr = MatLUFactorNumeric(((PC_Factor*)dir)->fact,pc->pmat,&((PC_Factor*)dir)->info);CHKERRQ(ierr);
+      ierr = MatFactorGetError(((PC_Factor*)dir)->fact,&err);CHKERRQ(ierr);
+      if (err) { /* FactorNumeric() fails */
+        pc->failedreason = (PCFailedReason)err;
+      } else {
+        ierr = PCFactorUpdateSetBase_Factor(pc);CHKERRQ(ierr);
+      }
     }
 
   }
@@ -152,6 +158,7 @@ static PetscErrorCode PCReset_LU(PC pc)
 
   PetscFunctionBegin;
   if (!dir->hdr.inplace && ((PC_Factor*)dir)->fact) {ierr = MatDestroy(&((PC_Factor*)dir)->fact);CHKERRQ(ierr);}
+  ierr = PCFactorUpdateReset_Factor(pc);CHKERRQ(ierr);
   if (dir->row && dir->col && dir->row != dir->col) {ierr = ISDestroy(&dir->row);CHKERRQ(ierr);}
   ierr = ISDestroy(&dir->col);CHKERRQ(ierr);
   PetscFunctionReturn(0);
@@ -179,7 +186,7 @@ static PetscErrorCode PCApply_LU(PC pc,Vec x,Vec y)
   if (dir->hdr.inplace) {
     ierr = MatSolve(pc->pmat,x,y);CHKERRQ(ierr);
   } else {
-    ierr = MatSolve(((PC_Factor*)dir)->fact,x,y);CHKERRQ(ierr);
+    ierr = PCFactorSolve_Factor(pc,x,y);CHKERRQ(ierr);
   }
   PetscFunctionReturn(0);
 }
@@ -193,7 +200,7 @@ static PetscErrorCode PCApplyTranspose_LU(PC pc,Vec x,Vec y)
   if (dir->hdr.inplace) {
     ierr = MatSolveTranspose(pc->pmat,x,y);CHKERRQ(ierr);
   } else {
-    ierr = MatSolveTranspose(((PC_Factor*)dir)->fact,x,y);CHKERRQ(ierr);
+    ierr = PCFactorSolveTranspose_Factor(pc,x,y);CHKERRQ(ierr);
   }
   PetscFunctionReturn(0);
 }
@@ -214,6 +221,7 @@ static PetscErrorCode PCApplyTranspose_LU(PC pc,Vec x,Vec y)
                                          stability of factorization.
 .  -pc_factor_shift_type <shifttype> - Sets shift type or PETSC_DECIDE for the default; use '-help' for a list of available types
 .  -pc_factor_shift_amount <shiftamount> - Sets shift amount or PETSC_DECIDE for the default
+.  -pc_factor_update_rank <rank> - Applies changes to at most rank rows of the matrix as a low-rank update instead of refactoring
 -   -pc_factor_nonzeros_along_diagonal - permutes the rows and columns to try to put nonzero value along the
         diagonal.
 
@@ -235,7 +243,7 @@ static PetscErrorCode PCApplyTranspose_LU(PC pc,Vec x,Vec y)
            PCILU, PCCHOLESKY, PCICC, PCFactorSetReuseOrdering(), PCFactorSetReuseFill(), PCFactorGetMatrix(),
            PCFactorSetFill(), PCFactorSetUseInPlace(), PCFactorSetMatOrderingType(), PCFactorSetColumnPivot(),
            PCFactorSetPivotingInBlocks(),PCFactorSetShiftType(),PCFactorSetShiftAmount()
-           PCFactorReorderForNonzeroDiagonal()
+           PCFactorReorderForNonzeroDiagonal(), PCFactorSetUpdateRank()
 M*/
 
 PETSC_EXTERN PetscErrorCode PCCreate_LU(PC pc)
@@ -45,6 +45,8 @@ typedef struct {
   KSP                       kspschur;              /* The solver for S */
   KSP                       kspupper;              /* The solver for A in the upper diagonal part of the factorization (H_2 in [El08]) */
   PetscScalar               schurscale;            /* Scaling factor for the Schur complement solution with DIAG factorization */
+  PetscReal                 schurhodlrtol;         /* If positive, compress the explicit Schur complement of PC_FIELDSPLIT_SCHUR_PRE_FULL to a MATHODLR */
+  PetscInt                  schurhodlrleafsize;    /* Leaf size of that MATHODLR */
 
   PC_FieldSplitLink         head;
   PetscBool                 isrestrict;             /* indicates PCFieldSplitRestrictIS() has been last called on this object, hack */
@@ -181,6 +183,9 @@ static PetscErrorCode PCView_FieldSplit_Schur(PC pc,PetscViewer viewer)
       break;
     case PC_FIELDSPLIT_SCHUR_PRE_FULL:
       ierr = PetscViewerASCIIPrintf(viewer,"  Preconditioner for the Schur complement formed from the exact Schur complement\n");CHKERRQ(ierr);
+      if (jac->schurhodlrtol > 0.0) {
+        ierr = PetscViewerASCIIPrintf(viewer,"  Exact Schur complement compressed to a HODLR matrix with tolerance %g\n",(double)jac->schurhodlrtol);CHKERRQ(ierr);
+      }
       break;
     case PC_FIELDSPLIT_SCHUR_PRE_USER:
       if (jac->schur_user) {
@@ -826,6 +831,20 @@ static PetscErrorCode PCSetUp_FieldSplit(PC pc)
         /* Note: This is bad if there exist preconditioners for MATSCHURCOMPLEMENT */
       } else if (jac->schurpre == PC_FIELDSPLIT_SCHUR_PRE_FULL) {
         ierr = MatSchurComplementComputeExplicitOperator(jac->schur, &jac->schur_user);CHKERRQ(ierr);
+        if (jac->schurhodlrtol > 0.0) {
+          PetscMPIInt size;
+
+          ierr = MPI_Comm_size(PetscObjectComm((PetscObject)pc),&size);CHKERRQ(ierr);
+          if (size == 1) {
+            Mat H;
+
+            ierr            = MatCreateHODLR(jac->schur_user,jac->schurhodlrtol,jac->schurhodlrleafsize,&H);CHKERRQ(ierr);
+            ierr            = MatDestroy(&jac->schur_user);CHKERRQ(ierr);
+            jac->schur_user = H;
+          } else {
+            ierr = PetscInfo(pc,"HODLR compression of the Schur complement is only available in serial, using the explicit Schur complement\n");CHKERRQ(ierr);
+          }
+        }
       }
       ierr = KSPSetOperators(jac->kspschur,jac->schur,FieldSplitSchurPre(jac));CHKERRQ(ierr);
       ierr = KSPGetOptionsPrefix(jac->head->next->ksp, &Dprefix);CHKERRQ(ierr);
@@ -1257,6 +1276,7 @@ static PetscErrorCode PCDestroy_FieldSplit(PC pc)
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCFieldSplitSetSchurPre_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCFieldSplitGetSchurPre_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCFieldSplitSetSchurFactType_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)pc,"PCFieldSplitSetSchurHODLR_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCFieldSplitRestrictIS_C",NULL);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
@@ -1299,6 +1319,8 @@ static PetscErrorCode PCSetFromOptions_FieldSplit(PetscOptionItems *PetscOptions
     ierr = PetscOptionsEnum("-pc_fieldsplit_schur_fact_type","Which off-diagonal parts of the block factorization to use","PCFieldSplitSetSchurFactType",PCFieldSplitSchurFactTypes,(PetscEnum)jac->schurfactorization,(PetscEnum*)&jac->schurfactorization,NULL);CHKERRQ(ierr);
     ierr = PetscOptionsEnum("-pc_fieldsplit_schur_precondition","How to build preconditioner for Schur complement","PCFieldSplitSetSchurPre",PCFieldSplitSchurPreTypes,(PetscEnum)jac->schurpre,(PetscEnum*)&jac->schurpre,NULL);CHKERRQ(ierr);
     ierr = PetscOptionsScalar("-pc_fieldsplit_schur_scale","Scale Schur complement","PCFieldSplitSetSchurScale",jac->schurscale,&jac->schurscale,NULL);CHKERRQ(ierr);
+    ierr = PetscOptionsReal("-pc_fieldsplit_schur_hodlr_tol","Compress the exact Schur complement to a HODLR matrix with this tolerance","PCFieldSplitSetSchurHODLR",jac->schurhodlrtol,&jac->schurhodlrtol,NULL);CHKERRQ(ierr);
+    ierr = PetscOptionsInt("-pc_fieldsplit_schur_hodlr_leaf_size","Leaf size of the HODLR matrix","PCFieldSplitSetSchurHODLR",jac->schurhodlrleafsize,&jac->schurhodlrleafsize,NULL);CHKERRQ(ierr);
   }
   ierr = PetscOptionsTail();CHKERRQ(ierr);
   PetscFunctionReturn(0);
@@ -2111,6 +2133,54 @@ static PetscErrorCode PCFieldSplitSetSchurScale_FieldSplit(PC pc,PetscScalar sca
   PetscFunctionReturn(0);
 }
 
+/*@
+    PCFieldSplitSetSchurHODLR -  Compresses the exact Schur complement used with PC_FIELDSPLIT_SCHUR_PRE_FULL to a hierarchically
+    off-diagonal low-rank matrix
+
+    Logically Collective on PC
+
+    Input Parameters:
++   pc       - the preconditioner context
+.   tol      - relative truncation tolerance of the off-diagonal blocks, a nonpositive value turns the compression off
+-   leafsize - size of the dense diagonal blocks, or PETSC_DEFAULT
+
+    Options Database:
++     -pc_fieldsplit_schur_hodlr_tol <tol> - default is 0, no compression
+-     -pc_fieldsplit_schur_hodlr_leaf_size <leafsize> - default is 32
+
+    Notes:
+    The dense explicit Schur complement is still computed first, with MatSchurComplementComputeExplicitOperator(), and then compressed,
+    so this does not lower the memory or the time needed to set up the preconditioner. It only makes the solves with the Schur complement
+    cheaper, for example with -fieldsplit_1_pc_type lu the factorization and the solves cost nearly linear in n instead of O(n^3) and O(n^2)
+    when the off-diagonal blocks have low numerical rank, as is the case for Schur complements of elliptic problems. It is only available
+    for sequential runs; in parallel the explicit Schur complement is used unchanged.
+
+    Level: intermediate
+
+.seealso: PCFIELDSPLIT, PCFieldSplitSetSchurPre(), PCFieldSplitSchurPreType, MatCreateHODLR(), MATHODLR
+@*/
+PetscErrorCode PCFieldSplitSetSchurHODLR(PC pc,PetscReal tol,PetscInt leafsize)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(pc,PC_CLASSID,1);
+  PetscValidLogicalCollectiveReal(pc,tol,2);
+  PetscValidLogicalCollectiveInt(pc,leafsize,3);
+  ierr = PetscTryMethod(pc,"PCFieldSplitSetSchurHODLR_C",(PC,PetscReal,PetscInt),(pc,tol,leafsize));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PCFieldSplitSetSchurHODLR_FieldSplit(PC pc,PetscReal tol,PetscInt leafsize)
+{
+  PC_FieldSplit *jac = (PC_FieldSplit*)pc->data;
+
+  PetscFunctionBegin;
+  jac->schurhodlrtol      = tol;
+  jac->schurhodlrleafsize = leafsize;
+  PetscFunctionReturn(0);
+}
+
 /*@C
    PCFieldSplitGetSchurBlocks - Gets all matrix blocks for the Schur complement
 
@@ -2159,6 +2229,7 @@ static PetscErrorCode  PCFieldSplitSetType_FieldSplit(PC pc,PCCompositeType type
     ierr = PetscObjectComposeFunction((PetscObject)pc,"PCFieldSplitGetSchurPre_C",PCFieldSplitGetSchurPre_FieldSplit);CHKERRQ(ierr);
     ierr = PetscObjectComposeFunction((PetscObject)pc,"PCFieldSplitSetSchurFactType_C",PCFieldSplitSetSchurFactType_FieldSplit);CHKERRQ(ierr);
     ierr = PetscObjectComposeFunction((PetscObject)pc,"PCFieldSplitSetSchurScale_C",PCFieldSplitSetSchurScale_FieldSplit);CHKERRQ(ierr);
+    ierr = PetscObjectComposeFunction((PetscObject)pc,"PCFieldSplitSetSchurHODLR_C",PCFieldSplitSetSchurHODLR_FieldSplit);CHKERRQ(ierr);
 
   } else {
     pc->ops->apply = PCApply_FieldSplit;
@@ -2169,6 +2240,7 @@ static PetscErrorCode  PCFieldSplitSetType_FieldSplit(PC pc,PCCompositeType type
     ierr = PetscObjectComposeFunction((PetscObject)pc,"PCFieldSplitGetSchurPre_C",0);CHKERRQ(ierr);
     ierr = PetscObjectComposeFunction((PetscObject)pc,"PCFieldSplitSetSchurFactType_C",0);CHKERRQ(ierr);
     ierr = PetscObjectComposeFunction((PetscObject)pc,"PCFieldSplitSetSchurScale_C",0);CHKERRQ(ierr);
+    ierr = PetscObjectComposeFunction((PetscObject)pc,"PCFieldSplitSetSchurHODLR_C",0);CHKERRQ(ierr);
   }
   PetscFunctionReturn(0);
 }
@@ -2391,6 +2463,7 @@ PetscErrorCode PCFieldSplitSetDetectSaddlePoint(PC pc,PetscBool flg)
 .   -pc_fieldsplit_block_size <bs> - size of block that defines fields (i.e. there are bs fields)
 .   -pc_fieldsplit_type <additive,multiplicative,symmetric_multiplicative,schur> - type of relaxation or factorization splitting
 .   -pc_fieldsplit_schur_precondition <self,selfp,user,a11,full> - default is a11; see PCFieldSplitSetSchurPre()
+.   -pc_fieldsplit_schur_hodlr_tol <tol> - compress the exact Schur complement used with full to a HODLR matrix; see PCFieldSplitSetSchurHODLR()
 .   -pc_fieldsplit_detect_saddle_point - automatically finds rows with zero diagonal and uses Schur complement with no preconditioner as the solver
 
 -    Options prefix for inner solvers when using Schur complement preconditioner are -fieldsplit_0_ and -fieldsplit_1_
@@ -2453,7 +2526,7 @@ $              (  0   S  )
 
 .seealso:  PCCreate(), PCSetType(), PCType (for list of available types), PC, Block_Preconditioners, PCLSC,
            PCFieldSplitGetSubKSP(), PCFieldSplitSetFields(), PCFieldSplitSetType(), PCFieldSplitSetIS(), PCFieldSplitSetSchurPre(),
-          MatSchurComplementSetAinvType(), PCFieldSplitSetSchurScale(),
+          MatSchurComplementSetAinvType(), PCFieldSplitSetSchurScale(), PCFieldSplitSetSchurHODLR(),
           PCFieldSplitSetDetectSaddlePoint()
 M*/
 
@@ -2471,6 +2544,8 @@ PETSC_EXTERN PetscErrorCode PCCreate_FieldSplit(PC pc)
   jac->schurpre           = PC_FIELDSPLIT_SCHUR_PRE_USER; /* Try user preconditioner first, fall back on diagonal */
   jac->schurfactorization = PC_FIELDSPLIT_SCHUR_FACT_FULL;
   jac->schurscale         = -1.0;
+  jac->schurhodlrtol      = 0.0;
+  jac->schurhodlrleafsize = 32;
   jac->dm_splits          = PETSC_TRUE;
   jac->detect             = PETSC_FALSE;
 
@@ -103,6 +103,9 @@ static PetscErrorCode PCGAMGSetSymGraph_AGG(PC pc, PetscBool n)
    Options Database Key:
 .  -pc_gamg_square_graph <n,default = 1> - number of levels to square the graph on before aggregating it
 
+   Notes:
+    The graph is never squared with the MATCOARSENMIS2 coarsener (-mat_coarsen_type mis2), which aggregates the distance two neighbors directly
+
    Level: intermediate
 
    Concepts: Aggregation AMG preconditioner
@@ -910,6 +913,7 @@ static PetscErrorCode PCGAMGCoarsen_AGG(PC a_pc,Mat *a_Gmat1,PetscCoarsenData **
   PetscReal      hashfact;
   PetscInt       iSwapIndex;
   PetscRandom    random;
+  PetscBool      ismis2;
 
   PetscFunctionBegin;
   ierr = PetscLogEventBegin(PC_GAMGCoarsen_AGG,0,0,0,0);CHKERRQ(ierr);
@@ -920,7 +924,11 @@ static PetscErrorCode PCGAMGCoarsen_AGG(PC a_pc,Mat *a_Gmat1,PetscCoarsenData **
   if (bs != 1) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_PLIB,"bs %D must be 1",bs);
   nloc = n/bs;
 
-  if (pc_gamg->current_level < pc_gamg_agg->square_graph) {
+  ierr = MatCoarsenCreate(comm, &crs);CHKERRQ(ierr);
+  ierr = MatCoarsenSetFromOptions(crs);CHKERRQ(ierr);
+  /* MIS-2 aggregates already reach the distance two neighbors, no need to square the graph and smooth the aggregates */
+  ierr = PetscObjectTypeCompare((PetscObject)crs,MATCOARSENMIS2,&ismis2);CHKERRQ(ierr);
+  if (pc_gamg->current_level < pc_gamg_agg->square_graph && !ismis2) {
     ierr = PetscInfo2(a_pc,"Square Graph on level %d of %d to square\n",pc_gamg->current_level+1,pc_gamg_agg->square_graph);CHKERRQ(ierr);
     ierr = MatTransposeMatMult(Gmat1, Gmat1, MAT_INITIAL_MATRIX, PETSC_DEFAULT, &Gmat2);CHKERRQ(ierr);
   } else Gmat2 = Gmat1;
@@ -949,8 +957,6 @@ static PetscErrorCode PCGAMGCoarsen_AGG(PC a_pc,Mat *a_Gmat1,PetscCoarsenData **
 #if defined PETSC_GAMG_USE_LOG
   ierr = PetscLogEventBegin(petsc_gamg_setup_events[SET4],0,0,0,0);CHKERRQ(ierr);
 #endif
-  ierr = MatCoarsenCreate(comm, &crs);CHKERRQ(ierr);
-  ierr = MatCoarsenSetFromOptions(crs);CHKERRQ(ierr);
   ierr = MatCoarsenSetGreedyOrdering(crs, perm);CHKERRQ(ierr);
   ierr = MatCoarsenSetAdjacency(crs, Gmat2);CHKERRQ(ierr);
   ierr = MatCoarsenSetStrictAggs(crs, PETSC_TRUE);CHKERRQ(ierr);
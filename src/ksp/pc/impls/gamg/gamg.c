@@ -4,6 +4,7 @@
 #include <petsc/private/matimpl.h>
 #include <../src/ksp/pc/impls/gamg/gamg.h>           /*I "petscpc.h" I*/
 #include <../src/ksp/pc/impls/bjacobi/bjacobi.h> /* Hack to access same_local_solves */
+#include <petsctime.h>
 
 #if defined PETSC_GAMG_USE_LOG
 PetscLogEvent petsc_gamg_setup_events[NUM_SET];
@@ -41,6 +42,102 @@ PetscErrorCode PCReset_GAMG(PC pc)
   PetscFunctionReturn(0);
 }
 
+/* -------------------------------------------------------------------------- */
+/*
+   PCGAMGCostModelSize_Private: number of processes that minimizes the modeled time of a matrix-vector product
+     with the coarse matrix, T(p) = nnz/p t_nz + (min(p-1,nbr) + log2(p)) t_lat, where nbr is the largest
+     number of neighbors of a process in the current layout. The first term is the local product, the
+     second the neighbor exchange and a reduction (as used by the Krylov methods and the norms).
+
+   Input Parameter:
+   . pc - the GAMG preconditioner
+   . Cmat - the coarse matrix on its current layout
+   . nactive - the number of active processes
+   Output Parameter:
+   . a_new_size - number of processes to use
+*/
+static PetscErrorCode PCGAMGCostModelSize_Private(PC pc,Mat Cmat,PetscMPIInt nactive,PetscMPIInt *a_new_size)
+{
+  PetscErrorCode ierr;
+  PC_MG          *mg      = (PC_MG*)pc->data;
+  PC_GAMG        *pc_gamg = (PC_GAMG*)mg->innerctx;
+  MPI_Comm       comm;
+  MatInfo        info;
+  PetscBool      isMPI;
+  PetscInt       M,nbr = 0,gnbr,ii,owner,last,pmax;
+  PetscMPIInt    p,best = 1,size;
+  PetscReal      nztime = pc_gamg->cost_nz_time,latency = pc_gamg->cost_latency,nnz,t,tbest = PETSC_MAX_REAL;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectGetComm((PetscObject)Cmat,&comm);CHKERRQ(ierr);
+  ierr = MPI_Comm_size(comm,&size);CHKERRQ(ierr);
+  ierr = MatGetSize(Cmat,&M,NULL);CHKERRQ(ierr);
+  ierr = MatGetInfo(Cmat,MAT_GLOBAL_SUM,&info);CHKERRQ(ierr);
+  nnz  = info.nz_used;
+
+  /* number of processes I receive ghost values from */
+  ierr = PetscObjectBaseTypeCompare((PetscObject)Cmat,MATMPIAIJ,&isMPI);CHKERRQ(ierr);
+  if (isMPI) {
+    Mat_MPIAIJ     *mpimat = (Mat_MPIAIJ*)Cmat->data;
+    const PetscInt *ranges;
+
+    ierr = MatGetOwnershipRangesColumn(Cmat,&ranges);CHKERRQ(ierr);
+    for (ii=0,owner=0,last=-1; ii<mpimat->B->cmap->n; ii++) {
+      while (mpimat->garray[ii] >= ranges[owner+1]) owner++;
+      if (owner != last) {nbr++; last = owner;}
+    }
+  } else if (size > 1) nbr = nactive-1;
+  ierr = MPIU_Allreduce(&nbr,&gnbr,1,MPIU_INT,MPI_MAX,comm);CHKERRQ(ierr);
+
+  if (nztime == PETSC_DECIDE) {
+    /* time a few products with the diagonal block, which involve no communication */
+    Mat            Ad = Cmat;
+    Vec            x,y;
+    PetscLogDouble t0,t1;
+    PetscReal      tloc[2],tglob[2];
+    PetscInt       k;
+
+    if (isMPI) Ad = ((Mat_MPIAIJ*)Cmat->data)->A;
+    ierr = MatCreateVecs(Ad,&x,&y);CHKERRQ(ierr);
+    ierr = VecSet(x,1.0);CHKERRQ(ierr);
+    ierr = MatMult(Ad,x,y);CHKERRQ(ierr);
+    ierr = PetscTime(&t0);CHKERRQ(ierr);
+    for (k=0; k<5; k++) {ierr = MatMult(Ad,x,y);CHKERRQ(ierr);}
+    ierr = PetscTime(&t1);CHKERRQ(ierr);
+    ierr = MatGetInfo(Ad,MAT_LOCAL,&info);CHKERRQ(ierr);
+    tloc[0] = (PetscReal)(t1-t0)/5.;
+    tloc[1] = info.nz_used;
+    ierr = MPIU_Allreduce(tloc,tglob,2,MPIU_REAL,MPIU_SUM,comm);CHKERRQ(ierr);
+    nztime = tglob[1] > 0. ? tglob[0]/tglob[1] : 0.;
+    ierr = VecDestroy(&x);CHKERRQ(ierr);
+    ierr = VecDestroy(&y);CHKERRQ(ierr);
+  }
+  if (latency == PETSC_DECIDE) {
+    /* a reduction costs about log2(size) latencies */
+    PetscLogDouble t0,t1;
+    PetscReal      in = 1.0,out,tloc,tglob;
+    PetscInt       k;
+
+    ierr = MPIU_Allreduce(&in,&out,1,MPIU_REAL,MPIU_SUM,comm);CHKERRQ(ierr);
+    ierr = PetscTime(&t0);CHKERRQ(ierr);
+    for (k=0; k<10; k++) {ierr = MPIU_Allreduce(&in,&out,1,MPIU_REAL,MPIU_SUM,comm);CHKERRQ(ierr);}
+    ierr = PetscTime(&t1);CHKERRQ(ierr);
+    tloc = (PetscReal)(t1-t0)/10.;
+    ierr = MPIU_Allreduce(&tloc,&tglob,1,MPIU_REAL,MPIU_MAX,comm);CHKERRQ(ierr);
+    latency = size > 1 ? tglob/PetscLog2Real((PetscReal)size) : tglob;
+  }
+
+  /* no more processes than equations */
+  pmax = PetscMin((PetscInt)nactive,M);
+  for (p=1; p<=pmax; p++) {
+    t = nnz*nztime/p + (PetscMin(p-1,gnbr) + PetscLog2Real((PetscReal)p))*latency;
+    if (t < tbest) {tbest = t; best = p;}
+  }
+  ierr = PetscInfo6(pc,"Cost model: nnz %g, neighbors %D, time per nonzero %g, latency %g: %d of %d processes\n",(double)nnz,gnbr,(double)nztime,(double)latency,best,nactive);CHKERRQ(ierr);
+  *a_new_size = best;
+  PetscFunctionReturn(0);
+}
+
 /* -------------------------------------------------------------------------- */
 /*
    PCGAMGCreateLevel_GAMG: create coarse op with RAP.  repartition and/or reduce number
@@ -65,7 +162,7 @@ static PetscErrorCode PCGAMGCreateLevel_GAMG(PC pc,Mat Amat_fine,PetscInt cr_bs,
   PC_GAMG         *pc_gamg    = (PC_GAMG*)mg->innerctx;
   Mat             Cmat,Pold=*a_P_inout;
   MPI_Comm        comm;
-  PetscMPIInt     rank,size,new_size,nactive=*a_nactive_proc;
+  PetscMPIInt     rank,size,new_size = 1,nactive=*a_nactive_proc;
   PetscInt        ncrs_eq,ncrs,f_bs;
 
   PetscFunctionBegin;
@@ -87,7 +184,9 @@ static PetscErrorCode PCGAMGCreateLevel_GAMG(PC pc,Mat Amat_fine,PetscInt cr_bs,
 
   /* get number of PEs to make active 'new_size', reduce, can be any integer 1-P */
   if (is_last && !pc_gamg->use_parallel_coarse_grid_solver) new_size = 1;
-  else {
+  else if (pc_gamg->cost_model) {
+    ierr = PCGAMGCostModelSize_Private(pc,Cmat,nactive,&new_size);CHKERRQ(ierr);
+  } else {
     PetscInt ncrs_eq_glob;
     ierr     = MatGetSize(Cmat, &ncrs_eq_glob, NULL);CHKERRQ(ierr);
     new_size = (PetscMPIInt)((float)ncrs_eq_glob/(float)pc_gamg->min_eq_proc + 0.5); /* hardwire min. number of eq/proc */
@@ -829,6 +928,104 @@ static PetscErrorCode PCGAMGSetRepartition_GAMG(PC pc, PetscBool n)
   PetscFunctionReturn(0);
 }
 
+/*@
+   PCGAMGSetProcCostModel - Choose the number of active processes on each coarse grid with a cost model of the matrix-vector product
+
+   Collective on PC
+
+   Input Parameters:
++  pc - the preconditioner context
+-  flg - PETSC_TRUE to use the cost model instead of the limit on the number of equations per process
+
+   Options Database Key:
+.  -pc_gamg_process_cost_model <true,false>
+
+   Notes:
+    For each coarse grid the number of processes p minimizes the modeled time T(p) = nnz/p t_nz + (min(p-1,nbr) + log2(p)) t_lat,
+    where nnz is the number of nonzeros of the coarse matrix, nbr the largest number of neighbors of a process,
+    t_nz the time of the local product per nonzero and t_lat the latency of a message, see PCGAMGSetProcCostModelParameters().
+    The equations are moved to the active processes as with PCGAMGSetProcEqLim(); use PCGAMGSetRepartition() to
+    repartition them with a graph partitioner.
+
+   Level: intermediate
+
+   Concepts: Unstructured multigrid preconditioner
+
+.seealso: PCGAMGSetProcCostModelParameters(), PCGAMGSetProcEqLim(), PCGAMGSetRepartition()
+@*/
+PetscErrorCode PCGAMGSetProcCostModel(PC pc, PetscBool flg)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(pc,PC_CLASSID,1);
+  PetscValidLogicalCollectiveBool(pc,flg,2);
+  ierr = PetscTryMethod(pc,"PCGAMGSetProcCostModel_C",(PC,PetscBool),(pc,flg));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PCGAMGSetProcCostModel_GAMG(PC pc, PetscBool flg)
+{
+  PC_MG   *mg      = (PC_MG*)pc->data;
+  PC_GAMG *pc_gamg = (PC_GAMG*)mg->innerctx;
+
+  PetscFunctionBegin;
+  pc_gamg->cost_model = flg;
+  PetscFunctionReturn(0);
+}
+
+/*@
+   PCGAMGSetProcCostModelParameters - Set the parameters of the cost model used to choose the number of active processes on the coarse grids
+
+   Collective on PC
+
+   Input Parameters:
++  pc - the preconditioner context
+.  nztime - time (in seconds) of the local matrix-vector product per nonzero, or PETSC_DECIDE to measure it on each level
+-  latency - latency (in seconds) of a message, or PETSC_DECIDE to measure it on each level
+
+   Options Database Keys:
++  -pc_gamg_process_cost_nz_time <t> - time per nonzero, default 2.5e-9, -1 to measure it
+-  -pc_gamg_process_cost_latency <t> - message latency, default 2.e-6, -1 to measure it
+
+   Notes:
+    Measured values give the best choice for the machine at hand but, since they vary between runs, so may the hierarchy.
+
+   Level: advanced
+
+   Concepts: Unstructured multigrid preconditioner
+
+.seealso: PCGAMGSetProcCostModel()
+@*/
+PetscErrorCode PCGAMGSetProcCostModelParameters(PC pc, PetscReal nztime, PetscReal latency)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(pc,PC_CLASSID,1);
+  PetscValidLogicalCollectiveReal(pc,nztime,2);
+  PetscValidLogicalCollectiveReal(pc,latency,3);
+  ierr = PetscTryMethod(pc,"PCGAMGSetProcCostModelParameters_C",(PC,PetscReal,PetscReal),(pc,nztime,latency));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PCGAMGSetProcCostModelParameters_GAMG(PC pc, PetscReal nztime, PetscReal latency)
+{
+  PC_MG   *mg      = (PC_MG*)pc->data;
+  PC_GAMG *pc_gamg = (PC_GAMG*)mg->innerctx;
+
+  PetscFunctionBegin;
+  if (nztime != PETSC_DEFAULT) {
+    if (nztime < 0. && nztime != PETSC_DECIDE) SETERRQ1(PetscObjectComm((PetscObject)pc),PETSC_ERR_ARG_OUTOFRANGE,"Time per nonzero %g must be nonnegative or PETSC_DECIDE",(double)nztime);
+    pc_gamg->cost_nz_time = nztime;
+  }
+  if (latency != PETSC_DEFAULT) {
+    if (latency < 0. && latency != PETSC_DECIDE) SETERRQ1(PetscObjectComm((PetscObject)pc),PETSC_ERR_ARG_OUTOFRANGE,"Latency %g must be nonnegative or PETSC_DECIDE",(double)latency);
+    pc_gamg->cost_latency = latency;
+  }
+  PetscFunctionReturn(0);
+}
+
 /*@
    PCGAMGSetReuseInterpolation - Reuse prolongation when rebuilding algebraic multigrid preconditioner
 
@@ -1178,6 +1375,13 @@ static PetscErrorCode PCView_GAMG(PC pc,PetscViewer viewer)
   if (pc_gamg->use_parallel_coarse_grid_solver) {
     ierr = PetscViewerASCIIPrintf(viewer,"      Using parallel coarse grid solver (all coarse grid equations not put on one process)\n");CHKERRQ(ierr);
   }
+  if (pc_gamg->cost_model) {
+    char nztime[64] = "measured",latency[64] = "measured";
+
+    if (pc_gamg->cost_nz_time != PETSC_DECIDE) {ierr = PetscSNPrintf(nztime,sizeof(nztime),"%g",(double)pc_gamg->cost_nz_time);CHKERRQ(ierr);}
+    if (pc_gamg->cost_latency != PETSC_DECIDE) {ierr = PetscSNPrintf(latency,sizeof(latency),"%g",(double)pc_gamg->cost_latency);CHKERRQ(ierr);}
+    ierr = PetscViewerASCIIPrintf(viewer,"      Number of processes on the coarse grids from a cost model, time per nonzero %s, latency %s\n",nztime,latency);CHKERRQ(ierr);
+  }
   if (pc_gamg->ops->view) {
     ierr = (*pc_gamg->ops->view)(pc,viewer);CHKERRQ(ierr);
   }
@@ -1209,6 +1413,14 @@ PetscErrorCode PCSetFromOptions_GAMG(PetscOptionItems *PetscOptionsObject,PC pc)
     ierr = PetscOptionsBool("-pc_gamg_asm_use_agg","Use aggregation aggregates for ASM smoother","PCGAMGASMSetUseAggs",pc_gamg->use_aggs_in_asm,&pc_gamg->use_aggs_in_asm,NULL);CHKERRQ(ierr);
     ierr = PetscOptionsBool("-pc_gamg_use_parallel_coarse_grid_solver","Use parallel coarse grid solver (otherwise put last grid on one process)","PCGAMGSetUseParallelCoarseGridSolve",pc_gamg->use_parallel_coarse_grid_solver,&pc_gamg->use_parallel_coarse_grid_solver,NULL);CHKERRQ(ierr);
     ierr = PetscOptionsInt("-pc_gamg_process_eq_limit","Limit (goal) on number of equations per process on coarse grids","PCGAMGSetProcEqLim",pc_gamg->min_eq_proc,&pc_gamg->min_eq_proc,NULL);CHKERRQ(ierr);
+    ierr = PetscOptionsBool("-pc_gamg_process_cost_model","Choose the number of processes on the coarse grids with a cost model","PCGAMGSetProcCostModel",pc_gamg->cost_model,&pc_gamg->cost_model,NULL);CHKERRQ(ierr);
+    if (pc_gamg->cost_model) {
+      PetscReal nztime = pc_gamg->cost_nz_time,latency = pc_gamg->cost_latency;
+
+      ierr = PetscOptionsReal("-pc_gamg_process_cost_nz_time","Time per nonzero of the local matrix-vector product, -1 to measure it","PCGAMGSetProcCostModelParameters",nztime,&nztime,NULL);CHKERRQ(ierr);
+      ierr = PetscOptionsReal("-pc_gamg_process_cost_latency","Latency of a message, -1 to measure it","PCGAMGSetProcCostModelParameters",latency,&latency,NULL);CHKERRQ(ierr);
+      ierr = PCGAMGSetProcCostModelParameters(pc,nztime,latency);CHKERRQ(ierr);
+    }
     ierr = PetscOptionsInt("-pc_gamg_coarse_eq_limit","Limit on number of equations for the coarse grid","PCGAMGSetCoarseEqLim",pc_gamg->coarse_eq_limit,&pc_gamg->coarse_eq_limit,NULL);CHKERRQ(ierr);
     ierr = PetscOptionsReal("-pc_gamg_threshold_scale","Scaling of threshold for each level not specified","PCGAMGSetThresholdScale",pc_gamg->threshold_scale,&pc_gamg->threshold_scale,NULL);CHKERRQ(ierr);
     n = PETSC_GAMG_MAXLEVELS;
@@ -1240,6 +1452,7 @@ PetscErrorCode PCSetFromOptions_GAMG(PetscOptionItems *PetscOptionsObject,PC pc)
 .   -pc_gamg_asm_use_agg <true,default=false> - use the aggregates from the coasening process to defined the subdomains on each level for the PCASM smoother
 .   -pc_gamg_process_eq_limit <limit, default=50> - GAMG will reduce the number of MPI processes used directly on the coarse grids so that there are around <limit>
                                         equations on each process that has degrees of freedom
+.   -pc_gamg_process_cost_model <true,default=false> - choose the number of processes on each coarse grid from a cost model of the matrix-vector product instead, see PCGAMGSetProcCostModel()
 .   -pc_gamg_coarse_eq_limit <limit, default=50> - Set maximum number of equations on coarsest grid to aim for.
 .   -pc_gamg_threshold[] <thresh,default=0> - Before aggregating the graph GAMG will remove small values from the graph on each level
 -   -pc_gamg_threshold_scale <scale,default=1> - Scaling of threshold on each coarser grid if not specified
@@ -1247,7 +1460,8 @@ PetscErrorCode PCSetFromOptions_GAMG(PetscOptionItems *PetscOptionsObject,PC pc)
    Options Database Keys for default Aggregation:
 +  -pc_gamg_agg_nsmooths <nsmooth, default=1> - number of smoothing steps to use with smooth aggregation
 .  -pc_gamg_sym_graph <true,default=false> - symmetrize the graph before computing the aggregation
--  -pc_gamg_square_graph <n,default=1> - number of levels to square the graph before aggregating it
+.  -pc_gamg_square_graph <n,default=1> - number of levels to square the graph before aggregating it
+-  -mat_coarsen_type <mis> - mis, mis2 or hem, the coarsener used to build the aggregates; mis2 does not depend on the number of processes and does not square the graph
 
    Multigrid options:
 +  -pc_mg_cycles <v> - v or w, see PCMGSetCycleType()
@@ -1266,7 +1480,7 @@ PetscErrorCode PCSetFromOptions_GAMG(PetscOptionItems *PetscOptionsObject,PC pc)
 
   Concepts: algebraic multigrid
 
-.seealso:  PCCreate(), PCSetType(), MatSetBlockSize(), PCMGType, PCSetCoordinates(), MatSetNearNullSpace(), PCGAMGSetType(), PCGAMGAGG, PCGAMGGEO, PCGAMGCLASSICAL, PCGAMGSetProcEqLim(),
+.seealso:  PCCreate(), PCSetType(), MatSetBlockSize(), PCMGType, PCSetCoordinates(), MatSetNearNullSpace(), PCGAMGSetType(), PCGAMGAGG, PCGAMGGEO, PCGAMGCLASSICAL, PCGAMGSetProcEqLim(), PCGAMGSetProcCostModel(),
            PCGAMGSetCoarseEqLim(), PCGAMGSetRepartition(), PCGAMGRegister(), PCGAMGSetReuseInterpolation(), PCGAMGASMSetUseAggs(), PCGAMGSetUseParallelCoarseGridSolve(), PCGAMGSetNlevels(), PCGAMGSetThreshold(), PCGAMGGetType(), PCGAMGSetReuseInterpolation()
 M*/
 
@@ -1307,6 +1521,8 @@ PETSC_EXTERN PetscErrorCode PCCreate_GAMG(PC pc)
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCGAMGSetProcEqLim_C",PCGAMGSetProcEqLim_GAMG);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCGAMGSetCoarseEqLim_C",PCGAMGSetCoarseEqLim_GAMG);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCGAMGSetRepartition_C",PCGAMGSetRepartition_GAMG);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)pc,"PCGAMGSetProcCostModel_C",PCGAMGSetProcCostModel_GAMG);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)pc,"PCGAMGSetProcCostModelParameters_C",PCGAMGSetProcCostModelParameters_GAMG);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCGAMGSetReuseInterpolation_C",PCGAMGSetReuseInterpolation_GAMG);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCGAMGASMSetUseAggs_C",PCGAMGASMSetUseAggs_GAMG);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCGAMGSetUseParallelCoarseGridSolve_C",PCGAMGSetUseParallelCoarseGridSolve_GAMG);CHKERRQ(ierr);
@@ -1321,6 +1537,9 @@ PETSC_EXTERN PetscErrorCode PCCreate_GAMG(PC pc)
   pc_gamg->use_parallel_coarse_grid_solver = PETSC_FALSE;
   pc_gamg->min_eq_proc      = 50;
   pc_gamg->coarse_eq_limit  = 50;
+  pc_gamg->cost_model       = PETSC_FALSE;
+  pc_gamg->cost_nz_time     = 2.5e-9;
+  pc_gamg->cost_latency     = 2.e-6;
   for (i=0;i<PETSC_GAMG_MAXLEVELS;i++) pc_gamg->threshold[i] = 0.;
   pc_gamg->threshold_scale = 1.;
   pc_gamg->Nlevels          = PETSC_GAMG_MAXLEVELS;
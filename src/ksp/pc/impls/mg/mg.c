@@ -134,6 +134,7 @@ PetscErrorCode PCReset_MG(PC pc)
       ierr = MatDestroy(&mglevels[i+1]->restrct);CHKERRQ(ierr);
       ierr = MatDestroy(&mglevels[i+1]->interpolate);CHKERRQ(ierr);
       ierr = MatDestroy(&mglevels[i+1]->inject);CHKERRQ(ierr);
+      ierr = MatDestroy(&mglevels[i+1]->sinterpolate);CHKERRQ(ierr);
       ierr = VecDestroy(&mglevels[i+1]->rscale);CHKERRQ(ierr);
     }
 
@@ -353,6 +354,7 @@ PetscErrorCode PCSetFromOptions_MG(PetscOptionItems *PetscOptionsObject,PC pc)
   PC_MG            *mg = (PC_MG*)pc->data;
   PC_MG_Levels     **mglevels;
   PCMGType         mgtype;
+  PCMGAdditiveType atype;
   PCMGCycleType    mgctype;
   PCMGGalerkinType gtype;
 
@@ -393,6 +395,12 @@ PetscErrorCode PCSetFromOptions_MG(PetscOptionItems *PetscOptionsObject,PC pc)
     if (flg) {
       ierr = PCMGMultiplicativeSetCycles(pc,cycles);CHKERRQ(ierr);
     }
+  } else if (mg->am == PC_MG_ADDITIVE) {
+    atype = mg->additivetype;
+    ierr  = PetscOptionsEnum("-pc_mg_additive_type","Variant of additive multigrid","PCMGSetAdditiveType",PCMGAdditiveTypes,(PetscEnum)atype,(PetscEnum*)&atype,&flg);CHKERRQ(ierr);
+    if (flg) {
+      ierr = PCMGSetAdditiveType(pc,atype);CHKERRQ(ierr);
+    }
   }
   flg  = PETSC_FALSE;
   ierr = PetscOptionsBool("-pc_mg_log","Log times for each multigrid level","None",flg,&flg,NULL);CHKERRQ(ierr);
@@ -439,6 +447,7 @@ PetscErrorCode PCSetFromOptions_MG(PetscOptionItems *PetscOptionsObject,PC pc)
 }
 
 const char *const PCMGTypes[] = {"MULTIPLICATIVE","ADDITIVE","FULL","KASKADE","PCMGType","PC_MG",0};
+const char *const PCMGAdditiveTypes[] = {"STANDARD","AFACX","MULT","PCMGAdditiveType","PC_MG_ADDITIVE_",0};
 const char *const PCMGCycleTypes[] = {"invalid","v","w","PCMGCycleType","PC_MG_CYCLE",0};
 const char *const PCMGGalerkinTypes[] = {"both","pmat","mat","none","external","PCMGGalerkinType","PC_MG_GALERKIN",0};
 
@@ -460,6 +469,8 @@ PetscErrorCode PCView_MG(PC pc,PetscViewer viewer)
     ierr = PetscViewerASCIIPrintf(viewer,"  type is %s, levels=%D cycles=%s\n", PCMGTypes[mg->am],levels,cyclename);CHKERRQ(ierr);
     if (mg->am == PC_MG_MULTIPLICATIVE) {
       ierr = PetscViewerASCIIPrintf(viewer,"    Cycles per PCApply=%d\n",mg->cyclesperpcapply);CHKERRQ(ierr);
+    } else if (mg->am == PC_MG_ADDITIVE) {
+      ierr = PetscViewerASCIIPrintf(viewer,"    Additive variant %s\n",PCMGAdditiveTypes[mg->additivetype]);CHKERRQ(ierr);
     }
     if (mg->galerkin == PC_MG_GALERKIN_BOTH) {
       ierr = PetscViewerASCIIPrintf(viewer,"    Using Galerkin computed coarse grid matrices\n");CHKERRQ(ierr);
@@ -531,6 +542,52 @@ PetscErrorCode PCView_MG(PC pc,PetscViewer viewer)
 #include <petsc/private/dmimpl.h>
 #include <petsc/private/kspimpl.h>
 
+/*
+   Builds the l1-Jacobi smoothed interpolation (I - D_l1^{-1} A) P used by the PC_MG_ADDITIVE_MULT cycle,
+   where D_l1 is the diagonal matrix of the absolute row sums of A. The l1 scaling keeps the smoother
+   convergent without an eigenvalue estimate.
+*/
+static PetscErrorCode PCMGCreateSmoothedInterpolation_Private(Mat A,Mat P,Mat *sP)
+{
+  PetscErrorCode    ierr;
+  Mat               AP,Pf;
+  Vec               dinv;
+  PetscScalar       *d;
+  const PetscScalar *vals;
+  PetscInt          i,j,ncols,rstart,rend,M,Mp,Np;
+
+  PetscFunctionBegin;
+  ierr = MatGetSize(A,&M,NULL);CHKERRQ(ierr);
+  ierr = MatGetSize(P,&Mp,&Np);CHKERRQ(ierr);
+  if (Mp == M) {
+    ierr = PetscObjectReference((PetscObject)P);CHKERRQ(ierr);
+    Pf   = P;
+  } else if (Np == M) {
+    ierr = MatTranspose(P,MAT_INITIAL_MATRIX,&Pf);CHKERRQ(ierr);
+  } else SETERRQ3(PetscObjectComm((PetscObject)A),PETSC_ERR_ARG_SIZ,"Interpolation of size %D x %D does not match operator of size %D",Mp,Np,M);
+
+  ierr = MatCreateVecs(A,NULL,&dinv);CHKERRQ(ierr);
+  ierr = MatGetOwnershipRange(A,&rstart,&rend);CHKERRQ(ierr);
+  ierr = VecGetArray(dinv,&d);CHKERRQ(ierr);
+  for (i=rstart; i<rend; i++) {
+    PetscReal sum = 0.0;
+
+    ierr = MatGetRow(A,i,&ncols,NULL,&vals);CHKERRQ(ierr);
+    for (j=0; j<ncols; j++) sum += PetscAbsScalar(vals[j]);
+    ierr = MatRestoreRow(A,i,&ncols,NULL,&vals);CHKERRQ(ierr);
+    d[i-rstart] = sum > 0.0 ? 1.0/sum : 0.0;
+  }
+  ierr = VecRestoreArray(dinv,&d);CHKERRQ(ierr);
+
+  ierr = MatMatMult(A,Pf,MAT_INITIAL_MATRIX,PETSC_DEFAULT,&AP);CHKERRQ(ierr);
+  ierr = MatDiagonalScale(AP,dinv,NULL);CHKERRQ(ierr);
+  ierr = MatAYPX(AP,-1.0,Pf,DIFFERENT_NONZERO_PATTERN);CHKERRQ(ierr);
+  *sP  = AP;
+  ierr = VecDestroy(&dinv);CHKERRQ(ierr);
+  ierr = MatDestroy(&Pf);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 /*
     Calls setup for the KSP on each level
 */
@@ -838,6 +895,17 @@ PetscErrorCode PCSetUp_MG(PC pc)
   }
   if (mglevels[0]->eventsmoothsetup) {ierr = PetscLogEventEnd(mglevels[0]->eventsmoothsetup,0,0,0,0);CHKERRQ(ierr);}
 
+  if (mg->am == PC_MG_ADDITIVE && mg->additivetype == PC_MG_ADDITIVE_MULT) {
+    /* the operators or the interpolations may have changed, so always rebuild the smoothed interpolations */
+    for (i=1; i<n; i++) {
+      Mat Amat;
+
+      ierr = MatDestroy(&mglevels[i]->sinterpolate);CHKERRQ(ierr);
+      ierr = KSPGetOperators(mglevels[i]->smoothd,NULL,&Amat);CHKERRQ(ierr);
+      ierr = PCMGCreateSmoothedInterpolation_Private(Amat,mglevels[i]->interpolate,&mglevels[i]->sinterpolate);CHKERRQ(ierr);
+    }
+  }
+
   /*
      Dump the interpolation/restriction matrices plus the
    Jacobian/stiffness on each level. This allows MATLAB users to
@@ -958,6 +1026,78 @@ PetscErrorCode  PCMGGetType(PC pc,PCMGType *type)
   PetscFunctionReturn(0);
 }
 
+/*@
+   PCMGSetAdditiveType - Determines the variant of additive multigrid to use with PC_MG_ADDITIVE
+
+   Logically Collective on PC
+
+   Input Parameters:
++  pc - the preconditioner context
+-  type - one of PC_MG_ADDITIVE_STANDARD, PC_MG_ADDITIVE_AFACX, PC_MG_ADDITIVE_MULT
+
+   Options Database Key:
+.  -pc_mg_additive_type <type> - Sets <type>, one of standard, afacx, mult
+
+   Notes:
+    PC_MG_ADDITIVE_STANDARD smooths the restricted right hand side on each level and adds up the interpolated corrections. It is
+    robust only as a preconditioner for a Krylov method since the levels correct for the same error components.
+
+    PC_MG_ADDITIVE_AFACX subtracts from the right hand side of each level the part already handled by the next coarser level, this costs
+    one extra smoothing and residual computation per level. The resulting preconditioner is not symmetric so it should be used with
+    KSPGMRES or KSPFGMRES rather than KSPCG.
+
+    PC_MG_ADDITIVE_MULT restricts and interpolates with the l1-Jacobi smoothed interpolation and applies the pre and post smoother on
+    each level, it mimics the multiplicative V-cycle and usually needs close to the same number of iterations. The smoothed interpolations
+    are computed with MatMatMult() during PCSetUp() so the interpolations must be assembled matrices.
+
+    With all the variants the smoothing on the different levels only depends on the restricted right hand sides, not on each other.
+
+   Level: advanced
+
+.keywords: MG, set, additive, AFACx, multigrid
+
+.seealso: PCMGSetType(), PCMGGetAdditiveType(), PCMGAdditiveType
+@*/
+PetscErrorCode  PCMGSetAdditiveType(PC pc,PCMGAdditiveType type)
+{
+  PC_MG *mg = (PC_MG*)pc->data;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(pc,PC_CLASSID,1);
+  PetscValidLogicalCollectiveEnum(pc,type,2);
+  if (mg->additivetype != type) pc->setupcalled = 0;
+  mg->additivetype = type;
+  PetscFunctionReturn(0);
+}
+
+/*@
+   PCMGGetAdditiveType - Gets the variant of additive multigrid used with PC_MG_ADDITIVE
+
+   Not Collective
+
+   Input Parameter:
+.  pc - the preconditioner context
+
+   Output Parameter:
+.  type - one of PC_MG_ADDITIVE_STANDARD, PC_MG_ADDITIVE_AFACX, PC_MG_ADDITIVE_MULT
+
+   Level: advanced
+
+.keywords: MG, get, additive, AFACx, multigrid
+
+.seealso: PCMGSetAdditiveType()
+@*/
+PetscErrorCode  PCMGGetAdditiveType(PC pc,PCMGAdditiveType *type)
+{
+  PC_MG *mg = (PC_MG*)pc->data;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(pc,PC_CLASSID,1);
+  PetscValidPointer(type,2);
+  *type = mg->additivetype;
+  PetscFunctionReturn(0);
+}
+
 /*@
    PCMGSetCycleType - Sets the type cycles to use.  Use PCMGSetCycleTypeOnLevel() for more
    complicated cycling.
@@ -1199,6 +1339,7 @@ PetscErrorCode  PCMGSetDistinctSmoothUp(PC pc)
 +  -pc_mg_levels <nlevels> - number of levels including finest
 .  -pc_mg_cycle_type <v,w> - 
 .  -pc_mg_type <additive,multiplicative,full,kaskade> - multiplicative is the default
+.  -pc_mg_additive_type <standard,afacx,mult> - variant of additive multigrid, see PCMGSetAdditiveType()
 .  -pc_mg_log - log information about time spent on each level of the solver
 .  -pc_mg_distinct_smoothup - configure up (after interpolation) and down (before restriction) smoothers separately (with different options prefixes)
 .  -pc_mg_galerkin <both,pmat,mat,none> - use Galerkin process to compute coarser operators, i.e. Acoarse = R A R'
@@ -1223,7 +1364,7 @@ PetscErrorCode  PCMGSetDistinctSmoothUp(PC pc)
    Concepts: multigrid/multilevel
 
 .seealso:  PCCreate(), PCSetType(), PCType (for list of available types), PC, PCMGType, PCEXOTIC, PCGAMG, PCML, PCHYPRE
-           PCMGSetLevels(), PCMGGetLevels(), PCMGSetType(), PCMGSetCycleType(),
+           PCMGSetLevels(), PCMGGetLevels(), PCMGSetType(), PCMGSetAdditiveType(), PCMGSetCycleType(),
            PCMGSetDistinctSmoothUp(), PCMGGetCoarseSolve(), PCMGSetResidual(), PCMGSetInterpolation(),
            PCMGSetRestriction(), PCMGGetSmoother(), PCMGGetSmootherUp(), PCMGGetSmootherDown(),
            PCMGSetCycleTypeOnLevel(), PCMGSetRhs(), PCMGSetX(), PCMGSetR()
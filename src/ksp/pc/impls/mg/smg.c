@@ -1,10 +1,12 @@
-
 /*
      Additive Multigrid V Cycle routine
 */
 #include <petsc/private/pcmgimpl.h>
 
-PetscErrorCode PCMGACycle_Private(PC pc,PC_MG_Levels **mglevels)
+/*
+   The classical additive cycle, the restricted right hand side is smoothed on each level independently
+*/
+static PetscErrorCode PCMGACycleStandard_Private(PC pc,PC_MG_Levels **mglevels)
 {
   PetscErrorCode ierr;
   PetscInt       i,l = mglevels[0]->levels;
@@ -30,3 +32,106 @@ PetscErrorCode PCMGACycle_Private(PC pc,PC_MG_Levels **mglevels)
   }
   PetscFunctionReturn(0);
 }
+
+/*
+   AFACx: on each level i > 0 the correction is x_i = S_i (b_i - A_i P_i w_{i-1}) where w_{i-1} is the smoothed
+   (or, on the coarsest level, solved) restricted right hand side of the next coarser level. Removing the part
+   of the right hand side that the coarser level already handles keeps the levels from over correcting each other,
+   and w_{i-1} only depends on b_{i-1} so all the levels may be processed independently.
+*/
+static PetscErrorCode PCMGACycleAFACx_Private(PC pc,PC_MG_Levels **mglevels)
+{
+  PetscErrorCode ierr;
+  PetscInt       i,l = mglevels[0]->levels;
+  Vec            w;
+
+  PetscFunctionBegin;
+  for (i=l-1; i>0; i--) {
+    if (mglevels[i]->eventinterprestrict) {ierr = PetscLogEventBegin(mglevels[i]->eventinterprestrict,0,0,0,0);CHKERRQ(ierr);}
+    ierr = MatRestrict(mglevels[i]->restrct,mglevels[i]->b,mglevels[i-1]->b);CHKERRQ(ierr);
+    if (mglevels[i]->eventinterprestrict) {ierr = PetscLogEventEnd(mglevels[i]->eventinterprestrict,0,0,0,0);CHKERRQ(ierr);}
+  }
+  ierr = VecSet(mglevels[0]->x,0.0);CHKERRQ(ierr);
+  if (mglevels[0]->eventsmoothsolve) {ierr = PetscLogEventBegin(mglevels[0]->eventsmoothsolve,0,0,0,0);CHKERRQ(ierr);}
+  ierr = KSPSolve(mglevels[0]->smoothd,mglevels[0]->b,mglevels[0]->x);CHKERRQ(ierr);
+  if (mglevels[0]->eventsmoothsolve) {ierr = PetscLogEventEnd(mglevels[0]->eventsmoothsolve,0,0,0,0);CHKERRQ(ierr);}
+  for (i=1; i<l; i++) {
+    if (i == 1) w = mglevels[0]->x;
+    else {
+      /* the residual work vector of the coarser level is no longer needed, use it to hold w */
+      w    = mglevels[i-1]->r;
+      ierr = VecSet(w,0.0);CHKERRQ(ierr);
+      if (mglevels[i-1]->eventsmoothsolve) {ierr = PetscLogEventBegin(mglevels[i-1]->eventsmoothsolve,0,0,0,0);CHKERRQ(ierr);}
+      ierr = KSPSolve(mglevels[i-1]->smoothd,mglevels[i-1]->b,w);CHKERRQ(ierr);
+      if (mglevels[i-1]->eventsmoothsolve) {ierr = PetscLogEventEnd(mglevels[i-1]->eventsmoothsolve,0,0,0,0);CHKERRQ(ierr);}
+    }
+    if (mglevels[i]->eventinterprestrict) {ierr = PetscLogEventBegin(mglevels[i]->eventinterprestrict,0,0,0,0);CHKERRQ(ierr);}
+    ierr = MatInterpolate(mglevels[i]->interpolate,w,mglevels[i]->x);CHKERRQ(ierr);
+    if (mglevels[i]->eventinterprestrict) {ierr = PetscLogEventEnd(mglevels[i]->eventinterprestrict,0,0,0,0);CHKERRQ(ierr);}
+    if (mglevels[i]->eventresidual) {ierr = PetscLogEventBegin(mglevels[i]->eventresidual,0,0,0,0);CHKERRQ(ierr);}
+    ierr = (*mglevels[i]->residual)(mglevels[i]->A,mglevels[i]->b,mglevels[i]->x,mglevels[i]->r);CHKERRQ(ierr);
+    if (mglevels[i]->eventresidual) {ierr = PetscLogEventEnd(mglevels[i]->eventresidual,0,0,0,0);CHKERRQ(ierr);}
+    ierr = VecSet(mglevels[i]->x,0.0);CHKERRQ(ierr);
+    if (mglevels[i]->eventsmoothsolve) {ierr = PetscLogEventBegin(mglevels[i]->eventsmoothsolve,0,0,0,0);CHKERRQ(ierr);}
+    ierr = KSPSolve(mglevels[i]->smoothd,mglevels[i]->r,mglevels[i]->x);CHKERRQ(ierr);
+    if (mglevels[i]->eventsmoothsolve) {ierr = PetscLogEventEnd(mglevels[i]->eventsmoothsolve,0,0,0,0);CHKERRQ(ierr);}
+  }
+  for (i=1; i<l; i++) {
+    if (mglevels[i]->eventinterprestrict) {ierr = PetscLogEventBegin(mglevels[i]->eventinterprestrict,0,0,0,0);CHKERRQ(ierr);}
+    ierr = MatInterpolateAdd(mglevels[i]->interpolate,mglevels[i-1]->x,mglevels[i]->x,mglevels[i]->x);CHKERRQ(ierr);
+    if (mglevels[i]->eventinterprestrict) {ierr = PetscLogEventEnd(mglevels[i]->eventinterprestrict,0,0,0,0);CHKERRQ(ierr);}
+  }
+  PetscFunctionReturn(0);
+}
+
+/*
+   Mult-additive: the transfers are the l1-Jacobi smoothed interpolations (I - D_l1^{-1} A_i) P_i, built in PCSetUp_MG(),
+   and each level applies the symmetrized smoother (down then up). This reproduces the action of the multiplicative
+   V-cycle to first order while the level solves remain independent of each other.
+*/
+static PetscErrorCode PCMGACycleMult_Private(PC pc,PC_MG_Levels **mglevels)
+{
+  PetscErrorCode ierr;
+  PetscInt       i,l = mglevels[0]->levels;
+
+  PetscFunctionBegin;
+  for (i=l-1; i>0; i--) {
+    if (mglevels[i]->eventinterprestrict) {ierr = PetscLogEventBegin(mglevels[i]->eventinterprestrict,0,0,0,0);CHKERRQ(ierr);}
+    ierr = MatMultTranspose(mglevels[i]->sinterpolate,mglevels[i]->b,mglevels[i-1]->b);CHKERRQ(ierr);
+    if (mglevels[i]->eventinterprestrict) {ierr = PetscLogEventEnd(mglevels[i]->eventinterprestrict,0,0,0,0);CHKERRQ(ierr);}
+  }
+  for (i=0; i<l; i++) {
+    ierr = VecSet(mglevels[i]->x,0.0);CHKERRQ(ierr);
+    if (mglevels[i]->eventsmoothsolve) {ierr = PetscLogEventBegin(mglevels[i]->eventsmoothsolve,0,0,0,0);CHKERRQ(ierr);}
+    ierr = KSPSolve(mglevels[i]->smoothd,mglevels[i]->b,mglevels[i]->x);CHKERRQ(ierr);
+    if (i) {ierr = KSPSolve(mglevels[i]->smoothu,mglevels[i]->b,mglevels[i]->x);CHKERRQ(ierr);}
+    if (mglevels[i]->eventsmoothsolve) {ierr = PetscLogEventEnd(mglevels[i]->eventsmoothsolve,0,0,0,0);CHKERRQ(ierr);}
+  }
+  for (i=1; i<l; i++) {
+    if (mglevels[i]->eventinterprestrict) {ierr = PetscLogEventBegin(mglevels[i]->eventinterprestrict,0,0,0,0);CHKERRQ(ierr);}
+    ierr = MatMultAdd(mglevels[i]->sinterpolate,mglevels[i-1]->x,mglevels[i]->x,mglevels[i]->x);CHKERRQ(ierr);
+    if (mglevels[i]->eventinterprestrict) {ierr = PetscLogEventEnd(mglevels[i]->eventinterprestrict,0,0,0,0);CHKERRQ(ierr);}
+  }
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode PCMGACycle_Private(PC pc,PC_MG_Levels **mglevels)
+{
+  PC_MG          *mg = (PC_MG*)pc->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  switch (mg->additivetype) {
+  case PC_MG_ADDITIVE_STANDARD:
+    ierr = PCMGACycleStandard_Private(pc,mglevels);CHKERRQ(ierr);
+    break;
+  case PC_MG_ADDITIVE_AFACX:
+    ierr = PCMGACycleAFACx_Private(pc,mglevels);CHKERRQ(ierr);
+    break;
+  case PC_MG_ADDITIVE_MULT:
+    ierr = PCMGACycleMult_Private(pc,mglevels);CHKERRQ(ierr);
+    break;
+  default: SETERRQ1(PetscObjectComm((PetscObject)pc),PETSC_ERR_ARG_OUTOFRANGE,"Unknown additive multigrid type %d",(int)mg->additivetype);
+  }
+  PetscFunctionReturn(0);
+}
@@ -0,0 +1,327 @@
+/*
+   Include files needed for the variable size block PBJacobi preconditioner:
+     pcimpl.h - private include file intended for use by all preconditioners
+*/
+
+#include <petsc/private/pcimpl.h>   /*I "petscpc.h" I*/
+
+/*
+   Private context (data structure) for the VPBJacobi preconditioner.
+
+   The blocks are processed in batches of blocks with the same size, so that the loop over the blocks of one
+   batch uses a kernel with the block size fixed at compile time. For each block of a batch xoff[] gives its
+   first row and doff[] the location of its inverse in diag[].
+*/
+typedef struct {
+  PetscScalar *diag;          /* inverses of the blocks, column major, in the order of the blocks */
+  PetscInt    nblocks;        /* number of local blocks */
+  PetscInt    *bsizes;        /* block sizes, only allocated when the matrix provides none */
+  PetscInt    nbatch;         /* number of distinct block sizes */
+  PetscInt    *batchbs;       /* block size of each batch */
+  PetscInt    *batchstart;    /* blocks of batch b are xoff[batchstart[b]] ... xoff[batchstart[b+1]-1] */
+  PetscInt    *xoff,*doff;
+} PC_VPBJacobi;
+
+static PetscErrorCode PCApplyBatch_VPBJacobi_1(PetscInt n,const PetscInt *xoff,const PetscInt *doff,const PetscScalar *diag,const PetscScalar *xx,PetscScalar *yy)
+{
+  PetscErrorCode ierr;
+  PetscInt       i;
+
+  PetscFunctionBegin;
+  for (i=0; i<n; i++) yy[xoff[i]] = diag[doff[i]]*xx[xoff[i]];
+  ierr = PetscLogFlops(n);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PCApplyBatch_VPBJacobi_2(PetscInt n,const PetscInt *xoff,const PetscInt *doff,const PetscScalar *diag,const PetscScalar *xx,PetscScalar *yy)
+{
+  PetscErrorCode    ierr;
+  PetscInt          i;
+  const PetscScalar *d,*x;
+  PetscScalar       x0,x1,*y;
+
+  PetscFunctionBegin;
+  for (i=0; i<n; i++) {
+    d = diag + doff[i]; x = xx + xoff[i]; y = yy + xoff[i];
+    x0   = x[0]; x1 = x[1];
+    y[0] = d[0]*x0 + d[2]*x1;
+    y[1] = d[1]*x0 + d[3]*x1;
+  }
+  ierr = PetscLogFlops(6.0*n);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PCApplyBatch_VPBJacobi_3(PetscInt n,const PetscInt *xoff,const PetscInt *doff,const PetscScalar *diag,const PetscScalar *xx,PetscScalar *yy)
+{
+  PetscErrorCode    ierr;
+  PetscInt          i;
+  const PetscScalar *d,*x;
+  PetscScalar       x0,x1,x2,*y;
+
+  PetscFunctionBegin;
+  for (i=0; i<n; i++) {
+    d = diag + doff[i]; x = xx + xoff[i]; y = yy + xoff[i];
+    x0   = x[0]; x1 = x[1]; x2 = x[2];
+    y[0] = d[0]*x0 + d[3]*x1 + d[6]*x2;
+    y[1] = d[1]*x0 + d[4]*x1 + d[7]*x2;
+    y[2] = d[2]*x0 + d[5]*x1 + d[8]*x2;
+  }
+  ierr = PetscLogFlops(15.0*n);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PCApplyBatch_VPBJacobi_4(PetscInt n,const PetscInt *xoff,const PetscInt *doff,const PetscScalar *diag,const PetscScalar *xx,PetscScalar *yy)
+{
+  PetscErrorCode    ierr;
+  PetscInt          i;
+  const PetscScalar *d,*x;
+  PetscScalar       x0,x1,x2,x3,*y;
+
+  PetscFunctionBegin;
+  for (i=0; i<n; i++) {
+    d = diag + doff[i]; x = xx + xoff[i]; y = yy + xoff[i];
+    x0   = x[0]; x1 = x[1]; x2 = x[2]; x3 = x[3];
+    y[0] = d[0]*x0 + d[4]*x1 + d[8]*x2  + d[12]*x3;
+    y[1] = d[1]*x0 + d[5]*x1 + d[9]*x2  + d[13]*x3;
+    y[2] = d[2]*x0 + d[6]*x1 + d[10]*x2 + d[14]*x3;
+    y[3] = d[3]*x0 + d[7]*x1 + d[11]*x2 + d[15]*x3;
+  }
+  ierr = PetscLogFlops(28.0*n);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PCApplyBatch_VPBJacobi_5(PetscInt n,const PetscInt *xoff,const PetscInt *doff,const PetscScalar *diag,const PetscScalar *xx,PetscScalar *yy)
+{
+  PetscErrorCode    ierr;
+  PetscInt          i;
+  const PetscScalar *d,*x;
+  PetscScalar       x0,x1,x2,x3,x4,*y;
+
+  PetscFunctionBegin;
+  for (i=0; i<n; i++) {
+    d = diag + doff[i]; x = xx + xoff[i]; y = yy + xoff[i];
+    x0   = x[0]; x1 = x[1]; x2 = x[2]; x3 = x[3]; x4 = x[4];
+    y[0] = d[0]*x0 + d[5]*x1 + d[10]*x2 + d[15]*x3 + d[20]*x4;
+    y[1] = d[1]*x0 + d[6]*x1 + d[11]*x2 + d[16]*x3 + d[21]*x4;
+    y[2] = d[2]*x0 + d[7]*x1 + d[12]*x2 + d[17]*x3 + d[22]*x4;
+    y[3] = d[3]*x0 + d[8]*x1 + d[13]*x2 + d[18]*x3 + d[23]*x4;
+    y[4] = d[4]*x0 + d[9]*x1 + d[14]*x2 + d[19]*x3 + d[24]*x4;
+  }
+  ierr = PetscLogFlops(45.0*n);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PCApplyBatch_VPBJacobi_N(PetscInt bs,PetscInt n,const PetscInt *xoff,const PetscInt *doff,const PetscScalar *diag,const PetscScalar *xx,PetscScalar *yy)
+{
+  PetscErrorCode    ierr;
+  PetscInt          i,ib,jb;
+  const PetscScalar *d,*x;
+  PetscScalar       *y,rowsum;
+
+  PetscFunctionBegin;
+  for (i=0; i<n; i++) {
+    d = diag + doff[i]; x = xx + xoff[i]; y = yy + xoff[i];
+    for (ib=0; ib<bs; ib++) {
+      rowsum = 0;
+      for (jb=0; jb<bs; jb++) rowsum += d[ib+jb*bs]*x[jb];
+      y[ib] = rowsum;
+    }
+  }
+  ierr = PetscLogFlops((2.0*bs*bs-bs)*n);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PCApply_VPBJacobi(PC pc,Vec x,Vec y)
+{
+  PC_VPBJacobi      *jac = (PC_VPBJacobi*)pc->data;
+  PetscErrorCode    ierr;
+  PetscInt          b,n;
+  const PetscInt    *xoff,*doff;
+  const PetscScalar *xx;
+  PetscScalar       *yy;
+
+  PetscFunctionBegin;
+  ierr = VecGetArrayRead(x,&xx);CHKERRQ(ierr);
+  ierr = VecGetArray(y,&yy);CHKERRQ(ierr);
+  for (b=0; b<jac->nbatch; b++) {
+    n    = jac->batchstart[b+1] - jac->batchstart[b];
+    xoff = jac->xoff + jac->batchstart[b];
+    doff = jac->doff + jac->batchstart[b];
+    switch (jac->batchbs[b]) {
+    case 1:
+      ierr = PCApplyBatch_VPBJacobi_1(n,xoff,doff,jac->diag,xx,yy);CHKERRQ(ierr);
+      break;
+    case 2:
+      ierr = PCApplyBatch_VPBJacobi_2(n,xoff,doff,jac->diag,xx,yy);CHKERRQ(ierr);
+      break;
+    case 3:
+      ierr = PCApplyBatch_VPBJacobi_3(n,xoff,doff,jac->diag,xx,yy);CHKERRQ(ierr);
+      break;
+    case 4:
+      ierr = PCApplyBatch_VPBJacobi_4(n,xoff,doff,jac->diag,xx,yy);CHKERRQ(ierr);
+      break;
+    case 5:
+      ierr = PCApplyBatch_VPBJacobi_5(n,xoff,doff,jac->diag,xx,yy);CHKERRQ(ierr);
+      break;
+    default:
+      ierr = PCApplyBatch_VPBJacobi_N(jac->batchbs[b],n,xoff,doff,jac->diag,xx,yy);CHKERRQ(ierr);
+    }
+  }
+  ierr = VecRestoreArrayRead(x,&xx);CHKERRQ(ierr);
+  ierr = VecRestoreArray(y,&yy);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* -------------------------------------------------------------------------- */
+static PetscErrorCode PCReset_VPBJacobi(PC pc)
+{
+  PC_VPBJacobi   *jac = (PC_VPBJacobi*)pc->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscFree(jac->diag);CHKERRQ(ierr);
+  ierr = PetscFree(jac->bsizes);CHKERRQ(ierr);
+  ierr = PetscFree2(jac->batchbs,jac->batchstart);CHKERRQ(ierr);
+  ierr = PetscFree2(jac->xoff,jac->doff);CHKERRQ(ierr);
+  jac->nblocks = 0;
+  jac->nbatch  = 0;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PCSetUp_VPBJacobi(PC pc)
+{
+  PC_VPBJacobi   *jac = (PC_VPBJacobi*)pc->data;
+  PetscErrorCode ierr;
+  Mat            A = pc->pmat;
+  MatFactorError err;
+  PetscInt       i,b,nlocal,nblocks,bs,bsmax = 0,nsize = 0,xstart = 0,dstart = 0,*cnt;
+  const PetscInt *bsizes;
+
+  PetscFunctionBegin;
+  ierr = PCReset_VPBJacobi(pc);CHKERRQ(ierr);
+  ierr = MatGetVariableBlockSizes(A,&nblocks,&bsizes);CHKERRQ(ierr);
+  ierr = MatGetLocalSize(A,&nlocal,NULL);CHKERRQ(ierr);
+  if (nlocal && !nblocks) {
+    /* no variable block sizes provided, use the block size of the matrix */
+    ierr    = MatGetBlockSize(A,&bs);CHKERRQ(ierr);
+    nblocks = nlocal/bs;
+    ierr    = PetscMalloc1(nblocks,&jac->bsizes);CHKERRQ(ierr);
+    for (i=0; i<nblocks; i++) jac->bsizes[i] = bs;
+    bsizes  = jac->bsizes;
+  }
+  jac->nblocks = nblocks;
+  for (i=0; i<nblocks; i++) {
+    bsmax  = PetscMax(bsmax,bsizes[i]);
+    nsize += bsizes[i]*bsizes[i];
+  }
+  ierr = PetscMalloc1(nsize,&jac->diag);CHKERRQ(ierr);
+  ierr = PetscLogObjectMemory((PetscObject)pc,nsize*sizeof(PetscScalar));CHKERRQ(ierr);
+  ierr = MatInvertVariableBlockDiagonal(A,nblocks,bsizes,jac->diag);CHKERRQ(ierr);
+  ierr = MatFactorGetError(A,&err);CHKERRQ(ierr);
+  if (err) pc->failedreason = (PCFailedReason)err;
+
+  /* sort the blocks into batches of equal size with a counting sort on the block size */
+  ierr = PetscCalloc1(bsmax+2,&cnt);CHKERRQ(ierr);
+  for (i=0; i<nblocks; i++) cnt[bsizes[i]+1]++;
+  for (bs=1; bs<=bsmax; bs++) if (cnt[bs+1]) jac->nbatch++;
+  ierr = PetscMalloc2(jac->nbatch,&jac->batchbs,jac->nbatch+1,&jac->batchstart);CHKERRQ(ierr);
+  ierr = PetscMalloc2(nblocks,&jac->xoff,nblocks,&jac->doff);CHKERRQ(ierr);
+  jac->batchstart[0] = 0;
+  for (bs=1, b=0; bs<=bsmax; bs++) {
+    cnt[bs+1] += cnt[bs];
+    if (cnt[bs+1] > cnt[bs]) {
+      jac->batchbs[b]      = bs;
+      jac->batchstart[b+1] = cnt[bs+1];
+      b++;
+    }
+  }
+  for (i=0; i<nblocks; i++) {
+    bs = bsizes[i];
+    jac->xoff[cnt[bs]] = xstart;
+    jac->doff[cnt[bs]] = dstart;
+    cnt[bs]++;
+    xstart += bs;
+    dstart += bs*bs;
+  }
+  ierr = PetscFree(cnt);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+/* -------------------------------------------------------------------------- */
+static PetscErrorCode PCDestroy_VPBJacobi(PC pc)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PCReset_VPBJacobi(pc);CHKERRQ(ierr);
+  ierr = PetscFree(pc->data);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PCView_VPBJacobi(PC pc,PetscViewer viewer)
+{
+  PetscErrorCode ierr;
+  PC_VPBJacobi   *jac = (PC_VPBJacobi*)pc->data;
+  PetscBool      iascii;
+  PetscInt       b,nblocks,bsmin = PETSC_MAX_INT,bsmax = 0,lmin,lmax;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectTypeCompare((PetscObject)viewer,PETSCVIEWERASCII,&iascii);CHKERRQ(ierr);
+  if (iascii) {
+    for (b=0; b<jac->nbatch; b++) {
+      bsmin = PetscMin(bsmin,jac->batchbs[b]);
+      bsmax = PetscMax(bsmax,jac->batchbs[b]);
+    }
+    ierr = MPIU_Allreduce(&jac->nblocks,&nblocks,1,MPIU_INT,MPI_SUM,PetscObjectComm((PetscObject)pc));CHKERRQ(ierr);
+    ierr = MPIU_Allreduce(&bsmin,&lmin,1,MPIU_INT,MPI_MIN,PetscObjectComm((PetscObject)pc));CHKERRQ(ierr);
+    ierr = MPIU_Allreduce(&bsmax,&lmax,1,MPIU_INT,MPI_MAX,PetscObjectComm((PetscObject)pc));CHKERRQ(ierr);
+    if (nblocks) {
+      ierr = PetscViewerASCIIPrintf(viewer,"  number of point-blocks %D, point-block sizes %D to %D\n",nblocks,lmin,lmax);CHKERRQ(ierr);
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
+/* -------------------------------------------------------------------------- */
+/*MC
+     PCVPBJACOBI - Variable size point block Jacobi preconditioner
+
+   Notes:
+    See PCJACOBI for point Jacobi preconditioning and PCPBJACOBI for fixed size point block Jacobi preconditioning
+
+   This works for AIJ matrices and uses the block sizes provided to the matrix with MatSetVariableBlockSizes(); if
+   none were provided the block size of the matrix is used
+
+   Uses dense LU factorization with partial pivoting to invert the blocks; if a zero pivot
+   is detected a PETSc error is generated.
+
+   The blocks are applied in batches of blocks with the same size, each batch with a kernel specialized to its block size.
+
+   Level: beginner
+
+  Concepts: variable point block Jacobi
+
+.seealso:  MatSetVariableBlockSizes(), PCCreate(), PCSetType(), PCType (for list of available types), PC, PCJACOBI, PCPBJACOBI
+
+M*/
+
+PETSC_EXTERN PetscErrorCode PCCreate_VPBJacobi(PC pc)
+{
+  PC_VPBJacobi   *jac;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr     = PetscNewLog(pc,&jac);CHKERRQ(ierr);
+  pc->data = (void*)jac;
+
+  pc->ops->apply               = PCApply_VPBJacobi;
+  pc->ops->applytranspose      = 0;
+  pc->ops->setup               = PCSetUp_VPBJacobi;
+  pc->ops->reset               = PCReset_VPBJacobi;
+  pc->ops->destroy             = PCDestroy_VPBJacobi;
+  pc->ops->setfromoptions      = 0;
+  pc->ops->view                = PCView_VPBJacobi;
+  pc->ops->applyrichardson     = 0;
+  pc->ops->applysymmetricleft  = 0;
+  pc->ops->applysymmetricright = 0;
+  PetscFunctionReturn(0);
+}
@@ -1129,6 +1129,65 @@ PetscErrorCode  PCSetOperators(PC pc,Mat Amat,Mat Pmat)
   PetscFunctionReturn(0);
 }
 
+/*
+   MatSameNonzeroStructure_Private - Determines if two sequential matrices of the same type have identical
+   nonzero structure; matrices that do not provide MatGetRowIJ() are reported as different.
+*/
+static PetscErrorCode MatSameNonzeroStructure_Private(Mat A,Mat B,PetscBool *same)
+{
+  PetscErrorCode ierr;
+  PetscInt       ma,mb,na,nb,bsa,bsb;
+  const PetscInt *ia,*ja,*ib,*jb;
+  PetscBool      donea,doneb,sametype;
+
+  PetscFunctionBegin;
+  *same = PETSC_FALSE;
+  ierr  = PetscObjectTypeCompare((PetscObject)A,((PetscObject)B)->type_name,&sametype);CHKERRQ(ierr);
+  if (!sametype) PetscFunctionReturn(0);
+  ierr = MatGetSize(A,&ma,&na);CHKERRQ(ierr);
+  ierr = MatGetSize(B,&mb,&nb);CHKERRQ(ierr);
+  ierr = MatGetBlockSize(A,&bsa);CHKERRQ(ierr);
+  ierr = MatGetBlockSize(B,&bsb);CHKERRQ(ierr);
+  if (ma != mb || na != nb || bsa != bsb) PetscFunctionReturn(0);
+  ierr = MatGetRowIJ(A,0,PETSC_FALSE,PETSC_FALSE,&ma,&ia,&ja,&donea);CHKERRQ(ierr);
+  ierr = MatGetRowIJ(B,0,PETSC_FALSE,PETSC_FALSE,&mb,&ib,&jb,&doneb);CHKERRQ(ierr);
+  if (donea && doneb && ma == mb) {
+    ierr = PetscMemcmp(ia,ib,(ma+1)*sizeof(PetscInt),same);CHKERRQ(ierr);
+    if (*same) {ierr = PetscMemcmp(ja,jb,ia[ma]*sizeof(PetscInt),same);CHKERRQ(ierr);}
+  }
+  if (donea) {ierr = MatRestoreRowIJ(A,0,PETSC_FALSE,PETSC_FALSE,&ma,&ia,&ja,&donea);CHKERRQ(ierr);}
+  if (doneb) {ierr = MatRestoreRowIJ(B,0,PETSC_FALSE,PETSC_FALSE,&mb,&ib,&jb,&doneb);CHKERRQ(ierr);}
+  PetscFunctionReturn(0);
+}
+
+/*
+   PCSetSubOperators_Private - KSPSetOperators() for the block solvers of PCBJACOBI and PCASM
+
+   When the outer matrix changes its nonzero structure the blocks are extracted again as new matrices, which
+   would force each block preconditioner to recompute its ordering and symbolic factorization. If the new
+   block has exactly the nonzero structure of the block it replaces, the nonzero state of the new block is
+   recorded in the block preconditioner so that its next PCSetUp() sees SAME_NONZERO_PATTERN and only the
+   numerical factorization is redone.
+*/
+PetscErrorCode PCSetSubOperators_Private(KSP ksp,Mat Amat,Mat Pmat)
+{
+  PetscErrorCode ierr;
+  PC             subpc;
+  PetscBool      same = PETSC_FALSE;
+
+  PetscFunctionBegin;
+  ierr = KSPGetPC(ksp,&subpc);CHKERRQ(ierr);
+  if (subpc->setupcalled && subpc->pmat && Pmat && subpc->pmat != Pmat && subpc->matnonzerostate >= 0) {
+    ierr = MatSameNonzeroStructure_Private(subpc->pmat,Pmat,&same);CHKERRQ(ierr);
+  }
+  ierr = KSPSetOperators(ksp,Amat,Pmat);CHKERRQ(ierr);
+  if (same) {
+    ierr = MatGetNonzeroState(Pmat,&subpc->matnonzerostate);CHKERRQ(ierr);
+    ierr = PetscInfo(subpc,"Block nonzero structure unchanged, reusing ordering and symbolic factorization\n");CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
 /*@
    PCSetReusePreconditioner - reuse the current preconditioner even if the operator in the preconditioner has changed.
 
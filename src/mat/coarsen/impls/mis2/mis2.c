@@ -0,0 +1,353 @@
+/*
+    Distance-two maximal independent set (MIS-2) aggregation with hashed random priorities (Luby).
+
+    Every vertex gets a pseudo-random priority that is a hash of its global index, so the selected set, and the
+    aggregates built from it, depend only on the global graph and not on its parallel partitioning. Each round of
+    the Luby iteration is synchronous (Jacobi style): it takes two neighbor exchanges, one for each hop of the
+    distance-two neighborhood, and the local sweeps in between may be done concurrently over the vertices.
+
+    Reference: N. Bell, S. Dalton and L. Olson, Exposing fine-grained parallelism in algebraic multigrid methods,
+    SIAM J. Sci. Comput. 34 (2012).
+*/
+#include <petsc/private/matimpl.h>    /*I "petscmat.h" I*/
+#include <petsc/private/hashtable.h>
+#include <../src/mat/impls/aij/seq/aij.h>
+#include <../src/mat/impls/aij/mpi/mpiaij.h>
+#include <petscsf.h>
+
+#define MIS2_REMOVED   -2
+#define MIS2_OUT       -1
+#define MIS2_UNDECIDED  0
+#define MIS2_IN         1
+
+typedef struct {
+  PetscInt seed;   /* seed of the hashed priorities */
+  PetscInt rounds; /* number of Luby rounds of the last application */
+} MatCoarsen_MIS2;
+
+/*
+   Priority of an undecided vertex, in [0,2^30) so that it never collides with the keys of the decided vertices
+*/
+PETSC_STATIC_INLINE PetscInt MatCoarsenMIS2Priority_Private(PetscInt seed,PetscInt gid)
+{
+  return (PetscInt)(PetscHashCombine(PetscHashInt(seed),PetscHashInt(gid)) >> 2);
+}
+
+/*
+   (key,gid) pairs are compared lexicographically; the key is PETSC_MAX_INT for selected vertices, -1 for removed
+   vertices and the priority otherwise
+*/
+#define MIS2_GREATER(k1,g1,k2,g2) ((k1) > (k2) || ((k1) == (k2) && (g1) > (g2)))
+
+/*
+   One hop of the propagation: out[v] is the largest pair over v and its neighbors, in[] holds the local pairs and
+   ghost[] those of the off-process columns
+*/
+static void MatCoarsenMIS2Max_Private(PetscInt nloc,const PetscInt *ai,const PetscInt *aj,const PetscInt *bi,const PetscInt *bj,const PetscInt *in,const PetscInt *ghost,PetscInt *out)
+{
+  PetscInt v;
+
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(static)
+#endif
+  for (v=0; v<nloc; v++) {
+    PetscInt j,u,key = in[2*v],gid = in[2*v+1];
+
+    for (j=ai[v]; j<ai[v+1]; j++) {
+      u = aj[j];
+      if (MIS2_GREATER(in[2*u],in[2*u+1],key,gid)) {key = in[2*u]; gid = in[2*u+1];}
+    }
+    if (bi) {
+      for (j=bi[v]; j<bi[v+1]; j++) {
+        u = bj[j];
+        if (MIS2_GREATER(ghost[2*u],ghost[2*u+1],key,gid)) {key = ghost[2*u]; gid = ghost[2*u+1];}
+      }
+    }
+    out[2*v]   = key;
+    out[2*v+1] = gid;
+  }
+}
+
+static PetscErrorCode MatCoarsenApply_MIS2(MatCoarsen coarse)
+{
+  MatCoarsen_MIS2  *mis2 = (MatCoarsen_MIS2*)coarse->subctx;
+  Mat              Gmat = coarse->graph;
+  PetscErrorCode   ierr;
+  Mat_SeqAIJ       *matA,*matB = NULL;
+  Mat_MPIAIJ       *mpimat = NULL;
+  MPI_Comm         comm;
+  PetscBool        isMPI,isAIJ;
+  PetscSF          sf = NULL,aggsf;
+  PetscLayout      layout;
+  PetscInt         nloc = Gmat->rmap->n,nghost = 0,my0,Iend,v,j,u,c,k,nundecided,gnundecided,nremoved = 0,nselected = 0,nleaves,nmulti;
+  PetscInt         *ai,*aj,*bi = NULL,*bj = NULL,*tuple,*tuple1,*tuple2,*gtuple = NULL,*state,*lid_gid,*agg1,*agg2,*gagg = NULL,*ilocal,*iremote,*members;
+  const PetscInt   *degree;
+  PetscCoarsenData *agg_lists;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectGetComm((PetscObject)Gmat,&comm);CHKERRQ(ierr);
+  if (!coarse->strict_aggs) SETERRQ(comm,PETSC_ERR_SUP,"MIS-2 coarsening only supports strict aggregates");
+  ierr = PetscObjectBaseTypeCompare((PetscObject)Gmat,MATMPIAIJ,&isMPI);CHKERRQ(ierr);
+  if (isMPI) {
+    mpimat = (Mat_MPIAIJ*)Gmat->data;
+    matA   = (Mat_SeqAIJ*)mpimat->A->data;
+    matB   = (Mat_SeqAIJ*)mpimat->B->data;
+    nghost = mpimat->B->cmap->n;
+    bi     = matB->i;
+    bj     = matB->j;
+  } else {
+    ierr = PetscObjectBaseTypeCompare((PetscObject)Gmat,MATSEQAIJ,&isAIJ);CHKERRQ(ierr);
+    if (!isAIJ) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_USER,"Require AIJ matrix.");
+    matA = (Mat_SeqAIJ*)Gmat->data;
+  }
+  ai   = matA->i;
+  aj   = matA->j;
+  ierr = MatGetOwnershipRange(Gmat,&my0,&Iend);CHKERRQ(ierr);
+  ierr = MatGetLayouts(Gmat,&layout,NULL);CHKERRQ(ierr);
+  if (mpimat) {
+    ierr = PetscSFCreate(comm,&sf);CHKERRQ(ierr);
+    ierr = PetscSFSetGraphLayout(sf,layout,nghost,NULL,PETSC_COPY_VALUES,mpimat->garray);CHKERRQ(ierr);
+    ierr = PetscMalloc2(2*nghost,&gtuple,nghost,&gagg);CHKERRQ(ierr);
+  }
+  ierr = PetscMalloc4(2*nloc,&tuple,2*nloc,&tuple1,2*nloc,&tuple2,nloc,&state);CHKERRQ(ierr);
+  ierr = PetscMalloc3(nloc,&lid_gid,nloc,&agg1,nloc,&agg2);CHKERRQ(ierr);
+
+  /* vertices without any neighbor are removed, as in MATCOARSENMIS */
+  for (v=0; v<nloc; v++) {
+    lid_gid[v] = my0 + v;
+    state[v]   = MIS2_UNDECIDED;
+    if (ai[v+1] - ai[v] < 2 && (!bi || bi[v+1] == bi[v])) {
+      if (ai[v+1] == ai[v] || aj[ai[v]] == v) {state[v] = MIS2_REMOVED; nremoved++;}
+    }
+    tuple[2*v]   = state[v] == MIS2_REMOVED ? -1 : MatCoarsenMIS2Priority_Private(mis2->seed,lid_gid[v]);
+    tuple[2*v+1] = lid_gid[v];
+  }
+
+  /* Luby rounds: a vertex is selected when it is the largest in its distance-two neighborhood */
+  for (mis2->rounds=1; ; mis2->rounds++) {
+    if (sf) {
+      ierr = PetscSFBcastBegin(sf,MPIU_2INT,tuple,gtuple);CHKERRQ(ierr);
+      ierr = PetscSFBcastEnd(sf,MPIU_2INT,tuple,gtuple);CHKERRQ(ierr);
+    }
+    MatCoarsenMIS2Max_Private(nloc,ai,aj,bi,bj,tuple,gtuple,tuple1);
+    if (sf) {
+      ierr = PetscSFBcastBegin(sf,MPIU_2INT,tuple1,gtuple);CHKERRQ(ierr);
+      ierr = PetscSFBcastEnd(sf,MPIU_2INT,tuple1,gtuple);CHKERRQ(ierr);
+    }
+    MatCoarsenMIS2Max_Private(nloc,ai,aj,bi,bj,tuple1,gtuple,tuple2);
+    nundecided = 0;
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(static) reduction(+:nundecided)
+#endif
+    for (v=0; v<nloc; v++) {
+      if (state[v] != MIS2_UNDECIDED) continue;
+      if (tuple2[2*v+1] == tuple[2*v+1]) {
+        state[v] = MIS2_IN; tuple[2*v] = PETSC_MAX_INT;
+      } else if (tuple2[2*v] == PETSC_MAX_INT) {
+        state[v] = MIS2_OUT; tuple[2*v] = -1;
+      } else nundecided++;
+    }
+    ierr = MPIU_Allreduce(&nundecided,&gnundecided,1,MPIU_INT,MPI_SUM,comm);CHKERRQ(ierr);
+    if (!gnundecided) break;
+  }
+
+  /* the neighbors of a selected vertex join its aggregate; there is at most one since the selected vertices are at distance three or more */
+  for (v=0; v<nloc; v++) agg1[v] = state[v] == MIS2_IN ? lid_gid[v] : -1;
+  if (sf) {
+    ierr = PetscSFBcastBegin(sf,MPIU_INT,agg1,gagg);CHKERRQ(ierr);
+    ierr = PetscSFBcastEnd(sf,MPIU_INT,agg1,gagg);CHKERRQ(ierr);
+  }
+  for (v=0; v<nloc; v++) {
+    agg2[v] = agg1[v];
+    if (state[v] == MIS2_IN) {nselected++; continue;}
+    for (j=ai[v]; j<ai[v+1] && agg2[v] < 0; j++) {
+      u = aj[j];
+      if (state[u] == MIS2_IN) agg2[v] = lid_gid[u];
+    }
+    if (bi) {
+      for (j=bi[v]; j<bi[v+1] && agg2[v] < 0; j++) {
+        c = bj[j];
+        if (gagg[c] >= 0) agg2[v] = gagg[c];
+      }
+    }
+  }
+  for (v=0; v<nloc; v++) agg1[v] = agg2[v];
+
+  /* the remaining vertices join the aggregate of a neighbor, choosing by the priority of the aggregates so the result is independent of the partitioning */
+  if (sf) {
+    ierr = PetscSFBcastBegin(sf,MPIU_INT,agg1,gagg);CHKERRQ(ierr);
+    ierr = PetscSFBcastEnd(sf,MPIU_INT,agg1,gagg);CHKERRQ(ierr);
+  }
+  for (v=0; v<nloc; v++) {
+    PetscInt best = -1,bestkey = -1,r,key;
+
+    if (agg1[v] >= 0 || state[v] == MIS2_REMOVED) continue;
+    for (j=ai[v]; j<ai[v+1]; j++) {
+      if ((r = agg1[aj[j]]) < 0) continue;
+      key = MatCoarsenMIS2Priority_Private(mis2->seed,r);
+      if (MIS2_GREATER(key,r,bestkey,best)) {bestkey = key; best = r;}
+    }
+    if (bi) {
+      for (j=bi[v]; j<bi[v+1]; j++) {
+        if ((r = gagg[bj[j]]) < 0) continue;
+        key = MatCoarsenMIS2Priority_Private(mis2->seed,r);
+        if (MIS2_GREATER(key,r,bestkey,best)) {bestkey = key; best = r;}
+      }
+    }
+    /* only possible for a nonsymmetric graph; the vertex then makes its own aggregate */
+    agg2[v] = best >= 0 ? best : lid_gid[v];
+    if (best < 0) nselected++;
+  }
+  ierr = PetscInfo4(Gmat,"\t removed %D of %D vertices.  %D selected in %D rounds.\n",nremoved,nloc,nselected,mis2->rounds);CHKERRQ(ierr);
+
+  /* send the global index of every vertex to the process owning the root of its aggregate */
+  for (v=0,nleaves=0; v<nloc; v++) if (agg2[v] >= 0 && agg2[v] != lid_gid[v]) nleaves++;
+  ierr = PetscMalloc2(nleaves,&ilocal,nleaves,&iremote);CHKERRQ(ierr);
+  for (v=0,nleaves=0; v<nloc; v++) {
+    if (agg2[v] >= 0 && agg2[v] != lid_gid[v]) {
+      ilocal[nleaves]  = v;
+      iremote[nleaves] = agg2[v];
+      nleaves++;
+    }
+  }
+  ierr = PetscSFCreate(comm,&aggsf);CHKERRQ(ierr);
+  ierr = PetscSFSetGraphLayout(aggsf,layout,nleaves,ilocal,PETSC_COPY_VALUES,iremote);CHKERRQ(ierr);
+  ierr = PetscFree2(ilocal,iremote);CHKERRQ(ierr);
+  ierr = PetscSFComputeDegreeBegin(aggsf,&degree);CHKERRQ(ierr);
+  ierr = PetscSFComputeDegreeEnd(aggsf,&degree);CHKERRQ(ierr);
+  for (v=0,nmulti=0; v<nloc; v++) nmulti += degree[v];
+  ierr = PetscMalloc1(nmulti,&members);CHKERRQ(ierr);
+  ierr = PetscSFGatherBegin(aggsf,MPIU_INT,lid_gid,members);CHKERRQ(ierr);
+  ierr = PetscSFGatherEnd(aggsf,MPIU_INT,lid_gid,members);CHKERRQ(ierr);
+
+  ierr = PetscCDCreate(nloc,&agg_lists);CHKERRQ(ierr);
+  for (v=0,k=0; v<nloc; v++) {
+    if (agg2[v] != lid_gid[v]) continue;
+    ierr = PetscCDAppendID(agg_lists,v,lid_gid[v]);CHKERRQ(ierr);
+    ierr = PetscSortInt(degree[v],members+k);CHKERRQ(ierr);
+    for (j=0; j<degree[v]; j++) {
+      ierr = PetscCDAppendID(agg_lists,v,members[k+j]);CHKERRQ(ierr);
+    }
+    k += degree[v];
+  }
+  coarse->agg_lists = agg_lists;
+
+  /* members of an aggregate at distance two of its root may not be ghosts of the graph; pass a matrix whose ghosts include them, as MATCOARSENHEM does */
+  if (mpimat) {
+    Mat         mat;
+    PetscInt    *onnz,gid1;
+    PetscScalar one = 1.0;
+
+    ierr = PetscCalloc1(nloc,&onnz);CHKERRQ(ierr);
+    for (v=0,k=0; v<nloc; v++) {
+      if (agg2[v] != lid_gid[v]) continue;
+      for (j=0; j<degree[v]; j++) if (members[k+j] < my0 || members[k+j] >= Iend) onnz[v]++;
+      k += degree[v];
+    }
+    ierr = MatCreateAIJ(comm,nloc,nloc,PETSC_DETERMINE,PETSC_DETERMINE,0,NULL,0,onnz,&mat);CHKERRQ(ierr);
+    for (v=0,k=0; v<nloc; v++) {
+      if (agg2[v] != lid_gid[v]) continue;
+      for (j=0; j<degree[v]; j++) {
+        gid1 = members[k+j];
+        if (gid1 < my0 || gid1 >= Iend) {
+          ierr = MatSetValues(mat,1,&lid_gid[v],1,&gid1,&one,INSERT_VALUES);CHKERRQ(ierr);
+        }
+      }
+      k += degree[v];
+    }
+    ierr = MatAssemblyBegin(mat,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+    ierr = MatAssemblyEnd(mat,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+    ierr = PetscCDSetMat(agg_lists,mat);CHKERRQ(ierr);
+    ierr = PetscFree(onnz);CHKERRQ(ierr);
+  }
+
+  ierr = PetscFree(members);CHKERRQ(ierr);
+  ierr = PetscSFDestroy(&aggsf);CHKERRQ(ierr);
+  ierr = PetscSFDestroy(&sf);CHKERRQ(ierr);
+  ierr = PetscFree2(gtuple,gagg);CHKERRQ(ierr);
+  ierr = PetscFree4(tuple,tuple1,tuple2,state);CHKERRQ(ierr);
+  ierr = PetscFree3(lid_gid,agg1,agg2);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatCoarsenSetFromOptions_MIS2(PetscOptionItems *PetscOptionsObject,MatCoarsen coarse)
+{
+  MatCoarsen_MIS2 *mis2 = (MatCoarsen_MIS2*)coarse->subctx;
+  PetscErrorCode  ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscOptionsHead(PetscOptionsObject,"MIS-2 coarsener options");CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-mat_coarsen_mis2_seed","Seed of the hashed vertex priorities","None",mis2->seed,&mis2->seed,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsTail();CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatCoarsenView_MIS2(MatCoarsen coarse,PetscViewer viewer)
+{
+  MatCoarsen_MIS2 *mis2 = (MatCoarsen_MIS2*)coarse->subctx;
+  PetscErrorCode  ierr;
+  PetscBool       iascii;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(coarse,MAT_COARSEN_CLASSID,1);
+  ierr = PetscObjectTypeCompare((PetscObject)viewer,PETSCVIEWERASCII,&iascii);CHKERRQ(ierr);
+  if (iascii) {
+    ierr = PetscViewerASCIIPrintf(viewer,"  MIS-2 aggregator, priority seed %D\n",mis2->seed);CHKERRQ(ierr);
+    if (mis2->rounds) {
+      ierr = PetscViewerASCIIPrintf(viewer,"  Luby rounds used in the last coarsening %D\n",mis2->rounds);CHKERRQ(ierr);
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatCoarsenDestroy_MIS2(MatCoarsen coarse)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(coarse,MAT_COARSEN_CLASSID,1);
+  ierr = PetscFree(coarse->subctx);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*MC
+   MATCOARSENMIS2 - A coarsener that aggregates around a distance-two maximal independent set computed with
+   hashed random priorities (Luby's algorithm)
+
+   Options Database Keys:
+.  -mat_coarsen_mis2_seed <seed> - seed of the hashed vertex priorities
+
+   Level: beginner
+
+   Notes:
+    The priority of each vertex is a hash of its global index, hence for a given graph the aggregates do not depend on
+    the number of processes or on the partitioning. Every round of the algorithm needs two neighbor exchanges and one
+    reduction, and the number of rounds grows only logarithmically with the size of the graph.
+
+    Each selected vertex forms an aggregate with its neighbors; the other vertices are at distance two of a selected
+    vertex and join the aggregate of one of their neighbors. The aggregates are thus similar to those of MATCOARSENMIS
+    on the squared graph, so PCGAMG does not square the graph when this coarsener is used.
+
+    The greedy ordering set with MatCoarsenSetGreedyOrdering() is ignored. Only strict aggregates are supported.
+
+.keywords: Coarsen, create, context
+
+.seealso: MatCoarsenSetType(), MatCoarsenType, MatCoarsenCreate(), MATCOARSENMIS
+
+M*/
+
+PETSC_EXTERN PetscErrorCode MatCoarsenCreate_MIS2(MatCoarsen coarse)
+{
+  PetscErrorCode  ierr;
+  MatCoarsen_MIS2 *mis2;
+
+  PetscFunctionBegin;
+  ierr           = PetscNewLog(coarse,&mis2);CHKERRQ(ierr);
+  coarse->subctx = (void*)mis2;
+
+  coarse->ops->apply          = MatCoarsenApply_MIS2;
+  coarse->ops->view           = MatCoarsenView_MIS2;
+  coarse->ops->destroy        = MatCoarsenDestroy_MIS2;
+  coarse->ops->setfromoptions = MatCoarsenSetFromOptions_MIS2;
+  PetscFunctionReturn(0);
+}
@@ -0,0 +1,113 @@
+
+static char help[] = "Partitions the graph of a two dimensional grid with the native multilevel partitioner.\n\
+Input parameters include:\n\
+  -m <m>, -n <n>   : the grid has m x n vertices\n\
+  -nparts <p>      : number of parts, by default the number of processes\n\
+  -weighted        : the vertices of the left half of the grid have weight 3\n\
+  -refined         : the vertices of the first quarter of the rows have weight 2, as after a local refinement\n\n";
+
+#include <petscmat.h>
+
+static PetscInt VertexWeight(PetscInt i,PetscInt j,PetscInt m,PetscInt n,PetscBool weighted,PetscBool refined)
+{
+  if (weighted && j < n/2) return 3;
+  if (refined && i < m/4)  return 2;
+  return 1;
+}
+
+int main(int argc,char **args)
+{
+  Mat             A;
+  MatPartitioning part;
+  IS              is;
+  const PetscInt  *parts;
+  PetscInt        m = 24,n = 20,nparts,rstart,rend,row,i,j,p,k,*ia,*ja,*vwgt,*pwgt,*gpwgt,tvwgt,cut,migration,nlocal;
+  PetscMPIInt     size;
+  PetscBool       weighted = PETSC_FALSE,refined = PETSC_FALSE;
+  PetscErrorCode  ierr;
+
+  ierr = PetscInitialize(&argc,&args,(char*)0,help);if (ierr) return ierr;
+  ierr = MPI_Comm_size(PETSC_COMM_WORLD,&size);CHKERRQ(ierr);
+  nparts = size;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-m",&m,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-n",&n,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-nparts",&nparts,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetBool(NULL,NULL,"-weighted",&weighted,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetBool(NULL,NULL,"-refined",&refined,NULL);CHKERRQ(ierr);
+
+  /* the graph of the five point stencil, distributed by rows of the grid */
+  nlocal = PETSC_DECIDE;
+  ierr   = PetscSplitOwnership(PETSC_COMM_WORLD,&nlocal,&m);CHKERRQ(ierr);
+  ierr   = MPI_Scan(&nlocal,&rend,1,MPIU_INT,MPI_SUM,PETSC_COMM_WORLD);CHKERRQ(ierr);
+  rstart = (rend - nlocal)*n; rend *= n; nlocal *= n;
+  ierr = PetscMalloc1(nlocal+1,&ia);CHKERRQ(ierr);
+  ierr = PetscMalloc1(4*nlocal,&ja);CHKERRQ(ierr);
+  ierr = PetscMalloc1(nlocal,&vwgt);CHKERRQ(ierr);
+  ia[0] = 0;
+  for (k=0, row=rstart; row<rend; row++) {
+    i = row/n; j = row - i*n;
+    if (i > 0)   ja[k++] = row - n;
+    if (j > 0)   ja[k++] = row - 1;
+    if (j < n-1) ja[k++] = row + 1;
+    if (i < m-1) ja[k++] = row + n;
+    ia[row-rstart+1] = k;
+    vwgt[row-rstart] = VertexWeight(i,j,m,n,weighted,refined);
+  }
+  ierr = MatCreateMPIAdj(PETSC_COMM_WORLD,nlocal,m*n,ia,ja,NULL,&A);CHKERRQ(ierr);
+
+  ierr = MatPartitioningCreate(PETSC_COMM_WORLD,&part);CHKERRQ(ierr);
+  ierr = MatPartitioningSetAdjacency(part,A);CHKERRQ(ierr);
+  ierr = MatPartitioningSetType(part,MATPARTITIONINGMULTILEVEL);CHKERRQ(ierr);
+  ierr = MatPartitioningSetNParts(part,nparts);CHKERRQ(ierr);
+  if (weighted || refined) {ierr = MatPartitioningSetVertexWeights(part,vwgt);CHKERRQ(ierr);}
+  ierr = MatPartitioningSetFromOptions(part);CHKERRQ(ierr);
+  ierr = MatPartitioningApply(part,&is);CHKERRQ(ierr);
+  ierr = MatPartitioningMultilevelGetEdgeCut(part,&cut);CHKERRQ(ierr);
+  ierr = MatPartitioningMultilevelGetMigration(part,&migration);CHKERRQ(ierr);
+  ierr = MatPartitioningView(part,PETSC_VIEWER_STDOUT_WORLD);CHKERRQ(ierr);
+
+  /* the weight of each part */
+  ierr = PetscCalloc2(nparts,&pwgt,nparts,&gpwgt);CHKERRQ(ierr);
+  ierr = ISGetIndices(is,&parts);CHKERRQ(ierr);
+  for (tvwgt=0, row=rstart; row<rend; row++) {
+    k           = VertexWeight(row/n,row%n,m,n,weighted,refined);
+    pwgt[parts[row-rstart]] += k;
+    tvwgt      += k;
+  }
+  ierr = ISRestoreIndices(is,&parts);CHKERRQ(ierr);
+  ierr = MPIU_Allreduce(pwgt,gpwgt,nparts,MPIU_INT,MPI_SUM,PETSC_COMM_WORLD);CHKERRQ(ierr);
+  ierr = MPIU_Allreduce(MPI_IN_PLACE,&tvwgt,1,MPIU_INT,MPI_SUM,PETSC_COMM_WORLD);CHKERRQ(ierr);
+  for (k=0, p=0; p<nparts; p++) k = PetscMax(k,gpwgt[p]);
+  ierr = PetscPrintf(PETSC_COMM_WORLD,"Parts %D, edge cut %D, migration %D, imbalance %s 1.05\n",nparts,cut,migration,k*nparts <= 1.05*tvwgt ? "<=" : ">");CHKERRQ(ierr);
+
+  if (!weighted && !refined) {ierr = PetscFree(vwgt);CHKERRQ(ierr);} /* otherwise owned by the partitioning */
+  ierr = PetscFree2(pwgt,gpwgt);CHKERRQ(ierr);
+  ierr = ISDestroy(&is);CHKERRQ(ierr);
+  ierr = MatPartitioningDestroy(&part);CHKERRQ(ierr);
+  ierr = MatDestroy(&A);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   test:
+      nsize: 1
+      args: -nparts 4
+
+   test:
+      suffix: 2
+      nsize: 3
+      args: -m 60 -n 50 -nparts 7
+
+   test:
+      suffix: 3
+      nsize: 4
+      args: -m 40 -n 40 -weighted
+
+   test:
+      suffix: repartition
+      nsize: 4
+      args: -m 80 -n 60 -refined -mat_partitioning_multilevel_repartition
+
+TEST*/
@@ -2401,6 +2401,17 @@ PetscErrorCode  MatInvertBlockDiagonal_MPIAIJ(Mat A,const PetscScalar **values)
   PetscFunctionReturn(0);
 }
 
+PetscErrorCode  MatInvertVariableBlockDiagonal_MPIAIJ(Mat A,PetscInt nblocks,const PetscInt *bsizes,PetscScalar *diag)
+{
+  Mat_MPIAIJ     *a = (Mat_MPIAIJ*) A->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatInvertVariableBlockDiagonal(a->A,nblocks,bsizes,diag);CHKERRQ(ierr);
+  A->factorerrortype = a->A->factorerrortype;
+  PetscFunctionReturn(0);
+}
+
 static PetscErrorCode  MatSetRandom_MPIAIJ(Mat x,PetscRandom rctx)
 {
   PetscErrorCode ierr;
@@ -2641,7 +2652,9 @@ static struct _MatOps MatOps_Values = {MatSetValues_MPIAIJ,
                                        0,
                                        MatFDColoringSetUp_MPIXAIJ,
                                        MatFindOffBlockDiagonalEntries_MPIAIJ,
-                                /*144*/MatCreateMPIMatConcatenateSeqMat_MPIAIJ
+                                /*144*/MatCreateMPIMatConcatenateSeqMat_MPIAIJ,
+                                       0,
+                                       MatInvertVariableBlockDiagonal_MPIAIJ
 };
 
 /* ----------------------------------------------------------------------------------------*/
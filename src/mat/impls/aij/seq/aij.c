@@ -3083,6 +3083,86 @@ PetscErrorCode MatInvertBlockDiagonal_SeqAIJ(Mat A,const PetscScalar **values)
   PetscFunctionReturn(0);
 }
 
+/*
+   The diagonal blocks are gathered directly from the compressed rows (the column indices are sorted so each
+   row of a block is a contiguous piece of the row) and inverted with the fixed size kernels for sizes up to 7.
+*/
+PetscErrorCode MatInvertVariableBlockDiagonal_SeqAIJ(Mat A,PetscInt nblocks,const PetscInt *bsizes,PetscScalar *diag)
+{
+  Mat_SeqAIJ      *a = (Mat_SeqAIJ*) A->data;
+  PetscErrorCode  ierr;
+  PetscInt        i,j,k,row,bs,bsmax = 0,start = 0,ipvt[5],*v_pivots;
+  const PetscInt  *aj;
+  const MatScalar *aa;
+  MatScalar       work[25],*v_work;
+  PetscReal       shift = 0.0;
+  PetscBool       allowzeropivot,zeropivotdetected = PETSC_FALSE;
+
+  PetscFunctionBegin;
+  allowzeropivot = PetscNot(A->erroriffailure);
+  for (i=0; i<nblocks; i++) bsmax = PetscMax(bsmax,bsizes[i]);
+  ierr = PetscMalloc2(bsmax,&v_work,bsmax,&v_pivots);CHKERRQ(ierr);
+  for (i=0; i<nblocks; i++) {
+    bs   = bsizes[i];
+    ierr = PetscMemzero(diag,bs*bs*sizeof(PetscScalar));CHKERRQ(ierr);
+    for (j=0; j<bs; j++) {
+      row = start + j;
+      aj  = a->j + a->i[row];
+      aa  = a->a + a->i[row];
+      for (k=0; k<a->i[row+1]-a->i[row]; k++) {
+        if (aj[k] < start) continue;
+        if (aj[k] >= start + bs) break;
+        diag[j*bs + aj[k] - start] = aa[k];
+      }
+    }
+    switch (bs) {
+    case 1:
+      if (PetscAbsScalar(diag[0] + shift) < PETSC_MACHINE_EPSILON) {
+        if (allowzeropivot) {
+          A->factorerrortype             = MAT_FACTOR_NUMERIC_ZEROPIVOT;
+          A->factorerror_zeropivot_value = PetscAbsScalar(diag[0]);
+          A->factorerror_zeropivot_row   = start;
+          ierr = PetscInfo3(A,"Zero pivot, row %D pivot %g tolerance %g\n",start,(double)PetscAbsScalar(diag[0]),(double)PETSC_MACHINE_EPSILON);CHKERRQ(ierr);
+        } else SETERRQ3(PETSC_COMM_SELF,PETSC_ERR_MAT_LU_ZRPVT,"Zero pivot, row %D pivot %g tolerance %g",start,(double)PetscAbsScalar(diag[0]),(double)PETSC_MACHINE_EPSILON);
+      }
+      diag[0] = (PetscScalar)1.0 / (diag[0] + shift);
+      break;
+    case 2:
+      ierr = PetscKernel_A_gets_inverse_A_2(diag,shift,allowzeropivot,&zeropivotdetected);CHKERRQ(ierr);
+      ierr = PetscKernel_A_gets_transpose_A_2(diag);CHKERRQ(ierr);
+      break;
+    case 3:
+      ierr = PetscKernel_A_gets_inverse_A_3(diag,shift,allowzeropivot,&zeropivotdetected);CHKERRQ(ierr);
+      ierr = PetscKernel_A_gets_transpose_A_3(diag);CHKERRQ(ierr);
+      break;
+    case 4:
+      ierr = PetscKernel_A_gets_inverse_A_4(diag,shift,allowzeropivot,&zeropivotdetected);CHKERRQ(ierr);
+      ierr = PetscKernel_A_gets_transpose_A_4(diag);CHKERRQ(ierr);
+      break;
+    case 5:
+      ierr = PetscKernel_A_gets_inverse_A_5(diag,ipvt,work,shift,allowzeropivot,&zeropivotdetected);CHKERRQ(ierr);
+      ierr = PetscKernel_A_gets_transpose_A_5(diag);CHKERRQ(ierr);
+      break;
+    case 6:
+      ierr = PetscKernel_A_gets_inverse_A_6(diag,shift,allowzeropivot,&zeropivotdetected);CHKERRQ(ierr);
+      ierr = PetscKernel_A_gets_transpose_A_6(diag);CHKERRQ(ierr);
+      break;
+    case 7:
+      ierr = PetscKernel_A_gets_inverse_A_7(diag,shift,allowzeropivot,&zeropivotdetected);CHKERRQ(ierr);
+      ierr = PetscKernel_A_gets_transpose_A_7(diag);CHKERRQ(ierr);
+      break;
+    default:
+      ierr = PetscKernel_A_gets_inverse_A(bs,diag,v_pivots,v_work,allowzeropivot,&zeropivotdetected);CHKERRQ(ierr);
+      ierr = PetscKernel_A_gets_transpose_A_N(diag,bs);CHKERRQ(ierr);
+    }
+    if (zeropivotdetected) A->factorerrortype = MAT_FACTOR_NUMERIC_ZEROPIVOT;
+    diag  += bs*bs;
+    start += bs;
+  }
+  ierr = PetscFree2(v_work,v_pivots);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 static PetscErrorCode  MatSetRandom_SeqAIJ(Mat x,PetscRandom rctx)
 {
   PetscErrorCode ierr;
@@ -3265,7 +3345,8 @@ static struct _MatOps MatOps_Values = { MatSetValues_SeqAIJ,
                                         MatFDColoringSetUp_SeqXAIJ,
                                         MatFindOffBlockDiagonalEntries_SeqAIJ,
                                  /*144*/MatCreateMPIMatConcatenateSeqMat_SeqAIJ,
-                                        MatDestroySubMatrices_SeqAIJ
+                                        MatDestroySubMatrices_SeqAIJ,
+                                        MatInvertVariableBlockDiagonal_SeqAIJ
 };
 
 PetscErrorCode  MatSeqAIJSetColumnIndices_SeqAIJ(Mat mat,PetscInt *indices)
@@ -0,0 +1,370 @@
+/*
+    Provides an iterative (Chow-Patel fine-grained parallel) incomplete LU factorization for SeqAIJ matrices.
+
+    The nonzero pattern of the factor is computed by the standard PETSc ILU(k) symbolic factorization; the
+    numerical values are then obtained by a fixed number of Jacobi-style fixed-point sweeps over all the
+    nonzeros of the factor, each of which is independent of the others within a sweep. The triangular solves
+    may also be replaced by a fixed number of Jacobi iterations. Neither phase uses level scheduling.
+
+    Reference: E. Chow and A. Patel, Fine-grained parallel incomplete LU factorization, SIAM J. Sci. Comput. 37 (2015).
+*/
+#include <../src/mat/impls/aij/seq/aij.h>
+
+typedef struct {
+  PetscInt    factorsweeps;  /* number of fixed-point sweeps used to compute the factor */
+  PetscInt    solvesweeps;   /* number of Jacobi iterations for each triangular solve, 0 means exact solves */
+  PetscInt    *amap;         /* location in A->a of each nonzero of the factor, -1 for fill */
+  PetscInt    *ucolptr;      /* column oriented (CSC) access to U, including the diagonal */
+  PetscInt    *ucolrow;
+  PetscInt    *ucolpos;
+  PetscScalar *aval;         /* entries of the (permuted) matrix in the layout of the factor */
+  PetscScalar *work;         /* second copy of the factor used by the sweeps */
+  PetscScalar *swork;        /* work space used by the Jacobi triangular solves */
+} Mat_ChowILU;
+
+static PetscErrorCode MatChowILUDestroy_Private(void *ptr)
+{
+  Mat_ChowILU    *chow = (Mat_ChowILU*)ptr;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscFree(chow->amap);CHKERRQ(ierr);
+  ierr = PetscFree3(chow->ucolptr,chow->ucolrow,chow->ucolpos);CHKERRQ(ierr);
+  ierr = PetscFree2(chow->aval,chow->work);CHKERRQ(ierr);
+  ierr = PetscFree(chow->swork);CHKERRQ(ierr);
+  ierr = PetscFree(chow);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatChowILUGetContext_Private(Mat fact,Mat_ChowILU **chow)
+{
+  PetscContainer container;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectQuery((PetscObject)fact,"MatChowILU",(PetscObject*)&container);CHKERRQ(ierr);
+  if (!container) SETERRQ(PetscObjectComm((PetscObject)fact),PETSC_ERR_ARG_WRONGSTATE,"Matrix was not obtained with MatGetFactor() for MATSOLVERCHOWILU");
+  ierr = PetscContainerGetPointer(container,(void**)chow);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   Computes the sum over k < min(i,j) of L(i,k) U(k,j) by merging the (sorted) row i of L with the (sorted) column j of U
+*/
+PETSC_STATIC_INLINE PetscScalar MatChowILUDot_Private(const PetscInt *bj,PetscInt lstart,PetscInt lend,const PetscInt *crow,const PetscInt *cpos,PetscInt cstart,PetscInt cend,PetscInt bound,const MatScalar *lu)
+{
+  PetscScalar sum = 0.0;
+  PetscInt    q = lstart,c = cstart,kq,kc;
+
+  while (q < lend && c < cend) {
+    kq = bj[q]; kc = crow[c];
+    if (kq >= bound || kc >= bound) break;
+    if (kq < kc) q++;
+    else if (kc < kq) c++;
+    else {sum += lu[q]*lu[cpos[c]]; q++; c++;}
+  }
+  return sum;
+}
+
+/*
+   One Jacobi sweep of the fixed-point iteration: every nonzero of the new factor is computed from the old factor only,
+   hence the rows may be processed in any order (and concurrently).
+*/
+static void MatChowILUSweep_Private(PetscInt n,const PetscInt *bi,const PetscInt *bj,const PetscInt *bdiag,const PetscInt *ucolptr,const PetscInt *ucolrow,const PetscInt *ucolpos,const PetscScalar *aval,const MatScalar *old,MatScalar *lu)
+{
+  PetscInt i;
+
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(static)
+#endif
+  for (i=0; i<n; i++) {
+    const PetscInt lstart = bi[i],lend = bi[i+1];
+    PetscInt       p,j;
+
+    /* L part: L(i,j) = (A(i,j) - sum_{k<j} L(i,k) U(k,j)) / U(j,j) */
+    for (p=lstart; p<lend; p++) {
+      j     = bj[p];
+      lu[p] = (aval[p] - MatChowILUDot_Private(bj,lstart,lend,ucolrow,ucolpos,ucolptr[j],ucolptr[j+1],j,old))/old[bdiag[j]];
+    }
+    /* U part, including the diagonal: U(i,j) = A(i,j) - sum_{k<i} L(i,k) U(k,j) */
+    for (p=bdiag[i+1]+1; p<=bdiag[i]; p++) {
+      j     = (p == bdiag[i]) ? i : bj[p];
+      lu[p] = aval[p] - MatChowILUDot_Private(bj,lstart,lend,ucolrow,ucolpos,ucolptr[j],ucolptr[j+1],i,old);
+    }
+  }
+}
+
+static PetscErrorCode MatSolve_SeqAIJ_ChowILU(Mat A,Vec bb,Vec xx)
+{
+  Mat_SeqAIJ        *a = (Mat_SeqAIJ*)A->data;
+  Mat_ChowILU       *chow;
+  PetscErrorCode    ierr;
+  const PetscInt    n = A->rmap->n,*ai = a->i,*aj = a->j,*adiag = a->diag;
+  const PetscInt    *r,*c;
+  const MatScalar   *aa = a->a;
+  const PetscScalar *b;
+  PetscScalar       *x,*rhs,*y,*z,*t;
+  PetscInt          i,it;
+
+  PetscFunctionBegin;
+  if (!n) PetscFunctionReturn(0);
+  ierr = MatChowILUGetContext_Private(A,&chow);CHKERRQ(ierr);
+  ierr = VecGetArrayRead(bb,&b);CHKERRQ(ierr);
+  ierr = VecGetArray(xx,&x);CHKERRQ(ierr);
+  ierr = ISGetIndices(a->row,&r);CHKERRQ(ierr);
+  ierr = ISGetIndices(a->col,&c);CHKERRQ(ierr);
+  rhs  = chow->swork; y = rhs + n; z = y + n;
+
+  /* Jacobi iteration for the unit lower triangular L y = P b */
+  for (i=0; i<n; i++) y[i] = rhs[i] = b[r[i]];
+  for (it=0; it<chow->solvesweeps; it++) {
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(static)
+#endif
+    for (i=0; i<n; i++) {
+      const MatScalar *v  = aa + ai[i];
+      const PetscInt  *vi = aj + ai[i],nz = ai[i+1] - ai[i];
+      PetscScalar     sum = rhs[i];
+
+      PetscSparseDenseMinusDot(sum,y,v,vi,nz);
+      z[i] = sum;
+    }
+    t = y; y = z; z = t;
+  }
+
+  /* Jacobi iteration for the upper triangular U x = y, the factor stores the inverse of the diagonal */
+  t = rhs; rhs = y; y = t;
+  for (i=0; i<n; i++) y[i] = aa[adiag[i]]*rhs[i];
+  for (it=0; it<chow->solvesweeps; it++) {
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(static)
+#endif
+    for (i=0; i<n; i++) {
+      const MatScalar *v  = aa + adiag[i+1] + 1;
+      const PetscInt  *vi = aj + adiag[i+1] + 1,nz = adiag[i] - adiag[i+1] - 1;
+      PetscScalar     sum = rhs[i];
+
+      PetscSparseDenseMinusDot(sum,y,v,vi,nz);
+      z[i] = aa[adiag[i]]*sum;
+    }
+    t = y; y = z; z = t;
+  }
+  for (i=0; i<n; i++) x[c[i]] = y[i];
+
+  ierr = ISRestoreIndices(a->row,&r);CHKERRQ(ierr);
+  ierr = ISRestoreIndices(a->col,&c);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(bb,&b);CHKERRQ(ierr);
+  ierr = VecRestoreArray(xx,&x);CHKERRQ(ierr);
+  ierr = PetscLogFlops(chow->solvesweeps*(2.0*a->nz - n) + n);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatLUFactorNumeric_SeqAIJ_ChowILU(Mat B,Mat A,const MatFactorInfo *info)
+{
+  Mat_SeqAIJ     *a = (Mat_SeqAIJ*)A->data,*b = (Mat_SeqAIJ*)B->data;
+  Mat_ChowILU    *chow;
+  PetscErrorCode ierr;
+  const PetscInt n = A->rmap->n,*bi = b->i,*bj = b->j,*bdiag = b->diag;
+  const PetscInt nz = n ? bdiag[0]+1 : 0;
+  MatScalar      *lu = b->a,*old = NULL,*tmp;
+  PetscScalar    *aval;
+  PetscInt       i,p,sweep;
+  PetscBool      row_identity,col_identity;
+  FactorShiftCtx sctx;
+
+  PetscFunctionBegin;
+  ierr = MatChowILUGetContext_Private(B,&chow);CHKERRQ(ierr);
+  aval = chow->aval;
+
+  /* gather the permuted matrix into the layout of the factor */
+  for (p=0; p<nz; p++) aval[p] = chow->amap[p] >= 0 ? a->a[chow->amap[p]] : 0.0;
+  if (info->shifttype == (PetscReal)MAT_SHIFT_NONZERO || info->shifttype == (PetscReal)MAT_SHIFT_INBLOCKS) {
+    for (i=0; i<n; i++) aval[bdiag[i]] += info->shiftamount;
+  }
+
+  /* initial guess: L = strict lower triangle of A scaled by its diagonal, U = upper triangle of A */
+  for (i=0; i<n; i++) {
+    for (p=bi[i]; p<bi[i+1]; p++) {
+      PetscScalar d = aval[bdiag[bj[p]]];
+      lu[p] = (d != 0.0) ? aval[p]/d : aval[p];
+    }
+    for (p=bdiag[i+1]+1; p<=bdiag[i]; p++) lu[p] = aval[p];
+  }
+
+  /* fixed-point sweeps, alternating between the factor storage and the work array */
+  old = chow->work;
+  for (sweep=0; sweep<chow->factorsweeps; sweep++) {
+    tmp = old; old = lu; lu = tmp;
+    MatChowILUSweep_Private(n,bi,bj,bdiag,chow->ucolptr,chow->ucolrow,chow->ucolpos,aval,old,lu);
+  }
+  if (lu != b->a) {ierr = PetscMemcpy(b->a,lu,nz*sizeof(MatScalar));CHKERRQ(ierr);}
+  ierr = PetscLogFlops(chow->factorsweeps*(2.0*nz));CHKERRQ(ierr);
+
+  /* check the pivots and store the inverse of the diagonal, as expected by the SeqAIJ triangular solves */
+  ierr = PetscMemzero(&sctx,sizeof(FactorShiftCtx));CHKERRQ(ierr);
+  lu   = b->a;
+  for (i=0; i<n; i++) {
+    sctx.pv = lu[bdiag[i]];
+    ierr    = MatPivotCheck_none(B,A,info,&sctx,i);CHKERRQ(ierr);
+    lu[bdiag[i]] = 1.0/lu[bdiag[i]];
+  }
+
+  if (chow->solvesweeps) {
+    B->ops->solve = MatSolve_SeqAIJ_ChowILU;
+  } else {
+    ierr = ISIdentity(b->row,&row_identity);CHKERRQ(ierr);
+    ierr = ISIdentity(b->col,&col_identity);CHKERRQ(ierr);
+    if (row_identity && col_identity) B->ops->solve = MatSolve_SeqAIJ_NaturalOrdering;
+    else B->ops->solve = MatSolve_SeqAIJ;
+  }
+  B->ops->solveadd          = MatSolveAdd_SeqAIJ;
+  B->ops->solvetranspose    = MatSolveTranspose_SeqAIJ;
+  B->ops->solvetransposeadd = MatSolveTransposeAdd_SeqAIJ;
+  B->ops->matsolve          = MatMatSolve_SeqAIJ;
+  B->assembled              = PETSC_TRUE;
+  B->preallocated           = PETSC_TRUE;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatILUFactorSymbolic_SeqAIJ_ChowILU(Mat fact,Mat A,IS isrow,IS iscol,const MatFactorInfo *info)
+{
+  Mat_SeqAIJ     *a = (Mat_SeqAIJ*)A->data,*b;
+  Mat_ChowILU    *chow;
+  PetscErrorCode ierr;
+  const PetscInt n = A->rmap->n,*ai = a->i,*aj = a->j;
+  const PetscInt *r,*ic,*bi,*bj,*bdiag;
+  PetscInt       i,j,p,nz,col,*cnt,*colmap;
+
+  PetscFunctionBegin;
+  ierr = MatChowILUGetContext_Private(fact,&chow);CHKERRQ(ierr);
+  /* the nonzero pattern is that of the standard level-based ILU(k) */
+  ierr = MatILUFactorSymbolic_SeqAIJ(fact,A,isrow,iscol,info);CHKERRQ(ierr);
+  b     = (Mat_SeqAIJ*)fact->data;
+  bi    = b->i; bj = b->j; bdiag = b->diag;
+  nz    = n ? bdiag[0]+1 : 0;
+
+  ierr = PetscFree(chow->amap);CHKERRQ(ierr);
+  ierr = PetscFree3(chow->ucolptr,chow->ucolrow,chow->ucolpos);CHKERRQ(ierr);
+  ierr = PetscFree2(chow->aval,chow->work);CHKERRQ(ierr);
+  ierr = PetscFree(chow->swork);CHKERRQ(ierr);
+  ierr = PetscMalloc1(nz,&chow->amap);CHKERRQ(ierr);
+  ierr = PetscMalloc2(nz,&chow->aval,nz,&chow->work);CHKERRQ(ierr);
+  ierr = PetscMalloc1(3*n,&chow->swork);CHKERRQ(ierr);
+  ierr = PetscLogObjectMemory((PetscObject)fact,nz*(sizeof(PetscInt)+2*sizeof(PetscScalar))+3*n*sizeof(PetscScalar));CHKERRQ(ierr);
+
+  /* locate each entry of the permuted matrix in the factor; entries outside the ILU pattern are dropped */
+  ierr = PetscMalloc1(n,&colmap);CHKERRQ(ierr);
+  for (i=0; i<n; i++) colmap[i] = -1;
+  for (p=0; p<nz; p++) chow->amap[p] = -1;
+  ierr = ISGetIndices(b->row,&r);CHKERRQ(ierr);
+  ierr = ISGetIndices(b->icol,&ic);CHKERRQ(ierr);
+  for (i=0; i<n; i++) {
+    for (p=bi[i]; p<bi[i+1]; p++) colmap[bj[p]] = p;
+    for (p=bdiag[i+1]+1; p<bdiag[i]; p++) colmap[bj[p]] = p;
+    colmap[i] = bdiag[i];
+    for (j=ai[r[i]]; j<ai[r[i]+1]; j++) {
+      col = ic[aj[j]];
+      if (colmap[col] >= 0) chow->amap[colmap[col]] = j;
+    }
+    for (p=bi[i]; p<bi[i+1]; p++) colmap[bj[p]] = -1;
+    for (p=bdiag[i+1]+1; p<bdiag[i]; p++) colmap[bj[p]] = -1;
+    colmap[i] = -1;
+  }
+  ierr = ISRestoreIndices(b->row,&r);CHKERRQ(ierr);
+  ierr = ISRestoreIndices(b->icol,&ic);CHKERRQ(ierr);
+  ierr = PetscFree(colmap);CHKERRQ(ierr);
+
+  /* column oriented access to U, rows are visited in increasing order so each column is sorted */
+  ierr = PetscMalloc3(n+1,&chow->ucolptr,nz-bi[n],&chow->ucolrow,nz-bi[n],&chow->ucolpos);CHKERRQ(ierr);
+  ierr = PetscLogObjectMemory((PetscObject)fact,(n+1+2*(nz-bi[n]))*sizeof(PetscInt));CHKERRQ(ierr);
+  ierr = PetscCalloc1(n+1,&cnt);CHKERRQ(ierr);
+  for (i=0; i<n; i++) {
+    for (p=bdiag[i+1]+1; p<bdiag[i]; p++) cnt[bj[p]+1]++;
+    cnt[i+1]++;
+  }
+  chow->ucolptr[0] = 0;
+  for (i=0; i<n; i++) {
+    chow->ucolptr[i+1] = chow->ucolptr[i] + cnt[i+1];
+    cnt[i+1]           = chow->ucolptr[i];
+  }
+  for (i=0; i<n; i++) {
+    for (p=bdiag[i+1]+1; p<=bdiag[i]; p++) {
+      col = (p == bdiag[i]) ? i : bj[p];
+      chow->ucolrow[cnt[col+1]]   = i;
+      chow->ucolpos[cnt[col+1]++] = p;
+    }
+  }
+  ierr = PetscFree(cnt);CHKERRQ(ierr);
+
+  fact->ops->lufactornumeric = MatLUFactorNumeric_SeqAIJ_ChowILU;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatFactorGetSolverType_seqaij_chowilu(Mat A,MatSolverType *type)
+{
+  PetscFunctionBegin;
+  *type = MATSOLVERCHOWILU;
+  PetscFunctionReturn(0);
+}
+
+/*MC
+  MATSOLVERCHOWILU = "chowilu" - A matrix type providing an incomplete LU factorization for sequential matrices
+  whose entries are computed by a fixed number of fixed-point sweeps over the nonzeros (Chow and Patel), optionally
+  followed by triangular solves that are approximated by a fixed number of Jacobi iterations.
+
+  The nonzero pattern is that of ILU(k) and is obtained with the standard PETSc symbolic factorization. All the
+  nonzeros of the factor, and all the rows of the triangular solves, are updated independently of each other
+  within a sweep, so no level scheduling is required.
+
+  Use -pc_type ilu -pc_factor_mat_solver_type chowilu to use this factorization
+
+  Options Database Keys:
++ -mat_chowilu_factor_sweeps <3> - number of fixed-point sweeps used to compute the factor
+- -mat_chowilu_solve_sweeps <2>  - number of Jacobi iterations for each triangular solve, 0 uses exact triangular solves
+
+  Notes:
+    The factorization is exact only in the limit of many sweeps; a small number of sweeps is usually sufficient
+    for preconditioning. The transpose solves are always exact.
+
+   Level: intermediate
+
+.seealso: PCILU, PCFactorSetMatSolverType(), MatSolverType, PCCHOWILUVIENNACL
+M*/
+
+PETSC_INTERN PetscErrorCode MatGetFactor_seqaij_chowilu(Mat A,MatFactorType ftype,Mat *B)
+{
+  PetscInt       n = A->rmap->n;
+  Mat_ChowILU    *chow;
+  PetscContainer container;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (ftype != MAT_FACTOR_ILU) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_SUP,"Factor type not supported");
+  ierr = MatCreate(PetscObjectComm((PetscObject)A),B);CHKERRQ(ierr);
+  ierr = MatSetSizes(*B,n,n,n,n);CHKERRQ(ierr);
+  ierr = MatSetType(*B,MATSEQAIJ);CHKERRQ(ierr);
+  ierr = MatSetBlockSizesFromMats(*B,A,A);CHKERRQ(ierr);
+
+  ierr = PetscNewLog(*B,&chow);CHKERRQ(ierr);
+  chow->factorsweeps = 3;
+  chow->solvesweeps  = 2;
+  ierr = PetscOptionsBegin(PetscObjectComm((PetscObject)A),((PetscObject)A)->prefix,"Chow ILU Options","Mat");CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-mat_chowilu_factor_sweeps","Number of fixed-point sweeps used to compute the factor","None",chow->factorsweeps,&chow->factorsweeps,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-mat_chowilu_solve_sweeps","Number of Jacobi iterations for each triangular solve (0 for exact solves)","None",chow->solvesweeps,&chow->solvesweeps,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsEnd();CHKERRQ(ierr);
+  if (chow->factorsweeps < 0 || chow->solvesweeps < 0) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Number of sweeps cannot be negative");
+
+  ierr = PetscContainerCreate(PETSC_COMM_SELF,&container);CHKERRQ(ierr);
+  ierr = PetscContainerSetPointer(container,chow);CHKERRQ(ierr);
+  ierr = PetscContainerSetUserDestroy(container,MatChowILUDestroy_Private);CHKERRQ(ierr);
+  ierr = PetscObjectCompose((PetscObject)*B,"MatChowILU",(PetscObject)container);CHKERRQ(ierr);
+  ierr = PetscContainerDestroy(&container);CHKERRQ(ierr);
+
+  (*B)->ops->ilufactorsymbolic = MatILUFactorSymbolic_SeqAIJ_ChowILU;
+  ierr = PetscObjectComposeFunction((PetscObject)*B,"MatFactorGetSolverType_C",MatFactorGetSolverType_seqaij_chowilu);CHKERRQ(ierr);
+  (*B)->factortype = ftype;
+
+  ierr = PetscFree((*B)->solvertype);CHKERRQ(ierr);
+  ierr = PetscStrallocpy(MATSOLVERCHOWILU,&(*B)->solvertype);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
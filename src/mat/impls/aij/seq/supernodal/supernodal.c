@@ -0,0 +1,881 @@
+/*
+    Provides a supernodal sparse Cholesky and LU factorization for SeqAIJ and SeqSBAIJ (block size 1) matrices.
+
+    The symbolic phase computes the elimination tree of the symmetrically permuted matrix (of A + A^T for LU),
+    postorders it, computes the column counts of the factor and groups the columns into (relaxed) supernodes.
+    All the columns of a supernode share one row structure and are stored together as a dense column major
+    panel, hence the numeric phase is a left-looking factorization in which the updates from the descendants,
+    the factorization of the diagonal blocks and the triangular solves with them are done with BLAS-3 (GEMM, TRSM)
+    and LAPACK kernels. As with the default PETSc LU factorization no pivoting is done; the factor U is stored
+    transposed, in panels with the same row structure as those of L.
+
+    Reference: E. Ng and B. Peyton, Block sparse Cholesky algorithms on advanced uniprocessor computers, SIAM J. Sci. Comput. 14 (1993).
+*/
+#include <../src/mat/impls/aij/seq/aij.h>
+#include <../src/mat/impls/sbaij/seq/sbaij.h>
+#include <petscblaslapack.h>
+
+typedef struct {
+  PetscBool   lu;             /* LU or Cholesky factorization */
+  PetscBool   relax;          /* amalgamate small supernodes with their parent */
+  PetscInt    maxwidth;       /* maximum number of columns in a supernode */
+  PetscInt    nsuper;         /* number of supernodes */
+  PetscInt    *perm,*iperm;   /* postordered fill reducing ordering: row i of the factor is row perm[i] of the matrix */
+  PetscInt    *super;         /* first column of each supernode */
+  PetscInt    *col2sup;       /* supernode containing each column */
+  PetscInt    *rowptr,*rows;  /* row structure of each supernode, its own columns come first */
+  PetscInt    *valptr;        /* location of the panel of each supernode */
+  PetscInt    lsize;          /* total length of the L panels, for LU the panels of U^T follow them */
+  PetscInt    maxrow,maxcol;  /* largest panel dimensions */
+  PetscInt    *amap;          /* location in the panels of each nonzero of the matrix, -1 if it is not used */
+  PetscBT     aconj;          /* nonzeros moved across the diagonal by the Cholesky factorization, they are conjugated */
+  PetscInt    nza;            /* number of nonzeros of the matrix when amap was computed */
+  PetscScalar *val;
+  PetscInt    *relmap,*lpos,*head,*next; /* work space for the numeric factorization */
+  PetscScalar *work;          /* work space for the updates */
+  PetscScalar *swork;         /* work space for the solves */
+  PetscReal   nzfactor;       /* number of nonzeros in the factor */
+} Mat_Supernodal;
+
+static PetscErrorCode MatSupernodalReset_Private(Mat_Supernodal *sn)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscFree2(sn->perm,sn->iperm);CHKERRQ(ierr);
+  ierr = PetscFree4(sn->super,sn->col2sup,sn->rowptr,sn->valptr);CHKERRQ(ierr);
+  ierr = PetscFree(sn->rows);CHKERRQ(ierr);
+  ierr = PetscFree(sn->amap);CHKERRQ(ierr);
+  ierr = PetscBTDestroy(&sn->aconj);CHKERRQ(ierr);
+  ierr = PetscFree(sn->val);CHKERRQ(ierr);
+  ierr = PetscFree4(sn->relmap,sn->lpos,sn->head,sn->next);CHKERRQ(ierr);
+  ierr = PetscFree2(sn->work,sn->swork);CHKERRQ(ierr);
+  sn->nsuper = 0;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatDestroy_Supernodal(Mat F)
+{
+  Mat_Supernodal *sn = (Mat_Supernodal*)F->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatSupernodalReset_Private(sn);CHKERRQ(ierr);
+  ierr = PetscFree(F->data);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)F,"MatFactorGetSolverType_C",NULL);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatSupernodalGetCSR_Private(Mat A,const PetscInt **ai,const PetscInt **aj,const MatScalar **aa,PetscBool *sbaij)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectTypeCompare((PetscObject)A,MATSEQSBAIJ,sbaij);CHKERRQ(ierr);
+  if (*sbaij) {
+    Mat_SeqSBAIJ *a = (Mat_SeqSBAIJ*)A->data;
+
+    if (A->rmap->bs > 1) SETERRQ1(PetscObjectComm((PetscObject)A),PETSC_ERR_SUP,"Supernodal factorization only supports block size 1, given %D",A->rmap->bs);
+    *ai = a->i; *aj = a->j; *aa = a->a;
+  } else {
+    Mat_SeqAIJ *a = (Mat_SeqAIJ*)A->data;
+
+    *ai = a->i; *aj = a->j; *aa = a->a;
+  }
+  PetscFunctionReturn(0);
+}
+
+/*
+   Computes the strictly lower triangular part of the structure of P (A + A^T) P^T, both by rows (ti,tj) and by columns (ci,cj);
+   the lists may contain duplicates
+*/
+static PetscErrorCode MatSupernodalPattern_Private(PetscInt n,const PetscInt *ai,const PetscInt *aj,const PetscInt *iperm,PetscInt **ti,PetscInt **tj,PetscInt **ci,PetscInt **cj)
+{
+  PetscInt       i,k,p,q,t,*tcnt,*ccnt;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscCalloc2(n+1,ti,n+1,ci);CHKERRQ(ierr);
+  for (i=0; i<n; i++) {
+    for (k=ai[i]; k<ai[i+1]; k++) {
+      if (aj[k] == i) continue;
+      p = iperm[i]; q = iperm[aj[k]];
+      if (p < q) {t = p; p = q; q = t;}
+      (*ti)[p+1]++; (*ci)[q+1]++;
+    }
+  }
+  for (i=0; i<n; i++) {(*ti)[i+1] += (*ti)[i]; (*ci)[i+1] += (*ci)[i];}
+  ierr = PetscMalloc2((*ti)[n],tj,(*ci)[n],cj);CHKERRQ(ierr);
+  ierr = PetscMalloc2(n,&tcnt,n,&ccnt);CHKERRQ(ierr);
+  ierr = PetscMemcpy(tcnt,*ti,n*sizeof(PetscInt));CHKERRQ(ierr);
+  ierr = PetscMemcpy(ccnt,*ci,n*sizeof(PetscInt));CHKERRQ(ierr);
+  for (i=0; i<n; i++) {
+    for (k=ai[i]; k<ai[i+1]; k++) {
+      if (aj[k] == i) continue;
+      p = iperm[i]; q = iperm[aj[k]];
+      if (p < q) {t = p; p = q; q = t;}
+      (*tj)[tcnt[p]++] = q; (*cj)[ccnt[q]++] = p;
+    }
+  }
+  ierr = PetscFree2(tcnt,ccnt);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* Liu's algorithm for the elimination tree, with path compression */
+static void MatSupernodalEtree_Private(PetscInt n,const PetscInt *ti,const PetscInt *tj,PetscInt *parent,PetscInt *ancestor)
+{
+  PetscInt i,k,r,t;
+
+  for (i=0; i<n; i++) {
+    parent[i] = ancestor[i] = -1;
+    for (k=ti[i]; k<ti[i+1]; k++) {
+      r = tj[k];
+      while (ancestor[r] != -1 && ancestor[r] != i) {t = ancestor[r]; ancestor[r] = i; r = t;}
+      if (ancestor[r] == -1) {ancestor[r] = i; parent[r] = i;}
+    }
+  }
+}
+
+/* Returns the position of row r in the structure of supernode s */
+PETSC_STATIC_INLINE PetscErrorCode MatSupernodalRowPosition_Private(Mat_Supernodal *sn,PetscInt s,PetscInt r,PetscInt *pos)
+{
+  const PetscInt f = sn->super[s],w = sn->super[s+1] - f,nrow = sn->rowptr[s+1] - sn->rowptr[s];
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (r < f + w) *pos = r - f;
+  else {
+    ierr = PetscFindInt(r,nrow-w,sn->rows+sn->rowptr[s]+w,pos);CHKERRQ(ierr);
+    if (*pos < 0) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_PLIB,"Row %D is not in the structure of supernode %D",r,s);
+    *pos += w;
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatFactorSymbolic_Supernodal_Private(Mat F,Mat A,IS perm)
+{
+  Mat_Supernodal  *sn = (Mat_Supernodal*)F->data;
+  const PetscInt  n = A->rmap->n,*ai,*aj,*r;
+  const MatScalar *aa;
+  PetscInt        *ti,*tj,*ci,*cj,*parent,*work,*post,*stack,*head,*next,*colcount,*mark,*nchild;
+  PetscInt        *sstart,*swidth,*scount,*spar,*chead,*cnext,*newperm;
+  PetscReal       *snz,stored;
+  PetscInt        i,j,k,p,s,t,c,f,w,top,cnt,nsup,nrow,start,lsize,nzl;
+  PetscBool       sbaij;
+  PetscErrorCode  ierr;
+
+  PetscFunctionBegin;
+  ierr = MatSupernodalReset_Private(sn);CHKERRQ(ierr);
+  ierr = MatSupernodalGetCSR_Private(A,&ai,&aj,&aa,&sbaij);CHKERRQ(ierr);
+  ierr = PetscMalloc2(n,&sn->perm,n,&sn->iperm);CHKERRQ(ierr);
+  ierr = ISGetIndices(perm,&r);CHKERRQ(ierr);
+  for (i=0; i<n; i++) {sn->perm[i] = r[i]; sn->iperm[r[i]] = i;}
+  ierr = ISRestoreIndices(perm,&r);CHKERRQ(ierr);
+  sn->nza = ai[n];
+  if (!n) PetscFunctionReturn(0);
+
+  /* postorder the elimination tree so that the columns of each subtree, in particular of each supernode, are contiguous */
+  ierr = PetscMalloc6(n,&parent,n,&work,n,&post,n,&stack,n,&head,n,&next);CHKERRQ(ierr);
+  ierr = MatSupernodalPattern_Private(n,ai,aj,sn->iperm,&ti,&tj,&ci,&cj);CHKERRQ(ierr);
+  MatSupernodalEtree_Private(n,ti,tj,parent,work);
+  ierr = PetscFree2(ti,ci);CHKERRQ(ierr);
+  ierr = PetscFree2(tj,cj);CHKERRQ(ierr);
+  for (i=0; i<n; i++) head[i] = -1;
+  for (i=n-1; i>=0; i--) {
+    if (parent[i] != -1) {next[i] = head[parent[i]]; head[parent[i]] = i;}
+  }
+  for (k=0, j=0; j<n; j++) {
+    if (parent[j] != -1) continue;
+    top = 0; stack[0] = j;
+    while (top >= 0) {
+      p = stack[top];
+      i = head[p];
+      if (i == -1) {top--; post[k++] = p;}
+      else {head[p] = next[i]; stack[++top] = i;}
+    }
+  }
+  newperm = work;
+  for (k=0; k<n; k++) newperm[k] = sn->perm[post[k]];
+  for (k=0; k<n; k++) {sn->perm[k] = newperm[k]; sn->iperm[newperm[k]] = k;}
+
+  /* elimination tree and column counts of the postordered matrix, the counts are computed from the row subtrees */
+  ierr = MatSupernodalPattern_Private(n,ai,aj,sn->iperm,&ti,&tj,&ci,&cj);CHKERRQ(ierr);
+  MatSupernodalEtree_Private(n,ti,tj,parent,work);
+  colcount = post; mark = stack; nchild = head;
+  for (j=0; j<n; j++) {colcount[j] = 1; mark[j] = -1; nchild[j] = 0;}
+  for (j=0; j<n; j++) if (parent[j] != -1) nchild[parent[j]]++;
+  for (i=0; i<n; i++) {
+    mark[i] = i;
+    for (k=ti[i]; k<ti[i+1]; k++) {
+      for (j=tj[k]; mark[j] != i; j=parent[j]) {colcount[j]++; mark[j] = i;}
+    }
+  }
+  for (nzl=0, j=0; j<n; j++) nzl += colcount[j];
+
+
+  /* fundamental supernodes, each one is amalgamated with its last child when this adds few explicit zeros */
+  ierr = PetscMalloc4(n,&sstart,n,&swidth,n,&scount,n,&snz);CHKERRQ(ierr);
+  for (nsup=0, j=0; j<n; j=f+w) {
+    f = j; w = 1;
+    while (f+w < n && w < sn->maxwidth && parent[f+w-1] == f+w && nchild[f+w] == 1 && colcount[f+w-1] == colcount[f+w]+1) w++;
+    c = colcount[f];
+    for (stored=0.0, k=f; k<f+w; k++) stored += colcount[k];
+    if (sn->relax && nsup && parent[f-1] == f) {
+      const PetscInt  nw = swidth[nsup-1] + w,nc = swidth[nsup-1] + c;
+      const PetscReal total = (PetscReal)nw*nc - 0.5*(PetscReal)nw*(nw-1),frac = (total - snz[nsup-1] - stored)/total;
+
+      if (nw <= sn->maxwidth && (nw <= 4 || (nw <= 16 && frac < 0.8) || (nw <= 48 && frac < 0.1) || frac < 0.05)) {
+        nsup--;
+        stored += snz[nsup];
+        f       = sstart[nsup];
+        w       = nw;
+        c       = nc;
+      }
+    }
+    sstart[nsup] = f; swidth[nsup] = w; scount[nsup] = c; snz[nsup] = stored;
+    nsup++;
+  }
+  sn->nsuper = nsup;
+  ierr = PetscMalloc4(nsup+1,&sn->super,n,&sn->col2sup,nsup+1,&sn->rowptr,nsup+1,&sn->valptr);CHKERRQ(ierr);
+  for (s=0; s<nsup; s++) {
+    sn->super[s] = sstart[s];
+    for (j=sstart[s]; j<sstart[s]+swidth[s]; j++) sn->col2sup[j] = s;
+  }
+  sn->super[nsup] = n;
+  ierr = PetscFree4(sstart,swidth,scount,snz);CHKERRQ(ierr);
+
+  /* the row structure of a supernode is the union of the structure of the matrix below its columns and of those of its children */
+  ierr = PetscMalloc3(nsup,&spar,nsup,&chead,nsup,&cnext);CHKERRQ(ierr);
+  for (s=0; s<nsup; s++) {
+    t       = parent[sn->super[s+1]-1];
+    spar[s] = (t == -1) ? -1 : sn->col2sup[t];
+    chead[s] = -1;
+  }
+  for (s=nsup-1; s>=0; s--) {
+    if (spar[s] != -1) {cnext[s] = chead[spar[s]]; chead[spar[s]] = s;}
+  }
+  ierr = PetscMalloc1(nzl,&sn->rows);CHKERRQ(ierr);
+  for (j=0; j<n; j++) mark[j] = -1;
+  sn->rowptr[0] = 0;
+  for (s=0; s<nsup; s++) {
+    f     = sn->super[s]; w = sn->super[s+1] - f;
+    start = sn->rowptr[s];
+    cnt   = 0;
+    for (j=f; j<f+w; j++) {sn->rows[start+cnt++] = j; mark[j] = s;}
+    for (j=f; j<f+w; j++) {
+      for (k=ci[j]; k<ci[j+1]; k++) {
+        p = cj[k];
+        if (mark[p] != s) {sn->rows[start+cnt++] = p; mark[p] = s;}
+      }
+    }
+    for (c=chead[s]; c!=-1; c=cnext[c]) {
+      for (k=sn->rowptr[c]+sn->super[c+1]-sn->super[c]; k<sn->rowptr[c+1]; k++) {
+        p = sn->rows[k];
+        if (mark[p] != s) {sn->rows[start+cnt++] = p; mark[p] = s;}
+      }
+    }
+    ierr = PetscSortInt(cnt-w,sn->rows+start+w);CHKERRQ(ierr);
+    sn->rowptr[s+1] = start + cnt;
+  }
+  ierr = PetscFree3(spar,chead,cnext);CHKERRQ(ierr);
+  ierr = PetscFree2(ti,ci);CHKERRQ(ierr);
+  ierr = PetscFree2(tj,cj);CHKERRQ(ierr);
+  ierr = PetscFree6(parent,work,post,stack,head,next);CHKERRQ(ierr);
+
+  /* layout of the panels */
+  sn->maxrow = sn->maxcol = 0; sn->nzfactor = 0.0;
+  for (lsize=0, s=0; s<nsup; s++) {
+    w              = sn->super[s+1] - sn->super[s];
+    nrow           = sn->rowptr[s+1] - sn->rowptr[s];
+    sn->valptr[s]  = lsize;
+    lsize         += nrow*w;
+    sn->maxrow     = PetscMax(sn->maxrow,nrow);
+    sn->maxcol     = PetscMax(sn->maxcol,w);
+    sn->nzfactor  += sn->lu ? (PetscReal)w*w + 2.0*(nrow-w)*w : 0.5*w*(w+1) + (PetscReal)(nrow-w)*w;
+  }
+  sn->valptr[nsup] = lsize;
+  sn->lsize        = lsize;
+
+  /* location in the panels of the entries of the matrix; Cholesky uses the upper triangular part of the matrix */
+  ierr = PetscMalloc1(ai[n],&sn->amap);CHKERRQ(ierr);
+  ierr = PetscBTCreate(ai[n],&sn->aconj);CHKERRQ(ierr);
+  for (i=0; i<n; i++) {
+    for (k=ai[i]; k<ai[i+1]; k++) {
+      PetscInt q,pos;
+
+      p = sn->iperm[i]; q = sn->iperm[aj[k]];
+      if (!sn->lu) {
+        if (!sbaij && aj[k] < i) {sn->amap[k] = -1; continue;}
+        if (p < q) {t = p; p = q; q = t; ierr = PetscBTSet(sn->aconj,k);CHKERRQ(ierr);}
+      }
+      if (p >= q || sn->col2sup[p] == sn->col2sup[q]) {
+        s    = sn->col2sup[q];
+        ierr = MatSupernodalRowPosition_Private(sn,s,p,&pos);CHKERRQ(ierr);
+        sn->amap[k] = sn->valptr[s] + (q - sn->super[s])*(sn->rowptr[s+1] - sn->rowptr[s]) + pos;
+      } else {
+        s    = sn->col2sup[p];
+        ierr = MatSupernodalRowPosition_Private(sn,s,q,&pos);CHKERRQ(ierr);
+        sn->amap[k] = lsize + sn->valptr[s] + (p - sn->super[s])*(sn->rowptr[s+1] - sn->rowptr[s]) + pos;
+      }
+    }
+  }
+
+  ierr = PetscMalloc1(sn->lu ? 2*lsize : lsize,&sn->val);CHKERRQ(ierr);
+  ierr = PetscMalloc4(n,&sn->relmap,nsup,&sn->lpos,nsup,&sn->head,nsup,&sn->next);CHKERRQ(ierr);
+  ierr = PetscMalloc2(sn->maxrow*sn->maxcol,&sn->work,n+sn->maxrow,&sn->swork);CHKERRQ(ierr);
+  ierr = PetscLogObjectMemory((PetscObject)F,(sn->lu ? 2 : 1)*lsize*sizeof(PetscScalar)+(ai[n]+sn->rowptr[nsup])*sizeof(PetscInt)+PetscBTLength(ai[n]));CHKERRQ(ierr);
+  ierr = PetscInfo4(F,"%D supernodes, largest has %D columns and %D rows, %g nonzeros in the factor\n",nsup,sn->maxcol,sn->maxrow,(double)sn->nzfactor);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   MatPivotCheck() for a pivot of a supernode; once the shift cannot be increased any more (MAT_SHIFT_POSITIVE_DEFINITE
+   at its largest shift) the pivot is treated as a zero pivot instead of restarting the factorization again
+*/
+static PetscErrorCode MatSupernodalPivotCheck_Private(Mat F,Mat A,const MatFactorInfo *info,FactorShiftCtx *sctx,PetscInt row)
+{
+  PetscReal      shift = sctx->shift_amount;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatPivotCheck(F,A,info,sctx,row);CHKERRQ(ierr);
+  if (sctx->newshift && sctx->shift_amount == shift) {
+    if (A->erroriffailure) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_MAT_CH_ZRPVT,"Zero pivot row %D value %g with the largest shift",row,(double)PetscAbsScalar(sctx->pv));
+    ierr = PetscInfo2(A,"Detected zero pivot in factorization in row %D value %g with the largest shift\n",row,(double)PetscAbsScalar(sctx->pv));CHKERRQ(ierr);
+    sctx->newshift                 = PETSC_FALSE;
+    F->factorerrortype             = MAT_FACTOR_NUMERIC_ZEROPIVOT;
+    F->factorerror_zeropivot_value = PetscAbsScalar(sctx->pv);
+    F->factorerror_zeropivot_row   = row;
+  }
+  PetscFunctionReturn(0);
+}
+
+/*
+   Factors the diagonal block of a supernode without pivoting, L is unit lower triangular. The pivots are checked with
+   MatPivotCheck(), the size of a row is measured by the off-diagonal part of the row of U, in the diagonal block and in
+   the panel u of U. sctx->newshift is set when the factorization has to be restarted with a larger shift.
+*/
+static PetscErrorCode MatSupernodalDenseLU_Private(Mat F,Mat A,const MatFactorInfo *info,FactorShiftCtx *sctx,PetscInt f,PetscInt w,PetscScalar *a,const PetscScalar *u,PetscInt lda)
+{
+  PetscInt       i,j,k;
+  PetscScalar    pv,ukj;
+  PetscReal      rs;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  for (k=0; k<w; k++) {
+    for (rs=0.0, j=k+1; j<w; j++) rs += PetscAbsScalar(a[j*lda+k]);
+    for (i=w; i<lda; i++) rs += PetscAbsScalar(u[k*lda+i]);
+    sctx->rs = rs;
+    sctx->pv = a[k*lda+k];
+    ierr     = MatSupernodalPivotCheck_Private(F,A,info,sctx,f+k);CHKERRQ(ierr);
+    if (sctx->newshift || F->factorerrortype) PetscFunctionReturn(0);
+    a[k*lda+k] = sctx->pv; /* sctx->pv might be updated in the case of MAT_SHIFT_INBLOCKS */
+    pv = 1.0/sctx->pv;
+    for (i=k+1; i<w; i++) a[k*lda+i] *= pv;
+    for (j=k+1; j<w; j++) {
+      ukj = a[j*lda+k];
+      if (ukj == (PetscScalar)0.0) continue;
+      for (i=k+1; i<w; i++) a[j*lda+i] -= a[k*lda+i]*ukj;
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
+/*
+   Cholesky factorization of the diagonal block of a supernode with the pivots checked by MatPivotCheck(), used instead
+   of LAPACK potrf() when the diagonal is shifted, the size of a row is measured by the column of L below the pivot
+*/
+static PetscErrorCode MatSupernodalDenseCholesky_Private(Mat F,Mat A,const MatFactorInfo *info,FactorShiftCtx *sctx,PetscInt f,PetscInt w,PetscScalar *a,PetscInt lda)
+{
+  PetscInt       i,j,k;
+  PetscScalar    ljk;
+  PetscReal      rs,d;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  for (k=0; k<w; k++) {
+    for (rs=0.0, i=k+1; i<lda; i++) rs += PetscAbsScalar(a[k*lda+i]);
+    sctx->rs = rs;
+    sctx->pv = a[k*lda+k];
+    ierr     = MatSupernodalPivotCheck_Private(F,A,info,sctx,f+k);CHKERRQ(ierr);
+    if (sctx->newshift || F->factorerrortype) PetscFunctionReturn(0);
+    if (PetscRealPart(sctx->pv) <= 0.0 || PetscIsNanScalar(sctx->pv)) {
+      if (A->erroriffailure) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_MAT_CH_ZRPVT,"Zero or negative pivot row %D value %g",f+k,(double)PetscRealPart(sctx->pv));
+      ierr = PetscInfo2(A,"Detected zero or negative pivot in factorization in row %D value %g\n",f+k,(double)PetscRealPart(sctx->pv));CHKERRQ(ierr);
+      F->factorerrortype             = MAT_FACTOR_NUMERIC_ZEROPIVOT;
+      F->factorerror_zeropivot_value = PetscAbsScalar(sctx->pv);
+      F->factorerror_zeropivot_row   = f+k;
+      PetscFunctionReturn(0);
+    }
+    d          = PetscSqrtReal(PetscRealPart(sctx->pv));
+    a[k*lda+k] = d;
+    for (i=k+1; i<w; i++) a[k*lda+i] /= d;
+    for (j=k+1; j<w; j++) {
+      ljk = PetscConj(a[k*lda+j]);
+      if (ljk == (PetscScalar)0.0) continue;
+      for (i=j; i<w; i++) a[j*lda+i] -= a[k*lda+i]*ljk;
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatFactorNumeric_Supernodal_Private(Mat F,Mat A,const MatFactorInfo *info)
+{
+  Mat_Supernodal  *sn = (Mat_Supernodal*)F->data;
+  const PetscInt  n = A->rmap->n,nsup = sn->nsuper,*super = sn->super,*rowptr = sn->rowptr,*rows = sn->rows;
+  const PetscInt  *ai,*aj;
+  const MatScalar *aa;
+  PetscInt        *relmap = sn->relmap,*lpos = sn->lpos,*head = sn->head,*next = sn->next;
+  PetscInt        s,d,dn,i,k,ii,jj,f,l,w,nrow,wd,nd,p,pend,m,kk,m2;
+  const PetscInt  *rs,*rd;
+  PetscScalar     *Ls,*Us,*Ld,*Ud,*C = sn->work,*col,one = 1.0,zero = 0.0;
+  PetscBLASInt    bm,bk,bn,bld,bldd,lierr;
+  PetscLogDouble  flops;
+  PetscBool       sbaij;
+  FactorShiftCtx  sctx;
+  PetscErrorCode  ierr;
+
+  PetscFunctionBegin;
+  ierr = MatSupernodalGetCSR_Private(A,&ai,&aj,&aa,&sbaij);CHKERRQ(ierr);
+  if (ai[n] != sn->nza) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONGSTATE,"Nonzero pattern of the matrix changed (%D nonzeros, %D in the symbolic factorization)",ai[n],sn->nza);
+
+  /* MatPivotSetUp(): initialize shift context sctx */
+  ierr = PetscMemzero(&sctx,sizeof(FactorShiftCtx));CHKERRQ(ierr);
+  if (info->shifttype == (PetscReal) MAT_SHIFT_POSITIVE_DEFINITE) { /* set sctx.shift_top=max{rs} */
+    PetscReal *rsum;
+
+    ierr = PetscCalloc1(n,&rsum);CHKERRQ(ierr);
+    for (i=0; i<n; i++) {
+      for (k=ai[i]; k<ai[i+1]; k++) {
+        /* calculate sum(|aij|)-RealPart(aii), amt of shift needed for this row */
+        if (aj[k] == i) rsum[i] -= PetscRealPart(aa[k]);
+        else {
+          rsum[i] += PetscAbsScalar(aa[k]);
+          if (sbaij) rsum[aj[k]] += PetscAbsScalar(aa[k]);
+        }
+      }
+    }
+    sctx.shift_top = info->zeropivot;
+    for (i=0; i<n; i++) if (rsum[i] > sctx.shift_top) sctx.shift_top = rsum[i];
+    ierr = PetscFree(rsum);CHKERRQ(ierr);
+    sctx.shift_top *= 1.1;
+    sctx.nshift_max = 5;
+    sctx.shift_lo   = 0.;
+    sctx.shift_hi   = 1.;
+  }
+
+  do {
+    sctx.newshift      = PETSC_FALSE;
+    F->factorerrortype = MAT_FACTOR_NOERROR;
+    flops              = 0.0;
+    ierr = PetscMemzero(sn->val,(sn->lu ? 2 : 1)*sn->lsize*sizeof(PetscScalar));CHKERRQ(ierr);
+    for (k=0; k<ai[n]; k++) {
+      if (sn->amap[k] < 0) continue;
+      if (PetscBTLookup(sn->aconj,k)) sn->val[sn->amap[k]] += PetscConj(aa[k]);
+      else sn->val[sn->amap[k]] += aa[k];
+    }
+    /* ZeropivotApply(): shift the diagonal of the matrix */
+    if (sctx.shift_amount != 0.0) {
+      for (s=0; s<nsup; s++) {
+        nrow = rowptr[s+1] - rowptr[s];
+        for (k=0; k<super[s+1]-super[s]; k++) sn->val[sn->valptr[s]+k*nrow+k] += sctx.shift_amount;
+      }
+    }
+    for (s=0; s<nsup; s++) head[s] = -1;
+
+    for (s=0; s<nsup; s++) {
+      f    = super[s]; w = super[s+1] - f; l = f + w - 1;
+      nrow = rowptr[s+1] - rowptr[s];
+      rs   = rows + rowptr[s];
+      Ls   = sn->val + sn->valptr[s];
+      Us   = Ls + sn->lsize;
+      for (k=0; k<nrow; k++) relmap[rs[k]] = k;
+
+      /* updates from all the supernodes whose next block of rows lies in the columns of this supernode */
+      for (d=head[s]; d!=-1; d=dn) {
+        dn   = next[d];
+        wd   = super[d+1] - super[d];
+        nd   = rowptr[d+1] - rowptr[d];
+        rd   = rows + rowptr[d];
+        Ld   = sn->val + sn->valptr[d];
+        Ud   = Ld + sn->lsize;
+        p    = lpos[d];
+        for (pend=p; pend<nd && rd[pend]<=l; pend++) ;
+        m    = nd - p; kk = pend - p; m2 = nd - pend;
+        ierr = PetscBLASIntCast(m,&bm);CHKERRQ(ierr);
+        ierr = PetscBLASIntCast(kk,&bk);CHKERRQ(ierr);
+        ierr = PetscBLASIntCast(wd,&bn);CHKERRQ(ierr);
+        ierr = PetscBLASIntCast(nd,&bldd);CHKERRQ(ierr);
+        PetscStackCallBLAS("BLASgemm",BLASgemm_("N",sn->lu ? "T" : "C",&bm,&bk,&bn,&one,Ld+p,&bldd,(sn->lu ? Ud : Ld)+p,&bldd,&zero,C,&bm));
+        flops += 2.0*m*kk*wd;
+        for (jj=0; jj<kk; jj++) {
+          col = Ls + (rd[p+jj]-f)*nrow;
+          for (ii=(sn->lu ? 0 : jj); ii<m; ii++) col[relmap[rd[p+ii]]] -= C[jj*m+ii];
+        }
+        if (sn->lu && m2) {
+          ierr = PetscBLASIntCast(m2,&bm);CHKERRQ(ierr);
+          PetscStackCallBLAS("BLASgemm",BLASgemm_("N","T",&bm,&bk,&bn,&one,Ud+pend,&bldd,Ld+p,&bldd,&zero,C,&bm));
+          flops += 2.0*m2*kk*wd;
+          for (jj=0; jj<kk; jj++) {
+            col = Us + (rd[p+jj]-f)*nrow;
+            for (ii=0; ii<m2; ii++) col[relmap[rd[pend+ii]]] -= C[jj*m2+ii];
+          }
+        }
+        lpos[d] = pend;
+        if (m2) {
+          k       = sn->col2sup[rd[pend]];
+          next[d] = head[k];
+          head[k] = d;
+        }
+      }
+
+      /* factor the diagonal block and compute the off-diagonal blocks of the panels */
+      m2   = nrow - w;
+      ierr = PetscBLASIntCast(w,&bn);CHKERRQ(ierr);
+      ierr = PetscBLASIntCast(m2,&bm);CHKERRQ(ierr);
+      ierr = PetscBLASIntCast(nrow,&bld);CHKERRQ(ierr);
+      if (sn->lu) {
+        ierr = MatSupernodalDenseLU_Private(F,A,info,&sctx,f,w,Ls,Us,nrow);CHKERRQ(ierr);
+        if (sctx.newshift || F->factorerrortype) break;
+        flops += 2.0*w*w*w/3.0;
+        if (m2) {
+          PetscStackCallBLAS("BLAStrsm",BLAStrsm_("R","U","N","N",&bm,&bn,&one,Ls,&bld,Ls+w,&bld));
+          PetscStackCallBLAS("BLAStrsm",BLAStrsm_("R","L","T","U",&bm,&bn,&one,Ls,&bld,Us+w,&bld));
+          flops += 2.0*m2*w*w;
+        }
+      } else {
+        if (info->shifttype == (PetscReal) MAT_SHIFT_NONE) {
+          PetscStackCallBLAS("LAPACKpotrf",LAPACKpotrf_("L",&bn,Ls,&bld,&lierr));
+          if (lierr) {
+            PetscScalar pv = Ls[(lierr-1)*(nrow+1)];
+
+            if (A->erroriffailure) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_MAT_CH_ZRPVT,"Zero or negative pivot row %D value %g",f+lierr-1,(double)PetscRealPart(pv));
+            ierr = PetscInfo2(A,"Detected zero or negative pivot in factorization in row %D value %g\n",f+lierr-1,(double)PetscRealPart(pv));CHKERRQ(ierr);
+            F->factorerrortype             = MAT_FACTOR_NUMERIC_ZEROPIVOT;
+            F->factorerror_zeropivot_value = PetscAbsScalar(pv);
+            F->factorerror_zeropivot_row   = f+lierr-1;
+            break;
+          }
+        } else {
+          ierr = MatSupernodalDenseCholesky_Private(F,A,info,&sctx,f,w,Ls,nrow);CHKERRQ(ierr);
+          if (sctx.newshift || F->factorerrortype) break;
+        }
+        flops += w*w*w/3.0;
+        if (m2) {
+          PetscStackCallBLAS("BLAStrsm",BLAStrsm_("R","L","C","N",&bm,&bn,&one,Ls,&bld,Ls+w,&bld));
+          flops += 1.0*m2*w*w;
+        }
+      }
+      if (m2) {
+        lpos[s] = w;
+        k       = sn->col2sup[rs[w]];
+        next[s] = head[k];
+        head[k] = s;
+      }
+    }
+
+    /* MatPivotRefine() */
+    if (info->shifttype == (PetscReal)MAT_SHIFT_POSITIVE_DEFINITE && !sctx.newshift && sctx.shift_fraction>0 && sctx.nshift<sctx.nshift_max) {
+      /* if no shift in this attempt & shifting & started shifting & can refine, then try lower shift */
+      sctx.shift_hi       = sctx.shift_fraction;
+      sctx.shift_fraction = (sctx.shift_hi+sctx.shift_lo)/2.;
+      sctx.shift_amount   = sctx.shift_fraction * sctx.shift_top;
+      sctx.newshift       = PETSC_TRUE;
+      sctx.nshift++;
+    }
+  } while (sctx.newshift);
+  ierr = PetscLogFlops(flops);CHKERRQ(ierr);
+
+  /* MatShiftView(A,info,&sctx) */
+  if (sctx.nshift) {
+    if (info->shifttype == (PetscReal)MAT_SHIFT_POSITIVE_DEFINITE) {
+      ierr = PetscInfo4(A,"number of shift_pd tries %D, shift_amount %g, diagonal shifted up by %e fraction top_value %e\n",sctx.nshift,(double)sctx.shift_amount,(double)sctx.shift_fraction,(double)sctx.shift_top);CHKERRQ(ierr);
+    } else if (info->shifttype == (PetscReal)MAT_SHIFT_NONZERO) {
+      ierr = PetscInfo2(A,"number of shift_nz tries %D, shift_amount %g\n",sctx.nshift,(double)sctx.shift_amount);CHKERRQ(ierr);
+    } else if (info->shifttype == (PetscReal)MAT_SHIFT_INBLOCKS) {
+      ierr = PetscInfo2(A,"number of shift_inblocks applied %D, each shift_amount %g\n",sctx.nshift,(double)info->shiftamount);CHKERRQ(ierr);
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatSolve_Supernodal_Private(Mat F,Vec bb,Vec xx,PetscBool transpose)
+{
+  Mat_Supernodal    *sn = (Mat_Supernodal*)F->data;
+  const PetscInt    n = F->rmap->n,nsup = sn->nsuper,*super = sn->super,*rowptr = sn->rowptr,*rows = sn->rows,*perm = sn->perm;
+  const PetscInt    *rs;
+  const PetscScalar *b;
+  PetscScalar       *x,*y = sn->swork,*t = sn->swork + n,*xs,*Ls,*Us,one = 1.0,zero = 0.0,mone = -1.0;
+  PetscInt          i,k,s,w,nrow,m2;
+  PetscBLASInt      bm,bn,bld,ione = 1;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  if (!n) PetscFunctionReturn(0);
+  ierr = VecGetArrayRead(bb,&b);CHKERRQ(ierr);
+  ierr = VecGetArray(xx,&x);CHKERRQ(ierr);
+  for (i=0; i<n; i++) y[i] = b[perm[i]];
+
+  /* forward substitution with L, or with U^T for the transposed LU solve */
+  for (s=0; s<nsup; s++) {
+    w    = super[s+1] - super[s];
+    nrow = rowptr[s+1] - rowptr[s];
+    m2   = nrow - w;
+    rs   = rows + rowptr[s];
+    Ls   = sn->val + sn->valptr[s];
+    Us   = Ls + sn->lsize;
+    xs   = y + super[s];
+    ierr = PetscBLASIntCast(w,&bn);CHKERRQ(ierr);
+    ierr = PetscBLASIntCast(m2,&bm);CHKERRQ(ierr);
+    ierr = PetscBLASIntCast(nrow,&bld);CHKERRQ(ierr);
+    if (!sn->lu) {
+      PetscStackCallBLAS("BLAStrsm",BLAStrsm_("L","L","N","N",&bn,&ione,&one,Ls,&bld,xs,&bn));
+    } else if (!transpose) {
+      PetscStackCallBLAS("BLAStrsm",BLAStrsm_("L","L","N","U",&bn,&ione,&one,Ls,&bld,xs,&bn));
+    } else {
+      PetscStackCallBLAS("BLAStrsm",BLAStrsm_("L","U","T","N",&bn,&ione,&one,Ls,&bld,xs,&bn));
+    }
+    if (m2) {
+      PetscStackCallBLAS("BLASgemv",BLASgemv_("N",&bm,&bn,&one,(sn->lu && transpose ? Us : Ls)+w,&bld,xs,&ione,&zero,t,&ione));
+      for (k=0; k<m2; k++) y[rs[w+k]] -= t[k];
+    }
+  }
+
+  /* backward substitution with L^H or U, or with L^T for the transposed LU solve */
+  for (s=nsup-1; s>=0; s--) {
+    w    = super[s+1] - super[s];
+    nrow = rowptr[s+1] - rowptr[s];
+    m2   = nrow - w;
+    rs   = rows + rowptr[s];
+    Ls   = sn->val + sn->valptr[s];
+    Us   = Ls + sn->lsize;
+    xs   = y + super[s];
+    ierr = PetscBLASIntCast(w,&bn);CHKERRQ(ierr);
+    ierr = PetscBLASIntCast(m2,&bm);CHKERRQ(ierr);
+    ierr = PetscBLASIntCast(nrow,&bld);CHKERRQ(ierr);
+    if (m2) {
+      for (k=0; k<m2; k++) t[k] = y[rs[w+k]];
+      PetscStackCallBLAS("BLASgemv",BLASgemv_(sn->lu ? "T" : "C",&bm,&bn,&mone,(sn->lu && !transpose ? Us : Ls)+w,&bld,t,&ione,&one,xs,&ione));
+    }
+    if (!sn->lu) {
+      PetscStackCallBLAS("BLAStrsm",BLAStrsm_("L","L","C","N",&bn,&ione,&one,Ls,&bld,xs,&bn));
+    } else if (!transpose) {
+      PetscStackCallBLAS("BLAStrsm",BLAStrsm_("L","U","N","N",&bn,&ione,&one,Ls,&bld,xs,&bn));
+    } else {
+      PetscStackCallBLAS("BLAStrsm",BLAStrsm_("L","L","T","U",&bn,&ione,&one,Ls,&bld,xs,&bn));
+    }
+  }
+
+  for (i=0; i<n; i++) x[perm[i]] = y[i];
+  ierr = VecRestoreArrayRead(bb,&b);CHKERRQ(ierr);
+  ierr = VecRestoreArray(xx,&x);CHKERRQ(ierr);
+  ierr = PetscLogFlops(4.0*sn->nzfactor - 2.0*n);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatSolve_Supernodal(Mat F,Vec b,Vec x)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatSolve_Supernodal_Private(F,b,x,PETSC_FALSE);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatSolveTranspose_Supernodal(Mat F,Vec b,Vec x)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatSolve_Supernodal_Private(F,b,x,PETSC_TRUE);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatLUFactorNumeric_Supernodal(Mat F,Mat A,const MatFactorInfo *info)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatFactorNumeric_Supernodal_Private(F,A,info);CHKERRQ(ierr);
+  F->ops->solve          = MatSolve_Supernodal;
+  F->ops->solvetranspose = MatSolveTranspose_Supernodal;
+  F->assembled           = PETSC_TRUE;
+  F->preallocated        = PETSC_TRUE;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatCholeskyFactorNumeric_Supernodal(Mat F,Mat A,const MatFactorInfo *info)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatFactorNumeric_Supernodal_Private(F,A,info);CHKERRQ(ierr);
+  F->ops->solve          = MatSolve_Supernodal;
+#if !defined(PETSC_USE_COMPLEX)
+  F->ops->solvetranspose = MatSolve_Supernodal;
+#endif
+  F->assembled           = PETSC_TRUE;
+  F->preallocated        = PETSC_TRUE;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatLUFactorSymbolic_Supernodal(Mat F,Mat A,IS r,IS c,const MatFactorInfo *info)
+{
+  Mat_Supernodal *sn = (Mat_Supernodal*)F->data;
+  PetscBool      same = PETSC_TRUE;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (r != c) {ierr = ISEqual(r,c,&same);CHKERRQ(ierr);}
+  if (!same) SETERRQ(PetscObjectComm((PetscObject)F),PETSC_ERR_SUP,"Supernodal LU factorization requires the same row and column orderings");
+  sn->lu = PETSC_TRUE;
+  ierr = MatFactorSymbolic_Supernodal_Private(F,A,r);CHKERRQ(ierr);
+  F->ops->lufactornumeric = MatLUFactorNumeric_Supernodal;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatCholeskyFactorSymbolic_Supernodal(Mat F,Mat A,IS perm,const MatFactorInfo *info)
+{
+  Mat_Supernodal *sn = (Mat_Supernodal*)F->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  sn->lu = PETSC_FALSE;
+  ierr = MatFactorSymbolic_Supernodal_Private(F,A,perm);CHKERRQ(ierr);
+  F->ops->choleskyfactornumeric = MatCholeskyFactorNumeric_Supernodal;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatGetInfo_Supernodal(Mat F,MatInfoType flag,MatInfo *info)
+{
+  Mat_Supernodal *sn = (Mat_Supernodal*)F->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscMemzero(info,sizeof(MatInfo));CHKERRQ(ierr);
+  info->block_size        = 1.0;
+  info->nz_used           = sn->nzfactor;
+  info->nz_allocated      = (sn->lu ? 2.0 : 1.0)*sn->lsize;
+  info->nz_unneeded       = info->nz_allocated - info->nz_used;
+  info->memory            = ((PetscObject)F)->mem;
+  info->fill_ratio_needed = sn->nza ? sn->nzfactor/sn->nza : 0.0;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatView_Supernodal(Mat F,PetscViewer viewer)
+{
+  Mat_Supernodal    *sn = (Mat_Supernodal*)F->data;
+  PetscBool         iascii;
+  PetscViewerFormat format;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectTypeCompare((PetscObject)viewer,PETSCVIEWERASCII,&iascii);CHKERRQ(ierr);
+  if (iascii) {
+    ierr = PetscViewerGetFormat(viewer,&format);CHKERRQ(ierr);
+    if (format == PETSC_VIEWER_ASCII_INFO) {
+      ierr = PetscViewerASCIIPrintf(viewer,"Supernodal %s factorization:\n",sn->lu ? "LU" : "Cholesky");CHKERRQ(ierr);
+      ierr = PetscViewerASCIIPrintf(viewer,"  number of supernodes %D, largest has %D columns and %D rows\n",sn->nsuper,sn->maxcol,sn->maxrow);CHKERRQ(ierr);
+      ierr = PetscViewerASCIIPrintf(viewer,"  supernode amalgamation %s, maximum width %D\n",sn->relax ? "on" : "off",sn->maxwidth);CHKERRQ(ierr);
+      ierr = PetscViewerASCIIPrintf(viewer,"  nonzeros in the factor %g, stored entries %g\n",(double)sn->nzfactor,(double)((sn->lu ? 2 : 1)*sn->lsize));CHKERRQ(ierr);
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatFactorGetSolverType_Supernodal(Mat A,MatSolverType *type)
+{
+  PetscFunctionBegin;
+  *type = MATSOLVERSUPERNODAL;
+  PetscFunctionReturn(0);
+}
+
+/*MC
+  MATSOLVERSUPERNODAL = "supernodal" - A built-in supernodal sparse direct solver (LU and Cholesky) for sequential
+  AIJ matrices and for sequential SBAIJ matrices with block size 1.
+
+  The columns of the factor are grouped into supernodes, found from the postordered elimination tree, and each
+  supernode is stored as a dense panel, so the factorization and the triangular solves spend most of their time in
+  BLAS-3 and LAPACK kernels; link with an optimized (possibly multithreaded) BLAS to get good performance. Any
+  symmetric fill reducing ordering can be used, for example -pc_factor_mat_ordering_type nd. The LU factorization
+  is done on the structure of A + A^T and, like the default PETSc LU, without pivoting.
+
+  Use -pc_type lu -pc_factor_mat_solver_type supernodal or -pc_type cholesky -pc_factor_mat_solver_type supernodal to use this direct solver
+
+  Options Database Keys:
++ -mat_supernodal_relax <true>        - amalgamate small supernodes with their parent, at the price of some explicitly stored zeros
+- -mat_supernodal_max_width <128>     - maximum number of columns of a supernode
+
+   Level: beginner
+
+   Notes:
+    The row and column orderings of the LU factorization must be the same. Zero pivots can be shifted with
+    -pc_factor_shift_type nonzero, positive_definite or inblocks; with a shift, the Cholesky factorization of the diagonal
+    blocks of the supernodes does not use LAPACK.
+    For complex numbers the Cholesky factorization is the Hermitian one.
+
+.seealso: PCLU, PCCHOLESKY, MATSOLVERPETSC, MATSOLVERCHOLMOD, MATSOLVERMUMPS, PCFactorSetMatSolverType(), MatSolverType
+M*/
+
+static PetscErrorCode MatGetFactor_Supernodal_Private(Mat A,MatFactorType ftype,Mat *F)
+{
+  Mat            B;
+  Mat_Supernodal *sn;
+  PetscInt       m = A->rmap->n,n = A->cmap->n;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatCreate(PetscObjectComm((PetscObject)A),&B);CHKERRQ(ierr);
+  ierr = MatSetSizes(B,PETSC_DECIDE,PETSC_DECIDE,m,n);CHKERRQ(ierr);
+  ierr = PetscStrallocpy("supernodal",&((PetscObject)B)->type_name);CHKERRQ(ierr);
+  ierr = MatSetUp(B);CHKERRQ(ierr);
+  ierr = PetscNewLog(B,&sn);CHKERRQ(ierr);
+  sn->relax    = PETSC_TRUE;
+  sn->maxwidth = 128;
+
+  B->data                        = sn;
+  B->ops->getinfo                = MatGetInfo_Supernodal;
+  B->ops->view                   = MatView_Supernodal;
+  B->ops->destroy                = MatDestroy_Supernodal;
+  if (ftype == MAT_FACTOR_LU) B->ops->lufactorsymbolic = MatLUFactorSymbolic_Supernodal;
+  else B->ops->choleskyfactorsymbolic = MatCholeskyFactorSymbolic_Supernodal;
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatFactorGetSolverType_C",MatFactorGetSolverType_Supernodal);CHKERRQ(ierr);
+  B->factortype   = ftype;
+  B->assembled    = PETSC_TRUE; /* required by -ksp_view */
+  B->preallocated = PETSC_TRUE;
+
+  ierr = PetscFree(B->solvertype);CHKERRQ(ierr);
+  ierr = PetscStrallocpy(MATSOLVERSUPERNODAL,&B->solvertype);CHKERRQ(ierr);
+
+  ierr = PetscOptionsBegin(PetscObjectComm((PetscObject)A),((PetscObject)A)->prefix,"Supernodal Options","Mat");CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-mat_supernodal_relax","Amalgamate small supernodes with their parent","None",sn->relax,&sn->relax,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-mat_supernodal_max_width","Maximum number of columns of a supernode","None",sn->maxwidth,&sn->maxwidth,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsEnd();CHKERRQ(ierr);
+  if (sn->maxwidth < 1) SETERRQ1(PetscObjectComm((PetscObject)A),PETSC_ERR_ARG_OUTOFRANGE,"Maximum supernode width %D must be positive",sn->maxwidth);
+  *F = B;
+  PetscFunctionReturn(0);
+}
+
+PETSC_INTERN PetscErrorCode MatGetFactor_seqaij_supernodal(Mat A,MatFactorType ftype,Mat *F)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (ftype != MAT_FACTOR_LU && ftype != MAT_FACTOR_CHOLESKY) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_SUP,"Supernodal factorization cannot do %s factorization",MatFactorTypes[ftype]);
+  ierr = MatGetFactor_Supernodal_Private(A,ftype,F);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PETSC_INTERN PetscErrorCode MatGetFactor_seqsbaij_supernodal(Mat A,MatFactorType ftype,Mat *F)
+{
+  PetscInt       bs;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (ftype != MAT_FACTOR_CHOLESKY) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_SUP,"Supernodal factorization cannot do %s factorization with SBAIJ, only Cholesky",MatFactorTypes[ftype]);
+  ierr = MatGetBlockSize(A,&bs);CHKERRQ(ierr);
+  if (bs != 1) SETERRQ1(PetscObjectComm((PetscObject)A),PETSC_ERR_SUP,"Supernodal factorization only supports block size 1, given %D",bs);
+  ierr = MatGetFactor_Supernodal_Private(A,ftype,F);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
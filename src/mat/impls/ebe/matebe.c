@@ -0,0 +1,625 @@
+/*
+   Element-by-element storage: the operator is kept as the unassembled sum of small dense element matrices,
+   all stored in one contiguous array, and applied by gathering, multiplying each block and scattering back.
+*/
+
+#include <petsc/private/matimpl.h>        /*I "petscmat.h" I*/
+#include <petscsf.h>
+
+typedef struct {
+  PetscInt     Ne;      /* number of elements */
+  PetscInt     Nb;      /* number of dofs on each element */
+  PetscInt     nl;      /* size of the local space, given by the local to global mapping */
+  PetscInt    *idx;     /* Ne*Nb local indices of the element dofs, negative entries are dropped */
+  PetscScalar *vals;    /* Ne dense row-major Nb x Nb element matrices, element e starting at e*Nb*Nb */
+  PetscScalar *xe, *ye; /* gathered element inputs and element outputs, Ne*Nb each */
+  PetscScalar *lx, *ly; /* local input and output vectors */
+  PetscSF      sf;      /* global rows (roots) to local dofs with a global index (leaves) */
+} Mat_EBE;
+
+static PetscErrorCode MatEBEMult_Private(Mat A, Vec x, Vec y, PetscBool trans, PetscBool add)
+{
+  Mat_EBE           *ebe = (Mat_EBE *) A->data;
+  const PetscInt     Nb  = ebe->Nb, Ne = ebe->Ne;
+  const PetscScalar *xa;
+  PetscScalar       *ya;
+  PetscInt           e, i;
+  PetscErrorCode     ierr;
+
+  PetscFunctionBegin;
+  if (!ebe->sf) SETERRQ(PetscObjectComm((PetscObject) A), PETSC_ERR_ARG_WRONGSTATE, "Need to first call MatSetLocalToGlobalMapping()");
+  ierr = PetscMemzero(ebe->lx, ebe->nl * sizeof(PetscScalar));CHKERRQ(ierr);
+  ierr = VecGetArrayRead(x, &xa);CHKERRQ(ierr);
+  ierr = PetscSFBcastBegin(ebe->sf, MPIU_SCALAR, xa, ebe->lx);CHKERRQ(ierr);
+  ierr = PetscSFBcastEnd(ebe->sf, MPIU_SCALAR, xa, ebe->lx);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(x, &xa);CHKERRQ(ierr);
+  /* Elements only read the local vector and write their own slot of ye, so they can be applied concurrently */
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(static) private(i)
+#endif
+  for (e = 0; e < Ne; ++e) {
+    const PetscInt    *idx = &ebe->idx[e*Nb];
+    const PetscScalar *Ae  = &ebe->vals[e*Nb*Nb];
+    PetscScalar       *xe  = &ebe->xe[e*Nb];
+    PetscScalar       *ye  = &ebe->ye[e*Nb];
+    PetscInt           j;
+
+    for (i = 0; i < Nb; ++i) xe[i] = idx[i] >= 0 ? ebe->lx[idx[i]] : 0.0;
+    if (trans) {
+      for (j = 0; j < Nb; ++j) ye[j] = 0.0;
+      for (i = 0; i < Nb; ++i) for (j = 0; j < Nb; ++j) ye[j] += Ae[i*Nb+j]*xe[i];
+    } else {
+      for (i = 0; i < Nb; ++i) {
+        PetscScalar sum = 0.0;
+
+        for (j = 0; j < Nb; ++j) sum += Ae[i*Nb+j]*xe[j];
+        ye[i] = sum;
+      }
+    }
+  }
+  ierr = PetscMemzero(ebe->ly, ebe->nl * sizeof(PetscScalar));CHKERRQ(ierr);
+  for (i = 0; i < Ne*Nb; ++i) if (ebe->idx[i] >= 0) ebe->ly[ebe->idx[i]] += ebe->ye[i];
+  if (!add) {ierr = VecSet(y, 0.0);CHKERRQ(ierr);}
+  ierr = VecGetArray(y, &ya);CHKERRQ(ierr);
+  ierr = PetscSFReduceBegin(ebe->sf, MPIU_SCALAR, ebe->ly, ya, MPIU_SUM);CHKERRQ(ierr);
+  ierr = PetscSFReduceEnd(ebe->sf, MPIU_SCALAR, ebe->ly, ya, MPIU_SUM);CHKERRQ(ierr);
+  ierr = VecRestoreArray(y, &ya);CHKERRQ(ierr);
+  ierr = PetscLogFlops(2.0*Ne*Nb*Nb);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatMult_EBE(Mat A, Vec x, Vec y)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatEBEMult_Private(A, x, y, PETSC_FALSE, PETSC_FALSE);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatMultAdd_EBE(Mat A, Vec x, Vec y, Vec z)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (z != y) {ierr = VecCopy(y, z);CHKERRQ(ierr);}
+  ierr = MatEBEMult_Private(A, x, z, PETSC_FALSE, PETSC_TRUE);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatMultTranspose_EBE(Mat A, Vec x, Vec y)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatEBEMult_Private(A, x, y, PETSC_TRUE, PETSC_FALSE);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatMultTransposeAdd_EBE(Mat A, Vec x, Vec y, Vec z)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (z != y) {ierr = VecCopy(y, z);CHKERRQ(ierr);}
+  ierr = MatEBEMult_Private(A, x, z, PETSC_TRUE, PETSC_TRUE);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatGetDiagonal_EBE(Mat A, Vec v)
+{
+  Mat_EBE       *ebe = (Mat_EBE *) A->data;
+  PetscScalar   *va;
+  PetscInt       e, i;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (!ebe->sf) SETERRQ(PetscObjectComm((PetscObject) A), PETSC_ERR_ARG_WRONGSTATE, "Need to first call MatSetLocalToGlobalMapping()");
+  ierr = PetscMemzero(ebe->ly, ebe->nl * sizeof(PetscScalar));CHKERRQ(ierr);
+  for (e = 0; e < ebe->Ne; ++e) {
+    for (i = 0; i < ebe->Nb; ++i) {
+      const PetscInt l = ebe->idx[e*ebe->Nb+i];
+
+      if (l >= 0) ebe->ly[l] += ebe->vals[(e*ebe->Nb+i)*ebe->Nb+i];
+    }
+  }
+  ierr = VecSet(v, 0.0);CHKERRQ(ierr);
+  ierr = VecGetArray(v, &va);CHKERRQ(ierr);
+  ierr = PetscSFReduceBegin(ebe->sf, MPIU_SCALAR, ebe->ly, va, MPIU_SUM);CHKERRQ(ierr);
+  ierr = PetscSFReduceEnd(ebe->sf, MPIU_SCALAR, ebe->ly, va, MPIU_SUM);CHKERRQ(ierr);
+  ierr = VecRestoreArray(v, &va);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatZeroEntries_EBE(Mat A)
+{
+  Mat_EBE       *ebe = (Mat_EBE *) A->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscMemzero(ebe->vals, ebe->Ne*ebe->Nb*ebe->Nb * sizeof(PetscScalar));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatScale_EBE(Mat A, PetscScalar a)
+{
+  Mat_EBE       *ebe = (Mat_EBE *) A->data;
+  PetscInt       i;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  for (i = 0; i < ebe->Ne*ebe->Nb*ebe->Nb; ++i) ebe->vals[i] *= a;
+  ierr = PetscLogFlops(ebe->Ne*ebe->Nb*ebe->Nb);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatCopy_EBE(Mat A, Mat B, MatStructure str)
+{
+  Mat_EBE       *a = (Mat_EBE *) A->data;
+  PetscBool      isebe;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectTypeCompare((PetscObject) B, MATEBE, &isebe);CHKERRQ(ierr);
+  if (isebe) {
+    Mat_EBE *b = (Mat_EBE *) B->data;
+
+    if ((a->Ne != b->Ne) || (a->Nb != b->Nb)) SETERRQ(PetscObjectComm((PetscObject) A), PETSC_ERR_ARG_INCOMP, "Matrices must have the same elements");
+    ierr = PetscMemcpy(b->vals, a->vals, a->Ne*a->Nb*a->Nb * sizeof(PetscScalar));CHKERRQ(ierr);
+    ierr = PetscObjectStateIncrease((PetscObject) B);CHKERRQ(ierr);
+  } else {
+    ierr = MatConvert(A, ((PetscObject) B)->type_name, MAT_REUSE_MATRIX, &B);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatDuplicate_EBE(Mat A, MatDuplicateOption op, Mat *B)
+{
+  Mat_EBE       *ebe = (Mat_EBE *) A->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatCreateEBE(PetscObjectComm((PetscObject) A), A->rmap->n, A->rmap->N, A->rmap->mapping, ebe->Ne, ebe->Nb, ebe->idx, B);CHKERRQ(ierr);
+  if (op == MAT_COPY_VALUES) {ierr = MatCopy_EBE(A, *B, SAME_NONZERO_PATTERN);CHKERRQ(ierr);}
+  ierr = MatAssemblyBegin(*B, MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(*B, MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatConvert_EBE_AIJ(Mat A, MatType newtype, MatReuse reuse, Mat *newmat)
+{
+  Mat_EBE       *ebe = (Mat_EBE *) A->data;
+  Mat            B;
+  PetscInt      *gidx, e;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscMalloc1(ebe->Nb, &gidx);CHKERRQ(ierr);
+  if (reuse == MAT_REUSE_MATRIX) {
+    B    = *newmat;
+    ierr = MatZeroEntries(B);CHKERRQ(ierr);
+  } else {
+    Mat P;
+
+    ierr = MatCreate(PetscObjectComm((PetscObject) A), &P);CHKERRQ(ierr);
+    ierr = MatSetSizes(P, A->rmap->n, A->cmap->n, A->rmap->N, A->cmap->N);CHKERRQ(ierr);
+    ierr = MatSetType(P, MATPREALLOCATOR);CHKERRQ(ierr);
+    ierr = MatSetUp(P);CHKERRQ(ierr);
+    for (e = 0; e < ebe->Ne; ++e) {
+      ierr = ISLocalToGlobalMappingApply(A->rmap->mapping, ebe->Nb, &ebe->idx[e*ebe->Nb], gidx);CHKERRQ(ierr);
+      ierr = MatSetValues(P, ebe->Nb, gidx, ebe->Nb, gidx, &ebe->vals[e*ebe->Nb*ebe->Nb], INSERT_VALUES);CHKERRQ(ierr);
+    }
+    ierr = MatAssemblyBegin(P, MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+    ierr = MatAssemblyEnd(P, MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+    ierr = MatCreate(PetscObjectComm((PetscObject) A), &B);CHKERRQ(ierr);
+    ierr = MatSetSizes(B, A->rmap->n, A->cmap->n, A->rmap->N, A->cmap->N);CHKERRQ(ierr);
+    ierr = MatSetType(B, newtype);CHKERRQ(ierr);
+    ierr = MatPreallocatorPreallocate(P, PETSC_FALSE, B);CHKERRQ(ierr);
+    ierr = MatDestroy(&P);CHKERRQ(ierr);
+  }
+  for (e = 0; e < ebe->Ne; ++e) {
+    ierr = ISLocalToGlobalMappingApply(A->rmap->mapping, ebe->Nb, &ebe->idx[e*ebe->Nb], gidx);CHKERRQ(ierr);
+    ierr = MatSetValues(B, ebe->Nb, gidx, ebe->Nb, gidx, &ebe->vals[e*ebe->Nb*ebe->Nb], ADD_VALUES);CHKERRQ(ierr);
+  }
+  ierr = MatAssemblyBegin(B, MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(B, MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = PetscFree(gidx);CHKERRQ(ierr);
+  if (reuse == MAT_INPLACE_MATRIX) {
+    ierr = MatHeaderReplace(A, &B);CHKERRQ(ierr);
+  } else if (reuse == MAT_INITIAL_MATRIX) *newmat = B;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatView_EBE(Mat A, PetscViewer viewer)
+{
+  Mat_EBE          *ebe = (Mat_EBE *) A->data;
+  PetscViewerFormat format;
+  PetscBool         isascii;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectTypeCompare((PetscObject) viewer, PETSCVIEWERASCII, &isascii);CHKERRQ(ierr);
+  ierr = PetscViewerGetFormat(viewer, &format);CHKERRQ(ierr);
+  if (isascii && (format == PETSC_VIEWER_ASCII_INFO || format == PETSC_VIEWER_ASCII_INFO_DETAIL)) {
+    PetscInt Ne;
+
+    ierr = MPIU_Allreduce(&ebe->Ne, &Ne, 1, MPIU_INT, MPI_SUM, PetscObjectComm((PetscObject) A));CHKERRQ(ierr);
+    ierr = PetscViewerASCIIPrintf(viewer, "element-by-element storage: %D elements with %D dofs each\n", Ne, ebe->Nb);CHKERRQ(ierr);
+  } else {
+    Mat B;
+
+    /* Element blocks have no row access, so view the assembled operator */
+    ierr = MatConvert(A, MATAIJ, MAT_INITIAL_MATRIX, &B);CHKERRQ(ierr);
+    ierr = MatView(B, viewer);CHKERRQ(ierr);
+    ierr = MatDestroy(&B);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatSetLocalToGlobalMapping_EBE(Mat A, ISLocalToGlobalMapping rmapping, ISLocalToGlobalMapping cmapping)
+{
+  Mat_EBE        *ebe = (Mat_EBE *) A->data;
+  const PetscInt *gidx;
+  PetscInt       *ilocal, *iremote, nleaves = 0, l;
+  PetscErrorCode  ierr;
+
+  PetscFunctionBegin;
+  if (rmapping != cmapping) SETERRQ(PetscObjectComm((PetscObject) A), PETSC_ERR_SUP, "MATEBE requires the same row and column mapping");
+  ierr = PetscLayoutSetUp(A->rmap);CHKERRQ(ierr);
+  ierr = PetscLayoutSetUp(A->cmap);CHKERRQ(ierr);
+  if (A->rmap->n != A->cmap->n) SETERRQ2(PetscObjectComm((PetscObject) A), PETSC_ERR_SUP, "MATEBE must be square, not %D x %D", A->rmap->n, A->cmap->n);
+  ierr = PetscLayoutSetISLocalToGlobalMapping(A->rmap, rmapping);CHKERRQ(ierr);
+  ierr = PetscLayoutSetISLocalToGlobalMapping(A->cmap, cmapping);CHKERRQ(ierr);
+  ierr = PetscSFDestroy(&ebe->sf);CHKERRQ(ierr);
+  ierr = PetscFree2(ebe->lx, ebe->ly);CHKERRQ(ierr);
+  ierr = ISLocalToGlobalMappingGetSize(rmapping, &ebe->nl);CHKERRQ(ierr);
+  ierr = ISLocalToGlobalMappingGetIndices(rmapping, &gidx);CHKERRQ(ierr);
+  for (l = 0; l < ebe->nl; ++l) if (gidx[l] >= 0) ++nleaves;
+  ierr = PetscMalloc1(nleaves, &ilocal);CHKERRQ(ierr);
+  ierr = PetscMalloc1(nleaves, &iremote);CHKERRQ(ierr);
+  for (l = 0, nleaves = 0; l < ebe->nl; ++l) {
+    if (gidx[l] < 0) continue;
+    ilocal[nleaves]  = l;
+    iremote[nleaves] = gidx[l];
+    ++nleaves;
+  }
+  ierr = ISLocalToGlobalMappingRestoreIndices(rmapping, &gidx);CHKERRQ(ierr);
+  ierr = PetscSFCreate(PetscObjectComm((PetscObject) A), &ebe->sf);CHKERRQ(ierr);
+  ierr = PetscSFSetGraphLayout(ebe->sf, A->rmap, nleaves, ilocal, PETSC_OWN_POINTER, iremote);CHKERRQ(ierr);
+  ierr = PetscFree(iremote);CHKERRQ(ierr);
+  ierr = PetscMalloc2(ebe->nl, &ebe->lx, ebe->nl, &ebe->ly);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatEBESetElements_EBE(Mat A, PetscInt numElements, PetscInt elemSize, const PetscInt elemIdx[])
+{
+  Mat_EBE       *ebe = (Mat_EBE *) A->data;
+  PetscInt       i;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (!ebe->sf) SETERRQ(PetscObjectComm((PetscObject) A), PETSC_ERR_ARG_WRONGSTATE, "Need to first call MatSetLocalToGlobalMapping()");
+  for (i = 0; i < numElements*elemSize; ++i) {
+    if (elemIdx[i] >= ebe->nl) SETERRQ3(PETSC_COMM_SELF, PETSC_ERR_ARG_OUTOFRANGE, "Element %D index %D is not in the local space [0, %D)", i/elemSize, elemIdx[i], ebe->nl);
+  }
+  ierr = PetscFree(ebe->idx);CHKERRQ(ierr);
+  ierr = PetscFree(ebe->vals);CHKERRQ(ierr);
+  ierr = PetscFree2(ebe->xe, ebe->ye);CHKERRQ(ierr);
+  ebe->Ne = numElements;
+  ebe->Nb = elemSize;
+  ierr = PetscMalloc1(numElements*elemSize, &ebe->idx);CHKERRQ(ierr);
+  ierr = PetscMemcpy(ebe->idx, elemIdx, numElements*elemSize * sizeof(PetscInt));CHKERRQ(ierr);
+  ierr = PetscCalloc1(numElements*elemSize*elemSize, &ebe->vals);CHKERRQ(ierr);
+  ierr = PetscMalloc2(numElements*elemSize, &ebe->xe, numElements*elemSize, &ebe->ye);CHKERRQ(ierr);
+  ierr = PetscLogObjectMemory((PetscObject) A, numElements*elemSize * (sizeof(PetscInt) + (elemSize+2) * sizeof(PetscScalar)));CHKERRQ(ierr);
+  A->preallocated = PETSC_TRUE;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatEBEGetElements_EBE(Mat A, PetscInt *numElements, PetscInt *elemSize, const PetscInt *elemIdx[])
+{
+  Mat_EBE *ebe = (Mat_EBE *) A->data;
+
+  PetscFunctionBegin;
+  if (numElements) *numElements = ebe->Ne;
+  if (elemSize)    *elemSize    = ebe->Nb;
+  if (elemIdx)     *elemIdx     = ebe->idx;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatEBEGetArray_EBE(Mat A, PetscScalar *values[])
+{
+  Mat_EBE *ebe = (Mat_EBE *) A->data;
+
+  PetscFunctionBegin;
+  *values = ebe->vals;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatEBERestoreArray_EBE(Mat A, PetscScalar *values[])
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  *values = NULL;
+  ierr = PetscObjectStateIncrease((PetscObject) A);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatEBESetElementValues_EBE(Mat A, PetscInt e, const PetscScalar values[], InsertMode mode)
+{
+  Mat_EBE       *ebe = (Mat_EBE *) A->data;
+  PetscScalar   *Ae;
+  PetscInt       i;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if ((e < 0) || (e >= ebe->Ne)) SETERRQ2(PETSC_COMM_SELF, PETSC_ERR_ARG_OUTOFRANGE, "Element %D is not in [0, %D)", e, ebe->Ne);
+  Ae = &ebe->vals[e*ebe->Nb*ebe->Nb];
+  if (mode == INSERT_VALUES) {
+    ierr = PetscMemcpy(Ae, values, ebe->Nb*ebe->Nb * sizeof(PetscScalar));CHKERRQ(ierr);
+  } else {
+    for (i = 0; i < ebe->Nb*ebe->Nb; ++i) Ae[i] += values[i];
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatDestroy_EBE(Mat A)
+{
+  Mat_EBE       *ebe = (Mat_EBE *) A->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscSFDestroy(&ebe->sf);CHKERRQ(ierr);
+  ierr = PetscFree2(ebe->lx, ebe->ly);CHKERRQ(ierr);
+  ierr = PetscFree2(ebe->xe, ebe->ye);CHKERRQ(ierr);
+  ierr = PetscFree(ebe->idx);CHKERRQ(ierr);
+  ierr = PetscFree(ebe->vals);CHKERRQ(ierr);
+  ierr = PetscFree(A->data);CHKERRQ(ierr);
+  ierr = PetscObjectChangeTypeName((PetscObject) A, 0);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject) A, "MatEBESetElements_C", NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject) A, "MatEBEGetElements_C", NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject) A, "MatEBEGetArray_C", NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject) A, "MatEBERestoreArray_C", NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject) A, "MatEBESetElementValues_C", NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject) A, "MatConvert_ebe_aij_C", NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject) A, "MatConvert_ebe_seqaij_C", NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject) A, "MatConvert_ebe_mpiaij_C", NULL);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@
+  MatEBESetElements - Set the dofs of each element of a MATEBE matrix, and allocate zeroed element matrices
+
+  Logically Collective on Mat
+
+  Input Parameters:
++ A           - The MATEBE matrix
+. numElements - The number of elements on this process
+. elemSize    - The number of dofs on each element
+- elemIdx     - The local indices of the element dofs, elemSize for each element, where negative entries are ignored
+
+  Level: advanced
+
+  Note: The local indices refer to the local to global mapping of the matrix, which must be set first.
+
+.seealso: MATEBE, MatCreateEBE(), MatEBEGetElements(), MatSetLocalToGlobalMapping()
+@*/
+PetscErrorCode MatEBESetElements(Mat A, PetscInt numElements, PetscInt elemSize, const PetscInt elemIdx[])
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(A, MAT_CLASSID, 1);
+  if (numElements && elemSize) PetscValidIntPointer(elemIdx, 4);
+  ierr = PetscUseMethod(A, "MatEBESetElements_C", (Mat,PetscInt,PetscInt,const PetscInt[]), (A,numElements,elemSize,elemIdx));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@C
+  MatEBEGetElements - Get the dofs of each element of a MATEBE matrix
+
+  Not Collective
+
+  Input Parameter:
+. A - The MATEBE matrix
+
+  Output Parameters:
++ numElements - The number of elements on this process, or NULL
+. elemSize    - The number of dofs on each element, or NULL
+- elemIdx     - The local indices of the element dofs, or NULL
+
+  Level: advanced
+
+.seealso: MATEBE, MatEBESetElements()
+@*/
+PetscErrorCode MatEBEGetElements(Mat A, PetscInt *numElements, PetscInt *elemSize, const PetscInt *elemIdx[])
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(A, MAT_CLASSID, 1);
+  ierr = PetscUseMethod(A, "MatEBEGetElements_C", (Mat,PetscInt*,PetscInt*,const PetscInt*[]), (A,numElements,elemSize,elemIdx));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@C
+  MatEBEGetArray - Get the array holding the element matrices of a MATEBE matrix
+
+  Not Collective
+
+  Input Parameter:
+. A - The MATEBE matrix
+
+  Output Parameter:
+. values - The element matrices, stored contiguously with element e at values[e*elemSize*elemSize] in row-major order
+
+  Note: This is the way to fill the matrix without going through MatSetValues(). Call MatAssemblyBegin() and MatAssemblyEnd()
+  after MatEBERestoreArray() as usual.
+
+  Level: advanced
+
+.seealso: MATEBE, MatEBERestoreArray(), MatEBESetElementValues()
+@*/
+PetscErrorCode MatEBEGetArray(Mat A, PetscScalar *values[])
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(A, MAT_CLASSID, 1);
+  PetscValidPointer(values, 2);
+  ierr = PetscUseMethod(A, "MatEBEGetArray_C", (Mat,PetscScalar*[]), (A,values));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@C
+  MatEBERestoreArray - Restore the array obtained with MatEBEGetArray()
+
+  Not Collective
+
+  Input Parameters:
++ A      - The MATEBE matrix
+- values - The element matrices
+
+  Level: advanced
+
+.seealso: MATEBE, MatEBEGetArray()
+@*/
+PetscErrorCode MatEBERestoreArray(Mat A, PetscScalar *values[])
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(A, MAT_CLASSID, 1);
+  PetscValidPointer(values, 2);
+  ierr = PetscUseMethod(A, "MatEBERestoreArray_C", (Mat,PetscScalar*[]), (A,values));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@
+  MatEBESetElementValues - Set or add the dense matrix of one element of a MATEBE matrix
+
+  Not Collective
+
+  Input Parameters:
++ A      - The MATEBE matrix
+. e      - The local element number
+. values - The elemSize x elemSize element matrix in row-major order
+- mode   - INSERT_VALUES or ADD_VALUES
+
+  Level: advanced
+
+.seealso: MATEBE, MatEBEGetArray(), MatEBESetElements()
+@*/
+PetscErrorCode MatEBESetElementValues(Mat A, PetscInt e, const PetscScalar values[], InsertMode mode)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(A, MAT_CLASSID, 1);
+  PetscValidScalarPointer(values, 3);
+  ierr = PetscUseMethod(A, "MatEBESetElementValues_C", (Mat,PetscInt,const PetscScalar[],InsertMode), (A,e,values,mode));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@
+  MatCreateEBE - Creates a square matrix stored as the unassembled sum of dense element matrices
+
+  Collective on MPI_Comm
+
+  Input Parameters:
++ comm        - MPI communicator that will share the matrix
+. m           - The number of local rows (or PETSC_DECIDE)
+. M           - The number of global rows (or PETSC_DETERMINE)
+. map         - The local to global mapping of the local space the element dofs index
+. numElements - The number of elements on this process
+. elemSize    - The number of dofs on each element
+- elemIdx     - The local indices of the element dofs, elemSize for each element, where negative entries are ignored
+
+  Output Parameter:
+. A - The matrix
+
+  Level: advanced
+
+  Note: The element matrices start out zero. Fill them with MatEBEGetArray() or MatEBESetElementValues() and then assemble.
+
+.seealso: MATEBE, MatEBESetElements(), MatEBEGetArray(), MATIS
+@*/
+PetscErrorCode MatCreateEBE(MPI_Comm comm, PetscInt m, PetscInt M, ISLocalToGlobalMapping map, PetscInt numElements, PetscInt elemSize, const PetscInt elemIdx[], Mat *A)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatCreate(comm, A);CHKERRQ(ierr);
+  ierr = MatSetSizes(*A, m, m, M, M);CHKERRQ(ierr);
+  ierr = MatSetType(*A, MATEBE);CHKERRQ(ierr);
+  ierr = MatSetLocalToGlobalMapping(*A, map, map);CHKERRQ(ierr);
+  ierr = MatEBESetElements(*A, numElements, elemSize, elemIdx);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*MC
+   MATEBE - MATEBE = "ebe" - A matrix type that keeps the operator element-by-element, as the unassembled sum of
+   small dense element matrices, all stored in one contiguous array.
+
+   The product gathers the dofs of each element from a local vector, multiplies by the element matrix, and adds the
+   results back into the local vector which is then summed into the global one. Unlike MATIS, which assembles one
+   matrix per process, nothing is assembled, so this suits high order or low connectivity operators that are only
+   applied, with preconditioners that need no more than the diagonal, such as Jacobi or Chebyshev smoothing.
+
+   Operations Provided:
++  MatMult()
+.  MatMultAdd()
+.  MatMultTranspose()
+.  MatMultTransposeAdd()
+.  MatGetDiagonal()
+.  MatZeroEntries()
+.  MatScale()
+.  MatCopy()
+.  MatDuplicate()
+-  MatConvert() to MATAIJ
+
+   Notes:
+    You must call MatSetLocalToGlobalMapping() and then MatEBESetElements(), or use MatCreateEBE(). DMCreateMatrix() on
+   a DMPLEX with -dm_mat_type ebe gives a matrix with one element per cell which DMPlexComputeJacobian_Internal() fills
+   directly.
+
+  Level: advanced
+
+.seealso: Mat, MatCreateEBE(), MatEBESetElements(), MatEBEGetArray(), MatEBESetElementValues(), MATIS
+M*/
+
+PETSC_EXTERN PetscErrorCode MatCreate_EBE(Mat A)
+{
+  Mat_EBE       *ebe;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr    = PetscNewLog(A, &ebe);CHKERRQ(ierr);
+  A->data = (void *) ebe;
+
+  ierr = PetscMemzero(A->ops, sizeof(struct _MatOps));CHKERRQ(ierr);
+  A->ops->mult                    = MatMult_EBE;
+  A->ops->multadd                 = MatMultAdd_EBE;
+  A->ops->multtranspose           = MatMultTranspose_EBE;
+  A->ops->multtransposeadd        = MatMultTransposeAdd_EBE;
+  A->ops->getdiagonal             = MatGetDiagonal_EBE;
+  A->ops->zeroentries             = MatZeroEntries_EBE;
+  A->ops->scale                   = MatScale_EBE;
+  A->ops->copy                    = MatCopy_EBE;
+  A->ops->duplicate               = MatDuplicate_EBE;
+  A->ops->view                    = MatView_EBE;
+  A->ops->destroy                 = MatDestroy_EBE;
+  A->ops->setlocaltoglobalmapping = MatSetLocalToGlobalMapping_EBE;
+
+  ierr = PetscObjectComposeFunction((PetscObject) A, "MatEBESetElements_C", MatEBESetElements_EBE);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject) A, "MatEBEGetElements_C", MatEBEGetElements_EBE);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject) A, "MatEBEGetArray_C", MatEBEGetArray_EBE);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject) A, "MatEBERestoreArray_C", MatEBERestoreArray_EBE);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject) A, "MatEBESetElementValues_C", MatEBESetElementValues_EBE);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject) A, "MatConvert_ebe_aij_C", MatConvert_EBE_AIJ);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject) A, "MatConvert_ebe_seqaij_C", MatConvert_EBE_AIJ);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject) A, "MatConvert_ebe_mpiaij_C", MatConvert_EBE_AIJ);CHKERRQ(ierr);
+  ierr = PetscObjectChangeTypeName((PetscObject) A, MATEBE);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
@@ -0,0 +1,599 @@
+/*
+    Hierarchically off-diagonal low-rank (HODLR) approximation of a sequential dense matrix.
+
+    The index range is split recursively in two halves; the diagonal blocks of the finest level are kept
+    dense and every off-diagonal block is stored as a truncated SVD. The factorization applies the
+    Sherman-Morrison-Woodbury formula level by level.
+*/
+#include <petsc/private/matimpl.h>          /*I "petscmat.h" I*/
+#include <../src/mat/impls/dense/seq/dense.h>
+#include <petscblaslapack.h>
+
+typedef struct _n_HODLRNode *HODLRNode;
+struct _n_HODLRNode {
+  PetscInt     n,n0,n1;       /* size of the block and of its two halves */
+  PetscBLASInt r0,r1;         /* ranks of the upper right and the lower left blocks */
+  PetscScalar  *U0,*Vt0;      /* A(0,1) ~ U0*Vt0, U0 is n0 x r0 and Vt0 is r0 x n1 */
+  PetscScalar  *U1,*Vt1;      /* A(1,0) ~ U1*Vt1, U1 is n1 x r1 and Vt1 is r1 x n0 */
+  PetscScalar  *D;            /* dense block at the leaves, n x n */
+  PetscScalar  *W0,*W1;       /* factored matrices only: A(0,0)^{-1} U0 and A(1,1)^{-1} U1 */
+  PetscScalar  *K;            /* factored matrices only: LU factors of the (r0+r1) x (r0+r1) capacitance matrix */
+  PetscScalar  *t;            /* work space of length r0+r1 */
+  PetscBLASInt *pivots;       /* pivots of D or K */
+  HODLRNode    child[2];
+};
+
+typedef struct {
+  HODLRNode   root;
+  PetscReal   tol;            /* relative truncation tolerance of the off-diagonal blocks */
+  PetscInt    leafsize;       /* blocks of at most this size are stored dense */
+  PetscInt    maxrank;        /* largest rank of an off-diagonal block */
+  PetscInt    levels;         /* depth of the tree */
+  PetscInt    nz;             /* number of stored entries */
+  PetscScalar *work;          /* work space of length maxrank used by MatMult() */
+} Mat_HODLR;
+
+static PetscErrorCode HODLRNodeDestroy(HODLRNode *node)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (!*node) PetscFunctionReturn(0);
+  ierr = HODLRNodeDestroy(&(*node)->child[0]);CHKERRQ(ierr);
+  ierr = HODLRNodeDestroy(&(*node)->child[1]);CHKERRQ(ierr);
+  ierr = PetscFree((*node)->U0);CHKERRQ(ierr);
+  ierr = PetscFree((*node)->Vt0);CHKERRQ(ierr);
+  ierr = PetscFree((*node)->U1);CHKERRQ(ierr);
+  ierr = PetscFree((*node)->Vt1);CHKERRQ(ierr);
+  ierr = PetscFree4((*node)->W0,(*node)->W1,(*node)->K,(*node)->t);CHKERRQ(ierr);
+  ierr = PetscFree((*node)->D);CHKERRQ(ierr);
+  ierr = PetscFree((*node)->pivots);CHKERRQ(ierr);
+  ierr = PetscFree(*node);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   Truncated SVD of the m x n block B (leading dimension ldb): on output U is m x r and Vt is r x n,
+   both stored with leading dimensions m and r, with U holding the singular values.
+*/
+static PetscErrorCode HODLRCompress_Private(const PetscScalar *B,PetscInt ldb,PetscInt m,PetscInt n,PetscReal tol,PetscBLASInt *r,PetscScalar **U,PetscScalar **Vt)
+{
+#if defined(PETSC_MISSING_LAPACK_GESVD)
+  PetscFunctionBegin;
+  SETERRQ(PETSC_COMM_SELF,PETSC_ERR_SUP,"GESVD - Lapack routine is unavailable.");
+#else
+  PetscErrorCode ierr;
+  PetscScalar    *a,*u,*vt,*work;
+  PetscReal      *s,*rwork = NULL;
+  PetscBLASInt   bm,bn,bk,lwork,info;
+  PetscInt       i,j,k = PetscMin(m,n),rank;
+
+  PetscFunctionBegin;
+  ierr  = PetscBLASIntCast(m,&bm);CHKERRQ(ierr);
+  ierr  = PetscBLASIntCast(n,&bn);CHKERRQ(ierr);
+  ierr  = PetscBLASIntCast(k,&bk);CHKERRQ(ierr);
+  lwork = 5*(bm+bn);
+  ierr  = PetscMalloc5(m*n,&a,m*k,&u,k*n,&vt,lwork,&work,k,&s);CHKERRQ(ierr);
+  for (j=0; j<n; j++) {
+    ierr = PetscMemcpy(a+j*m,B+j*ldb,m*sizeof(PetscScalar));CHKERRQ(ierr);
+  }
+#if defined(PETSC_USE_COMPLEX)
+  ierr = PetscMalloc1(5*k,&rwork);CHKERRQ(ierr);
+#endif
+  ierr = PetscFPTrapPush(PETSC_FP_TRAP_OFF);CHKERRQ(ierr);
+#if !defined(PETSC_USE_COMPLEX)
+  PetscStackCallBLAS("LAPACKgesvd",LAPACKgesvd_("S","S",&bm,&bn,a,&bm,s,u,&bm,vt,&bk,work,&lwork,&info));
+#else
+  PetscStackCallBLAS("LAPACKgesvd",LAPACKgesvd_("S","S",&bm,&bn,a,&bm,s,u,&bm,vt,&bk,work,&lwork,rwork,&info));
+#endif
+  ierr = PetscFPTrapPop();CHKERRQ(ierr);
+  if (info) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_LIB,"Error in SVD Lapack routine %d",(int)info);
+  ierr = PetscFree(rwork);CHKERRQ(ierr);
+
+  for (rank=0; rank<k; rank++) if (s[rank] <= tol*s[0]) break;
+  *r   = (PetscBLASInt)rank;
+  ierr = PetscMalloc1(m*rank,U);CHKERRQ(ierr);
+  ierr = PetscMalloc1(rank*n,Vt);CHKERRQ(ierr);
+  for (j=0; j<rank; j++) {
+    for (i=0; i<m; i++) (*U)[i+j*m] = u[i+j*m]*s[j];
+  }
+  for (j=0; j<n; j++) {
+    for (i=0; i<rank; i++) (*Vt)[i+j*rank] = vt[i+j*k];
+  }
+  ierr = PetscFree5(a,u,vt,work,s);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+#endif
+}
+
+static PetscErrorCode HODLRNodeCreate(const PetscScalar *A,PetscInt lda,PetscInt n,Mat_HODLR *h,PetscInt level,HODLRNode *node)
+{
+  PetscErrorCode ierr;
+  HODLRNode      nd;
+  PetscInt       j;
+
+  PetscFunctionBegin;
+  ierr      = PetscNew(&nd);CHKERRQ(ierr);
+  nd->n     = n;
+  h->levels = PetscMax(h->levels,level+1);
+  if (n <= h->leafsize) {
+    ierr = PetscMalloc1(n*n,&nd->D);CHKERRQ(ierr);
+    for (j=0; j<n; j++) {
+      ierr = PetscMemcpy(nd->D+j*n,A+j*lda,n*sizeof(PetscScalar));CHKERRQ(ierr);
+    }
+    h->nz += n*n;
+  } else {
+    nd->n0 = n/2;
+    nd->n1 = n - nd->n0;
+    ierr   = HODLRCompress_Private(A+nd->n0*lda,lda,nd->n0,nd->n1,h->tol,&nd->r0,&nd->U0,&nd->Vt0);CHKERRQ(ierr);
+    ierr   = HODLRCompress_Private(A+nd->n0,lda,nd->n1,nd->n0,h->tol,&nd->r1,&nd->U1,&nd->Vt1);CHKERRQ(ierr);
+    h->maxrank = PetscMax(h->maxrank,PetscMax(nd->r0,nd->r1));
+    h->nz     += (nd->r0 + nd->r1)*n;
+    ierr = HODLRNodeCreate(A,lda,nd->n0,h,level+1,&nd->child[0]);CHKERRQ(ierr);
+    ierr = HODLRNodeCreate(A+nd->n0*(lda+1),lda,nd->n1,h,level+1,&nd->child[1]);CHKERRQ(ierr);
+  }
+  *node = nd;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode HODLRNodeDuplicate(HODLRNode node,HODLRNode *dup)
+{
+  PetscErrorCode ierr;
+  HODLRNode      nd;
+
+  PetscFunctionBegin;
+  ierr   = PetscNew(&nd);CHKERRQ(ierr);
+  nd->n  = node->n;
+  nd->n0 = node->n0;
+  nd->n1 = node->n1;
+  nd->r0 = node->r0;
+  nd->r1 = node->r1;
+  if (node->D) {
+    ierr = PetscMalloc1(nd->n*nd->n,&nd->D);CHKERRQ(ierr);
+    ierr = PetscMemcpy(nd->D,node->D,nd->n*nd->n*sizeof(PetscScalar));CHKERRQ(ierr);
+  } else {
+    ierr = PetscMalloc1(nd->n0*nd->r0,&nd->U0);CHKERRQ(ierr);
+    ierr = PetscMalloc1(nd->r0*nd->n1,&nd->Vt0);CHKERRQ(ierr);
+    ierr = PetscMalloc1(nd->n1*nd->r1,&nd->U1);CHKERRQ(ierr);
+    ierr = PetscMalloc1(nd->r1*nd->n0,&nd->Vt1);CHKERRQ(ierr);
+    ierr = PetscMemcpy(nd->U0,node->U0,nd->n0*nd->r0*sizeof(PetscScalar));CHKERRQ(ierr);
+    ierr = PetscMemcpy(nd->Vt0,node->Vt0,nd->r0*nd->n1*sizeof(PetscScalar));CHKERRQ(ierr);
+    ierr = PetscMemcpy(nd->U1,node->U1,nd->n1*nd->r1*sizeof(PetscScalar));CHKERRQ(ierr);
+    ierr = PetscMemcpy(nd->Vt1,node->Vt1,nd->r1*nd->n0*sizeof(PetscScalar));CHKERRQ(ierr);
+    ierr = HODLRNodeDuplicate(node->child[0],&nd->child[0]);CHKERRQ(ierr);
+    ierr = HODLRNodeDuplicate(node->child[1],&nd->child[1]);CHKERRQ(ierr);
+  }
+  *dup = nd;
+  PetscFunctionReturn(0);
+}
+
+/* y = A x, t is work space of length at least maxrank */
+static PetscErrorCode HODLRNodeMult(HODLRNode node,PetscBool trans,const PetscScalar *x,PetscScalar *y,PetscScalar *t)
+{
+  PetscErrorCode ierr;
+  PetscScalar    one = 1.0,zero = 0.0;
+  PetscBLASInt   n,n0,n1,ione = 1;
+
+  PetscFunctionBegin;
+  ierr = PetscBLASIntCast(node->n,&n);CHKERRQ(ierr);
+  if (node->D) {
+    PetscStackCallBLAS("BLASgemv",BLASgemv_(trans ? "T" : "N",&n,&n,&one,node->D,&n,x,&ione,&zero,y,&ione));
+    PetscFunctionReturn(0);
+  }
+  ierr = PetscBLASIntCast(node->n0,&n0);CHKERRQ(ierr);
+  ierr = PetscBLASIntCast(node->n1,&n1);CHKERRQ(ierr);
+  ierr = HODLRNodeMult(node->child[0],trans,x,y,t);CHKERRQ(ierr);
+  ierr = HODLRNodeMult(node->child[1],trans,x+n0,y+n0,t);CHKERRQ(ierr);
+  if (!trans) {
+    if (node->r0) {
+      PetscStackCallBLAS("BLASgemv",BLASgemv_("N",&node->r0,&n1,&one,node->Vt0,&node->r0,x+n0,&ione,&zero,t,&ione));
+      PetscStackCallBLAS("BLASgemv",BLASgemv_("N",&n0,&node->r0,&one,node->U0,&n0,t,&ione,&one,y,&ione));
+    }
+    if (node->r1) {
+      PetscStackCallBLAS("BLASgemv",BLASgemv_("N",&node->r1,&n0,&one,node->Vt1,&node->r1,x,&ione,&zero,t,&ione));
+      PetscStackCallBLAS("BLASgemv",BLASgemv_("N",&n1,&node->r1,&one,node->U1,&n1,t,&ione,&one,y+n0,&ione));
+    }
+  } else {
+    if (node->r1) {
+      PetscStackCallBLAS("BLASgemv",BLASgemv_("T",&n1,&node->r1,&one,node->U1,&n1,x+n0,&ione,&zero,t,&ione));
+      PetscStackCallBLAS("BLASgemv",BLASgemv_("T",&node->r1,&n0,&one,node->Vt1,&node->r1,t,&ione,&one,y,&ione));
+    }
+    if (node->r0) {
+      PetscStackCallBLAS("BLASgemv",BLASgemv_("T",&n0,&node->r0,&one,node->U0,&n0,x,&ione,&zero,t,&ione));
+      PetscStackCallBLAS("BLASgemv",BLASgemv_("T",&node->r0,&n1,&one,node->Vt0,&node->r0,t,&ione,&one,y+n0,&ione));
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
+/* overwrites the n x nrhs block X (leading dimension ldx) with A^{-1} X */
+static PetscErrorCode HODLRNodeSolve(HODLRNode node,PetscScalar *X,PetscBLASInt ldx,PetscBLASInt nrhs)
+{
+  PetscErrorCode ierr;
+  PetscScalar    one = 1.0,mone = -1.0,zero = 0.0,*T;
+  PetscBLASInt   n,n0,n1,r = node->r0 + node->r1,info;
+
+  PetscFunctionBegin;
+  ierr = PetscBLASIntCast(node->n,&n);CHKERRQ(ierr);
+  if (node->D) {
+    PetscStackCallBLAS("LAPACKgetrs",LAPACKgetrs_("N",&n,&nrhs,node->D,&n,node->pivots,X,&ldx,&info));
+    if (info) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_LIB,"GETRS - Bad solve");
+    PetscFunctionReturn(0);
+  }
+  ierr = PetscBLASIntCast(node->n0,&n0);CHKERRQ(ierr);
+  ierr = PetscBLASIntCast(node->n1,&n1);CHKERRQ(ierr);
+  ierr = HODLRNodeSolve(node->child[0],X,ldx,nrhs);CHKERRQ(ierr);
+  ierr = HODLRNodeSolve(node->child[1],X+n0,ldx,nrhs);CHKERRQ(ierr);
+  if (!r) PetscFunctionReturn(0);
+  if (nrhs == 1) T = node->t;
+  else {
+    ierr = PetscMalloc1(r*nrhs,&T);CHKERRQ(ierr);
+  }
+  if (node->r0) PetscStackCallBLAS("BLASgemm",BLASgemm_("N","N",&node->r0,&nrhs,&n1,&one,node->Vt0,&node->r0,X+n0,&ldx,&zero,T,&r));
+  if (node->r1) PetscStackCallBLAS("BLASgemm",BLASgemm_("N","N",&node->r1,&nrhs,&n0,&one,node->Vt1,&node->r1,X,&ldx,&zero,T+node->r0,&r));
+  PetscStackCallBLAS("LAPACKgetrs",LAPACKgetrs_("N",&r,&nrhs,node->K,&r,node->pivots,T,&r,&info));
+  if (info) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_LIB,"GETRS - Bad solve");
+  if (node->r0) PetscStackCallBLAS("BLASgemm",BLASgemm_("N","N",&n0,&nrhs,&node->r0,&mone,node->W0,&n0,T,&r,&one,X,&ldx));
+  if (node->r1) PetscStackCallBLAS("BLASgemm",BLASgemm_("N","N",&n1,&nrhs,&node->r1,&mone,node->W1,&n1,T+node->r0,&r,&one,X+n0,&ldx));
+  if (nrhs != 1) {ierr = PetscFree(T);CHKERRQ(ierr);}
+  PetscFunctionReturn(0);
+}
+
+/* overwrites x with A^{-T} x */
+static PetscErrorCode HODLRNodeSolveTranspose(HODLRNode node,PetscScalar *x)
+{
+  PetscErrorCode ierr;
+  PetscScalar    one = 1.0,mone = -1.0,zero = 0.0;
+  PetscBLASInt   n,n0,n1,r = node->r0 + node->r1,ione = 1,info;
+
+  PetscFunctionBegin;
+  ierr = PetscBLASIntCast(node->n,&n);CHKERRQ(ierr);
+  if (node->D) {
+    PetscStackCallBLAS("LAPACKgetrs",LAPACKgetrs_("T",&n,&ione,node->D,&n,node->pivots,x,&n,&info));
+    if (info) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_LIB,"GETRS - Bad solve");
+    PetscFunctionReturn(0);
+  }
+  ierr = PetscBLASIntCast(node->n0,&n0);CHKERRQ(ierr);
+  ierr = PetscBLASIntCast(node->n1,&n1);CHKERRQ(ierr);
+  if (r) {
+    if (node->r0) PetscStackCallBLAS("BLASgemv",BLASgemv_("T",&n0,&node->r0,&one,node->W0,&n0,x,&ione,&zero,node->t,&ione));
+    if (node->r1) PetscStackCallBLAS("BLASgemv",BLASgemv_("T",&n1,&node->r1,&one,node->W1,&n1,x+n0,&ione,&zero,node->t+node->r0,&ione));
+    PetscStackCallBLAS("LAPACKgetrs",LAPACKgetrs_("T",&r,&ione,node->K,&r,node->pivots,node->t,&r,&info));
+    if (info) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_LIB,"GETRS - Bad solve");
+    if (node->r1) PetscStackCallBLAS("BLASgemv",BLASgemv_("T",&node->r1,&n0,&mone,node->Vt1,&node->r1,node->t+node->r0,&ione,&one,x,&ione));
+    if (node->r0) PetscStackCallBLAS("BLASgemv",BLASgemv_("T",&node->r0,&n1,&mone,node->Vt0,&node->r0,node->t,&ione,&one,x+n0,&ione));
+  }
+  ierr = HODLRNodeSolveTranspose(node->child[0],x);CHKERRQ(ierr);
+  ierr = HODLRNodeSolveTranspose(node->child[1],x+n0);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   With D = diag(A(0,0),A(1,1)), U = diag(U0,U1) and V = [0 Vt0; Vt1 0] we have A = D + U V and
+
+      A^{-1} = D^{-1} - W K^{-1} V D^{-1},   W = D^{-1} U,   K = I + V W = [I Vt0 W1; Vt1 W0 I]
+*/
+static PetscErrorCode HODLRNodeFactor(HODLRNode node)
+{
+  PetscErrorCode ierr;
+  PetscScalar    one = 1.0,zero = 0.0;
+  PetscBLASInt   n,n0,n1,r = node->r0 + node->r1,i,info;
+
+  PetscFunctionBegin;
+  ierr = PetscBLASIntCast(node->n,&n);CHKERRQ(ierr);
+  if (node->D) {
+    ierr = PetscMalloc1(n,&node->pivots);CHKERRQ(ierr);
+    PetscStackCallBLAS("LAPACKgetrf",LAPACKgetrf_(&n,&n,node->D,&n,node->pivots,&info));
+    if (info<0) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_LIB,"Bad argument to LU factorization");
+    if (info>0) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_MAT_LU_ZRPVT,"Bad LU factorization");
+    PetscFunctionReturn(0);
+  }
+  ierr = PetscBLASIntCast(node->n0,&n0);CHKERRQ(ierr);
+  ierr = PetscBLASIntCast(node->n1,&n1);CHKERRQ(ierr);
+  ierr = HODLRNodeFactor(node->child[0]);CHKERRQ(ierr);
+  ierr = HODLRNodeFactor(node->child[1]);CHKERRQ(ierr);
+  if (!r) PetscFunctionReturn(0);
+
+  ierr = PetscMalloc4(n0*node->r0,&node->W0,n1*node->r1,&node->W1,r*r,&node->K,r,&node->t);CHKERRQ(ierr);
+  ierr = PetscMemcpy(node->W0,node->U0,n0*node->r0*sizeof(PetscScalar));CHKERRQ(ierr);
+  ierr = PetscMemcpy(node->W1,node->U1,n1*node->r1*sizeof(PetscScalar));CHKERRQ(ierr);
+  if (node->r0) {ierr = HODLRNodeSolve(node->child[0],node->W0,n0,node->r0);CHKERRQ(ierr);}
+  if (node->r1) {ierr = HODLRNodeSolve(node->child[1],node->W1,n1,node->r1);CHKERRQ(ierr);}
+
+  ierr = PetscMemzero(node->K,r*r*sizeof(PetscScalar));CHKERRQ(ierr);
+  for (i=0; i<r; i++) node->K[i*(r+1)] = 1.0;
+  if (node->r0 && node->r1) {
+    PetscStackCallBLAS("BLASgemm",BLASgemm_("N","N",&node->r0,&node->r1,&n1,&one,node->Vt0,&node->r0,node->W1,&n1,&zero,node->K+node->r0*r,&r));
+    PetscStackCallBLAS("BLASgemm",BLASgemm_("N","N",&node->r1,&node->r0,&n0,&one,node->Vt1,&node->r1,node->W0,&n0,&zero,node->K+node->r0,&r));
+  }
+  ierr = PetscMalloc1(r,&node->pivots);CHKERRQ(ierr);
+  PetscStackCallBLAS("LAPACKgetrf",LAPACKgetrf_(&r,&r,node->K,&r,node->pivots,&info));
+  if (info<0) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_LIB,"Bad argument to LU factorization");
+  if (info>0) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_MAT_LU_ZRPVT,"Bad LU factorization");
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatMult_HODLR(Mat A,Vec xx,Vec yy)
+{
+  Mat_HODLR         *h = (Mat_HODLR*)A->data;
+  PetscErrorCode    ierr;
+  const PetscScalar *x;
+  PetscScalar       *y;
+
+  PetscFunctionBegin;
+  if (!A->rmap->n) PetscFunctionReturn(0);
+  ierr = VecGetArrayRead(xx,&x);CHKERRQ(ierr);
+  ierr = VecGetArray(yy,&y);CHKERRQ(ierr);
+  ierr = HODLRNodeMult(h->root,PETSC_FALSE,x,y,h->work);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(xx,&x);CHKERRQ(ierr);
+  ierr = VecRestoreArray(yy,&y);CHKERRQ(ierr);
+  ierr = PetscLogFlops(2.0*h->nz);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatMultTranspose_HODLR(Mat A,Vec xx,Vec yy)
+{
+  Mat_HODLR         *h = (Mat_HODLR*)A->data;
+  PetscErrorCode    ierr;
+  const PetscScalar *x;
+  PetscScalar       *y;
+
+  PetscFunctionBegin;
+  if (!A->rmap->n) PetscFunctionReturn(0);
+  ierr = VecGetArrayRead(xx,&x);CHKERRQ(ierr);
+  ierr = VecGetArray(yy,&y);CHKERRQ(ierr);
+  ierr = HODLRNodeMult(h->root,PETSC_TRUE,x,y,h->work);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(xx,&x);CHKERRQ(ierr);
+  ierr = VecRestoreArray(yy,&y);CHKERRQ(ierr);
+  ierr = PetscLogFlops(2.0*h->nz);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatSolve_HODLR(Mat A,Vec bb,Vec xx)
+{
+  Mat_HODLR      *h = (Mat_HODLR*)A->data;
+  PetscErrorCode ierr;
+  PetscScalar    *x;
+  PetscBLASInt   n;
+
+  PetscFunctionBegin;
+  ierr = PetscBLASIntCast(A->rmap->n,&n);CHKERRQ(ierr);
+  ierr = VecCopy(bb,xx);CHKERRQ(ierr);
+  ierr = VecGetArray(xx,&x);CHKERRQ(ierr);
+  ierr = PetscFPTrapPush(PETSC_FP_TRAP_OFF);CHKERRQ(ierr);
+  ierr = HODLRNodeSolve(h->root,x,n,1);CHKERRQ(ierr);
+  ierr = PetscFPTrapPop();CHKERRQ(ierr);
+  ierr = VecRestoreArray(xx,&x);CHKERRQ(ierr);
+  ierr = PetscLogFlops(2.0*h->nz);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatSolveTranspose_HODLR(Mat A,Vec bb,Vec xx)
+{
+  Mat_HODLR      *h = (Mat_HODLR*)A->data;
+  PetscErrorCode ierr;
+  PetscScalar    *x;
+
+  PetscFunctionBegin;
+  ierr = VecCopy(bb,xx);CHKERRQ(ierr);
+  ierr = VecGetArray(xx,&x);CHKERRQ(ierr);
+  ierr = PetscFPTrapPush(PETSC_FP_TRAP_OFF);CHKERRQ(ierr);
+  ierr = HODLRNodeSolveTranspose(h->root,x);CHKERRQ(ierr);
+  ierr = PetscFPTrapPop();CHKERRQ(ierr);
+  ierr = VecRestoreArray(xx,&x);CHKERRQ(ierr);
+  ierr = PetscLogFlops(2.0*h->nz);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatLUFactorNumeric_HODLR(Mat F,Mat A,const MatFactorInfo *info)
+{
+  Mat_HODLR      *f = (Mat_HODLR*)F->data,*h = (Mat_HODLR*)A->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  /* the tree of A may have changed since the symbolic factorization, since the ranks depend on the values */
+  ierr = HODLRNodeDestroy(&f->root);CHKERRQ(ierr);
+  f->tol      = h->tol;
+  f->leafsize = h->leafsize;
+  f->maxrank  = h->maxrank;
+  f->levels   = h->levels;
+  f->nz       = h->nz;
+  if (A->rmap->n) {
+    ierr = HODLRNodeDuplicate(h->root,&f->root);CHKERRQ(ierr);
+    ierr = PetscFPTrapPush(PETSC_FP_TRAP_OFF);CHKERRQ(ierr);
+    ierr = HODLRNodeFactor(f->root);CHKERRQ(ierr);
+    ierr = PetscFPTrapPop();CHKERRQ(ierr);
+  }
+  F->ops->solve          = MatSolve_HODLR;
+  F->ops->solvetranspose = MatSolveTranspose_HODLR;
+  F->assembled           = PETSC_TRUE;
+  F->preallocated        = PETSC_TRUE;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatLUFactorSymbolic_HODLR(Mat F,Mat A,IS row,IS col,const MatFactorInfo *info)
+{
+  PetscBool      flg;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (row) {
+    ierr = ISIdentity(row,&flg);CHKERRQ(ierr);
+    if (!flg) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_SUP,"HODLR factorization only supports the natural ordering");
+  }
+  F->ops->lufactornumeric = MatLUFactorNumeric_HODLR;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatGetInfo_HODLR(Mat A,MatInfoType flag,MatInfo *info)
+{
+  Mat_HODLR      *h = (Mat_HODLR*)A->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscMemzero(info,sizeof(MatInfo));CHKERRQ(ierr);
+  info->block_size        = 1.0;
+  info->nz_allocated      = (PetscLogDouble)h->nz;
+  info->nz_used           = (PetscLogDouble)h->nz;
+  info->memory            = ((PetscObject)A)->mem;
+  info->fill_ratio_given  = 0;
+  info->fill_ratio_needed = A->factortype ? 1.0 : 0;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatView_HODLR(Mat A,PetscViewer viewer)
+{
+  Mat_HODLR      *h = (Mat_HODLR*)A->data;
+  PetscErrorCode ierr;
+  PetscBool      iascii;
+  PetscReal      n = (PetscReal)A->rmap->n;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectTypeCompare((PetscObject)viewer,PETSCVIEWERASCII,&iascii);CHKERRQ(ierr);
+  if (!iascii) PetscFunctionReturn(0);
+  ierr = PetscViewerASCIIPrintf(viewer,"HODLR: leaf size %D, truncation tolerance %g, levels %D, maximum rank %D\n",h->leafsize,(double)h->tol,h->levels,h->maxrank);CHKERRQ(ierr);
+  ierr = PetscViewerASCIIPrintf(viewer,"HODLR: %D stored entries, %g%% of the dense matrix\n",h->nz,n > 0 ? (double)(100.0*h->nz/(n*n)) : 0.0);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatDestroy_HODLR(Mat A)
+{
+  Mat_HODLR      *h = (Mat_HODLR*)A->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = HODLRNodeDestroy(&h->root);CHKERRQ(ierr);
+  ierr = PetscFree(h->work);CHKERRQ(ierr);
+  ierr = PetscFree(A->data);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatCreate_HODLR_Private(MPI_Comm comm,PetscInt n,Mat *H)
+{
+  PetscErrorCode ierr;
+  Mat_HODLR      *h;
+
+  PetscFunctionBegin;
+  ierr = MatCreate(comm,H);CHKERRQ(ierr);
+  ierr = MatSetSizes(*H,n,n,n,n);CHKERRQ(ierr);
+  ierr = PetscObjectChangeTypeName((PetscObject)*H,MATHODLR);CHKERRQ(ierr);
+  ierr = PetscLayoutSetUp((*H)->rmap);CHKERRQ(ierr);
+  ierr = PetscLayoutSetUp((*H)->cmap);CHKERRQ(ierr);
+
+  ierr        = PetscNewLog(*H,&h);CHKERRQ(ierr);
+  (*H)->data  = (void*)h;
+
+  (*H)->ops->destroy = MatDestroy_HODLR;
+  (*H)->ops->view    = MatView_HODLR;
+  (*H)->ops->getinfo = MatGetInfo_HODLR;
+  (*H)->assembled    = PETSC_TRUE;
+  (*H)->preallocated = PETSC_TRUE;
+  PetscFunctionReturn(0);
+}
+
+PETSC_INTERN PetscErrorCode MatGetFactor_hodlr_petsc(Mat A,MatFactorType ftype,Mat *F)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (ftype != MAT_FACTOR_LU) SETERRQ1(PetscObjectComm((PetscObject)A),PETSC_ERR_SUP,"Factor type %s not supported for HODLR matrices",MatFactorTypes[ftype]);
+  ierr = MatCreate_HODLR_Private(PetscObjectComm((PetscObject)A),A->rmap->n,F);CHKERRQ(ierr);
+  (*F)->ops->lufactorsymbolic = MatLUFactorSymbolic_HODLR;
+  (*F)->factortype            = ftype;
+
+  ierr = PetscFree((*F)->solvertype);CHKERRQ(ierr);
+  ierr = PetscStrallocpy(MATSOLVERPETSC,&(*F)->solvertype);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@
+   MatCreateHODLR - Creates a hierarchically off-diagonal low-rank (HODLR) approximation of a sequential matrix
+
+   Collective on Mat
+
+   Input Parameters:
++  A - the (sequential, square) matrix to compress, usually dense such as an explicitly formed Schur complement
+.  tol - relative truncation tolerance of the off-diagonal blocks, or PETSC_DEFAULT
+-  leafsize - diagonal blocks of at most this size are stored as dense matrices, or PETSC_DEFAULT
+
+   Output Parameter:
+.  H - the HODLR matrix
+
+   Notes:
+   The rows and columns are recursively split in halves in their given order; an off-diagonal block A(I,J) is
+   replaced by its singular value decomposition truncated at the singular values smaller than tol times the
+   largest singular value of that block. The compression is most effective when nearby indices correspond
+   to nearby unknowns, as in Schur complements of PDE discretizations ordered along the interface.
+
+   The resulting matrix supports MatMult(), MatMultTranspose() and a direct solver obtained with
+   MatGetFactor(H,MATSOLVERPETSC,MAT_FACTOR_LU,&F), which is used by PCLU. The factorization and solve cost
+   O(n k^2 log^2 n) and O(n k log n) operations respectively, where k is the largest rank.
+
+   The blocks are compressed from the entries of A, so A has to be available as an explicit (dense) matrix and creating
+   H does not reduce the peak memory; the savings are in the storage of H and in the cost of its products and solves.
+   The matrix H does not reference A; to recompress after changing A destroy H and call this routine again.
+
+   Level: advanced
+
+.seealso: MATHODLR, MatCreateLRC(), PCFieldSplitSetSchurHODLR()
+@*/
+PetscErrorCode MatCreateHODLR(Mat A,PetscReal tol,PetscInt leafsize,Mat *H)
+{
+  PetscErrorCode ierr;
+  PetscMPIInt    size;
+  PetscBool      isdense;
+  Mat            Ad;
+  Mat_HODLR      *h;
+  PetscInt       m,n;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(A,MAT_CLASSID,1);
+  PetscValidLogicalCollectiveReal(A,tol,2);
+  PetscValidLogicalCollectiveInt(A,leafsize,3);
+  PetscValidPointer(H,4);
+  ierr = MPI_Comm_size(PetscObjectComm((PetscObject)A),&size);CHKERRQ(ierr);
+  if (size > 1) SETERRQ(PetscObjectComm((PetscObject)A),PETSC_ERR_SUP,"HODLR matrices are only available for sequential matrices");
+  ierr = MatGetSize(A,&m,&n);CHKERRQ(ierr);
+  if (m != n) SETERRQ2(PetscObjectComm((PetscObject)A),PETSC_ERR_ARG_SIZ,"Matrix must be square, rows %D columns %D",m,n);
+  if (tol == PETSC_DEFAULT) tol = 1.e-8;
+  if (leafsize == PETSC_DEFAULT) leafsize = 32;
+  if (tol < 0.0) SETERRQ1(PetscObjectComm((PetscObject)A),PETSC_ERR_ARG_OUTOFRANGE,"Tolerance %g must be nonnegative",(double)tol);
+  if (leafsize < 1) SETERRQ1(PetscObjectComm((PetscObject)A),PETSC_ERR_ARG_OUTOFRANGE,"Leaf size %D must be positive",leafsize);
+
+  ierr = PetscObjectTypeCompare((PetscObject)A,MATSEQDENSE,&isdense);CHKERRQ(ierr);
+  if (isdense) {
+    ierr = PetscObjectReference((PetscObject)A);CHKERRQ(ierr);
+    Ad   = A;
+  } else {
+    ierr = MatConvert(A,MATSEQDENSE,MAT_INITIAL_MATRIX,&Ad);CHKERRQ(ierr);
+  }
+
+  ierr        = MatCreate_HODLR_Private(PetscObjectComm((PetscObject)A),m,H);CHKERRQ(ierr);
+  h           = (Mat_HODLR*)(*H)->data;
+  h->tol      = tol;
+  h->leafsize = leafsize;
+  if (m) {
+    Mat_SeqDense *d = (Mat_SeqDense*)Ad->data;
+
+    ierr = PetscFPTrapPush(PETSC_FP_TRAP_OFF);CHKERRQ(ierr);
+    ierr = HODLRNodeCreate(d->v,d->lda,m,h,0,&h->root);CHKERRQ(ierr);
+    ierr = PetscFPTrapPop();CHKERRQ(ierr);
+  }
+  ierr = PetscMalloc1(h->maxrank,&h->work);CHKERRQ(ierr);
+  ierr = PetscLogObjectMemory((PetscObject)*H,(h->nz+h->maxrank)*sizeof(PetscScalar));CHKERRQ(ierr);
+  ierr = MatDestroy(&Ad);CHKERRQ(ierr);
+
+  (*H)->ops->mult          = MatMult_HODLR;
+  (*H)->ops->multtranspose = MatMultTranspose_HODLR;
+  PetscFunctionReturn(0);
+}
+
+/*MC
+   MATHODLR - "hodlr" - A sequential hierarchically off-diagonal low-rank matrix, created with MatCreateHODLR()
+
+   The matrix supports MatMult(), MatMultTranspose() and LU factorization with MATSOLVERPETSC; it can therefore
+   be used as the preconditioning matrix of a KSP with PCLU.
+
+   Level: advanced
+
+.seealso: MatCreateHODLR(), MATLRC
+M*/
@@ -129,7 +129,11 @@ PETSC_INTERN PetscErrorCode MatGetFactor_seqaij_petsc(Mat,MatFactorType,Mat*);
 PETSC_INTERN PetscErrorCode MatGetFactor_seqbaij_petsc(Mat,MatFactorType,Mat*);
 PETSC_INTERN PetscErrorCode MatGetFactor_seqsbaij_petsc(Mat,MatFactorType,Mat*);
 PETSC_INTERN PetscErrorCode MatGetFactor_seqdense_petsc(Mat,MatFactorType,Mat*);
+PETSC_INTERN PetscErrorCode MatGetFactor_hodlr_petsc(Mat,MatFactorType,Mat*);
 PETSC_INTERN PetscErrorCode MatGetFactor_seqaij_bas(Mat,MatFactorType,Mat*);
+PETSC_INTERN PetscErrorCode MatGetFactor_seqaij_chowilu(Mat,MatFactorType,Mat*);
+PETSC_INTERN PetscErrorCode MatGetFactor_seqaij_supernodal(Mat,MatFactorType,Mat*);
+PETSC_INTERN PetscErrorCode MatGetFactor_seqsbaij_supernodal(Mat,MatFactorType,Mat*);
 
 /*@C
   MatInitializePackage - This function initializes everything in the Mat package. It is called
@@ -346,8 +350,16 @@ PetscErrorCode  MatInitializePackage(void)
   ierr = MatSolverTypeRegister(MATSOLVERPETSC, MATSEQDENSE,      MAT_FACTOR_LU,MatGetFactor_seqdense_petsc);CHKERRQ(ierr);
   ierr = MatSolverTypeRegister(MATSOLVERPETSC, MATSEQDENSE,      MAT_FACTOR_CHOLESKY,MatGetFactor_seqdense_petsc);CHKERRQ(ierr);
 
+  ierr = MatSolverTypeRegister(MATSOLVERPETSC, MATHODLR,         MAT_FACTOR_LU,MatGetFactor_hodlr_petsc);CHKERRQ(ierr);
+
   ierr = MatSolverTypeRegister(MATSOLVERBAS,   MATSEQAIJ,        MAT_FACTOR_ICC,MatGetFactor_seqaij_bas);CHKERRQ(ierr);
 
+  ierr = MatSolverTypeRegister(MATSOLVERCHOWILU,MATSEQAIJ,       MAT_FACTOR_ILU,MatGetFactor_seqaij_chowilu);CHKERRQ(ierr);
+
+  ierr = MatSolverTypeRegister(MATSOLVERSUPERNODAL,MATSEQAIJ,    MAT_FACTOR_LU,MatGetFactor_seqaij_supernodal);CHKERRQ(ierr);
+  ierr = MatSolverTypeRegister(MATSOLVERSUPERNODAL,MATSEQAIJ,    MAT_FACTOR_CHOLESKY,MatGetFactor_seqaij_supernodal);CHKERRQ(ierr);
+  ierr = MatSolverTypeRegister(MATSOLVERSUPERNODAL,MATSEQSBAIJ,   MAT_FACTOR_CHOLESKY,MatGetFactor_seqsbaij_supernodal);CHKERRQ(ierr);
+
   /*
      Register the external package factorization based solvers
         Eventually we don't want to have these hardwired here at compile time of PETSc
@@ -59,6 +59,7 @@ PETSC_EXTERN PetscErrorCode MatCreate_Elemental(Mat);
 
 PETSC_EXTERN PetscErrorCode MatCreate_Preallocator(Mat);
 PETSC_EXTERN PetscErrorCode MatCreate_Dummy(Mat);
+PETSC_EXTERN PetscErrorCode MatCreate_EBE(Mat);
 
 #if defined PETSC_HAVE_HYPRE
 PETSC_EXTERN PetscErrorCode MatCreate_HYPRE(Mat);
@@ -157,6 +158,7 @@ PetscErrorCode  MatRegisterAll(void)
 
   ierr = MatRegister(MATPREALLOCATOR,   MatCreate_Preallocator);CHKERRQ(ierr);
   ierr = MatRegister(MATDUMMY,          MatCreate_Dummy);CHKERRQ(ierr);
+  ierr = MatRegister(MATEBE,            MatCreate_EBE);CHKERRQ(ierr);
 
 #if defined PETSC_HAVE_HYPRE
   ierr = MatRegister(MATHYPRE,          MatCreate_HYPRE);CHKERRQ(ierr);
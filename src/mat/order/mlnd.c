@@ -0,0 +1,456 @@
+#include <petscmat.h>
+#include <petsc/private/matorderimpl.h>
+
+/*
+    Multilevel nested dissection ordering.
+
+    Each subgraph is bisected by a vertex separator computed with the multilevel scheme: the graph is coarsened by
+    heavy edge matching, the coarsest graph is split by greedy graph growing, the boundary of the smaller side is taken
+    as the initial separator, and the separator is improved by Fiduccia-Mattheyses (FM) vertex moves on the coarsest
+    graph and again on every finer graph after it has been projected. The separator is numbered last and the two
+    remaining parts are dissected in turn; small subgraphs are ordered with the SPARSPAK quotient minimum degree.
+
+    Reference: G. Karypis and V. Kumar, A fast and high quality multilevel scheme for partitioning irregular graphs, SIAM J. Sci. Comput. 20 (1998).
+*/
+
+typedef struct {
+  PetscInt nvtxs;
+  PetscInt *xadj,*adjncy;  /* adjacency structure without the diagonal */
+  PetscInt *vwgt,*adjwgt;  /* vertex and edge weights */
+  PetscInt tvwgt;          /* total vertex weight */
+  PetscInt *label;         /* vertex of the matrix, only for the graphs that are dissected */
+  PetscInt *cmap;          /* vertex of the coarser graph, once the graph has been coarsened */
+} MLNDGraph;
+
+static PetscErrorCode MLNDGraphCreate_Private(PetscInt nvtxs,PetscInt nedges,PetscBool labels,MLNDGraph **g)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscNew(g);CHKERRQ(ierr);
+  (*g)->nvtxs = nvtxs;
+  ierr = PetscMalloc4(nvtxs+1,&(*g)->xadj,PetscMax(nedges,1),&(*g)->adjncy,nvtxs,&(*g)->vwgt,PetscMax(nedges,1),&(*g)->adjwgt);CHKERRQ(ierr);
+  if (labels) {ierr = PetscMalloc1(nvtxs,&(*g)->label);CHKERRQ(ierr);}
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MLNDGraphDestroy_Private(MLNDGraph **g)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (!*g) PetscFunctionReturn(0);
+  ierr = PetscFree4((*g)->xadj,(*g)->adjncy,(*g)->vwgt,(*g)->adjwgt);CHKERRQ(ierr);
+  ierr = PetscFree((*g)->label);CHKERRQ(ierr);
+  ierr = PetscFree((*g)->cmap);CHKERRQ(ierr);
+  ierr = PetscFree(*g);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* A small linear congruential generator, so that the orderings do not depend on the random number implementation */
+PETSC_STATIC_INLINE PetscInt MLNDRandom_Private(unsigned long *seed,PetscInt n)
+{
+  *seed = (*seed*1103515245UL + 12345UL) & 0x7fffffffUL;
+  return (PetscInt)((*seed >> 4) % (unsigned long)n);
+}
+
+/*
+   Heavy edge matching: the vertices are visited in random order and each unmatched vertex is matched with the
+   unmatched neighbor connected by the heaviest edge. The coarse graph has one vertex per matched pair.
+*/
+static PetscErrorCode MLNDCoarsen_Private(MLNDGraph *g,PetscInt coarsento,unsigned long *seed,MLNDGraph **gc)
+{
+  const PetscInt n = g->nvtxs,maxvwgt = PetscMax(2,(3*g->tvwgt)/(2*coarsento));
+  PetscInt       *perm,*match,*cvtx,*pos,i,k,v,u,c,cu,nc,best,bestw,start,cnt;
+  MLNDGraph      *cg;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscMalloc1(n,&g->cmap);CHKERRQ(ierr);
+  ierr = PetscMalloc4(n,&perm,n,&match,n,&cvtx,n,&pos);CHKERRQ(ierr);
+  for (i=0; i<n; i++) {perm[i] = i; match[i] = -1;}
+  for (i=n-1; i>0; i--) {k = MLNDRandom_Private(seed,i+1); v = perm[i]; perm[i] = perm[k]; perm[k] = v;}
+  for (i=0; i<n; i++) {
+    v = perm[i];
+    if (match[v] != -1) continue;
+    best = v; bestw = -1;
+    for (k=g->xadj[v]; k<g->xadj[v+1]; k++) {
+      u = g->adjncy[k];
+      if (match[u] == -1 && g->adjwgt[k] > bestw && g->vwgt[v] + g->vwgt[u] <= maxvwgt) {best = u; bestw = g->adjwgt[k];}
+    }
+    match[v] = best; match[best] = v;
+  }
+  for (nc=0, v=0; v<n; v++) {
+    if (v <= match[v]) {g->cmap[v] = g->cmap[match[v]] = nc; cvtx[nc++] = v;}
+  }
+
+  ierr = MLNDGraphCreate_Private(nc,g->xadj[n],PETSC_FALSE,&cg);CHKERRQ(ierr);
+  cg->tvwgt = g->tvwgt;
+  for (c=0; c<nc; c++) pos[c] = -1;
+  cg->xadj[0] = 0;
+  for (c=0; c<nc; c++) {
+    start = cnt = cg->xadj[c];
+    v     = cvtx[c];
+    cg->vwgt[c] = g->vwgt[v] + (match[v] != v ? g->vwgt[match[v]] : 0);
+    for (i=0; i<2; i++, v=match[v]) {
+      if (i && match[v] == v) break;
+      for (k=g->xadj[v]; k<g->xadj[v+1]; k++) {
+        cu = g->cmap[g->adjncy[k]];
+        if (cu == c) continue;
+        if (pos[cu] >= start && cg->adjncy[pos[cu]] == cu) cg->adjwgt[pos[cu]] += g->adjwgt[k];
+        else {pos[cu] = cnt; cg->adjncy[cnt] = cu; cg->adjwgt[cnt++] = g->adjwgt[k];}
+      }
+    }
+    cg->xadj[c+1] = cnt;
+  }
+  ierr = PetscFree4(perm,match,cvtx,pos);CHKERRQ(ierr);
+  *gc  = cg;
+  PetscFunctionReturn(0);
+}
+
+/*
+   Gains of moving the separator vertex v to part 0 and to part 1, the neighbors of v in the other part enter the
+   separator. A move is not valid if it would pull a locked vertex into the separator.
+*/
+PETSC_STATIC_INLINE void MLNDNodeGain_Private(MLNDGraph *g,const PetscInt *where,const PetscInt *locked,PetscInt v,PetscInt *gain,PetscBool *valid)
+{
+  PetscInt k,u;
+
+  gain[0]  = gain[1] = g->vwgt[v];
+  valid[0] = valid[1] = PETSC_TRUE;
+  for (k=g->xadj[v]; k<g->xadj[v+1]; k++) {
+    u = g->adjncy[k];
+    if (where[u] < 2) {
+      gain[1-where[u]] -= g->vwgt[u];
+      if (locked[u]) valid[1-where[u]] = PETSC_FALSE;
+    }
+  }
+}
+
+/* Queues the moves of v whose gain has changed; queued[] is the gain of the queued move, PETSC_MIN_INT if none */
+PETSC_STATIC_INLINE PetscErrorCode MLNDNodePush_Private(MLNDGraph *g,const PetscInt *where,const PetscInt *locked,PetscInt v,PetscInt *queued,PetscHeap heap)
+{
+  PetscInt       t,gain[2];
+  PetscBool      valid[2];
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  MLNDNodeGain_Private(g,where,locked,v,gain,valid);
+  for (t=0; t<2; t++) {
+    if (valid[t] && gain[t] != queued[2*v+t]) {
+      queued[2*v+t] = gain[t];
+      ierr = PetscHeapAdd(heap,2*v+t,-gain[t]);CHKERRQ(ierr);
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
+/*
+   FM refinement of a vertex separator, where[] is 0 or 1 for the two parts and 2 for the separator. In each pass the
+   separator vertex with the largest gain is moved, even if this makes the separator larger, until no improvement is
+   found for a number of moves; the moves after the best separator seen are then undone.
+*/
+static PetscErrorCode MLNDNodeRefine_Private(MLNDGraph *g,PetscInt *where,PetscInt *pwgt,PetscInt maxpwgt,PetscInt npasses)
+{
+  const PetscInt n = g->nvtxs,nedges = g->xadj[n],limit = PetscMax(20,PetscMin(n/50,100));
+  PetscInt       *locked,*queued,*mvlist,*mvptr,*ulist,pass,id,val,v,u,w,t,k,j,gain[2],nmoves,nbest,nu,best,bestbal,bal;
+  PetscBool      valid[2];
+  PetscHeap      heap;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscMalloc5(n,&locked,2*n,&queued,n,&mvlist,n+1,&mvptr,n,&ulist);CHKERRQ(ierr);
+  ierr = PetscHeapCreate(2*n+4*nedges,&heap);CHKERRQ(ierr);
+  for (pass=0; pass<npasses; pass++) {
+    for (v=0; v<n; v++) {
+      locked[v]   = 0;
+      queued[2*v] = queued[2*v+1] = PETSC_MIN_INT;
+    }
+    for (v=0; v<n; v++) {
+      if (where[v] == 2) {ierr = MLNDNodePush_Private(g,where,locked,v,queued,heap);CHKERRQ(ierr);}
+    }
+    best    = pwgt[2];
+    bestbal = PetscAbsInt(pwgt[0]-pwgt[1]);
+    nmoves  = nbest = nu = 0;
+    mvptr[0] = 0;
+    while (PETSC_TRUE) {
+      ierr = PetscHeapPop(heap,&id,&val);CHKERRQ(ierr);
+      if (id < 0) break;
+      v = id/2; t = id%2;
+      if (locked[v] || where[v] != 2 || queued[id] != -val) continue; /* stale entry */
+      queued[id] = PETSC_MIN_INT;
+      MLNDNodeGain_Private(g,where,locked,v,gain,valid);
+      if (!valid[t] || pwgt[t] + g->vwgt[v] > maxpwgt) continue;
+
+      where[v]  = t; locked[v] = 1;
+      pwgt[2]  -= g->vwgt[v]; pwgt[t] += g->vwgt[v];
+      for (k=g->xadj[v]; k<g->xadj[v+1]; k++) {
+        u = g->adjncy[k];
+        if (where[u] == 1-t) {
+          where[u]    = 2;
+          pwgt[1-t]  -= g->vwgt[u]; pwgt[2] += g->vwgt[u];
+          ulist[nu++] = u;
+        }
+      }
+      mvlist[nmoves++] = id;
+      mvptr[nmoves]    = nu;
+      for (k=g->xadj[v]; k<g->xadj[v+1]; k++) {
+        u = g->adjncy[k];
+        if (where[u] == 2 && !locked[u]) {ierr = MLNDNodePush_Private(g,where,locked,u,queued,heap);CHKERRQ(ierr);}
+      }
+      for (j=mvptr[nmoves-1]; j<nu; j++) {
+        u = ulist[j];
+        for (k=g->xadj[u]; k<g->xadj[u+1]; k++) {
+          w = g->adjncy[k];
+          if (where[w] == 2 && !locked[w] && w != v) {ierr = MLNDNodePush_Private(g,where,locked,w,queued,heap);CHKERRQ(ierr);}
+        }
+      }
+
+      bal = PetscAbsInt(pwgt[0]-pwgt[1]);
+      if (pwgt[2] < best || (pwgt[2] == best && bal < bestbal)) {best = pwgt[2]; bestbal = bal; nbest = nmoves;}
+      else if (nmoves - nbest > limit) break;
+    }
+    do {ierr = PetscHeapPop(heap,&id,&val);CHKERRQ(ierr);} while (id >= 0);
+
+    for (j=nmoves-1; j>=nbest; j--) {
+      v = mvlist[j]/2; t = mvlist[j]%2;
+      for (k=mvptr[j]; k<mvptr[j+1]; k++) {
+        u         = ulist[k];
+        where[u]  = 1-t;
+        pwgt[2]  -= g->vwgt[u]; pwgt[1-t] += g->vwgt[u];
+      }
+      where[v]  = 2;
+      pwgt[t]  -= g->vwgt[v]; pwgt[2] += g->vwgt[v];
+    }
+    if (!nbest) break;
+  }
+  ierr = PetscHeapDestroy(&heap);CHKERRQ(ierr);
+  ierr = PetscFree5(locked,queued,mvlist,mvptr,ulist);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   Initial separator of the coarsest graph: part 0 is grown breadth first from a random vertex until it has half of
+   the weight, then the boundary of the side with the lighter boundary becomes the separator
+*/
+static PetscErrorCode MLNDGrow_Private(MLNDGraph *g,unsigned long *seed,PetscInt *queue,PetscInt *where,PetscInt *pwgt)
+{
+  const PetscInt n = g->nvtxs;
+  PetscInt       k,v,u,head = 0,tail = 0,next,bwgt[2] = {0,0},side;
+
+  PetscFunctionBegin;
+  for (v=0; v<n; v++) where[v] = 1;
+  pwgt[0] = 0; pwgt[1] = g->tvwgt; pwgt[2] = 0;
+  next = MLNDRandom_Private(seed,n);
+  while (2*pwgt[0] < g->tvwgt) {
+    if (head == tail) { /* start again in another connected component */
+      while (where[next] != 1) next = (next+1)%n;
+      where[next] = -1; queue[tail++] = next;
+    }
+    v        = queue[head++];
+    where[v] = 0;
+    pwgt[0] += g->vwgt[v]; pwgt[1] -= g->vwgt[v];
+    for (k=g->xadj[v]; k<g->xadj[v+1]; k++) {
+      u = g->adjncy[k];
+      if (where[u] == 1) {where[u] = -1; queue[tail++] = u;}
+    }
+  }
+  for (k=head; k<tail; k++) where[queue[k]] = 1;
+
+  for (v=0; v<n; v++) {
+    for (k=g->xadj[v]; k<g->xadj[v+1]; k++) {
+      if (where[g->adjncy[k]] != where[v]) {bwgt[where[v]] += g->vwgt[v]; break;}
+    }
+  }
+  side = bwgt[0] <= bwgt[1] ? 0 : 1;
+  for (v=0; v<n; v++) {
+    if (where[v] != side) continue;
+    for (k=g->xadj[v]; k<g->xadj[v+1]; k++) {
+      u = g->adjncy[k];
+      if (where[u] == 1-side) {where[v] = 3; break;}
+    }
+  }
+  for (v=0; v<n; v++) {
+    if (where[v] == 3) {where[v] = 2; pwgt[side] -= g->vwgt[v]; pwgt[2] += g->vwgt[v];}
+  }
+  PetscFunctionReturn(0);
+}
+
+/* Computes a vertex separator of the graph with the multilevel scheme */
+static PetscErrorCode MLNDBisect_Private(MLNDGraph *g,PetscInt coarsento,PetscInt ntrials,unsigned long *seed,PetscInt *where)
+{
+  MLNDGraph      *graphs[32];
+  PetscInt       *cwhere,*twhere,*queue,pwgt[3],tpwgt[3],nlevels = 1,l,v,trial,maxvwgt,maxpwgt;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  graphs[0] = g;
+  while (graphs[nlevels-1]->nvtxs > coarsento && nlevels < 32) {
+    MLNDGraph *fine = graphs[nlevels-1],*coarse = NULL;
+
+    ierr = MLNDCoarsen_Private(fine,coarsento,seed,&coarse);CHKERRQ(ierr);
+    if (20*coarse->nvtxs > 19*fine->nvtxs) { /* matching stalled */
+      ierr = MLNDGraphDestroy_Private(&coarse);CHKERRQ(ierr);
+      ierr = PetscFree(fine->cmap);CHKERRQ(ierr);
+      break;
+    }
+    graphs[nlevels++] = coarse;
+  }
+
+  /* several initial separators of the coarsest graph, the smallest one is kept */
+  g    = graphs[nlevels-1];
+  ierr = PetscMalloc1(g->nvtxs,&cwhere);CHKERRQ(ierr);
+  ierr = PetscMalloc2(g->nvtxs,&twhere,g->nvtxs,&queue);CHKERRQ(ierr);
+  for (maxvwgt=0, v=0; v<g->nvtxs; v++) maxvwgt = PetscMax(maxvwgt,g->vwgt[v]);
+  maxpwgt = PetscMax((11*g->tvwgt)/20,g->tvwgt/2 + maxvwgt);
+  pwgt[2] = PETSC_MAX_INT;
+  for (trial=0; trial<ntrials; trial++) {
+    ierr = MLNDGrow_Private(g,seed,queue,twhere,tpwgt);CHKERRQ(ierr);
+    ierr = MLNDNodeRefine_Private(g,twhere,tpwgt,maxpwgt,10);CHKERRQ(ierr);
+    if (tpwgt[2] < pwgt[2] || (tpwgt[2] == pwgt[2] && PetscAbsInt(tpwgt[0]-tpwgt[1]) < PetscAbsInt(pwgt[0]-pwgt[1]))) {
+      ierr = PetscMemcpy(cwhere,twhere,g->nvtxs*sizeof(PetscInt));CHKERRQ(ierr);
+      pwgt[0] = tpwgt[0]; pwgt[1] = tpwgt[1]; pwgt[2] = tpwgt[2];
+    }
+  }
+  ierr = PetscFree2(twhere,queue);CHKERRQ(ierr);
+
+  /* project the separator back to the finer graphs, refining it on each of them */
+  for (l=nlevels-2; l>=0; l--) {
+    MLNDGraph *fine = graphs[l];
+    PetscInt  *fwhere = l ? NULL : where;
+
+    if (l) {ierr = PetscMalloc1(fine->nvtxs,&fwhere);CHKERRQ(ierr);}
+    for (v=0; v<fine->nvtxs; v++) fwhere[v] = cwhere[fine->cmap[v]];
+    ierr = PetscFree(cwhere);CHKERRQ(ierr);
+    ierr = PetscFree(fine->cmap);CHKERRQ(ierr);
+    ierr = MLNDGraphDestroy_Private(&graphs[l+1]);CHKERRQ(ierr);
+    for (maxvwgt=0, v=0; v<fine->nvtxs; v++) maxvwgt = PetscMax(maxvwgt,fine->vwgt[v]);
+    maxpwgt = PetscMax((11*fine->tvwgt)/20,fine->tvwgt/2 + maxvwgt);
+    ierr = MLNDNodeRefine_Private(fine,fwhere,pwgt,maxpwgt,4);CHKERRQ(ierr);
+    cwhere = fwhere;
+  }
+  if (nlevels == 1) {
+    ierr = PetscMemcpy(where,cwhere,g->nvtxs*sizeof(PetscInt));CHKERRQ(ierr);
+    ierr = PetscFree(cwhere);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+/* Extracts the subgraph induced by the vertices in the given part */
+static PetscErrorCode MLNDSubgraph_Private(MLNDGraph *g,const PetscInt *where,PetscInt part,PetscInt *map,MLNDGraph **sub)
+{
+  PetscInt       v,k,u,nv = 0,ne = 0;
+  MLNDGraph      *s;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  for (v=0; v<g->nvtxs; v++) {
+    if (where[v] != part) continue;
+    map[v] = nv++;
+    for (k=g->xadj[v]; k<g->xadj[v+1]; k++) if (where[g->adjncy[k]] == part) ne++;
+  }
+  ierr = MLNDGraphCreate_Private(nv,ne,PETSC_TRUE,&s);CHKERRQ(ierr);
+  s->xadj[0] = 0; s->tvwgt = 0;
+  for (nv=0, ne=0, v=0; v<g->nvtxs; v++) {
+    if (where[v] != part) continue;
+    for (k=g->xadj[v]; k<g->xadj[v+1]; k++) {
+      u = g->adjncy[k];
+      if (where[u] == part) {s->adjncy[ne] = map[u]; s->adjwgt[ne++] = g->adjwgt[k];}
+    }
+    s->vwgt[nv]    = g->vwgt[v];
+    s->tvwgt      += g->vwgt[v];
+    s->label[nv++] = g->label[v];
+    s->xadj[nv]    = ne;
+  }
+  *sub = s;
+  PetscFunctionReturn(0);
+}
+
+/* Orders a subgraph with quotient minimum degree, its vertices take the positions first, first+1, ... */
+static PetscErrorCode MLNDLeafOrder_Private(MLNDGraph *g,PetscInt first,PetscInt *order)
+{
+  const PetscInt n = g->nvtxs,nedges = g->xadj[n];
+  PetscInt       *xadj,*adjncy,*perm,*invp,*deg,*marker,*rchset,*nbrhd,*qsize,*qlink,nofsub,i;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (!n) PetscFunctionReturn(0);
+  ierr = PetscMalloc2(n+1,&xadj,PetscMax(nedges,1),&adjncy);CHKERRQ(ierr);
+  ierr = PetscMalloc5(n,&perm,n,&invp,n,&deg,n,&marker,n,&rchset);CHKERRQ(ierr);
+  ierr = PetscMalloc3(n,&nbrhd,n,&qsize,n,&qlink);CHKERRQ(ierr);
+  /* SPARSPAK uses indices starting at one and destroys the adjacency */
+  for (i=0; i<=n; i++) xadj[i] = g->xadj[i] + 1;
+  for (i=0; i<nedges; i++) adjncy[i] = g->adjncy[i] + 1;
+  ierr = SPARSEPACKgenqmd(&n,xadj,adjncy,perm,invp,deg,marker,rchset,nbrhd,qsize,qlink,&nofsub);CHKERRQ(ierr);
+  for (i=0; i<n; i++) order[first+i] = g->label[perm[i]-1];
+  ierr = PetscFree2(xadj,adjncy);CHKERRQ(ierr);
+  ierr = PetscFree5(perm,invp,deg,marker,rchset);CHKERRQ(ierr);
+  ierr = PetscFree3(nbrhd,qsize,qlink);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+    MatGetOrdering_MLND - Find the multilevel nested dissection ordering of a given matrix.
+
+    The subgraphs left to dissect are kept on a stack; they are independent of each other.
+*/
+PETSC_INTERN PetscErrorCode MatGetOrdering_MLND(Mat mat,MatOrderingType type,IS *row,IS *col)
+{
+  const PetscInt *ia,*ja;
+  PetscInt       n,i,k,v,nv,last,*order,*where,*map,nparts[3],top,*stacklast,leafsize = 120,coarsento = 100,ntrials = 4;
+  MLNDGraph      *g,*sub[2],**stack;
+  unsigned long  seed = 7;
+  PetscBool      done;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscOptionsGetInt(((PetscObject)mat)->options,((PetscObject)mat)->prefix,"-mat_ordering_mlnd_leaf_size",&leafsize,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(((PetscObject)mat)->options,((PetscObject)mat)->prefix,"-mat_ordering_mlnd_coarsen_to",&coarsento,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(((PetscObject)mat)->options,((PetscObject)mat)->prefix,"-mat_ordering_mlnd_trials",&ntrials,NULL);CHKERRQ(ierr);
+  leafsize  = PetscMax(leafsize,2);
+  coarsento = PetscMax(coarsento,10);
+  ntrials   = PetscMax(ntrials,1);
+
+  ierr = MatGetRowIJ(mat,0,PETSC_TRUE,PETSC_TRUE,&n,&ia,&ja,&done);CHKERRQ(ierr);
+  if (!done) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_SUP,"Cannot get rows for matrix type %s",((PetscObject)mat)->type_name);
+  for (k=0, v=0; v<n; v++) for (i=ia[v]; i<ia[v+1]; i++) if (ja[i] != v) k++;
+  ierr = MLNDGraphCreate_Private(n,k,PETSC_TRUE,&g);CHKERRQ(ierr);
+  g->xadj[0] = 0; g->tvwgt = n;
+  for (k=0, v=0; v<n; v++) {
+    for (i=ia[v]; i<ia[v+1]; i++) if (ja[i] != v) {g->adjncy[k] = ja[i]; g->adjwgt[k++] = 1;}
+    g->xadj[v+1] = k;
+    g->vwgt[v]   = 1;
+    g->label[v]  = v;
+  }
+  ierr = MatRestoreRowIJ(mat,0,PETSC_TRUE,PETSC_TRUE,NULL,&ia,&ja,&done);CHKERRQ(ierr);
+
+  ierr = PetscMalloc5(n,&order,n,&where,n,&map,n+1,&stack,n+1,&stacklast);CHKERRQ(ierr);
+  top = 0; stack[0] = g; stacklast[0] = n;
+  while (top >= 0) {
+    g    = stack[top];
+    last = stacklast[top--];
+    nv   = g->nvtxs;
+    if (nv > leafsize) {
+      ierr = MLNDBisect_Private(g,coarsento,ntrials,&seed,where);CHKERRQ(ierr);
+      nparts[0] = nparts[1] = nparts[2] = 0;
+      for (v=0; v<nv; v++) nparts[where[v]]++;
+    }
+    if (nv <= leafsize || !nparts[0] || !nparts[1]) {
+      ierr = MLNDLeafOrder_Private(g,last-nv,order);CHKERRQ(ierr);
+      ierr = MLNDGraphDestroy_Private(&g);CHKERRQ(ierr);
+      continue;
+    }
+    /* the separator is numbered last, then part 1 and part 0 */
+    for (k=last-nparts[2], v=0; v<nv; v++) if (where[v] == 2) order[k++] = g->label[v];
+    ierr = MLNDSubgraph_Private(g,where,0,map,&sub[0]);CHKERRQ(ierr);
+    ierr = MLNDSubgraph_Private(g,where,1,map,&sub[1]);CHKERRQ(ierr);
+    ierr = MLNDGraphDestroy_Private(&g);CHKERRQ(ierr);
+    stack[++top] = sub[0]; stacklast[top] = last - nparts[2] - nparts[1];
+    stack[++top] = sub[1]; stacklast[top] = last - nparts[2];
+  }
+
+  ierr = ISCreateGeneral(PETSC_COMM_SELF,n,order,PETSC_COPY_VALUES,row);CHKERRQ(ierr);
+  ierr = ISCreateGeneral(PETSC_COMM_SELF,n,order,PETSC_COPY_VALUES,col);CHKERRQ(ierr);
+  ierr = PetscFree5(order,where,map,stack,stacklast);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
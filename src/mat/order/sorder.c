@@ -134,6 +134,7 @@ $      MATORDERINGND - Nested Dissection
 $      MATORDERING1WD - One-way Dissection
 $      MATORDERINGRCM - Reverse Cuthill-McKee
 $      MATORDERINGQMD - Quotient Minimum Degree
+$      MATORDERINGMLND - Multilevel Nested Dissection
 
    Output Parameters:
 +  rperm - row permutation indices
@@ -170,7 +171,7 @@ PetscErrorCode  MatGetOrdering(Mat mat,MatOrderingType type,IS *rperm,IS *cperm)
   PetscErrorCode ierr;
   PetscInt       mmat,nmat,mis,m;
   PetscErrorCode (*r)(Mat,MatOrderingType,IS*,IS*);
-  PetscBool      flg = PETSC_FALSE,isseqdense,ismpidense,ismpiaij,ismpibaij,ismpisbaij,ismpiaijcusparse,iselemental;
+  PetscBool      flg = PETSC_FALSE,isseqdense,ismpidense,ismpiaij,ismpibaij,ismpisbaij,ismpiaijcusparse,iselemental,ishodlr;
 
   PetscFunctionBegin;
   PetscValidHeaderSpecific(mat,MAT_CLASSID,1);
@@ -218,7 +219,8 @@ PetscErrorCode  MatGetOrdering(Mat mat,MatOrderingType type,IS *rperm,IS *cperm)
   ierr = PetscObjectTypeCompare((PetscObject)mat,MATMPIBAIJ,&ismpibaij);CHKERRQ(ierr);
   ierr = PetscObjectTypeCompare((PetscObject)mat,MATMPISBAIJ,&ismpisbaij);CHKERRQ(ierr);
   ierr = PetscObjectTypeCompare((PetscObject)mat,MATELEMENTAL,&iselemental);CHKERRQ(ierr);
-  if (isseqdense || ismpidense || ismpibaij || ismpisbaij || ismpiaijcusparse || iselemental) {
+  ierr = PetscObjectTypeCompare((PetscObject)mat,MATHODLR,&ishodlr);CHKERRQ(ierr);
+  if (isseqdense || ismpidense || ismpibaij || ismpisbaij || ismpiaijcusparse || iselemental || ishodlr) {
     ierr = MatGetLocalSize(mat,&m,NULL);CHKERRQ(ierr);
     /*
        These matrices only give natural ordering
@@ -0,0 +1,1016 @@
+#include <../src/mat/impls/adj/mpi/mpiadj.h>    /*I "petscmat.h" I*/
+#include <petscsf.h>
+
+/*
+   Native multilevel k-way partitioner.
+
+   The distributed graph is coarsened by heavy edge matching between vertices owned by the same process, so that the
+   coarse vertices stay on the process that owns their fine vertices. The coarsest graph is gathered on every process,
+   which computes a k-way partitioning of it by recursive bisection (greedy graph growing followed by Fiduccia-Mattheyses
+   refinement) with its own random seed; the partitioning with the smallest edge cut is kept. The partitioning is then
+   projected back to the finer graphs and, on every level, improved by parallel label propagation: a boundary vertex is
+   moved to the neighboring part to which it is most strongly connected if this decreases the edge cut and respects the
+   imbalance tolerance. In alternate sweeps only moves to parts with a larger (smaller) number are allowed, so that two
+   neighboring vertices on different processes cannot swap their parts.
+
+   For repartitioning, the current distribution is the starting point: part p is the set of vertices owned by process p.
+   Since the matching is local, this is also a partitioning of every coarse graph, and the coarsest graph is not gathered.
+   On every level the load is first balanced by diffusion: the flow of weight between neighboring parts with the smallest
+   2-norm is the solution of a Laplace equation on the quotient graph, whose vertices are the parts, and it is realized by
+   moving the boundary vertices with the best cut gains, one layer per sweep. The label propagation that follows does not
+   move a vertex away from its process unless this decreases the edge cut, so the migration stays proportional to the
+   imbalance instead of the size of the graph.
+*/
+
+typedef struct {
+  PetscInt  coarsento;  /* coarsening stops when the graph has fewer vertices than this times the number of parts */
+  PetscInt  ntrials;    /* initial bisections tried by each process */
+  PetscInt  nsweeps;    /* maximum number of refinement sweeps on each level */
+  PetscReal imbalance;  /* tolerance for the ratio between the weight of a part and its target weight */
+  PetscBool repartition; /* start from the current distribution and keep the migration small */
+  PetscInt  cut;        /* edge cut of the last partitioning (output) */
+  PetscInt  migration;  /* weight of the vertices assigned to a part other than their process (output) */
+} MatPartitioning_Multilevel;
+
+/* distributed graph, the adjacency uses local numbers with the ghost vertices numbered after the owned ones */
+typedef struct {
+  PetscInt    n,nghost;
+  PetscInt    *xadj,*adjncy,*vwgt,*adjwgt;
+  PetscInt    *ghosts;   /* global numbers of the ghost vertices */
+  PetscLayout map;       /* ownership of the vertices */
+  PetscSF     sf;        /* from the owned vertices to the ghost vertices */
+  PetscInt    *cmap;     /* local vertex of the coarser graph, once the graph has been coarsened */
+} MLGraph;
+
+/* sequential graph, used for the coarsest graph gathered on each process */
+typedef struct {
+  PetscInt n;
+  PetscInt *xadj,*adjncy,*vwgt,*adjwgt;
+  PetscInt *label;       /* vertex of the gathered graph */
+} MLSeqGraph;
+
+/* A small linear congruential generator, so that the partitionings do not depend on the random number implementation */
+PETSC_STATIC_INLINE PetscInt MLRandom(unsigned long *seed,PetscInt n)
+{
+  *seed = (*seed*1103515245UL + 12345UL) & 0x7fffffffUL;
+  return (PetscInt)((*seed >> 4) % (unsigned long)n);
+}
+
+static PetscErrorCode MatPartitioningMultilevel_GraphSetUp(MPI_Comm comm,MLGraph *g)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscLayoutCreate(comm,&g->map);CHKERRQ(ierr);
+  ierr = PetscLayoutSetLocalSize(g->map,g->n);CHKERRQ(ierr);
+  ierr = PetscLayoutSetBlockSize(g->map,1);CHKERRQ(ierr);
+  ierr = PetscLayoutSetUp(g->map);CHKERRQ(ierr);
+  ierr = PetscSFCreate(comm,&g->sf);CHKERRQ(ierr);
+  ierr = PetscSFSetGraphLayout(g->sf,g->map,g->nghost,NULL,PETSC_COPY_VALUES,g->ghosts);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatPartitioningMultilevel_GraphDestroy(MLGraph **g)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (!*g) PetscFunctionReturn(0);
+  ierr = PetscFree4((*g)->xadj,(*g)->adjncy,(*g)->vwgt,(*g)->adjwgt);CHKERRQ(ierr);
+  ierr = PetscFree((*g)->ghosts);CHKERRQ(ierr);
+  ierr = PetscFree((*g)->cmap);CHKERRQ(ierr);
+  ierr = PetscLayoutDestroy(&(*g)->map);CHKERRQ(ierr);
+  ierr = PetscSFDestroy(&(*g)->sf);CHKERRQ(ierr);
+  ierr = PetscFree(*g);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* Builds the distributed graph of an MPIAdj matrix, ignoring the diagonal entries */
+static PetscErrorCode MatPartitioningMultilevel_GraphFromAdj(Mat amat,const PetscInt *vwgt,MLGraph **graph)
+{
+  Mat_MPIAdj     *adj = (Mat_MPIAdj*)amat->data;
+  PetscInt       rstart = amat->rmap->rstart,rend = amat->rmap->rend,n = amat->rmap->n,i,k,c,nedges = 0,ng = 0;
+  MLGraph        *g;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscNew(&g);CHKERRQ(ierr);
+  for (i=0; i<n; i++) for (k=adj->i[i]; k<adj->i[i+1]; k++) if (adj->j[k] != rstart+i) nedges++;
+  g->n = n;
+  ierr = PetscMalloc4(n+1,&g->xadj,PetscMax(nedges,1),&g->adjncy,PetscMax(n,1),&g->vwgt,PetscMax(nedges,1),&g->adjwgt);CHKERRQ(ierr);
+  ierr = PetscMalloc1(PetscMax(nedges,1),&g->ghosts);CHKERRQ(ierr);
+  for (i=0; i<n; i++) {
+    for (k=adj->i[i]; k<adj->i[i+1]; k++) {
+      c = adj->j[k];
+      if (c < rstart || c >= rend) g->ghosts[ng++] = c;
+    }
+  }
+  ierr = PetscSortRemoveDupsInt(&ng,g->ghosts);CHKERRQ(ierr);
+  g->nghost  = ng;
+  g->xadj[0] = 0;
+  for (nedges=0, i=0; i<n; i++) {
+    for (k=adj->i[i]; k<adj->i[i+1]; k++) {
+      c = adj->j[k];
+      if (c == rstart+i) continue;
+      if (c >= rstart && c < rend) g->adjncy[nedges] = c - rstart;
+      else {
+        ierr = PetscFindInt(c,ng,g->ghosts,&g->adjncy[nedges]);CHKERRQ(ierr);
+        g->adjncy[nedges] += n;
+      }
+      g->adjwgt[nedges++] = adj->values ? adj->values[k] : 1;
+    }
+    g->xadj[i+1] = nedges;
+    g->vwgt[i]   = vwgt ? vwgt[i] : 1;
+  }
+  ierr   = MatPartitioningMultilevel_GraphSetUp(PetscObjectComm((PetscObject)amat),g);CHKERRQ(ierr);
+  *graph = g;
+  PetscFunctionReturn(0);
+}
+
+/*
+   Heavy edge matching of the vertices owned by this process, the vertices are visited in random order and each
+   unmatched vertex is matched with the unmatched local neighbor connected by the heaviest edge
+*/
+static PetscErrorCode MatPartitioningMultilevel_Coarsen(MLGraph *g,PetscInt maxvwgt,unsigned long *seed,MLGraph **graph)
+{
+  const PetscInt n = g->n;
+  PetscInt       *perm,*match,*cvtx,*gcmap,*pos,i,k,v,u,c,w,cw,nc,cstart,best,bestw,start,cnt,ng,nedges;
+  MLGraph        *cg;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscMalloc1(PetscMax(n,1),&g->cmap);CHKERRQ(ierr);
+  ierr = PetscMalloc4(PetscMax(n,1),&perm,PetscMax(n,1),&match,PetscMax(n,1),&cvtx,PetscMax(g->nghost,1),&gcmap);CHKERRQ(ierr);
+  for (i=0; i<n; i++) {perm[i] = i; match[i] = -1;}
+  for (i=n-1; i>0; i--) {k = MLRandom(seed,i+1); v = perm[i]; perm[i] = perm[k]; perm[k] = v;}
+  for (i=0; i<n; i++) {
+    v = perm[i];
+    if (match[v] != -1) continue;
+    best = v; bestw = -1;
+    for (k=g->xadj[v]; k<g->xadj[v+1]; k++) {
+      u = g->adjncy[k];
+      if (u < n && match[u] == -1 && g->adjwgt[k] > bestw && g->vwgt[v] + g->vwgt[u] <= maxvwgt) {best = u; bestw = g->adjwgt[k];}
+    }
+    match[v] = best; match[best] = v;
+  }
+  for (nc=0, v=0; v<n; v++) {
+    if (v <= match[v]) {g->cmap[v] = g->cmap[match[v]] = nc; cvtx[nc++] = v;}
+  }
+
+  /* the coarse vertices of the ghosts */
+  ierr = MPI_Scan(&nc,&cstart,1,MPIU_INT,MPI_SUM,PetscObjectComm((PetscObject)g->sf));CHKERRQ(ierr);
+  cstart -= nc;
+  for (v=0; v<n; v++) perm[v] = cstart + g->cmap[v];
+  ierr = PetscSFBcastBegin(g->sf,MPIU_INT,perm,gcmap);CHKERRQ(ierr);
+  ierr = PetscSFBcastEnd(g->sf,MPIU_INT,perm,gcmap);CHKERRQ(ierr);
+
+  ierr = PetscNew(&cg);CHKERRQ(ierr);
+  cg->n = nc;
+  ierr = PetscMalloc1(PetscMax(g->nghost,1),&cg->ghosts);CHKERRQ(ierr);
+  ierr = PetscMemcpy(cg->ghosts,gcmap,g->nghost*sizeof(PetscInt));CHKERRQ(ierr);
+  ng   = g->nghost;
+  ierr = PetscSortRemoveDupsInt(&ng,cg->ghosts);CHKERRQ(ierr);
+  cg->nghost = ng;
+  for (k=0; k<g->nghost; k++) {
+    ierr = PetscFindInt(gcmap[k],ng,cg->ghosts,&i);CHKERRQ(ierr);
+    gcmap[k] = nc + i;
+  }
+
+  /* the edges of a coarse vertex are the merged edges of its fine vertices */
+  nedges = g->xadj[n];
+  ierr = PetscMalloc4(nc+1,&cg->xadj,PetscMax(nedges,1),&cg->adjncy,PetscMax(nc,1),&cg->vwgt,PetscMax(nedges,1),&cg->adjwgt);CHKERRQ(ierr);
+  ierr = PetscMalloc1(nc+ng+1,&pos);CHKERRQ(ierr);
+  for (i=0; i<nc+ng; i++) pos[i] = -1;
+  cg->xadj[0] = 0;
+  for (cnt=0, c=0; c<nc; c++) {
+    start       = cnt;
+    v           = cvtx[c];
+    cg->vwgt[c] = g->vwgt[v] + (match[v] != v ? g->vwgt[match[v]] : 0);
+    for (i=0; i<2; i++) {
+      if (i) {if (match[v] == v) break; v = match[v];}
+      for (k=g->xadj[v]; k<g->xadj[v+1]; k++) {
+        w  = g->adjncy[k];
+        cw = w < n ? g->cmap[w] : gcmap[w-n];
+        if (cw == c) continue;
+        if (pos[cw] >= start) cg->adjwgt[pos[cw]] += g->adjwgt[k];
+        else {pos[cw] = cnt; cg->adjncy[cnt] = cw; cg->adjwgt[cnt++] = g->adjwgt[k];}
+      }
+    }
+    cg->xadj[c+1] = cnt;
+  }
+  ierr = PetscFree(pos);CHKERRQ(ierr);
+  ierr = PetscFree4(perm,match,cvtx,gcmap);CHKERRQ(ierr);
+  ierr = MatPartitioningMultilevel_GraphSetUp(PetscObjectComm((PetscObject)g->sf),cg);CHKERRQ(ierr);
+  *graph = cg;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatPartitioningMultilevel_SeqGraphDestroy(MLSeqGraph **g)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (!*g) PetscFunctionReturn(0);
+  ierr = PetscFree5((*g)->xadj,(*g)->adjncy,(*g)->vwgt,(*g)->adjwgt,(*g)->label);CHKERRQ(ierr);
+  ierr = PetscFree(*g);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* Gathers the distributed graph on every process, with the global vertex numbers */
+static PetscErrorCode MatPartitioningMultilevel_Gather(MLGraph *g,MLSeqGraph **graph)
+{
+  MPI_Comm       comm = PetscObjectComm((PetscObject)g->sf);
+  PetscMPIInt    size,*counts,*displs,*ecounts,*edispls,p,nl,el;
+  PetscInt       N = g->map->N,nedges,i,k,*ladj,*lxadj;
+  MLSeqGraph     *sg;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MPI_Comm_size(comm,&size);CHKERRQ(ierr);
+  ierr = PetscMalloc4(size,&counts,size+1,&displs,size,&ecounts,size+1,&edispls);CHKERRQ(ierr);
+  ierr = PetscMPIIntCast(g->n,&nl);CHKERRQ(ierr);
+  ierr = PetscMPIIntCast(g->xadj[g->n],&el);CHKERRQ(ierr);
+  ierr = MPI_Allgather(&nl,1,MPI_INT,counts,1,MPI_INT,comm);CHKERRQ(ierr);
+  ierr = MPI_Allgather(&el,1,MPI_INT,ecounts,1,MPI_INT,comm);CHKERRQ(ierr);
+  displs[0] = edispls[0] = 0;
+  for (p=0; p<size; p++) {displs[p+1] = displs[p] + counts[p]; edispls[p+1] = edispls[p] + ecounts[p];}
+  nedges = edispls[size];
+
+  ierr = PetscNew(&sg);CHKERRQ(ierr);
+  sg->n = N;
+  ierr = PetscMalloc5(N+1,&sg->xadj,PetscMax(nedges,1),&sg->adjncy,PetscMax(N,1),&sg->vwgt,PetscMax(nedges,1),&sg->adjwgt,PetscMax(N,1),&sg->label);CHKERRQ(ierr);
+  ierr = PetscMalloc2(PetscMax(g->n,1),&lxadj,PetscMax(g->xadj[g->n],1),&ladj);CHKERRQ(ierr);
+  for (i=0; i<g->n; i++) lxadj[i] = g->xadj[i+1] - g->xadj[i];
+  for (k=0; k<g->xadj[g->n]; k++) ladj[k] = g->adjncy[k] < g->n ? g->map->rstart + g->adjncy[k] : g->ghosts[g->adjncy[k]-g->n];
+  ierr = MPI_Allgatherv(lxadj,nl,MPIU_INT,sg->xadj+1,counts,displs,MPIU_INT,comm);CHKERRQ(ierr);
+  ierr = MPI_Allgatherv(g->vwgt,nl,MPIU_INT,sg->vwgt,counts,displs,MPIU_INT,comm);CHKERRQ(ierr);
+  ierr = MPI_Allgatherv(ladj,el,MPIU_INT,sg->adjncy,ecounts,edispls,MPIU_INT,comm);CHKERRQ(ierr);
+  ierr = MPI_Allgatherv(g->adjwgt,el,MPIU_INT,sg->adjwgt,ecounts,edispls,MPIU_INT,comm);CHKERRQ(ierr);
+  sg->xadj[0] = 0;
+  for (i=0; i<N; i++) {sg->xadj[i+1] += sg->xadj[i]; sg->label[i] = i;}
+  ierr = PetscFree2(lxadj,ladj);CHKERRQ(ierr);
+  ierr = PetscFree4(counts,displs,ecounts,edispls);CHKERRQ(ierr);
+  *graph = sg;
+  PetscFunctionReturn(0);
+}
+
+/* Extracts the subgraph induced by the vertices of the given side */
+static PetscErrorCode MatPartitioningMultilevel_SeqSubgraph(MLSeqGraph *g,const PetscInt *where,PetscInt side,PetscInt *map,MLSeqGraph **graph)
+{
+  PetscInt       v,k,u,n = 0,nedges = 0;
+  MLSeqGraph     *s;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  for (v=0; v<g->n; v++) {
+    if (where[v] != side) continue;
+    map[v] = n++;
+    for (k=g->xadj[v]; k<g->xadj[v+1]; k++) if (where[g->adjncy[k]] == side) nedges++;
+  }
+  ierr = PetscNew(&s);CHKERRQ(ierr);
+  s->n = n;
+  ierr = PetscMalloc5(n+1,&s->xadj,PetscMax(nedges,1),&s->adjncy,PetscMax(n,1),&s->vwgt,PetscMax(nedges,1),&s->adjwgt,PetscMax(n,1),&s->label);CHKERRQ(ierr);
+  s->xadj[0] = 0;
+  for (n=0, nedges=0, v=0; v<g->n; v++) {
+    if (where[v] != side) continue;
+    for (k=g->xadj[v]; k<g->xadj[v+1]; k++) {
+      u = g->adjncy[k];
+      if (where[u] == side) {s->adjncy[nedges] = map[u]; s->adjwgt[nedges++] = g->adjwgt[k];}
+    }
+    s->vwgt[n]    = g->vwgt[v];
+    s->label[n++] = g->label[v];
+    s->xadj[n]    = nedges;
+  }
+  *graph = s;
+  PetscFunctionReturn(0);
+}
+
+/*
+   Bisection of a sequential graph: side 0 is grown breadth first from a random vertex until it reaches its target
+   weight, then the cut is improved by FM moves with a lazily updated heap of gains; each pass moves the vertex with
+   the largest gain that keeps both sides within their maximum weight and rolls back to the smallest cut seen
+*/
+static PetscErrorCode MatPartitioningMultilevel_SeqBisect(MLSeqGraph *g,const PetscInt *tpwgt,const PetscInt *maxpwgt,unsigned long *seed,PetscInt *where,PetscInt *pwgt,PetscInt *cut)
+{
+  const PetscInt n = g->n,limit = PetscMax(20,PetscMin(n/20,100));
+  PetscInt       *queue,*id,*ed,*queued,*locked,*moves,head = 0,tail = 0,next,v,u,k,s,t,pass,val,gain,nmoves,nbest,best,bestbal,bal;
+  PetscHeap      heap;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (!n) {pwgt[0] = pwgt[1] = 0; *cut = 0; PetscFunctionReturn(0);}
+  ierr = PetscMalloc6(n,&queue,n,&id,n,&ed,n,&queued,n,&locked,n,&moves);CHKERRQ(ierr);
+  for (v=0; v<n; v++) where[v] = 1;
+  pwgt[0] = 0; pwgt[1] = 0;
+  for (v=0; v<n; v++) pwgt[1] += g->vwgt[v];
+  next = MLRandom(seed,n);
+  while (pwgt[0] < tpwgt[0]) {
+    if (head == tail) { /* start again in another connected component */
+      while (where[next] != 1) next = (next+1)%n;
+      where[next] = -1; queue[tail++] = next;
+    }
+    v = queue[head++];
+    if (pwgt[0] + g->vwgt[v] > maxpwgt[0] && pwgt[0]) {where[v] = 1; break;}
+    where[v] = 0;
+    pwgt[0] += g->vwgt[v]; pwgt[1] -= g->vwgt[v];
+    for (k=g->xadj[v]; k<g->xadj[v+1]; k++) {
+      u = g->adjncy[k];
+      if (where[u] == 1) {where[u] = -1; queue[tail++] = u;}
+    }
+  }
+  for (k=head; k<tail; k++) if (where[queue[k]] == -1) where[queue[k]] = 1;
+
+  ierr = PetscHeapCreate(2*g->xadj[n]+n,&heap);CHKERRQ(ierr);
+  for (pass=0; pass<8; pass++) {
+    *cut = 0;
+    for (v=0; v<n; v++) {
+      id[v] = ed[v] = 0; locked[v] = 0; queued[v] = PETSC_MIN_INT;
+      for (k=g->xadj[v]; k<g->xadj[v+1]; k++) {
+        if (where[g->adjncy[k]] == where[v]) id[v] += g->adjwgt[k];
+        else ed[v] += g->adjwgt[k];
+      }
+      *cut += ed[v];
+      if (ed[v] > 0) {queued[v] = ed[v]-id[v]; ierr = PetscHeapAdd(heap,v,id[v]-ed[v]);CHKERRQ(ierr);}
+    }
+    *cut   /= 2;
+    best    = *cut;
+    bestbal = PetscMax(pwgt[0]-maxpwgt[0],pwgt[1]-maxpwgt[1]);
+    nmoves  = nbest = 0;
+    while (PETSC_TRUE) {
+      ierr = PetscHeapPop(heap,&v,&val);CHKERRQ(ierr);
+      if (v < 0) break;
+      if (locked[v] || queued[v] != -val) continue; /* stale entry */
+      queued[v] = PETSC_MIN_INT;
+      s = where[v]; t = 1-s;
+      if (pwgt[t] + g->vwgt[v] > maxpwgt[t] && pwgt[s] <= maxpwgt[s]) continue;
+      gain      = ed[v] - id[v];
+      where[v]  = t; locked[v] = 1;
+      pwgt[s]  -= g->vwgt[v]; pwgt[t] += g->vwgt[v];
+      *cut     -= gain;
+      k = id[v]; id[v] = ed[v]; ed[v] = k;
+      moves[nmoves++] = v;
+      for (k=g->xadj[v]; k<g->xadj[v+1]; k++) {
+        u = g->adjncy[k];
+        if (where[u] == t) {id[u] += g->adjwgt[k]; ed[u] -= g->adjwgt[k];}
+        else               {id[u] -= g->adjwgt[k]; ed[u] += g->adjwgt[k];}
+        if (!locked[u] && ed[u] > 0 && queued[u] != ed[u]-id[u]) {
+          queued[u] = ed[u]-id[u];
+          ierr = PetscHeapAdd(heap,u,id[u]-ed[u]);CHKERRQ(ierr);
+        }
+      }
+      bal = PetscMax(pwgt[0]-maxpwgt[0],pwgt[1]-maxpwgt[1]);
+      if ((bal <= 0 && bestbal <= 0 && *cut < best) || (bestbal > 0 && bal < bestbal)) {best = *cut; bestbal = bal; nbest = nmoves;}
+      else if (nmoves - nbest > limit) break;
+    }
+    do {ierr = PetscHeapPop(heap,&v,&val);CHKERRQ(ierr);} while (v >= 0);
+    while (nmoves > nbest) {
+      v = moves[--nmoves]; t = where[v]; s = 1-t;
+      where[v] = s; pwgt[t] -= g->vwgt[v]; pwgt[s] += g->vwgt[v];
+    }
+    *cut = best;
+    if (!nbest) break;
+  }
+  ierr = PetscHeapDestroy(&heap);CHKERRQ(ierr);
+  ierr = PetscFree6(queue,id,ed,queued,locked,moves);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* Recursive bisection of a sequential graph into the parts first, first+1, ..., first+nparts-1 */
+static PetscErrorCode MatPartitioningMultilevel_SeqPartition(MLSeqGraph *g,PetscInt first,PetscInt nparts,const PetscReal *tpwgts,PetscReal ub,PetscInt ntrials,unsigned long *seed,PetscInt *part)
+{
+  PetscInt       *where,*twhere,*map,v,trial,tvwgt = 0,pwgt[2],tpwgt[2],maxpwgt[2],cut = 0,bestcut = PETSC_MAX_INT,bestbal = PETSC_MAX_INT,bal,n0,i;
+  PetscReal      frac0 = 0.0,total = 0.0;
+  MLSeqGraph     *sub;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (nparts == 1 || !g->n) {
+    for (v=0; v<g->n; v++) part[g->label[v]] = first;
+    PetscFunctionReturn(0);
+  }
+  n0 = nparts/2;
+  for (i=0; i<nparts; i++) total += tpwgts[i];
+  for (i=0; i<n0; i++) frac0 += tpwgts[i];
+  frac0 /= total;
+  for (v=0; v<g->n; v++) tvwgt += g->vwgt[v];
+  tpwgt[0]   = (PetscInt)(frac0*tvwgt + 0.5);
+  tpwgt[1]   = tvwgt - tpwgt[0];
+  maxpwgt[0] = (PetscInt)(ub*tpwgt[0]);
+  maxpwgt[1] = (PetscInt)(ub*tpwgt[1]);
+
+  ierr = PetscMalloc3(g->n,&where,g->n,&twhere,g->n,&map);CHKERRQ(ierr);
+  for (trial=0; trial<ntrials; trial++) {
+    ierr = MatPartitioningMultilevel_SeqBisect(g,tpwgt,maxpwgt,seed,twhere,pwgt,&cut);CHKERRQ(ierr);
+    bal  = PetscMax(0,PetscMax(pwgt[0]-maxpwgt[0],pwgt[1]-maxpwgt[1]));
+    if (bal < bestbal || (bal == bestbal && cut < bestcut)) {
+      bestbal = bal; bestcut = cut;
+      ierr = PetscMemcpy(where,twhere,g->n*sizeof(PetscInt));CHKERRQ(ierr);
+    }
+  }
+  for (i=0; i<2; i++) {
+    ierr = MatPartitioningMultilevel_SeqSubgraph(g,where,i,map,&sub);CHKERRQ(ierr);
+    ierr = MatPartitioningMultilevel_SeqPartition(sub,i ? first+n0 : first,i ? nparts-n0 : n0,i ? tpwgts+n0 : tpwgts,ub,ntrials,seed,part);CHKERRQ(ierr);
+    ierr = MatPartitioningMultilevel_SeqGraphDestroy(&sub);CHKERRQ(ierr);
+  }
+  ierr = PetscFree3(where,twhere,map);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* Edge cut of the partitioning of the distributed graph, the ghost entries of part[] must be up to date */
+static PetscErrorCode MatPartitioningMultilevel_EdgeCut(MLGraph *g,const PetscInt *part,PetscInt *cut)
+{
+  PetscInt       v,k,lcut = 0;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  for (v=0; v<g->n; v++) {
+    for (k=g->xadj[v]; k<g->xadj[v+1]; k++) if (part[g->adjncy[k]] != part[v]) lcut += g->adjwgt[k];
+  }
+  ierr = MPIU_Allreduce(&lcut,cut,1,MPIU_INT,MPI_SUM,PetscObjectComm((PetscObject)g->sf));CHKERRQ(ierr);
+  *cut /= 2;
+  PetscFunctionReturn(0);
+}
+
+/*
+   Parallel refinement by label propagation. Each process may only use its share of the room left in a part during a
+   sweep, so the part weights can only exceed their maximum if they already did; vertices of such parts are moved to
+   the neighboring part with room even if the edge cut increases. If home is not negative, it is the part of the process
+   that owns the vertices, which they leave only if this decreases the edge cut.
+*/
+static PetscErrorCode MatPartitioningMultilevel_Refine(MLGraph *g,PetscInt nparts,const PetscInt *tpwgt,const PetscInt *maxpwgt,PetscInt nsweeps,PetscInt home,PetscInt *part)
+{
+  MPI_Comm       comm = PetscObjectComm((PetscObject)g->sf);
+  PetscMPIInt    size;
+  PetscInt       *pwgt,*delta,*conn,*touched,*inflow,*outflow,sweep,v,k,p,q,own,ntouched,best,bestgain,gain,nmoved,gmoved,idle = 0;
+  PetscBool      over;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MPI_Comm_size(comm,&size);CHKERRQ(ierr);
+  ierr = PetscMalloc6(nparts,&pwgt,nparts,&delta,nparts,&conn,nparts,&touched,nparts,&inflow,nparts,&outflow);CHKERRQ(ierr);
+  for (p=0; p<nparts; p++) {delta[p] = 0; conn[p] = 0;}
+  for (v=0; v<g->n; v++) delta[part[v]] += g->vwgt[v];
+  ierr = MPIU_Allreduce(delta,pwgt,nparts,MPIU_INT,MPI_SUM,comm);CHKERRQ(ierr);
+  for (sweep=0; sweep<nsweeps; sweep++) {
+    for (p=0; p<nparts; p++) inflow[p] = outflow[p] = 0;
+    for (nmoved=0, v=0; v<g->n; v++) {
+      own  = part[v];
+      over = (PetscBool)(pwgt[own] > maxpwgt[own]);
+      for (ntouched=0, k=g->xadj[v]; k<g->xadj[v+1]; k++) {
+        q = part[g->adjncy[k]];
+        if (!conn[q]) touched[ntouched++] = q;
+        conn[q] += g->adjwgt[k];
+      }
+      best = -1; bestgain = PETSC_MIN_INT;
+      for (k=0; k<ntouched; k++) {
+        q = touched[k];
+        if (q == own) continue;
+        if (inflow[q] + g->vwgt[v] > (maxpwgt[q] - pwgt[q])/size) continue; /* no room left for this process */
+        gain = conn[q] - conn[own];
+        if (over) {
+          if (outflow[own] + g->vwgt[v] > (pwgt[own] - tpwgt[own])/size) continue;
+        } else {
+          if ((sweep%2 == 0 && q < own) || (sweep%2 == 1 && q > own)) continue;
+          if (gain < 0 || (!gain && q != home && pwgt[own] - outflow[own] <= pwgt[q] + inflow[q] + g->vwgt[v])) continue;
+          if (!gain && own == home) continue; /* when repartitioning, a vertex leaves its process only to decrease the cut */
+        }
+        if (gain > bestgain) {best = q; bestgain = gain;}
+      }
+      for (k=0; k<ntouched; k++) conn[touched[k]] = 0;
+      if (best < 0) continue;
+      part[v]          = best;
+      inflow[best]    += g->vwgt[v];
+      outflow[own]    += g->vwgt[v];
+      nmoved++;
+    }
+    for (p=0; p<nparts; p++) delta[p] = inflow[p] - outflow[p];
+    ierr = MPIU_Allreduce(MPI_IN_PLACE,delta,nparts,MPIU_INT,MPI_SUM,comm);CHKERRQ(ierr);
+    for (p=0; p<nparts; p++) pwgt[p] += delta[p];
+    ierr = PetscSFBcastBegin(g->sf,MPIU_INT,part,part+g->n);CHKERRQ(ierr);
+    ierr = PetscSFBcastEnd(g->sf,MPIU_INT,part,part+g->n);CHKERRQ(ierr);
+    ierr = MPIU_Allreduce(&nmoved,&gmoved,1,MPIU_INT,MPI_SUM,comm);CHKERRQ(ierr);
+    idle = gmoved ? 0 : idle+1;
+    if (idle == 2) break; /* no moves in either direction */
+  }
+  ierr = PetscFree6(pwgt,delta,conn,touched,inflow,outflow);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   Diffusive load balancing for repartitioning. The flow between the parts is computed redundantly on every process by
+   conjugate gradients on the Laplacian of the quotient graph, which is stored densely since there is one part per
+   process. In each sweep every process moves its share of the remaining flow between two parts, in proportion to its
+   boundary vertices that could carry it, starting with the vertices with the largest cut gains.
+*/
+static PetscErrorCode MatPartitioningMultilevel_Diffuse(MLGraph *g,PetscInt nparts,const PetscReal *tpwgts,const PetscInt *maxpwgt,PetscInt nsweeps,PetscInt *part)
+{
+  MPI_Comm       comm = PetscObjectComm((PetscObject)g->sf);
+  PetscInt       *pwgt,*qconn,*qxadj,*qadj,*flow,*quota,*moved,*conn,*touched,*cv,*cq,*key,*perm,sweep,it,v,c,e,k,p,q,own,ntouched,ncand,best,bestgain,gain,nmoved,remaining;
+  PetscReal      *b,*x,*r,*d,*ad,tvwgt = 0.0,mean = 0.0,rr = 0.0,rr0,rrnew,dad,alpha;
+  PetscBool      over = PETSC_FALSE;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscCalloc1(nparts,&pwgt);CHKERRQ(ierr);
+  for (v=0; v<g->n; v++) pwgt[part[v]] += g->vwgt[v];
+  ierr = MPIU_Allreduce(MPI_IN_PLACE,pwgt,nparts,MPIU_INT,MPI_SUM,comm);CHKERRQ(ierr);
+  for (p=0; p<nparts; p++) if (pwgt[p] > maxpwgt[p]) over = PETSC_TRUE;
+  if (!over) {
+    ierr = PetscFree(pwgt);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+
+  /* the quotient graph */
+  ierr = PetscCalloc3(nparts*nparts,&qconn,nparts*nparts,&flow,nparts*nparts,&moved);CHKERRQ(ierr);
+  ierr = PetscMalloc2(nparts*nparts,&quota,nparts+1,&qxadj);CHKERRQ(ierr);
+  for (v=0; v<g->n; v++) {
+    for (k=g->xadj[v]; k<g->xadj[v+1]; k++) if (part[g->adjncy[k]] != part[v]) qconn[part[v]*nparts+part[g->adjncy[k]]] = 1;
+  }
+  ierr = MPIU_Allreduce(MPI_IN_PLACE,qconn,nparts*nparts,MPIU_INT,MPI_MAX,comm);CHKERRQ(ierr);
+  for (qxadj[0]=0, p=0; p<nparts; p++) {
+    for (qxadj[p+1]=qxadj[p], q=0; q<nparts; q++) qxadj[p+1] += qconn[p*nparts+q];
+  }
+  ierr = PetscMalloc1(qxadj[nparts]+1,&qadj);CHKERRQ(ierr);
+  for (k=0, p=0; p<nparts; p++) {
+    for (q=0; q<nparts; q++) if (qconn[p*nparts+q]) qadj[k++] = q;
+  }
+
+  /* the flow with the smallest 2-norm that removes the excess weights solves L x = excess */
+  ierr = PetscMalloc5(nparts,&b,nparts,&x,nparts,&r,nparts,&d,nparts,&ad);CHKERRQ(ierr);
+  for (p=0; p<nparts; p++) tvwgt += pwgt[p];
+  for (p=0; p<nparts; p++) {b[p] = pwgt[p] - tpwgts[p]*tvwgt; mean += b[p];}
+  for (p=0; p<nparts; p++) {
+    b[p] -= mean/nparts;
+    x[p]  = 0.0; r[p] = d[p] = b[p];
+    rr   += b[p]*b[p];
+  }
+  for (rr0=rr, it=0; it<10*nparts && rr > 1.e-16*rr0; it++) {
+    for (dad=0.0, p=0; p<nparts; p++) {
+      for (ad[p]=(qxadj[p+1]-qxadj[p])*d[p], k=qxadj[p]; k<qxadj[p+1]; k++) ad[p] -= d[qadj[k]];
+      dad += d[p]*ad[p];
+    }
+    if (dad <= 0.0) break;
+    alpha = rr/dad;
+    for (rrnew=0.0, p=0; p<nparts; p++) {
+      x[p]  += alpha*d[p];
+      r[p]  -= alpha*ad[p];
+      rrnew += r[p]*r[p];
+    }
+    for (p=0; p<nparts; p++) d[p] = r[p] + (rrnew/rr)*d[p];
+    rr = rrnew;
+  }
+  for (p=0; p<nparts; p++) {
+    for (k=qxadj[p]; k<qxadj[p+1]; k++) if (x[p] - x[qadj[k]] >= 0.5) flow[p*nparts+qadj[k]] = (PetscInt)(x[p] - x[qadj[k]] + 0.5);
+  }
+  ierr = PetscFree5(b,x,r,d,ad);CHKERRQ(ierr);
+
+  /* move the boundary vertices along the flow */
+  ierr = PetscCalloc2(nparts,&conn,nparts,&touched);CHKERRQ(ierr);
+  ierr = PetscMalloc4(g->n+1,&cv,g->n+1,&cq,g->n+1,&key,g->n+1,&perm);CHKERRQ(ierr);
+  for (sweep=0; sweep<10*nsweeps; sweep++) {
+    ierr = PetscMemzero(quota,nparts*nparts*sizeof(PetscInt));CHKERRQ(ierr);
+    for (ncand=0, v=0; v<g->n; v++) {
+      own = part[v];
+      for (ntouched=0, k=g->xadj[v]; k<g->xadj[v+1]; k++) {
+        q = part[g->adjncy[k]];
+        if (!conn[q]) touched[ntouched++] = q;
+        conn[q] += g->adjwgt[k];
+      }
+      best = -1; bestgain = PETSC_MIN_INT;
+      for (k=0; k<ntouched; k++) {
+        q = touched[k];
+        if (q == own || !flow[own*nparts+q]) continue;
+        gain = conn[q] - conn[own];
+        if (gain > bestgain) {best = q; bestgain = gain;}
+      }
+      for (k=0; k<ntouched; k++) conn[touched[k]] = 0;
+      if (best < 0) continue;
+      cv[ncand] = v; cq[ncand] = best; key[ncand] = -bestgain; perm[ncand] = ncand; ncand++;
+      quota[own*nparts+best] += g->vwgt[v];
+    }
+    ierr = MPIU_Allreduce(quota,moved,nparts*nparts,MPIU_INT,MPI_SUM,comm);CHKERRQ(ierr);
+    for (e=0; e<nparts*nparts; e++) {
+      quota[e] = moved[e] ? (PetscInt)PetscCeilReal(((PetscReal)flow[e])*quota[e]/moved[e]) : 0;
+      moved[e] = 0;
+    }
+    ierr = PetscSortIntWithArray(ncand,key,perm);CHKERRQ(ierr);
+    for (c=0; c<ncand; c++) {
+      v = cv[perm[c]]; e = part[v]*nparts+cq[perm[c]];
+      if (moved[e] >= quota[e]) continue;
+      part[v]   = cq[perm[c]];
+      moved[e] += g->vwgt[v];
+    }
+    ierr = MPIU_Allreduce(MPI_IN_PLACE,moved,nparts*nparts,MPIU_INT,MPI_SUM,comm);CHKERRQ(ierr);
+    for (nmoved=0, remaining=0, e=0; e<nparts*nparts; e++) {
+      flow[e]    = PetscMax(0,flow[e]-moved[e]);
+      nmoved    += moved[e];
+      remaining += flow[e];
+    }
+    ierr = PetscSFBcastBegin(g->sf,MPIU_INT,part,part+g->n);CHKERRQ(ierr);
+    ierr = PetscSFBcastEnd(g->sf,MPIU_INT,part,part+g->n);CHKERRQ(ierr);
+    if (!nmoved || !remaining) break;
+  }
+  ierr = PetscFree4(cv,cq,key,perm);CHKERRQ(ierr);
+  ierr = PetscFree2(conn,touched);CHKERRQ(ierr);
+  ierr = PetscFree(qadj);CHKERRQ(ierr);
+  ierr = PetscFree2(quota,qxadj);CHKERRQ(ierr);
+  ierr = PetscFree3(qconn,flow,moved);CHKERRQ(ierr);
+  ierr = PetscFree(pwgt);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatPartitioningApply_Multilevel(MatPartitioning part,IS *partitioning)
+{
+  MatPartitioning_Multilevel *ml = (MatPartitioning_Multilevel*)part->data;
+  Mat                        mat = part->adj,amat;
+  MPI_Comm                   comm;
+  PetscMPIInt                rank,size;
+  PetscBool                  flg,repartition;
+  PetscInt                   bs = 1,nparts = part->n,nlevels = 1,l,i,j,p,v,tvwgt,maxvwgt,*tpwgt,*maxpwgt,*pwgt,*locals,*cpart,*fpart,*gpart,cut,bal,key,gkey,winner,home;
+  PetscReal                  *tpwgts,total = 0.0;
+  MLGraph                    *graphs[64];
+  MLSeqGraph                 *sg;
+  unsigned long              seed;
+  PetscErrorCode             ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectGetComm((PetscObject)part,&comm);CHKERRQ(ierr);
+  ierr = MPI_Comm_rank(comm,&rank);CHKERRQ(ierr);
+  ierr = MPI_Comm_size(comm,&size);CHKERRQ(ierr);
+  ierr = PetscObjectTypeCompare((PetscObject)mat,MATMPIADJ,&flg);CHKERRQ(ierr);
+  if (flg) {
+    amat = mat;
+    ierr = PetscObjectReference((PetscObject)amat);CHKERRQ(ierr);
+  } else {
+    /* bs indicates if the converted matrix is "reduced" from the original and hence the
+       resulting partition results need to be stretched to match the original matrix */
+    ierr = MatConvert(mat,MATMPIADJ,MAT_INITIAL_MATRIX,&amat);CHKERRQ(ierr);
+    if (amat->rmap->n > 0) bs = mat->rmap->n/amat->rmap->n;
+  }
+  seed = 1 + 7919UL*(unsigned long)rank;
+  repartition = ml->repartition;
+  if (repartition) {
+    if (nparts != size) SETERRQ2(comm,PETSC_ERR_ARG_INCOMP,"Repartitioning needs one part per process, not %D parts on %d processes",nparts,size);
+    /* the load cannot diffuse to a process without vertices, for instance before a serial mesh is distributed */
+    ierr = MPIU_Allreduce(&amat->rmap->n,&i,1,MPIU_INT,MPI_MIN,comm);CHKERRQ(ierr);
+    if (!i) {
+      ierr = PetscInfo(part,"Some processes own no vertices, partitioning from scratch instead of repartitioning\n");CHKERRQ(ierr);
+      repartition = PETSC_FALSE;
+    }
+  }
+
+  /* target weights of the parts */
+  ierr = MatPartitioningMultilevel_GraphFromAdj(amat,part->vertex_weights,&graphs[0]);CHKERRQ(ierr);
+  for (tvwgt=0, maxvwgt=0, v=0; v<graphs[0]->n; v++) {tvwgt += graphs[0]->vwgt[v]; maxvwgt = PetscMax(maxvwgt,graphs[0]->vwgt[v]);}
+  ierr = MPIU_Allreduce(MPI_IN_PLACE,&tvwgt,1,MPIU_INT,MPI_SUM,comm);CHKERRQ(ierr);
+  ierr = MPIU_Allreduce(MPI_IN_PLACE,&maxvwgt,1,MPIU_INT,MPI_MAX,comm);CHKERRQ(ierr);
+  ierr = PetscMalloc3(nparts,&tpwgts,nparts,&tpwgt,nparts,&maxpwgt);CHKERRQ(ierr);
+  for (p=0; p<nparts; p++) {tpwgts[p] = part->part_weights ? part->part_weights[p] : 1.0; total += tpwgts[p];}
+  for (p=0; p<nparts; p++) {
+    tpwgts[p] /= total;
+    tpwgt[p]   = (PetscInt)(tpwgts[p]*tvwgt);
+    maxpwgt[p] = PetscMax((PetscInt)(ml->imbalance*tpwgts[p]*tvwgt),tpwgt[p] + maxvwgt);
+  }
+
+  /* coarsening */
+  while (graphs[nlevels-1]->map->N > ml->coarsento*nparts && nlevels < 64) {
+    MLGraph *fine = graphs[nlevels-1],*coarse = NULL;
+
+    ierr = MatPartitioningMultilevel_Coarsen(fine,PetscMax(1,(3*tvwgt)/(2*ml->coarsento*nparts)),&seed,&coarse);CHKERRQ(ierr);
+    if (20*coarse->map->N > 19*fine->map->N) { /* the matching stalled */
+      ierr = MatPartitioningMultilevel_GraphDestroy(&coarse);CHKERRQ(ierr);
+      ierr = PetscFree(fine->cmap);CHKERRQ(ierr);
+      break;
+    }
+    graphs[nlevels++] = coarse;
+  }
+
+  l    = nlevels-1;
+  ierr = PetscMalloc1(graphs[l]->n+graphs[l]->nghost+1,&cpart);CHKERRQ(ierr);
+  if (repartition) {
+    /* the current distribution is the initial partitioning of every level */
+    for (v=0; v<graphs[l]->n; v++) cpart[v] = rank;
+  } else {
+    /* every process partitions the coarsest graph, the partitioning with the smallest cut is kept */
+    ierr = MatPartitioningMultilevel_Gather(graphs[l],&sg);CHKERRQ(ierr);
+    ierr = PetscMalloc1(PetscMax(sg->n,1),&gpart);CHKERRQ(ierr);
+    ierr = MatPartitioningMultilevel_SeqPartition(sg,0,nparts,tpwgts,PetscMax(1.0,1.0 + (ml->imbalance-1.0)/2),ml->ntrials,&seed,gpart);CHKERRQ(ierr);
+    ierr = PetscCalloc1(nparts,&pwgt);CHKERRQ(ierr);
+    for (cut=0, v=0; v<sg->n; v++) {
+      pwgt[gpart[v]] += sg->vwgt[v];
+      for (j=sg->xadj[v]; j<sg->xadj[v+1]; j++) if (gpart[sg->adjncy[j]] != gpart[v]) cut += sg->adjwgt[j];
+    }
+    for (bal=0, p=0; p<nparts; p++) bal += PetscMax(0,pwgt[p]-maxpwgt[p]);
+    ierr = PetscFree(pwgt);CHKERRQ(ierr);
+    ierr = MPIU_Allreduce(&bal,&gkey,1,MPIU_INT,MPI_MIN,comm);CHKERRQ(ierr);
+    key  = bal == gkey ? cut/2 : PETSC_MAX_INT;
+    ierr = MPIU_Allreduce(&key,&gkey,1,MPIU_INT,MPI_MIN,comm);CHKERRQ(ierr);
+    key  = gkey == key ? rank : size;
+    ierr = MPIU_Allreduce(&key,&winner,1,MPIU_INT,MPI_MIN,comm);CHKERRQ(ierr);
+    ierr = MPI_Bcast(gpart,sg->n,MPIU_INT,(PetscMPIInt)winner,comm);CHKERRQ(ierr);
+    for (v=0; v<graphs[l]->n; v++) cpart[v] = gpart[graphs[l]->map->rstart+v];
+    ierr = PetscFree(gpart);CHKERRQ(ierr);
+    ierr = MatPartitioningMultilevel_SeqGraphDestroy(&sg);CHKERRQ(ierr);
+  }
+
+  /* uncoarsening, with refinement on every level */
+  home = repartition ? rank : -1;
+  ierr = PetscSFBcastBegin(graphs[l]->sf,MPIU_INT,cpart,cpart+graphs[l]->n);CHKERRQ(ierr);
+  ierr = PetscSFBcastEnd(graphs[l]->sf,MPIU_INT,cpart,cpart+graphs[l]->n);CHKERRQ(ierr);
+  if (repartition) {ierr = MatPartitioningMultilevel_Diffuse(graphs[l],nparts,tpwgts,maxpwgt,ml->nsweeps,cpart);CHKERRQ(ierr);}
+  ierr = MatPartitioningMultilevel_Refine(graphs[l],nparts,tpwgt,maxpwgt,ml->nsweeps,home,cpart);CHKERRQ(ierr);
+  for (l=nlevels-2; l>=0; l--) {
+    MLGraph *fine = graphs[l];
+
+    ierr = PetscMalloc1(fine->n+fine->nghost+1,&fpart);CHKERRQ(ierr);
+    for (v=0; v<fine->n; v++) fpart[v] = cpart[fine->cmap[v]];
+    ierr = PetscFree(cpart);CHKERRQ(ierr);
+    ierr = MatPartitioningMultilevel_GraphDestroy(&graphs[l+1]);CHKERRQ(ierr);
+    ierr = PetscSFBcastBegin(fine->sf,MPIU_INT,fpart,fpart+fine->n);CHKERRQ(ierr);
+    ierr = PetscSFBcastEnd(fine->sf,MPIU_INT,fpart,fpart+fine->n);CHKERRQ(ierr);
+    if (repartition) {ierr = MatPartitioningMultilevel_Diffuse(fine,nparts,tpwgts,maxpwgt,ml->nsweeps,fpart);CHKERRQ(ierr);}
+    ierr = MatPartitioningMultilevel_Refine(fine,nparts,tpwgt,maxpwgt,ml->nsweeps,home,fpart);CHKERRQ(ierr);
+    cpart = fpart;
+  }
+  ierr = MatPartitioningMultilevel_EdgeCut(graphs[0],cpart,&ml->cut);CHKERRQ(ierr);
+  for (ml->migration=0, v=0; v<graphs[0]->n; v++) if (cpart[v] != rank) ml->migration += graphs[0]->vwgt[v];
+  ierr = MPIU_Allreduce(MPI_IN_PLACE,&ml->migration,1,MPIU_INT,MPI_SUM,comm);CHKERRQ(ierr);
+
+  ierr = PetscMalloc1(bs*amat->rmap->n,&locals);CHKERRQ(ierr);
+  for (i=0; i<amat->rmap->n; i++) for (j=0; j<bs; j++) locals[bs*i+j] = cpart[i];
+  ierr = ISCreateGeneral(comm,bs*amat->rmap->n,locals,PETSC_OWN_POINTER,partitioning);CHKERRQ(ierr);
+  ierr = PetscFree(cpart);CHKERRQ(ierr);
+  ierr = MatPartitioningMultilevel_GraphDestroy(&graphs[0]);CHKERRQ(ierr);
+  ierr = PetscFree3(tpwgts,tpwgt,maxpwgt);CHKERRQ(ierr);
+  ierr = MatDestroy(&amat);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatPartitioningView_Multilevel(MatPartitioning part,PetscViewer viewer)
+{
+  MatPartitioning_Multilevel *ml = (MatPartitioning_Multilevel*)part->data;
+  PetscErrorCode             ierr;
+  PetscBool                  iascii;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectTypeCompare((PetscObject)viewer,PETSCVIEWERASCII,&iascii);CHKERRQ(ierr);
+  if (iascii) {
+    ierr = PetscViewerASCIIPrintf(viewer,"  Coarsening to %D vertices per part, %D initial bisection trials per process\n",ml->coarsento,ml->ntrials);CHKERRQ(ierr);
+    ierr = PetscViewerASCIIPrintf(viewer,"  Imbalance tolerance %g, at most %D refinement sweeps per level\n",(double)ml->imbalance,ml->nsweeps);CHKERRQ(ierr);
+    if (ml->repartition) {ierr = PetscViewerASCIIPrintf(viewer,"  Repartitioning the current distribution by diffusion\n");CHKERRQ(ierr);}
+    ierr = PetscViewerASCIIPrintf(viewer,"  Edge cut %D, migration %D\n",ml->cut,ml->migration);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+/*@
+   MatPartitioningMultilevelSetImbalance - Sets the tolerance on the load imbalance of the multilevel partitioner
+
+   Logically Collective on MatPartitioning
+
+   Input Parameters:
++  part - the partitioning context
+-  imbalance - the largest allowed ratio between the weight of a part and its target weight, at least 1.0
+
+   Options Database Keys:
+.  -mat_partitioning_multilevel_imbalance <imbalance> - the tolerance (default 1.05)
+
+   Level: advanced
+
+.seealso: MATPARTITIONINGMULTILEVEL, MatPartitioningMultilevelGetEdgeCut()
+@*/
+PetscErrorCode MatPartitioningMultilevelSetImbalance(MatPartitioning part,PetscReal imbalance)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(part,MAT_PARTITIONING_CLASSID,1);
+  PetscValidLogicalCollectiveReal(part,imbalance,2);
+  ierr = PetscTryMethod(part,"MatPartitioningMultilevelSetImbalance_C",(MatPartitioning,PetscReal),(part,imbalance));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatPartitioningMultilevelSetImbalance_Multilevel(MatPartitioning part,PetscReal imbalance)
+{
+  MatPartitioning_Multilevel *ml = (MatPartitioning_Multilevel*)part->data;
+
+  PetscFunctionBegin;
+  if (imbalance < 1.0) SETERRQ1(PetscObjectComm((PetscObject)part),PETSC_ERR_ARG_OUTOFRANGE,"Imbalance tolerance %g must be at least 1.0",(double)imbalance);
+  ml->imbalance = imbalance;
+  PetscFunctionReturn(0);
+}
+
+/*@
+   MatPartitioningMultilevelGetEdgeCut - Returns the edge cut of the last partitioning computed by the multilevel partitioner
+
+   Not Collective
+
+   Input Parameter:
+.  part - the partitioning context
+
+   Output Parameter:
+.  cut - the sum of the weights of the edges between different parts
+
+   Level: advanced
+
+.seealso: MATPARTITIONINGMULTILEVEL, MatPartitioningMultilevelSetImbalance(), MatPartitioningMultilevelGetMigration()
+@*/
+PetscErrorCode MatPartitioningMultilevelGetEdgeCut(MatPartitioning part,PetscInt *cut)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(part,MAT_PARTITIONING_CLASSID,1);
+  PetscValidIntPointer(cut,2);
+  ierr = PetscUseMethod(part,"MatPartitioningMultilevelGetEdgeCut_C",(MatPartitioning,PetscInt*),(part,cut));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatPartitioningMultilevelGetEdgeCut_Multilevel(MatPartitioning part,PetscInt *cut)
+{
+  MatPartitioning_Multilevel *ml = (MatPartitioning_Multilevel*)part->data;
+
+  PetscFunctionBegin;
+  *cut = ml->cut;
+  PetscFunctionReturn(0);
+}
+
+/*@
+   MatPartitioningMultilevelSetRepartition - Makes the multilevel partitioner rebalance the current distribution instead of
+   partitioning the graph from scratch
+
+   Logically Collective on MatPartitioning
+
+   Input Parameters:
++  part - the partitioning context
+-  flg - PETSC_TRUE to repartition
+
+   Options Database Keys:
+.  -mat_partitioning_multilevel_repartition - repartition the current distribution
+
+   Notes:
+   Part p initially holds the vertices owned by process p, so the number of parts must be the number of processes.
+   The load is balanced by diffusion between neighboring parts on every level of the multilevel hierarchy, and vertices
+   leave their process during the refinement only if this decreases the edge cut. The migration is thus proportional
+   to the imbalance of the current distribution, which makes this suitable for redistributing a mesh after adaptive
+   refinement; the expected migration is returned by MatPartitioningMultilevelGetMigration().
+
+   Level: advanced
+
+.seealso: MATPARTITIONINGMULTILEVEL, MatPartitioningMultilevelGetMigration(), MatPartitioningParmetisSetRepartition()
+@*/
+PetscErrorCode MatPartitioningMultilevelSetRepartition(MatPartitioning part,PetscBool flg)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(part,MAT_PARTITIONING_CLASSID,1);
+  PetscValidLogicalCollectiveBool(part,flg,2);
+  ierr = PetscTryMethod(part,"MatPartitioningMultilevelSetRepartition_C",(MatPartitioning,PetscBool),(part,flg));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatPartitioningMultilevelSetRepartition_Multilevel(MatPartitioning part,PetscBool flg)
+{
+  MatPartitioning_Multilevel *ml = (MatPartitioning_Multilevel*)part->data;
+
+  PetscFunctionBegin;
+  ml->repartition = flg;
+  PetscFunctionReturn(0);
+}
+
+/*@
+   MatPartitioningMultilevelGetMigration - Returns the weight of the vertices that the last partitioning computed by
+   the multilevel partitioner assigns to a part other than the process that owns them
+
+   Not Collective
+
+   Input Parameter:
+.  part - the partitioning context
+
+   Output Parameter:
+.  migration - the sum of the weights of the vertices whose part differs from their process
+
+   Notes:
+   With one part per process this is the amount of data, measured by the vertex weights, that is moved when the
+   partitioning is used to redistribute the graph.
+
+   Level: advanced
+
+.seealso: MATPARTITIONINGMULTILEVEL, MatPartitioningMultilevelSetRepartition(), MatPartitioningMultilevelGetEdgeCut()
+@*/
+PetscErrorCode MatPartitioningMultilevelGetMigration(MatPartitioning part,PetscInt *migration)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(part,MAT_PARTITIONING_CLASSID,1);
+  PetscValidIntPointer(migration,2);
+  ierr = PetscUseMethod(part,"MatPartitioningMultilevelGetMigration_C",(MatPartitioning,PetscInt*),(part,migration));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatPartitioningMultilevelGetMigration_Multilevel(MatPartitioning part,PetscInt *migration)
+{
+  MatPartitioning_Multilevel *ml = (MatPartitioning_Multilevel*)part->data;
+
+  PetscFunctionBegin;
+  *migration = ml->migration;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatPartitioningSetFromOptions_Multilevel(PetscOptionItems *PetscOptionsObject,MatPartitioning part)
+{
+  MatPartitioning_Multilevel *ml = (MatPartitioning_Multilevel*)part->data;
+  PetscReal                  imbalance = ml->imbalance;
+  PetscBool                  flg;
+  PetscErrorCode             ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscOptionsHead(PetscOptionsObject,"Multilevel partitioning options");CHKERRQ(ierr);
+  ierr = PetscOptionsReal("-mat_partitioning_multilevel_imbalance","Largest allowed ratio between the weight of a part and its target","MatPartitioningMultilevelSetImbalance",imbalance,&imbalance,&flg);CHKERRQ(ierr);
+  if (flg) {ierr = MatPartitioningMultilevelSetImbalance(part,imbalance);CHKERRQ(ierr);}
+  ierr = PetscOptionsInt("-mat_partitioning_multilevel_coarsen_to","Number of vertices per part below which coarsening stops","None",ml->coarsento,&ml->coarsento,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-mat_partitioning_multilevel_trials","Number of initial bisections tried by each process","None",ml->ntrials,&ml->ntrials,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-mat_partitioning_multilevel_sweeps","Maximum number of refinement sweeps on each level","None",ml->nsweeps,&ml->nsweeps,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-mat_partitioning_multilevel_repartition","Rebalance the current distribution with little migration","MatPartitioningMultilevelSetRepartition",ml->repartition,&ml->repartition,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsTail();CHKERRQ(ierr);
+  ml->coarsento = PetscMax(ml->coarsento,1);
+  ml->ntrials   = PetscMax(ml->ntrials,1);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatPartitioningDestroy_Multilevel(MatPartitioning part)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectComposeFunction((PetscObject)part,"MatPartitioningMultilevelSetImbalance_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)part,"MatPartitioningMultilevelGetEdgeCut_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)part,"MatPartitioningMultilevelSetRepartition_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)part,"MatPartitioningMultilevelGetMigration_C",NULL);CHKERRQ(ierr);
+  ierr = PetscFree(part->data);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*MC
+   MATPARTITIONINGMULTILEVEL - A native parallel multilevel k-way graph partitioner that does not need any external package
+
+   Collective on MPI_Comm
+
+   Options Database Keys:
++  -mat_partitioning_multilevel_imbalance <1.05> - largest allowed ratio between the weight of a part and its target weight
+.  -mat_partitioning_multilevel_coarsen_to <20> - coarsening stops when the graph has fewer vertices than this times the number of parts
+.  -mat_partitioning_multilevel_trials <4> - number of initial bisections tried by each process on the coarsest graph
+.  -mat_partitioning_multilevel_sweeps <8> - maximum number of refinement sweeps on each level
+-  -mat_partitioning_multilevel_repartition - rebalance the current distribution by diffusion instead of partitioning from scratch
+
+   Level: beginner
+
+   Notes:
+    The graph is coarsened by heavy edge matching of the vertices owned by the same process. The coarsest graph is
+    gathered on every process and partitioned by recursive bisection; the partitioning is then projected back and
+    refined on every level by parallel label propagation, which respects the vertex weights and the imbalance tolerance.
+    The target part weights set with MatPartitioningSetPartitionWeights() are honored and the edge weights are taken
+    from the values of the MATMPIADJ matrix.
+
+    With MatPartitioningMultilevelSetRepartition() the current distribution is rebalanced with a migration proportional
+    to its imbalance, see MatPartitioningMultilevelGetMigration(). DMPlexDistribute() uses this with the options
+    -petscpartitioner_type matpartitioning -mat_partitioning_type multilevel -mat_partitioning_multilevel_repartition
+
+    Select it with -mat_partitioning_type multilevel; MATPARTITIONINGCURRENT remains the default when PETSc is
+    configured without ParMETIS, Chaco, Party or PT-Scotch.
+
+.keywords: Partitioning, create, context
+
+.seealso: MatPartitioningSetType(), MatPartitioningType, MatPartitioningMultilevelSetImbalance(), MatPartitioningMultilevelGetEdgeCut(),
+          MatPartitioningMultilevelSetRepartition(), MatPartitioningMultilevelGetMigration()
+M*/
+
+PETSC_EXTERN PetscErrorCode MatPartitioningCreate_Multilevel(MatPartitioning part)
+{
+  MatPartitioning_Multilevel *ml;
+  PetscErrorCode             ierr;
+
+  PetscFunctionBegin;
+  ierr       = PetscNewLog(part,&ml);CHKERRQ(ierr);
+  part->data = (void*)ml;
+
+  ml->coarsento   = 20;
+  ml->ntrials     = 4;
+  ml->nsweeps     = 8;
+  ml->imbalance   = 1.05;
+  ml->repartition = PETSC_FALSE;
+  ml->cut         = 0;
+  ml->migration   = 0;
+
+  part->ops->apply          = MatPartitioningApply_Multilevel;
+  part->ops->view           = MatPartitioningView_Multilevel;
+  part->ops->destroy        = MatPartitioningDestroy_Multilevel;
+  part->ops->setfromoptions = MatPartitioningSetFromOptions_Multilevel;
+  ierr = PetscObjectComposeFunction((PetscObject)part,"MatPartitioningMultilevelSetImbalance_C",MatPartitioningMultilevelSetImbalance_Multilevel);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)part,"MatPartitioningMultilevelGetEdgeCut_C",MatPartitioningMultilevelGetEdgeCut_Multilevel);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)part,"MatPartitioningMultilevelSetRepartition_C",MatPartitioningMultilevelSetRepartition_Multilevel);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)part,"MatPartitioningMultilevelGetMigration_C",MatPartitioningMultilevelGetMigration_Multilevel);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
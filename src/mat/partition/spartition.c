@@ -7,6 +7,7 @@ PETSC_EXTERN PetscErrorCode MatPartitioningCreate_Average(MatPartitioning part);
 PETSC_EXTERN PetscErrorCode MatPartitioningCreate_Square(MatPartitioning);
 PETSC_EXTERN PetscErrorCode MatPartitioningCreate_Parmetis(MatPartitioning);
 PETSC_EXTERN PetscErrorCode MatPartitioningCreate_Hierarchical(MatPartitioning);
+PETSC_EXTERN PetscErrorCode MatPartitioningCreate_Multilevel(MatPartitioning);
 #if defined(PETSC_HAVE_CHACO)
 PETSC_EXTERN PetscErrorCode MatPartitioningCreate_Chaco(MatPartitioning);
 #endif
@@ -51,6 +52,7 @@ PetscErrorCode  MatPartitioningRegisterAll(void)
   ierr = MatPartitioningRegister(MATPARTITIONINGAVERAGE, MatPartitioningCreate_Average);CHKERRQ(ierr);
   ierr = MatPartitioningRegister(MATPARTITIONINGSQUARE,  MatPartitioningCreate_Square);CHKERRQ(ierr);
   ierr = MatPartitioningRegister(MATPARTITIONINGHIERARCH,MatPartitioningCreate_Hierarchical);CHKERRQ(ierr);
+  ierr = MatPartitioningRegister(MATPARTITIONINGMULTILEVEL,MatPartitioningCreate_Multilevel);CHKERRQ(ierr);
 #if defined(PETSC_HAVE_PARMETIS)
   ierr = MatPartitioningRegister(MATPARTITIONINGPARMETIS,MatPartitioningCreate_Parmetis);CHKERRQ(ierr);
 #endif
@@ -1374,6 +1374,20 @@ int main(int argc, char **argv)
     requires: triangle
     args: -run_type full -refinement_limit 0.0    -bc_type dirichlet -interpolate 1 -petscspace_order 1 -snes_converged_reason ::ascii_info_detail
 
+  # Cell blocks of PetscFE: the residual and Jacobian must not depend on the number of cells integrated together,
+  # 15 cells leave a partial block for the default and for 4 blocks
+  testset:
+    output_file: output/ex12_fe_blocks.out
+    args: -run_type test -simplex 0 -cells 5,3 -interpolate 1 -bc_type dirichlet -variable_coefficient nonlinear -petscspace_order 1 -petscspace_poly_tensor
+    test:
+      suffix: fe_blocks_1
+      args: -petscfe_num_blocks 1
+    test:
+      suffix: fe_blocks_default
+    test:
+      suffix: fe_blocks_4
+      args: -petscfe_num_blocks 4
+
   # 2D serial P1 test with field bc
   test:
     suffix: field_bc_p1_0
@@ -1576,6 +1590,10 @@ int main(int argc, char **argv)
     requires: p4est
     args: -run_type test -refinement_limit 0.0 -simplex 0 -interpolate -bc_type dirichlet -petscspace_order 1 -dm_forest_initial_refinement 1 -dm_forest_minimum_refinement 0 -dim 3 -dm_plex_convert_type p8est -cells 2,2,2
 
+  test:
+    suffix: tensor_plex_3d_threaded
+    args: -run_type test -refinement_limit 0.0 -simplex 0 -interpolate -bc_type dirichlet -petscspace_order 1 -dim 3 -dm_refine_hierarchy 1 -cells 2,2,2 -dm_plex_threaded_assembly
+
   test:
     suffix: p4est_test_q2_conformal_serial
     requires: p4est
@@ -533,6 +533,31 @@ int main(int argc, char **argv)
   test:
     suffix: 2d_q3_0
     args: -simplex 0 -potential_petscspace_order 3 -dm_refine 2 -num_refine 3 -snes_convergence_estimate
+  # Threaded assembly adds the element vectors by closure colors even on one thread, so it needs neither openmp nor threadsafety
+  testset:
+    output_file: output/ex13_2d_q2_threaded.out
+    args: -simplex 0 -potential_petscspace_order 2 -dm_refine 3 -snes_monitor_short -snes_converged_reason -ksp_type preonly -pc_type lu
+    test:
+      suffix: 2d_q2_serial
+    test:
+      suffix: 2d_q2_threaded
+      args: -dm_plex_threaded_assembly
+  test:
+    suffix: 2d_q2_threaded_coloring
+    args: -simplex 0 -potential_petscspace_order 2 -dm_refine 3 -ksp_type preonly -pc_type lu -dm_plex_threaded_assembly -info
+    filter: grep -E "Closure coloring|plain gather"
+  # Cell blocks of PetscFE: 15 cells leave a partial block for the default of 8 and for 4 blocks
+  testset:
+    output_file: output/ex13_2d_q2_fe_blocks.out
+    args: -simplex 0 -cells 5,3 -potential_petscspace_order 2 -snes_monitor_short -snes_converged_reason -ksp_type preonly -pc_type lu
+    test:
+      suffix: 2d_q2_fe_blocks_1
+      args: -potential_petscfe_num_blocks 1
+    test:
+      suffix: 2d_q2_fe_blocks_default
+    test:
+      suffix: 2d_q2_fe_blocks_4
+      args: -potential_petscfe_num_blocks 4
   test:
     suffix: 3d_p1_0
     requires: ctetgen
@@ -942,4 +942,12 @@ PetscErrorCode NonlinearGS(SNES snes,Vec X, Vec B, void *ctx)
      nsize: 4
      args: -snes_converged_reason -ksp_converged_reason -da_grid_x 129 -da_grid_y 129 -pc_type mg -pc_mg_levels 8 -mg_levels_ksp_type chebyshev -mg_levels_ksp_chebyshev_esteig 0,0.5,0,1.1 -mg_levels_ksp_max_it 2
 
+   test:
+     suffix: mg_cheby_fourth
+     args: -snes_converged_reason -ksp_converged_reason -da_refine 3 -par 6 -pc_type mg -pc_mg_levels 4 -mg_levels_ksp_chebyshev_kind fourth
+
+   test:
+     suffix: mg_cheby_refine
+     args: -snes_converged_reason -ksp_converged_reason -da_refine 3 -par 6 -pc_type mg -pc_mg_levels 4 -mg_levels_ksp_chebyshev_esteig_refine 2
+
 TEST*/
@@ -4,6 +4,9 @@
 #include <petscblaslapack.h>
 #include <petsc/private/petscimpl.h>
 #include <petsc/private/petscfeimpl.h>
+#if defined(_OPENMP) && defined(PETSC_HAVE_THREADSAFETY)
+#include <omp.h>
+#endif
 
 static PetscErrorCode ISGetPointRange(IS pointIS, PetscInt *pStart, PetscInt *pEnd, const PetscInt **points)
 {
@@ -149,6 +152,151 @@ PetscErrorCode DMInterpolationAddPoints(DMInterpolationInfo ctx, PetscInt n, Pet
   PetscFunctionReturn(0);
 }
 
+/*
+  Each point is only sent to the ranks whose local bounding box contains it, through a single PetscSF whose leaves are
+  the pairs (point, candidate rank) and whose roots are the points received by each candidate. A point is owned by the
+  lowest rank which locates it, and each rank stores its points ordered by the sending rank and then the local number,
+  which is the order of the global point numbering.
+*/
+static PetscErrorCode DMInterpolationSetUp_Distributed_Private(DMInterpolationInfo ctx, DM dm)
+{
+  MPI_Comm           comm = ctx->comm;
+  const PetscInt     dim  = ctx->dim;
+  PetscSF            sf, cellSF = NULL;
+  PetscSFNode       *remote;
+  const PetscSFNode *foundCells;
+  const PetscInt    *foundPoints;
+  MPI_Datatype       pointType;
+  Vec                coordsLocal, pointVec;
+  const PetscScalar *coords;
+  PetscScalar       *rootPoints, *a;
+  PetscReal          lbox[6], *gbox, *leafCoords, *rootCoords, tol = 0.0;
+  PetscMPIInt        rank, size, r, *sendCounts, *recvCounts, *sendOffsets, *recvOffsets;
+  PetscInt           cdim, N, nleaves, nroots, numFound, *leafOff, *leafFlags, *rootFlags, *rootCells, p, l, i, d;
+  PetscInt           nMissing = 0, gMissing;
+  PetscErrorCode     ierr;
+
+  PetscFunctionBegin;
+  ierr = MPI_Comm_size(comm, &size);CHKERRQ(ierr);
+  ierr = MPI_Comm_rank(comm, &rank);CHKERRQ(ierr);
+  ierr = DMGetCoordinateDim(dm, &cdim);CHKERRQ(ierr);
+  if (cdim != dim) SETERRQ2(comm, PETSC_ERR_ARG_WRONG, "Point dimension %D must be the mesh coordinate dimension %D", dim, cdim);
+  /* Exchange the bounding boxes of the local coordinates */
+  ierr = DMGetCoordinatesLocal(dm, &coordsLocal);CHKERRQ(ierr);
+  ierr = VecGetLocalSize(coordsLocal, &N);CHKERRQ(ierr);
+  ierr = VecGetArrayRead(coordsLocal, &coords);CHKERRQ(ierr);
+  for (d = 0; d < dim; ++d) {lbox[d] = PETSC_MAX_REAL; lbox[dim+d] = PETSC_MIN_REAL;}
+  for (i = 0; i < N; i += dim) {
+    for (d = 0; d < dim; ++d) {
+      lbox[d]     = PetscMin(lbox[d],     PetscRealPart(coords[i+d]));
+      lbox[dim+d] = PetscMax(lbox[dim+d], PetscRealPart(coords[i+d]));
+    }
+  }
+  ierr = VecRestoreArrayRead(coordsLocal, &coords);CHKERRQ(ierr);
+  if (N) {
+    for (d = 0; d < dim; ++d) tol = PetscMax(tol, lbox[dim+d] - lbox[d]);
+    tol *= PETSC_SQRT_MACHINE_EPSILON;
+    for (d = 0; d < dim; ++d) {lbox[d] -= tol; lbox[dim+d] += tol;}
+  }
+  ierr = PetscMalloc5(size*2*dim, &gbox, size, &sendCounts, size, &recvCounts, size, &sendOffsets, size, &recvOffsets);CHKERRQ(ierr);
+  ierr = MPI_Allgather(lbox, 2*dim, MPIU_REAL, gbox, 2*dim, MPIU_REAL, comm);CHKERRQ(ierr);
+  /* Count the candidate ranks for the points, and find where our points go in their receive buffers */
+  ierr = PetscMalloc1(ctx->nInput+1, &leafOff);CHKERRQ(ierr);
+  for (r = 0; r < size; ++r) sendCounts[r] = 0;
+  for (p = 0, nleaves = 0; p < ctx->nInput; ++p) {
+    const PetscReal *x = &ctx->points[p*dim];
+
+    leafOff[p] = nleaves;
+    for (r = 0; r < size; ++r) {
+      for (d = 0; d < dim; ++d) if ((x[d] < gbox[r*2*dim+d]) || (x[d] > gbox[r*2*dim+dim+d])) break;
+      if (d == dim) {++sendCounts[r]; ++nleaves;}
+    }
+  }
+  leafOff[ctx->nInput] = nleaves;
+  ierr = MPI_Alltoall(sendCounts, 1, MPI_INT, recvCounts, 1, MPI_INT, comm);CHKERRQ(ierr);
+  for (r = 0, nroots = 0; r < size; ++r) {recvOffsets[r] = (PetscMPIInt) nroots; nroots += recvCounts[r];}
+  ierr = MPI_Alltoall(recvOffsets, 1, MPI_INT, sendOffsets, 1, MPI_INT, comm);CHKERRQ(ierr);
+  ierr = PetscMalloc1(nleaves, &remote);CHKERRQ(ierr);
+  ierr = PetscMalloc2(nleaves*dim, &leafCoords, nleaves, &leafFlags);CHKERRQ(ierr);
+  for (p = 0, l = 0; p < ctx->nInput; ++p) {
+    const PetscReal *x = &ctx->points[p*dim];
+
+    for (r = 0; r < size; ++r) {
+      for (d = 0; d < dim; ++d) if ((x[d] < gbox[r*2*dim+d]) || (x[d] > gbox[r*2*dim+dim+d])) break;
+      if (d < dim) continue;
+      remote[l].rank  = r;
+      remote[l].index = sendOffsets[r]++;
+      for (d = 0; d < dim; ++d) leafCoords[l*dim+d] = x[d];
+      ++l;
+    }
+  }
+  ierr = PetscSFCreate(comm, &sf);CHKERRQ(ierr);
+  ierr = PetscSFSetGraph(sf, nroots, nleaves, NULL, PETSC_OWN_POINTER, remote, PETSC_OWN_POINTER);CHKERRQ(ierr);
+  /* Send the points to the candidates, which locate them */
+  ierr = PetscMalloc4(nroots*dim, &rootCoords, nroots*dim, &rootPoints, nroots, &rootFlags, nroots, &rootCells);CHKERRQ(ierr);
+  ierr = MPI_Type_contiguous(dim, MPIU_REAL, &pointType);CHKERRQ(ierr);
+  ierr = MPI_Type_commit(&pointType);CHKERRQ(ierr);
+  ierr = PetscSFReduceBegin(sf, pointType, leafCoords, rootCoords, MPIU_REPLACE);CHKERRQ(ierr);
+  ierr = PetscSFReduceEnd(sf, pointType, leafCoords, rootCoords, MPIU_REPLACE);CHKERRQ(ierr);
+  ierr = MPI_Type_free(&pointType);CHKERRQ(ierr);
+  for (i = 0; i < nroots*dim; ++i) rootPoints[i] = rootCoords[i];
+  ierr = VecCreateSeqWithArray(PETSC_COMM_SELF, dim, nroots*dim, rootPoints, &pointVec);CHKERRQ(ierr);
+  ierr = DMLocatePoints(dm, pointVec, DM_POINTLOCATION_REMOVE, &cellSF);CHKERRQ(ierr);
+  ierr = PetscSFGetGraph(cellSF, NULL, &numFound, &foundPoints, &foundCells);CHKERRQ(ierr);
+  for (i = 0; i < nroots; ++i) rootCells[i] = -1;
+  for (i = 0; i < numFound; ++i) if (foundCells[i].index >= 0) rootCells[foundPoints ? foundPoints[i] : i] = foundCells[i].index;
+  for (i = 0; i < nroots; ++i) rootFlags[i] = rootCells[i] >= 0 ? 1 : 0;
+  ierr = PetscSFDestroy(&cellSF);CHKERRQ(ierr);
+  ierr = VecDestroy(&pointVec);CHKERRQ(ierr);
+  /* Let the lowest rank which located each point own it, the candidates of a point are in increasing rank order */
+  ierr = PetscSFBcastBegin(sf, MPIU_INT, rootFlags, leafFlags);CHKERRQ(ierr);
+  ierr = PetscSFBcastEnd(sf, MPIU_INT, rootFlags, leafFlags);CHKERRQ(ierr);
+  for (p = 0; p < ctx->nInput; ++p) {
+    PetscBool owned = PETSC_FALSE;
+
+    for (l = leafOff[p]; l < leafOff[p+1]; ++l) {
+      if (leafFlags[l] && !owned) owned = PETSC_TRUE;
+      else leafFlags[l] = 0;
+    }
+    if (!owned) ++nMissing;
+  }
+  /* Only the rank holding an unlocated point knows about it, so agree on the failure before raising it collectively */
+  ierr = MPIU_Allreduce(&nMissing, &gMissing, 1, MPIU_INT, MPI_SUM, comm);CHKERRQ(ierr);
+  if (gMissing) {
+    for (p = 0; p < ctx->nInput; ++p) {
+      const PetscReal *x = &ctx->points[p*dim];
+
+      for (l = leafOff[p]; l < leafOff[p+1]; ++l) if (leafFlags[l]) break;
+      if (l < leafOff[p+1]) continue;
+      ierr = PetscSynchronizedFPrintf(comm, PETSC_STDERR, "[%d] Point %D: %g %g %g not located in mesh\n", rank, p, (double) x[0], (double) (dim > 1 ? x[1] : 0.0), (double) (dim > 2 ? x[2] : 0.0));CHKERRQ(ierr);
+    }
+    ierr = PetscSynchronizedFlush(comm, PETSC_STDERR);CHKERRQ(ierr);
+    SETERRQ1(comm, PETSC_ERR_PLIB, "%D points not located in mesh", gMissing);
+  }
+  ierr = PetscSFReduceBegin(sf, MPIU_INT, leafFlags, rootFlags, MPIU_REPLACE);CHKERRQ(ierr);
+  ierr = PetscSFReduceEnd(sf, MPIU_INT, leafFlags, rootFlags, MPIU_REPLACE);CHKERRQ(ierr);
+  /* Create coordinates vector and array of owned cells */
+  for (i = 0, ctx->n = 0; i < nroots; ++i) if (rootFlags[i]) ++ctx->n;
+  ierr = PetscMalloc1(ctx->n, &ctx->cells);CHKERRQ(ierr);
+  ierr = VecCreate(comm, &ctx->coords);CHKERRQ(ierr);
+  ierr = VecSetSizes(ctx->coords, ctx->n*dim, PETSC_DECIDE);CHKERRQ(ierr);
+  ierr = VecSetBlockSize(ctx->coords, dim);CHKERRQ(ierr);
+  ierr = VecSetType(ctx->coords, VECSTANDARD);CHKERRQ(ierr);
+  ierr = VecGetArray(ctx->coords, &a);CHKERRQ(ierr);
+  for (i = 0, l = 0; i < nroots; ++i) {
+    if (!rootFlags[i]) continue;
+    for (d = 0; d < dim; ++d) a[l*dim+d] = rootCoords[i*dim+d];
+    ctx->cells[l++] = rootCells[i];
+  }
+  ierr = VecRestoreArray(ctx->coords, &a);CHKERRQ(ierr);
+  ierr = PetscSFDestroy(&sf);CHKERRQ(ierr);
+  ierr = PetscFree4(rootCoords, rootPoints, rootFlags, rootCells);CHKERRQ(ierr);
+  ierr = PetscFree2(leafCoords, leafFlags);CHKERRQ(ierr);
+  ierr = PetscFree(leafOff);CHKERRQ(ierr);
+  ierr = PetscFree5(gbox, sendCounts, recvCounts, sendOffsets, recvOffsets);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 PetscErrorCode DMInterpolationSetUp(DMInterpolationInfo ctx, DM dm, PetscBool redundantPoints)
 {
   MPI_Comm          comm = ctx->comm;
@@ -158,47 +306,26 @@ PetscErrorCode DMInterpolationSetUp(DMInterpolationInfo ctx, DM dm, PetscBool re
   PetscErrorCode    ierr;
   Vec               pointVec;
   PetscSF           cellSF;
-  PetscLayout       layout;
   PetscReal         *globalPoints;
   PetscScalar       *globalPointsScalar;
-  const PetscInt    *ranges;
-  PetscMPIInt       *counts, *displs;
   const PetscSFNode *foundCells;
   const PetscInt    *foundPoints;
   PetscMPIInt       *foundProcs, *globalProcs;
-  PetscInt          n, N, numFound;
+  PetscInt          *globalCells;
+  PetscInt          N, numFound;
 
   PetscFunctionBegin;
   PetscValidHeaderSpecific(dm, DM_CLASSID, 1);
   ierr = MPI_Comm_size(comm, &size);CHKERRQ(ierr);
   ierr = MPI_Comm_rank(comm, &rank);CHKERRQ(ierr);
   if (ctx->dim < 0) SETERRQ(comm, PETSC_ERR_ARG_WRONGSTATE, "The spatial dimension has not been set");
-  /* Locate points */
-  n = ctx->nInput;
   if (!redundantPoints) {
-    ierr = PetscLayoutCreate(comm, &layout);CHKERRQ(ierr);
-    ierr = PetscLayoutSetBlockSize(layout, 1);CHKERRQ(ierr);
-    ierr = PetscLayoutSetLocalSize(layout, n);CHKERRQ(ierr);
-    ierr = PetscLayoutSetUp(layout);CHKERRQ(ierr);
-    ierr = PetscLayoutGetSize(layout, &N);CHKERRQ(ierr);
-    /* Communicate all points to all processes */
-    ierr = PetscMalloc3(N*ctx->dim,&globalPoints,size,&counts,size,&displs);CHKERRQ(ierr);
-    ierr = PetscLayoutGetRanges(layout, &ranges);CHKERRQ(ierr);
-    for (p = 0; p < size; ++p) {
-      counts[p] = (ranges[p+1] - ranges[p])*ctx->dim;
-      displs[p] = ranges[p]*ctx->dim;
-    }
-    ierr = MPI_Allgatherv(ctx->points, n*ctx->dim, MPIU_REAL, globalPoints, counts, displs, MPIU_REAL, comm);CHKERRQ(ierr);
-  } else {
-    N = n;
-    globalPoints = ctx->points;
-    counts = displs = NULL;
-    layout = NULL;
-  }
-#if 0
-  ierr = PetscMalloc3(N,&foundCells,N,&foundProcs,N,&globalProcs);CHKERRQ(ierr);
-  /* foundCells[p] = m->locatePoint(&globalPoints[p*ctx->dim]); */
-#else
+    ierr = DMInterpolationSetUp_Distributed_Private(ctx, dm);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  /* Every process has all the points, so locate them locally */
+  N = ctx->nInput;
+  globalPoints = ctx->points;
 #if defined(PETSC_USE_COMPLEX)
   ierr = PetscMalloc1(N*ctx->dim,&globalPointsScalar);CHKERRQ(ierr);
   for (i=0; i<N*ctx->dim; i++) globalPointsScalar[i] = globalPoints[i];
@@ -206,14 +333,16 @@ PetscErrorCode DMInterpolationSetUp(DMInterpolationInfo ctx, DM dm, PetscBool re
   globalPointsScalar = globalPoints;
 #endif
   ierr = VecCreateSeqWithArray(PETSC_COMM_SELF, ctx->dim, N*ctx->dim, globalPointsScalar, &pointVec);CHKERRQ(ierr);
-  ierr = PetscMalloc2(N,&foundProcs,N,&globalProcs);CHKERRQ(ierr);
-  for (p = 0; p < N; ++p) {foundProcs[p] = size;}
+  ierr = PetscMalloc3(N,&foundProcs,N,&globalProcs,N,&globalCells);CHKERRQ(ierr);
+  for (p = 0; p < N; ++p) {foundProcs[p] = size; globalCells[p] = -1;}
   cellSF = NULL;
   ierr = DMLocatePoints(dm, pointVec, DM_POINTLOCATION_REMOVE, &cellSF);CHKERRQ(ierr);
   ierr = PetscSFGetGraph(cellSF,NULL,&numFound,&foundPoints,&foundCells);CHKERRQ(ierr);
-#endif
   for (p = 0; p < numFound; ++p) {
-    if (foundCells[p].index >= 0) foundProcs[foundPoints ? foundPoints[p] : p] = rank;
+    if (foundCells[p].index >= 0) {
+      foundProcs[foundPoints ? foundPoints[p] : p]  = rank;
+      globalCells[foundPoints ? foundPoints[p] : p] = foundCells[p].index;
+    }
   }
   /* Let the lowest rank process own each point */
   ierr   = MPIU_Allreduce(foundProcs, globalProcs, N, MPI_INT, MPI_MIN, comm);CHKERRQ(ierr);
@@ -234,21 +363,15 @@ PetscErrorCode DMInterpolationSetUp(DMInterpolationInfo ctx, DM dm, PetscBool re
       PetscInt d;
 
       for (d = 0; d < ctx->dim; ++d, ++i) a[i] = globalPoints[p*ctx->dim+d];
-      ctx->cells[q] = foundCells[q].index;
+      ctx->cells[q] = globalCells[p];
       ++q;
     }
   }
   ierr = VecRestoreArray(ctx->coords, &a);CHKERRQ(ierr);
-#if 0
-  ierr = PetscFree3(foundCells,foundProcs,globalProcs);CHKERRQ(ierr);
-#else
-  ierr = PetscFree2(foundProcs,globalProcs);CHKERRQ(ierr);
+  ierr = PetscFree3(foundProcs,globalProcs,globalCells);CHKERRQ(ierr);
   ierr = PetscSFDestroy(&cellSF);CHKERRQ(ierr);
   ierr = VecDestroy(&pointVec);CHKERRQ(ierr);
-#endif
   if ((void*)globalPointsScalar != (void*)globalPoints) {ierr = PetscFree(globalPointsScalar);CHKERRQ(ierr);}
-  if (!redundantPoints) {ierr = PetscFree3(globalPoints,counts,displs);CHKERRQ(ierr);}
-  ierr = PetscLayoutDestroy(&layout);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -1397,6 +1520,348 @@ static PetscErrorCode ISIntersect_Caching(IS is1, IS is2, IS *isect)
   PetscFunctionReturn(0);
 }
 
+/********************* Threaded Assembly **************************/
+
+/* Returns the number of threads integrating cells, which is one unless PETSc routines may be called from OpenMP threads */
+static PetscErrorCode DMPlexGetAssemblyThreads_Private(DM dm, PetscInt numCells, PetscInt *nt)
+{
+  PetscBool      threaded;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = DMPlexGetThreadedAssembly(dm, &threaded);CHKERRQ(ierr);
+  *nt  = 1;
+#if defined(_OPENMP) && defined(PETSC_HAVE_THREADSAFETY)
+  if (threaded) *nt = PetscMax(1, PetscMin(omp_get_max_threads(), numCells));
+#endif
+  PetscFunctionReturn(0);
+}
+
+/* Creates a PetscDS with the equations of prob but its own work arrays, so that another thread can integrate with it */
+static PetscErrorCode PetscDSCreateThreadCopy_Private(PetscDS prob, PetscDS *tprob)
+{
+  PetscInt       dimEmbed, Nf, f;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  *tprob = NULL;
+  if (!prob) PetscFunctionReturn(0);
+  ierr = PetscDSCreate(PETSC_COMM_SELF, tprob);CHKERRQ(ierr);
+  ierr = PetscDSGetNumFields(prob, &Nf);CHKERRQ(ierr);
+  for (f = 0; f < Nf; ++f) {
+    PetscObject disc;
+    PetscBool   implicit;
+
+    ierr = PetscDSGetDiscretization(prob, f, &disc);CHKERRQ(ierr);
+    ierr = PetscDSSetDiscretization(*tprob, f, disc);CHKERRQ(ierr);
+    ierr = PetscDSGetImplicit(prob, f, &implicit);CHKERRQ(ierr);
+    ierr = PetscDSSetImplicit(*tprob, f, implicit);CHKERRQ(ierr);
+  }
+  ierr = PetscDSGetCoordinateDimension(prob, &dimEmbed);CHKERRQ(ierr);
+  ierr = PetscDSSetCoordinateDimension(*tprob, dimEmbed);CHKERRQ(ierr);
+  ierr = PetscDSCopyEquations(prob, *tprob);CHKERRQ(ierr);
+  ierr = PetscDSCopyConstants(prob, *tprob);CHKERRQ(ierr);
+  ierr = PetscDSSetUp(*tprob);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* Checks whether the PetscDS cached on the DM were copied from prob and probAux with the same discretizations */
+static PetscErrorCode DMPlexThreadDSValid_Private(DM dm, PetscDS prob, PetscDS probAux, PetscInt nt, PetscBool *valid)
+{
+  DM_Plex       *mesh = (DM_Plex *) dm->data;
+  PetscDS        probs[2], tprobs[2];
+  PetscInt       i, Nf, Ng, f;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  *valid = PETSC_FALSE;
+  if (mesh->numThreadDS < nt || mesh->threadDS[0] != prob || mesh->threadDSAux[0] != probAux) PetscFunctionReturn(0);
+  probs[0] = prob; probs[1] = probAux;
+  tprobs[0] = mesh->threadDS[1]; tprobs[1] = mesh->threadDSAux[1];
+  for (i = 0; i < 2; ++i) {
+    if (!probs[i]) continue;
+    ierr = PetscDSGetNumFields(probs[i], &Nf);CHKERRQ(ierr);
+    ierr = PetscDSGetNumFields(tprobs[i], &Ng);CHKERRQ(ierr);
+    if (Nf != Ng) PetscFunctionReturn(0);
+    for (f = 0; f < Nf; ++f) {
+      PetscObject disc, tdisc;
+
+      ierr = PetscDSGetDiscretization(probs[i], f, &disc);CHKERRQ(ierr);
+      ierr = PetscDSGetDiscretization(tprobs[i], f, &tdisc);CHKERRQ(ierr);
+      if (disc != tdisc) PetscFunctionReturn(0);
+    }
+  }
+  *valid = PETSC_TRUE;
+  PetscFunctionReturn(0);
+}
+
+/* Returns a PetscDS for the problem and auxiliary problem for each assembly thread, where the first thread uses the originals.
+   The copies are cached on the DM and only recreated when the problem or its discretizations change; their equations and
+   constants, which are cheap to copy, are refreshed on each call. */
+static PetscErrorCode DMPlexGetThreadDS_Private(DM dm, PetscInt numCells, PetscDS prob, PetscDS probAux, PetscInt *nt, PetscDS **probs, PetscDS **probsAux)
+{
+  DM_Plex       *mesh = (DM_Plex *) dm->data;
+  PetscInt       th;
+  PetscBool      valid;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = DMPlexGetAssemblyThreads_Private(dm, numCells, nt);CHKERRQ(ierr);
+  if (*nt > 1) {
+    ierr = DMPlexThreadDSValid_Private(dm, prob, probAux, *nt, &valid);CHKERRQ(ierr);
+    if (!valid) {
+      for (th = 0; th < mesh->numThreadDS; ++th) {
+        ierr = PetscDSDestroy(&mesh->threadDS[th]);CHKERRQ(ierr);
+        ierr = PetscDSDestroy(&mesh->threadDSAux[th]);CHKERRQ(ierr);
+      }
+      ierr = PetscFree2(mesh->threadDS, mesh->threadDSAux);CHKERRQ(ierr);
+      ierr = PetscMalloc2(*nt, &mesh->threadDS, *nt, &mesh->threadDSAux);CHKERRQ(ierr);
+      ierr = PetscInfo1(dm, "Creating PetscDS copies for %D assembly threads\n", *nt);CHKERRQ(ierr);
+      mesh->numThreadDS = *nt;
+      ierr = PetscObjectReference((PetscObject) prob);CHKERRQ(ierr);
+      ierr = PetscObjectReference((PetscObject) probAux);CHKERRQ(ierr);
+      mesh->threadDS[0]    = prob;
+      mesh->threadDSAux[0] = probAux;
+      for (th = 1; th < *nt; ++th) {
+        ierr = PetscDSCreateThreadCopy_Private(prob, &mesh->threadDS[th]);CHKERRQ(ierr);
+        ierr = PetscDSCreateThreadCopy_Private(probAux, &mesh->threadDSAux[th]);CHKERRQ(ierr);
+      }
+    } else {
+      for (th = 1; th < *nt; ++th) {
+        ierr = PetscDSCopyEquations(prob, mesh->threadDS[th]);CHKERRQ(ierr);
+        ierr = PetscDSCopyConstants(prob, mesh->threadDS[th]);CHKERRQ(ierr);
+        if (probAux) {
+          ierr = PetscDSCopyEquations(probAux, mesh->threadDSAux[th]);CHKERRQ(ierr);
+          ierr = PetscDSCopyConstants(probAux, mesh->threadDSAux[th]);CHKERRQ(ierr);
+        }
+      }
+    }
+  }
+  ierr = PetscMalloc2(*nt, probs, *nt, probsAux);CHKERRQ(ierr);
+  (*probs)[0]    = prob;
+  (*probsAux)[0] = probAux;
+  for (th = 1; th < *nt; ++th) {
+    (*probs)[th]    = mesh->threadDS[th];
+    (*probsAux)[th] = mesh->threadDSAux[th];
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode DMPlexRestoreThreadDS_Private(DM dm, PetscInt numCells, PetscDS prob, PetscDS probAux, PetscInt *nt, PetscDS **probs, PetscDS **probsAux)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscFree2(*probs, *probsAux);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* Integrates the FE residual over cells [cS, cE) of the chunk, using the work arrays of prob and probAux */
+static PetscErrorCode DMPlexIntegrateResidualSlab_Private(PetscDS prob, PetscDS probAux, PetscBool isImplicit, PetscFEGeom *affineGeom, PetscFEGeom **geoms, PetscInt cS, PetscInt cE,
+                                                          const PetscScalar u[], const PetscScalar u_t[], const PetscScalar a[], PetscReal t, PetscScalar elemVec[])
+{
+  PetscInt       Nf, f, totDim, totDimAux = 0;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscDSGetNumFields(prob, &Nf);CHKERRQ(ierr);
+  ierr = PetscDSGetTotalDimension(prob, &totDim);CHKERRQ(ierr);
+  if (probAux) {ierr = PetscDSGetTotalDimension(probAux, &totDimAux);CHKERRQ(ierr);}
+  for (f = 0; f < Nf; ++f) {
+    PetscObject  obj;
+    PetscClassId id;
+    PetscBool    fimp;
+
+    ierr = PetscDSGetImplicit(prob, f, &fimp);CHKERRQ(ierr);
+    if (isImplicit != fimp) continue;
+    ierr = PetscDSGetDiscretization(prob, f, &obj);CHKERRQ(ierr);
+    ierr = PetscObjectGetClassId(obj, &id);CHKERRQ(ierr);
+    if (id == PETSCFE_CLASSID) {
+      PetscFE      fe        = (PetscFE) obj;
+      PetscFEGeom *geom      = affineGeom ? affineGeom : geoms[f];
+      PetscFEGeom *chunkGeom = NULL;
+      PetscInt     numCells  = cE - cS, numChunks, numBatches, batchSize, Ne, Nr, offset;
+
+      ierr = PetscFEGetTileSizes(fe, NULL, NULL, &batchSize, &numBatches);CHKERRQ(ierr);
+      numChunks = numCells / (numBatches*batchSize);
+      Ne        = numChunks*numBatches*batchSize;
+      Nr        = numCells % (numBatches*batchSize);
+      offset    = cS + numCells - Nr;
+      ierr = PetscFEGeomGetChunk(geom,cS,offset,&chunkGeom);CHKERRQ(ierr);
+      ierr = PetscFEIntegrateResidual(fe, prob, f, Ne, chunkGeom, &u[cS*totDim], u_t ? &u_t[cS*totDim] : NULL, probAux, a ? &a[cS*totDimAux] : NULL, t, &elemVec[cS*totDim]);CHKERRQ(ierr);
+      ierr = PetscFEGeomGetChunk(geom,offset,cE,&chunkGeom);CHKERRQ(ierr);
+      ierr = PetscFEIntegrateResidual(fe, prob, f, Nr, chunkGeom, &u[offset*totDim], u_t ? &u_t[offset*totDim] : NULL, probAux, a ? &a[offset*totDimAux] : NULL, t, &elemVec[offset*totDim]);CHKERRQ(ierr);
+      ierr = PetscFEGeomRestoreChunk(geom,offset,cE,&chunkGeom);CHKERRQ(ierr);
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
+/* Integrates the FE Jacobian blocks of row field fieldI over cells [cS, cE), using the work arrays of prob and probAux */
+static PetscErrorCode DMPlexIntegrateJacobianSlab_Private(PetscFE fe, PetscDS prob, PetscDS probAux, PetscInt fieldI, PetscFEGeom *cgeom, PetscInt cS, PetscInt cE,
+                                                          const PetscScalar u[], const PetscScalar u_t[], const PetscScalar a[], PetscReal t, PetscReal X_tShift,
+                                                          PetscBool hasJac, PetscBool hasPrec, PetscBool hasDyn, PetscScalar elemMat[], PetscScalar elemMatP[], PetscScalar elemMatD[])
+{
+  PetscFEGeom   *chunkGeom = NULL, *remGeom = NULL;
+  PetscInt       Nf, fieldJ, totDim, totDimAux = 0, numCells = cE - cS, numChunks, numBatches, batchSize, Ne, Nr, offset;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscDSGetNumFields(prob, &Nf);CHKERRQ(ierr);
+  ierr = PetscDSGetTotalDimension(prob, &totDim);CHKERRQ(ierr);
+  if (probAux) {ierr = PetscDSGetTotalDimension(probAux, &totDimAux);CHKERRQ(ierr);}
+  ierr = PetscFEGetTileSizes(fe, NULL, NULL, &batchSize, &numBatches);CHKERRQ(ierr);
+  numChunks = numCells / (numBatches*batchSize);
+  Ne        = numChunks*numBatches*batchSize;
+  Nr        = numCells % (numBatches*batchSize);
+  offset    = cS + numCells - Nr;
+  u         = &u[cS*totDim];
+  u_t       = u_t ? &u_t[cS*totDim] : NULL;
+  a         = a ? &a[cS*totDimAux] : NULL;
+  if (hasJac)  elemMat  = &elemMat[cS*totDim*totDim];
+  if (hasPrec) elemMatP = &elemMatP[cS*totDim*totDim];
+  if (hasDyn)  elemMatD = &elemMatD[cS*totDim*totDim];
+  offset   -= cS;
+  ierr = PetscFEGeomGetChunk(cgeom,cS,cS+offset,&chunkGeom);CHKERRQ(ierr);
+  ierr = PetscFEGeomGetChunk(cgeom,cS+offset,cE,&remGeom);CHKERRQ(ierr);
+  for (fieldJ = 0; fieldJ < Nf; ++fieldJ) {
+    if (hasJac) {
+      ierr = PetscFEIntegrateJacobian(fe, prob, PETSCFE_JACOBIAN, fieldI, fieldJ, Ne, chunkGeom, u, u_t, probAux, a, t, X_tShift, elemMat);CHKERRQ(ierr);
+      ierr = PetscFEIntegrateJacobian(fe, prob, PETSCFE_JACOBIAN, fieldI, fieldJ, Nr, remGeom, &u[offset*totDim], u_t ? &u_t[offset*totDim] : NULL, probAux, a ? &a[offset*totDimAux] : NULL, t, X_tShift, &elemMat[offset*totDim*totDim]);CHKERRQ(ierr);
+    }
+    if (hasPrec) {
+      ierr = PetscFEIntegrateJacobian(fe, prob, PETSCFE_JACOBIAN_PRE, fieldI, fieldJ, Ne, chunkGeom, u, u_t, probAux, a, t, X_tShift, elemMatP);CHKERRQ(ierr);
+      ierr = PetscFEIntegrateJacobian(fe, prob, PETSCFE_JACOBIAN_PRE, fieldI, fieldJ, Nr, remGeom, &u[offset*totDim], u_t ? &u_t[offset*totDim] : NULL, probAux, a ? &a[offset*totDimAux] : NULL, t, X_tShift, &elemMatP[offset*totDim*totDim]);CHKERRQ(ierr);
+    }
+    if (hasDyn) {
+      ierr = PetscFEIntegrateJacobian(fe, prob, PETSCFE_JACOBIAN_DYN, fieldI, fieldJ, Ne, chunkGeom, u, u_t, probAux, a, t, X_tShift, elemMatD);CHKERRQ(ierr);
+      ierr = PetscFEIntegrateJacobian(fe, prob, PETSCFE_JACOBIAN_DYN, fieldI, fieldJ, Nr, remGeom, &u[offset*totDim], u_t ? &u_t[offset*totDim] : NULL, probAux, a ? &a[offset*totDimAux] : NULL, t, X_tShift, &elemMatD[offset*totDim*totDim]);CHKERRQ(ierr);
+    }
+  }
+  ierr = PetscFEGeomRestoreChunk(cgeom,cS+offset,cE,&remGeom);CHKERRQ(ierr);
+  ierr = PetscFEGeomRestoreChunk(cgeom,cS,cS+offset,&chunkGeom);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+  The closure coloring of a cell IS, along with the offset into the local vector of each closure dof of each cell. The
+  offsets of ghost cells are -1, and closure is NULL when the closure values are not a plain gather, e.g. when the
+  section has sign flips.
+*/
+typedef struct {
+  ISColoring coloring;
+  PetscInt  *closure;
+} DMSNESAssemblyColoring;
+
+static PetscErrorCode PetscContainerUserDestroy_DMSNESAssemblyColoring(void *ctx)
+{
+  DMSNESAssemblyColoring *ac = (DMSNESAssemblyColoring *) ctx;
+  PetscErrorCode          ierr;
+
+  PetscFunctionBegin;
+  ierr = ISColoringDestroy(&ac->coloring);CHKERRQ(ierr);
+  ierr = PetscFree(ac->closure);CHKERRQ(ierr);
+  ierr = PetscFree(ac);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* The closure offsets are the local closure indices of each cell, or -1 on ghost cells */
+static PetscErrorCode DMSNESCreateClosureOffsets_Private(DM dm, IS cellIS, PetscSection section, DMLabel ghostLabel, PetscInt totDim, PetscInt **closure)
+{
+  DMPlexClosureIndexCache *cache;
+  const PetscInt          *cells;
+  PetscInt                 cStart, cEnd, c, i;
+  PetscBool                valid;
+  PetscErrorCode           ierr;
+
+  PetscFunctionBegin;
+  ierr  = DMPlexGetClosureIndexCache_Internal(dm, section, NULL, &cache);CHKERRQ(ierr);
+  valid = cache->lvalid;
+  ierr  = ISGetPointRange(cellIS, &cStart, &cEnd, &cells);CHKERRQ(ierr);
+  ierr  = PetscMalloc1((cEnd-cStart)*totDim, closure);CHKERRQ(ierr);
+  for (c = cStart; valid && c < cEnd; ++c) {
+    const PetscInt cell = cells ? cells[c] : c;
+    PetscInt      *cl   = &(*closure)[(c-cStart)*totDim];
+    PetscInt       ghostVal = 0;
+
+    if (ghostLabel) {ierr = DMLabelGetValue(ghostLabel, cell, &ghostVal);CHKERRQ(ierr);}
+    if (ghostVal > 0) {
+      for (i = 0; i < totDim; ++i) cl[i] = -1;
+      continue;
+    }
+    if ((cell < cache->cStart) || (cell >= cache->cEnd) || (cache->off[cell-cache->cStart+1] - cache->off[cell-cache->cStart] != totDim)) {valid = PETSC_FALSE; break;}
+    /* Element vectors are added with ADD_ALL_VALUES, so constrained dofs are included */
+    for (i = 0; i < totDim; ++i) {
+      const PetscInt idx = cache->lidx[cache->off[cell-cache->cStart]+i];
+
+      cl[i] = idx < 0 ? -(idx+1) : idx;
+    }
+  }
+  ierr = ISRestorePointRange(cellIS, &cStart, &cEnd, &cells);CHKERRQ(ierr);
+  if (!valid) {ierr = PetscFree(*closure);CHKERRQ(ierr);}
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode DMSNESGetAssemblyColoring(DM dm, IS cellIS, PetscSection section, DMLabel ghostLabel, PetscInt totDim, DMSNESAssemblyColoring **ac)
+{
+  char           composeStr[33] = {0};
+  PetscObjectId  id;
+  PetscContainer container;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectGetId((PetscObject) section, &id);CHKERRQ(ierr);
+  ierr = PetscSNPrintf(composeStr, 32, "DMSNESGetAssemblyColoring_%x", id);CHKERRQ(ierr);
+  ierr = PetscObjectQuery((PetscObject) cellIS, composeStr, (PetscObject *) &container);CHKERRQ(ierr);
+  if (container) {
+    ierr = PetscContainerGetPointer(container, (void **) ac);CHKERRQ(ierr);
+  } else {
+    ierr = PetscNew(ac);CHKERRQ(ierr);
+    ierr = DMPlexCreateClosureColoring(dm, cellIS, &(*ac)->coloring);CHKERRQ(ierr);
+    ierr = DMSNESCreateClosureOffsets_Private(dm, cellIS, section, ghostLabel, totDim, &(*ac)->closure);CHKERRQ(ierr);
+    ierr = PetscContainerCreate(PETSC_COMM_SELF, &container);CHKERRQ(ierr);
+    ierr = PetscContainerSetPointer(container, (void *) *ac);CHKERRQ(ierr);
+    ierr = PetscContainerSetUserDestroy(container, PetscContainerUserDestroy_DMSNESAssemblyColoring);CHKERRQ(ierr);
+    ierr = PetscObjectCompose((PetscObject) cellIS, composeStr, (PetscObject) container);CHKERRQ(ierr);
+    ierr = PetscContainerDestroy(&container);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+/* Adds the element vectors into the local vector one color at a time, where the cells of a color have disjoint closures */
+static PetscErrorCode DMSNESAddElementVectorsColored_Private(DMSNESAssemblyColoring *ac, PetscInt totDim, const PetscScalar elemVec[], Vec locF)
+{
+  PetscScalar   *fa;
+  IS            *colorIS;
+  PetscInt       numColors, k;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = ISColoringGetIS(ac->coloring, &numColors, &colorIS);CHKERRQ(ierr);
+  ierr = VecGetArray(locF, &fa);CHKERRQ(ierr);
+  for (k = 0; k < numColors; ++k) {
+    const PetscInt *cind;
+    PetscInt        n, i;
+
+    ierr = ISGetLocalSize(colorIS[k], &n);CHKERRQ(ierr);
+    ierr = ISGetIndices(colorIS[k], &cind);CHKERRQ(ierr);
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(static)
+#endif
+    for (i = 0; i < n; ++i) {
+      const PetscInt    *cl = &ac->closure[cind[i]*totDim];
+      const PetscScalar *ev = &elemVec[cind[i]*totDim];
+      PetscInt           j;
+
+      for (j = 0; j < totDim; ++j) if (cl[j] >= 0) fa[cl[j]] += ev[j];
+    }
+    ierr = ISRestoreIndices(colorIS[k], &cind);CHKERRQ(ierr);
+  }
+  ierr = VecRestoreArray(locF, &fa);CHKERRQ(ierr);
+  ierr = ISColoringRestoreIS(ac->coloring, &colorIS);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 static PetscErrorCode DMPlexComputeBdResidual_Single_Internal(DM dm, PetscReal t, DMLabel label, PetscInt numValues, const PetscInt values[], PetscInt field, Vec locX, Vec locX_t, Vec locF, DMField coordField, IS facetIS)
 {
   DM_Plex         *mesh = (DM_Plex *) dm->data;
@@ -1685,6 +2150,7 @@ PetscErrorCode DMPlexComputeResidual_Internal(DM dm, IS cellIS, PetscReal time,
     PetscScalar     *elemVec, *fluxL, *fluxR;
     PetscReal       *vol;
     PetscFVFaceGeom *fgeom;
+    PetscBool        colored;
     PetscInt         cS = cStart+chunk*cellChunkSize, cE = PetscMin(cS+cellChunkSize, cEnd), numCells = cE - cS, c;
     PetscInt         fS = fStart+chunk*faceChunkSize, fE = PetscMin(fS+faceChunkSize, fEnd), numFaces = 0, face;
 
@@ -1709,36 +2175,22 @@ PetscErrorCode DMPlexComputeResidual_Internal(DM dm, IS cellIS, PetscReal time,
       PetscObject  obj;
       PetscClassId id;
       PetscBool    fimp;
-      PetscInt     numChunks, numBatches, batchSize, numBlocks, blockSize, Ne, Nr, offset;
+      PetscInt     numBatches, batchSize, numBlocks, blockSize, Ne;
 
       ierr = PetscDSGetImplicit(prob, f, &fimp);CHKERRQ(ierr);
       if (isImplicit != fimp) continue;
       ierr = PetscDSGetDiscretization(prob, f, &obj);CHKERRQ(ierr);
       ierr = PetscObjectGetClassId(obj, &id);CHKERRQ(ierr);
       if (id == PETSCFE_CLASSID) {
-        PetscFE         fe = (PetscFE) obj;
-        PetscFEGeom    *geom = affineGeom ? affineGeom : geoms[f];
-        PetscFEGeom    *chunkGeom = NULL;
-        PetscQuadrature quad = affineQuad ? affineQuad : quads[f];
-        PetscInt        Nq, Nb;
+        PetscFE fe = (PetscFE) obj;
+        PetscInt Nb;
 
+        /* The FE residual is integrated below, once the tiling is set for all fields */
         ierr = PetscFEGetTileSizes(fe, NULL, &numBlocks, NULL, &numBatches);CHKERRQ(ierr);
-        ierr = PetscQuadratureGetData(quad, NULL, NULL, &Nq, NULL, NULL);CHKERRQ(ierr);
         ierr = PetscFEGetDimension(fe, &Nb);CHKERRQ(ierr);
         blockSize = Nb;
         batchSize = numBlocks * blockSize;
         ierr      = PetscFESetTileSizes(fe, blockSize, numBlocks, batchSize, numBatches);CHKERRQ(ierr);
-        numChunks = numCells / (numBatches*batchSize);
-        Ne        = numChunks*numBatches*batchSize;
-        Nr        = numCells % (numBatches*batchSize);
-        offset    = numCells - Nr;
-        /* Integrate FE residual to get elemVec (need fields at quadrature points) */
-        /*   For FV, I think we use a P0 basis and the cell coefficients (for subdivided cells, we can tweak the basis tabulation to be the indicator function) */
-        ierr = PetscFEGeomGetChunk(geom,0,offset,&chunkGeom);CHKERRQ(ierr);
-        ierr = PetscFEIntegrateResidual(fe, prob, f, Ne, chunkGeom, u, u_t, probAux, a, t, elemVec);CHKERRQ(ierr);
-        ierr = PetscFEGeomGetChunk(geom,offset,numCells,&chunkGeom);CHKERRQ(ierr);
-        ierr = PetscFEIntegrateResidual(fe, prob, f, Nr, chunkGeom, &u[offset*totDim], u_t ? &u_t[offset*totDim] : NULL, probAux, &a[offset*totDimAux], t, &elemVec[offset*totDim]);CHKERRQ(ierr);
-        ierr = PetscFEGeomRestoreChunk(geom,offset,numCells,&chunkGeom);CHKERRQ(ierr);
       } else if (id == PETSCFV_CLASSID) {
         PetscFV fv = (PetscFV) obj;
 
@@ -1748,8 +2200,43 @@ PetscErrorCode DMPlexComputeResidual_Internal(DM dm, IS cellIS, PetscReal time,
         ierr = PetscFVIntegrateRHSFunction(fv, prob, f, Ne, fgeom, vol, uL, uR, fluxL, fluxR);CHKERRQ(ierr);
       } else SETERRQ1(PetscObjectComm((PetscObject) dm), PETSC_ERR_ARG_WRONG, "Unknown discretization type for field %d", f);
     }
-    /* Loop over domain */
+    /* Integrate FE residual to get elemVec (need fields at quadrature points), in one slab of cells per thread */
+    /*   For FV, I think we use a P0 basis and the cell coefficients (for subdivided cells, we can tweak the basis tabulation to be the indicator function) */
     if (useFEM) {
+      PetscDS        *probs, *probsAux;
+      PetscErrorCode *ierrs;
+      PetscInt        nt, th;
+
+      ierr = DMPlexGetThreadDS_Private(dm, numCells, prob, probAux, &nt, &probs, &probsAux);CHKERRQ(ierr);
+      ierr = PetscMalloc1(nt, &ierrs);CHKERRQ(ierr);
+#if defined(_OPENMP) && defined(PETSC_HAVE_THREADSAFETY)
+#pragma omp parallel for schedule(static)
+#endif
+      for (th = 0; th < nt; ++th) {
+        ierrs[th] = DMPlexIntegrateResidualSlab_Private(probs[th], probsAux[th], isImplicit, affineGeom, geoms, (th*numCells)/nt, ((th+1)*numCells)/nt, u, u_t, a, t, elemVec);
+      }
+      for (th = 0; th < nt; ++th) {ierr = ierrs[th];CHKERRQ(ierr);}
+      ierr = PetscFree(ierrs);CHKERRQ(ierr);
+      ierr = DMPlexRestoreThreadDS_Private(dm, numCells, prob, probAux, &nt, &probs, &probsAux);CHKERRQ(ierr);
+    }
+    /* Loop over domain */
+    colored = PETSC_FALSE;
+    if (useFEM && mesh->threadedAssembly) {
+      DMSNESAssemblyColoring *ac;
+
+      ierr = DMSNESGetAssemblyColoring(dm, cellIS, section, ghostLabel, totDim, &ac);CHKERRQ(ierr);
+      if (ac->closure) {
+        if (mesh->printFEM > 1) {
+          for (c = cS; c < cE; ++c) {ierr = DMPrintCellVector(cells ? cells[c] : c, name, totDim, &elemVec[(c-cStart)*totDim]);CHKERRQ(ierr);}
+        }
+        /* Cells of one color have disjoint closures, so their element vectors are added concurrently */
+        ierr = DMSNESAddElementVectorsColored_Private(ac, totDim, elemVec, locF);CHKERRQ(ierr);
+        colored = PETSC_TRUE;
+      } else {
+        ierr = PetscInfo(dm, "Closure values are not a plain gather, adding element vectors serially\n");CHKERRQ(ierr);
+      }
+    }
+    if (useFEM && !colored) {
       /* Add elemVec to locX */
       for (c = cS; c < cE; ++c) {
         const PetscInt cell = cells ? cells[c] : c;
@@ -2290,14 +2777,14 @@ PetscErrorCode DMPlexComputeJacobian_Internal(DM dm, IS cellIS, PetscReal t, Pet
   DM              dmAux, plex;
   Vec             A;
   DMField         coordField;
-  PetscDS         prob, probAux = NULL;
+  PetscDS         prob, probAux = NULL, *probs, *probsAux;
   PetscSection    section, globalSection, subSection, sectionAux;
-  PetscScalar    *elemMat, *elemMatP, *elemMatD, *u, *u_t, *a = NULL;
+  PetscScalar    *elemMat, *elemMatP, *elemMatD, *u, *u_t, *a = NULL, *ebeArray = NULL, *elemMatBuf = NULL;
   const PetscInt *cells;
-  PetscInt        Nf, fieldI, fieldJ;
-  PetscInt        totDim, totDimAux, cStart, cEnd, numCells, c;
-  PetscBool       isMatIS, isMatISP, isShell, hasJac, hasPrec, hasDyn, hasFV = PETSC_FALSE;
-  PetscErrorCode  ierr;
+  PetscInt        Nf, fieldI;
+  PetscInt        totDim, totDimAux, cStart, cEnd, numCells, c, nt, eStart;
+  PetscBool       isMatIS, isMatISP, isEBE, isShell, hasJac, hasPrec, hasDyn, hasFV = PETSC_FALSE;
+  PetscErrorCode *ierrs, ierr;
 
   PetscFunctionBegin;
   ierr = PetscLogEventBegin(DMPLEX_JacobianFEM,dm,0,0,0);CHKERRQ(ierr);
@@ -2324,7 +2811,20 @@ PetscErrorCode DMPlexComputeJacobian_Internal(DM dm, IS cellIS, PetscReal t, Pet
     ierr = DMGetDS(dmAux, &probAux);CHKERRQ(ierr);
     ierr = PetscDSGetTotalDimension(probAux, &totDimAux);CHKERRQ(ierr);
   }
-  ierr = PetscMalloc5(numCells*totDim,&u,X_t ? numCells*totDim : 0,&u_t,hasJac ? numCells*totDim*totDim : 0,&elemMat,hasPrec ? numCells*totDim*totDim : 0, &elemMatP,hasDyn ? numCells*totDim*totDim : 0, &elemMatD);CHKERRQ(ierr);
+  /* A MATEBE operator stores one element matrix per cell, so a contiguous range of cells is integrated straight into it */
+  ierr = PetscObjectTypeCompare((PetscObject) JacP, MATEBE, &isEBE);CHKERRQ(ierr);
+  if (isEBE && hasJac && !hasPrec && !cells) {
+    PetscInt Ne, Nb;
+
+    ierr = MatEBEGetElements(JacP, &Ne, &Nb, NULL);CHKERRQ(ierr);
+    ierr = DMPlexGetHeightStratum(dm, 0, &eStart, NULL);CHKERRQ(ierr);
+    if ((Nb == totDim) && (cStart >= eStart) && (cEnd-eStart <= Ne)) {ierr = MatEBEGetArray(JacP, &ebeArray);CHKERRQ(ierr);}
+  }
+  ierr = PetscMalloc5(numCells*totDim,&u,X_t ? numCells*totDim : 0,&u_t,hasJac && !ebeArray ? numCells*totDim*totDim : 0,&elemMat,hasPrec ? numCells*totDim*totDim : 0, &elemMatP,hasDyn ? numCells*totDim*totDim : 0, &elemMatD);CHKERRQ(ierr);
+  if (ebeArray) {
+    elemMatBuf = elemMat;
+    elemMat    = &ebeArray[(cStart-eStart)*totDim*totDim];
+  }
   if (dmAux) {ierr = PetscMalloc1(numCells*totDimAux, &a);CHKERRQ(ierr);}
   ierr = DMGetCoordinateField(dm, &coordField);CHKERRQ(ierr);
   for (c = cStart; c < cEnd; ++c) {
@@ -2347,20 +2847,19 @@ PetscErrorCode DMPlexComputeJacobian_Internal(DM dm, IS cellIS, PetscReal t, Pet
       ierr = DMPlexVecRestoreClosure(plex, sectionAux, A, cell, NULL, &x);CHKERRQ(ierr);
     }
   }
-  if (hasJac)  {ierr = PetscMemzero(elemMat,  numCells*totDim*totDim * sizeof(PetscScalar));CHKERRQ(ierr);}
+  /* Integration accumulates, so the MATEBE array is not cleared, which gives the ADD_VALUES semantics of the assembled path */
+  if (hasJac && !ebeArray) {ierr = PetscMemzero(elemMat,  numCells*totDim*totDim * sizeof(PetscScalar));CHKERRQ(ierr);}
   if (hasPrec) {ierr = PetscMemzero(elemMatP, numCells*totDim*totDim * sizeof(PetscScalar));CHKERRQ(ierr);}
   if (hasDyn)  {ierr = PetscMemzero(elemMatD, numCells*totDim*totDim * sizeof(PetscScalar));CHKERRQ(ierr);}
+  ierr = DMPlexGetThreadDS_Private(dm, numCells, prob, probAux, &nt, &probs, &probsAux);CHKERRQ(ierr);
+  ierr = PetscMalloc1(nt, &ierrs);CHKERRQ(ierr);
   for (fieldI = 0; fieldI < Nf; ++fieldI) {
     PetscClassId    id;
     PetscFE         fe;
     PetscQuadrature qGeom = NULL;
-    PetscInt        Nb;
-    /* Conforming batches */
-    PetscInt        numChunks, numBatches, numBlocks, Ne, blockSize, batchSize;
-    /* Remainder */
-    PetscInt        Nr, offset, Nq;
+    PetscInt        Nb, numBatches, numBlocks, blockSize, batchSize, th;
     PetscBool       isAffine;
-    PetscFEGeom     *cgeomFEM, *chunkGeom = NULL, *remGeom = NULL;
+    PetscFEGeom     *cgeomFEM;
 
     ierr = PetscDSGetDiscretization(prob, fieldI, (PetscObject *) &fe);CHKERRQ(ierr);
     ierr = PetscObjectGetClassId((PetscObject) fe, &id);CHKERRQ(ierr);
@@ -2375,36 +2874,23 @@ PetscErrorCode DMPlexComputeJacobian_Internal(DM dm, IS cellIS, PetscReal t, Pet
       ierr = PetscFEGetQuadrature(fe,&qGeom);CHKERRQ(ierr);
       ierr = PetscObjectReference((PetscObject)qGeom);CHKERRQ(ierr);
     }
-    ierr = PetscQuadratureGetData(qGeom, NULL, NULL, &Nq, NULL, NULL);CHKERRQ(ierr);
     ierr = DMSNESGetFEGeom(coordField,cellIS,qGeom,PETSC_FALSE,&cgeomFEM);CHKERRQ(ierr);
     blockSize = Nb;
     batchSize = numBlocks * blockSize;
     ierr = PetscFESetTileSizes(fe, blockSize, numBlocks, batchSize, numBatches);CHKERRQ(ierr);
-    numChunks = numCells / (numBatches*batchSize);
-    Ne        = numChunks*numBatches*batchSize;
-    Nr        = numCells % (numBatches*batchSize);
-    offset    = numCells - Nr;
-    ierr = PetscFEGeomGetChunk(cgeomFEM,0,offset,&chunkGeom);CHKERRQ(ierr);
-    ierr = PetscFEGeomGetChunk(cgeomFEM,offset,numCells,&remGeom);CHKERRQ(ierr);
-    for (fieldJ = 0; fieldJ < Nf; ++fieldJ) {
-      if (hasJac) {
-        ierr = PetscFEIntegrateJacobian(fe, prob, PETSCFE_JACOBIAN, fieldI, fieldJ, Ne, chunkGeom, u, u_t, probAux, a, t, X_tShift, elemMat);CHKERRQ(ierr);
-        ierr = PetscFEIntegrateJacobian(fe, prob, PETSCFE_JACOBIAN, fieldI, fieldJ, Nr, remGeom, &u[offset*totDim], u_t ? &u_t[offset*totDim] : NULL, probAux, &a[offset*totDimAux], t, X_tShift, &elemMat[offset*totDim*totDim]);CHKERRQ(ierr);
-      }
-      if (hasPrec) {
-        ierr = PetscFEIntegrateJacobian(fe, prob, PETSCFE_JACOBIAN_PRE, fieldI, fieldJ, Ne, chunkGeom, u, u_t, probAux, a, t, X_tShift, elemMatP);CHKERRQ(ierr);
-        ierr = PetscFEIntegrateJacobian(fe, prob, PETSCFE_JACOBIAN_PRE, fieldI, fieldJ, Nr, remGeom, &u[offset*totDim], u_t ? &u_t[offset*totDim] : NULL, probAux, &a[offset*totDimAux], t, X_tShift, &elemMatP[offset*totDim*totDim]);CHKERRQ(ierr);
-      }
-      if (hasDyn) {
-        ierr = PetscFEIntegrateJacobian(fe, prob, PETSCFE_JACOBIAN_DYN, fieldI, fieldJ, Ne, chunkGeom, u, u_t, probAux, a, t, X_tShift, elemMatD);CHKERRQ(ierr);
-        ierr = PetscFEIntegrateJacobian(fe, prob, PETSCFE_JACOBIAN_DYN, fieldI, fieldJ, Nr, remGeom, &u[offset*totDim], u_t ? &u_t[offset*totDim] : NULL, probAux, &a[offset*totDimAux], t, X_tShift, &elemMatD[offset*totDim*totDim]);CHKERRQ(ierr);
-      }
+    /* Each thread integrates one slab of cells into its own rows of the element matrices */
+#if defined(_OPENMP) && defined(PETSC_HAVE_THREADSAFETY)
+#pragma omp parallel for schedule(static)
+#endif
+    for (th = 0; th < nt; ++th) {
+      ierrs[th] = DMPlexIntegrateJacobianSlab_Private(fe, probs[th], probsAux[th], fieldI, cgeomFEM, (th*numCells)/nt, ((th+1)*numCells)/nt, u, u_t, a, t, X_tShift, hasJac, hasPrec, hasDyn, elemMat, elemMatP, elemMatD);
     }
-    ierr = PetscFEGeomRestoreChunk(cgeomFEM,offset,numCells,&remGeom);CHKERRQ(ierr);
-    ierr = PetscFEGeomRestoreChunk(cgeomFEM,0,offset,&chunkGeom);CHKERRQ(ierr);
+    for (th = 0; th < nt; ++th) {ierr = ierrs[th];CHKERRQ(ierr);}
     ierr = DMSNESRestoreFEGeom(coordField,cellIS,qGeom,PETSC_FALSE,&cgeomFEM);CHKERRQ(ierr);
     ierr = PetscQuadratureDestroy(&qGeom);CHKERRQ(ierr);
   }
+  ierr = PetscFree(ierrs);CHKERRQ(ierr);
+  ierr = DMPlexRestoreThreadDS_Private(dm, numCells, prob, probAux, &nt, &probs, &probsAux);CHKERRQ(ierr);
   if (hasDyn) {for (c = 0; c < numCells*totDim*totDim; ++c) elemMat[c] += X_tShift*elemMatD[c];}
   if (hasFV) {
     PetscClassId id;
@@ -2427,7 +2913,7 @@ PetscErrorCode DMPlexComputeJacobian_Internal(DM dm, IS cellIS, PetscReal t, Pet
             if (hasPrec) {
               if (hasJac) {elemMat[eOffset+i*totDim+i] = 1.0;}
               elemMatP[eOffset+i*totDim+i] = 1.0;
-            } else {elemMat[eOffset+i*totDim+i] = 1.0;}
+            } else {elemMat[eOffset+i*totDim+i] += 1.0;}
           }
         }
       }
@@ -2469,6 +2955,7 @@ PetscErrorCode DMPlexComputeJacobian_Internal(DM dm, IS cellIS, PetscReal t, Pet
       }
     } else {
       if (mesh->printFEM > 1) {ierr = DMPrintCellMatrix(cell, name, totDim, totDim, &elemMat[cind*totDim*totDim]);CHKERRQ(ierr);}
+      if (ebeArray) continue;
       if (!isMatISP) {
         ierr = DMPlexMatSetClosure(dm, section, globalSection, JacP, cell, &elemMat[cind*totDim*totDim], ADD_VALUES);CHKERRQ(ierr);
       } else {
@@ -2481,6 +2968,10 @@ PetscErrorCode DMPlexComputeJacobian_Internal(DM dm, IS cellIS, PetscReal t, Pet
   }
   ierr = ISRestorePointRange(cellIS, &cStart, &cEnd, &cells);CHKERRQ(ierr);
   if (hasFV) {ierr = MatSetOption(JacP, MAT_IGNORE_ZERO_ENTRIES, PETSC_FALSE);CHKERRQ(ierr);}
+  if (ebeArray) {
+    elemMat = elemMatBuf;
+    ierr    = MatEBERestoreArray(JacP, &ebeArray);CHKERRQ(ierr);
+  }
   ierr = PetscFree5(u,u_t,elemMat,elemMatP,elemMatD);CHKERRQ(ierr);
   if (dmAux) {
     ierr = PetscFree(a);CHKERRQ(ierr);
@@ -2512,13 +3003,12 @@ PetscErrorCode DMPlexComputeJacobian_Internal(DM dm, IS cellIS, PetscReal t, Pet
 PetscErrorCode DMPlexComputeJacobianAction_Internal(DM dm, IS cellIS, PetscReal t, PetscReal X_tShift, Vec X, Vec X_t, Vec Y, Vec Z, void *user)
 {
   DM_Plex          *mesh  = (DM_Plex *) dm->data;
-  const char       *name  = "Jacobian";
   DM                dmAux, plex;
   Vec               A;
   PetscDS           prob, probAux = NULL;
   PetscQuadrature   quad;
   PetscSection      section, globalSection, sectionAux;
-  PetscScalar      *elemMat, *elemMatD, *u, *u_t, *a = NULL, *y, *z;
+  PetscScalar      *elemVec, *elemVecD, *u, *u_t, *a = NULL, *y;
   PetscInt          Nf, fieldI, fieldJ;
   PetscInt          totDim, totDimAux = 0;
   const PetscInt   *cells;
@@ -2547,7 +3037,7 @@ PetscErrorCode DMPlexComputeJacobianAction_Internal(DM dm, IS cellIS, PetscReal
     ierr = PetscDSGetTotalDimension(probAux, &totDimAux);CHKERRQ(ierr);
   }
   ierr = VecSet(Z, 0.0);CHKERRQ(ierr);
-  ierr = PetscMalloc6(numCells*totDim,&u,X_t ? numCells*totDim : 0,&u_t,numCells*totDim*totDim,&elemMat,hasDyn ? numCells*totDim*totDim : 0, &elemMatD,numCells*totDim,&y,totDim,&z);CHKERRQ(ierr);
+  ierr = PetscMalloc5(numCells*totDim,&u,X_t ? numCells*totDim : 0,&u_t,numCells*totDim,&elemVec,hasDyn ? numCells*totDim : 0, &elemVecD,numCells*totDim,&y);CHKERRQ(ierr);
   if (dmAux) {ierr = PetscMalloc1(numCells*totDimAux, &a);CHKERRQ(ierr);}
   ierr = DMGetCoordinateField(dm, &coordField);CHKERRQ(ierr);
   for (c = cStart; c < cEnd; ++c) {
@@ -2573,8 +3063,8 @@ PetscErrorCode DMPlexComputeJacobianAction_Internal(DM dm, IS cellIS, PetscReal
     for (i = 0; i < totDim; ++i) y[cind*totDim+i] = x[i];
     ierr = DMPlexVecRestoreClosure(dm, section, Y, cell, NULL, &x);CHKERRQ(ierr);
   }
-  ierr = PetscMemzero(elemMat, numCells*totDim*totDim * sizeof(PetscScalar));CHKERRQ(ierr);
-  if (hasDyn)  {ierr = PetscMemzero(elemMatD, numCells*totDim*totDim * sizeof(PetscScalar));CHKERRQ(ierr);}
+  ierr = PetscMemzero(elemVec, numCells*totDim * sizeof(PetscScalar));CHKERRQ(ierr);
+  if (hasDyn)  {ierr = PetscMemzero(elemVecD, numCells*totDim * sizeof(PetscScalar));CHKERRQ(ierr);}
   for (fieldI = 0; fieldI < Nf; ++fieldI) {
     PetscFE  fe;
     PetscInt Nb;
@@ -2610,11 +3100,11 @@ PetscErrorCode DMPlexComputeJacobianAction_Internal(DM dm, IS cellIS, PetscReal
     ierr = PetscFEGeomGetChunk(cgeomFEM,0,offset,&chunkGeom);CHKERRQ(ierr);
     ierr = PetscFEGeomGetChunk(cgeomFEM,offset,numCells,&remGeom);CHKERRQ(ierr);
     for (fieldJ = 0; fieldJ < Nf; ++fieldJ) {
-      ierr = PetscFEIntegrateJacobian(fe, prob, PETSCFE_JACOBIAN, fieldI, fieldJ, Ne, chunkGeom, u, u_t, probAux, a, t, X_tShift, elemMat);CHKERRQ(ierr);
-      ierr = PetscFEIntegrateJacobian(fe, prob, PETSCFE_JACOBIAN, fieldI, fieldJ, Nr, remGeom, &u[offset*totDim], u_t ? &u_t[offset*totDim] : NULL, probAux, &a[offset*totDimAux], t, X_tShift, &elemMat[offset*totDim*totDim]);CHKERRQ(ierr);
+      ierr = PetscFEIntegrateJacobianAction(fe, prob, PETSCFE_JACOBIAN, fieldI, fieldJ, Ne, chunkGeom, u, u_t, probAux, a, t, X_tShift, y, elemVec);CHKERRQ(ierr);
+      ierr = PetscFEIntegrateJacobianAction(fe, prob, PETSCFE_JACOBIAN, fieldI, fieldJ, Nr, remGeom, &u[offset*totDim], u_t ? &u_t[offset*totDim] : NULL, probAux, &a[offset*totDimAux], t, X_tShift, &y[offset*totDim], &elemVec[offset*totDim]);CHKERRQ(ierr);
       if (hasDyn) {
-        ierr = PetscFEIntegrateJacobian(fe, prob, PETSCFE_JACOBIAN_DYN, fieldI, fieldJ, Ne, chunkGeom, u, u_t, probAux, a, t, X_tShift, elemMatD);CHKERRQ(ierr);
-        ierr = PetscFEIntegrateJacobian(fe, prob, PETSCFE_JACOBIAN_DYN, fieldI, fieldJ, Nr, remGeom, &u[offset*totDim], u_t ? &u_t[offset*totDim] : NULL, probAux, &a[offset*totDimAux], t, X_tShift, &elemMatD[offset*totDim*totDim]);CHKERRQ(ierr);
+        ierr = PetscFEIntegrateJacobianAction(fe, prob, PETSCFE_JACOBIAN_DYN, fieldI, fieldJ, Ne, chunkGeom, u, u_t, probAux, a, t, X_tShift, y, elemVecD);CHKERRQ(ierr);
+        ierr = PetscFEIntegrateJacobianAction(fe, prob, PETSCFE_JACOBIAN_DYN, fieldI, fieldJ, Nr, remGeom, &u[offset*totDim], u_t ? &u_t[offset*totDim] : NULL, probAux, &a[offset*totDimAux], t, X_tShift, &y[offset*totDim], &elemVecD[offset*totDim]);CHKERRQ(ierr);
       }
     }
     ierr = PetscFEGeomRestoreChunk(cgeomFEM,offset,numCells,&remGeom);CHKERRQ(ierr);
@@ -2623,23 +3113,19 @@ PetscErrorCode DMPlexComputeJacobianAction_Internal(DM dm, IS cellIS, PetscReal
     ierr = PetscQuadratureDestroy(&qGeom);CHKERRQ(ierr);
   }
   if (hasDyn) {
-    for (c = 0; c < numCells*totDim*totDim; ++c) elemMat[c] += X_tShift*elemMatD[c];
+    for (c = 0; c < numCells*totDim; ++c) elemVec[c] += X_tShift*elemVecD[c];
   }
   for (c = cStart; c < cEnd; ++c) {
-    const PetscInt     cell = cells ? cells[c] : c;
-    const PetscInt     cind = c - cStart;
-    const PetscBLASInt M = totDim, one = 1;
-    const PetscScalar  a = 1.0, b = 0.0;
+    const PetscInt cell = cells ? cells[c] : c;
+    const PetscInt cind = c - cStart;
 
-    PetscStackCallBLAS("BLASgemv", BLASgemv_("N", &M, &M, &a, &elemMat[cind*totDim*totDim], &M, &y[cind*totDim], &one, &b, z, &one));
     if (mesh->printFEM > 1) {
-      ierr = DMPrintCellMatrix(c, name, totDim, totDim, &elemMat[cind*totDim*totDim]);CHKERRQ(ierr);
       ierr = DMPrintCellVector(c, "Y",  totDim, &y[cind*totDim]);CHKERRQ(ierr);
-      ierr = DMPrintCellVector(c, "Z",  totDim, z);CHKERRQ(ierr);
+      ierr = DMPrintCellVector(c, "Z",  totDim, &elemVec[cind*totDim]);CHKERRQ(ierr);
     }
-    ierr = DMPlexVecSetClosure(dm, section, Z, cell, z, ADD_VALUES);CHKERRQ(ierr);
+    ierr = DMPlexVecSetClosure(dm, section, Z, cell, &elemVec[cind*totDim], ADD_VALUES);CHKERRQ(ierr);
   }
-  ierr = PetscFree6(u,u_t,elemMat,elemMatD,y,z);CHKERRQ(ierr);
+  ierr = PetscFree5(u,u_t,elemVec,elemVecD,y);CHKERRQ(ierr);
   if (dmAux) {
     ierr = PetscFree(a);CHKERRQ(ierr);
     ierr = DMDestroy(&plex);CHKERRQ(ierr);
@@ -279,6 +279,10 @@ int main(int argc, char **argv)
     requires: !single
     filter: sed -e "s~ATOL~RTOL~g" -e "s~ABS~RELATIVE~g"
     args: -simplex 0 -dm_refine 5 -temp_petscspace_order 2 -ts_type beuler -ts_max_steps 10 -ts_dt 0.1 -pc_type lu -ksp_monitor_short -ksp_converged_reason -snes_monitor_short -snes_converged_reason -ts_monitor
+  test:
+    suffix: 2d_q2_r2_reorder
+    nsize: 3
+    args: -simplex 0 -dm_refine 2 -dm_plex_reorder hilbert -temp_petscspace_order 2 -ts_type beuler -ts_max_steps 4 -ts_dt 0.1 -pc_type jacobi -ksp_rtol 1.0e-12 -snes_monitor_short -ts_monitor
   test:
     suffix: 3d_p1_r1
     requires: ctetgen
@@ -50,6 +50,10 @@ PetscErrorCode PetscSectionCreate(MPI_Comm comm, PetscSection *s)
   (*s)->maxDof             = 0;
   (*s)->atlasDof           = NULL;
   (*s)->atlasOff           = NULL;
+  (*s)->numRuns            = 0;
+  (*s)->runStart           = NULL;
+  (*s)->runDof             = NULL;
+  (*s)->runOff             = NULL;
   (*s)->bc                 = NULL;
   (*s)->bcIndices          = NULL;
   (*s)->setup              = PETSC_FALSE;
@@ -509,6 +513,8 @@ PetscErrorCode PetscSectionSetChart(PetscSection s, PetscInt pStart, PetscInt pE
   ierr = PetscSectionDestroy(&s->bc);CHKERRQ(ierr);
   ierr = PetscFree(s->bcIndices);CHKERRQ(ierr);
   ierr = PetscFree2(s->atlasDof, s->atlasOff);CHKERRQ(ierr);
+  ierr = PetscFree3(s->runStart, s->runDof, s->runOff);CHKERRQ(ierr);
+  s->numRuns = 0;
 
   s->pStart = pStart;
   s->pEnd   = pEnd;
@@ -574,6 +580,20 @@ PetscErrorCode PetscSectionSetPermutation(PetscSection s, IS perm)
   PetscFunctionReturn(0);
 }
 
+/* Returns the run of a compact section containing the point */
+PETSC_STATIC_INLINE PetscInt PetscSectionFindRun_Private(PetscSection s, PetscInt point)
+{
+  PetscInt lo = 0, hi = s->numRuns;
+
+  while (hi - lo > 1) {
+    const PetscInt mid = lo + (hi - lo)/2;
+
+    if (s->runStart[mid] <= point) lo = mid;
+    else                           hi = mid;
+  }
+  return lo;
+}
+
 /*@
   PetscSectionGetDof - Return the number of degrees of freedom associated with a given point.
 
@@ -598,6 +618,7 @@ PetscErrorCode PetscSectionGetDof(PetscSection s, PetscInt point, PetscInt *numD
 #if defined(PETSC_USE_DEBUG)
   if ((point < s->pStart) || (point >= s->pEnd)) SETERRQ3(PETSC_COMM_SELF, PETSC_ERR_ARG_OUTOFRANGE, "Section point %d should be in [%d, %d)", point, s->pStart, s->pEnd);
 #endif
+  if (PetscUnlikely(s->numRuns)) {*numDof = s->runDof[PetscSectionFindRun_Private(s, point)]; PetscFunctionReturn(0);}
   *numDof = s->atlasDof[point - s->pStart];
   PetscFunctionReturn(0);
 }
@@ -618,9 +639,12 @@ PetscErrorCode PetscSectionGetDof(PetscSection s, PetscInt point, PetscInt *numD
 @*/
 PetscErrorCode PetscSectionSetDof(PetscSection s, PetscInt point, PetscInt numDof)
 {
+  PetscErrorCode ierr;
+
   PetscFunctionBegin;
   PetscValidHeaderSpecific(s, PETSC_SECTION_CLASSID, 1);
   if ((point < s->pStart) || (point >= s->pEnd)) SETERRQ3(PETSC_COMM_SELF, PETSC_ERR_ARG_OUTOFRANGE, "Section point %d should be in [%d, %d)", point, s->pStart, s->pEnd);
+  if (s->numRuns) {ierr = PetscSectionExpand_Internal(s);CHKERRQ(ierr);}
   s->atlasDof[point - s->pStart] = numDof;
   PetscFunctionReturn(0);
 }
@@ -641,9 +665,12 @@ PetscErrorCode PetscSectionSetDof(PetscSection s, PetscInt point, PetscInt numDo
 @*/
 PetscErrorCode PetscSectionAddDof(PetscSection s, PetscInt point, PetscInt numDof)
 {
+  PetscErrorCode ierr;
+
   PetscFunctionBegin;
   PetscValidHeaderSpecific(s, PETSC_SECTION_CLASSID, 1);
   if ((point < s->pStart) || (point >= s->pEnd)) SETERRQ3(PETSC_COMM_SELF, PETSC_ERR_ARG_OUTOFRANGE, "Section point %d should be in [%d, %d)", point, s->pStart, s->pEnd);
+  if (s->numRuns) {ierr = PetscSectionExpand_Internal(s);CHKERRQ(ierr);}
   s->atlasDof[point - s->pStart] += numDof;
   PetscFunctionReturn(0);
 }
@@ -929,6 +956,7 @@ PetscErrorCode PetscSectionSetUp(PetscSection s)
   PetscValidHeaderSpecific(s, PETSC_SECTION_CLASSID, 1);
   if (s->setup) PetscFunctionReturn(0);
   s->setup = PETSC_TRUE;
+  ierr = PetscObjectStateIncrease((PetscObject) s);CHKERRQ(ierr);
   if (s->perm) {ierr = ISGetIndices(s->perm, &pind);CHKERRQ(ierr);}
   for (p = 0; p < s->pEnd - s->pStart; ++p) {
     const PetscInt q = pind ? pind[p] : p;
@@ -957,6 +985,88 @@ PetscErrorCode PetscSectionSetUp(PetscSection s)
   PetscFunctionReturn(0);
 }
 
+/*
+  PetscSectionCompact_Internal - Replace the per point layout by runs of consecutive points having the same number of dof and contiguous offsets
+
+  Not collective
+
+  Input Parameters:
++ s       - the PetscSection, which must be set up and have no fields or constraints
+- maxRuns - the largest number of runs for which the section is compacted
+
+  Output Parameter:
+. compact - PETSC_TRUE if the section was compacted
+
+  Notes:
+  A compact section answers PetscSectionGetDof() and PetscSectionGetOffset() by a search over the runs, without
+  storing atlasDof and atlasOff. Any routine needing the per point arrays, or changing the layout, expands the
+  section again with PetscSectionExpand_Internal(). This is meant for sections, like the cone section of a DMPlex,
+  where the points of a stratum all have the same size.
+
+  Level: developer
+*/
+PetscErrorCode PetscSectionCompact_Internal(PetscSection s, PetscInt maxRuns, PetscBool *compact)
+{
+  PetscInt       n = s->pEnd - s->pStart, numRuns = 0, p, r;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(s, PETSC_SECTION_CLASSID, 1);
+  PetscValidPointer(compact, 3);
+  *compact = PETSC_FALSE;
+  if (s->numRuns) {*compact = PETSC_TRUE; PetscFunctionReturn(0);}
+  if (!s->setup || s->bc || s->numFields || n <= 0) PetscFunctionReturn(0);
+  for (p = 0; p < n; ++p) {
+    if (!p || (s->atlasDof[p] != s->atlasDof[p-1]) || (s->atlasOff[p] != s->atlasOff[p-1] + s->atlasDof[p-1])) {
+      if (++numRuns > maxRuns) PetscFunctionReturn(0);
+    }
+  }
+  ierr = PetscMalloc3(numRuns+1, &s->runStart, numRuns, &s->runDof, numRuns, &s->runOff);CHKERRQ(ierr);
+  for (p = 0, r = 0; p < n; ++p) {
+    if (!p || (s->atlasDof[p] != s->atlasDof[p-1]) || (s->atlasOff[p] != s->atlasOff[p-1] + s->atlasDof[p-1])) {
+      s->runStart[r] = p + s->pStart;
+      s->runDof[r]   = s->atlasDof[p];
+      s->runOff[r]   = s->atlasOff[p];
+      ++r;
+    }
+  }
+  s->runStart[numRuns] = s->pEnd;
+  s->numRuns           = numRuns;
+  ierr = PetscFree2(s->atlasDof, s->atlasOff);CHKERRQ(ierr);
+  *compact = PETSC_TRUE;
+  PetscFunctionReturn(0);
+}
+
+/*
+  PetscSectionExpand_Internal - Restore the per point layout of a section compacted with PetscSectionCompact_Internal()
+
+  Not collective
+
+  Input Parameter:
+. s - the PetscSection
+
+  Level: developer
+*/
+PetscErrorCode PetscSectionExpand_Internal(PetscSection s)
+{
+  PetscInt       r, p;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(s, PETSC_SECTION_CLASSID, 1);
+  if (!s->numRuns) PetscFunctionReturn(0);
+  ierr = PetscMalloc2((s->pEnd - s->pStart), &s->atlasDof, (s->pEnd - s->pStart), &s->atlasOff);CHKERRQ(ierr);
+  for (r = 0; r < s->numRuns; ++r) {
+    for (p = s->runStart[r]; p < s->runStart[r+1]; ++p) {
+      s->atlasDof[p - s->pStart] = s->runDof[r];
+      s->atlasOff[p - s->pStart] = s->runOff[r] + (p - s->runStart[r])*s->runDof[r];
+    }
+  }
+  ierr = PetscFree3(s->runStart, s->runDof, s->runOff);CHKERRQ(ierr);
+  s->numRuns = 0;
+  PetscFunctionReturn(0);
+}
+
 /*@
   PetscSectionGetMaxDof - Return the maximum number of degrees of freedom on any point in the chart
 
@@ -1004,6 +1114,11 @@ PetscErrorCode PetscSectionGetStorageSize(PetscSection s, PetscInt *size)
   PetscFunctionBegin;
   PetscValidHeaderSpecific(s, PETSC_SECTION_CLASSID, 1);
   PetscValidPointer(size, 2);
+  if (s->numRuns) {
+    for (p = 0; p < s->numRuns; ++p) n += s->runDof[p] > 0 ? (s->runStart[p+1] - s->runStart[p])*s->runDof[p] : 0;
+    *size = n;
+    PetscFunctionReturn(0);
+  }
   for (p = 0; p < s->pEnd - s->pStart; ++p) n += s->atlasDof[p] > 0 ? s->atlasDof[p] : 0;
   *size = n;
   PetscFunctionReturn(0);
@@ -1027,11 +1142,14 @@ PetscErrorCode PetscSectionGetStorageSize(PetscSection s, PetscInt *size)
 @*/
 PetscErrorCode PetscSectionGetConstrainedStorageSize(PetscSection s, PetscInt *size)
 {
-  PetscInt p, n = 0;
+  PetscInt       p, n = 0;
+  PetscErrorCode ierr;
 
   PetscFunctionBegin;
   PetscValidHeaderSpecific(s, PETSC_SECTION_CLASSID, 1);
   PetscValidPointer(size, 2);
+  /* A compact section has no constraints */
+  if (s->numRuns) {ierr = PetscSectionGetStorageSize(s, size);CHKERRQ(ierr); PetscFunctionReturn(0);}
   for (p = 0; p < s->pEnd - s->pStart; ++p) {
     const PetscInt cdof = s->bc ? s->bc->atlasDof[p] : 0;
     n += s->atlasDof[p] > 0 ? s->atlasDof[p] - cdof : 0;
@@ -1317,6 +1435,12 @@ PetscErrorCode PetscSectionGetOffset(PetscSection s, PetscInt point, PetscInt *o
 #if defined(PETSC_USE_DEBUG)
   if ((point < s->pStart) || (point >= s->pEnd)) SETERRQ3(PETSC_COMM_SELF, PETSC_ERR_ARG_OUTOFRANGE, "Section point %d should be in [%d, %d)", point, s->pStart, s->pEnd);
 #endif
+  if (PetscUnlikely(s->numRuns)) {
+    const PetscInt r = PetscSectionFindRun_Private(s, point);
+
+    *offset = s->runOff[r] + (point - s->runStart[r])*s->runDof[r];
+    PetscFunctionReturn(0);
+  }
   *offset = s->atlasOff[point - s->pStart];
   PetscFunctionReturn(0);
 }
@@ -1339,9 +1463,12 @@ PetscErrorCode PetscSectionGetOffset(PetscSection s, PetscInt point, PetscInt *o
 @*/
 PetscErrorCode PetscSectionSetOffset(PetscSection s, PetscInt point, PetscInt offset)
 {
+  PetscErrorCode ierr;
+
   PetscFunctionBegin;
   PetscValidHeaderSpecific(s, PETSC_SECTION_CLASSID, 1);
   if ((point < s->pStart) || (point >= s->pEnd)) SETERRQ3(PETSC_COMM_SELF, PETSC_ERR_ARG_OUTOFRANGE, "Section point %d should be in [%d, %d)", point, s->pStart, s->pEnd);
+  if (s->numRuns) {ierr = PetscSectionExpand_Internal(s);CHKERRQ(ierr);}
   s->atlasOff[point - s->pStart] = offset;
   PetscFunctionReturn(0);
 }
@@ -1442,6 +1569,7 @@ PetscErrorCode PetscSectionGetOffsetRange(PetscSection s, PetscInt *start, Petsc
 
   PetscFunctionBegin;
   PetscValidHeaderSpecific(s, PETSC_SECTION_CLASSID, 1);
+  if (s->numRuns) {ierr = PetscSectionExpand_Internal(s);CHKERRQ(ierr);}
   if (s->atlasOff) {os = s->atlasOff[0]; oe = s->atlasOff[0];}
   ierr = PetscSectionGetChart(s, &pStart, &pEnd);CHKERRQ(ierr);
   for (p = 0; p < pEnd-pStart; ++p) {
@@ -1716,6 +1844,7 @@ PetscErrorCode  PetscSectionView_ASCII(PetscSection s, PetscViewer viewer)
   ierr = MPI_Comm_rank(PetscObjectComm((PetscObject)viewer), &rank);CHKERRQ(ierr);
   ierr = PetscViewerASCIIPushSynchronized(viewer);CHKERRQ(ierr);
   ierr = PetscViewerASCIISynchronizedPrintf(viewer, "Process %d:\n", rank);CHKERRQ(ierr);
+  if (s->numRuns) {ierr = PetscSectionExpand_Internal(s);CHKERRQ(ierr);}
   for (p = 0; p < s->pEnd - s->pStart; ++p) {
     if ((s->bc) && (s->bc->atlasDof[p] > 0)) {
       PetscInt b;
@@ -1807,6 +1936,8 @@ PetscErrorCode PetscSectionReset(PetscSection s)
   ierr = PetscSectionDestroy(&s->bc);CHKERRQ(ierr);
   ierr = PetscFree(s->bcIndices);CHKERRQ(ierr);
   ierr = PetscFree2(s->atlasDof, s->atlasOff);CHKERRQ(ierr);
+  ierr = PetscFree3(s->runStart, s->runDof, s->runOff);CHKERRQ(ierr);
+  s->numRuns = 0;
   ierr = PetscSectionDestroy(&s->clSection);CHKERRQ(ierr);
   ierr = ISDestroy(&s->clPoints);CHKERRQ(ierr);
   ierr = ISDestroy(&s->perm);CHKERRQ(ierr);
@@ -1820,6 +1951,7 @@ PetscErrorCode PetscSectionReset(PetscSection s)
   s->setup     = PETSC_FALSE;
   s->numFields = 0;
   s->clObj     = NULL;
+  ierr = PetscObjectStateIncrease((PetscObject) s);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -1857,9 +1989,11 @@ PetscErrorCode PetscSectionDestroy(PetscSection *s)
 PetscErrorCode VecIntGetValuesSection(PetscInt *baseArray, PetscSection s, PetscInt point, const PetscInt **values)
 {
   const PetscInt p = point - s->pStart;
+  PetscErrorCode ierr;
 
   PetscFunctionBegin;
   PetscValidHeaderSpecific(s, PETSC_SECTION_CLASSID, 2);
+  if (s->numRuns) {ierr = PetscSectionExpand_Internal(s);CHKERRQ(ierr);}
   *values = &baseArray[s->atlasOff[p]];
   PetscFunctionReturn(0);
 }
@@ -1875,6 +2009,7 @@ PetscErrorCode VecIntSetValuesSection(PetscInt *baseArray, PetscSection s, Petsc
   PetscFunctionBegin;
   PetscValidHeaderSpecific(s, PETSC_SECTION_CLASSID, 2);
   ierr  = PetscSectionGetConstraintDof(s, p, &cDim);CHKERRQ(ierr);
+  if (s->numRuns) {ierr = PetscSectionExpand_Internal(s);CHKERRQ(ierr);}
   array = &baseArray[s->atlasOff[p]];
   if (!cDim) {
     if (orientation >= 0) {
@@ -2000,6 +2135,7 @@ PetscErrorCode PetscSectionSetConstraintIndices(PetscSection s, PetscInt point,
   if (s->bc) {
     ierr = VecIntSetValuesSection(s->bcIndices, s->bc, point, indices, INSERT_VALUES);CHKERRQ(ierr);
   }
+  ierr = PetscObjectStateIncrease((PetscObject) s);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -2022,6 +2158,7 @@ PetscErrorCode PetscSectionSetFieldConstraintIndices(PetscSection s, PetscInt po
   PetscValidHeaderSpecific(s, PETSC_SECTION_CLASSID, 1);
   if ((field < 0) || (field >= s->numFields)) SETERRQ3(PETSC_COMM_SELF, PETSC_ERR_ARG_OUTOFRANGE, "Section field %d should be in [%d, %d)", field, 0, s->numFields);
   ierr = PetscSectionSetConstraintIndices(s->field[field], point, indices);CHKERRQ(ierr);
+  ierr = PetscObjectStateIncrease((PetscObject) s);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -2161,6 +2298,7 @@ PetscErrorCode PetscSFDistributeSection(PetscSF sf, PetscSection rootSection, Pe
     lpEnd   = nleaves;
   }
   ierr = PetscSectionSetChart(leafSection, lpStart, lpEnd);CHKERRQ(ierr);
+  if (rootSection->numRuns) {ierr = PetscSectionExpand_Internal(rootSection);CHKERRQ(ierr);}
   /* Could fuse these at the cost of a copy and extra allocation */
   ierr = PetscSFBcastBegin(embedSF, MPIU_INT, &rootSection->atlasDof[-rpStart], &leafSection->atlasDof[-lpStart]);CHKERRQ(ierr);
   ierr = PetscSFBcastEnd(embedSF, MPIU_INT, &rootSection->atlasDof[-rpStart], &leafSection->atlasDof[-lpStart]);CHKERRQ(ierr);
@@ -2198,6 +2336,7 @@ PetscErrorCode PetscSFCreateRemoteOffsets(PetscSF sf, PetscSection rootSection,
   ierr = ISRestoreIndices(selected, &indices);CHKERRQ(ierr);
   ierr = ISDestroy(&selected);CHKERRQ(ierr);
   ierr = PetscCalloc1(lpEnd - lpStart, remoteOffsets);CHKERRQ(ierr);
+  if (rootSection->numRuns) {ierr = PetscSectionExpand_Internal(rootSection);CHKERRQ(ierr);}
   ierr = PetscSFBcastBegin(embedSF, MPIU_INT, &rootSection->atlasOff[-rpStart], &(*remoteOffsets)[-lpStart]);CHKERRQ(ierr);
   ierr = PetscSFBcastEnd(embedSF, MPIU_INT, &rootSection->atlasOff[-rpStart], &(*remoteOffsets)[-lpStart]);CHKERRQ(ierr);
   ierr = PetscSFDestroy(&embedSF);CHKERRQ(ierr);
@@ -2362,6 +2501,7 @@ PetscErrorCode PetscSectionSetClosurePermutation_Internal(PetscSection section,
   } else SETERRQ(PetscObjectComm(obj), PETSC_ERR_SUP, "Do not support borrowed arrays");
   ierr = PetscMalloc1(clSize, &section->clInvPerm);CHKERRQ(ierr);
   for (i = 0; i < clSize; ++i) section->clInvPerm[section->clPerm[i]] = i;
+  ierr = PetscObjectStateIncrease((PetscObject) section);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -2719,6 +2859,7 @@ PetscErrorCode PetscSectionSetSym(PetscSection section, PetscSectionSym sym)
     ierr = PetscObjectReference((PetscObject) sym);CHKERRQ(ierr);
   }
   section->sym = sym;
+  ierr = PetscObjectStateIncrease((PetscObject) section);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -2767,6 +2908,7 @@ PetscErrorCode PetscSectionSetFieldSym(PetscSection section, PetscInt field, Pet
   PetscValidHeaderSpecific(section,PETSC_SECTION_CLASSID,1);
   if (field < 0 || field >= section->numFields) SETERRQ2(PetscObjectComm((PetscObject)section),PETSC_ERR_ARG_OUTOFRANGE,"Invalid field number %D (not in [0,%D)", field, section->numFields);
   ierr = PetscSectionSetSym(section->field[field],sym);CHKERRQ(ierr);
+  ierr = PetscObjectStateIncrease((PetscObject) section);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 